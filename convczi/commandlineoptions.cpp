@@ -22,24 +22,75 @@ bool CmdlineOpts::ParseArguments(int argc, char** argv)
     std::map<std::string, CmdlineOpts::AddMode> map_string_to_add_mode
     {
         { "transaction-per-tile", AddMode::TransactionPerTile},
+        { "transaction-per-batch", AddMode::TransactionPerBatch},
         { "single-transaction", AddMode::SingleTransaction},
+        { "auto-commit", AddMode::AutoCommit},
+    };
+
+    std::map<std::string, CmdlineOpts::Compression> map_string_to_compression
+    {
+        { "keep", Compression::Keep},
+        { "zstd0", Compression::Zstd0},
+        { "zstd1", Compression::Zstd1},
     };
 
     string source_filename;
     string destination_filename;
     AddMode add_mode;
+    uint32_t reader_threads_count;
+    uint32_t transform_threads_count;
+    uint32_t queue_length;
+    uint32_t batch_size;
+    uint32_t commit_max_tiles;
+    uint32_t commit_max_megabytes;
+    uint32_t commit_max_milliseconds;
+    bool resume = false;
+    Compression compression;
+    int zstd_level;
     app.add_option("-s,--source", source_filename, "The source CZI-file to be converted.")
         ->check(CLI::ExistingFile)
         ->required();
     app.add_option("-o,--output", destination_filename, "The destination file.")
         ->required();
     app.add_option("-m,--mode", add_mode, "Choose between different modes (how the operation is ran).")
-        ->default_val(AddMode::TransactionPerTile)
+        ->default_val(AddMode::TransactionPerBatch)
         ->transform(CLI::CheckedTransformer(map_string_to_add_mode, CLI::ignore_case));
+    app.add_option("--reader-threads", reader_threads_count, "The number of threads reading subblocks from the CZI-file.")
+        ->default_val(2)
+        ->check(CLI::Range(1, 64));
+    app.add_option("--transform-threads", transform_threads_count, "The number of threads for converting the subblocks; with 0 the conversion runs on the reader threads.")
+        ->default_val(0)
+        ->check(CLI::Range(0, 256));
+    app.add_option("--queue-length", queue_length, "The maximal number of subblocks held in memory between the stages of the conversion.")
+        ->default_val(64)
+        ->check(CLI::Range(1, 65536));
+    app.add_option("--commit-tiles", commit_max_tiles, "With mode 'auto-commit': the maximal number of tiles within one transaction (0 for no limit).")
+        ->default_val(1024);
+    app.add_option("--commit-megabytes", commit_max_megabytes, "With mode 'auto-commit': the maximal size of the tile data within one transaction in megabytes (0 for no limit).")
+        ->default_val(256);
+    app.add_option("--commit-milliseconds", commit_max_milliseconds, "With mode 'auto-commit': the maximal duration of a transaction in milliseconds (0 for no limit).")
+        ->default_val(5000);
+    app.add_option("--batch-size", batch_size, "The number of tiles added to the document in one batch (with mode 'transaction-per-batch' this is the number of tiles per transaction).")
+        ->default_val(64)
+        ->check(CLI::Range(1, 65536));
+    app.add_option("-c,--compression", compression, "The compression of the tiles in the destination - 'keep' copies the data as it is, 'zstd0' and 'zstd1' (re-)compress the data. The recompression runs in the transform stage, so it is advisable to use multiple transform threads.")
+        ->default_val(Compression::Keep)
+        ->transform(CLI::CheckedTransformer(map_string_to_compression, CLI::ignore_case));
+    app.add_option("--zstd-level", zstd_level, "The zstd compression level for the compression 'zstd0' or 'zstd1' (0 for the default level).")
+        ->default_val(0)
+        ->check(CLI::Range(0, 22));
+    app.add_flag("--resume", resume, "Resume an interrupted conversion - the destination file must exist, and the subblocks which were converted already are skipped.");
 
     try
     {
         app.parse(argc, argv);
+
+        // with all limits disabled, the auto-commit policy would be switched off - every statement would then be committed on
+        //  its own, so the checkpoint could be committed before the tiles it refers to
+        if (add_mode == AddMode::AutoCommit && commit_max_tiles == 0 && commit_max_megabytes == 0 && commit_max_milliseconds == 0)
+        {
+            throw CLI::ValidationError("--commit-tiles", "with mode 'auto-commit', at least one of '--commit-tiles', '--commit-megabytes' or '--commit-milliseconds' must be non-zero");
+        }
     }
     catch (const CLI::ParseError& e)
     {
@@ -50,6 +101,18 @@ bool CmdlineOpts::ParseArguments(int argc, char** argv)
     this->source_czi_filename_ = source_filename;
     this->destination_filename_ = destination_filename;
     this->mode_ = add_mode;
+    this->reader_threads_count_ = reader_threads_count;
+    this->transform_threads_count_ = transform_threads_count;
+    this->queue_length_ = queue_length;
+
+    // with "transaction-per-tile", each tile is added on its own (i.e. the batch size is one)
+    this->batch_size_ = add_mode == AddMode::TransactionPerTile ? 1 : batch_size;
+    this->commit_max_tiles_ = commit_max_tiles;
+    this->commit_max_bytes_ = static_cast<uint64_t>(commit_max_megabytes) * 1024 * 1024;
+    this->commit_max_milliseconds_ = commit_max_milliseconds;
+    this->resume_ = resume;
+    this->compression_ = compression;
+    this->zstd_level_ = zstd_level;
 
     return true;
 }
@@ -68,3 +131,53 @@ CmdlineOpts::AddMode CmdlineOpts::GetMode() const
 {
     return this->mode_;
 }
+
+std::uint32_t CmdlineOpts::GetReaderThreadsCount() const
+{
+    return this->reader_threads_count_;
+}
+
+std::uint32_t CmdlineOpts::GetTransformThreadsCount() const
+{
+    return this->transform_threads_count_;
+}
+
+std::uint32_t CmdlineOpts::GetQueueLength() const
+{
+    return this->queue_length_;
+}
+
+std::uint32_t CmdlineOpts::GetBatchSize() const
+{
+    return this->batch_size_;
+}
+
+std::uint32_t CmdlineOpts::GetCommitMaxTiles() const
+{
+    return this->commit_max_tiles_;
+}
+
+std::uint64_t CmdlineOpts::GetCommitMaxBytes() const
+{
+    return this->commit_max_bytes_;
+}
+
+std::uint32_t CmdlineOpts::GetCommitMaxMilliseconds() const
+{
+    return this->commit_max_milliseconds_;
+}
+
+bool CmdlineOpts::GetResume() const
+{
+    return this->resume_;
+}
+
+CmdlineOpts::Compression CmdlineOpts::GetCompression() const
+{
+    return this->compression_;
+}
+
+int CmdlineOpts::GetZstdLevel() const
+{
+    return this->zstd_level_;
+}
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: MIT
 
 #pragma once
+#include <cstdint>
 #include <string>
 
 /// This class is responsible for parsing the command-line arguments
@@ -14,14 +15,38 @@ public:
     /// (of how the data is added to the imgdoc2-document).
     enum class AddMode
     {
-        TransactionPerTile, ///< Each tile added is within its own transaction.
+        TransactionPerTile,     ///< Each tile added is within its own transaction.
 
-        SingleTransaction   ///< One transaction for the whole operation.
+        TransactionPerBatch,    ///< Each batch of tiles added is within its own transaction.
+
+        SingleTransaction,      ///< One transaction for the whole operation.
+
+        AutoCommit              ///< The tiles are grouped into transactions by the auto-commit policy of the writer.
+    };
+
+    /// Values that represent the compression of the tiles in the destination document.
+    enum class Compression
+    {
+        Keep,                   ///< The data of the subblocks is copied as it is.
+
+        Zstd0,                  ///< The data is (re-)compressed with the "zstd0"-scheme.
+
+        Zstd1                   ///< The data is (re-)compressed with the "zstd1"-scheme.
     };
 private:
     std::string source_czi_filename_;
     std::string destination_filename_;
-    AddMode mode_{ AddMode::TransactionPerTile };
+    AddMode mode_{ AddMode::TransactionPerBatch };
+    std::uint32_t reader_threads_count_{ 2 };
+    std::uint32_t transform_threads_count_{ 0 };
+    std::uint32_t queue_length_{ 64 };
+    std::uint32_t batch_size_{ 64 };
+    std::uint32_t commit_max_tiles_{ 0 };
+    std::uint64_t commit_max_bytes_{ 0 };
+    std::uint32_t commit_max_milliseconds_{ 0 };
+    bool resume_{ false };
+    Compression compression_{ Compression::Keep };
+    int zstd_level_{ 0 };
 public:
     /// Default constructor.
     CmdlineOpts();
@@ -41,4 +66,45 @@ public:
     const std::string& GetDstFilename() const;
 
     AddMode GetMode() const;
+
+    /// Gets the number of threads reading subblocks from the CZI-file.
+    /// \returns The number of reader threads.
+    std::uint32_t GetReaderThreadsCount() const;
+
+    /// Gets the number of threads for the transform stage (0 meaning that the transform runs on the reader threads).
+    /// \returns The number of transform threads.
+    std::uint32_t GetTransformThreadsCount() const;
+
+    /// Gets the maximal number of subblocks held by the queues between the stages of the conversion.
+    /// \returns The queue length.
+    std::uint32_t GetQueueLength() const;
+
+    /// Gets the number of tiles added to the document in one batch.
+    /// \returns The batch size.
+    std::uint32_t GetBatchSize() const;
+
+    /// Gets the maximal number of tiles within one transaction (for mode "auto-commit"; 0 meaning "no limit").
+    /// \returns The maximal number of tiles within one transaction.
+    std::uint32_t GetCommitMaxTiles() const;
+
+    /// Gets the maximal number of bytes of tile data within one transaction (for mode "auto-commit"; 0 meaning "no limit").
+    /// \returns The maximal number of bytes within one transaction.
+    std::uint64_t GetCommitMaxBytes() const;
+
+    /// Gets the maximal duration of a transaction in milliseconds (for mode "auto-commit"; 0 meaning "no limit").
+    /// \returns The maximal duration of a transaction.
+    std::uint32_t GetCommitMaxMilliseconds() const;
+
+    /// Gets a boolean indicating whether an interrupted conversion is to be resumed (i.e. the destination document
+    /// exists already, and the subblocks recorded there as converted are skipped).
+    /// \returns True if an interrupted conversion is to be resumed; false otherwise.
+    bool GetResume() const;
+
+    /// Gets the compression of the tiles in the destination document.
+    /// \returns The compression.
+    Compression GetCompression() const;
+
+    /// Gets the zstd compression level (where 0 means "use the default level").
+    /// \returns The zstd compression level.
+    int GetZstdLevel() const;
 };
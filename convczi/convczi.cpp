@@ -4,17 +4,29 @@
 
 #include "ConvCZI_Config.h"
 #include <iostream>
+#include <iomanip>
+#include <sstream>
 #include <string>
 #include <chrono>
+#include <vector>
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
 #include <imgdoc2.h>
 #include "utilities.h"
 #include <libCZI.h>
 #include "commandlineoptions.h"
+#include "conversionpipeline.h"
+#include "recompression.h"
 
 using namespace std;
 using namespace libCZI;
 using namespace imgdoc2;
 
+/// The keys of the "user properties" (in the destination document) with which the progress of the conversion is recorded.
+static const char* const kUserPropertyKeySourceFingerprint = "convczi.SourceFingerprint";
+static const char* const kUserPropertyKeyLastSubblockIndex = "convczi.LastSubblockIndex";
+
 static shared_ptr<ICZIReader> CreateCziReader(const CmdlineOpts& options)
 {
     auto spReader = libCZI::CreateCZIReader();
@@ -35,6 +47,29 @@ static shared_ptr<ICZIReader> CreateCziReader(const CmdlineOpts& options)
     return spReader;
 }
 
+/// Gets a "fingerprint" of the source CZI-file, which is used for checking that a conversion is resumed with the same
+/// source file. It is made up of the file-GUID of the CZI-file, the number of subblocks and the size of the file.
+/// \param  czi_reader  The CZI-reader object.
+/// \param  filename    The filename of the CZI-file.
+/// \returns The fingerprint.
+static string GetSourceFingerprint(ICZIReader* czi_reader, const string& filename)
+{
+    const auto file_header_info = czi_reader->GetFileHeaderInfo();
+    const auto& guid = file_header_info.fileGuid;
+    ostringstream string_stream;
+    string_stream << hex << setfill('0') <<
+        setw(8) << guid.Data1 << '-' << setw(4) << guid.Data2 << '-' << setw(4) << guid.Data3 << '-';
+    for (const auto byte : guid.Data4)
+    {
+        string_stream << setw(2) << static_cast<unsigned int>(byte);
+    }
+
+    error_code error_code;
+    const auto file_size = filesystem::file_size(filesystem::u8path(filename), error_code);
+    string_stream << dec << ';' << czi_reader->GetStatistics().subBlockCount << ';' << (error_code ? 0 : file_size);
+    return string_stream.str();
+}
+
 static void ConvertDimCoordinate(const CDimCoordinate& dimCoordinate, TileCoordinate& tc)
 {
     dimCoordinate.EnumValidDimensions(
@@ -125,6 +160,10 @@ static imgdoc2::DataTypes DetermineTileStorageDataType(const libCZI::ISubBlock*
         return imgdoc2::DataTypes::UNCOMPRESSED_BITMAP;
     case CompressionMode::JpgXr:
         return imgdoc2::DataTypes::JPGXRCOMPRESSED_BITMAP;
+    case CompressionMode::Zstd0:
+        return imgdoc2::DataTypes::ZSTD0COMPRESSED_BITMAP;
+    case CompressionMode::Zstd1:
+        return imgdoc2::DataTypes::ZSTD1COMPRESSED_BITMAP;
     default:
         throw invalid_argument("Unsupported compression encountered.");
     }
@@ -135,9 +174,9 @@ static imgdoc2::DataTypes DetermineTileStorageDataType(const libCZI::ISubBlock*
 class DataObjOnSubBlk : public IDataObjBase
 {
 private:
-    const shared_ptr<ISubBlock>& sbBlk;
+    shared_ptr<ISubBlock> sbBlk;
 public:
-    explicit DataObjOnSubBlk(const shared_ptr<ISubBlock>& sbblk) :sbBlk(sbblk)
+    explicit DataObjOnSubBlk(shared_ptr<ISubBlock> sbblk) :sbBlk(std::move(sbblk))
     {
     }
 
@@ -150,6 +189,36 @@ public:
     }
 };
 
+/// Wrapper which is implementing the IDataObjBase-interface on a libCZI-memory-block.
+class DataObjOnMemoryBlock : public IDataObjBase
+{
+private:
+    shared_ptr<IMemoryBlock> memory_block_;
+public:
+    explicit DataObjOnMemoryBlock(shared_ptr<IMemoryBlock> memory_block) : memory_block_(std::move(memory_block))
+    {
+    }
+
+    void GetData(const void** p, size_t* s) const override
+    {
+        *p = this->memory_block_->GetPtr();
+        *s = this->memory_block_->GetSizeOfData();
+    }
+};
+
+static imgdoc2::DataTypes GetTargetDataType(CmdlineOpts::Compression compression)
+{
+    switch (compression)
+    {
+    case CmdlineOpts::Compression::Zstd0:
+        return imgdoc2::DataTypes::ZSTD0COMPRESSED_BITMAP;
+    case CmdlineOpts::Compression::Zstd1:
+        return imgdoc2::DataTypes::ZSTD1COMPRESSED_BITMAP;
+    default:
+        return imgdoc2::DataTypes::ZERO;
+    }
+}
+
 int main(int argc, char** argv)
 {
     CmdlineOpts cmdline_options;
@@ -181,42 +250,52 @@ int main(int argc, char** argv)
         return EXIT_FAILURE;
     }
 
-    // create the "imgdoc2-create-options"-object
-    auto imgdoc2_create_options = ClassFactory::CreateCreateOptionsUp();
-
-    // set parameters with the option-object
-    imgdoc2_create_options->SetFilename(cmdline_options.GetDstFilename().c_str());
-    imgdoc2_create_options->SetCreateBlobTable(true);
-
     auto subBlkStatistics = czi_reader->GetStatistics();
-    subBlkStatistics.dimBounds.EnumValidDimensions(
-        [&](DimensionIndex dim, int start, int end)->bool
-        {
-            if (dim != DimensionIndex::B)
-            {
-                char dimension = Utils::DimensionToChar(dim);
-                imgdoc2_create_options->AddDimension(dimension);
-            }
-
-            return true;
-        });
 
     // if there is a valid M-index, then we want to add a "m-dimension"
-    bool includeMindex = false;
-    if (subBlkStatistics.IsMIndexValid())
-    {
-        imgdoc2_create_options->AddDimension('M');
-        includeMindex = true;
-    }
+    const bool includeMindex = subBlkStatistics.IsMIndexValid();
 
-    // now, with this options-object, we can create an imgdoc2-document
+    // now, we create the imgdoc2-document (or open the existing one if resuming a conversion)
     auto imgdoc2_hosting_environment = ClassFactory::CreateStandardHostingEnvironment();
     shared_ptr<imgdoc2::IDoc> imgdoc2_document;
     try
     {
-        imgdoc2_document = ClassFactory::CreateNew(
-            imgdoc2_create_options.get(),
-            imgdoc2_hosting_environment);
+        if (cmdline_options.GetResume())
+        {
+            auto open_existing_options = ClassFactory::CreateOpenExistingOptionsUp();
+            open_existing_options->SetFilename(cmdline_options.GetDstFilename().c_str());
+            imgdoc2_document = ClassFactory::OpenExisting(open_existing_options.get(), imgdoc2_hosting_environment);
+        }
+        else
+        {
+            // create the "imgdoc2-create-options"-object
+            auto imgdoc2_create_options = ClassFactory::CreateCreateOptionsUp();
+
+            // set parameters with the option-object
+            imgdoc2_create_options->SetFilename(cmdline_options.GetDstFilename().c_str());
+            imgdoc2_create_options->SetCreateBlobTable(true);
+
+            subBlkStatistics.dimBounds.EnumValidDimensions(
+                [&](DimensionIndex dim, int start, int end)->bool
+                {
+                    if (dim != DimensionIndex::B)
+                    {
+                        char dimension = Utils::DimensionToChar(dim);
+                        imgdoc2_create_options->AddDimension(dimension);
+                    }
+
+                    return true;
+                });
+
+            if (includeMindex)
+            {
+                imgdoc2_create_options->AddDimension('M');
+            }
+
+            imgdoc2_document = ClassFactory::CreateNew(
+                imgdoc2_create_options.get(),
+                imgdoc2_hosting_environment);
+        }
     }
     catch (database_exception& exception)
     {
@@ -238,61 +317,173 @@ int main(int argc, char** argv)
     // ...from which we request the "writer2d-interface"
     auto imgdoc2_document_writer = imgdoc2_document->GetWriter2d();
 
+    // we gather the indices of all subblocks in the CZI-file (in the order in which they are converted)
+    vector<int> subblock_indices;
+    subblock_indices.reserve(subBlkStatistics.subBlockCount);
+    czi_reader->EnumerateSubBlocks(
+        [&](int idx, const SubBlockInfo&)->bool
+        {
+            subblock_indices.push_back(idx);
+            return true;
+        });
+
+    // The progress is recorded in the destination document: the fingerprint of the source file is stored when the document
+    //  is created, and with each batch of tiles the index of the last subblock in the batch is stored. When resuming, we check
+    //  the fingerprint, and skip the subblocks up to (and including) the last one recorded.
+    const string source_fingerprint = GetSourceFingerprint(czi_reader.get(), cmdline_options.GetCziFilename());
+    if (cmdline_options.GetResume())
+    {
+        const auto imgdoc2_document_reader = imgdoc2_document->GetReader2d();
+        string value;
+        if (!imgdoc2_document_reader->TryGetUserProperty(kUserPropertyKeySourceFingerprint, &value) || value != source_fingerprint)
+        {
+            cerr << "The output-document was not created from the specified CZI-file, cannot resume the conversion." << endl;
+            return EXIT_FAILURE;
+        }
+
+        if (imgdoc2_document_reader->TryGetUserProperty(kUserPropertyKeyLastSubblockIndex, &value))
+        {
+            int last_subblock_index = 0;
+            const auto parse_result = from_chars(value.data(), value.data() + value.size(), last_subblock_index);
+            const bool is_valid_number = parse_result.ec == errc() && parse_result.ptr == value.data() + value.size();
+            const auto last_converted = is_valid_number ?
+                find(subblock_indices.cbegin(), subblock_indices.cend(), last_subblock_index) :
+                subblock_indices.cend();
+            if (last_converted == subblock_indices.cend())
+            {
+                cerr << "The progress recorded in the output-document is invalid, cannot resume the conversion." << endl;
+                return EXIT_FAILURE;
+            }
+
+            const auto converted_count = distance(subblock_indices.cbegin(), last_converted) + 1;
+            subblock_indices.erase(subblock_indices.cbegin(), last_converted + 1);
+            cout << "Resuming the conversion, " << converted_count << " subblocks have been converted already." << endl;
+        }
+    }
+    else
+    {
+        imgdoc2_document_writer->SetUserProperty(kUserPropertyKeySourceFingerprint, source_fingerprint);
+    }
+
+    // In order to have the checkpoint committed together with the batch of tiles it refers to, an auto-commit policy must
+    //  be active: for the modes "transaction-per-tile" and "transaction-per-batch", the limit is the batch size (so that
+    //  each batch is committed on its own), and for the mode "auto-commit" the command line parser ensures that at least
+    //  one limit is given (with all limits being zero, the policy would be disabled).
     if (cmdline_options.GetMode() == CmdlineOpts::AddMode::SingleTransaction)
     {
         imgdoc2_document_writer->BeginTransaction();
     }
+    else if (cmdline_options.GetMode() == CmdlineOpts::AddMode::AutoCommit)
+    {
+        AutoCommitPolicy auto_commit_policy;
+        auto_commit_policy.max_items = cmdline_options.GetCommitMaxTiles();
+        auto_commit_policy.max_bytes = cmdline_options.GetCommitMaxBytes();
+        auto_commit_policy.max_duration_milliseconds = cmdline_options.GetCommitMaxMilliseconds();
+        imgdoc2_document_writer->SetAutoCommitPolicy(auto_commit_policy);
+    }
+    else
+    {
+        AutoCommitPolicy auto_commit_policy;
+        auto_commit_policy.max_items = cmdline_options.GetBatchSize();
+        imgdoc2_document_writer->SetAutoCommitPolicy(auto_commit_policy);
+    }
 
     cout << endl;
 
-    // ... and now, we simply loop over every subblock in the CZI-file, and copy it over into the
-    //      imgdoc2-document
-    TileCoordinate imgdoc2_tile_coordinate;
-    LogicalPositionInfo imgdoc2_logical_position_info;
-    uint64_t total_data_size = 0;
-    auto start = chrono::high_resolution_clock::now();
-    uint32_t subblocks_processed_count = 0;
-    uint32_t total_subblock_count = static_cast<uint32_t>(czi_reader->GetStatistics().subBlockCount);
-    czi_reader->EnumerateSubBlocks(
-        [&](int idx, const SubBlockInfo& info)->bool
+    // this is converting a subblock into the tile description - it is called concurrently on the threads of the pipeline
+    const bool recompress = cmdline_options.GetCompression() != CmdlineOpts::Compression::Keep;
+    const imgdoc2::DataTypes target_data_type = GetTargetDataType(cmdline_options.GetCompression());
+    const int zstd_level = cmdline_options.GetZstdLevel();
+    const auto transform = [includeMindex, recompress, target_data_type, zstd_level](TileToConvert& tile)->void
         {
-            imgdoc2_tile_coordinate.Clear();
-            ConvertDimCoordinate(info.coordinate, imgdoc2_tile_coordinate);
+            const SubBlockInfo& info = tile.subblock->GetSubBlockInfo();
+            ConvertDimCoordinate(info.coordinate, tile.tile_coordinate);
             if (includeMindex)
             {
-                imgdoc2_tile_coordinate.Set('M', info.mIndex);
+                tile.tile_coordinate.Set('M', info.mIndex);
             }
 
-            imgdoc2_logical_position_info.posX = info.logicalRect.x;
-            imgdoc2_logical_position_info.posY = info.logicalRect.y;
-            imgdoc2_logical_position_info.width = info.logicalRect.w;
-            imgdoc2_logical_position_info.height = info.logicalRect.h;
-            imgdoc2_logical_position_info.pyrLvl = CalcPyramidLayerNo(info.logicalRect, info.physicalSize, 2);
+            tile.logical_position_info.posX = info.logicalRect.x;
+            tile.logical_position_info.posY = info.logicalRect.y;
+            tile.logical_position_info.width = info.logicalRect.w;
+            tile.logical_position_info.height = info.logicalRect.h;
+            tile.logical_position_info.pyrLvl = CalcPyramidLayerNo(info.logicalRect, info.physicalSize, 2);
 
-            TileBaseInfo imgdoc2_tile_base_info = DeriveTileBaseInfo(info);
+            tile.tile_base_info = DeriveTileBaseInfo(info);
+            tile.data_type = DetermineTileStorageDataType(tile.subblock.get());
 
-            auto sbBlk = czi_reader->ReadSubBlock(idx);
-            const imgdoc2::DataTypes tile_storage_data_type = DetermineTileStorageDataType(sbBlk.get());
-
-            DataObjOnSubBlk dataobj(sbBlk);
-            imgdoc2_document_writer->AddTile(
-                &imgdoc2_tile_coordinate,
-                &imgdoc2_logical_position_info,
-                &imgdoc2_tile_base_info,
-                tile_storage_data_type,
-                TileDataStorageType::BlobInDatabase,
-                &dataobj);
+            // if the subblock is compressed with the requested scheme already, we copy the data as it is
+            if (recompress && tile.data_type != target_data_type)
+            {
+                const auto compressed_data = Recompression::CompressSubBlock(tile.subblock.get(), target_data_type, zstd_level);
+                tile.data_type = target_data_type;
+                tile.data_size = compressed_data->GetSizeOfData();
+                tile.data = make_unique<DataObjOnMemoryBlock>(compressed_data);
+                return;
+            }
 
             size_t size_of_subblock_data;
             const void* dummy;
-            sbBlk->DangerousGetRawData(ISubBlock::MemBlkType::Data, dummy, size_of_subblock_data);
-            total_data_size += size_of_subblock_data;
+            tile.subblock->DangerousGetRawData(ISubBlock::MemBlkType::Data, dummy, size_of_subblock_data);
+            tile.data_size = size_of_subblock_data;
+            tile.data = make_unique<DataObjOnSubBlk>(tile.subblock);
+        };
+
+    ConversionPipelineOptions pipeline_options;
+    pipeline_options.reader_threads_count = cmdline_options.GetReaderThreadsCount();
+    pipeline_options.transform_threads_count = cmdline_options.GetTransformThreadsCount();
+    pipeline_options.queue_length = cmdline_options.GetQueueLength();
+    pipeline_options.batch_size = cmdline_options.GetBatchSize();
+
+    // the progress report gives the data rate sustained over the last second (or so), in addition to the number of
+    //  subblocks processed
+    auto start = chrono::high_resolution_clock::now();
+    auto last_rate_update = start;
+    uint64_t data_size_at_last_rate_update = 0;
+    double current_datarate = 0;
+    pipeline_options.report_progress =
+        [&](uint64_t processed_count, uint64_t total_count, uint64_t data_size)->void
+        {
+            const auto now = chrono::high_resolution_clock::now();
+            const chrono::duration<double> elapsed_since_rate_update = now - last_rate_update;
+            if (elapsed_since_rate_update.count() >= 1)
+            {
+                current_datarate = static_cast<double>(data_size - data_size_at_last_rate_update) / elapsed_since_rate_update.count() / 1e6;
+                last_rate_update = now;
+                data_size_at_last_rate_update = data_size;
+            }
 
-            cout << subblocks_processed_count << " / " << total_subblock_count << "\r";
-            ++subblocks_processed_count;
+            cout << processed_count << " / " << total_count << " (" << current_datarate << "MB/s)    \r";
+        };
 
-            return true;
-        });
+    pipeline_options.record_checkpoint =
+        [&](int last_subblock_index)->void
+        {
+            imgdoc2_document_writer->SetUserProperty(kUserPropertyKeyLastSubblockIndex, to_string(last_subblock_index));
+        };
+
+    ConversionPipeline pipeline(czi_reader, imgdoc2_document_writer, transform, pipeline_options);
+    try
+    {
+        pipeline.Run(subblock_indices);
+    }
+    catch (exception& exception)
+    {
+        cout << endl;
+        cerr << "Error converting the CZI-file : " << exception.what() << endl;
+
+        // the pending transaction is discarded (it may contain a checkpoint for a batch which could not be added), so
+        //  that the document reflects the state of the last commit - from which the conversion can be resumed
+        try
+        {
+            imgdoc2_document_writer->RollbackTransaction();
+        }
+        catch (...)
+        {
+        }
+
+        return EXIT_FAILURE;
+    }
 
     cout << endl;
 
@@ -300,11 +491,16 @@ int main(int argc, char** argv)
     {
         imgdoc2_document_writer->CommitTransaction();
     }
+    else
+    {
+        // resetting the policy commits the pending auto-commit transaction
+        imgdoc2_document_writer->SetAutoCommitPolicy(AutoCommitPolicy{});
+    }
 
     auto end = chrono::high_resolution_clock::now();
     chrono::duration<double> elapsed_seconds = end - start;
 
-    cout << "Operation completed within " << elapsed_seconds.count() << "s -> datarate=" << total_data_size / elapsed_seconds.count() / 1e6 << "MB/s" << endl;
+    cout << "Operation completed within " << elapsed_seconds.count() << "s -> datarate=" << pipeline.GetTotalDataSize() / elapsed_seconds.count() / 1e6 << "MB/s" << endl;
 
     // and... done
     return EXIT_SUCCESS;
@@ -0,0 +1,217 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include "conversionpipeline.h"
+#include "orderedboundedqueue.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+using namespace std;
+using namespace imgdoc2;
+
+ConversionPipeline::ConversionPipeline(
+    std::shared_ptr<libCZI::ICZIReader> czi_reader,
+    std::shared_ptr<imgdoc2::IDocWrite2d> document_writer,
+    TransformFunction transform,
+    const ConversionPipelineOptions& options) :
+    czi_reader_(std::move(czi_reader)),
+    document_writer_(std::move(document_writer)),
+    transform_(std::move(transform)),
+    options_(options)
+{
+    this->options_.reader_threads_count = max(this->options_.reader_threads_count, 1u);
+    this->options_.queue_length = max(this->options_.queue_length, 1u);
+    this->options_.batch_size = max(this->options_.batch_size, 1u);
+}
+
+void ConversionPipeline::Run(const std::vector<int>& subblock_indices)
+{
+    const uint64_t total_count = subblock_indices.size();
+    const bool use_transform_threads = this->options_.transform_threads_count > 0;
+
+    // the "read queue" is only used if there is a separate transform stage, otherwise the readers are putting the
+    //  (transformed) tiles directly into the "write queue"
+    OrderedBoundedQueue<TileToConvert> read_queue(this->options_.queue_length, use_transform_threads ? total_count : 0);
+    OrderedBoundedQueue<TileToConvert> write_queue(this->options_.queue_length, total_count);
+
+    mutex error_mutex;
+    exception_ptr first_error;
+    const auto abort_with_error = [&](exception_ptr error)
+    {
+        {
+            const lock_guard<mutex> lock(error_mutex);
+            if (!first_error)
+            {
+                first_error = std::move(error);
+            }
+        }
+
+        read_queue.Abort();
+        write_queue.Abort();
+    };
+
+    // the readers are claiming the subblocks in ascending order, so that the CZI-file is read (more or less) sequentially
+    atomic_uint64_t next_to_read{ 0 };
+    const auto reader = [&]()
+    {
+        try
+        {
+            for (;;)
+            {
+                const uint64_t sequence_number = next_to_read.fetch_add(1);
+                if (sequence_number >= total_count)
+                {
+                    break;
+                }
+
+                TileToConvert tile;
+                tile.subblock_index = subblock_indices[sequence_number];
+                tile.subblock = this->czi_reader_->ReadSubBlock(tile.subblock_index);
+                if (!use_transform_threads)
+                {
+                    this->transform_(tile);
+                }
+
+                auto& destination_queue = use_transform_threads ? read_queue : write_queue;
+                if (!destination_queue.Put(sequence_number, std::move(tile)))
+                {
+                    break;
+                }
+            }
+        }
+        catch (...)
+        {
+            abort_with_error(current_exception());
+        }
+    };
+
+    const auto transformer = [&]()
+    {
+        try
+        {
+            uint64_t sequence_number;
+            TileToConvert tile;
+            while (read_queue.Take(sequence_number, tile))
+            {
+                this->transform_(tile);
+                if (!write_queue.Put(sequence_number, std::move(tile)))
+                {
+                    break;
+                }
+            }
+        }
+        catch (...)
+        {
+            abort_with_error(current_exception());
+        }
+    };
+
+    vector<thread> threads;
+    const auto join_threads = [&]()
+    {
+        for (auto& worker : threads)
+        {
+            worker.join();
+        }
+
+        threads.clear();
+    };
+
+    try
+    {
+        for (uint32_t i = 0; i < this->options_.reader_threads_count; ++i)
+        {
+            threads.emplace_back(reader);
+        }
+
+        if (use_transform_threads)
+        {
+            for (uint32_t i = 0; i < this->options_.transform_threads_count; ++i)
+            {
+                threads.emplace_back(transformer);
+            }
+        }
+    }
+    catch (...)
+    {
+        abort_with_error(current_exception());
+        join_threads();
+        throw;
+    }
+
+    // and now, the calling thread is acting as the writer - the tiles arrive here in the original order
+    vector<TileToConvert> batch;
+    batch.reserve(this->options_.batch_size);
+    uint64_t processed_count = 0;
+    try
+    {
+        uint64_t sequence_number;
+        TileToConvert tile;
+        while (write_queue.Take(sequence_number, tile))
+        {
+            batch.emplace_back(std::move(tile));
+            if (batch.size() >= this->options_.batch_size)
+            {
+                processed_count += batch.size();
+                this->AddTiles(batch);
+                if (this->options_.report_progress)
+                {
+                    this->options_.report_progress(processed_count, total_count, this->total_data_size_);
+                }
+            }
+        }
+    }
+    catch (...)
+    {
+        abort_with_error(current_exception());
+    }
+
+    join_threads();
+    if (first_error)
+    {
+        rethrow_exception(first_error);
+    }
+
+    if (!batch.empty())
+    {
+        processed_count += batch.size();
+        this->AddTiles(batch);
+        if (this->options_.report_progress)
+        {
+            this->options_.report_progress(processed_count, total_count, this->total_data_size_);
+        }
+    }
+}
+
+void ConversionPipeline::AddTiles(std::vector<TileToConvert>& batch)
+{
+    vector<TileToAdd> tiles_to_add;
+    tiles_to_add.reserve(batch.size());
+    uint64_t batch_data_size = 0;
+    for (const auto& tile : batch)
+    {
+        TileToAdd tile_to_add;
+        tile_to_add.coordinate = &tile.tile_coordinate;
+        tile_to_add.logical_position_info = &tile.logical_position_info;
+        tile_to_add.tile_base_info = &tile.tile_base_info;
+        tile_to_add.data_type = tile.data_type;
+        tile_to_add.storage_type = TileDataStorageType::BlobInDatabase;
+        tile_to_add.data = tile.data.get();
+        tiles_to_add.push_back(tile_to_add);
+        batch_data_size += tile.data_size;
+    }
+
+    if (this->options_.record_checkpoint)
+    {
+        this->options_.record_checkpoint(batch.back().subblock_index);
+    }
+
+    this->document_writer_->AddTiles(tiles_to_add.data(), static_cast<uint32_t>(tiles_to_add.size()), nullptr);
+    this->total_data_size_ += batch_data_size;
+    batch.clear();
+}
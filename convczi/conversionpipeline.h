@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <imgdoc2.h>
+#include <libCZI.h>
+
+/// This structure gathers the information about a tile which is to be added to the imgdoc2-document.
+struct TileToConvert
+{
+    int subblock_index{ -1 };                                   ///< The index of the subblock (in the CZI-file).
+    std::shared_ptr<libCZI::ISubBlock> subblock;                ///< The subblock (as read from the CZI-file).
+    imgdoc2::TileCoordinate tile_coordinate;                    ///< The tile coordinate.
+    imgdoc2::LogicalPositionInfo logical_position_info;         ///< The logical position information.
+    imgdoc2::TileBaseInfo tile_base_info;                       ///< The tile base information.
+    imgdoc2::DataTypes data_type{ imgdoc2::DataTypes::ZERO };   ///< The data type of the tile data.
+    std::unique_ptr<imgdoc2::IDataObjBase> data;                ///< The tile data.
+    std::uint64_t data_size{ 0 };                               ///< The size of the tile data in bytes.
+};
+
+/// The parameters for the conversion pipeline.
+struct ConversionPipelineOptions
+{
+    std::uint32_t reader_threads_count{ 2 };            ///< The number of threads reading subblocks from the CZI-file.
+    std::uint32_t transform_threads_count{ 0 };         ///< The number of threads for the transform stage; if 0, the transform runs on the reader threads.
+    std::uint32_t queue_length{ 64 };                   ///< The maximal number of items held by each of the queues between the stages.
+    std::uint32_t batch_size{ 64 };                     ///< The number of tiles added to the document in one batch.
+
+    /// A functor which is called periodically (on the writer thread) in order to report the progress. The arguments
+    /// are the number of subblocks processed so far, the total number of subblocks and the number of bytes written so far.
+    std::function<void(std::uint64_t, std::uint64_t, std::uint64_t)> report_progress;
+
+    /// A functor which is called (on the writer thread) before a batch of tiles is added to the document, with the index
+    /// of the last subblock in the batch as argument. This is intended for recording the progress of the conversion in the
+    /// document - within the same transaction as the batch, so that the checkpoint is committed together with the tiles.
+    std::function<void(int)> record_checkpoint;
+};
+
+/// The conversion pipeline is copying the subblocks of a CZI-file into an imgdoc2-document. It consists of three stages
+/// which run concurrently:
+/// - reader threads: the subblocks are read from the CZI-file (in the order of the subblock-directory, which is usually
+///   the order in which they appear in the file),
+/// - transform stage: the subblocks are converted into the tile description for imgdoc2 (by calling the "transform"-functor
+///   given to the constructor) - this runs on a pool of threads of its own, or on the reader threads,
+/// - writer: the tiles are added to the document (in batches) - this runs on the thread calling "Run", so the writer is
+///   only accessed by one thread.
+/// The stages are connected by bounded queues (which also restore the original order), so that the memory usage is bounded
+/// and a slow writer is throttling the readers.
+class ConversionPipeline
+{
+public:
+    /// A functor which is converting the subblock (given in the tile-object) into the tile description. It is
+    /// called concurrently on different threads.
+    using TransformFunction = std::function<void(TileToConvert&)>;
+private:
+    std::shared_ptr<libCZI::ICZIReader> czi_reader_;
+    std::shared_ptr<imgdoc2::IDocWrite2d> document_writer_;
+    TransformFunction transform_;
+    ConversionPipelineOptions options_;
+    std::uint64_t total_data_size_{ 0 };
+public:
+    /// Constructor.
+    ///
+    /// \param  czi_reader      The CZI-reader object.
+    /// \param  document_writer The writer object of the destination document.
+    /// \param  transform       The functor converting a subblock into a tile description.
+    /// \param  options         The parameters of the pipeline.
+    ConversionPipeline(
+        std::shared_ptr<libCZI::ICZIReader> czi_reader,
+        std::shared_ptr<imgdoc2::IDocWrite2d> document_writer,
+        TransformFunction transform,
+        const ConversionPipelineOptions& options);
+
+    /// Runs the conversion for the specified subblocks - the tiles are added to the document in the order given here. This
+    /// method returns when all subblocks are added to the document. If an error occurs (in any of the stages), the
+    /// operation is cancelled and the exception is re-thrown on the calling thread.
+    ///
+    /// \param  subblock_indices    The indices of the subblocks to be converted.
+    void Run(const std::vector<int>& subblock_indices);
+
+    /// Gets the total size of the tile data written to the document (in bytes).
+    ///
+    /// \returns    The total size of the tile data written.
+    [[nodiscard]] std::uint64_t GetTotalDataSize() const { return this->total_data_size_; }
+private:
+    void AddTiles(std::vector<TileToConvert>& batch);
+};
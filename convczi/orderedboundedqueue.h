@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/// A bounded queue which delivers its items in the order of their sequence numbers, regardless of the order in which they
+/// are put into the queue. The items are numbered from 0 to "total_count - 1", and every sequence number must be put exactly
+/// once. The queue is a ring of "capacity" slots - the item with sequence number n goes into slot "n % capacity", and putting
+/// it blocks until the item with sequence number "n - capacity" has been taken out. So, the number of items held by the queue
+/// is bounded (giving backpressure to the producers), and since the producer of the lowest outstanding sequence number can
+/// always proceed, there is no deadlock with multiple producers. Multiple consumers are allowed as well - they receive the
+/// items in sequence order (but may of course finish processing them in any order).
+/// If the operation is to be cancelled (e.g. because of an error), "Abort" is to be called, which releases all waiting
+/// producers and consumers.
+template <typename t_item>
+class OrderedBoundedQueue
+{
+private:
+    std::mutex mutex_;
+    std::condition_variable slot_freed_;
+    std::condition_variable slot_filled_;
+    std::vector<std::optional<t_item>> slots_;
+    std::uint64_t total_count_;
+    std::uint64_t next_to_take_{ 0 };
+    bool aborted_{ false };
+public:
+    /// Constructor.
+    ///
+    /// \param  capacity    The number of slots (which must be greater than zero).
+    /// \param  total_count The total number of items which will go through the queue.
+    OrderedBoundedQueue(std::uint32_t capacity, std::uint64_t total_count) :
+        slots_(capacity > 0 ? capacity : 1), total_count_(total_count)
+    {}
+
+    OrderedBoundedQueue(const OrderedBoundedQueue&) = delete;
+    OrderedBoundedQueue& operator=(const OrderedBoundedQueue&) = delete;
+
+    /// Puts the item with the specified sequence number into the queue, blocking until there is room for it.
+    ///
+    /// \param  sequence_number The sequence number of the item.
+    /// \param  item            The item.
+    ///
+    /// \returns    True if the item was put into the queue; false if the queue has been aborted.
+    bool Put(std::uint64_t sequence_number, t_item item)
+    {
+        std::unique_lock<std::mutex> lock(this->mutex_);
+        this->slot_freed_.wait(
+            lock,
+            [&] { return this->aborted_ || sequence_number < this->next_to_take_ + this->slots_.size(); });
+        if (this->aborted_)
+        {
+            return false;
+        }
+
+        this->slots_[sequence_number % this->slots_.size()] = std::move(item);
+        lock.unlock();
+        this->slot_filled_.notify_all();
+        return true;
+    }
+
+    /// Takes the next item (in sequence order) out of the queue, blocking until it is available.
+    ///
+    /// \param [out]    sequence_number The sequence number of the item.
+    /// \param [out]    item            The item.
+    ///
+    /// \returns    True if an item was retrieved; false if all items have been taken or if the queue has been aborted.
+    bool Take(std::uint64_t& sequence_number, t_item& item)
+    {
+        std::unique_lock<std::mutex> lock(this->mutex_);
+        this->slot_filled_.wait(
+            lock,
+            [&]
+            {
+                return this->aborted_ ||
+                    this->next_to_take_ >= this->total_count_ ||
+                    this->slots_[this->next_to_take_ % this->slots_.size()].has_value();
+            });
+        if (this->aborted_ || this->next_to_take_ >= this->total_count_)
+        {
+            return false;
+        }
+
+        auto& slot = this->slots_[this->next_to_take_ % this->slots_.size()];
+        item = std::move(*slot);
+        slot.reset();
+        sequence_number = this->next_to_take_++;
+        lock.unlock();
+        this->slot_freed_.notify_all();
+
+        // another consumer may be waiting for the next slot (which may already be filled)
+        this->slot_filled_.notify_all();
+        return true;
+    }
+
+    /// Aborts the operation - all blocked (and all future) calls to "Put" and "Take" will return false.
+    void Abort()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(this->mutex_);
+            this->aborted_ = true;
+        }
+
+        this->slot_freed_.notify_all();
+        this->slot_filled_.notify_all();
+    }
+};
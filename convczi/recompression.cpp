@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include "recompression.h"
+#include <stdexcept>
+
+using namespace std;
+using namespace libCZI;
+
+/*static*/std::shared_ptr<libCZI::IMemoryBlock> Recompression::CompressSubBlock(const libCZI::ISubBlock* subblock, imgdoc2::DataTypes target_data_type, int zstd_level)
+{
+    const SubBlockInfo& subblock_info = subblock->GetSubBlockInfo();
+
+    // uncompressed data can be compressed directly (the lines are packed in the CZI-file), otherwise we have to
+    //  decode the data first
+    if (subblock_info.GetCompressionMode() == CompressionMode::UnCompressed)
+    {
+        const void* data;
+        size_t size_of_data;
+        subblock->DangerousGetRawData(ISubBlock::MemBlkType::Data, data, size_of_data);
+        const uint32_t stride = subblock_info.physicalSize.w * Utils::GetBytesPerPixel(subblock_info.pixelType);
+        if (size_of_data < static_cast<size_t>(stride) * subblock_info.physicalSize.h)
+        {
+            throw runtime_error("The size of the uncompressed subblock data is too small.");
+        }
+
+        return Recompression::Compress(target_data_type, zstd_level, subblock_info, data, stride);
+    }
+
+    const auto decoded_bitmap = Recompression::DecodeSubBlock(subblock);
+    const ScopedBitmapLockerSP decoded_bitmap_locker(decoded_bitmap);
+    return Recompression::Compress(target_data_type, zstd_level, subblock_info, decoded_bitmap_locker.ptrDataRoi, decoded_bitmap_locker.stride);
+}
+
+/*static*/std::shared_ptr<libCZI::IBitmapData> Recompression::DecodeSubBlock(const libCZI::ISubBlock* subblock)
+{
+    const SubBlockInfo& subblock_info = subblock->GetSubBlockInfo();
+    ImageDecoderType decoder_type;
+    switch (subblock_info.GetCompressionMode())
+    {
+    case CompressionMode::JpgXr:
+        decoder_type = ImageDecoderType::JPXR_JxrLib;
+        break;
+    case CompressionMode::Zstd0:
+        decoder_type = ImageDecoderType::ZStd0;
+        break;
+    case CompressionMode::Zstd1:
+        decoder_type = ImageDecoderType::ZStd1;
+        break;
+    default:
+        throw invalid_argument("Unsupported compression encountered.");
+    }
+
+    const void* data;
+    size_t size_of_data;
+    subblock->DangerousGetRawData(ISubBlock::MemBlkType::Data, data, size_of_data);
+    const auto decoder = GetDefaultSiteObject(SiteObjectType::Default)->GetDecoder(decoder_type, nullptr);
+    return decoder->Decode(data, size_of_data, subblock_info.pixelType, subblock_info.physicalSize.w, subblock_info.physicalSize.h);
+}
+
+/*static*/std::shared_ptr<libCZI::IMemoryBlock> Recompression::Compress(
+    imgdoc2::DataTypes target_data_type,
+    int zstd_level,
+    const libCZI::SubBlockInfo& subblock_info,
+    const void* data,
+    std::uint32_t stride)
+{
+    CompressParametersOnMap parameters;
+    if (zstd_level != 0)
+    {
+        parameters.map[static_cast<int>(CompressionParameterKey::ZSTD_RAWCOMPRESSIONLEVEL)] = CompressParameter(static_cast<int32_t>(zstd_level));
+    }
+
+    switch (target_data_type)
+    {
+    case imgdoc2::DataTypes::ZSTD0COMPRESSED_BITMAP:
+        return ZstdCompress::CompressZStd0Alloc(
+            subblock_info.physicalSize.w,
+            subblock_info.physicalSize.h,
+            stride,
+            subblock_info.pixelType,
+            data,
+            &parameters);
+    case imgdoc2::DataTypes::ZSTD1COMPRESSED_BITMAP:
+        // with the "hi/lo byte packing", 16-bit data compresses significantly better (for other pixel types, this
+        //  parameter is ignored)
+        parameters.map[static_cast<int>(CompressionParameterKey::ZSTD_PREPROCESS_DOLOHIBYTEPACKING)] = CompressParameter(true);
+        return ZstdCompress::CompressZStd1Alloc(
+            subblock_info.physicalSize.w,
+            subblock_info.physicalSize.h,
+            stride,
+            subblock_info.pixelType,
+            data,
+            &parameters);
+    default:
+        throw invalid_argument("Unsupported target compression.");
+    }
+}
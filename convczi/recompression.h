@@ -0,0 +1,34 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <memory>
+#include <imgdoc2.h>
+#include <libCZI.h>
+
+/// This class gathers the functionality for changing the compression of the subblock data (as it is copied into the
+/// imgdoc2-document). The subblock data is decoded (if it is compressed), and then it is compressed with the
+/// requested zstd-based scheme - using the codecs of libCZI for both operations.
+class Recompression
+{
+public:
+    /// Compresses the bitmap contained in the specified subblock with the specified compression scheme.
+    ///
+    /// \param  subblock            The subblock.
+    /// \param  target_data_type    The target data type - must be either "ZSTD0COMPRESSED_BITMAP" or "ZSTD1COMPRESSED_BITMAP".
+    /// \param  zstd_level          The zstd compression level, where 0 means "use the default".
+    ///
+    /// \returns    A memory block containing the compressed data.
+    static std::shared_ptr<libCZI::IMemoryBlock> CompressSubBlock(const libCZI::ISubBlock* subblock, imgdoc2::DataTypes target_data_type, int zstd_level);
+
+private:
+    static std::shared_ptr<libCZI::IBitmapData> DecodeSubBlock(const libCZI::ISubBlock* subblock);
+    static std::shared_ptr<libCZI::IMemoryBlock> Compress(
+        imgdoc2::DataTypes target_data_type,
+        int zstd_level,
+        const libCZI::SubBlockInfo& subblock_info,
+        const void* data,
+        std::uint32_t stride);
+};
@@ -43,5 +43,30 @@ namespace ImgDoc2Net.Interfaces
         ///
         /// <value> The total number of currently existing "writer 3d" objects.</value>
         public int NumberOfWriter3dObjectsActive { get; set; }
+
+        /// <summary> Gets or sets the number of bytes of tile data read (since the last reset of the statistics).</summary>
+        ///
+        /// <value> The number of bytes of tile data read.</value>
+        public ulong BytesRead { get; set; }
+
+        /// <summary> Gets or sets the number of bytes of tile data written (since the last reset of the statistics).</summary>
+        ///
+        /// <value> The number of bytes of tile data written.</value>
+        public ulong BytesWritten { get; set; }
+
+        /// <summary> Gets or sets the number of database statements prepared (since the last reset of the statistics).</summary>
+        ///
+        /// <value> The number of database statements prepared.</value>
+        public ulong StatementsPrepared { get; set; }
+
+        /// <summary> Gets or sets the number of lookups in decoded-bitmap-caches which found a bitmap (since the last reset of the statistics).</summary>
+        ///
+        /// <value> The number of lookups in decoded-bitmap-caches which found a bitmap.</value>
+        public ulong DecodedBitmapCacheHits { get; set; }
+
+        /// <summary> Gets or sets the number of lookups in decoded-bitmap-caches which did not find a bitmap (since the last reset of the statistics).</summary>
+        ///
+        /// <value> The number of lookups in decoded-bitmap-caches which did not find a bitmap.</value>
+        public ulong DecodedBitmapCacheMisses { get; set; }
     }
 }
@@ -381,6 +381,11 @@ namespace ImgDoc2Net.Interop
                     NumberOfWriter2dObjectsActive = (int)statisticsInterop.NumberOfWriter2dObjectsActive,
                     NumberOfReader3dObjectsActive = (int)statisticsInterop.NumberOfReader3dObjectsActive,
                     NumberOfWriter3dObjectsActive = (int)statisticsInterop.NumberOfWriter3dObjectsActive,
+                    BytesRead = statisticsInterop.BytesRead,
+                    BytesWritten = statisticsInterop.BytesWritten,
+                    StatementsPrepared = statisticsInterop.StatementsPrepared,
+                    DecodedBitmapCacheHits = statisticsInterop.DecodedBitmapCacheHits,
+                    DecodedBitmapCacheMisses = statisticsInterop.DecodedBitmapCacheMisses,
                 };
             }
         }
@@ -2439,6 +2444,11 @@ namespace ImgDoc2Net.Interop
             public uint NumberOfWriter2dObjectsActive;
             public uint NumberOfReader3dObjectsActive;
             public uint NumberOfWriter3dObjectsActive;
+            public ulong BytesRead;
+            public ulong BytesWritten;
+            public ulong StatementsPrepared;
+            public ulong DecodedBitmapCacheHits;
+            public ulong DecodedBitmapCacheMisses;
         }
 
         [StructLayout(LayoutKind.Sequential, Pack = 4)]
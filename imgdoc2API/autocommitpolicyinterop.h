@@ -0,0 +1,18 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+
+#pragma pack(push, 4)
+/// This struct defines the auto-commit policy of a writer object (c.f. imgdoc2::AutoCommitPolicy). A value of zero means
+/// "no limit", and if all values are zero, the auto-commit policy is disabled.
+struct AutoCommitPolicyInterop
+{
+    std::uint32_t max_items;                    ///< The maximal number of tiles (or bricks) added within one transaction.
+    std::uint64_t max_bytes;                    ///< The maximal number of bytes (of tile or brick data) added within one transaction.
+    std::uint32_t max_duration_milliseconds;    ///< The maximal duration (in milliseconds) of a transaction.
+};
+#pragma pack(pop)
@@ -0,0 +1,25 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include "logicalpositioninfo3dinterop.h"
+#include "brickbaseinfointerop.h"
+
+#pragma pack(push, 4)
+/// This struct describes a brick to be added with a batched add operation (c.f. IDocWrite3d_AddBricks). The coordinate of the
+/// brick is given as a range in an array of dimension-value-pairs, and the data of the brick is given as a range in a memory
+/// block containing the data of all bricks.
+struct BrickToAddInterop
+{
+    LogicalPositionInfo3DInterop logical_position_info; ///< The logical position information.
+    BrickBaseInfoInterop brick_base_info;               ///< The 'base brick information'.
+    std::uint8_t data_type;                             ///< The data type.
+    std::uint32_t coordinate_offset;                    ///< The index of the first dimension-value-pair of the coordinate of the brick.
+    std::uint32_t coordinate_count;                     ///< The number of dimension-value-pairs of the coordinate of the brick.
+    std::uint64_t data_offset;                          ///< The offset of the data of the brick (relative to the start of the memory block).
+    std::uint64_t data_size;                            ///< The size of the data of the brick in bytes.
+};
+#pragma pack(pop)
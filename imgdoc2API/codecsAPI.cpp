@@ -3,9 +3,18 @@
 // SPDX-License-Identifier: MIT
 
 #include "codecsAPI.h"
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <new>
 #include <libCZI.h>
 #include "imgdoc2APIsupport.h"
+#include "pixelkernels.h"
+#include "parallelexecution.h"
+#include "sharedptrwrapper.h"
+#include "decodedbitmapcache.h"
+#include "operationstatistics.h"
 
 using namespace libCZI;
 using namespace std;
@@ -31,20 +40,303 @@ namespace
         }
     }
 
-    void CopyWithStrideConversion(const void* source_data, std::uint32_t source_stride, libCZI::PixelType pixel_type, std::uint32_t width, std::uint32_t height, void* destination_data, std::uint32_t destination_stride)
+    /// Information about the header of a ZSTD1-compressed blob.
+    struct Zstd1HeaderInfo
     {
-        const size_t line_length = width * static_cast<size_t>(libCZI::Utils::GetBytesPerPixel(pixel_type));
+        size_t header_size;             ///< The size of the header in bytes (0 if the header could not be parsed).
+        bool hi_lo_byte_packing;        ///< Whether the payload is subject to "hi/lo byte packing".
+    };
 
-        // Iterate over each row of the source image
-        for (std::uint32_t row = 0; row < height; row++)
+    /// Parses the header of a ZSTD1-compressed blob. The header starts with a byte giving the size of the header, currently
+    /// only the sizes 1 (no chunks) and 3 (with a chunk of type 1, where bit 0 of the payload indicates "hi/lo byte packing")
+    /// are defined. After the header, the (zstd-compressed) payload follows.
+    ///
+    /// \param  data    The ZSTD1-compressed data.
+    /// \param  size    The size of the data in bytes.
+    ///
+    /// \returns    Information about the header, where a header_size of 0 indicates that the header is invalid.
+    Zstd1HeaderInfo ParseZstd1Header(const void* data, uint64_t size)
+    {
+        const uint8_t* header = static_cast<const uint8_t*>(data);
+        if (size >= 1 && header[0] == 1)
         {
-            // Calculate the memory address of the current row in the source and destination images
-            const std::uint8_t* source_row = static_cast<const std::uint8_t*>(source_data) + static_cast<size_t>(row) * source_stride;
-            std::uint8_t* destination_row = static_cast<std::uint8_t*>(destination_data) + static_cast<size_t>(row) * destination_stride;
+            return Zstd1HeaderInfo{ 1, false };
+        }
 
-            // Copy the row from the source image to the destination image
-            std::memcpy(destination_row, source_row, line_length);
+        if (size >= 3 && header[0] == 3 && header[1] == 1)
+        {
+            return Zstd1HeaderInfo{ 3, (header[2] & 1) == 1 };
         }
+
+        return Zstd1HeaderInfo{ 0, false };
+    }
+
+    bool IsPixelTypeMadeUpOfWords(libCZI::PixelType pixel_type)
+    {
+        return pixel_type == libCZI::PixelType::Gray16 || pixel_type == libCZI::PixelType::Bgr48;
+    }
+
+    /// Checks the arguments describing the source and the destination bitmap of a conversion, where the strides must be at
+    /// least the width times the bytes per pixel.
+    ///
+    /// \param          source_bitmap_info      Information describing the source bitmap.
+    /// \param          source                  Pointer to the source bitmap.
+    /// \param          source_stride           The stride of the source bitmap (in bytes).
+    /// \param          destination_pixel_type  The pixel type of the destination bitmap.
+    /// \param          destination             Pointer to the destination bitmap.
+    /// \param          destination_stride      The stride of the destination bitmap (in bytes).
+    /// \param [in,out] error_information       If non-null, in case of an error, additional information describing the error are put here.
+    ///
+    /// \returns    True if the arguments are valid; false otherwise (and the error information is filled out).
+    bool CheckConversionArguments(const BitmapInfoInterop* source_bitmap_info, const void* source, std::uint32_t source_stride, std::uint8_t destination_pixel_type, const void* destination, std::uint32_t destination_stride, ImgDoc2ErrorInformation* error_information)
+    {
+        if (source_bitmap_info == nullptr)
+        {
+            ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("source_bitmap_info", "must not be null", error_information);
+            return false;
+        }
+
+        if (source == nullptr)
+        {
+            ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("source", "must not be null", error_information);
+            return false;
+        }
+
+        if (destination == nullptr)
+        {
+            ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("destination", "must not be null", error_information);
+            return false;
+        }
+
+        const libCZI::PixelType source_pixel_type = ConvertToLibCziPixelType(source_bitmap_info->pixelType);
+        const libCZI::PixelType libczi_destination_pixel_type = ConvertToLibCziPixelType(destination_pixel_type);
+        if (source_pixel_type == libCZI::PixelType::Invalid || libczi_destination_pixel_type == libCZI::PixelType::Invalid)
+        {
+            ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("pixelType", "is not supported", error_information);
+            return false;
+        }
+
+        if (source_stride < static_cast<uint64_t>(source_bitmap_info->pixelWidth) * libCZI::Utils::GetBytesPerPixel(source_pixel_type))
+        {
+            ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("source_stride", "must be greater than or equal to pixelWidth * bytes per pixel", error_information);
+            return false;
+        }
+
+        if (destination_stride < static_cast<uint64_t>(source_bitmap_info->pixelWidth) * libCZI::Utils::GetBytesPerPixel(libczi_destination_pixel_type))
+        {
+            ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("destination_stride", "must be greater than or equal to pixelWidth * bytes per pixel", error_information);
+            return false;
+        }
+
+        return true;
+    }
+
+    /// Decodes the specified compressed data into an uncompressed bitmap. The destination is requested (once the stride is known)
+    /// from the specified function, which is given the stride and the required size (in bytes) of the destination and returns a
+    /// pointer to the destination memory (or null if the memory could not be provided).
+    ///
+    /// \param          bitmap_info             Information describing the (compressed) bitmap.
+    /// \param          data_type               The type of the compression (corresponding to imgdoc2::DataTypes).
+    /// \param          compressed_data         Pointer to the compressed data.
+    /// \param          compressed_data_size    Size of the compressed data in bytes.
+    /// \param          destination_stride      The destination stride or 0 to let the function determine the stride itself.
+    /// \param          get_destination         The function providing the destination memory.
+    /// \param [in,out] error_information       If non-null, in case of an error, additional information describing the error are put here.
+    ///
+    /// \returns    An error-code indicating success or failure of the operation.
+    ImgDoc2ErrorCode DecodeImageInternal(
+                    const BitmapInfoInterop* bitmap_info,
+                    std::uint8_t data_type,
+                    const void* compressed_data,
+                    std::uint64_t compressed_data_size,
+                    std::uint32_t destination_stride,
+                    const std::function<void*(std::uint32_t, std::uint64_t)>& get_destination,
+                    ImgDoc2ErrorInformation* error_information)
+    {
+        const OperationStatistics::Scope operation_scope(OperationStatistics::GetInstance(), OperationStatistics::Operation::Decode);
+        if (bitmap_info == nullptr)
+        {
+            ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("bitmap_info", "must not be null", error_information);
+            return ImgDoc2_ErrorCode_InvalidArgument;
+        }
+
+        if (bitmap_info->pixelWidth == 0 || bitmap_info->pixelHeight == 0)
+        {
+            ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("bitmap_info", "pixelWidth and pixelHeight must be greater than 0", error_information);
+            return ImgDoc2_ErrorCode_InvalidArgument;
+        }
+
+        if (compressed_data_size == 0)
+        {
+            ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("compressed_data_size", "must be greater than 0", error_information);
+            return ImgDoc2_ErrorCode_InvalidArgument;
+        }
+
+        if (compressed_data == nullptr)
+        {
+            ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("compressed_data", "must not be null", error_information);
+            return ImgDoc2_ErrorCode_InvalidArgument;
+        }
+
+        if (destination_stride > 0)
+        {
+            if (destination_stride < bitmap_info->pixelWidth * libCZI::Utils::GetBytesPerPixel(ConvertToLibCziPixelType(bitmap_info->pixelType)))
+            {
+                ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("destination_stride", "must be either be zero (which means that the stride is chosen by this function) or greater than or equal to pixelWidth * bytes per pixel", error_information);
+                return ImgDoc2_ErrorCode_InvalidArgument;
+            }
+        }
+
+        const libCZI::PixelType libczi_pixel_type = ConvertToLibCziPixelType(bitmap_info->pixelType);
+        if (libczi_pixel_type == libCZI::PixelType::Invalid)
+        {
+            ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("bitmap_info", "pixelType is not supported", error_information);
+            return ImgDoc2_ErrorCode_InvalidArgument;
+        }
+
+        std::shared_ptr<libCZI::IBitmapData> decoded_bitmap;
+
+        // If this is true, then the "decoded_bitmap" contains the zstd-decompressed payload of a ZSTD1-blob, where the
+        //  "hi/lo byte packing" has not yet been reversed. We do this ourselves, and we write the result directly into the
+        //  destination buffer (instead of having libCZI unpack into an intermediate bitmap which we then have to copy).
+        bool hi_lo_byte_unpacking_pending = false;
+
+        switch (data_type)
+        {
+            case static_cast<std::underlying_type_t<imgdoc2::DataTypes>>(imgdoc2::DataTypes::JPGXRCOMPRESSED_BITMAP):
+                try
+                {
+                    const auto decoder = libCZI::GetDefaultSiteObject(libCZI::SiteObjectType::Default)->GetDecoder(ImageDecoderType::JPXR_JxrLib, nullptr);
+                    decoded_bitmap = decoder->Decode(compressed_data, compressed_data_size, libczi_pixel_type, bitmap_info->pixelWidth, bitmap_info->pixelHeight);
+                }
+                catch (const std::exception& e)
+                {
+                    ImgDoc2ApiSupport::FillOutErrorInformation(e, error_information);
+                    return ImgDoc2_ErrorCode_UnspecifiedError;
+                }
+
+                break;
+            case static_cast<std::underlying_type_t<imgdoc2::DataTypes>>(imgdoc2::DataTypes::ZSTD0COMPRESSED_BITMAP):
+                try
+                {
+                    const auto decoder = libCZI::GetDefaultSiteObject(libCZI::SiteObjectType::Default)->GetDecoder(ImageDecoderType::ZStd0, nullptr);
+                    decoded_bitmap = decoder->Decode(compressed_data, compressed_data_size, libczi_pixel_type, bitmap_info->pixelWidth, bitmap_info->pixelHeight);
+                }
+                catch (const std::exception& e)
+                {
+                    ImgDoc2ApiSupport::FillOutErrorInformation(e, error_information);
+                    return ImgDoc2_ErrorCode_UnspecifiedError;
+                }
+
+                break;
+            case static_cast<std::underlying_type_t<imgdoc2::DataTypes>>(imgdoc2::DataTypes::ZSTD1COMPRESSED_BITMAP):
+                try
+                {
+                    const Zstd1HeaderInfo zstd1_header_info = ParseZstd1Header(compressed_data, compressed_data_size);
+                    if (zstd1_header_info.header_size > 0 && zstd1_header_info.hi_lo_byte_packing && IsPixelTypeMadeUpOfWords(libczi_pixel_type))
+                    {
+                        // the payload (after the header) is a plain zstd-stream, so we can use the ZStd0-decoder to decompress it
+                        const auto decoder = libCZI::GetDefaultSiteObject(libCZI::SiteObjectType::Default)->GetDecoder(ImageDecoderType::ZStd0, nullptr);
+                        decoded_bitmap = decoder->Decode(
+                            static_cast<const std::uint8_t*>(compressed_data) + zstd1_header_info.header_size,
+                            compressed_data_size - zstd1_header_info.header_size,
+                            libczi_pixel_type,
+                            bitmap_info->pixelWidth,
+                            bitmap_info->pixelHeight);
+                        hi_lo_byte_unpacking_pending = true;
+                    }
+                    else
+                    {
+                        const auto decoder = libCZI::GetDefaultSiteObject(libCZI::SiteObjectType::Default)->GetDecoder(ImageDecoderType::ZStd1, nullptr);
+                        decoded_bitmap = decoder->Decode(compressed_data, compressed_data_size, libczi_pixel_type, bitmap_info->pixelWidth, bitmap_info->pixelHeight);
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    ImgDoc2ApiSupport::FillOutErrorInformation(e, error_information);
+                    return ImgDoc2_ErrorCode_UnspecifiedError;
+                }
+
+                break;
+            default:
+                ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("data_type", "is not supported", error_information);
+                return ImgDoc2_ErrorCode_InvalidArgument;
+        }
+
+        const ScopedBitmapLockerSP decoder_bitmap_locker(decoded_bitmap);
+
+        // the stride for the decoded image is either the one we happen to get from the decoder (in the case that no stride was passed in) or the one that was passed in
+        const std::uint32_t stride = destination_stride == 0 ? decoder_bitmap_locker.stride : destination_stride;
+
+        const uint64_t required_size = static_cast<uint64_t>(stride) * bitmap_info->pixelHeight;
+
+        void* destination = get_destination(stride, required_size);
+        if (destination == nullptr)
+        {
+            ImgDoc2ApiSupport::FillOutErrorInformationForAllocationFailure(required_size, error_information);
+            return ImgDoc2_ErrorCode_AllocationError;
+        }
+
+        const std::uint32_t line_length = bitmap_info->pixelWidth * libCZI::Utils::GetBytesPerPixel(decoded_bitmap->GetPixelType());
+        if (!hi_lo_byte_unpacking_pending)
+        {
+            PixelKernels::CopyWithStrideConversion(
+                decoder_bitmap_locker.ptrDataRoi,
+                decoder_bitmap_locker.stride,
+                line_length,
+                bitmap_info->pixelHeight,
+                destination,
+                stride);
+            return ImgDoc2_ErrorCode_OK;
+        }
+
+        // The packed data is a contiguous stream, which the decoder has written line-by-line into its bitmap. If this bitmap
+        //  happens to have padding at the end of the lines, we need to compact the data first.
+        const void* packed_data = decoder_bitmap_locker.ptrDataRoi;
+        std::unique_ptr<std::uint8_t[]> compacted_packed_data;
+        if (decoder_bitmap_locker.stride != line_length)
+        {
+            compacted_packed_data = std::make_unique<std::uint8_t[]>(static_cast<size_t>(line_length) * bitmap_info->pixelHeight);
+            PixelKernels::CopyWithStrideConversion(
+                decoder_bitmap_locker.ptrDataRoi,
+                decoder_bitmap_locker.stride,
+                line_length,
+                bitmap_info->pixelHeight,
+                compacted_packed_data.get(),
+                line_length);
+            packed_data = compacted_packed_data.get();
+        }
+
+        PixelKernels::UnpackHiLoBytes(
+            packed_data,
+            line_length / 2,
+            bitmap_info->pixelHeight,
+            destination,
+            stride);
+
+        return ImgDoc2_ErrorCode_OK;
+    }
+
+    /// Creates a handle referencing the specified bitmap (i.e. keeping it "pinned"), and optionally fills out the interop-structure
+    /// describing the bitmap.
+    ///
+    /// \param          bitmap          The bitmap.
+    /// \param [out]    bitmap_interop  If non-null, information about the bitmap is put here.
+    ///
+    /// \returns    The handle referencing the bitmap.
+    HandleDecodedBitmap CreateDecodedBitmapHandle(std::shared_ptr<const DecodedBitmapCache::Bitmap> bitmap, DecodedBitmapInterop* bitmap_interop)
+    {
+        if (bitmap_interop != nullptr)
+        {
+            bitmap_interop->pixelType = bitmap->pixel_type;
+            bitmap_interop->pixelWidth = bitmap->width;
+            bitmap_interop->pixelHeight = bitmap->height;
+            bitmap_interop->stride = bitmap->stride;
+            bitmap_interop->data = bitmap->data.get();
+        }
+
+        const auto wrapper = new SharedPtrWrapper<const DecodedBitmapCache::Bitmap>{ std::move(bitmap) };
+        return reinterpret_cast<HandleDecodedBitmap>(wrapper);
     }
 }
 
@@ -58,49 +350,262 @@ ImgDoc2ErrorCode DecodeImage(
                 DecodedImageResultInterop* result,
                 ImgDoc2ErrorInformation* error_information)
 {
-    if (bitmap_info == nullptr)
+    if (allocate_memory_function == nullptr)
     {
-        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("bitmap_info", "must not be null", error_information);
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("allocate_memory_function", "must not be null", error_information);
         return ImgDoc2_ErrorCode_InvalidArgument;
     }
 
-    if (bitmap_info->pixelWidth == 0 || bitmap_info->pixelHeight == 0)
+    if (result == nullptr)
     {
-        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("bitmap_info", "pixelWidth and pixelHeight must be greater than 0", error_information);
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("result", "must not be null", error_information);
         return ImgDoc2_ErrorCode_InvalidArgument;
     }
 
-    if (compressed_data_size == 0)
+    return DecodeImageInternal(
+        bitmap_info,
+        data_type,
+        compressed_data,
+        compressed_data_size,
+        destination_stride,
+        [&](std::uint32_t stride, std::uint64_t size) -> void*
+        {
+            if (!allocate_memory_function(size, &result->bitmap))
+            {
+                return nullptr;
+            }
+
+            result->stride = stride;
+            return result->bitmap.pointer_to_memory;
+        },
+        error_information);
+}
+
+ImgDoc2ErrorCode DecodeImageIntoBuffer(
+                const BitmapInfoInterop* bitmap_info,
+                std::uint8_t data_type,
+                const void* compressed_data,
+                std::uint64_t compressed_data_size,
+                void* destination,
+                std::uint32_t destination_stride,
+                std::uint64_t destination_size,
+                ImgDoc2ErrorInformation* error_information)
+{
+    if (destination == nullptr)
     {
-        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("compressed_data_size", "must be greater than 0", error_information);
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("destination", "must not be null", error_information);
         return ImgDoc2_ErrorCode_InvalidArgument;
     }
 
-    if (compressed_data == nullptr)
+    if (destination_stride == 0)
     {
-        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("compressed_data", "must not be null", error_information);
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("destination_stride", "must be greater than 0", error_information);
         return ImgDoc2_ErrorCode_InvalidArgument;
     }
 
-    if (allocate_memory_function == nullptr)
+    if (bitmap_info != nullptr && destination_size < static_cast<std::uint64_t>(destination_stride) * bitmap_info->pixelHeight)
     {
-        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("allocate_memory_function", "must not be null", error_information);
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("destination_size", "must be greater than or equal to destination_stride * pixelHeight", error_information);
         return ImgDoc2_ErrorCode_InvalidArgument;
     }
 
-    if (result == nullptr)
+    return DecodeImageInternal(
+        bitmap_info,
+        data_type,
+        compressed_data,
+        compressed_data_size,
+        destination_stride,
+        [destination](std::uint32_t, std::uint64_t) -> void*
+        {
+            return destination;
+        },
+        error_information);
+}
+
+ImgDoc2ErrorCode DecodeImages(
+                DecodeImageJobInterop* jobs,
+                std::uint32_t job_count,
+                std::uint32_t max_number_of_threads,
+                ImgDoc2ErrorInformation* error_information)
+{
+    if (jobs == nullptr && job_count > 0)
     {
-        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("result", "must not be null", error_information);
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("jobs", "must not be null", error_information);
         return ImgDoc2_ErrorCode_InvalidArgument;
     }
 
-    if (destination_stride > 0)
+    // the error information of the first failed job (i.e. the failed job with the lowest index) is reported
+    std::mutex first_failure_mutex;
+    std::uint32_t first_failure_index = job_count;
+    ImgDoc2ErrorInformation first_failure_error_information{};
+
+    try
     {
-        if (destination_stride < bitmap_info->pixelWidth * libCZI::Utils::GetBytesPerPixel(ConvertToLibCziPixelType(bitmap_info->pixelType)))
+        ParallelExecution::Run(
+            max_number_of_threads == 0 ? ParallelExecution::GetDefaultNumberOfThreads() : max_number_of_threads,
+            job_count,
+            [&](size_t index)
+            {
+                DecodeImageJobInterop& job = jobs[index];
+                ImgDoc2ErrorInformation job_error_information{};
+                job.result = DecodeImageIntoBuffer(
+                    &job.bitmap_info,
+                    job.data_type,
+                    job.compressed_data,
+                    job.compressed_data_size,
+                    job.destination,
+                    job.destination_stride,
+                    job.destination_size,
+                    &job_error_information);
+
+                if (job.result != ImgDoc2_ErrorCode_OK)
+                {
+                    const std::lock_guard<std::mutex> lock(first_failure_mutex);
+                    if (index < first_failure_index)
+                    {
+                        first_failure_index = static_cast<std::uint32_t>(index);
+                        first_failure_error_information = job_error_information;
+                    }
+                }
+            });
+    }
+    catch (const std::exception& e)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformation(e, error_information);
+        return ImgDoc2_ErrorCode_UnspecifiedError;
+    }
+
+    if (first_failure_index < job_count)
+    {
+        if (error_information != nullptr)
         {
-            ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("destination_stride", "must be either be zero (which means that the stride is chosen by this function) or greater than or equal to pixelWidth * bytes per pixel", error_information);
-            return ImgDoc2_ErrorCode_InvalidArgument;
+            *error_information = first_failure_error_information;
         }
+
+        return jobs[first_failure_index].result;
+    }
+
+    return ImgDoc2_ErrorCode_OK;
+}
+
+ImgDoc2ErrorCode CreateDecodedBitmapCache(
+                std::uint64_t max_memory_size,
+                std::uint32_t number_of_shards,
+                HandleDecodedBitmapCache* cache,
+                ImgDoc2ErrorInformation* error_information)
+{
+    if (cache == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("cache", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    if (max_memory_size == 0)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("max_memory_size", "must be greater than 0", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    try
+    {
+        const auto wrapper = new SharedPtrWrapper<DecodedBitmapCache>{ std::make_shared<DecodedBitmapCache>(max_memory_size, number_of_shards) };
+        *cache = reinterpret_cast<HandleDecodedBitmapCache>(wrapper);
+    }
+    catch (const std::exception& e)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformation(e, error_information);
+        return ImgDoc2_ErrorCode_UnspecifiedError;
+    }
+
+    return ImgDoc2_ErrorCode_OK;
+}
+
+ImgDoc2ErrorCode DestroyDecodedBitmapCache(HandleDecodedBitmapCache handle, ImgDoc2ErrorInformation* error_information)
+{
+    const auto object = reinterpret_cast<SharedPtrWrapper<DecodedBitmapCache>*>(handle);  // NOLINT(performance-no-int-to-ptr)
+    if (!object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleDecodedBitmapCache", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    delete object;
+    return ImgDoc2_ErrorCode_OK;
+}
+
+ImgDoc2ErrorCode DecodedBitmapCache_TryGet(
+                HandleDecodedBitmapCache cache,
+                const DecodedBitmapCacheKeyInterop* key,
+                HandleDecodedBitmap* bitmap,
+                DecodedBitmapInterop* bitmap_interop,
+                ImgDoc2ErrorInformation* error_information)
+{
+    if (key == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("key", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    if (bitmap == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("bitmap", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    const auto object = reinterpret_cast<SharedPtrWrapper<DecodedBitmapCache>*>(cache);  // NOLINT(performance-no-int-to-ptr)
+    if (!object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleDecodedBitmapCache", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    auto cached_bitmap = object->shared_ptr_->Get(DecodedBitmapCache::Key{ key->document_id, key->tile_index });
+    *bitmap = cached_bitmap ? CreateDecodedBitmapHandle(std::move(cached_bitmap), bitmap_interop) : kInvalidObjectHandle;
+    return ImgDoc2_ErrorCode_OK;
+}
+
+ImgDoc2ErrorCode DecodeImageWithCache(
+                HandleDecodedBitmapCache cache,
+                const DecodedBitmapCacheKeyInterop* key,
+                const BitmapInfoInterop* bitmap_info,
+                std::uint8_t data_type,
+                const void* compressed_data,
+                std::uint64_t compressed_data_size,
+                HandleDecodedBitmap* bitmap,
+                DecodedBitmapInterop* bitmap_interop,
+                ImgDoc2ErrorInformation* error_information)
+{
+    if (key == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("key", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    if (bitmap == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("bitmap", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    const auto object = reinterpret_cast<SharedPtrWrapper<DecodedBitmapCache>*>(cache);  // NOLINT(performance-no-int-to-ptr)
+    if (!object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleDecodedBitmapCache", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    const DecodedBitmapCache::Key cache_key{ key->document_id, key->tile_index };
+    auto cached_bitmap = object->shared_ptr_->Get(cache_key);
+    if (cached_bitmap)
+    {
+        *bitmap = CreateDecodedBitmapHandle(std::move(cached_bitmap), bitmap_interop);
+        return ImgDoc2_ErrorCode_OK;
+    }
+
+    if (bitmap_info == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("bitmap_info", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
     }
 
     const libCZI::PixelType libczi_pixel_type = ConvertToLibCziPixelType(bitmap_info->pixelType);
@@ -110,76 +615,200 @@ ImgDoc2ErrorCode DecodeImage(
         return ImgDoc2_ErrorCode_InvalidArgument;
     }
 
-    std::shared_ptr<libCZI::IBitmapData> decoded_bitmap;
+    const auto decoded_bitmap = std::make_shared<DecodedBitmapCache::Bitmap>();
+    decoded_bitmap->pixel_type = bitmap_info->pixelType;
+    decoded_bitmap->width = bitmap_info->pixelWidth;
+    decoded_bitmap->height = bitmap_info->pixelHeight;
+    decoded_bitmap->stride = bitmap_info->pixelWidth * libCZI::Utils::GetBytesPerPixel(libczi_pixel_type);
 
-    switch (data_type)
+    const auto start_time = std::chrono::steady_clock::now();
+    const ImgDoc2ErrorCode error_code = DecodeImageInternal(
+        bitmap_info,
+        data_type,
+        compressed_data,
+        compressed_data_size,
+        decoded_bitmap->stride,
+        [&decoded_bitmap](std::uint32_t, std::uint64_t size) -> void*
+        {
+            decoded_bitmap->data = std::shared_ptr<void>(new(std::nothrow) std::uint8_t[static_cast<size_t>(size)], std::default_delete<std::uint8_t[]>());
+            return decoded_bitmap->data.get();
+        },
+        error_information);
+    if (error_code != ImgDoc2_ErrorCode_OK)
     {
-        case static_cast<std::underlying_type_t<imgdoc2::DataTypes>>(imgdoc2::DataTypes::JPGXRCOMPRESSED_BITMAP):
-            try
-            {
-                const auto decoder = libCZI::GetDefaultSiteObject(libCZI::SiteObjectType::Default)->GetDecoder(ImageDecoderType::JPXR_JxrLib, nullptr);
-                decoded_bitmap = decoder->Decode(compressed_data, compressed_data_size, libczi_pixel_type, bitmap_info->pixelWidth, bitmap_info->pixelHeight);
-            }
-            catch (const std::exception& e)
-            {
-                ImgDoc2ApiSupport::FillOutErrorInformation(e, error_information);
-                return ImgDoc2_ErrorCode_UnspecifiedError;
-            }
+        return error_code;
+    }
 
-            break;
-        case static_cast<std::underlying_type_t<imgdoc2::DataTypes>>(imgdoc2::DataTypes::ZSTD0COMPRESSED_BITMAP):
-            try
-            {
-                const auto decoder = libCZI::GetDefaultSiteObject(libCZI::SiteObjectType::Default)->GetDecoder(ImageDecoderType::ZStd0, nullptr);
-                decoded_bitmap = decoder->Decode(compressed_data, compressed_data_size, libczi_pixel_type, bitmap_info->pixelWidth, bitmap_info->pixelHeight);
-            }
-            catch (const std::exception& e)
-            {
-                ImgDoc2ApiSupport::FillOutErrorInformation(e, error_information);
-                return ImgDoc2_ErrorCode_UnspecifiedError;
-            }
+    try
+    {
+        cached_bitmap = object->shared_ptr_->Add(cache_key, decoded_bitmap, std::chrono::steady_clock::now() - start_time);
+    }
+    catch (const std::exception& e)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformation(e, error_information);
+        return ImgDoc2_ErrorCode_UnspecifiedError;
+    }
 
-            break;
-        case static_cast<std::underlying_type_t<imgdoc2::DataTypes>>(imgdoc2::DataTypes::ZSTD1COMPRESSED_BITMAP):
-            try
-            {
-                const auto decoder = libCZI::GetDefaultSiteObject(libCZI::SiteObjectType::Default)->GetDecoder(ImageDecoderType::ZStd1, nullptr);
-                decoded_bitmap = decoder->Decode(compressed_data, compressed_data_size, libczi_pixel_type, bitmap_info->pixelWidth, bitmap_info->pixelHeight);
-            }
-            catch (const std::exception& e)
-            {
-                ImgDoc2ApiSupport::FillOutErrorInformation(e, error_information);
-                return ImgDoc2_ErrorCode_UnspecifiedError;
-            }
+    *bitmap = CreateDecodedBitmapHandle(std::move(cached_bitmap), bitmap_interop);
+    return ImgDoc2_ErrorCode_OK;
+}
 
-            break;
-        default:
-            ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("data_type", "is not supported", error_information);
-            return ImgDoc2_ErrorCode_InvalidArgument;
+ImgDoc2ErrorCode ReleaseDecodedBitmap(HandleDecodedBitmap handle, ImgDoc2ErrorInformation* error_information)
+{
+    const auto object = reinterpret_cast<SharedPtrWrapper<const DecodedBitmapCache::Bitmap>*>(handle);  // NOLINT(performance-no-int-to-ptr)
+    if (!object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleDecodedBitmap", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
     }
 
-    const ScopedBitmapLockerSP decoder_bitmap_locker(decoded_bitmap);
+    delete object;
+    return ImgDoc2_ErrorCode_OK;
+}
 
-    // the stride for the decoded image is either the one we happen to get from the decoder (in the case that no stride was passed in) or the one that was passed in
-    result->stride = destination_stride == 0 ? decoder_bitmap_locker.stride : destination_stride;
+ImgDoc2ErrorCode DecodedBitmapCache_RemoveDocument(
+                HandleDecodedBitmapCache cache,
+                std::uint64_t document_id,
+                ImgDoc2ErrorInformation* error_information)
+{
+    const auto object = reinterpret_cast<SharedPtrWrapper<DecodedBitmapCache>*>(cache);  // NOLINT(performance-no-int-to-ptr)
+    if (!object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleDecodedBitmapCache", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
 
-    const uint64_t required_size = static_cast<uint64_t>(result->stride) * bitmap_info->pixelHeight;
+    object->shared_ptr_->RemoveDocument(document_id);
+    return ImgDoc2_ErrorCode_OK;
+}
 
-    const bool success = allocate_memory_function(required_size, &result->bitmap);
+ImgDoc2ErrorCode DecodedBitmapCache_GetStatistics(
+                HandleDecodedBitmapCache cache,
+                DecodedBitmapCacheStatisticsInterop* statistics,
+                ImgDoc2ErrorInformation* error_information)
+{
+    if (statistics == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("statistics", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    const auto object = reinterpret_cast<SharedPtrWrapper<DecodedBitmapCache>*>(cache);  // NOLINT(performance-no-int-to-ptr)
+    if (!object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleDecodedBitmapCache", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    const auto cache_statistics = object->shared_ptr_->GetStatistics();
+    statistics->hits = cache_statistics.hits;
+    statistics->misses = cache_statistics.misses;
+    statistics->insertions = cache_statistics.insertions;
+    statistics->evictions = cache_statistics.evictions;
+    statistics->memory_usage = cache_statistics.memory_usage;
+    statistics->number_of_entries = cache_statistics.number_of_entries;
+    return ImgDoc2_ErrorCode_OK;
+}
+
+ImgDoc2ErrorCode ConvertBitmapWithWindow(
+                const BitmapInfoInterop* source_bitmap_info,
+                const void* source,
+                std::uint32_t source_stride,
+                std::uint8_t destination_pixel_type,
+                double window_minimum,
+                double window_maximum,
+                void* destination,
+                std::uint32_t destination_stride,
+                ImgDoc2ErrorInformation* error_information)
+{
+    if (!CheckConversionArguments(source_bitmap_info, source, source_stride, destination_pixel_type, destination, destination_stride, error_information))
+    {
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    if (!(window_maximum > window_minimum))
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("window_maximum", "must be greater than window_minimum", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    const bool success = PixelKernels::ConvertWithWindow(
+        source_bitmap_info->pixelType,
+        source,
+        source_stride,
+        source_bitmap_info->pixelWidth,
+        source_bitmap_info->pixelHeight,
+        window_minimum,
+        window_maximum,
+        destination_pixel_type,
+        destination,
+        destination_stride);
     if (!success)
     {
-        ImgDoc2ApiSupport::FillOutErrorInformationForAllocationFailure(required_size, error_information);
-        return ImgDoc2_ErrorCode_AllocationError;
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("destination_pixel_type", "the conversion is not supported", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    return ImgDoc2_ErrorCode_OK;
+}
+
+ImgDoc2ErrorCode CreateWindowLookUpTable(
+                double window_minimum,
+                double window_maximum,
+                double gamma,
+                std::uint8_t* look_up_table,
+                ImgDoc2ErrorInformation* error_information)
+{
+    if (look_up_table == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("look_up_table", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    if (!PixelKernels::FillWindowLookUpTable(window_minimum, window_maximum, gamma, look_up_table))
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("window_maximum/gamma", "window_maximum must be greater than window_minimum, and gamma must be positive", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    return ImgDoc2_ErrorCode_OK;
+}
+
+ImgDoc2ErrorCode ConvertBitmapWithLookUpTable(
+                const BitmapInfoInterop* source_bitmap_info,
+                const void* source,
+                std::uint32_t source_stride,
+                const std::uint8_t* look_up_table,
+                void* destination,
+                std::uint32_t destination_stride,
+                ImgDoc2ErrorInformation* error_information)
+{
+    if (look_up_table == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("look_up_table", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    if (source_bitmap_info != nullptr && source_bitmap_info->pixelType != imgdoc2::PixelType::Gray16 && source_bitmap_info->pixelType != imgdoc2::PixelType::Bgr48)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("source_bitmap_info", "pixelType must be Gray16 or Bgr48", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
     }
 
-    CopyWithStrideConversion(
-        decoder_bitmap_locker.ptrDataRoi,
-        decoder_bitmap_locker.stride,
-        decoded_bitmap->GetPixelType(),
-        bitmap_info->pixelWidth,
-        bitmap_info->pixelHeight,
-        result->bitmap.pointer_to_memory,
-        result->stride);
+    const std::uint8_t destination_pixel_type = source_bitmap_info != nullptr && source_bitmap_info->pixelType == imgdoc2::PixelType::Bgr48 ? imgdoc2::PixelType::Bgr24 : imgdoc2::PixelType::Gray8;
+    if (!CheckConversionArguments(source_bitmap_info, source, source_stride, destination_pixel_type, destination, destination_stride, error_information))
+    {
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
 
+    PixelKernels::ConvertWithLookUpTable(
+        source_bitmap_info->pixelType,
+        source,
+        source_stride,
+        source_bitmap_info->pixelWidth,
+        source_bitmap_info->pixelHeight,
+        look_up_table,
+        destination,
+        destination_stride);
     return ImgDoc2_ErrorCode_OK;
 }
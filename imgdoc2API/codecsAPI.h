@@ -9,6 +9,16 @@
 #include "errorcodes.h"
 #include "bitmapinfointerop.h"
 #include "decodedimageresultinterop.h"
+#include "decodeimagejobinterop.h"
+#include "decodedbitmapcachekeyinterop.h"
+#include "decodedbitmapinterop.h"
+#include "decodedbitmapcachestatisticsinterop.h"
+
+/// Defines an alias representing the handle of a decoded-bitmap-cache object.
+typedef ObjectHandle HandleDecodedBitmapCache;
+
+/// Defines an alias representing the handle of a decoded bitmap held by a decoded-bitmap-cache.
+typedef ObjectHandle HandleDecodedBitmap;
 
 /// Decodes the specified compressed data into an uncompressed bitmap. This destination bitmap is allocated
 /// by a user provided function. The caller may either provide a stride it expects the destination bitmap to be
@@ -36,3 +46,212 @@ EXTERNAL_API(ImgDoc2ErrorCode) DecodeImage(
                 DecodedImageResultInterop* result,
                 ImgDoc2ErrorInformation* error_information);
 
+/// Decodes the specified compressed data directly into a destination bitmap provided by the caller (i.e. without an allocation
+/// on behalf of the caller).
+///
+/// \param          bitmap_info             Information describing the (compressed) bitmap. If this information turns out to be not
+///                                         corresponding to the actual data, the function will return an error.
+/// \param          data_type               The type of the compression (corresponding to imgdoc2::DataTypes).
+/// \param          compressed_data         Pointer to the compressed data.
+/// \param          compressed_data_size    Size of the compressed data in bytes.
+/// \param [out]    destination             Pointer to the destination bitmap.
+/// \param          destination_stride      The stride of the destination bitmap (in bytes), which must be greater than or equal to pixelWidth * bytes per pixel.
+/// \param          destination_size        The size of the destination buffer in bytes, which must be at least destination_stride * pixelHeight.
+/// \param [in,out] error_information       If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns    An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) DecodeImageIntoBuffer(
+                const BitmapInfoInterop* bitmap_info,
+                std::uint8_t data_type,
+                const void* compressed_data,
+                std::uint64_t compressed_data_size,
+                void* destination,
+                std::uint32_t destination_stride,
+                std::uint64_t destination_size,
+                ImgDoc2ErrorInformation* error_information);
+
+/// Decodes a batch of images concurrently. Each job gives the compressed data and the destination bitmap (which is provided by
+/// the caller, and which must be large enough to hold the decoded bitmap with the given stride). The jobs are executed on
+/// an internal pool of threads (where the calling thread is one of them), and the result of each job is reported in its
+/// "result" field. A failing job does not affect the other jobs.
+///
+/// \param          jobs                    The jobs (an array with job_count elements).
+/// \param          job_count               The number of jobs.
+/// \param          max_number_of_threads   The maximal number of threads to use, where 0 means "use the number of hardware threads".
+/// \param [in,out] error_information       If non-null, in case of an error, additional information describing the error are put here
+///                                         (if jobs failed, this is the information for the failed job with the lowest index).
+///
+/// \returns    ImgDoc2_ErrorCode_OK if all jobs were successful; otherwise the error-code of the failed job with the lowest index.
+EXTERNAL_API(ImgDoc2ErrorCode) DecodeImages(
+                DecodeImageJobInterop* jobs,
+                std::uint32_t job_count,
+                std::uint32_t max_number_of_threads,
+                ImgDoc2ErrorInformation* error_information);
+
+/// Creates a decoded-bitmap-cache object, i.e. a thread-safe cache for decoded bitmaps (identified by a document-id chosen by
+/// the caller and the index of the tile) with a memory budget. When the budget is exceeded, the bitmaps which are cheapest
+/// to reproduce (i.e. with the lowest decode time per byte) and which have not been used recently are evicted. The cache
+/// is divided into shards (with the memory budget distributed evenly), so that concurrent accesses rarely contend.
+///
+/// \param          max_memory_size     The maximal size of the bitmap data held by the cache (in bytes).
+/// \param          number_of_shards    The number of shards, where 0 means "use the default number of shards".
+/// \param [out]    cache               If successful, the handle of the newly created cache object is put here.
+/// \param [in,out] error_information   If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns    An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) CreateDecodedBitmapCache(
+                std::uint64_t max_memory_size,
+                std::uint32_t number_of_shards,
+                HandleDecodedBitmapCache* cache,
+                ImgDoc2ErrorInformation* error_information);
+
+/// Destroys the decoded-bitmap-cache object. Bitmaps which are still referenced by a handle remain valid until the
+/// handle is released.
+///
+/// \param          handle              Handle of the decoded-bitmap-cache object (which is to be destroyed).
+/// \param [in,out] error_information   If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns    An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) DestroyDecodedBitmapCache(HandleDecodedBitmapCache handle, ImgDoc2ErrorInformation* error_information);
+
+/// Looks up the bitmap with the specified key in the cache. If it is found, a handle referencing the bitmap is returned,
+/// which keeps the bitmap valid (even if it is evicted from the cache) until it is released with ReleaseDecodedBitmap.
+///
+/// \param          cache               Handle of the decoded-bitmap-cache object.
+/// \param          key                 The key of the bitmap.
+/// \param [out]    bitmap              If the bitmap is found, the handle referencing it is put here; otherwise kInvalidObjectHandle.
+/// \param [out]    bitmap_interop      If non-null and the bitmap is found, information about the bitmap is put here.
+/// \param [in,out] error_information   If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns    An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) DecodedBitmapCache_TryGet(
+                HandleDecodedBitmapCache cache,
+                const DecodedBitmapCacheKeyInterop* key,
+                HandleDecodedBitmap* bitmap,
+                DecodedBitmapInterop* bitmap_interop,
+                ImgDoc2ErrorInformation* error_information);
+
+/// Decodes the specified compressed data (as with DecodeImage) and adds the result to the cache - or, if the bitmap with
+/// the specified key is already in the cache, the cached bitmap is used without decoding the data. The returned handle
+/// references the bitmap and keeps it valid until it is released with ReleaseDecodedBitmap. The decoded bitmap has the
+/// minimal stride (i.e. pixelWidth * bytes per pixel).
+///
+/// \param          cache                   Handle of the decoded-bitmap-cache object.
+/// \param          key                     The key of the bitmap.
+/// \param          bitmap_info             Information describing the (compressed) bitmap.
+/// \param          data_type               The type of the compression (corresponding to imgdoc2::DataTypes).
+/// \param          compressed_data         Pointer to the compressed data.
+/// \param          compressed_data_size    Size of the compressed data in bytes.
+/// \param [out]    bitmap                  If successful, the handle referencing the bitmap is put here.
+/// \param [out]    bitmap_interop          If non-null and successful, information about the bitmap is put here.
+/// \param [in,out] error_information       If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns    An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) DecodeImageWithCache(
+                HandleDecodedBitmapCache cache,
+                const DecodedBitmapCacheKeyInterop* key,
+                const BitmapInfoInterop* bitmap_info,
+                std::uint8_t data_type,
+                const void* compressed_data,
+                std::uint64_t compressed_data_size,
+                HandleDecodedBitmap* bitmap,
+                DecodedBitmapInterop* bitmap_interop,
+                ImgDoc2ErrorInformation* error_information);
+
+/// Releases the reference to a bitmap obtained with DecodedBitmapCache_TryGet or DecodeImageWithCache.
+///
+/// \param          handle              Handle of the bitmap (which is to be released).
+/// \param [in,out] error_information   If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns    An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) ReleaseDecodedBitmap(HandleDecodedBitmap handle, ImgDoc2ErrorInformation* error_information);
+
+/// Removes all bitmaps of the specified document from the cache (e.g. because the document was modified or closed).
+///
+/// \param          cache               Handle of the decoded-bitmap-cache object.
+/// \param          document_id         The identifier of the document.
+/// \param [in,out] error_information   If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns    An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) DecodedBitmapCache_RemoveDocument(
+                HandleDecodedBitmapCache cache,
+                std::uint64_t document_id,
+                ImgDoc2ErrorInformation* error_information);
+
+/// Gets statistics about the usage of the cache.
+///
+/// \param          cache               Handle of the decoded-bitmap-cache object.
+/// \param [out]    statistics          The statistics are put here.
+/// \param [in,out] error_information   If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns    An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) DecodedBitmapCache_GetStatistics(
+                HandleDecodedBitmapCache cache,
+                DecodedBitmapCacheStatisticsInterop* statistics,
+                ImgDoc2ErrorInformation* error_information);
+
+/// Converts a bitmap to a pixel type with a smaller range by mapping the source values linearly ("window/level"), i.e. the
+/// value window_minimum is mapped to zero, the value window_maximum is mapped to the maximal value of the destination pixel
+/// type, and values outside of the window are clamped. The following conversions are supported: Gray16 to Gray8, Bgr48 to
+/// Bgr24, Gray32Float to Gray8 and Gray32Float to Gray16. The destination bitmap (of the same width and height as the source)
+/// is provided by the caller.
+///
+/// \param          source_bitmap_info      Information describing the source bitmap.
+/// \param          source                  Pointer to the source bitmap.
+/// \param          source_stride           The stride of the source bitmap (in bytes).
+/// \param          destination_pixel_type  The pixel type of the destination bitmap.
+/// \param          window_minimum          The source value which is mapped to zero.
+/// \param          window_maximum          The source value which is mapped to the maximal value of the destination pixel type.
+/// \param          destination             Pointer to the destination bitmap.
+/// \param          destination_stride      The stride of the destination bitmap (in bytes).
+/// \param [in,out] error_information       If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns    An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) ConvertBitmapWithWindow(
+                const BitmapInfoInterop* source_bitmap_info,
+                const void* source,
+                std::uint32_t source_stride,
+                std::uint8_t destination_pixel_type,
+                double window_minimum,
+                double window_maximum,
+                void* destination,
+                std::uint32_t destination_stride,
+                ImgDoc2ErrorInformation* error_information);
+
+/// Fills a look-up table for use with ConvertBitmapWithLookUpTable. The values are mapped linearly (as with ConvertBitmapWithWindow)
+/// to the range [0,1], then a gamma-correction is applied and the result is scaled to the range [0,255].
+///
+/// \param          window_minimum      The value which is mapped to zero.
+/// \param          window_maximum      The value which is mapped to 255.
+/// \param          gamma               The exponent of the gamma-correction (1 means "linear mapping").
+/// \param [out]    look_up_table       The look-up table, which must have space for 65536 elements.
+/// \param [in,out] error_information   If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns    An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) CreateWindowLookUpTable(
+                double window_minimum,
+                double window_maximum,
+                double gamma,
+                std::uint8_t* look_up_table,
+                ImgDoc2ErrorInformation* error_information);
+
+/// Converts a bitmap of pixel type Gray16 to Gray8 (or Bgr48 to Bgr24) by mapping each value (each channel respectively) with
+/// the specified look-up table. The destination bitmap (of the same width and height as the source) is provided by the caller.
+///
+/// \param          source_bitmap_info  Information describing the source bitmap.
+/// \param          source              Pointer to the source bitmap.
+/// \param          source_stride       The stride of the source bitmap (in bytes).
+/// \param          look_up_table       The look-up table with 65536 elements.
+/// \param          destination         Pointer to the destination bitmap.
+/// \param          destination_stride  The stride of the destination bitmap (in bytes).
+/// \param [in,out] error_information   If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns    An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) ConvertBitmapWithLookUpTable(
+                const BitmapInfoInterop* source_bitmap_info,
+                const void* source,
+                std::uint32_t source_stride,
+                const std::uint8_t* look_up_table,
+                void* destination,
+                std::uint32_t destination_stride,
+                ImgDoc2ErrorInformation* error_information);
@@ -0,0 +1,164 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include "decodedbitmapcache.h"
+#include "operationstatistics.h"
+#include <algorithm>
+#include <utility>
+
+using namespace std;
+using namespace imgdoc2;
+
+size_t DecodedBitmapCache::KeyHash::operator()(const Key& key) const
+{
+    // combine the two values and apply the finalizer of "splitmix64", so that all bits of the result are well mixed (the
+    //  lower bits are used for choosing the shard, and the hash map is using the hash as well)
+    uint64_t value = key.document_id * 0x9E3779B97F4A7C15ULL + static_cast<uint64_t>(key.tile_index);
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return static_cast<size_t>(value ^ (value >> 31));
+}
+
+DecodedBitmapCache::DecodedBitmapCache(std::uint64_t max_memory_size, std::uint32_t number_of_shards)
+{
+    if (max_memory_size == 0)
+    {
+        throw invalid_argument_exception("The maximal memory size must be greater than zero.");
+    }
+
+    this->number_of_shards_ = number_of_shards > 0 ? number_of_shards : DecodedBitmapCache::kDefaultNumberOfShards;
+    this->max_memory_size_per_shard_ = max(max_memory_size / this->number_of_shards_, static_cast<uint64_t>(1));
+    this->shards_ = make_unique<Shard[]>(this->number_of_shards_);
+}
+
+std::shared_ptr<const DecodedBitmapCache::Bitmap> DecodedBitmapCache::Get(const Key& key)
+{
+    Shard& shard = this->GetShard(key);
+    const lock_guard<mutex> lock(shard.mutex);
+    const auto iterator = shard.entries.find(key);
+    if (iterator == shard.entries.end())
+    {
+        ++this->misses_;
+        OperationStatistics::GetInstance().AddDecodedBitmapCacheMiss();
+        return nullptr;
+    }
+
+    ++this->hits_;
+    OperationStatistics::GetInstance().AddDecodedBitmapCacheHit();
+
+    // the priority of the entry is raised to the current inflation value plus its cost (re-using the node of the
+    //  multimap, so that no allocation is necessary)
+    Entry& entry = iterator->second;
+    auto node = shard.eviction_order.extract(entry.eviction_order_position);
+    node.key() = shard.inflation + entry.cost_per_byte;
+    entry.eviction_order_position = shard.eviction_order.insert(std::move(node));
+    return entry.bitmap;
+}
+
+std::shared_ptr<const DecodedBitmapCache::Bitmap> DecodedBitmapCache::Add(const Key& key, std::shared_ptr<const Bitmap> bitmap, std::chrono::nanoseconds decode_time)
+{
+    if (!bitmap)
+    {
+        throw invalid_argument_exception("The bitmap must not be null.");
+    }
+
+    const uint64_t size = bitmap->GetSize();
+    if (size > this->max_memory_size_per_shard_)
+    {
+        return bitmap;
+    }
+
+    Shard& shard = this->GetShard(key);
+    const lock_guard<mutex> lock(shard.mutex);
+    const auto iterator = shard.entries.find(key);
+    if (iterator != shard.entries.end())
+    {
+        return iterator->second.bitmap;
+    }
+
+    // the cost is the decode time (in microseconds, and at least 1, so that also bitmaps with a negligible decode time
+    //  are ordered by their size)
+    const double cost = max(chrono::duration<double, micro>(decode_time).count(), 1.0);
+    Entry entry;
+    entry.bitmap = bitmap;
+    entry.cost_per_byte = cost / static_cast<double>(max(size, static_cast<uint64_t>(1)));
+    entry.eviction_order_position = shard.eviction_order.emplace(shard.inflation + entry.cost_per_byte, key);
+    shard.entries.emplace(key, std::move(entry));
+    shard.memory_usage += size;
+    ++this->insertions_;
+
+    this->EvictIfNecessary(shard);
+    return bitmap;
+}
+
+void DecodedBitmapCache::RemoveDocument(std::uint64_t document_id)
+{
+    for (uint32_t i = 0; i < this->number_of_shards_; ++i)
+    {
+        Shard& shard = this->shards_[i];
+        const lock_guard<mutex> lock(shard.mutex);
+        for (auto iterator = shard.entries.begin(); iterator != shard.entries.end();)
+        {
+            const auto current = iterator++;
+            if (current->first.document_id == document_id)
+            {
+                DecodedBitmapCache::RemoveEntry(shard, current);
+            }
+        }
+    }
+}
+
+void DecodedBitmapCache::Clear()
+{
+    for (uint32_t i = 0; i < this->number_of_shards_; ++i)
+    {
+        Shard& shard = this->shards_[i];
+        const lock_guard<mutex> lock(shard.mutex);
+        shard.entries.clear();
+        shard.eviction_order.clear();
+        shard.inflation = 0;
+        shard.memory_usage = 0;
+    }
+}
+
+DecodedBitmapCache::Statistics DecodedBitmapCache::GetStatistics() const
+{
+    Statistics statistics;
+    statistics.hits = this->hits_.load();
+    statistics.misses = this->misses_.load();
+    statistics.insertions = this->insertions_.load();
+    statistics.evictions = this->evictions_.load();
+    for (uint32_t i = 0; i < this->number_of_shards_; ++i)
+    {
+        Shard& shard = this->shards_[i];
+        const lock_guard<mutex> lock(shard.mutex);
+        statistics.memory_usage += shard.memory_usage;
+        statistics.number_of_entries += shard.entries.size();
+    }
+
+    return statistics;
+}
+
+DecodedBitmapCache::Shard& DecodedBitmapCache::GetShard(const Key& key) const
+{
+    return this->shards_[KeyHash{}(key) % this->number_of_shards_];
+}
+
+void DecodedBitmapCache::EvictIfNecessary(Shard& shard)
+{
+    while (shard.memory_usage > this->max_memory_size_per_shard_ && !shard.eviction_order.empty())
+    {
+        const auto victim = shard.eviction_order.begin();
+        shard.inflation = victim->first;
+        DecodedBitmapCache::RemoveEntry(shard, shard.entries.find(victim->second));
+        ++this->evictions_;
+    }
+}
+
+/*static*/void DecodedBitmapCache::RemoveEntry(Shard& shard, std::unordered_map<Key, Entry, KeyHash>::iterator iterator)
+{
+    shard.memory_usage -= iterator->second.bitmap->GetSize();
+    shard.eviction_order.erase(iterator->second.eviction_order_position);
+    shard.entries.erase(iterator);
+}
@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <imgdoc2.h>
+
+/// This class is a cache for decoded bitmaps (i.e. the result of decoding the data of a tile), where a bitmap is identified
+/// by a document-id (which is chosen by the user of the cache) and the index of the tile. The cache is thread-safe, and it
+/// is divided into shards (where each shard is protected by its own mutex), so that concurrent accesses only contend if they
+/// happen to go to the same shard. The memory budget is distributed evenly over the shards.
+/// When a shard exceeds its budget, bitmaps are evicted following the "GreedyDual-Size" policy - the priority of a bitmap
+/// is its "cost" (i.e. the time it took to decode it) divided by its size, plus an "inflation value" which is raised to
+/// the priority of the bitmap evicted last. So, bitmaps which are cheap to reproduce (relative to the memory they occupy)
+/// are evicted first, and bitmaps which have not been used for a long time are eventually evicted regardless of their cost.
+/// Bitmaps are handed out as shared pointers, i.e. a bitmap remains valid (is "pinned") as long as a reference to it is
+/// held, even if it has been evicted from the cache in the meantime.
+class DecodedBitmapCache
+{
+public:
+    /// The key identifying a bitmap in the cache.
+    struct Key
+    {
+        std::uint64_t document_id{ 0 };     ///< The identifier of the document (chosen by the user of the cache).
+        imgdoc2::dbIndex tile_index{ 0 };   ///< The index of the tile within the document.
+
+        bool operator==(const Key& other) const
+        {
+            return this->document_id == other.document_id && this->tile_index == other.tile_index;
+        }
+    };
+
+    /// A decoded bitmap.
+    struct Bitmap
+    {
+        std::uint8_t pixel_type{ imgdoc2::PixelType::Unknown };    ///< The pixel type (c.f. imgdoc2::PixelType).
+        std::uint32_t width{ 0 };                                   ///< The width of the bitmap in pixels.
+        std::uint32_t height{ 0 };                                  ///< The height of the bitmap in pixels.
+        std::uint32_t stride{ 0 };                                  ///< The stride of the bitmap in bytes.
+        std::shared_ptr<void> data;                                 ///< The bitmap data.
+
+        /// Gets the size of the bitmap data in bytes.
+        /// \returns The size of the bitmap data in bytes.
+        [[nodiscard]] std::uint64_t GetSize() const
+        {
+            return static_cast<std::uint64_t>(this->stride) * this->height;
+        }
+    };
+
+    /// Statistics about the usage of the cache.
+    struct Statistics
+    {
+        std::uint64_t hits{ 0 };                ///< The number of lookups which found a bitmap.
+        std::uint64_t misses{ 0 };              ///< The number of lookups which did not find a bitmap.
+        std::uint64_t insertions{ 0 };          ///< The number of bitmaps added to the cache.
+        std::uint64_t evictions{ 0 };           ///< The number of bitmaps evicted from the cache.
+        std::uint64_t memory_usage{ 0 };        ///< The size of the bitmap data currently held by the cache (in bytes).
+        std::uint64_t number_of_entries{ 0 };   ///< The number of bitmaps currently held by the cache.
+    };
+
+    static constexpr std::uint32_t kDefaultNumberOfShards = 16; ///< The number of shards used if the number of shards is not specified.
+private:
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry
+    {
+        std::shared_ptr<const Bitmap> bitmap;
+        double cost_per_byte;
+        std::multimap<double, Key>::iterator eviction_order_position;
+    };
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<Key, Entry, KeyHash> entries;
+        std::multimap<double, Key> eviction_order;  ///< The keys of the entries ordered by their priority (lowest first).
+        double inflation{ 0 };
+        std::uint64_t memory_usage{ 0 };
+    };
+
+    std::uint64_t max_memory_size_per_shard_;
+    std::uint32_t number_of_shards_;
+    std::unique_ptr<Shard[]> shards_;
+    std::atomic_uint64_t hits_{ 0 };
+    std::atomic_uint64_t misses_{ 0 };
+    std::atomic_uint64_t insertions_{ 0 };
+    std::atomic_uint64_t evictions_{ 0 };
+public:
+    /// Constructor.
+    ///
+    /// \param  max_memory_size     The maximal size of the bitmap data held by the cache (in bytes).
+    /// \param  number_of_shards    The number of shards, where 0 means "use the default number of shards".
+    DecodedBitmapCache(std::uint64_t max_memory_size, std::uint32_t number_of_shards);
+
+    /// Looks up the bitmap with the specified key.
+    ///
+    /// \param  key The key.
+    ///
+    /// \returns    The bitmap if it is in the cache; null otherwise.
+    std::shared_ptr<const Bitmap> Get(const Key& key);
+
+    /// Adds the specified bitmap to the cache. If there already is a bitmap with the specified key (e.g. because it was
+    /// decoded concurrently), then the bitmap in the cache is retained. A bitmap which is larger than the budget of a
+    /// shard is not added.
+    ///
+    /// \param  key         The key.
+    /// \param  bitmap      The bitmap.
+    /// \param  decode_time The time it took to decode the bitmap (which is the "cost" of the bitmap).
+    ///
+    /// \returns    The bitmap for the key, i.e. the bitmap which was in the cache already or the specified bitmap.
+    std::shared_ptr<const Bitmap> Add(const Key& key, std::shared_ptr<const Bitmap> bitmap, std::chrono::nanoseconds decode_time);
+
+    /// Removes all bitmaps of the specified document from the cache.
+    ///
+    /// \param  document_id The identifier of the document.
+    void RemoveDocument(std::uint64_t document_id);
+
+    /// Removes all bitmaps from the cache.
+    void Clear();
+
+    /// Gets statistics about the usage of the cache.
+    ///
+    /// \returns    The statistics.
+    Statistics GetStatistics() const;
+private:
+    Shard& GetShard(const Key& key) const;
+    void EvictIfNecessary(Shard& shard);
+    static void RemoveEntry(Shard& shard, std::unordered_map<Key, Entry, KeyHash>::iterator iterator);
+};
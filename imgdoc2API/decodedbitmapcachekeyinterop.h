@@ -0,0 +1,16 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+
+#pragma pack(push, 4)
+/// This struct is the key identifying a bitmap in a decoded-bitmap-cache.
+struct DecodedBitmapCacheKeyInterop
+{
+    std::uint64_t document_id;  ///< The identifier of the document (chosen by the user of the cache).
+    std::int64_t tile_index;    ///< The index of the tile within the document.
+};
+#pragma pack(pop)
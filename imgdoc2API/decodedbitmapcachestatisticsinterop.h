@@ -0,0 +1,20 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+
+#pragma pack(push, 4)
+/// This struct gives statistics about the usage of a decoded-bitmap-cache.
+struct DecodedBitmapCacheStatisticsInterop
+{
+    std::uint64_t hits;                 ///< The number of lookups which found a bitmap.
+    std::uint64_t misses;               ///< The number of lookups which did not find a bitmap.
+    std::uint64_t insertions;           ///< The number of bitmaps added to the cache.
+    std::uint64_t evictions;            ///< The number of bitmaps evicted from the cache.
+    std::uint64_t memory_usage;         ///< The size of the bitmap data currently held by the cache (in bytes).
+    std::uint64_t number_of_entries;    ///< The number of bitmaps currently held by the cache.
+};
+#pragma pack(pop)
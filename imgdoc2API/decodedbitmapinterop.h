@@ -0,0 +1,20 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+
+#pragma pack(push, 4)
+/// This struct describes a decoded bitmap which is held by a decoded-bitmap-cache. The memory is valid as long as the
+/// handle of the bitmap is not released.
+struct DecodedBitmapInterop
+{
+    std::uint8_t pixelType;     ///< The pixel type.
+    std::uint32_t pixelWidth;   ///< The width of the bitmap in pixels.
+    std::uint32_t pixelHeight;  ///< The height of the bitmap in pixels.
+    std::uint32_t stride;       ///< The stride of the bitmap in bytes.
+    const void* data;           ///< Pointer to the bitmap data.
+};
+#pragma pack(pop)
@@ -0,0 +1,25 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include "errorcodes.h"
+#include "bitmapinfointerop.h"
+
+#pragma pack(push, 4)
+/// This struct describes a decoding job for the function DecodeImages - the compressed data is decoded into the destination
+/// bitmap provided by the caller.
+struct DecodeImageJobInterop
+{
+    BitmapInfoInterop bitmap_info;          ///< Information describing the (compressed) bitmap.
+    std::uint8_t data_type;                 ///< The type of the compression (corresponding to imgdoc2::DataTypes).
+    const void* compressed_data;            ///< Pointer to the compressed data.
+    std::uint64_t compressed_data_size;     ///< Size of the compressed data in bytes.
+    void* destination;                      ///< Pointer to the destination bitmap.
+    std::uint32_t destination_stride;       ///< The stride of the destination bitmap (in bytes), which must be greater than or equal to pixelWidth * bytes per pixel.
+    std::uint64_t destination_size;         ///< The size of the destination buffer in bytes, which must be at least destination_stride * pixelHeight.
+    ImgDoc2ErrorCode result;                ///< [out] The result of the job - this is set by DecodeImages.
+};
+#pragma pack(pop)
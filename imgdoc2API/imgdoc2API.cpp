@@ -7,15 +7,23 @@
 #include <algorithm>
 #include <atomic>
 #include <map>
+#include <functional>
 #include <limits>
 #include <utility>
+#include <sstream>
 #include <string>
 #include <vector>
 #include <gsl/util>
 #include "utilities.h"
 #include "imgdoc2apistatistics.h"
+#include "operationstatistics.h"
 #include "sharedptrwrapper.h"
 #include "imgdoc2APIsupport.h"
+#include "planeslicerenderer.h"
+#include "pyramidgenerator.h"
+#include "regioncompositor.h"
+#include "regionstatistics.h"
+#include "volumeprojector.h"
 
 #include <imgdoc2.h>
 #include <gsl/narrow>
@@ -33,6 +41,58 @@ void GetStatistics(ImgDoc2StatisticsInterop* statistics_interop)
     }
 }
 
+ImgDoc2ErrorCode GetOperationStatistics(
+    std::uint8_t operation,
+    OperationStatisticsInterop* statistics,
+    std::uint64_t* histogram,
+    std::uint32_t* histogram_count,
+    ImgDoc2ErrorInformation* error_information)
+{
+    if (!OperationStatistics::IsValidOperation(operation))
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("operation", "is not a valid operation", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    const auto snapshot = OperationStatistics::GetInstance().GetOperationSnapshot(static_cast<OperationStatistics::Operation>(operation));
+    if (statistics != nullptr)
+    {
+        statistics->count = snapshot.count;
+        statistics->total_duration = snapshot.total_duration;
+        statistics->maximum_duration = snapshot.maximum_duration;
+        statistics->median_duration = snapshot.GetPercentile(50);
+        statistics->percentile90_duration = snapshot.GetPercentile(90);
+        statistics->percentile99_duration = snapshot.GetPercentile(99);
+    }
+
+    if (histogram_count != nullptr)
+    {
+        if (histogram != nullptr)
+        {
+            copy_n(snapshot.histogram.cbegin(), min(static_cast<size_t>(*histogram_count), snapshot.histogram.size()), histogram);
+        }
+
+        *histogram_count = gsl::narrow<std::uint32_t>(snapshot.histogram.size());
+    }
+
+    return ImgDoc2_ErrorCode_OK;
+}
+
+std::uint64_t GetOperationStatisticsBucketLowerBound(std::uint32_t bucket_index)
+{
+    if (bucket_index >= OperationStatistics::kBucketCount)
+    {
+        return numeric_limits<std::uint64_t>::max();
+    }
+
+    return OperationStatistics::GetBucketLowerBound(bucket_index);
+}
+
+void ResetStatistics()
+{
+    OperationStatistics::GetInstance().Reset();
+}
+
 static void ClearAllocationObject(AllocationObject* allocation_object)
 {
     allocation_object->pointer_to_memory = nullptr;
@@ -56,6 +116,193 @@ static void CopyStringToAllocationObject(const string& str, AllocMemoryFunctionP
     }
 }
 
+/// Checks the ranges given for an item of a batched add operation (c.f. IDocWrite2d_AddTiles), i.e. checks that the range of the
+/// coordinate is within the array of dimension-value-pairs, and that the range of the data is within the memory block.
+///
+/// \param          index               The index of the item.
+/// \param          coordinate_offset   The index of the first dimension-value-pair of the item.
+/// \param          coordinate_count    The number of dimension-value-pairs of the item.
+/// \param          coordinates_count   The number of elements in the array of dimension-value-pairs.
+/// \param          data_offset         The offset of the data of the item.
+/// \param          data_size           The size of the data of the item.
+/// \param          total_data_size     The size of the memory block.
+/// \param [out]    error_information   If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns    True if the ranges are valid; false otherwise.
+static bool CheckRangesOfItemToAdd(
+    uint32_t index,
+    uint32_t coordinate_offset,
+    uint32_t coordinate_count,
+    uint32_t coordinates_count,
+    uint64_t data_offset,
+    uint64_t data_size,
+    uint64_t total_data_size,
+    ImgDoc2ErrorInformation* error_information)
+{
+    if (coordinate_offset > coordinates_count || coordinate_count > coordinates_count - coordinate_offset)
+    {
+        ostringstream string_stream;
+        string_stream << "the coordinate of item #" << index << " is not within the array of coordinates";
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("coordinates", string_stream.str().c_str(), error_information);
+        return false;
+    }
+
+    if (data_offset > total_data_size || data_size > total_data_size - data_offset)
+    {
+        ostringstream string_stream;
+        string_stream << "the data of item #" << index << " is not within the memory block";
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("data", string_stream.str().c_str(), error_information);
+        return false;
+    }
+
+    return true;
+}
+
+/// Reads the data of a batch of tiles (or bricks) into one memory block - either the caller-provided arena, or a memory block
+/// allocated with the specified function (c.f. IDocRead2d_ReadTileDataBatch).
+///
+/// \param          read_data                   The function reading the data of the tile with the specified primary key.
+/// \param          pks                         The primary keys.
+/// \param          count                       The number of tiles.
+/// \param          arena                       If non-null, the memory block into which the data is placed.
+/// \param          arena_size                  The size of the arena in bytes.
+/// \param          allocate_memory_function    If no arena is given, the function used to allocate the memory block.
+/// \param [out]    allocation_object           If no arena is given, the allocated memory block is put here.
+/// \param [out]    entries                     The offset, the size and the result for each tile are put here.
+/// \param [out]    error_information           If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns    An error-code indicating success or failure of the operation.
+static ImgDoc2ErrorCode ReadTileDataBatch(
+    const function<void(imgdoc2::dbIndex, IBlobOutput*)>& read_data,
+    const std::int64_t* pks,
+    std::uint32_t count,
+    void* arena,
+    std::uint64_t arena_size,
+    AllocMemoryFunctionPointer allocate_memory_function,
+    AllocationObject* allocation_object,
+    TileDataBatchEntryInterop* entries,
+    ImgDoc2ErrorInformation* error_information)
+{
+    if (count > 0 && pks == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("pks", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    if (count > 0 && entries == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("entries", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    if (arena == nullptr && (allocate_memory_function == nullptr || allocation_object == nullptr))
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("arena", "if no arena is given, then 'allocate_memory_function' and 'allocation_object' must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    // the error of the first tile which failed is reported
+    ImgDoc2ErrorCode first_error_code = ImgDoc2_ErrorCode_OK;
+    const auto set_entry = [&](uint32_t index, uint64_t offset, uint64_t size, ImgDoc2ErrorCode result, const ImgDoc2ErrorInformation& entry_error_information)
+    {
+        entries[index] = TileDataBatchEntryInterop{ offset, size, result };
+        if (result == ImgDoc2_ErrorCode_OK)
+        {
+            OperationStatistics::GetInstance().AddBytesRead(size);
+        }
+
+        if (result != ImgDoc2_ErrorCode_OK && first_error_code == ImgDoc2_ErrorCode_OK)
+        {
+            first_error_code = result;
+            if (error_information != nullptr)
+            {
+                *error_information = entry_error_information;
+            }
+        }
+    };
+
+    if (arena != nullptr)
+    {
+        Utilities::BlobOutputIntoArena blob_output(arena, arena_size);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            ImgDoc2ErrorInformation entry_error_information{};
+            blob_output.BeginBlob();
+            try
+            {
+                read_data(pks[i], &blob_output);
+            }
+            catch (exception& exception)
+            {
+                ImgDoc2ApiSupport::FillOutErrorInformation(exception, &entry_error_information);
+                set_entry(i, 0, 0, ImgDoc2ApiSupport::MapExceptionToReturnValue(exception), entry_error_information);
+                continue;
+            }
+
+            if (blob_output.GetIsRejected())
+            {
+                ImgDoc2ApiSupport::FillOutErrorInformationForAllocationFailure(blob_output.GetBlobSize(), &entry_error_information);
+                set_entry(i, 0, blob_output.GetBlobSize(), ImgDoc2_ErrorCode_AllocationError, entry_error_information);
+            }
+            else
+            {
+                set_entry(i, blob_output.GetBlobOffset(), blob_output.GetBlobSize(), ImgDoc2_ErrorCode_OK, entry_error_information);
+            }
+        }
+
+        return first_error_code;
+    }
+
+    // without an arena, we read the data into temporary buffers first (since we need to know the total size before we can
+    //  allocate the memory block), and then copy it into the memory block
+    vector<unique_ptr<BlobOutputOnHeap>> blobs(count);
+    uint64_t total_size = 0;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        ImgDoc2ErrorInformation entry_error_information{};
+        blobs[i] = make_unique<BlobOutputOnHeap>();
+        try
+        {
+            read_data(pks[i], blobs[i].get());
+        }
+        catch (exception& exception)
+        {
+            blobs[i].reset();
+            ImgDoc2ApiSupport::FillOutErrorInformation(exception, &entry_error_information);
+            set_entry(i, 0, 0, ImgDoc2ApiSupport::MapExceptionToReturnValue(exception), entry_error_information);
+            continue;
+        }
+
+        const uint64_t offset = (total_size + Utilities::BlobOutputIntoArena::kAlignment - 1) / Utilities::BlobOutputIntoArena::kAlignment * Utilities::BlobOutputIntoArena::kAlignment;
+        const uint64_t size = blobs[i]->GetHasData() ? blobs[i]->GetSizeOfData() : 0;
+        set_entry(i, offset, size, ImgDoc2_ErrorCode_OK, entry_error_information);
+        total_size = offset + size;
+    }
+
+    if (total_size == 0)
+    {
+        ClearAllocationObject(allocation_object);
+        return first_error_code;
+    }
+
+    if (!allocate_memory_function(total_size, allocation_object) || allocation_object->pointer_to_memory == nullptr)
+    {
+        ClearAllocationObject(allocation_object);
+        ImgDoc2ApiSupport::FillOutErrorInformationForAllocationFailure(total_size, error_information);
+        return ImgDoc2_ErrorCode_AllocationError;
+    }
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (blobs[i] && entries[i].size > 0)
+        {
+            memcpy(static_cast<uint8_t*>(allocation_object->pointer_to_memory) + entries[i].offset, blobs[i]->GetDataC(), static_cast<size_t>(entries[i].size));
+        }
+    }
+
+    return first_error_code;
+}
+
 ImgDoc2ErrorCode GetVersionInfo(VersionInfoInterop* version_info, AllocMemoryFunctionPointer allocate_memory_function)
 {
     if (version_info == nullptr)
@@ -447,6 +694,19 @@ ImgDoc2ErrorCode CreateOptions_SetFilename(HandleCreateOptions handle, const cha
     return ImgDoc2_ErrorCode_OK;
 }
 
+ImgDoc2ErrorCode CreateOptions_SetBlobDatabaseFilename(HandleCreateOptions handle, const char* filename_utf8, ImgDoc2ErrorInformation* error_information)
+{
+    const auto create_options_object = reinterpret_cast<PtrWrapper<ICreateOptions>*>(handle);  // NOLINT(performance-no-int-to-ptr)
+    if (!create_options_object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleCreateOptions", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    create_options_object->ptr_->SetBlobDatabaseFilename(filename_utf8);
+    return ImgDoc2_ErrorCode_OK;
+}
+
 ImgDoc2ErrorCode OpenExistingOptions_SetFilename(HandleOpenExistingOptions handle, const char* filename_utf8, ImgDoc2ErrorInformation* error_information)
 {
     const auto open_existing_options_object = reinterpret_cast<PtrWrapper<IOpenExistingOptions>*>(handle);  // NOLINT(performance-no-int-to-ptr)
@@ -509,6 +769,19 @@ ImgDoc2ErrorCode CreateOptions_SetUseBlobTable(HandleCreateOptions handle, bool
     return ImgDoc2_ErrorCode_OK;
 }
 
+ImgDoc2ErrorCode CreateOptions_SetCreateTileStatisticsTable(HandleCreateOptions handle, bool create_tile_statistics_table, ImgDoc2ErrorInformation* error_information)
+{
+    const auto create_options_object = reinterpret_cast<PtrWrapper<ICreateOptions>*>(handle);  // NOLINT(performance-no-int-to-ptr)
+    if (!create_options_object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleCreateOptions", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    create_options_object->ptr_->SetCreateTileStatisticsTable(create_tile_statistics_table);
+    return ImgDoc2_ErrorCode_OK;
+}
+
 ImgDoc2ErrorCode CreateOptions_AddIndexForDimension(HandleCreateOptions handle, char dimension, ImgDoc2ErrorInformation* error_information)
 {
     const auto create_options_object = reinterpret_cast<PtrWrapper<ICreateOptions>*>(handle);  // NOLINT(performance-no-int-to-ptr)
@@ -561,6 +834,25 @@ ImgDoc2ErrorCode CreateOptions_GetFilename(HandleCreateOptions handle, char* fil
             error_information);
 }
 
+ImgDoc2ErrorCode CreateOptions_GetBlobDatabaseFilename(HandleCreateOptions handle, char* filename_utf8, size_t* size, ImgDoc2ErrorInformation* error_information)
+{
+    const auto create_options_object = reinterpret_cast<PtrWrapper<ICreateOptions>*>(handle);  // NOLINT(performance-no-int-to-ptr)
+    if (!create_options_object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleCreateOptions", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    return ReturnStringHelper(
+        [=]()->std::string
+        {
+            return create_options_object->ptr_->GetBlobDatabaseFilename();
+        },
+        filename_utf8,
+        size,
+        error_information);
+}
+
 ImgDoc2ErrorCode OpenExistingOptions_GetFilename(HandleOpenExistingOptions handle, char* filename_utf8, size_t* size, ImgDoc2ErrorInformation* error_information)
 {
     const auto open_existing_options_object = reinterpret_cast<PtrWrapper<IOpenExistingOptions>*>(handle);  // NOLINT(performance-no-int-to-ptr)
@@ -636,6 +928,24 @@ ImgDoc2ErrorCode CreateOptions_GetUseBlobTable(HandleCreateOptions handle, bool*
     return ImgDoc2_ErrorCode_OK;
 }
 
+ImgDoc2ErrorCode CreateOptions_GetCreateTileStatisticsTable(HandleCreateOptions handle, bool* create_tile_statistics_table, ImgDoc2ErrorInformation* error_information)
+{
+    const auto create_options_object = reinterpret_cast<PtrWrapper<ICreateOptions>*>(handle);  // NOLINT(performance-no-int-to-ptr)
+    if (!create_options_object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleCreateOptions", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    const bool b = create_options_object->ptr_->GetCreateTileStatisticsTable();
+    if (create_tile_statistics_table != nullptr)
+    {
+        *create_tile_statistics_table = b;
+    }
+
+    return ImgDoc2_ErrorCode_OK;
+}
+
 ImgDoc2ErrorCode CreateOptions_AddDimension(HandleCreateOptions handle, std::uint8_t dimension, ImgDoc2ErrorInformation* error_information)
 {
     const auto create_options_object = reinterpret_cast<PtrWrapper<ICreateOptions>*>(handle);  // NOLINT(performance-no-int-to-ptr)
@@ -754,6 +1064,7 @@ ImgDoc2ErrorCode IDocWrite2d_AddTile(
     imgdoc2::dbIndex* result_pk,
     ImgDoc2ErrorInformation* error_information)
 {
+    const OperationStatistics::Scope operation_scope(OperationStatistics::GetInstance(), OperationStatistics::Operation::AddTile);
     if (tile_coordinate_interop == nullptr)
     {
         ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("tile_coordinate_interop", "must not be null", error_information);
@@ -790,6 +1101,7 @@ ImgDoc2ErrorCode IDocWrite2d_AddTile(
             data_type,
             TileDataStorageType::BlobInDatabase,
             &data_object);
+        OperationStatistics::GetInstance().AddBytesWritten(size_data);
         if (result_pk != nullptr)
         {
             *result_pk = pk;
@@ -804,6 +1116,99 @@ ImgDoc2ErrorCode IDocWrite2d_AddTile(
     return ImgDoc2_ErrorCode_OK;
 }
 
+ImgDoc2ErrorCode IDocWrite2d_AddTiles(
+    HandleDocWrite2D handle,
+    const TileToAddInterop* tiles,
+    std::uint32_t count,
+    const DimensionAndValueInterop* coordinates,
+    std::uint32_t coordinates_count,
+    const void* data,
+    std::uint64_t data_size,
+    imgdoc2::dbIndex* result_pks,
+    ImgDoc2ErrorInformation* error_information)
+{
+    const OperationStatistics::Scope operation_scope(OperationStatistics::GetInstance(), OperationStatistics::Operation::AddTiles);
+    if (count > 0 && tiles == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("tiles", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    if (coordinates_count > 0 && coordinates == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("coordinates", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    if (data_size > 0 && data == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("data", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (!CheckRangesOfItemToAdd(i, tiles[i].coordinate_offset, tiles[i].coordinate_count, coordinates_count, tiles[i].data_offset, tiles[i].data_size, data_size, error_information))
+        {
+            return ImgDoc2_ErrorCode_InvalidArgument;
+        }
+    }
+
+    const auto write2d_object = reinterpret_cast<SharedPtrWrapper<IDocWrite2d>*>(handle); // NOLINT(performance-no-int-to-ptr)
+    if (!write2d_object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleDocWrite2D", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    const auto writer2d = write2d_object->shared_ptr_;
+
+    try
+    {
+        // convert the interop-structures - the vectors are sized up-front, so that the pointers to their elements (which are
+        //  put into the TileToAdd-structures) remain valid
+        vector<TileCoordinate> tile_coordinates;
+        vector<LogicalPositionInfo> logical_position_infos;
+        vector<TileBaseInfo> tile_base_infos;
+        vector<Utilities::GetDataObject> data_objects;
+        vector<TileToAdd> tiles_to_add(count);
+        tile_coordinates.reserve(count);
+        logical_position_infos.reserve(count);
+        tile_base_infos.reserve(count);
+        data_objects.reserve(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const TileToAddInterop& tile = tiles[i];
+            tile_coordinates.push_back(Utilities::ConvertToTileCoordinate(coordinates + tile.coordinate_offset, tile.coordinate_count));
+            logical_position_infos.push_back(Utilities::ConvertLogicalPositionInfoInteropToImgdoc2(tile.logical_position_info));
+            tile_base_infos.push_back(Utilities::ConvertTileBaseInfoInteropToImgdoc2(tile.tile_base_info));
+            data_objects.emplace_back(static_cast<const uint8_t*>(data) + tile.data_offset, tile.data_size);
+            tiles_to_add[i].coordinate = &tile_coordinates.back();
+            tiles_to_add[i].logical_position_info = &logical_position_infos.back();
+            tiles_to_add[i].tile_base_info = &tile_base_infos.back();
+            tiles_to_add[i].data_type = Utilities::ConvertDatatypeEnumInterop(tile.data_type);
+            tiles_to_add[i].storage_type = TileDataStorageType::BlobInDatabase;
+            tiles_to_add[i].data = &data_objects.back();
+        }
+
+        writer2d->AddTiles(tiles_to_add.data(), count, result_pks);
+        uint64_t total_data_size = 0;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            total_data_size += tiles[i].data_size;
+        }
+
+        OperationStatistics::GetInstance().AddBytesWritten(total_data_size);
+    }
+    catch (exception& exception)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformation(exception, error_information);
+        return ImgDoc2ApiSupport::MapExceptionToReturnValue(exception);
+    }
+
+    return ImgDoc2_ErrorCode_OK;
+}
+
 ImgDoc2ErrorCode IDocWrite3d_AddBrick(
     HandleDocWrite3D handle,
     const TileCoordinateInterop* tile_coordinate_interop,
@@ -815,6 +1220,7 @@ ImgDoc2ErrorCode IDocWrite3d_AddBrick(
     imgdoc2::dbIndex* result_pk,
     ImgDoc2ErrorInformation* error_information)
 {
+    const OperationStatistics::Scope operation_scope(OperationStatistics::GetInstance(), OperationStatistics::Operation::AddTile);
     if (tile_coordinate_interop == nullptr)
     {
         ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("tile_coordinate_interop", "must not be null", error_information);
@@ -851,6 +1257,7 @@ ImgDoc2ErrorCode IDocWrite3d_AddBrick(
             data_type,
             TileDataStorageType::BlobInDatabase,
             &data_object);
+        OperationStatistics::GetInstance().AddBytesWritten(size_data);
         if (result_pk != nullptr)
         {
             *result_pk = pk;
@@ -865,6 +1272,99 @@ ImgDoc2ErrorCode IDocWrite3d_AddBrick(
     return ImgDoc2_ErrorCode_OK;
 }
 
+ImgDoc2ErrorCode IDocWrite3d_AddBricks(
+    HandleDocWrite3D handle,
+    const BrickToAddInterop* bricks,
+    std::uint32_t count,
+    const DimensionAndValueInterop* coordinates,
+    std::uint32_t coordinates_count,
+    const void* data,
+    std::uint64_t data_size,
+    imgdoc2::dbIndex* result_pks,
+    ImgDoc2ErrorInformation* error_information)
+{
+    const OperationStatistics::Scope operation_scope(OperationStatistics::GetInstance(), OperationStatistics::Operation::AddTiles);
+    if (count > 0 && bricks == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("bricks", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    if (coordinates_count > 0 && coordinates == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("coordinates", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    if (data_size > 0 && data == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("data", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (!CheckRangesOfItemToAdd(i, bricks[i].coordinate_offset, bricks[i].coordinate_count, coordinates_count, bricks[i].data_offset, bricks[i].data_size, data_size, error_information))
+        {
+            return ImgDoc2_ErrorCode_InvalidArgument;
+        }
+    }
+
+    const auto write3d_object = reinterpret_cast<SharedPtrWrapper<IDocWrite3d>*>(handle); // NOLINT(performance-no-int-to-ptr)
+    if (!write3d_object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleDocWrite3D", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    const auto writer3d = write3d_object->shared_ptr_;
+
+    try
+    {
+        // convert the interop-structures - the vectors are sized up-front, so that the pointers to their elements (which are
+        //  put into the BrickToAdd-structures) remain valid
+        vector<TileCoordinate> tile_coordinates;
+        vector<LogicalPositionInfo3D> logical_position_infos;
+        vector<BrickBaseInfo> brick_base_infos;
+        vector<Utilities::GetDataObject> data_objects;
+        vector<BrickToAdd> bricks_to_add(count);
+        tile_coordinates.reserve(count);
+        logical_position_infos.reserve(count);
+        brick_base_infos.reserve(count);
+        data_objects.reserve(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const BrickToAddInterop& brick = bricks[i];
+            tile_coordinates.push_back(Utilities::ConvertToTileCoordinate(coordinates + brick.coordinate_offset, brick.coordinate_count));
+            logical_position_infos.push_back(Utilities::ConvertLogicalPositionInfo3DInteropToImgdoc2(brick.logical_position_info));
+            brick_base_infos.push_back(Utilities::ConvertBrickBaseInfoInteropToImgdoc2(brick.brick_base_info));
+            data_objects.emplace_back(static_cast<const uint8_t*>(data) + brick.data_offset, brick.data_size);
+            bricks_to_add[i].coordinate = &tile_coordinates.back();
+            bricks_to_add[i].logical_position_info = &logical_position_infos.back();
+            bricks_to_add[i].brick_base_info = &brick_base_infos.back();
+            bricks_to_add[i].data_type = Utilities::ConvertDatatypeEnumInterop(brick.data_type);
+            bricks_to_add[i].storage_type = TileDataStorageType::BlobInDatabase;
+            bricks_to_add[i].data = &data_objects.back();
+        }
+
+        writer3d->AddBricks(bricks_to_add.data(), count, result_pks);
+        uint64_t total_data_size = 0;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            total_data_size += bricks[i].data_size;
+        }
+
+        OperationStatistics::GetInstance().AddBytesWritten(total_data_size);
+    }
+    catch (exception& exception)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformation(exception, error_information);
+        return ImgDoc2ApiSupport::MapExceptionToReturnValue(exception);
+    }
+
+    return ImgDoc2_ErrorCode_OK;
+}
+
 ImgDoc2ErrorCode IDocRead2d_Query(
     HandleDocRead2D handle,
     const DimensionQueryClauseInterop* dim_coordinate_query_clause_interop,
@@ -872,6 +1372,7 @@ ImgDoc2ErrorCode IDocRead2d_Query(
     QueryResultInterop* result,
     ImgDoc2ErrorInformation* error_information)
 {
+    const OperationStatistics::Scope operation_scope(OperationStatistics::GetInstance(), OperationStatistics::Operation::Query);
     const auto reader2d_object = reinterpret_cast<SharedPtrWrapper<IDocRead2d>*>(handle); // NOLINT(performance-no-int-to-ptr)
     if (!reader2d_object->IsValid())
     {
@@ -927,6 +1428,7 @@ ImgDoc2ErrorCode IDocRead3d_Query(
     QueryResultInterop* result,
     ImgDoc2ErrorInformation* error_information)
 {
+    const OperationStatistics::Scope operation_scope(OperationStatistics::GetInstance(), OperationStatistics::Operation::Query);
     const auto reader3d_object = reinterpret_cast<SharedPtrWrapper<IDocRead3d>*>(handle); // NOLINT(performance-no-int-to-ptr)
     if (!reader3d_object->IsValid())
     {
@@ -981,6 +1483,7 @@ ImgDoc2ErrorCode IDocRead2d_GetTilesIntersectingRect(
     QueryResultInterop* result,
     ImgDoc2ErrorInformation* error_information)
 {
+    const OperationStatistics::Scope operation_scope(OperationStatistics::GetInstance(), OperationStatistics::Operation::Query);
     const auto reader2d_object = reinterpret_cast<SharedPtrWrapper<IDocRead2d>*>(handle); // NOLINT(performance-no-int-to-ptr)
     if (!reader2d_object->IsValid())
     {
@@ -1039,6 +1542,7 @@ ImgDoc2ErrorCode IDocRead3d_GetBricksIntersectingCuboid(
     QueryResultInterop* result,
     ImgDoc2ErrorInformation* error_information)
 {
+    const OperationStatistics::Scope operation_scope(OperationStatistics::GetInstance(), OperationStatistics::Operation::Query);
     const auto reader3d_object = reinterpret_cast<SharedPtrWrapper<IDocRead3d>*>(handle); // NOLINT(performance-no-int-to-ptr)
     if (!reader3d_object->IsValid())
     {
@@ -1095,6 +1599,7 @@ ImgDoc2ErrorCode IDocRead3d_GetBricksIntersectingPlane(
     QueryResultInterop* result,
     ImgDoc2ErrorInformation* error_information)
 {
+    const OperationStatistics::Scope operation_scope(OperationStatistics::GetInstance(), OperationStatistics::Operation::Query);
     const auto reader3d_object = reinterpret_cast<SharedPtrWrapper<IDocRead3d>*>(handle); // NOLINT(performance-no-int-to-ptr)
     if (!reader3d_object->IsValid())
     {
@@ -1150,6 +1655,7 @@ ImgDoc2ErrorCode IDocRead2d_ReadTileData(
     MemTransferSetDataFunctionPointer pfnSetData,
     ImgDoc2ErrorInformation* error_information)
 {
+    const OperationStatistics::Scope operation_scope(OperationStatistics::GetInstance(), OperationStatistics::Operation::ReadTileData);
     static_assert(sizeof(pk) == sizeof(imgdoc2::dbIndex), "Type of the argument 'pk' and the imgdoc2-dbIndex-type must have same size.");
 
     const auto reader2d_object = reinterpret_cast<SharedPtrWrapper<IDocRead2d>*>(handle); // NOLINT(performance-no-int-to-ptr)
@@ -1165,6 +1671,7 @@ ImgDoc2ErrorCode IDocRead2d_ReadTileData(
     try
     {
         reader2d->ReadTileData(pk, &blob_output_object);
+        OperationStatistics::GetInstance().AddBytesRead(blob_output_object.GetSize());
     }
     catch (exception& exception)
     {
@@ -1175,14 +1682,132 @@ ImgDoc2ErrorCode IDocRead2d_ReadTileData(
     return ImgDoc2_ErrorCode_OK;
 }
 
-ImgDoc2ErrorCode IDocRead3d_ReadBrickData(
-    HandleDocRead3D handle,
+ImgDoc2ErrorCode IDocRead2d_GetTileDataSize(
+    HandleDocRead2D handle,
     std::int64_t pk,
-    std::intptr_t blob_output_handle,
-    MemTransferReserveFunctionPointer pfnReserve,
-    MemTransferSetDataFunctionPointer pfnSetData,
+    std::uint64_t* size,
     ImgDoc2ErrorInformation* error_information)
 {
+    if (size == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("size", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    const auto reader2d_object = reinterpret_cast<SharedPtrWrapper<IDocRead2d>*>(handle); // NOLINT(performance-no-int-to-ptr)
+    if (!reader2d_object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleDocRead2D", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    try
+    {
+        *size = reader2d_object->shared_ptr_->GetTileDataSize(pk);
+    }
+    catch (exception& exception)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformation(exception, error_information);
+        return ImgDoc2ApiSupport::MapExceptionToReturnValue(exception);
+    }
+
+    return ImgDoc2_ErrorCode_OK;
+}
+
+ImgDoc2ErrorCode IDocRead2d_ReadTileDataIntoBuffer(
+    HandleDocRead2D handle,
+    std::int64_t pk,
+    void* buffer,
+    std::uint64_t* size,
+    ImgDoc2ErrorInformation* error_information)
+{
+    const OperationStatistics::Scope operation_scope(OperationStatistics::GetInstance(), OperationStatistics::Operation::ReadTileData);
+    if (size == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("size", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    if (buffer == nullptr && *size > 0)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("buffer", "must not be null if the size is greater than 0", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    const auto reader2d_object = reinterpret_cast<SharedPtrWrapper<IDocRead2d>*>(handle); // NOLINT(performance-no-int-to-ptr)
+    if (!reader2d_object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleDocRead2D", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    // the buffer is used as an "arena" for one blob, i.e. the data is written directly into it (if it fits)
+    Utilities::BlobOutputIntoArena blob_output(buffer, *size);
+    try
+    {
+        reader2d_object->shared_ptr_->ReadTileData(pk, &blob_output);
+    }
+    catch (exception& exception)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformation(exception, error_information);
+        return ImgDoc2ApiSupport::MapExceptionToReturnValue(exception);
+    }
+
+    if (!blob_output.GetIsRejected())
+    {
+        OperationStatistics::GetInstance().AddBytesRead(blob_output.GetBlobSize());
+    }
+
+    *size = blob_output.GetBlobSize();
+    return ImgDoc2_ErrorCode_OK;
+}
+
+ImgDoc2ErrorCode IDocRead2d_ReadTileDataBatch(
+    HandleDocRead2D handle,
+    const std::int64_t* pks,
+    std::uint32_t count,
+    void* arena,
+    std::uint64_t arena_size,
+    AllocMemoryFunctionPointer allocate_memory_function,
+    AllocationObject* allocation_object,
+    TileDataBatchEntryInterop* entries,
+    ImgDoc2ErrorInformation* error_information)
+{
+    const OperationStatistics::Scope operation_scope(OperationStatistics::GetInstance(), OperationStatistics::Operation::ReadTileData);
+    static_assert(sizeof(*pks) == sizeof(imgdoc2::dbIndex), "Type of the argument 'pks' and the imgdoc2-dbIndex-type must have same size.");
+
+    const auto reader2d_object = reinterpret_cast<SharedPtrWrapper<IDocRead2d>*>(handle); // NOLINT(performance-no-int-to-ptr)
+    if (!reader2d_object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleDocRead2D", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    const auto reader2d = reader2d_object->shared_ptr_;
+    return ReadTileDataBatch(
+        [&reader2d](imgdoc2::dbIndex pk, IBlobOutput* blob_output)->void
+        {
+            reader2d->ReadTileData(pk, blob_output);
+        },
+        pks,
+        count,
+        arena,
+        arena_size,
+        allocate_memory_function,
+        allocation_object,
+        entries,
+        error_information);
+}
+
+ImgDoc2ErrorCode IDocRead3d_ReadBrickData(
+    HandleDocRead3D handle,
+    std::int64_t pk,
+    std::intptr_t blob_output_handle,
+    MemTransferReserveFunctionPointer pfnReserve,
+    MemTransferSetDataFunctionPointer pfnSetData,
+    ImgDoc2ErrorInformation* error_information)
+{
+    const OperationStatistics::Scope operation_scope(OperationStatistics::GetInstance(), OperationStatistics::Operation::ReadTileData);
     static_assert(sizeof(pk) == sizeof(imgdoc2::dbIndex), "Type of the argument 'pk' and the imgdoc2-dbIndex-type must have same size.");
 
     const auto reader3d_object = reinterpret_cast<SharedPtrWrapper<IDocRead3d>*>(handle); // NOLINT(performance-no-int-to-ptr)
@@ -1192,12 +1817,511 @@ ImgDoc2ErrorCode IDocRead3d_ReadBrickData(
         return ImgDoc2_ErrorCode_InvalidHandle;
     }
 
-    const auto reader3d = reader3d_object->shared_ptr_;
+    const auto reader3d = reader3d_object->shared_ptr_;
+
+    Utilities::BlobOutputOnFunctionsDecorator blob_output_object(blob_output_handle, pfnReserve, pfnSetData);
+    try
+    {
+        reader3d->ReadBrickData(pk, &blob_output_object);
+        OperationStatistics::GetInstance().AddBytesRead(blob_output_object.GetSize());
+    }
+    catch (exception& exception)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformation(exception, error_information);
+        return ImgDoc2ApiSupport::MapExceptionToReturnValue(exception);
+    }
+
+    return ImgDoc2_ErrorCode_OK;
+}
+
+ImgDoc2ErrorCode IDocRead3d_GetBrickDataSize(
+    HandleDocRead3D handle,
+    std::int64_t pk,
+    std::uint64_t* size,
+    ImgDoc2ErrorInformation* error_information)
+{
+    if (size == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("size", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    const auto reader3d_object = reinterpret_cast<SharedPtrWrapper<IDocRead3d>*>(handle); // NOLINT(performance-no-int-to-ptr)
+    if (!reader3d_object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleDocRead3D", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    try
+    {
+        *size = reader3d_object->shared_ptr_->GetBrickDataSize(pk);
+    }
+    catch (exception& exception)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformation(exception, error_information);
+        return ImgDoc2ApiSupport::MapExceptionToReturnValue(exception);
+    }
+
+    return ImgDoc2_ErrorCode_OK;
+}
+
+ImgDoc2ErrorCode IDocRead3d_ReadBrickDataIntoBuffer(
+    HandleDocRead3D handle,
+    std::int64_t pk,
+    void* buffer,
+    std::uint64_t* size,
+    ImgDoc2ErrorInformation* error_information)
+{
+    const OperationStatistics::Scope operation_scope(OperationStatistics::GetInstance(), OperationStatistics::Operation::ReadTileData);
+    if (size == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("size", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    if (buffer == nullptr && *size > 0)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("buffer", "must not be null if the size is greater than 0", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    const auto reader3d_object = reinterpret_cast<SharedPtrWrapper<IDocRead3d>*>(handle); // NOLINT(performance-no-int-to-ptr)
+    if (!reader3d_object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleDocRead3D", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    // the buffer is used as an "arena" for one blob, i.e. the data is written directly into it (if it fits)
+    Utilities::BlobOutputIntoArena blob_output(buffer, *size);
+    try
+    {
+        reader3d_object->shared_ptr_->ReadBrickData(pk, &blob_output);
+    }
+    catch (exception& exception)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformation(exception, error_information);
+        return ImgDoc2ApiSupport::MapExceptionToReturnValue(exception);
+    }
+
+    if (!blob_output.GetIsRejected())
+    {
+        OperationStatistics::GetInstance().AddBytesRead(blob_output.GetBlobSize());
+    }
+
+    *size = blob_output.GetBlobSize();
+    return ImgDoc2_ErrorCode_OK;
+}
+
+ImgDoc2ErrorCode IDocRead3d_ReadBrickDataBatch(
+    HandleDocRead3D handle,
+    const std::int64_t* pks,
+    std::uint32_t count,
+    void* arena,
+    std::uint64_t arena_size,
+    AllocMemoryFunctionPointer allocate_memory_function,
+    AllocationObject* allocation_object,
+    TileDataBatchEntryInterop* entries,
+    ImgDoc2ErrorInformation* error_information)
+{
+    const OperationStatistics::Scope operation_scope(OperationStatistics::GetInstance(), OperationStatistics::Operation::ReadTileData);
+    static_assert(sizeof(*pks) == sizeof(imgdoc2::dbIndex), "Type of the argument 'pks' and the imgdoc2-dbIndex-type must have same size.");
+
+    const auto reader3d_object = reinterpret_cast<SharedPtrWrapper<IDocRead3d>*>(handle); // NOLINT(performance-no-int-to-ptr)
+    if (!reader3d_object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleDocRead3D", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    const auto reader3d = reader3d_object->shared_ptr_;
+    return ReadTileDataBatch(
+        [&reader3d](imgdoc2::dbIndex pk, IBlobOutput* blob_output)->void
+        {
+            reader3d->ReadBrickData(pk, blob_output);
+        },
+        pks,
+        count,
+        arena,
+        arena_size,
+        allocate_memory_function,
+        allocation_object,
+        entries,
+        error_information);
+}
+
+ImgDoc2ErrorCode IDocRead3d_RenderPlaneSlice(
+    HandleDocRead3D handle,
+    const PlaneNormalAndDistanceInterop* plane_normal_and_distance_interop,
+    const Vector3dDoubleInterop* axis_u,
+    const Vector3dDoubleInterop* axis_v,
+    const RectangleDoubleInterop* region,
+    const DimensionQueryClauseInterop* dim_coordinate_query_clause_interop,
+    std::uint8_t pixel_type,
+    double background_value,
+    std::uint8_t sampling_filter,
+    std::uint32_t destination_width,
+    std::uint32_t destination_height,
+    std::uint32_t destination_stride,
+    void* destination,
+    ImgDoc2ErrorInformation* error_information)
+{
+    if (plane_normal_and_distance_interop == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("plane_normal_and_distance_interop", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    if (axis_u == nullptr || axis_v == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("axis_u/axis_v", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    if (region == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("region", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    if (destination == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("destination", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    if (sampling_filter > static_cast<std::uint8_t>(PlaneSliceRenderer::SamplingFilter::Trilinear))
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("sampling_filter", "is not supported", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    const auto reader3d_object = reinterpret_cast<SharedPtrWrapper<IDocRead3d>*>(handle); // NOLINT(performance-no-int-to-ptr)
+    if (!reader3d_object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleDocRead3D", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    const auto dimension_coordinate_query_clause = dim_coordinate_query_clause_interop != nullptr ?
+        Utilities::ConvertDimensionQueryRangeClauseInteropToImgdoc2(dim_coordinate_query_clause_interop) :
+        CDimCoordinateQueryClause();
+
+    PlaneSliceRenderer::SliceGeometry geometry;
+    geometry.plane = Utilities::ConvertPlaneNormalAndDistanceInterop(*plane_normal_and_distance_interop);
+    geometry.axis_u = Vector3dD(axis_u->x, axis_u->y, axis_u->z);
+    geometry.axis_v = Vector3dD(axis_v->x, axis_v->y, axis_v->z);
+    PlaneSliceRenderer::Options options;
+    options.pixel_type = pixel_type;
+    options.background_value = background_value;
+    options.filter = static_cast<PlaneSliceRenderer::SamplingFilter>(sampling_filter);
+    PlaneSliceRenderer::DestinationBitmap destination_bitmap;
+    destination_bitmap.data = destination;
+    destination_bitmap.width = destination_width;
+    destination_bitmap.height = destination_height;
+    destination_bitmap.stride = destination_stride;
+
+    try
+    {
+        geometry.region = Utilities::ConvertRectangleDoubleInterop(*region);
+        PlaneSliceRenderer renderer(reader3d_object->shared_ptr_);
+        renderer.Render(
+            geometry,
+            dim_coordinate_query_clause_interop != nullptr ? &dimension_coordinate_query_clause : nullptr,
+            options,
+            destination_bitmap);
+    }
+    catch (exception& exception)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformation(exception, error_information);
+        return ImgDoc2ApiSupport::MapExceptionToReturnValue(exception);
+    }
+
+    return ImgDoc2_ErrorCode_OK;
+}
+
+static ImgDoc2ErrorCode CheckProjectionArguments(std::uint8_t axis, std::uint8_t operation, ImgDoc2ErrorInformation* error_information)
+{
+    if (axis > static_cast<std::uint8_t>(VolumeProjector::Axis::Z))
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("axis", "is not supported", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    if (operation > static_cast<std::uint8_t>(VolumeProjector::Operation::Mean))
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("operation", "is not supported", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    return ImgDoc2_ErrorCode_OK;
+}
+
+ImgDoc2ErrorCode IDocRead3d_Project(
+    HandleDocRead3D handle,
+    const CuboidDoubleInterop* roi_cuboid,
+    const DimensionQueryClauseInterop* dim_coordinate_query_clause_interop,
+    std::uint8_t axis,
+    std::uint8_t operation,
+    std::uint8_t pixel_type,
+    double background_value,
+    std::uint32_t destination_width,
+    std::uint32_t destination_height,
+    std::uint32_t destination_stride,
+    void* destination,
+    ImgDoc2ErrorInformation* error_information)
+{
+    if (roi_cuboid == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("roi_cuboid", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    if (destination == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("destination", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    const auto check_result = CheckProjectionArguments(axis, operation, error_information);
+    if (check_result != ImgDoc2_ErrorCode_OK)
+    {
+        return check_result;
+    }
+
+    const auto reader3d_object = reinterpret_cast<SharedPtrWrapper<IDocRead3d>*>(handle); // NOLINT(performance-no-int-to-ptr)
+    if (!reader3d_object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleDocRead3D", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    const auto dimension_coordinate_query_clause = dim_coordinate_query_clause_interop != nullptr ?
+        Utilities::ConvertDimensionQueryRangeClauseInteropToImgdoc2(dim_coordinate_query_clause_interop) :
+        CDimCoordinateQueryClause();
+
+    VolumeProjector::Options options;
+    options.axis = static_cast<VolumeProjector::Axis>(axis);
+    options.operation = static_cast<VolumeProjector::Operation>(operation);
+    options.pixel_type = pixel_type;
+    options.background_value = background_value;
+    VolumeProjector::DestinationBitmap destination_bitmap;
+    destination_bitmap.data = destination;
+    destination_bitmap.width = destination_width;
+    destination_bitmap.height = destination_height;
+    destination_bitmap.stride = destination_stride;
+
+    try
+    {
+        const auto roi = Utilities::ConvertCuboidDoubleInterop(*roi_cuboid);
+        VolumeProjector projector(reader3d_object->shared_ptr_);
+        projector.Project(
+            roi,
+            dim_coordinate_query_clause_interop != nullptr ? &dimension_coordinate_query_clause : nullptr,
+            options,
+            destination_bitmap);
+    }
+    catch (exception& exception)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformation(exception, error_information);
+        return ImgDoc2ApiSupport::MapExceptionToReturnValue(exception);
+    }
+
+    return ImgDoc2_ErrorCode_OK;
+}
+
+ImgDoc2ErrorCode IDocRead3d_ProjectIntoDocument2d(
+    HandleDocRead3D handle,
+    const CuboidDoubleInterop* roi_cuboid,
+    const DimensionQueryClauseInterop* dim_coordinate_query_clause_interop,
+    std::uint8_t axis,
+    std::uint8_t operation,
+    std::uint8_t pixel_type,
+    double background_value,
+    std::uint32_t width,
+    std::uint32_t height,
+    HandleDocWrite2D writer2d_handle,
+    const TileCoordinateInterop* tile_coordinate_interop,
+    const LogicalPositionInfoInterop* logical_position_info_interop,
+    imgdoc2::dbIndex* result_pk,
+    ImgDoc2ErrorInformation* error_information)
+{
+    if (roi_cuboid == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("roi_cuboid", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    if (tile_coordinate_interop == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("tile_coordinate_interop", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    if (logical_position_info_interop == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("logical_position_info_interop", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    const auto check_result = CheckProjectionArguments(axis, operation, error_information);
+    if (check_result != ImgDoc2_ErrorCode_OK)
+    {
+        return check_result;
+    }
+
+    const auto reader3d_object = reinterpret_cast<SharedPtrWrapper<IDocRead3d>*>(handle); // NOLINT(performance-no-int-to-ptr)
+    if (!reader3d_object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleDocRead3D", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    const auto write2d_object = reinterpret_cast<SharedPtrWrapper<IDocWrite2d>*>(writer2d_handle); // NOLINT(performance-no-int-to-ptr)
+    if (!write2d_object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleDocWrite2D", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    const auto dimension_coordinate_query_clause = dim_coordinate_query_clause_interop != nullptr ?
+        Utilities::ConvertDimensionQueryRangeClauseInteropToImgdoc2(dim_coordinate_query_clause_interop) :
+        CDimCoordinateQueryClause();
+    const auto tile_coordinate = Utilities::ConvertToTileCoordinate(tile_coordinate_interop);
+    const auto logical_position_info = Utilities::ConvertLogicalPositionInfoInteropToImgdoc2(*logical_position_info_interop);
+
+    VolumeProjector::Options options;
+    options.axis = static_cast<VolumeProjector::Axis>(axis);
+    options.operation = static_cast<VolumeProjector::Operation>(operation);
+    options.pixel_type = pixel_type;
+    options.background_value = background_value;
+
+    try
+    {
+        TileBaseInfo tile_info;
+        tile_info.pixelWidth = width;
+        tile_info.pixelHeight = height;
+        tile_info.pixelType = VolumeProjector::GetResultPixelType(options.operation, pixel_type);
+        const uint8_t bytes_per_pixel = RenderingUtilities::GetBytesPerPixel(tile_info.pixelType);
+        vector<uint8_t> bitmap(static_cast<size_t>(width) * height * bytes_per_pixel);
+        VolumeProjector::DestinationBitmap destination_bitmap;
+        destination_bitmap.data = bitmap.data();
+        destination_bitmap.width = width;
+        destination_bitmap.height = height;
+        destination_bitmap.stride = width * bytes_per_pixel;
+
+        const auto roi = Utilities::ConvertCuboidDoubleInterop(*roi_cuboid);
+        VolumeProjector projector(reader3d_object->shared_ptr_);
+        projector.Project(
+            roi,
+            dim_coordinate_query_clause_interop != nullptr ? &dimension_coordinate_query_clause : nullptr,
+            options,
+            destination_bitmap);
+
+        const Utilities::GetDataObject data_object(bitmap.data(), bitmap.size());
+        const auto pk = write2d_object->shared_ptr_->AddTile(
+            &tile_coordinate,
+            &logical_position_info,
+            &tile_info,
+            DataTypes::UNCOMPRESSED_BITMAP,
+            TileDataStorageType::BlobInDatabase,
+            &data_object);
+        if (result_pk != nullptr)
+        {
+            *result_pk = pk;
+        }
+    }
+    catch (exception& exception)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformation(exception, error_information);
+        return ImgDoc2ApiSupport::MapExceptionToReturnValue(exception);
+    }
+
+    return ImgDoc2_ErrorCode_OK;
+}
+
+static RegionStatistics::Options CreateRegionStatisticsOptions(std::uint8_t pixel_type, std::uint32_t number_of_bins, double range_minimum, double range_maximum, std::uint64_t max_number_of_pixels)
+{
+    RegionStatistics::Options options;
+    options.pixel_type = pixel_type;
+    options.number_of_bins = number_of_bins;
+    options.range_minimum = range_minimum;
+    options.range_maximum = range_maximum;
+    options.max_number_of_pixels = max_number_of_pixels;
+    return options;
+}
+
+static void CopyRegionStatisticsResult(const RegionStatistics::Result& result, RegionStatisticsInterop* statistics, std::uint64_t* histogram, std::uint32_t* histogram_count)
+{
+    if (statistics != nullptr)
+    {
+        statistics->number_of_pixels = result.number_of_pixels;
+        statistics->minimum = result.minimum;
+        statistics->maximum = result.maximum;
+        statistics->mean = result.mean;
+        statistics->standard_deviation = result.standard_deviation;
+        statistics->histogram_range_minimum = result.range_minimum;
+        statistics->histogram_range_maximum = result.range_maximum;
+        statistics->pyramid_level = result.pyramid_level;
+    }
+
+    if (histogram_count != nullptr)
+    {
+        if (histogram != nullptr)
+        {
+            copy_n(result.histogram.cbegin(), min(static_cast<size_t>(*histogram_count), result.histogram.size()), histogram);
+        }
+
+        *histogram_count = gsl::narrow<std::uint32_t>(result.histogram.size());
+    }
+}
+
+ImgDoc2ErrorCode IDocRead3d_CalculateStatistics(
+    HandleDocRead3D handle,
+    const CuboidDoubleInterop* roi_cuboid,
+    const DimensionQueryClauseInterop* dim_coordinate_query_clause_interop,
+    std::uint8_t pixel_type,
+    std::uint32_t number_of_bins,
+    double range_minimum,
+    double range_maximum,
+    std::uint64_t max_number_of_pixels,
+    RegionStatisticsInterop* statistics,
+    std::uint64_t* histogram,
+    std::uint32_t* histogram_count,
+    ImgDoc2ErrorInformation* error_information)
+{
+    if (roi_cuboid == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("roi_cuboid", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    if (histogram != nullptr && histogram_count == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("histogram_count", "must not be null if 'histogram' is non-null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    const auto reader3d_object = reinterpret_cast<SharedPtrWrapper<IDocRead3d>*>(handle); // NOLINT(performance-no-int-to-ptr)
+    if (!reader3d_object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleDocRead3D", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    const auto dimension_coordinate_query_clause = dim_coordinate_query_clause_interop != nullptr ?
+        Utilities::ConvertDimensionQueryRangeClauseInteropToImgdoc2(dim_coordinate_query_clause_interop) :
+        CDimCoordinateQueryClause();
 
-    Utilities::BlobOutputOnFunctionsDecorator blob_output_object(blob_output_handle, pfnReserve, pfnSetData);
     try
     {
-        reader3d->ReadBrickData(pk, &blob_output_object);
+        RegionStatistics region_statistics(reader3d_object->shared_ptr_);
+        const auto result = region_statistics.Calculate(
+            Utilities::ConvertCuboidDoubleInterop(*roi_cuboid),
+            dim_coordinate_query_clause_interop != nullptr ? &dimension_coordinate_query_clause : nullptr,
+            CreateRegionStatisticsOptions(pixel_type, number_of_bins, range_minimum, range_maximum, max_number_of_pixels));
+        CopyRegionStatisticsResult(result, statistics, histogram, histogram_count);
     }
     catch (exception& exception)
     {
@@ -1267,6 +2391,175 @@ ImgDoc2ErrorCode IDocRead2d_ReadTileInfo(
     return ImgDoc2_ErrorCode_OK;
 }
 
+ImgDoc2ErrorCode IDocRead2d_CompositeRegion(
+    HandleDocRead2D handle,
+    const RectangleDoubleInterop* roi,
+    const DimensionQueryClauseInterop* dim_coordinate_query_clause_interop,
+    std::uint8_t pixel_type,
+    double background_value,
+    std::uint8_t resampling_filter,
+    std::uint32_t destination_width,
+    std::uint32_t destination_height,
+    std::uint32_t destination_stride,
+    void* destination,
+    ImgDoc2ErrorInformation* error_information)
+{
+    if (roi == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("roi", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    if (destination == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("destination", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    if (resampling_filter > static_cast<std::uint8_t>(RegionCompositor::ResamplingFilter::Bilinear))
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("resampling_filter", "is not supported", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    const auto reader2d_object = reinterpret_cast<SharedPtrWrapper<IDocRead2d>*>(handle); // NOLINT(performance-no-int-to-ptr)
+    if (!reader2d_object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleDocRead2D", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    const auto dimension_coordinate_query_clause = dim_coordinate_query_clause_interop != nullptr ?
+        Utilities::ConvertDimensionQueryRangeClauseInteropToImgdoc2(dim_coordinate_query_clause_interop) :
+        CDimCoordinateQueryClause();
+
+    RegionCompositor::Options options;
+    options.pixel_type = pixel_type;
+    options.background_value = background_value;
+    options.filter = static_cast<RegionCompositor::ResamplingFilter>(resampling_filter);
+    RegionCompositor::DestinationBitmap destination_bitmap;
+    destination_bitmap.data = destination;
+    destination_bitmap.width = destination_width;
+    destination_bitmap.height = destination_height;
+    destination_bitmap.stride = destination_stride;
+
+    try
+    {
+        RegionCompositor compositor(reader2d_object->shared_ptr_);
+        compositor.Compose(
+            Utilities::ConvertRectangleDoubleInterop(*roi),
+            dim_coordinate_query_clause_interop != nullptr ? &dimension_coordinate_query_clause : nullptr,
+            options,
+            destination_bitmap);
+    }
+    catch (exception& exception)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformation(exception, error_information);
+        return ImgDoc2ApiSupport::MapExceptionToReturnValue(exception);
+    }
+
+    return ImgDoc2_ErrorCode_OK;
+}
+
+ImgDoc2ErrorCode IDocRead2d_CalculateStatistics(
+    HandleDocRead2D handle,
+    const RectangleDoubleInterop* roi,
+    const DimensionQueryClauseInterop* dim_coordinate_query_clause_interop,
+    std::uint8_t pixel_type,
+    std::uint32_t number_of_bins,
+    double range_minimum,
+    double range_maximum,
+    std::uint64_t max_number_of_pixels,
+    RegionStatisticsInterop* statistics,
+    std::uint64_t* histogram,
+    std::uint32_t* histogram_count,
+    ImgDoc2ErrorInformation* error_information)
+{
+    if (roi == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("roi", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    if (histogram != nullptr && histogram_count == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("histogram_count", "must not be null if 'histogram' is non-null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    const auto reader2d_object = reinterpret_cast<SharedPtrWrapper<IDocRead2d>*>(handle); // NOLINT(performance-no-int-to-ptr)
+    if (!reader2d_object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleDocRead2D", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    const auto dimension_coordinate_query_clause = dim_coordinate_query_clause_interop != nullptr ?
+        Utilities::ConvertDimensionQueryRangeClauseInteropToImgdoc2(dim_coordinate_query_clause_interop) :
+        CDimCoordinateQueryClause();
+
+    try
+    {
+        RegionStatistics region_statistics(reader2d_object->shared_ptr_);
+        const auto result = region_statistics.Calculate(
+            Utilities::ConvertRectangleDoubleInterop(*roi),
+            dim_coordinate_query_clause_interop != nullptr ? &dimension_coordinate_query_clause : nullptr,
+            CreateRegionStatisticsOptions(pixel_type, number_of_bins, range_minimum, range_maximum, max_number_of_pixels));
+        CopyRegionStatisticsResult(result, statistics, histogram, histogram_count);
+    }
+    catch (exception& exception)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformation(exception, error_information);
+        return ImgDoc2ApiSupport::MapExceptionToReturnValue(exception);
+    }
+
+    return ImgDoc2_ErrorCode_OK;
+}
+
+ImgDoc2ErrorCode IDoc_GeneratePyramid2d(
+    HandleDoc handle_document,
+    std::uint32_t minification_factor,
+    std::uint32_t number_of_levels,
+    std::uint32_t tile_width,
+    std::uint32_t tile_height,
+    std::uint32_t max_number_of_threads,
+    ImgDoc2ErrorInformation* error_information)
+{
+    const auto document_object = reinterpret_cast<SharedPtrWrapper<IDoc>*>(handle_document);  // NOLINT(performance-no-int-to-ptr)
+    if (!document_object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleDoc", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    PyramidGenerator::Options options;
+    options.minification_factor = minification_factor;
+    options.number_of_levels = number_of_levels;
+    options.tile_width = tile_width;
+    options.tile_height = tile_height;
+    options.max_number_of_threads = max_number_of_threads;
+
+    try
+    {
+        auto reader2d = document_object->shared_ptr_->GetReader2d();
+        auto writer2d = document_object->shared_ptr_->GetWriter2d();
+        if (!reader2d || !writer2d)
+        {
+            throw invalid_operation_exception("The document is not a 2D-document.");
+        }
+
+        PyramidGenerator generator(reader2d, writer2d);
+        generator.Generate(options);
+    }
+    catch (exception& exception)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformation(exception, error_information);
+        return ImgDoc2ApiSupport::MapExceptionToReturnValue(exception);
+    }
+
+    return ImgDoc2_ErrorCode_OK;
+}
+
 ImgDoc2ErrorCode IDocRead3d_ReadBrickInfo(
     HandleDocRead3D handle,
     std::int64_t pk,
@@ -1730,6 +3023,7 @@ ImgDoc2ErrorCode IDocInfo3d_GetTileCountPerLayer(
 
 static ImgDoc2ErrorCode IDocWriter2d_TransactionCommon(HandleDocWrite2D handle, ImgDoc2ErrorInformation* error_information, void(IDatabaseTransaction::* mfp)())
 {
+    const OperationStatistics::Scope operation_scope(OperationStatistics::GetInstance(), OperationStatistics::Operation::Transaction);
     const auto writer2d_object = reinterpret_cast<SharedPtrWrapper<IDocWrite2d>*>(handle); // NOLINT(performance-no-int-to-ptr)
     if (!writer2d_object->IsValid())
     {
@@ -1768,6 +3062,7 @@ ImgDoc2ErrorCode IDocWrite2d_RollbackTransaction(HandleDocWrite2D handle, ImgDoc
 
 static ImgDoc2ErrorCode IDocWriter3d_TransactionCommon(HandleDocWrite3D handle, ImgDoc2ErrorInformation* error_information, void(IDatabaseTransaction::* mfp)())
 {
+    const OperationStatistics::Scope operation_scope(OperationStatistics::GetInstance(), OperationStatistics::Operation::Transaction);
     const auto writer3d_object = reinterpret_cast<SharedPtrWrapper<IDocWrite3d>*>(handle); // NOLINT(performance-no-int-to-ptr)
     if (!writer3d_object->IsValid())
     {
@@ -1803,3 +3098,115 @@ ImgDoc2ErrorCode IDocWrite3d_RollbackTransaction(HandleDocWrite3D handle, ImgDoc
 {
     return IDocWriter3d_TransactionCommon(handle, error_information, &IDatabaseTransaction::RollbackTransaction);
 }
+
+ImgDoc2ErrorCode IDocWrite2d_SetAutoCommitPolicy(HandleDocWrite2D handle, const AutoCommitPolicyInterop* auto_commit_policy_interop, ImgDoc2ErrorInformation* error_information)
+{
+    if (auto_commit_policy_interop == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("auto_commit_policy_interop", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    const auto writer2d_object = reinterpret_cast<SharedPtrWrapper<IDocWrite2d>*>(handle); // NOLINT(performance-no-int-to-ptr)
+    if (!writer2d_object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleDocWrite2D", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    AutoCommitPolicy auto_commit_policy;
+    auto_commit_policy.max_items = auto_commit_policy_interop->max_items;
+    auto_commit_policy.max_bytes = auto_commit_policy_interop->max_bytes;
+    auto_commit_policy.max_duration_milliseconds = auto_commit_policy_interop->max_duration_milliseconds;
+
+    const auto writer2d = writer2d_object->shared_ptr_;
+    try
+    {
+        writer2d->SetAutoCommitPolicy(auto_commit_policy);
+    }
+    catch (exception& exception)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformation(exception, error_information);
+        return ImgDoc2ApiSupport::MapExceptionToReturnValue(exception);
+    }
+
+    return ImgDoc2_ErrorCode_OK;
+}
+
+ImgDoc2ErrorCode IDocWrite2d_GetAutoCommitPolicy(HandleDocWrite2D handle, AutoCommitPolicyInterop* auto_commit_policy_interop, ImgDoc2ErrorInformation* error_information)
+{
+    if (auto_commit_policy_interop == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("auto_commit_policy_interop", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    const auto writer2d_object = reinterpret_cast<SharedPtrWrapper<IDocWrite2d>*>(handle); // NOLINT(performance-no-int-to-ptr)
+    if (!writer2d_object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleDocWrite2D", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    const auto auto_commit_policy = writer2d_object->shared_ptr_->GetAutoCommitPolicy();
+    auto_commit_policy_interop->max_items = auto_commit_policy.max_items;
+    auto_commit_policy_interop->max_bytes = auto_commit_policy.max_bytes;
+    auto_commit_policy_interop->max_duration_milliseconds = auto_commit_policy.max_duration_milliseconds;
+    return ImgDoc2_ErrorCode_OK;
+}
+
+ImgDoc2ErrorCode IDocWrite3d_SetAutoCommitPolicy(HandleDocWrite3D handle, const AutoCommitPolicyInterop* auto_commit_policy_interop, ImgDoc2ErrorInformation* error_information)
+{
+    if (auto_commit_policy_interop == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("auto_commit_policy_interop", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    const auto writer3d_object = reinterpret_cast<SharedPtrWrapper<IDocWrite3d>*>(handle); // NOLINT(performance-no-int-to-ptr)
+    if (!writer3d_object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleDocWrite3D", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    AutoCommitPolicy auto_commit_policy;
+    auto_commit_policy.max_items = auto_commit_policy_interop->max_items;
+    auto_commit_policy.max_bytes = auto_commit_policy_interop->max_bytes;
+    auto_commit_policy.max_duration_milliseconds = auto_commit_policy_interop->max_duration_milliseconds;
+
+    const auto writer3d = writer3d_object->shared_ptr_;
+    try
+    {
+        writer3d->SetAutoCommitPolicy(auto_commit_policy);
+    }
+    catch (exception& exception)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformation(exception, error_information);
+        return ImgDoc2ApiSupport::MapExceptionToReturnValue(exception);
+    }
+
+    return ImgDoc2_ErrorCode_OK;
+}
+
+ImgDoc2ErrorCode IDocWrite3d_GetAutoCommitPolicy(HandleDocWrite3D handle, AutoCommitPolicyInterop* auto_commit_policy_interop, ImgDoc2ErrorInformation* error_information)
+{
+    if (auto_commit_policy_interop == nullptr)
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidArgument("auto_commit_policy_interop", "must not be null", error_information);
+        return ImgDoc2_ErrorCode_InvalidArgument;
+    }
+
+    const auto writer3d_object = reinterpret_cast<SharedPtrWrapper<IDocWrite3d>*>(handle); // NOLINT(performance-no-int-to-ptr)
+    if (!writer3d_object->IsValid())
+    {
+        ImgDoc2ApiSupport::FillOutErrorInformationForInvalidHandle("HandleDocWrite3D", "The handle is invalid.", error_information);
+        return ImgDoc2_ErrorCode_InvalidHandle;
+    }
+
+    const auto auto_commit_policy = writer3d_object->shared_ptr_->GetAutoCommitPolicy();
+    auto_commit_policy_interop->max_items = auto_commit_policy.max_items;
+    auto_commit_policy_interop->max_bytes = auto_commit_policy.max_bytes;
+    auto_commit_policy_interop->max_duration_milliseconds = auto_commit_policy.max_duration_milliseconds;
+    return ImgDoc2_ErrorCode_OK;
+}
@@ -18,11 +18,18 @@
 #include "tilebaseinfointerop.h"
 #include "brickbaseinfointerop.h"
 #include "imgdoc2statisticsinterop.h"
+#include "operationstatisticsinterop.h"
 #include "rectangledoubleinterop.h"
 #include "cuboiddoubleinterop.h"
 #include "minmaxfortiledimensioninterop.h"
 #include "tilecountperlayerinterop.h"
 #include "planenormalanddistanceinterop.h"
+#include "vector3ddoubleinterop.h"
+#include "regionstatisticsinterop.h"
+#include "tiledatabatchentryinterop.h"
+#include "tiletoaddinterop.h"
+#include "bricktoaddinterop.h"
+#include "autocommitpolicyinterop.h"
 #include "versioninfointerop.h"
 #include "allocationobject.h"
 
@@ -84,6 +91,42 @@ EXTERNAL_API(ImgDoc2ErrorCode) GetVersionInfo(VersionInfoInterop* version_info,
 /// \param [out] statistics_interop     If non-null, the statistics is put here. If null, the call is a no-op.
 EXTERNAL_API(void) GetStatistics(ImgDoc2StatisticsInterop* statistics_interop);
 
+/// Retrieve the performance counters for a kind of operation of the imgdoc2API - the number of calls, the accumulated, maximal
+/// and estimated percentiles of the durations, and a histogram of the durations. The kinds of operation are: 0 for queries (e.g.
+/// IDocRead2d_Query or IDocRead2d_GetTilesIntersectingRect), 1 for reading tile data (e.g. IDocRead2d_ReadTileData), 2 for adding
+/// tiles (e.g. IDocWrite2d_AddTile), 3 for decoding bitmaps (e.g. DecodeImage, where every image decoded with DecodeImages is
+/// counted individually), 4 for transactions (beginning, committing or rolling back) and 5 for adding a batch of tiles (with
+/// IDocWrite2d_AddTiles, where the batch is counted as one call) - the respective 3D-operations are counted as well. The counters are maintained for the lifetime of the library and can be reset with ResetStatistics.
+/// The histogram uses logarithmic buckets (where each power of two is divided into 8 buckets of equal width), and the lower
+/// bound of a bucket can be retrieved with GetOperationStatisticsBucketLowerBound. All durations are given in nanoseconds.
+///
+/// \param          operation           The kind of operation.
+/// \param [out]    statistics          If non-null, the performance counters are put here.
+/// \param [out]    histogram           If non-null, the histogram is put here (at most 'histogram_count' elements).
+/// \param [in,out] histogram_count     On input, the number of elements of the array 'histogram'; on output, the number of buckets of the histogram. May be null if 'histogram' is null.
+/// \param [out]    error_information   If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) GetOperationStatistics(
+    std::uint8_t operation,
+    OperationStatisticsInterop* statistics,
+    std::uint64_t* histogram,
+    std::uint32_t* histogram_count,
+    ImgDoc2ErrorInformation* error_information);
+
+/// Gets the lower bound of a bucket of the histogram returned by GetOperationStatistics, i.e. the smallest duration (in
+/// nanoseconds) which falls into this bucket. The upper bound of a bucket is the lower bound of the next bucket (exclusive).
+///
+/// \param  bucket_index    The index of the bucket.
+///
+/// \returns The lower bound of the bucket in nanoseconds (or the maximal value of an uint64 if the index is out of range).
+EXTERNAL_API(std::uint64_t) GetOperationStatisticsBucketLowerBound(std::uint32_t bucket_index);
+
+/// Resets the performance counters (i.e. the counters reported by GetOperationStatistics and the counters of bytes read and
+/// written, statements prepared and decoded-bitmap-cache lookups reported by GetStatistics) to zero. This allows for sampling
+/// the counters in intervals. The number of active objects is not affected.
+EXTERNAL_API(void) ResetStatistics();
+
 /// Create a new environment object. The environment-object created here will route certain actions to the
 /// function pointers given here.
 /// IMPORTANT: The environment object created here must have a lifetime greater than any of its usages.
@@ -266,6 +309,26 @@ EXTERNAL_API(ImgDoc2ErrorCode) CreateOptions_AddIndexForDimension(HandleCreateOp
 /// \returns An error-code indicating success or failure of the operation.
 EXTERNAL_API(ImgDoc2ErrorCode) CreateOptions_SetUseBlobTable(HandleCreateOptions handle, bool use_blob_table, ImgDoc2ErrorInformation* error_information);
 
+/// Method operating on a CreateOptions-object: Specify whether a "tile-statistics table" is to be created within the database. If
+/// so, then statistics of the pixel values are calculated and stored when a tile is added (for suitable tiles).
+///
+/// \param          handle                      The handle of the CreateOptions object.
+/// \param          create_tile_statistics_table Boolean whether a tile-statistics table is to be created.
+/// \param [in,out] error_information           If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) CreateOptions_SetCreateTileStatisticsTable(HandleCreateOptions handle, bool create_tile_statistics_table, ImgDoc2ErrorInformation* error_information);
+
+/// Method operating on a CreateOptions-object: Set the filename of a separate database-file which is to contain the blob-table.
+/// If this is an empty string (which is the default), the blob-table is created in the main database-file.
+///
+/// \param          handle            The handle of the CreateOptions object.
+/// \param          filename_utf8     The filename (given as an UTF-8 encoded string).
+/// \param [in,out] error_information If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) CreateOptions_SetBlobDatabaseFilename(HandleCreateOptions handle, const char* filename_utf8, ImgDoc2ErrorInformation* error_information);
+
 /// Method operating on a CreateOptions-object: Get the property 'filename' from the CreateOptions-object (as an UTF8-encoded string).
 /// On input, 'size' specifies the size of the buffer pointed to 'filename_utf8' in bytes. On return, the actual
 /// number of bytes required is put here (including the terminating zero character).
@@ -278,6 +341,18 @@ EXTERNAL_API(ImgDoc2ErrorCode) CreateOptions_SetUseBlobTable(HandleCreateOptions
 /// \returns An error-code indicating success or failure of the operation.
 EXTERNAL_API(ImgDoc2ErrorCode) CreateOptions_GetFilename(HandleCreateOptions handle, char* filename_utf8, size_t* size, ImgDoc2ErrorInformation* error_information);
 
+/// Method operating on a CreateOptions-object: Get the property 'blob database filename' from the CreateOptions-object (as an UTF8-encoded string).
+/// On input, 'size' specifies the size of the buffer pointed to 'filename_utf8' in bytes. On return, the actual
+/// number of bytes required is put here (including the terminating zero character).
+/// If 'filename_utf8' is non-null, then at most as many bytes as indicated by 'size' (on input) are written.
+/// \param          handle               Handle identifying an CreateOptions-object.
+/// \param [out]    filename_utf8        If non-null, the buffer where the string will be placed.
+/// \param [in,out] size                 On input, the size of the buffer pointed to by 'filename_utf8'; on output the number of bytes actually required.
+/// \param [out]    error_information    If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) CreateOptions_GetBlobDatabaseFilename(HandleCreateOptions handle, char* filename_utf8, size_t* size, ImgDoc2ErrorInformation* error_information);
+
 /// Method operating on a CreateOptions-object: get the document type setting from the CreateOptions object.
 ///
 /// \param          handle                The handle of the CreateOptions object.
@@ -305,6 +380,15 @@ EXTERNAL_API(ImgDoc2ErrorCode) CreateOptions_GetUseSpatialIndex(HandleCreateOpti
 /// \returns An error-code indicating success or failure of the operation.
 EXTERNAL_API(ImgDoc2ErrorCode) CreateOptions_GetUseBlobTable(HandleCreateOptions handle, bool* create_blob_table, ImgDoc2ErrorInformation* error_information);
 
+/// Method operating on a CreateOptions-object: get whether a tile-statistics table is to be constructed.
+///
+/// \param          handle                          The handle of the CreateOptions object.
+/// \param [out]    create_tile_statistics_table    If non-null, a boolean indicating whether a tile-statistics table is to be constructed is put here.
+/// \param [out]    error_information               If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) CreateOptions_GetCreateTileStatisticsTable(HandleCreateOptions handle, bool* create_tile_statistics_table, ImgDoc2ErrorInformation* error_information);
+
 /// Method operating on a CreateOptions-object: add a dimension.
 ///
 /// \param          handle                The handle of the CreateOptions object.
@@ -394,6 +478,35 @@ EXTERNAL_API(ImgDoc2ErrorCode) IDocWrite2d_AddTile(
     imgdoc2::dbIndex* result_pk,
     ImgDoc2ErrorInformation* error_information);
 
+/// Method operating on a writer2d-object: Add a batch of tiles to the document with a single call. The tiles are described by an array
+/// of TileToAddInterop-structures, where the coordinate of each tile is given as a range in the array 'coordinates', and the data of
+/// each tile is given as a range in the memory block 'data'. All tiles are added within one transaction (if there is no
+/// transaction pending already), and the database statements are prepared only once for the whole batch - so this is more
+/// efficient than calling IDocWrite2d_AddTile for each tile. If an error occurs, then (if the transaction was initiated by this
+/// function) none of the tiles is added.
+///
+/// \param          handle                  The writer2d-object.
+/// \param          tiles                   Array of structures describing the tiles to be added.
+/// \param          count                   The number of tiles.
+/// \param          coordinates             Array of dimension-value-pairs containing the coordinates of all tiles.
+/// \param          coordinates_count       The number of elements in the array 'coordinates'.
+/// \param          data                    The memory block containing the data of all tiles.
+/// \param          data_size               The size of the memory block 'data' in bytes.
+/// \param [out]    result_pks              If non-null and in case of success, the primary keys of the newly added tiles are put here (this array must have room for 'count' elements).
+/// \param [out]    error_information       If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) IDocWrite2d_AddTiles(
+    HandleDocWrite2D handle,
+    const TileToAddInterop* tiles,
+    std::uint32_t count,
+    const DimensionAndValueInterop* coordinates,
+    std::uint32_t coordinates_count,
+    const void* data,
+    std::uint64_t data_size,
+    imgdoc2::dbIndex* result_pks,
+    ImgDoc2ErrorInformation* error_information);
+
 /// Method operating on a reader2d-object: query the tiles table. The two query clauses are
 /// used to filter the tiles. The first clause is used to filter the tiles by their
 /// coordinates, the second by other "per tile data". Matching tiles are returned in the
@@ -438,6 +551,68 @@ EXTERNAL_API(ImgDoc2ErrorCode) IDocRead2d_ReadTileData(
     MemTransferSetDataFunctionPointer pfnSetData,
     ImgDoc2ErrorInformation* error_information);
 
+/// Method operating on a reader2d-object: get the size of the data of the specified tile (in bytes), without reading the data.
+///
+/// \param          handle              The reader2d object.
+/// \param          pk                  The primary key of the tile.
+/// \param [out]    size                The size of the data in bytes is put here.
+/// \param [out]    error_information   If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns    An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) IDocRead2d_GetTileDataSize(
+    HandleDocRead2D handle,
+    std::int64_t pk,
+    std::uint64_t* size,
+    ImgDoc2ErrorInformation* error_information);
+
+/// Method operating on a reader2d-object: read the data of the specified tile directly into a caller-provided buffer. On input, 'size'
+/// specifies the size of the buffer in bytes. On return, the actual size of the data is put there. If the buffer is too
+/// small, nothing is written to the buffer (and the caller can retry with a buffer of the size reported).
+///
+/// \param          handle              The reader2d object.
+/// \param          pk                  The primary key of the tile.
+/// \param [out]    buffer              The buffer into which the data is written (may be null if 'size' is 0 on input).
+/// \param [in,out] size                On input, the size of the buffer; on output, the size of the data in bytes.
+/// \param [out]    error_information   If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns    An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) IDocRead2d_ReadTileDataIntoBuffer(
+    HandleDocRead2D handle,
+    std::int64_t pk,
+    void* buffer,
+    std::uint64_t* size,
+    ImgDoc2ErrorInformation* error_information);
+
+/// Method operating on a reader2d-object: read the data of a batch of tiles with one call. The data is placed into one memory
+/// block - either into the caller-provided "arena", or (if no arena is given) into a memory block allocated with one call
+/// to 'allocate_memory_function'. The data of a tile is placed at an offset (relative to the start of the memory block) which is
+/// a multiple of 16, and the offset, the size and the result are reported for each tile in the 'entries' array. If the data
+/// of a tile does not fit into the remaining space of the arena, its result is ImgDoc2_ErrorCode_AllocationError (and its
+/// size is reported), and the subsequent tiles are still read. A failure for one tile does not affect the other tiles.
+///
+/// \param          handle                      The reader2d object.
+/// \param          pks                         The primary keys of the tiles (an array with 'count' elements).
+/// \param          count                       The number of tiles.
+/// \param          arena                       If non-null, the memory block into which the data is placed.
+/// \param          arena_size                  The size of the arena in bytes.
+/// \param          allocate_memory_function    If no arena is given, the function used to allocate the memory block for the data.
+/// \param [out]    allocation_object           If no arena is given, the allocated memory block is put here (if there is no data at all, the pointer is null).
+/// \param [out]    entries                     An array with 'count' elements, which receives the offset, the size and the result for each tile.
+/// \param [out]    error_information           If non-null, in case of an error, additional information describing the error are put here
+///                                             (if the data of tiles could not be read, this is the information for the first of them).
+///
+/// \returns    ImgDoc2_ErrorCode_OK if the data of all tiles was read; otherwise the error-code for the first tile which failed.
+EXTERNAL_API(ImgDoc2ErrorCode) IDocRead2d_ReadTileDataBatch(
+    HandleDocRead2D handle,
+    const std::int64_t* pks,
+    std::uint32_t count,
+    void* arena,
+    std::uint64_t arena_size,
+    AllocMemoryFunctionPointer allocate_memory_function,
+    AllocationObject* allocation_object,
+    TileDataBatchEntryInterop* entries,
+    ImgDoc2ErrorInformation* error_information);
+
 /// Method operating on a reader2d-object: query the tiles table. The three query clauses are
 /// used to filter the tiles. The first clause is used to filter the tiles by their
 /// coordinates, the second by other "per tile data" and there is third geometric clause filtering
@@ -480,6 +655,96 @@ EXTERNAL_API(ImgDoc2ErrorCode) IDocRead2d_ReadTileInfo(
     TileBlobInfoInterop* tile_blob_info_interop,
     ImgDoc2ErrorInformation* error_information);
 
+/// Method operating on a reader2d-object: render the specified region of the document into a bitmap. The tiles intersecting
+/// the region (and matching the dimension-clause) are read, decoded (in parallel) and resampled into the destination
+/// bitmap. The zoom factor is given by the ratio of the size of the destination bitmap and the size of the region. The
+/// pyramid level is chosen automatically, and tiles are drawn in the order of their M-index. Where there are no tiles,
+/// the destination bitmap is filled with the specified background value.
+///
+/// \param          handle                              The reader2d object.
+/// \param          roi                                 The region to be rendered (in the logical coordinate system).
+/// \param          dim_coordinate_query_clause_interop If non-null, the interop-structure containing the coordinate query clause (selecting the plane).
+/// \param          pixel_type                          The pixel type of the destination bitmap, which must be identical to the pixel type of the tiles.
+/// \param          background_value                    The value with which the destination bitmap is filled where there are no tiles.
+/// \param          resampling_filter                   The resampling filter - 0 for nearest-neighbor, 1 for bilinear interpolation.
+/// \param          destination_width                   The width of the destination bitmap in pixels.
+/// \param          destination_height                  The height of the destination bitmap in pixels.
+/// \param          destination_stride                  The stride of the destination bitmap in bytes.
+/// \param [out]    destination                         Pointer to the destination bitmap.
+/// \param [out]    error_information                   If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns    An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) IDocRead2d_CompositeRegion(
+    HandleDocRead2D handle,
+    const RectangleDoubleInterop* roi,
+    const DimensionQueryClauseInterop* dim_coordinate_query_clause_interop,
+    std::uint8_t pixel_type,
+    double background_value,
+    std::uint8_t resampling_filter,
+    std::uint32_t destination_width,
+    std::uint32_t destination_height,
+    std::uint32_t destination_stride,
+    void* destination,
+    ImgDoc2ErrorInformation* error_information);
+
+/// Method operating on a reader2d-object: calculate the histogram and the statistics (minimum, maximum, mean and standard
+/// deviation) of the pixels within the specified region. A pixel is taken into account if its center is within the region,
+/// and pixels in regions where tiles overlap are counted once for each tile. The tiles are decoded and analyzed in parallel.
+/// Values outside of the range of the histogram are counted in the first or the last bin respectively.
+///
+/// \param          handle                              The reader2d object.
+/// \param          roi                                 The region (in the logical coordinate system).
+/// \param          dim_coordinate_query_clause_interop If non-null, the interop-structure containing the coordinate query clause (selecting the plane).
+/// \param          pixel_type                          The pixel type of the tiles - Gray8, Gray16 and Gray32Float are supported.
+/// \param          number_of_bins                      The number of bins of the histogram, where 0 means "256 for Gray8 and Gray32Float, and 65536 for Gray16".
+/// \param          range_minimum                       The lower bound of the range covered by the histogram.
+/// \param          range_maximum                       The upper bound of the range covered by the histogram - if not greater than range_minimum, the range of the pixel type is used (which is not possible for Gray32Float).
+/// \param          max_number_of_pixels                If non-zero, a pyramid level with at most this number of pixels within the region may be used (giving an approximation); if zero, pyramid level 0 is used.
+/// \param [out]    statistics                          If non-null, the statistics are put here.
+/// \param [out]    histogram                           If non-null, the histogram is put here (at most 'histogram_count' elements).
+/// \param [in,out] histogram_count                     On input, the number of elements of the array 'histogram'; on output, the number of bins of the histogram. May be null if 'histogram' is null.
+/// \param [out]    error_information                   If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns    An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) IDocRead2d_CalculateStatistics(
+    HandleDocRead2D handle,
+    const RectangleDoubleInterop* roi,
+    const DimensionQueryClauseInterop* dim_coordinate_query_clause_interop,
+    std::uint8_t pixel_type,
+    std::uint32_t number_of_bins,
+    double range_minimum,
+    double range_maximum,
+    std::uint64_t max_number_of_pixels,
+    RegionStatisticsInterop* statistics,
+    std::uint64_t* histogram,
+    std::uint32_t* histogram_count,
+    ImgDoc2ErrorInformation* error_information);
+
+/// Method operating on a document-object: create the pyramid levels 1...number_of_levels of a 2D-document from its level-0
+/// tiles. This is done for each plane of the document (where a plane is given by the tile-coordinate, not taking into account
+/// the M-index), and a pyramid level of a plane which already contains tiles is left unchanged. The pyramid level L is
+/// created from the level L-1 by averaging blocks of minification_factor x minification_factor pixels, and the resulting
+/// tiles (of the specified size, where the tiles at the right and bottom edge may be smaller) are stored as uncompressed
+/// bitmaps. The operation is executed on multiple threads, and no transaction must be pending on the document.
+///
+/// \param          handle_document         The document object.
+/// \param          minification_factor     The factor by which the resolution decreases from one pyramid level to the next (must be at least 2).
+/// \param          number_of_levels        The number of pyramid levels to create.
+/// \param          tile_width              The width of the output tiles in pixels.
+/// \param          tile_height             The height of the output tiles in pixels.
+/// \param          max_number_of_threads   The maximal number of threads to use, where 0 means "use the number of hardware threads".
+/// \param [out]    error_information       If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns    An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) IDoc_GeneratePyramid2d(
+    HandleDoc handle_document,
+    std::uint32_t minification_factor,
+    std::uint32_t number_of_levels,
+    std::uint32_t tile_width,
+    std::uint32_t tile_height,
+    std::uint32_t max_number_of_threads,
+    ImgDoc2ErrorInformation* error_information);
+
 /// Method operating on a writer3d-object: Add a brick to an image3d-document. On success, a key for the newly added brick is returned ('result_pk').
 ///
 /// \param          handle                        The writer3d-object.
@@ -504,6 +769,35 @@ EXTERNAL_API(ImgDoc2ErrorCode) IDocWrite3d_AddBrick(
     imgdoc2::dbIndex* result_pk,
     ImgDoc2ErrorInformation* error_information);
 
+/// Method operating on a writer3d-object: Add a batch of bricks to the document with a single call. The bricks are described by an array
+/// of BrickToAddInterop-structures, where the coordinate of each brick is given as a range in the array 'coordinates', and the data of
+/// each brick is given as a range in the memory block 'data'. All bricks are added within one transaction (if there is no
+/// transaction pending already), and the database statements are prepared only once for the whole batch - so this is more
+/// efficient than calling IDocWrite3d_AddBrick for each brick. If an error occurs, then (if the transaction was initiated by this
+/// function) none of the bricks is added.
+///
+/// \param          handle                  The writer3d-object.
+/// \param          bricks                  Array of structures describing the bricks to be added.
+/// \param          count                   The number of bricks.
+/// \param          coordinates             Array of dimension-value-pairs containing the coordinates of all bricks.
+/// \param          coordinates_count       The number of elements in the array 'coordinates'.
+/// \param          data                    The memory block containing the data of all bricks.
+/// \param          data_size               The size of the memory block 'data' in bytes.
+/// \param [out]    result_pks              If non-null and in case of success, the primary keys of the newly added bricks are put here (this array must have room for 'count' elements).
+/// \param [out]    error_information       If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) IDocWrite3d_AddBricks(
+    HandleDocWrite3D handle,
+    const BrickToAddInterop* bricks,
+    std::uint32_t count,
+    const DimensionAndValueInterop* coordinates,
+    std::uint32_t coordinates_count,
+    const void* data,
+    std::uint64_t data_size,
+    imgdoc2::dbIndex* result_pks,
+    ImgDoc2ErrorInformation* error_information);
+
 // ------ IDocQuery3d ------
 
 /// Method operating on a reader3d-object: reads tile information for the specified brick. There are three 
@@ -605,6 +899,206 @@ EXTERNAL_API(ImgDoc2ErrorCode) IDocRead3d_ReadBrickData(
     MemTransferSetDataFunctionPointer pfnSetData,
     ImgDoc2ErrorInformation* error_information);
 
+/// Method operating on a reader3d-object: get the size of the data of the specified brick (in bytes), without reading the data.
+///
+/// \param          handle              The reader3d object.
+/// \param          pk                  The primary key of the brick.
+/// \param [out]    size                The size of the data in bytes is put here.
+/// \param [out]    error_information   If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns    An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) IDocRead3d_GetBrickDataSize(
+    HandleDocRead3D handle,
+    std::int64_t pk,
+    std::uint64_t* size,
+    ImgDoc2ErrorInformation* error_information);
+
+/// Method operating on a reader3d-object: read the data of the specified brick directly into a caller-provided buffer. On input, 'size'
+/// specifies the size of the buffer in bytes. On return, the actual size of the data is put there. If the buffer is too
+/// small, nothing is written to the buffer (and the caller can retry with a buffer of the size reported).
+///
+/// \param          handle              The reader3d object.
+/// \param          pk                  The primary key of the brick.
+/// \param [out]    buffer              The buffer into which the data is written (may be null if 'size' is 0 on input).
+/// \param [in,out] size                On input, the size of the buffer; on output, the size of the data in bytes.
+/// \param [out]    error_information   If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns    An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) IDocRead3d_ReadBrickDataIntoBuffer(
+    HandleDocRead3D handle,
+    std::int64_t pk,
+    void* buffer,
+    std::uint64_t* size,
+    ImgDoc2ErrorInformation* error_information);
+
+/// Method operating on a reader3d-object: read the data of a batch of bricks with one call. This is operating in the same
+/// way as IDocRead2d_ReadTileDataBatch.
+///
+/// \param          handle                      The reader3d object.
+/// \param          pks                         The primary keys of the bricks (an array with 'count' elements).
+/// \param          count                       The number of bricks.
+/// \param          arena                       If non-null, the memory block into which the data is placed.
+/// \param          arena_size                  The size of the arena in bytes.
+/// \param          allocate_memory_function    If no arena is given, the function used to allocate the memory block for the data.
+/// \param [out]    allocation_object           If no arena is given, the allocated memory block is put here (if there is no data at all, the pointer is null).
+/// \param [out]    entries                     An array with 'count' elements, which receives the offset, the size and the result for each brick.
+/// \param [out]    error_information           If non-null, in case of an error, additional information describing the error are put here
+///                                             (if the data of bricks could not be read, this is the information for the first of them).
+///
+/// \returns    ImgDoc2_ErrorCode_OK if the data of all bricks was read; otherwise the error-code for the first brick which failed.
+EXTERNAL_API(ImgDoc2ErrorCode) IDocRead3d_ReadBrickDataBatch(
+    HandleDocRead3D handle,
+    const std::int64_t* pks,
+    std::uint32_t count,
+    void* arena,
+    std::uint64_t arena_size,
+    AllocMemoryFunctionPointer allocate_memory_function,
+    AllocationObject* allocation_object,
+    TileDataBatchEntryInterop* entries,
+    ImgDoc2ErrorInformation* error_information);
+
+/// Method operating on a reader3d-object: render a planar slice through the document into a bitmap. The slice is given by
+/// the plane, an in-plane basis (u, v) and a region in the coordinate system spanned by this basis (with its origin at the
+/// point "normal * distance"). The pixel (i, j) of the destination bitmap is sampled at the point
+/// normal * distance + (region.x + (i + 0.5) * region.width / width) * u + (region.y + (j + 0.5) * region.height / height) * v.
+/// The basis vectors are projected onto the plane and normalized. The bricks (on pyramid level 0) intersecting the slice are
+/// sampled in the order of their primary key, and where there are no bricks, the destination bitmap is filled with the
+/// specified background value.
+///
+/// \param          handle                              The reader3d object.
+/// \param          plane_normal_and_distance_interop   The plane.
+/// \param          axis_u                              The first vector of the in-plane basis (giving the x-direction of the destination bitmap).
+/// \param          axis_v                              The second vector of the in-plane basis (giving the y-direction of the destination bitmap).
+/// \param          region                              The region to be rendered (in the coordinate system given by the in-plane basis).
+/// \param          dim_coordinate_query_clause_interop If non-null, the interop-structure containing the coordinate query clause.
+/// \param          pixel_type                          The pixel type of the destination bitmap, which must be identical to the pixel type of the bricks.
+/// \param          background_value                    The value with which the destination bitmap is filled where there are no bricks.
+/// \param          sampling_filter                     The sampling filter - 0 for nearest-neighbor, 1 for trilinear interpolation.
+/// \param          destination_width                   The width of the destination bitmap in pixels.
+/// \param          destination_height                  The height of the destination bitmap in pixels.
+/// \param          destination_stride                  The stride of the destination bitmap in bytes.
+/// \param [out]    destination                         Pointer to the destination bitmap.
+/// \param [out]    error_information                   If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns    An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) IDocRead3d_RenderPlaneSlice(
+    HandleDocRead3D handle,
+    const PlaneNormalAndDistanceInterop* plane_normal_and_distance_interop,
+    const Vector3dDoubleInterop* axis_u,
+    const Vector3dDoubleInterop* axis_v,
+    const RectangleDoubleInterop* region,
+    const DimensionQueryClauseInterop* dim_coordinate_query_clause_interop,
+    std::uint8_t pixel_type,
+    double background_value,
+    std::uint8_t sampling_filter,
+    std::uint32_t destination_width,
+    std::uint32_t destination_height,
+    std::uint32_t destination_stride,
+    void* destination,
+    ImgDoc2ErrorInformation* error_information);
+
+/// Method operating on a reader3d-object: calculate a projection (e.g. a maximum-intensity-projection) of a cuboid region
+/// along one of the axes into a bitmap. The x- and y-axis of the destination bitmap are the x- and y-axis of the document
+/// for a projection along the z-axis, x and z for a projection along the y-axis, and y and z for a projection along the
+/// x-axis. The pixel (i, j) is the reduction of all voxels along the projection axis whose center is within the region (at
+/// the center of the pixel). For the operations "maximum" and "minimum", the pixel type of the destination is the pixel type
+/// of the bricks; for "sum" and "mean" (which are only supported for Gray8, Gray16 and Gray32Float) it is Gray32Float.
+/// Pixels where there are no voxels are set to the specified background value.
+///
+/// \param          handle                              The reader3d object.
+/// \param          roi_cuboid                          The region (in the logical coordinate system) to be projected.
+/// \param          dim_coordinate_query_clause_interop If non-null, the interop-structure containing the coordinate query clause.
+/// \param          axis                                The projection axis - 0 for x, 1 for y and 2 for z.
+/// \param          operation                           The operation - 0 for maximum, 1 for minimum, 2 for sum and 3 for mean.
+/// \param          pixel_type                          The pixel type of the bricks.
+/// \param          background_value                    The value with which pixels are filled where there are no voxels.
+/// \param          destination_width                   The width of the destination bitmap in pixels.
+/// \param          destination_height                  The height of the destination bitmap in pixels.
+/// \param          destination_stride                  The stride of the destination bitmap in bytes.
+/// \param [out]    destination                         Pointer to the destination bitmap.
+/// \param [out]    error_information                   If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns    An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) IDocRead3d_Project(
+    HandleDocRead3D handle,
+    const CuboidDoubleInterop* roi_cuboid,
+    const DimensionQueryClauseInterop* dim_coordinate_query_clause_interop,
+    std::uint8_t axis,
+    std::uint8_t operation,
+    std::uint8_t pixel_type,
+    double background_value,
+    std::uint32_t destination_width,
+    std::uint32_t destination_height,
+    std::uint32_t destination_stride,
+    void* destination,
+    ImgDoc2ErrorInformation* error_information);
+
+/// Method operating on a reader3d-object: calculate a projection (as described for IDocRead3d_Project) and add the result
+/// as a tile (of data type "uncompressed bitmap") to a 2D-document.
+///
+/// \param          handle                              The reader3d object.
+/// \param          roi_cuboid                          The region (in the logical coordinate system) to be projected.
+/// \param          dim_coordinate_query_clause_interop If non-null, the interop-structure containing the coordinate query clause.
+/// \param          axis                                The projection axis - 0 for x, 1 for y and 2 for z.
+/// \param          operation                           The operation - 0 for maximum, 1 for minimum, 2 for sum and 3 for mean.
+/// \param          pixel_type                          The pixel type of the bricks.
+/// \param          background_value                    The value with which pixels are filled where there are no voxels.
+/// \param          width                               The width of the projection (and of the tile) in pixels.
+/// \param          height                              The height of the projection (and of the tile) in pixels.
+/// \param          writer2d_handle                     The writer2d-object to which the tile is added.
+/// \param          tile_coordinate_interop             The coordinate of the tile.
+/// \param          logical_position_info_interop       The logical position of the tile.
+/// \param [out]    result_pk                           If non-null, the primary key of the added tile is put here.
+/// \param [out]    error_information                   If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns    An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) IDocRead3d_ProjectIntoDocument2d(
+    HandleDocRead3D handle,
+    const CuboidDoubleInterop* roi_cuboid,
+    const DimensionQueryClauseInterop* dim_coordinate_query_clause_interop,
+    std::uint8_t axis,
+    std::uint8_t operation,
+    std::uint8_t pixel_type,
+    double background_value,
+    std::uint32_t width,
+    std::uint32_t height,
+    HandleDocWrite2D writer2d_handle,
+    const TileCoordinateInterop* tile_coordinate_interop,
+    const LogicalPositionInfoInterop* logical_position_info_interop,
+    imgdoc2::dbIndex* result_pk,
+    ImgDoc2ErrorInformation* error_information);
+
+/// Method operating on a reader3d-object: calculate the histogram and the statistics of the voxels within the specified
+/// cuboid (as described for IDocRead2d_CalculateStatistics).
+///
+/// \param          handle                              The reader3d object.
+/// \param          roi_cuboid                          The region (in the logical coordinate system).
+/// \param          dim_coordinate_query_clause_interop If non-null, the interop-structure containing the coordinate query clause.
+/// \param          pixel_type                          The pixel type of the tiles - Gray8, Gray16 and Gray32Float are supported.
+/// \param          number_of_bins                      The number of bins of the histogram, where 0 means "256 for Gray8 and Gray32Float, and 65536 for Gray16".
+/// \param          range_minimum                       The lower bound of the range covered by the histogram.
+/// \param          range_maximum                       The upper bound of the range covered by the histogram - if not greater than range_minimum, the range of the pixel type is used (which is not possible for Gray32Float).
+/// \param          max_number_of_pixels                If non-zero, a pyramid level with at most this number of pixels within the region may be used (giving an approximation); if zero, pyramid level 0 is used.
+/// \param [out]    statistics                          If non-null, the statistics are put here.
+/// \param [out]    histogram                           If non-null, the histogram is put here (at most 'histogram_count' elements).
+/// \param [in,out] histogram_count                     On input, the number of elements of the array 'histogram'; on output, the number of bins of the histogram. May be null if 'histogram' is null.
+/// \param [out]    error_information                   If non-null, in case of an error, additional information describing the error are put here.
+///
+/// \returns    An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) IDocRead3d_CalculateStatistics(
+    HandleDocRead3D handle,
+    const CuboidDoubleInterop* roi_cuboid,
+    const DimensionQueryClauseInterop* dim_coordinate_query_clause_interop,
+    std::uint8_t pixel_type,
+    std::uint32_t number_of_bins,
+    double range_minimum,
+    double range_maximum,
+    std::uint64_t max_number_of_pixels,
+    RegionStatisticsInterop* statistics,
+    std::uint64_t* histogram,
+    std::uint32_t* histogram_count,
+    ImgDoc2ErrorInformation* error_information);
+
 /// Get the tile-dimensions used in the document. On input, the parameter 'count' must give the
 /// size of the memory pointed to by 'dimensions' (= the number of elements in there). On output,
 /// the actual number of elements available is put into 'count'. At most, the initial number 
@@ -832,3 +1326,49 @@ EXTERNAL_API(ImgDoc2ErrorCode) IDocWrite3d_CommitTransaction(
 EXTERNAL_API(ImgDoc2ErrorCode) IDocWrite3d_RollbackTransaction(
     HandleDocWrite3D handle,
     ImgDoc2ErrorInformation* error_information);
+
+/// Method operating on a writer2d-object: set the auto-commit policy (c.f. imgdoc2::IDocWrite2d::SetAutoCommitPolicy). With an
+/// auto-commit policy in effect, the tiles added (outside of a transaction started with IDocWrite2d_BeginTransaction) are grouped
+/// into transactions, which are committed when one of the limits is reached. A pending auto-commit transaction can be committed
+/// with IDocWrite2d_CommitTransaction, and it is committed when the writer object is destroyed.
+/// \param          handle                          The handle of a writer2d object.
+/// \param          auto_commit_policy_interop      The auto-commit policy.
+/// \param [in,out] error_information               If non-null, in case of an error, additional information describing the error are put here.
+/// \returns An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) IDocWrite2d_SetAutoCommitPolicy(
+    HandleDocWrite2D handle,
+    const AutoCommitPolicyInterop* auto_commit_policy_interop,
+    ImgDoc2ErrorInformation* error_information);
+
+/// Method operating on a writer2d-object: get the auto-commit policy.
+/// \param          handle                          The handle of a writer2d object.
+/// \param [out]    auto_commit_policy_interop      The auto-commit policy is put here.
+/// \param [in,out] error_information               If non-null, in case of an error, additional information describing the error are put here.
+/// \returns An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) IDocWrite2d_GetAutoCommitPolicy(
+    HandleDocWrite2D handle,
+    AutoCommitPolicyInterop* auto_commit_policy_interop,
+    ImgDoc2ErrorInformation* error_information);
+
+/// Method operating on a writer3d-object: set the auto-commit policy (c.f. imgdoc2::IDocWrite3d::SetAutoCommitPolicy). With an
+/// auto-commit policy in effect, the bricks added (outside of a transaction started with IDocWrite3d_BeginTransaction) are grouped
+/// into transactions, which are committed when one of the limits is reached. A pending auto-commit transaction can be committed
+/// with IDocWrite3d_CommitTransaction, and it is committed when the writer object is destroyed.
+/// \param          handle                          The handle of a writer3d object.
+/// \param          auto_commit_policy_interop      The auto-commit policy.
+/// \param [in,out] error_information               If non-null, in case of an error, additional information describing the error are put here.
+/// \returns An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) IDocWrite3d_SetAutoCommitPolicy(
+    HandleDocWrite3D handle,
+    const AutoCommitPolicyInterop* auto_commit_policy_interop,
+    ImgDoc2ErrorInformation* error_information);
+
+/// Method operating on a writer3d-object: get the auto-commit policy.
+/// \param          handle                          The handle of a writer3d object.
+/// \param [out]    auto_commit_policy_interop      The auto-commit policy is put here.
+/// \param [in,out] error_information               If non-null, in case of an error, additional information describing the error are put here.
+/// \returns An error-code indicating success or failure of the operation.
+EXTERNAL_API(ImgDoc2ErrorCode) IDocWrite3d_GetAutoCommitPolicy(
+    HandleDocWrite3D handle,
+    AutoCommitPolicyInterop* auto_commit_policy_interop,
+    ImgDoc2ErrorInformation* error_information);
@@ -59,7 +59,7 @@
 
 /*static*/ImgDoc2ErrorCode ImgDoc2ApiSupport::MapExceptionToReturnValue(const std::exception& exception)
 {
-    if (typeid(exception) == typeid(invalid_argument))
+    if (typeid(exception) == typeid(invalid_argument) || typeid(exception) == typeid(imgdoc2::invalid_argument_exception))
     {
         return ImgDoc2_ErrorCode_InvalidArgument;
     }
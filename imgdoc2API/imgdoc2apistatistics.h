@@ -6,8 +6,10 @@
 
 #include <atomic>
 #include "imgdoc2statisticsinterop.h"
+#include "operationstatistics.h"
 
-/// This struct is used to count active instances of objects, which are created by the imgdoc2API.
+/// This struct is used to count active instances of objects, which are created by the imgdoc2API. The interop-structure
+/// in addition contains the totals of the performance counters (c.f. OperationStatistics).
 struct ImgDoc2ApiStatistics
 {
     std::atomic_uint32_t number_of_createoptions_objects_active{ 0 };
@@ -28,6 +30,12 @@ struct ImgDoc2ApiStatistics
         interop.number_of_writer2d_objects_active = this->number_of_writer2d_objects_active.load();
         interop.number_of_reader3d_objects_active = this->number_of_reader3d_objects_active.load();
         interop.number_of_writer3d_objects_active = this->number_of_writer3d_objects_active.load();
+        const OperationStatistics& operation_statistics = OperationStatistics::GetInstance();
+        interop.bytes_read = operation_statistics.GetBytesRead();
+        interop.bytes_written = operation_statistics.GetBytesWritten();
+        interop.statements_prepared = operation_statistics.GetStatementsPrepared();
+        interop.decoded_bitmap_cache_hits = operation_statistics.GetDecodedBitmapCacheHits();
+        interop.decoded_bitmap_cache_misses = operation_statistics.GetDecodedBitmapCacheMisses();
         return interop;
     }
 };
@@ -16,5 +16,10 @@ struct ImgDoc2StatisticsInterop
     std::uint32_t number_of_writer2d_objects_active;
     std::uint32_t number_of_reader3d_objects_active;
     std::uint32_t number_of_writer3d_objects_active;
+    std::uint64_t bytes_read;                       ///< The number of bytes of tile data read (since the last reset of the statistics).
+    std::uint64_t bytes_written;                    ///< The number of bytes of tile data written (since the last reset of the statistics).
+    std::uint64_t statements_prepared;              ///< The number of database statements prepared (since the last reset of the statistics).
+    std::uint64_t decoded_bitmap_cache_hits;        ///< The number of lookups in decoded-bitmap-caches which found a bitmap (since the last reset of the statistics).
+    std::uint64_t decoded_bitmap_cache_misses;      ///< The number of lookups in decoded-bitmap-caches which did not find a bitmap (since the last reset of the statistics).
 };
 #pragma pack(pop)
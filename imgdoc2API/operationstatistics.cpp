@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include "operationstatistics.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <imgdoc2.h>
+
+using namespace std;
+using namespace imgdoc2;
+
+/*static*/OperationStatistics& OperationStatistics::GetInstance()
+{
+    static OperationStatistics instance;
+    return instance;
+}
+
+void OperationStatistics::Record(Operation operation, std::chrono::nanoseconds duration)
+{
+    const uint64_t duration_in_nanoseconds = static_cast<uint64_t>(max(duration.count(), static_cast<chrono::nanoseconds::rep>(0)));
+    OperationCounters& counters = this->operations_[static_cast<size_t>(operation)];
+    counters.count.fetch_add(1, memory_order_relaxed);
+    counters.total_duration.fetch_add(duration_in_nanoseconds, memory_order_relaxed);
+    counters.histogram[OperationStatistics::GetBucketIndex(duration_in_nanoseconds)].fetch_add(1, memory_order_relaxed);
+
+    uint64_t maximum = counters.maximum_duration.load(memory_order_relaxed);
+    while (duration_in_nanoseconds > maximum &&
+        !counters.maximum_duration.compare_exchange_weak(maximum, duration_in_nanoseconds, memory_order_relaxed))
+    {
+    }
+}
+
+std::uint64_t OperationStatistics::GetStatementsPrepared() const
+{
+    // the counter is maintained by libimgdoc2 (and cannot be reset), so we report the difference to the value at the last reset
+    return ClassFactory::GetNumberOfStatementsPrepared() - this->statements_prepared_at_reset_.load(memory_order_relaxed);
+}
+
+OperationStatistics::OperationSnapshot OperationStatistics::GetOperationSnapshot(Operation operation) const
+{
+    const OperationCounters& counters = this->operations_[static_cast<size_t>(operation)];
+    OperationSnapshot snapshot;
+    snapshot.count = counters.count.load(memory_order_relaxed);
+    snapshot.total_duration = counters.total_duration.load(memory_order_relaxed);
+    snapshot.maximum_duration = counters.maximum_duration.load(memory_order_relaxed);
+    for (size_t i = 0; i < kBucketCount; ++i)
+    {
+        snapshot.histogram[i] = counters.histogram[i].load(memory_order_relaxed);
+    }
+
+    return snapshot;
+}
+
+void OperationStatistics::Reset()
+{
+    for (auto& counters : this->operations_)
+    {
+        counters.count.store(0, memory_order_relaxed);
+        counters.total_duration.store(0, memory_order_relaxed);
+        counters.maximum_duration.store(0, memory_order_relaxed);
+        for (auto& bucket : counters.histogram)
+        {
+            bucket.store(0, memory_order_relaxed);
+        }
+    }
+
+    this->bytes_read_.store(0, memory_order_relaxed);
+    this->bytes_written_.store(0, memory_order_relaxed);
+    this->decoded_bitmap_cache_hits_.store(0, memory_order_relaxed);
+    this->decoded_bitmap_cache_misses_.store(0, memory_order_relaxed);
+    this->statements_prepared_at_reset_.store(ClassFactory::GetNumberOfStatementsPrepared(), memory_order_relaxed);
+}
+
+/*static*/std::uint32_t OperationStatistics::GetBucketIndex(std::uint64_t duration)
+{
+    if (duration < 2 * kSubBucketCount)
+    {
+        return static_cast<uint32_t>(duration);
+    }
+
+    // determine the index of the most significant bit (with a binary search)
+    uint32_t most_significant_bit = 0;
+    for (uint32_t shift = 32; shift > 0; shift /= 2)
+    {
+        if ((duration >> (most_significant_bit + shift)) != 0)
+        {
+            most_significant_bit += shift;
+        }
+    }
+
+    // the bits following the most significant bit give the sub-bucket
+    const uint32_t sub_bucket = static_cast<uint32_t>(duration >> (most_significant_bit - kSubBucketCountLog2)) - kSubBucketCount;
+    return (most_significant_bit - kSubBucketCountLog2 + 1) * kSubBucketCount + sub_bucket;
+}
+
+/*static*/std::uint64_t OperationStatistics::GetBucketLowerBound(std::uint32_t bucket_index)
+{
+    if (bucket_index < 2 * kSubBucketCount)
+    {
+        return bucket_index;
+    }
+
+    const uint32_t octave = bucket_index / kSubBucketCount - 1;
+    const uint32_t sub_bucket = bucket_index % kSubBucketCount;
+    return static_cast<uint64_t>(kSubBucketCount + sub_bucket) << octave;
+}
+
+std::uint64_t OperationStatistics::OperationSnapshot::GetPercentile(double percentile) const
+{
+    if (this->count == 0)
+    {
+        return 0;
+    }
+
+    // the histogram may (when taking the snapshot while the counters are updated) be slightly inconsistent with the count,
+    //  so we determine the total from the histogram itself
+    uint64_t total = 0;
+    for (const auto bucket_count : this->histogram)
+    {
+        total += bucket_count;
+    }
+
+    const uint64_t rank = max(static_cast<uint64_t>(ceil(clamp(percentile, 0.0, 100.0) / 100 * static_cast<double>(total))), static_cast<uint64_t>(1));
+    uint64_t accumulated = 0;
+    for (uint32_t i = 0; i < kBucketCount; ++i)
+    {
+        accumulated += this->histogram[i];
+        if (accumulated >= rank)
+        {
+            const uint64_t upper_bound = i + 1 < kBucketCount ? OperationStatistics::GetBucketLowerBound(i + 1) - 1 : numeric_limits<uint64_t>::max();
+            return min(upper_bound, this->maximum_duration);
+        }
+    }
+
+    return this->maximum_duration;
+}
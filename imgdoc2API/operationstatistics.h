@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/// This class gathers performance counters for the operations of the imgdoc2API. For each kind of operation, the number of
+/// calls, the accumulated duration, the maximal duration and a histogram of the durations are maintained. In addition, there
+/// are counters for the number of bytes read and written (as tile data), and for the hits and misses of decoded-bitmap-caches.
+/// All counters are atomic and are updated with relaxed memory ordering, so that maintaining them is cheap enough to have them
+/// enabled permanently. The counters can be reset at any time (e.g. for sampling them in intervals) - note that an operation
+/// which is in progress while resetting the counters is recorded after the reset.
+/// The histogram of the durations uses logarithmic buckets (in the style of an "HDR histogram"): the durations are given in
+/// nanoseconds, and the range [2^n, 2^(n+1)) is divided into kSubBucketCount buckets of equal width (where the durations below
+/// kSubBucketCount nanoseconds each get a bucket of their own). So, the relative width of a bucket is at most 1/kSubBucketCount.
+class OperationStatistics
+{
+public:
+    /// Values that represent the kinds of operations for which statistics are gathered.
+    enum class Operation : std::uint8_t
+    {
+        Query = 0,          ///< Queries for tiles (or bricks).
+        ReadTileData = 1,   ///< Reading the data of tiles (or bricks).
+        AddTile = 2,        ///< Adding tiles (or bricks).
+        Decode = 3,         ///< Decoding bitmaps.
+        Transaction = 4,    ///< Beginning, committing or rolling back a transaction.
+        AddTiles = 5,       ///< Adding a batch of tiles (or bricks), where the batch is counted as one call.
+    };
+
+    static constexpr std::uint32_t kOperationCount = 6;                                                         ///< The number of kinds of operations.
+    static constexpr std::uint32_t kSubBucketCountLog2 = 3;                                                     ///< The base-2 logarithm of the number of buckets per power of two.
+    static constexpr std::uint32_t kSubBucketCount = 1u << kSubBucketCountLog2;                                 ///< The number of buckets per power of two.
+    static constexpr std::uint32_t kBucketCount = (64 - kSubBucketCountLog2 + 1) * kSubBucketCount;            ///< The number of buckets of the histogram.
+
+    /// A snapshot of the statistics of an operation.
+    struct OperationSnapshot
+    {
+        std::uint64_t count{ 0 };                               ///< The number of calls.
+        std::uint64_t total_duration{ 0 };                      ///< The accumulated duration of the calls (in nanoseconds).
+        std::uint64_t maximum_duration{ 0 };                    ///< The maximal duration of a call (in nanoseconds).
+        std::array<std::uint64_t, kBucketCount> histogram{};    ///< The histogram of the durations.
+
+        /// Gets an estimate of the specified percentile of the durations - which is the upper bound of the bucket in which the
+        /// percentile falls (or the maximal duration if it is smaller).
+        ///
+        /// \param  percentile  The percentile (in the range 0 to 100).
+        ///
+        /// \returns    The estimate of the percentile (in nanoseconds); zero if there have been no calls.
+        [[nodiscard]] std::uint64_t GetPercentile(double percentile) const;
+    };
+
+    /// This is a utility for measuring the duration of an operation - the duration from the construction to the destruction
+    /// of this object is recorded.
+    class Scope
+    {
+    private:
+        OperationStatistics& statistics_;
+        Operation operation_;
+        std::chrono::steady_clock::time_point start_;
+    public:
+        Scope(OperationStatistics& statistics, Operation operation) :
+            statistics_(statistics), operation_(operation), start_(std::chrono::steady_clock::now())
+        {}
+
+        ~Scope()
+        {
+            this->statistics_.Record(this->operation_, std::chrono::steady_clock::now() - this->start_);
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        Scope(Scope&&) = delete;
+        Scope& operator=(Scope&&) = delete;
+    };
+
+private:
+    struct OperationCounters
+    {
+        std::atomic_uint64_t count{ 0 };
+        std::atomic_uint64_t total_duration{ 0 };
+        std::atomic_uint64_t maximum_duration{ 0 };
+        std::array<std::atomic_uint64_t, kBucketCount> histogram{};
+    };
+
+    std::array<OperationCounters, kOperationCount> operations_;
+    std::atomic_uint64_t bytes_read_{ 0 };
+    std::atomic_uint64_t bytes_written_{ 0 };
+    std::atomic_uint64_t decoded_bitmap_cache_hits_{ 0 };
+    std::atomic_uint64_t decoded_bitmap_cache_misses_{ 0 };
+    std::atomic_uint64_t statements_prepared_at_reset_{ 0 };
+public:
+    /// Gets the (process-wide) instance.
+    ///
+    /// \returns    The instance.
+    static OperationStatistics& GetInstance();
+
+    /// Records a call of the specified operation.
+    ///
+    /// \param  operation   The operation.
+    /// \param  duration    The duration of the call.
+    void Record(Operation operation, std::chrono::nanoseconds duration);
+
+    void AddBytesRead(std::uint64_t size) { this->bytes_read_.fetch_add(size, std::memory_order_relaxed); }
+    void AddBytesWritten(std::uint64_t size) { this->bytes_written_.fetch_add(size, std::memory_order_relaxed); }
+    void AddDecodedBitmapCacheHit() { this->decoded_bitmap_cache_hits_.fetch_add(1, std::memory_order_relaxed); }
+    void AddDecodedBitmapCacheMiss() { this->decoded_bitmap_cache_misses_.fetch_add(1, std::memory_order_relaxed); }
+
+    [[nodiscard]] std::uint64_t GetBytesRead() const { return this->bytes_read_.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::uint64_t GetBytesWritten() const { return this->bytes_written_.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::uint64_t GetDecodedBitmapCacheHits() const { return this->decoded_bitmap_cache_hits_.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::uint64_t GetDecodedBitmapCacheMisses() const { return this->decoded_bitmap_cache_misses_.load(std::memory_order_relaxed); }
+
+    /// Gets the number of database statements prepared since the last reset.
+    ///
+    /// \returns    The number of database statements prepared.
+    [[nodiscard]] std::uint64_t GetStatementsPrepared() const;
+
+    /// Gets a snapshot of the statistics of the specified operation.
+    ///
+    /// \param  operation   The operation.
+    ///
+    /// \returns    The snapshot.
+    [[nodiscard]] OperationSnapshot GetOperationSnapshot(Operation operation) const;
+
+    /// Resets all counters to zero.
+    void Reset();
+
+    /// Gets the index of the histogram bucket for the specified duration.
+    ///
+    /// \param  duration    The duration in nanoseconds.
+    ///
+    /// \returns    The index of the bucket.
+    static std::uint32_t GetBucketIndex(std::uint64_t duration);
+
+    /// Gets the lower bound of the specified histogram bucket, i.e. the smallest duration which falls into this bucket.
+    ///
+    /// \param  bucket_index    The index of the bucket (which must be less than kBucketCount).
+    ///
+    /// \returns    The lower bound of the bucket in nanoseconds.
+    static std::uint64_t GetBucketLowerBound(std::uint32_t bucket_index);
+
+    /// Query if the specified value is a valid operation.
+    ///
+    /// \param  operation   The value to check.
+    ///
+    /// \returns    True if the value is a valid operation; false otherwise.
+    static bool IsValidOperation(std::uint8_t operation) { return operation < kOperationCount; }
+};
@@ -0,0 +1,21 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+
+#pragma pack(push, 4)
+/// This struct contains the performance counters of one kind of operation (c.f. GetOperationStatistics). All durations
+/// are given in nanoseconds.
+struct OperationStatisticsInterop
+{
+    std::uint64_t count;                    ///< The number of calls.
+    std::uint64_t total_duration;           ///< The accumulated duration of the calls.
+    std::uint64_t maximum_duration;         ///< The maximal duration of a call.
+    std::uint64_t median_duration;          ///< An estimate of the median of the durations (the upper bound of the histogram bucket containing it).
+    std::uint64_t percentile90_duration;    ///< An estimate of the 90th percentile of the durations.
+    std::uint64_t percentile99_duration;    ///< An estimate of the 99th percentile of the durations.
+};
+#pragma pack(pop)
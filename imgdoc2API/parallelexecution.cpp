@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include "parallelexecution.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/*static*/std::uint32_t ParallelExecution::GetDefaultNumberOfThreads()
+{
+    return max(1u, thread::hardware_concurrency());
+}
+
+/*static*/void ParallelExecution::Run(std::uint32_t number_of_threads, size_t number_of_work_items, const std::function<void(size_t)>& action)
+{
+    ParallelExecution::RunWithThreadIndex(
+        number_of_threads,
+        number_of_work_items,
+        [&action](uint32_t, size_t work_item)->void
+        {
+            action(work_item);
+        });
+}
+
+/*static*/void ParallelExecution::RunWithThreadIndex(std::uint32_t number_of_threads, size_t number_of_work_items, const std::function<void(std::uint32_t, size_t)>& action)
+{
+    const size_t thread_count = min(static_cast<size_t>(number_of_threads), number_of_work_items);
+    if (thread_count <= 1)
+    {
+        for (size_t i = 0; i < number_of_work_items; ++i)
+        {
+            action(0, i);
+        }
+
+        return;
+    }
+
+    // the work items are distributed dynamically - each thread is picking the next work item until all are done, and
+    //  the first exception (if any) is re-thrown after all threads have finished
+    atomic<size_t> next_work_item{ 0 };
+    exception_ptr first_exception;
+    mutex exception_mutex;
+    const auto worker = [&](uint32_t thread_index)->void
+        {
+            for (;;)
+            {
+                const size_t work_item = next_work_item.fetch_add(1);
+                if (work_item >= number_of_work_items)
+                {
+                    break;
+                }
+
+                try
+                {
+                    action(thread_index, work_item);
+                }
+                catch (...)
+                {
+                    const lock_guard<mutex> lock(exception_mutex);
+                    if (!first_exception)
+                    {
+                        first_exception = current_exception();
+                    }
+
+                    // make the other threads stop as soon as possible
+                    next_work_item.store(number_of_work_items);
+                }
+            }
+        };
+
+    vector<thread> threads;
+    threads.reserve(thread_count - 1);
+    for (size_t i = 0; i < thread_count - 1; ++i)
+    {
+        threads.emplace_back(worker, static_cast<uint32_t>(i + 1));
+    }
+
+    worker(0);
+    for (auto& worker_thread : threads)
+    {
+        worker_thread.join();
+    }
+
+    if (first_exception)
+    {
+        rethrow_exception(first_exception);
+    }
+}
@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+/// Utilities for executing work items in parallel.
+class ParallelExecution
+{
+public:
+    /// Gets the number of threads to be used if the caller did not specify it (i.e. the number of hardware threads).
+    ///
+    /// \returns    The default number of threads (which is at least 1).
+    static std::uint32_t GetDefaultNumberOfThreads();
+
+    /// Executes the specified action for all work items (i.e. for the indices 0 ... number_of_work_items-1) on up to
+    /// 'number_of_threads' threads (where the calling thread is one of them). The work items are distributed dynamically,
+    /// i.e. a thread which has finished its work item is picking the next pending one. If an action throws an exception,
+    /// no further work items are started, and the (first) exception is re-thrown after all threads have finished.
+    ///
+    /// \param  number_of_threads       The maximal number of threads to use.
+    /// \param  number_of_work_items    The number of work items.
+    /// \param  action                  The action to be executed for each work item.
+    static void Run(std::uint32_t number_of_threads, size_t number_of_work_items, const std::function<void(size_t)>& action);
+
+    /// Executes the specified action for all work items - this is identical to "Run", except that the action is also given
+    /// the index of the thread executing it (in the range 0 ... number_of_threads-1). This allows for keeping per-thread
+    /// state (e.g. partial results) without synchronization.
+    ///
+    /// \param  number_of_threads       The maximal number of threads to use.
+    /// \param  number_of_work_items    The number of work items.
+    /// \param  action                  The action to be executed for each work item, taking the thread index and the work item index.
+    static void RunWithThreadIndex(std::uint32_t number_of_threads, size_t number_of_work_items, const std::function<void(std::uint32_t, size_t)>& action);
+};
@@ -0,0 +1,1415 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include "pixelkernels.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include <imgdoc2.h>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMGDOC2API_KERNELS_X86 1
+#include <emmintrin.h>
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define IMGDOC2API_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+// With GCC and Clang, the AVX2-intrinsics can only be used in functions which are marked as being compiled for AVX2 (and we do
+// not want to compile the whole file with AVX2 enabled, since we are choosing the implementation at runtime). MSVC does not
+// require this.
+#if defined(__GNUC__) || defined(__clang__)
+#define IMGDOC2API_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define IMGDOC2API_TARGET_AVX2
+#endif
+
+using namespace std;
+
+namespace
+{
+    typedef void(*CopyLineFunction)(const uint8_t* source, uint8_t* destination, size_t size);
+    typedef void(*UnpackHiLoLineFunction)(const uint8_t* source_lo, const uint8_t* source_hi, uint8_t* destination, size_t count);
+    typedef void(*Downscale2x2Gray8LineFunction)(const uint8_t* source_line0, const uint8_t* source_line1, uint8_t* destination, size_t count);
+    typedef void(*Downscale2x2Gray16LineFunction)(const uint16_t* source_line0, const uint16_t* source_line1, uint16_t* destination, size_t count);
+    typedef void(*ExtremumLineU8Function)(const uint8_t* source, uint8_t* accumulator, size_t count);
+    typedef void(*ExtremumLineU16Function)(const uint16_t* source, uint16_t* accumulator, size_t count);
+    typedef void(*ExtremumLineFloatFunction)(const float* source, float* accumulator, size_t count);
+    typedef void(*AddLineU8Function)(const uint8_t* source, uint32_t* accumulator, size_t count);
+    typedef void(*AddLineU16Function)(const uint16_t* source, uint32_t* accumulator, size_t count);
+    typedef void(*StatisticsLineFloatFunction)(const float* source, size_t count, PixelKernels::FloatStatistics& statistics);
+    typedef void(*WindowLineU16ToU8Function)(const uint16_t* source, uint8_t* destination, size_t count, float offset, float scale);
+    typedef void(*WindowLineFloatToU8Function)(const float* source, uint8_t* destination, size_t count, float offset, float scale);
+    typedef void(*WindowLineFloatToU16Function)(const float* source, uint16_t* destination, size_t count, float offset, float scale);
+
+    void CopyLine_Scalar(const uint8_t* source, uint8_t* destination, size_t size)
+    {
+        memcpy(destination, source, size);
+    }
+
+    void UnpackHiLoLine_Scalar(const uint8_t* source_lo, const uint8_t* source_hi, uint8_t* destination, size_t count)
+    {
+        // we are writing the words byte-by-byte (little-endian), which means we do not have to care about alignment
+        for (size_t i = 0; i < count; ++i)
+        {
+            destination[2 * i] = source_lo[i];
+            destination[2 * i + 1] = source_hi[i];
+        }
+    }
+
+    // The "Downscale2x2"-line-functions are averaging 2x2-blocks of a single-channel bitmap - 'count' is the number of
+    //  destination pixels, and the source lines must contain 2 * count pixels. The result is rounded to nearest.
+    void Downscale2x2Gray8Line_Scalar(const uint8_t* source_line0, const uint8_t* source_line1, uint8_t* destination, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const unsigned int sum = source_line0[2 * i] + source_line0[2 * i + 1] + source_line1[2 * i] + source_line1[2 * i + 1];
+            destination[i] = static_cast<uint8_t>((sum + 2) >> 2);
+        }
+    }
+
+    void Downscale2x2Gray16Line_Scalar(const uint16_t* source_line0, const uint16_t* source_line1, uint16_t* destination, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const uint32_t sum = static_cast<uint32_t>(source_line0[2 * i]) + source_line0[2 * i + 1] + source_line1[2 * i] + source_line1[2 * i + 1];
+            destination[i] = static_cast<uint16_t>((sum + 2) >> 2);
+        }
+    }
+
+    // The "extremum"-line-functions are updating the accumulator with the element-wise maximum (or minimum) of the accumulator
+    //  and the source, and the "add"-line-functions are adding the source element-wise to the (32-bit) accumulator.
+    template <typename t_value>
+    void MaximumLine_Scalar(const t_value* source, t_value* accumulator, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            accumulator[i] = accumulator[i] < source[i] ? source[i] : accumulator[i];
+        }
+    }
+
+    template <typename t_value>
+    void MinimumLine_Scalar(const t_value* source, t_value* accumulator, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            accumulator[i] = source[i] < accumulator[i] ? source[i] : accumulator[i];
+        }
+    }
+
+    template <typename t_value>
+    void AddLine_Scalar(const t_value* source, uint32_t* accumulator, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            accumulator[i] += source[i];
+        }
+    }
+
+    void StatisticsLineFloat_Scalar(const float* source, size_t count, PixelKernels::FloatStatistics& statistics)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float value = source[i];
+            statistics.minimum = min(statistics.minimum, value);
+            statistics.maximum = max(statistics.maximum, value);
+            statistics.sum += value;
+            statistics.sum_of_squares += static_cast<double>(value) * value;
+        }
+    }
+
+    // The "window"-line-functions are mapping the source values linearly to the destination range, i.e. the value is calculated
+    //  as "(source - offset) * scale", clamped to the range of the destination type and rounded to nearest. The SIMD-implementations
+    //  are doing exactly the same operations (with single precision), so they are giving identical results. Note that the
+    //  comparison "value > 0" is false for NaN, so NaN is mapped to zero.
+    template <typename t_source, typename t_destination>
+    void WindowLine_Scalar(const t_source* source, t_destination* destination, size_t count, float offset, float scale)
+    {
+        constexpr float kMaximum = static_cast<float>(numeric_limits<t_destination>::max());
+        for (size_t i = 0; i < count; ++i)
+        {
+            float value = (static_cast<float>(source[i]) - offset) * scale;
+            value = value > 0 ? value : 0;
+            value = value < kMaximum ? value : kMaximum;
+            destination[i] = static_cast<t_destination>(value + 0.5f);
+        }
+    }
+
+    void LookUpTableLine_Scalar(const uint16_t* source, uint8_t* destination, size_t count, const uint8_t* look_up_table)
+    {
+        // there is no gather-instruction for bytes, so there is no point in a SIMD-implementation here
+        for (size_t i = 0; i < count; ++i)
+        {
+            destination[i] = look_up_table[source[i]];
+        }
+    }
+
+#if IMGDOC2API_KERNELS_X86
+    void CopyLine_Sse2(const uint8_t* source, uint8_t* destination, size_t size)
+    {
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i)));
+        }
+
+        memcpy(destination + i, source + i, size - i);
+    }
+
+    void UnpackHiLoLine_Sse2(const uint8_t* source_lo, const uint8_t* source_hi, uint8_t* destination, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source_lo + i));
+            const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source_hi + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 2 * i), _mm_unpacklo_epi8(lo, hi));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 2 * i + 16), _mm_unpackhi_epi8(lo, hi));
+        }
+
+        UnpackHiLoLine_Scalar(source_lo + i, source_hi + i, destination + 2 * i, count - i);
+    }
+
+    IMGDOC2API_TARGET_AVX2 void CopyLine_Avx2(const uint8_t* source, uint8_t* destination, size_t size)
+    {
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i)));
+        }
+
+        memcpy(destination + i, source + i, size - i);
+    }
+
+    IMGDOC2API_TARGET_AVX2 void UnpackHiLoLine_Avx2(const uint8_t* source_lo, const uint8_t* source_hi, uint8_t* destination, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 32 <= count; i += 32)
+        {
+            const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source_lo + i));
+            const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source_hi + i));
+
+            // the unpack-instructions operate within the 128-bit lanes, so "interleaved_low" contains the words 0-7 and 16-23,
+            //  and "interleaved_high" contains the words 8-15 and 24-31 - we then need to reorder the lanes
+            const __m256i interleaved_low = _mm256_unpacklo_epi8(lo, hi);
+            const __m256i interleaved_high = _mm256_unpackhi_epi8(lo, hi);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + 2 * i), _mm256_permute2x128_si256(interleaved_low, interleaved_high, 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + 2 * i + 32), _mm256_permute2x128_si256(interleaved_low, interleaved_high, 0x31));
+        }
+
+        UnpackHiLoLine_Sse2(source_lo + i, source_hi + i, destination + 2 * i, count - i);
+    }
+
+    /// Adds the even and the odd bytes of the two vectors, giving eight 16-bit sums of 2x2-blocks.
+    inline __m128i SumOf2x2BlocksGray8_Sse2(__m128i line0, __m128i line1)
+    {
+        const __m128i mask_low_byte = _mm_set1_epi16(0x00ff);
+        const __m128i sum_even = _mm_add_epi16(_mm_and_si128(line0, mask_low_byte), _mm_and_si128(line1, mask_low_byte));
+        const __m128i sum_odd = _mm_add_epi16(_mm_srli_epi16(line0, 8), _mm_srli_epi16(line1, 8));
+        return _mm_add_epi16(sum_even, sum_odd);
+    }
+
+    void Downscale2x2Gray8Line_Sse2(const uint8_t* source_line0, const uint8_t* source_line1, uint8_t* destination, size_t count)
+    {
+        const __m128i rounding = _mm_set1_epi16(2);
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            const __m128i sum_a = SumOf2x2BlocksGray8_Sse2(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(source_line0 + 2 * i)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(source_line1 + 2 * i)));
+            const __m128i sum_b = SumOf2x2BlocksGray8_Sse2(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(source_line0 + 2 * i + 16)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(source_line1 + 2 * i + 16)));
+            const __m128i average_a = _mm_srli_epi16(_mm_add_epi16(sum_a, rounding), 2);
+            const __m128i average_b = _mm_srli_epi16(_mm_add_epi16(sum_b, rounding), 2);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_packus_epi16(average_a, average_b));
+        }
+
+        Downscale2x2Gray8Line_Scalar(source_line0 + 2 * i, source_line1 + 2 * i, destination + i, count - i);
+    }
+
+    /// Calculates the (rounded) averages of 2x2-blocks, giving four 32-bit results.
+    inline __m128i AverageOf2x2BlocksGray16_Sse2(__m128i line0, __m128i line1)
+    {
+        const __m128i mask_low_word = _mm_set1_epi32(0x0000ffff);
+        const __m128i sum_even = _mm_add_epi32(_mm_and_si128(line0, mask_low_word), _mm_and_si128(line1, mask_low_word));
+        const __m128i sum_odd = _mm_add_epi32(_mm_srli_epi32(line0, 16), _mm_srli_epi32(line1, 16));
+        return _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(sum_even, sum_odd), _mm_set1_epi32(2)), 2);
+    }
+
+    void Downscale2x2Gray16Line_Sse2(const uint16_t* source_line0, const uint16_t* source_line1, uint16_t* destination, size_t count)
+    {
+        // SSE2 has no instruction for packing 32-bit integers into unsigned 16-bit integers, so we shift the values into the
+        //  signed range, use the signed saturating pack, and then shift back
+        const __m128i bias32 = _mm_set1_epi32(0x8000);
+        const __m128i bias16 = _mm_set1_epi16(static_cast<short>(0x8000));
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m128i average_a = AverageOf2x2BlocksGray16_Sse2(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(source_line0 + 2 * i)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(source_line1 + 2 * i)));
+            const __m128i average_b = AverageOf2x2BlocksGray16_Sse2(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(source_line0 + 2 * i + 8)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(source_line1 + 2 * i + 8)));
+            const __m128i packed = _mm_packs_epi32(_mm_sub_epi32(average_a, bias32), _mm_sub_epi32(average_b, bias32));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_xor_si128(packed, bias16));
+        }
+
+        Downscale2x2Gray16Line_Scalar(source_line0 + 2 * i, source_line1 + 2 * i, destination + i, count - i);
+    }
+
+    void MaximumLineU8_Sse2(const uint8_t* source, uint8_t* accumulator, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+            const __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(accumulator + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(accumulator + i), _mm_max_epu8(current, value));
+        }
+
+        MaximumLine_Scalar(source + i, accumulator + i, count - i);
+    }
+
+    void MinimumLineU8_Sse2(const uint8_t* source, uint8_t* accumulator, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+            const __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(accumulator + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(accumulator + i), _mm_min_epu8(current, value));
+        }
+
+        MinimumLine_Scalar(source + i, accumulator + i, count - i);
+    }
+
+    void MaximumLineU16_Sse2(const uint16_t* source, uint16_t* accumulator, size_t count)
+    {
+        // SSE2 has no instruction for the maximum of unsigned 16-bit integers, but max(a, b) = b + saturated_subtract(a, b)
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+            const __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(accumulator + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(accumulator + i), _mm_add_epi16(value, _mm_subs_epu16(current, value)));
+        }
+
+        MaximumLine_Scalar(source + i, accumulator + i, count - i);
+    }
+
+    void MinimumLineU16_Sse2(const uint16_t* source, uint16_t* accumulator, size_t count)
+    {
+        // min(a, b) = a - saturated_subtract(a, b)
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+            const __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(accumulator + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(accumulator + i), _mm_sub_epi16(current, _mm_subs_epu16(current, value)));
+        }
+
+        MinimumLine_Scalar(source + i, accumulator + i, count - i);
+    }
+
+    void MaximumLineFloat_Sse2(const float* source, float* accumulator, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            _mm_storeu_ps(accumulator + i, _mm_max_ps(_mm_loadu_ps(accumulator + i), _mm_loadu_ps(source + i)));
+        }
+
+        MaximumLine_Scalar(source + i, accumulator + i, count - i);
+    }
+
+    void MinimumLineFloat_Sse2(const float* source, float* accumulator, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            _mm_storeu_ps(accumulator + i, _mm_min_ps(_mm_loadu_ps(accumulator + i), _mm_loadu_ps(source + i)));
+        }
+
+        MinimumLine_Scalar(source + i, accumulator + i, count - i);
+    }
+
+    /// Adds the eight 16-bit values to the accumulator (at the specified position).
+    inline void AddU16ToAccumulator_Sse2(__m128i values, uint32_t* accumulator)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i low = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(accumulator)), _mm_unpacklo_epi16(values, zero));
+        const __m128i high = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(accumulator + 4)), _mm_unpackhi_epi16(values, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(accumulator), low);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(accumulator + 4), high);
+    }
+
+    void AddLineU8_Sse2(const uint8_t* source, uint32_t* accumulator, size_t count)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+            AddU16ToAccumulator_Sse2(_mm_unpacklo_epi8(value, zero), accumulator + i);
+            AddU16ToAccumulator_Sse2(_mm_unpackhi_epi8(value, zero), accumulator + i + 8);
+        }
+
+        AddLine_Scalar(source + i, accumulator + i, count - i);
+    }
+
+    void AddLineU16_Sse2(const uint16_t* source, uint32_t* accumulator, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            AddU16ToAccumulator_Sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i)), accumulator + i);
+        }
+
+        AddLine_Scalar(source + i, accumulator + i, count - i);
+    }
+
+    void StatisticsLineFloat_Sse2(const float* source, size_t count, PixelKernels::FloatStatistics& statistics)
+    {
+        // the sums are accumulated with double precision (in two lanes for the lower and the upper half of the four floats)
+        __m128 minimum = _mm_set1_ps(statistics.minimum);
+        __m128 maximum = _mm_set1_ps(statistics.maximum);
+        __m128d sum_low = _mm_setzero_pd();
+        __m128d sum_high = _mm_setzero_pd();
+        __m128d sum_of_squares_low = _mm_setzero_pd();
+        __m128d sum_of_squares_high = _mm_setzero_pd();
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128 value = _mm_loadu_ps(source + i);
+            minimum = _mm_min_ps(minimum, value);
+            maximum = _mm_max_ps(maximum, value);
+            const __m128d value_low = _mm_cvtps_pd(value);
+            const __m128d value_high = _mm_cvtps_pd(_mm_movehl_ps(value, value));
+            sum_low = _mm_add_pd(sum_low, value_low);
+            sum_high = _mm_add_pd(sum_high, value_high);
+            sum_of_squares_low = _mm_add_pd(sum_of_squares_low, _mm_mul_pd(value_low, value_low));
+            sum_of_squares_high = _mm_add_pd(sum_of_squares_high, _mm_mul_pd(value_high, value_high));
+        }
+
+        float minimum_lanes[4], maximum_lanes[4];
+        double sum_lanes[2], sum_of_squares_lanes[2];
+        _mm_storeu_ps(minimum_lanes, minimum);
+        _mm_storeu_ps(maximum_lanes, maximum);
+        _mm_storeu_pd(sum_lanes, _mm_add_pd(sum_low, sum_high));
+        _mm_storeu_pd(sum_of_squares_lanes, _mm_add_pd(sum_of_squares_low, sum_of_squares_high));
+        statistics.minimum = min(min(minimum_lanes[0], minimum_lanes[1]), min(minimum_lanes[2], minimum_lanes[3]));
+        statistics.maximum = max(max(maximum_lanes[0], maximum_lanes[1]), max(maximum_lanes[2], maximum_lanes[3]));
+        statistics.sum += sum_lanes[0] + sum_lanes[1];
+        statistics.sum_of_squares += sum_of_squares_lanes[0] + sum_of_squares_lanes[1];
+        StatisticsLineFloat_Scalar(source + i, count - i, statistics);
+    }
+
+    /// Maps four values as described for WindowLine_Scalar, giving four 32-bit integers.
+    inline __m128i WindowToInt32_Sse2(__m128 value, __m128 offset, __m128 scale, __m128 maximum)
+    {
+        // note that "_mm_max_ps" is returning the second operand if one of the operands is NaN, so NaN is mapped to zero
+        __m128 result = _mm_mul_ps(_mm_sub_ps(value, offset), scale);
+        result = _mm_min_ps(_mm_max_ps(result, _mm_setzero_ps()), maximum);
+        return _mm_cvttps_epi32(_mm_add_ps(result, _mm_set1_ps(0.5f)));
+    }
+
+    void WindowLineU16ToU8_Sse2(const uint16_t* source, uint8_t* destination, size_t count, float offset, float scale)
+    {
+        const __m128 offset_vector = _mm_set1_ps(offset);
+        const __m128 scale_vector = _mm_set1_ps(scale);
+        const __m128 maximum = _mm_set1_ps(255.f);
+        const __m128i zero = _mm_setzero_si128();
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            const __m128i value_a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+            const __m128i value_b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i + 8));
+            const __m128i result_0 = WindowToInt32_Sse2(_mm_cvtepi32_ps(_mm_unpacklo_epi16(value_a, zero)), offset_vector, scale_vector, maximum);
+            const __m128i result_1 = WindowToInt32_Sse2(_mm_cvtepi32_ps(_mm_unpackhi_epi16(value_a, zero)), offset_vector, scale_vector, maximum);
+            const __m128i result_2 = WindowToInt32_Sse2(_mm_cvtepi32_ps(_mm_unpacklo_epi16(value_b, zero)), offset_vector, scale_vector, maximum);
+            const __m128i result_3 = WindowToInt32_Sse2(_mm_cvtepi32_ps(_mm_unpackhi_epi16(value_b, zero)), offset_vector, scale_vector, maximum);
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i*>(destination + i),
+                _mm_packus_epi16(_mm_packs_epi32(result_0, result_1), _mm_packs_epi32(result_2, result_3)));
+        }
+
+        WindowLine_Scalar(source + i, destination + i, count - i, offset, scale);
+    }
+
+    void WindowLineFloatToU8_Sse2(const float* source, uint8_t* destination, size_t count, float offset, float scale)
+    {
+        const __m128 offset_vector = _mm_set1_ps(offset);
+        const __m128 scale_vector = _mm_set1_ps(scale);
+        const __m128 maximum = _mm_set1_ps(255.f);
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            const __m128i result_0 = WindowToInt32_Sse2(_mm_loadu_ps(source + i), offset_vector, scale_vector, maximum);
+            const __m128i result_1 = WindowToInt32_Sse2(_mm_loadu_ps(source + i + 4), offset_vector, scale_vector, maximum);
+            const __m128i result_2 = WindowToInt32_Sse2(_mm_loadu_ps(source + i + 8), offset_vector, scale_vector, maximum);
+            const __m128i result_3 = WindowToInt32_Sse2(_mm_loadu_ps(source + i + 12), offset_vector, scale_vector, maximum);
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i*>(destination + i),
+                _mm_packus_epi16(_mm_packs_epi32(result_0, result_1), _mm_packs_epi32(result_2, result_3)));
+        }
+
+        WindowLine_Scalar(source + i, destination + i, count - i, offset, scale);
+    }
+
+    void WindowLineFloatToU16_Sse2(const float* source, uint16_t* destination, size_t count, float offset, float scale)
+    {
+        const __m128 offset_vector = _mm_set1_ps(offset);
+        const __m128 scale_vector = _mm_set1_ps(scale);
+        const __m128 maximum = _mm_set1_ps(65535.f);
+
+        // SSE2 has no instruction for packing 32-bit integers into unsigned 16-bit integers, so we shift the values into the range of
+        //  signed 16-bit integers before packing, and then flip the sign bit
+        const __m128i bias_32 = _mm_set1_epi32(32768);
+        const __m128i bias_16 = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m128i result_0 = WindowToInt32_Sse2(_mm_loadu_ps(source + i), offset_vector, scale_vector, maximum);
+            const __m128i result_1 = WindowToInt32_Sse2(_mm_loadu_ps(source + i + 4), offset_vector, scale_vector, maximum);
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i*>(destination + i),
+                _mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(result_0, bias_32), _mm_sub_epi32(result_1, bias_32)), bias_16));
+        }
+
+        WindowLine_Scalar(source + i, destination + i, count - i, offset, scale);
+    }
+
+    /// Calculates the (rounded) averages of 2x2-blocks, giving sixteen 16-bit results.
+    IMGDOC2API_TARGET_AVX2 inline __m256i AverageOf2x2BlocksGray8_Avx2(const uint8_t* source_line0, const uint8_t* source_line1)
+    {
+        const __m256i mask_low_byte = _mm256_set1_epi16(0x00ff);
+        const __m256i line0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source_line0));
+        const __m256i line1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source_line1));
+        const __m256i sum_even = _mm256_add_epi16(_mm256_and_si256(line0, mask_low_byte), _mm256_and_si256(line1, mask_low_byte));
+        const __m256i sum_odd = _mm256_add_epi16(_mm256_srli_epi16(line0, 8), _mm256_srli_epi16(line1, 8));
+        return _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(sum_even, sum_odd), _mm256_set1_epi16(2)), 2);
+    }
+
+    IMGDOC2API_TARGET_AVX2 void Downscale2x2Gray8Line_Avx2(const uint8_t* source_line0, const uint8_t* source_line1, uint8_t* destination, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 32 <= count; i += 32)
+        {
+            const __m256i average_a = AverageOf2x2BlocksGray8_Avx2(source_line0 + 2 * i, source_line1 + 2 * i);
+            const __m256i average_b = AverageOf2x2BlocksGray8_Avx2(source_line0 + 2 * i + 32, source_line1 + 2 * i + 32);
+
+            // the pack-instruction operates within the 128-bit lanes, so the 64-bit quarters need to be reordered
+            const __m256i packed = _mm256_packus_epi16(average_a, average_b);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm256_permute4x64_epi64(packed, 0xd8));
+        }
+
+        Downscale2x2Gray8Line_Sse2(source_line0 + 2 * i, source_line1 + 2 * i, destination + i, count - i);
+    }
+
+    /// Calculates the (rounded) averages of 2x2-blocks, giving eight 32-bit results.
+    IMGDOC2API_TARGET_AVX2 inline __m256i AverageOf2x2BlocksGray16_Avx2(const uint16_t* source_line0, const uint16_t* source_line1)
+    {
+        const __m256i mask_low_word = _mm256_set1_epi32(0x0000ffff);
+        const __m256i line0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source_line0));
+        const __m256i line1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source_line1));
+        const __m256i sum_even = _mm256_add_epi32(_mm256_and_si256(line0, mask_low_word), _mm256_and_si256(line1, mask_low_word));
+        const __m256i sum_odd = _mm256_add_epi32(_mm256_srli_epi32(line0, 16), _mm256_srli_epi32(line1, 16));
+        return _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(sum_even, sum_odd), _mm256_set1_epi32(2)), 2);
+    }
+
+    IMGDOC2API_TARGET_AVX2 void Downscale2x2Gray16Line_Avx2(const uint16_t* source_line0, const uint16_t* source_line1, uint16_t* destination, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            const __m256i average_a = AverageOf2x2BlocksGray16_Avx2(source_line0 + 2 * i, source_line1 + 2 * i);
+            const __m256i average_b = AverageOf2x2BlocksGray16_Avx2(source_line0 + 2 * i + 16, source_line1 + 2 * i + 16);
+            const __m256i packed = _mm256_packus_epi32(average_a, average_b);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), _mm256_permute4x64_epi64(packed, 0xd8));
+        }
+
+        Downscale2x2Gray16Line_Sse2(source_line0 + 2 * i, source_line1 + 2 * i, destination + i, count - i);
+    }
+
+    IMGDOC2API_TARGET_AVX2 void WindowLineU16ToU8_Avx2(const uint16_t* source, uint8_t* destination, size_t count, float offset, float scale)
+    {
+        const __m256 offset_vector = _mm256_set1_ps(offset);
+        const __m256 scale_vector = _mm256_set1_ps(scale);
+        const __m256 maximum = _mm256_set1_ps(255.f);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 rounding = _mm256_set1_ps(0.5f);
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+            __m256 result_0 = _mm256_mul_ps(_mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm256_castsi256_si128(value))), offset_vector), scale_vector);
+            __m256 result_1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm256_extracti128_si256(value, 1))), offset_vector), scale_vector);
+            result_0 = _mm256_add_ps(_mm256_min_ps(_mm256_max_ps(result_0, zero), maximum), rounding);
+            result_1 = _mm256_add_ps(_mm256_min_ps(_mm256_max_ps(result_1, zero), maximum), rounding);
+
+            // the pack-instruction operates within the 128-bit lanes, so the 64-bit blocks need to be reordered afterwards
+            const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(_mm256_cvttps_epi32(result_0), _mm256_cvttps_epi32(result_1)), 0xd8);
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i*>(destination + i),
+                _mm_packus_epi16(_mm256_castsi256_si128(packed), _mm256_extracti128_si256(packed, 1)));
+        }
+
+        WindowLineU16ToU8_Sse2(source + i, destination + i, count - i, offset, scale);
+    }
+
+    bool IsAvx2Supported()
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int cpu_info[4];
+        __cpuid(cpu_info, 0);
+        if (cpu_info[0] < 7)
+        {
+            return false;
+        }
+
+        // check that the CPU supports AVX and that the OS has enabled saving the YMM-registers (OSXSAVE and XCR0)
+        __cpuid(cpu_info, 1);
+        const bool os_uses_xsave_and_cpu_supports_avx = (cpu_info[2] & (1 << 27)) != 0 && (cpu_info[2] & (1 << 28)) != 0;
+        if (!os_uses_xsave_and_cpu_supports_avx || (_xgetbv(0) & 6) != 6)
+        {
+            return false;
+        }
+
+        __cpuidex(cpu_info, 7, 0);
+        return (cpu_info[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+#endif
+
+#if IMGDOC2API_KERNELS_NEON
+    void CopyLine_Neon(const uint8_t* source, uint8_t* destination, size_t size)
+    {
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16)
+        {
+            vst1q_u8(destination + i, vld1q_u8(source + i));
+        }
+
+        memcpy(destination + i, source + i, size - i);
+    }
+
+    void UnpackHiLoLine_Neon(const uint8_t* source_lo, const uint8_t* source_hi, uint8_t* destination, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            uint8x16x2_t lo_and_hi;
+            lo_and_hi.val[0] = vld1q_u8(source_lo + i);
+            lo_and_hi.val[1] = vld1q_u8(source_hi + i);
+            vst2q_u8(destination + 2 * i, lo_and_hi);   // vst2 does the interleaving for us
+        }
+
+        UnpackHiLoLine_Scalar(source_lo + i, source_hi + i, destination + 2 * i, count - i);
+    }
+
+    void Downscale2x2Gray8Line_Neon(const uint8_t* source_line0, const uint8_t* source_line1, uint8_t* destination, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            // vpaddl adds adjacent pairs, and vrshrn does the rounding shift and the narrowing
+            const uint16x8_t sum = vaddq_u16(vpaddlq_u8(vld1q_u8(source_line0 + 2 * i)), vpaddlq_u8(vld1q_u8(source_line1 + 2 * i)));
+            vst1_u8(destination + i, vrshrn_n_u16(sum, 2));
+        }
+
+        Downscale2x2Gray8Line_Scalar(source_line0 + 2 * i, source_line1 + 2 * i, destination + i, count - i);
+    }
+
+    void Downscale2x2Gray16Line_Neon(const uint16_t* source_line0, const uint16_t* source_line1, uint16_t* destination, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            const uint32x4_t sum = vaddq_u32(vpaddlq_u16(vld1q_u16(source_line0 + 2 * i)), vpaddlq_u16(vld1q_u16(source_line1 + 2 * i)));
+            vst1_u16(destination + i, vrshrn_n_u32(sum, 2));
+        }
+
+        Downscale2x2Gray16Line_Scalar(source_line0 + 2 * i, source_line1 + 2 * i, destination + i, count - i);
+    }
+
+    void MaximumLineU8_Neon(const uint8_t* source, uint8_t* accumulator, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            vst1q_u8(accumulator + i, vmaxq_u8(vld1q_u8(accumulator + i), vld1q_u8(source + i)));
+        }
+
+        MaximumLine_Scalar(source + i, accumulator + i, count - i);
+    }
+
+    void MinimumLineU8_Neon(const uint8_t* source, uint8_t* accumulator, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            vst1q_u8(accumulator + i, vminq_u8(vld1q_u8(accumulator + i), vld1q_u8(source + i)));
+        }
+
+        MinimumLine_Scalar(source + i, accumulator + i, count - i);
+    }
+
+    void MaximumLineU16_Neon(const uint16_t* source, uint16_t* accumulator, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            vst1q_u16(accumulator + i, vmaxq_u16(vld1q_u16(accumulator + i), vld1q_u16(source + i)));
+        }
+
+        MaximumLine_Scalar(source + i, accumulator + i, count - i);
+    }
+
+    void MinimumLineU16_Neon(const uint16_t* source, uint16_t* accumulator, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            vst1q_u16(accumulator + i, vminq_u16(vld1q_u16(accumulator + i), vld1q_u16(source + i)));
+        }
+
+        MinimumLine_Scalar(source + i, accumulator + i, count - i);
+    }
+
+    void MaximumLineFloat_Neon(const float* source, float* accumulator, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            vst1q_f32(accumulator + i, vmaxq_f32(vld1q_f32(accumulator + i), vld1q_f32(source + i)));
+        }
+
+        MaximumLine_Scalar(source + i, accumulator + i, count - i);
+    }
+
+    void MinimumLineFloat_Neon(const float* source, float* accumulator, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            vst1q_f32(accumulator + i, vminq_f32(vld1q_f32(accumulator + i), vld1q_f32(source + i)));
+        }
+
+        MinimumLine_Scalar(source + i, accumulator + i, count - i);
+    }
+
+    void AddLineU8_Neon(const uint8_t* source, uint32_t* accumulator, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const uint16x8_t value = vmovl_u8(vld1_u8(source + i));
+            vst1q_u32(accumulator + i, vaddw_u16(vld1q_u32(accumulator + i), vget_low_u16(value)));
+            vst1q_u32(accumulator + i + 4, vaddw_u16(vld1q_u32(accumulator + i + 4), vget_high_u16(value)));
+        }
+
+        AddLine_Scalar(source + i, accumulator + i, count - i);
+    }
+
+    void AddLineU16_Neon(const uint16_t* source, uint32_t* accumulator, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const uint16x8_t value = vld1q_u16(source + i);
+            vst1q_u32(accumulator + i, vaddw_u16(vld1q_u32(accumulator + i), vget_low_u16(value)));
+            vst1q_u32(accumulator + i + 4, vaddw_u16(vld1q_u32(accumulator + i + 4), vget_high_u16(value)));
+        }
+
+        AddLine_Scalar(source + i, accumulator + i, count - i);
+    }
+
+    /// Maps four values as described for WindowLine_Scalar, giving four 32-bit unsigned integers.
+    inline uint32x4_t WindowToUInt32_Neon(float32x4_t value, float32x4_t offset, float32x4_t scale, float32x4_t maximum)
+    {
+        // "vmaxq_f32" would propagate NaN, so we use a comparison (which is false for NaN) and a select instead
+        const float32x4_t zero = vdupq_n_f32(0);
+        float32x4_t result = vmulq_f32(vsubq_f32(value, offset), scale);
+        result = vbslq_f32(vcgtq_f32(result, zero), result, zero);
+        result = vminq_f32(result, maximum);
+        return vcvtq_u32_f32(vaddq_f32(result, vdupq_n_f32(0.5f)));
+    }
+
+    void WindowLineU16ToU8_Neon(const uint16_t* source, uint8_t* destination, size_t count, float offset, float scale)
+    {
+        const float32x4_t offset_vector = vdupq_n_f32(offset);
+        const float32x4_t scale_vector = vdupq_n_f32(scale);
+        const float32x4_t maximum = vdupq_n_f32(255.f);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const uint16x8_t value = vld1q_u16(source + i);
+            const uint32x4_t result_low = WindowToUInt32_Neon(vcvtq_f32_u32(vmovl_u16(vget_low_u16(value))), offset_vector, scale_vector, maximum);
+            const uint32x4_t result_high = WindowToUInt32_Neon(vcvtq_f32_u32(vmovl_u16(vget_high_u16(value))), offset_vector, scale_vector, maximum);
+            vst1_u8(destination + i, vmovn_u16(vcombine_u16(vmovn_u32(result_low), vmovn_u32(result_high))));
+        }
+
+        WindowLine_Scalar(source + i, destination + i, count - i, offset, scale);
+    }
+
+    void WindowLineFloatToU8_Neon(const float* source, uint8_t* destination, size_t count, float offset, float scale)
+    {
+        const float32x4_t offset_vector = vdupq_n_f32(offset);
+        const float32x4_t scale_vector = vdupq_n_f32(scale);
+        const float32x4_t maximum = vdupq_n_f32(255.f);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const uint32x4_t result_low = WindowToUInt32_Neon(vld1q_f32(source + i), offset_vector, scale_vector, maximum);
+            const uint32x4_t result_high = WindowToUInt32_Neon(vld1q_f32(source + i + 4), offset_vector, scale_vector, maximum);
+            vst1_u8(destination + i, vmovn_u16(vcombine_u16(vmovn_u32(result_low), vmovn_u32(result_high))));
+        }
+
+        WindowLine_Scalar(source + i, destination + i, count - i, offset, scale);
+    }
+
+    void WindowLineFloatToU16_Neon(const float* source, uint16_t* destination, size_t count, float offset, float scale)
+    {
+        const float32x4_t offset_vector = vdupq_n_f32(offset);
+        const float32x4_t scale_vector = vdupq_n_f32(scale);
+        const float32x4_t maximum = vdupq_n_f32(65535.f);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const uint32x4_t result_low = WindowToUInt32_Neon(vld1q_f32(source + i), offset_vector, scale_vector, maximum);
+            const uint32x4_t result_high = WindowToUInt32_Neon(vld1q_f32(source + i + 4), offset_vector, scale_vector, maximum);
+            vst1q_u16(destination + i, vcombine_u16(vmovn_u32(result_low), vmovn_u32(result_high)));
+        }
+
+        WindowLine_Scalar(source + i, destination + i, count - i, offset, scale);
+    }
+#endif
+
+    struct KernelTable
+    {
+        PixelKernels::InstructionSet instruction_set;
+        CopyLineFunction copy_line;
+        UnpackHiLoLineFunction unpack_hi_lo_line;
+        Downscale2x2Gray8LineFunction downscale_2x2_gray8_line;
+        Downscale2x2Gray16LineFunction downscale_2x2_gray16_line;
+        ExtremumLineU8Function maximum_u8_line;
+        ExtremumLineU16Function maximum_u16_line;
+        ExtremumLineFloatFunction maximum_float_line;
+        ExtremumLineU8Function minimum_u8_line;
+        ExtremumLineU16Function minimum_u16_line;
+        ExtremumLineFloatFunction minimum_float_line;
+        AddLineU8Function add_u8_line;
+        AddLineU16Function add_u16_line;
+        StatisticsLineFloatFunction statistics_float_line;
+        WindowLineU16ToU8Function window_u16_to_u8_line;
+        WindowLineFloatToU8Function window_float_to_u8_line;
+        WindowLineFloatToU16Function window_float_to_u16_line;
+    };
+
+    KernelTable CreateScalarKernelTable()
+    {
+        KernelTable table;
+        table.instruction_set = PixelKernels::InstructionSet::Scalar;
+        table.copy_line = CopyLine_Scalar;
+        table.unpack_hi_lo_line = UnpackHiLoLine_Scalar;
+        table.downscale_2x2_gray8_line = Downscale2x2Gray8Line_Scalar;
+        table.downscale_2x2_gray16_line = Downscale2x2Gray16Line_Scalar;
+        table.maximum_u8_line = MaximumLine_Scalar<uint8_t>;
+        table.maximum_u16_line = MaximumLine_Scalar<uint16_t>;
+        table.maximum_float_line = MaximumLine_Scalar<float>;
+        table.minimum_u8_line = MinimumLine_Scalar<uint8_t>;
+        table.minimum_u16_line = MinimumLine_Scalar<uint16_t>;
+        table.minimum_float_line = MinimumLine_Scalar<float>;
+        table.add_u8_line = AddLine_Scalar<uint8_t>;
+        table.add_u16_line = AddLine_Scalar<uint16_t>;
+        table.statistics_float_line = StatisticsLineFloat_Scalar;
+        table.window_u16_to_u8_line = WindowLine_Scalar<uint16_t, uint8_t>;
+        table.window_float_to_u8_line = WindowLine_Scalar<float, uint8_t>;
+        table.window_float_to_u16_line = WindowLine_Scalar<float, uint16_t>;
+        return table;
+    }
+
+#if IMGDOC2API_KERNELS_X86
+    KernelTable CreateSse2KernelTable()
+    {
+        KernelTable table;
+        table.instruction_set = PixelKernels::InstructionSet::Sse2;
+        table.copy_line = CopyLine_Sse2;
+        table.unpack_hi_lo_line = UnpackHiLoLine_Sse2;
+        table.downscale_2x2_gray8_line = Downscale2x2Gray8Line_Sse2;
+        table.downscale_2x2_gray16_line = Downscale2x2Gray16Line_Sse2;
+        table.maximum_u8_line = MaximumLineU8_Sse2;
+        table.maximum_u16_line = MaximumLineU16_Sse2;
+        table.maximum_float_line = MaximumLineFloat_Sse2;
+        table.minimum_u8_line = MinimumLineU8_Sse2;
+        table.minimum_u16_line = MinimumLineU16_Sse2;
+        table.minimum_float_line = MinimumLineFloat_Sse2;
+        table.add_u8_line = AddLineU8_Sse2;
+        table.add_u16_line = AddLineU16_Sse2;
+        table.statistics_float_line = StatisticsLineFloat_Sse2;
+        table.window_u16_to_u8_line = WindowLineU16ToU8_Sse2;
+        table.window_float_to_u8_line = WindowLineFloatToU8_Sse2;
+        table.window_float_to_u16_line = WindowLineFloatToU16_Sse2;
+        return table;
+    }
+
+    KernelTable CreateAvx2KernelTable()
+    {
+        // for the reductions, the SSE2-implementation is used also if AVX2 is available - those kernels are doing only one
+        //  operation per element loaded, so they are limited by the memory bandwidth
+        KernelTable table = CreateSse2KernelTable();
+        table.instruction_set = PixelKernels::InstructionSet::Avx2;
+        table.copy_line = CopyLine_Avx2;
+        table.unpack_hi_lo_line = UnpackHiLoLine_Avx2;
+        table.downscale_2x2_gray8_line = Downscale2x2Gray8Line_Avx2;
+        table.downscale_2x2_gray16_line = Downscale2x2Gray16Line_Avx2;
+        table.window_u16_to_u8_line = WindowLineU16ToU8_Avx2;
+        return table;
+    }
+#elif IMGDOC2API_KERNELS_NEON
+    KernelTable CreateNeonKernelTable()
+    {
+        KernelTable table;
+        table.instruction_set = PixelKernels::InstructionSet::Neon;
+        table.copy_line = CopyLine_Neon;
+        table.unpack_hi_lo_line = UnpackHiLoLine_Neon;
+        table.downscale_2x2_gray8_line = Downscale2x2Gray8Line_Neon;
+        table.downscale_2x2_gray16_line = Downscale2x2Gray16Line_Neon;
+        table.maximum_u8_line = MaximumLineU8_Neon;
+        table.maximum_u16_line = MaximumLineU16_Neon;
+        table.maximum_float_line = MaximumLineFloat_Neon;
+        table.minimum_u8_line = MinimumLineU8_Neon;
+        table.minimum_u16_line = MinimumLineU16_Neon;
+        table.minimum_float_line = MinimumLineFloat_Neon;
+        table.add_u8_line = AddLineU8_Neon;
+        table.add_u16_line = AddLineU16_Neon;
+        table.window_u16_to_u8_line = WindowLineU16ToU8_Neon;
+        table.window_float_to_u8_line = WindowLineFloatToU8_Neon;
+        table.window_float_to_u16_line = WindowLineFloatToU16_Neon;
+
+        // AArch32 has no vector instructions for double precision, so the scalar implementation is used here
+        table.statistics_float_line = StatisticsLineFloat_Scalar;
+        return table;
+    }
+#endif
+
+    /// Gets the kernel table for the specified instruction set. The initialization of a function-local static is thread-safe, so
+    /// each table is created exactly once.
+    ///
+    /// \param instruction_set The instruction set.
+    ///
+    /// \returns   The kernel table; or nullptr if the instruction set is not available (on this platform or on this CPU).
+    const KernelTable* GetKernelTableForInstructionSet(PixelKernels::InstructionSet instruction_set)
+    {
+        switch (instruction_set)
+        {
+        case PixelKernels::InstructionSet::Scalar:
+        {
+            static const KernelTable scalar_kernel_table = CreateScalarKernelTable();
+            return &scalar_kernel_table;
+        }
+#if IMGDOC2API_KERNELS_X86
+        case PixelKernels::InstructionSet::Sse2:
+        {
+            static const KernelTable sse2_kernel_table = CreateSse2KernelTable();
+            return &sse2_kernel_table;
+        }
+        case PixelKernels::InstructionSet::Avx2:
+        {
+            static const bool avx2_supported = IsAvx2Supported();
+            if (!avx2_supported)
+            {
+                return nullptr;
+            }
+
+            static const KernelTable avx2_kernel_table = CreateAvx2KernelTable();
+            return &avx2_kernel_table;
+        }
+#elif IMGDOC2API_KERNELS_NEON
+        case PixelKernels::InstructionSet::Neon:
+        {
+            static const KernelTable neon_kernel_table = CreateNeonKernelTable();
+            return &neon_kernel_table;
+        }
+#endif
+        default:
+            return nullptr;
+        }
+    }
+
+    const KernelTable* DetermineKernelTable()
+    {
+        // choose the "best" instruction set which is available
+        for (const auto instruction_set : { PixelKernels::InstructionSet::Avx2, PixelKernels::InstructionSet::Sse2, PixelKernels::InstructionSet::Neon })
+        {
+            const KernelTable* kernel_table = GetKernelTableForInstructionSet(instruction_set);
+            if (kernel_table != nullptr)
+            {
+                return kernel_table;
+            }
+        }
+
+        return GetKernelTableForInstructionSet(PixelKernels::InstructionSet::Scalar);
+    }
+
+    /// Downscales a bitmap by averaging factor x factor blocks - this is the generic implementation which is used for all
+    /// pixel types and factors.
+    template <typename t_channel, int t_channels>
+    void DownscaleByAveragingGeneric(std::uint32_t factor, const void* source, std::uint32_t source_stride, std::uint32_t destination_width, std::uint32_t destination_height, void* destination, std::uint32_t destination_stride)
+    {
+        typedef std::conditional_t<std::is_integral_v<t_channel>, uint64_t, double> AccumulatorType;
+        const auto number_of_samples = static_cast<AccumulatorType>(factor) * factor;
+        vector<AccumulatorType> accumulator(static_cast<size_t>(destination_width) * t_channels);
+        for (uint32_t y = 0; y < destination_height; ++y)
+        {
+            fill(accumulator.begin(), accumulator.end(), static_cast<AccumulatorType>(0));
+            for (uint32_t row = 0; row < factor; ++row)
+            {
+                const t_channel* source_line = reinterpret_cast<const t_channel*>(static_cast<const uint8_t*>(source) + (static_cast<size_t>(y) * factor + row) * source_stride);
+                for (uint32_t x = 0; x < destination_width; ++x)
+                {
+                    for (uint32_t column = 0; column < factor; ++column)
+                    {
+                        const t_channel* source_pixel = source_line + (static_cast<size_t>(x) * factor + column) * t_channels;
+                        for (int c = 0; c < t_channels; ++c)
+                        {
+                            accumulator[static_cast<size_t>(x) * t_channels + c] += source_pixel[c];
+                        }
+                    }
+                }
+            }
+
+            t_channel* destination_line = reinterpret_cast<t_channel*>(static_cast<uint8_t*>(destination) + static_cast<size_t>(y) * destination_stride);
+            for (size_t i = 0; i < accumulator.size(); ++i)
+            {
+                if constexpr (std::is_integral_v<t_channel>)
+                {
+                    destination_line[i] = static_cast<t_channel>((accumulator[i] + number_of_samples / 2) / number_of_samples);
+                }
+                else
+                {
+                    destination_line[i] = static_cast<t_channel>(accumulator[i] / number_of_samples);
+                }
+            }
+        }
+    }
+
+    template <typename t_channel, typename t_line_function>
+    void Downscale2x2SingleChannel(t_line_function line_function, const void* source, std::uint32_t source_stride, std::uint32_t destination_width, std::uint32_t destination_height, void* destination, std::uint32_t destination_stride)
+    {
+        for (uint32_t y = 0; y < destination_height; ++y)
+        {
+            const auto source_line0 = static_cast<const uint8_t*>(source) + static_cast<size_t>(2 * y) * source_stride;
+            line_function(
+                reinterpret_cast<const t_channel*>(source_line0),
+                reinterpret_cast<const t_channel*>(source_line0 + source_stride),
+                reinterpret_cast<t_channel*>(static_cast<uint8_t*>(destination) + static_cast<size_t>(y) * destination_stride),
+                destination_width);
+        }
+    }
+
+    /// Applies the specified line-function to all lines of a bitmap - if both bitmaps are contiguous, the line-function is
+    /// called only once for the whole bitmap. The line-function is called with the pointers to the source and destination line
+    /// and the number of elements (which is the width times the number of channels).
+    template <typename t_source, typename t_destination, typename t_line_function>
+    void ApplyLineFunction(const void* source, std::uint32_t source_stride, std::uint32_t width, std::uint32_t height, int channels, void* destination, std::uint32_t destination_stride, const t_line_function& line_function)
+    {
+        const size_t count = static_cast<size_t>(width) * channels;
+        if (source_stride == count * sizeof(t_source) && destination_stride == count * sizeof(t_destination))
+        {
+            line_function(static_cast<const t_source*>(source), static_cast<t_destination*>(destination), count * height);
+            return;
+        }
+
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            line_function(
+                reinterpret_cast<const t_source*>(static_cast<const uint8_t*>(source) + static_cast<size_t>(y) * source_stride),
+                reinterpret_cast<t_destination*>(static_cast<uint8_t*>(destination) + static_cast<size_t>(y) * destination_stride),
+                count);
+        }
+    }
+
+    /// The kernel table chosen with PixelKernels::SetInstructionSet - if this is nullptr, the kernel table for the best instruction
+    /// set available is used.
+    atomic<const KernelTable*> chosen_kernel_table{ nullptr };
+
+    const KernelTable& GetKernelTable()
+    {
+        const KernelTable* kernel_table = chosen_kernel_table.load(memory_order_acquire);
+        if (kernel_table != nullptr)
+        {
+            return *kernel_table;
+        }
+
+        // the initialization of a function-local static is thread-safe, so the CPU-detection is done exactly once
+        static const KernelTable* const best_kernel_table = DetermineKernelTable();
+        return *best_kernel_table;
+    }
+}
+
+/*static*/PixelKernels::InstructionSet PixelKernels::GetInstructionSet()
+{
+    return GetKernelTable().instruction_set;
+}
+
+/*static*/std::vector<PixelKernels::InstructionSet> PixelKernels::GetAvailableInstructionSets()
+{
+    vector<InstructionSet> instruction_sets;
+    for (const auto instruction_set : { InstructionSet::Scalar, InstructionSet::Sse2, InstructionSet::Avx2, InstructionSet::Neon })
+    {
+        if (GetKernelTableForInstructionSet(instruction_set) != nullptr)
+        {
+            instruction_sets.push_back(instruction_set);
+        }
+    }
+
+    return instruction_sets;
+}
+
+/*static*/bool PixelKernels::SetInstructionSet(InstructionSet instruction_set)
+{
+    const KernelTable* kernel_table = GetKernelTableForInstructionSet(instruction_set);
+    if (kernel_table == nullptr)
+    {
+        return false;
+    }
+
+    chosen_kernel_table.store(kernel_table, memory_order_release);
+    return true;
+}
+
+/*static*/void PixelKernels::CopyWithStrideConversion(const void* source, std::uint32_t source_stride, std::uint32_t line_length, std::uint32_t height, void* destination, std::uint32_t destination_stride)
+{
+    const auto copy_line = GetKernelTable().copy_line;
+    const uint8_t* source_line = static_cast<const uint8_t*>(source);
+    uint8_t* destination_line = static_cast<uint8_t*>(destination);
+
+    if (source_stride == line_length && destination_stride == line_length)
+    {
+        // both bitmaps are contiguous, so we can copy them in one go
+        copy_line(source_line, destination_line, static_cast<size_t>(line_length) * height);
+        return;
+    }
+
+    for (uint32_t row = 0; row < height; ++row)
+    {
+        copy_line(source_line, destination_line, line_length);
+        source_line += source_stride;
+        destination_line += destination_stride;
+    }
+}
+
+/*static*/void PixelKernels::UnpackHiLoBytes(const void* source, std::uint32_t words_per_line, std::uint32_t height, void* destination, std::uint32_t destination_stride)
+{
+    const auto unpack_hi_lo_line = GetKernelTable().unpack_hi_lo_line;
+    const size_t total_number_of_words = static_cast<size_t>(words_per_line) * height;
+    const uint8_t* source_lo = static_cast<const uint8_t*>(source);
+    const uint8_t* source_hi = source_lo + total_number_of_words;
+    uint8_t* destination_line = static_cast<uint8_t*>(destination);
+
+    if (destination_stride == static_cast<size_t>(words_per_line) * 2)
+    {
+        unpack_hi_lo_line(source_lo, source_hi, destination_line, total_number_of_words);
+        return;
+    }
+
+    for (uint32_t row = 0; row < height; ++row)
+    {
+        unpack_hi_lo_line(source_lo, source_hi, destination_line, words_per_line);
+        source_lo += words_per_line;
+        source_hi += words_per_line;
+        destination_line += destination_stride;
+    }
+}
+
+/*static*/bool PixelKernels::DownscaleByAveraging(std::uint8_t pixel_type, std::uint32_t factor, const void* source, std::uint32_t source_stride, std::uint32_t destination_width, std::uint32_t destination_height, void* destination, std::uint32_t destination_stride)
+{
+    if (factor == 0)
+    {
+        return false;
+    }
+
+    if (factor == 2)
+    {
+        switch (pixel_type)
+        {
+        case imgdoc2::PixelType::Gray8:
+            Downscale2x2SingleChannel<uint8_t>(GetKernelTable().downscale_2x2_gray8_line, source, source_stride, destination_width, destination_height, destination, destination_stride);
+            return true;
+        case imgdoc2::PixelType::Gray16:
+            Downscale2x2SingleChannel<uint16_t>(GetKernelTable().downscale_2x2_gray16_line, source, source_stride, destination_width, destination_height, destination, destination_stride);
+            return true;
+        default:
+            break;
+        }
+    }
+
+    switch (pixel_type)
+    {
+    case imgdoc2::PixelType::Gray8:
+        DownscaleByAveragingGeneric<uint8_t, 1>(factor, source, source_stride, destination_width, destination_height, destination, destination_stride);
+        return true;
+    case imgdoc2::PixelType::Gray16:
+        DownscaleByAveragingGeneric<uint16_t, 1>(factor, source, source_stride, destination_width, destination_height, destination, destination_stride);
+        return true;
+    case imgdoc2::PixelType::Bgr24:
+        DownscaleByAveragingGeneric<uint8_t, 3>(factor, source, source_stride, destination_width, destination_height, destination, destination_stride);
+        return true;
+    case imgdoc2::PixelType::Bgr48:
+        DownscaleByAveragingGeneric<uint16_t, 3>(factor, source, source_stride, destination_width, destination_height, destination, destination_stride);
+        return true;
+    case imgdoc2::PixelType::Gray32Float:
+        DownscaleByAveragingGeneric<float, 1>(factor, source, source_stride, destination_width, destination_height, destination, destination_stride);
+        return true;
+    default:
+        return false;
+    }
+}
+
+/*static*/bool PixelKernels::UpdateExtremum(std::uint8_t pixel_type, bool maximum, const void* source, void* accumulator, std::uint32_t number_of_pixels)
+{
+    const auto& kernel_table = GetKernelTable();
+    switch (pixel_type)
+    {
+    case imgdoc2::PixelType::Gray8:
+    case imgdoc2::PixelType::Bgr24:
+    {
+        const size_t count = static_cast<size_t>(number_of_pixels) * (pixel_type == imgdoc2::PixelType::Bgr24 ? 3 : 1);
+        (maximum ? kernel_table.maximum_u8_line : kernel_table.minimum_u8_line)(static_cast<const uint8_t*>(source), static_cast<uint8_t*>(accumulator), count);
+        return true;
+    }
+    case imgdoc2::PixelType::Gray16:
+    case imgdoc2::PixelType::Bgr48:
+    {
+        const size_t count = static_cast<size_t>(number_of_pixels) * (pixel_type == imgdoc2::PixelType::Bgr48 ? 3 : 1);
+        (maximum ? kernel_table.maximum_u16_line : kernel_table.minimum_u16_line)(static_cast<const uint16_t*>(source), static_cast<uint16_t*>(accumulator), count);
+        return true;
+    }
+    case imgdoc2::PixelType::Gray32Float:
+        (maximum ? kernel_table.maximum_float_line : kernel_table.minimum_float_line)(static_cast<const float*>(source), static_cast<float*>(accumulator), number_of_pixels);
+        return true;
+    default:
+        return false;
+    }
+}
+
+/*static*/bool PixelKernels::AccumulateSum(std::uint8_t pixel_type, const void* source, std::uint32_t* accumulator, std::uint32_t number_of_pixels)
+{
+    const auto& kernel_table = GetKernelTable();
+    switch (pixel_type)
+    {
+    case imgdoc2::PixelType::Gray8:
+        kernel_table.add_u8_line(static_cast<const uint8_t*>(source), accumulator, number_of_pixels);
+        return true;
+    case imgdoc2::PixelType::Bgr24:
+        kernel_table.add_u8_line(static_cast<const uint8_t*>(source), accumulator, static_cast<size_t>(number_of_pixels) * 3);
+        return true;
+    case imgdoc2::PixelType::Gray16:
+        kernel_table.add_u16_line(static_cast<const uint16_t*>(source), accumulator, number_of_pixels);
+        return true;
+    case imgdoc2::PixelType::Bgr48:
+        kernel_table.add_u16_line(static_cast<const uint16_t*>(source), accumulator, static_cast<size_t>(number_of_pixels) * 3);
+        return true;
+    default:
+        return false;
+    }
+}
+
+/*static*/bool PixelKernels::AccumulateHistogram(std::uint8_t pixel_type, const void* source, std::uint32_t stride, std::uint32_t width, std::uint32_t height, std::uint64_t* histogram)
+{
+    switch (pixel_type)
+    {
+    case imgdoc2::PixelType::Gray8:
+    {
+        // Incrementing the same counter for consecutive pixels (which is common, e.g. for the background) makes each
+        //  increment wait for the previous one to be stored, so four interleaved histograms are used. Those are using
+        //  32-bit counters, which are added to the result before they can overflow.
+        uint32_t partial_histograms[4][256];
+        memset(partial_histograms, 0, sizeof(partial_histograms));
+        uint64_t pixels_in_partial_histograms = 0;
+        const auto add_partial_histograms = [&]()->void
+            {
+                for (int i = 0; i < 256; ++i)
+                {
+                    histogram[i] += static_cast<uint64_t>(partial_histograms[0][i]) + partial_histograms[1][i] + partial_histograms[2][i] + partial_histograms[3][i];
+                }
+
+                memset(partial_histograms, 0, sizeof(partial_histograms));
+                pixels_in_partial_histograms = 0;
+            };
+
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            if (pixels_in_partial_histograms + width > numeric_limits<uint32_t>::max())
+            {
+                add_partial_histograms();
+            }
+
+            const uint8_t* line = static_cast<const uint8_t*>(source) + static_cast<size_t>(y) * stride;
+            uint32_t x = 0;
+            for (; x + 4 <= width; x += 4)
+            {
+                ++partial_histograms[0][line[x]];
+                ++partial_histograms[1][line[x + 1]];
+                ++partial_histograms[2][line[x + 2]];
+                ++partial_histograms[3][line[x + 3]];
+            }
+
+            for (; x < width; ++x)
+            {
+                ++partial_histograms[0][line[x]];
+            }
+
+            pixels_in_partial_histograms += width;
+        }
+
+        add_partial_histograms();
+        return true;
+    }
+    case imgdoc2::PixelType::Gray16:
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            const uint16_t* line = reinterpret_cast<const uint16_t*>(static_cast<const uint8_t*>(source) + static_cast<size_t>(y) * stride);
+            for (uint32_t x = 0; x < width; ++x)
+            {
+                ++histogram[line[x]];
+            }
+        }
+
+        return true;
+    default:
+        return false;
+    }
+}
+
+/*static*/void PixelKernels::AccumulateStatistics(const float* source, std::uint32_t count, FloatStatistics& statistics)
+{
+    GetKernelTable().statistics_float_line(source, count, statistics);
+}
+
+/*static*/bool PixelKernels::ConvertWithWindow(std::uint8_t source_pixel_type, const void* source, std::uint32_t source_stride, std::uint32_t width, std::uint32_t height, double window_minimum, double window_maximum, std::uint8_t destination_pixel_type, void* destination, std::uint32_t destination_stride)
+{
+    if (!(window_maximum > window_minimum))
+    {
+        return false;
+    }
+
+    const auto& kernel_table = GetKernelTable();
+    const auto offset = static_cast<float>(window_minimum);
+    if ((source_pixel_type == imgdoc2::PixelType::Gray16 && destination_pixel_type == imgdoc2::PixelType::Gray8) ||
+        (source_pixel_type == imgdoc2::PixelType::Bgr48 && destination_pixel_type == imgdoc2::PixelType::Bgr24))
+    {
+        const auto scale = static_cast<float>(255 / (window_maximum - window_minimum));
+        ApplyLineFunction<uint16_t, uint8_t>(
+            source,
+            source_stride,
+            width,
+            height,
+            source_pixel_type == imgdoc2::PixelType::Bgr48 ? 3 : 1,
+            destination,
+            destination_stride,
+            [&](const uint16_t* source_line, uint8_t* destination_line, size_t count)->void
+            {
+                kernel_table.window_u16_to_u8_line(source_line, destination_line, count, offset, scale);
+            });
+        return true;
+    }
+
+    if (source_pixel_type == imgdoc2::PixelType::Gray32Float && destination_pixel_type == imgdoc2::PixelType::Gray8)
+    {
+        const auto scale = static_cast<float>(255 / (window_maximum - window_minimum));
+        ApplyLineFunction<float, uint8_t>(
+            source,
+            source_stride,
+            width,
+            height,
+            1,
+            destination,
+            destination_stride,
+            [&](const float* source_line, uint8_t* destination_line, size_t count)->void
+            {
+                kernel_table.window_float_to_u8_line(source_line, destination_line, count, offset, scale);
+            });
+        return true;
+    }
+
+    if (source_pixel_type == imgdoc2::PixelType::Gray32Float && destination_pixel_type == imgdoc2::PixelType::Gray16)
+    {
+        const auto scale = static_cast<float>(65535 / (window_maximum - window_minimum));
+        ApplyLineFunction<float, uint16_t>(
+            source,
+            source_stride,
+            width,
+            height,
+            1,
+            destination,
+            destination_stride,
+            [&](const float* source_line, uint16_t* destination_line, size_t count)->void
+            {
+                kernel_table.window_float_to_u16_line(source_line, destination_line, count, offset, scale);
+            });
+        return true;
+    }
+
+    return false;
+}
+
+/*static*/bool PixelKernels::FillWindowLookUpTable(double window_minimum, double window_maximum, double gamma, std::uint8_t* look_up_table)
+{
+    if (!(window_maximum > window_minimum) || !(gamma > 0))
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i <= numeric_limits<uint16_t>::max(); ++i)
+    {
+        double value = (i - window_minimum) / (window_maximum - window_minimum);
+        value = clamp(value, 0.0, 1.0);
+        if (gamma != 1)
+        {
+            value = pow(value, gamma);
+        }
+
+        look_up_table[i] = static_cast<uint8_t>(value * 255 + 0.5);
+    }
+
+    return true;
+}
+
+/*static*/bool PixelKernels::ConvertWithLookUpTable(std::uint8_t source_pixel_type, const void* source, std::uint32_t source_stride, std::uint32_t width, std::uint32_t height, const std::uint8_t* look_up_table, void* destination, std::uint32_t destination_stride)
+{
+    if (source_pixel_type != imgdoc2::PixelType::Gray16 && source_pixel_type != imgdoc2::PixelType::Bgr48)
+    {
+        return false;
+    }
+
+    ApplyLineFunction<uint16_t, uint8_t>(
+        source,
+        source_stride,
+        width,
+        height,
+        source_pixel_type == imgdoc2::PixelType::Bgr48 ? 3 : 1,
+        destination,
+        destination_stride,
+        [&](const uint16_t* source_line, uint8_t* destination_line, size_t count)->void
+        {
+            LookUpTableLine_Scalar(source_line, destination_line, count, look_up_table);
+        });
+    return true;
+}
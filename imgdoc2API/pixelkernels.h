@@ -0,0 +1,183 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/// This class is gathering low-level operations on pixel data. Where available, SIMD-implementations (AVX2, SSE2 or NEON)
+/// are used, and the implementation to be used is chosen at runtime (based on the capabilities of the CPU). A scalar
+/// implementation is available as fallback in all cases.
+class PixelKernels
+{
+public:
+    /// Values that represent the instruction set which is used by the kernels.
+    enum class InstructionSet
+    {
+        Scalar,     ///< Plain C++ implementation.
+        Sse2,       ///< SSE2-implementation (x86/x64).
+        Avx2,       ///< AVX2-implementation (x86/x64).
+        Neon        ///< NEON-implementation (ARM).
+    };
+
+    /// The (running) statistics of a set of floating-point values.
+    struct FloatStatistics
+    {
+        float minimum{ std::numeric_limits<float>::infinity() };    ///< The minimum of the values.
+        float maximum{ -std::numeric_limits<float>::infinity() };   ///< The maximum of the values.
+        double sum{ 0 };                                            ///< The sum of the values.
+        double sum_of_squares{ 0 };                                 ///< The sum of the squares of the values.
+    };
+
+    /// Gets the instruction set which is used by the kernels (as determined at runtime).
+    ///
+    /// \returns    The instruction set being used.
+    static InstructionSet GetInstructionSet();
+
+    /// Gets the instruction sets which are available on this platform and on this CPU. The scalar implementation is always
+    /// available.
+    ///
+    /// \returns    The instruction sets available.
+    static std::vector<InstructionSet> GetAvailableInstructionSets();
+
+    /// Chooses the instruction set to be used by the kernels (instead of the best one available). This is intended for testing,
+    /// i.e. for comparing the results of the different implementations. Note that the setting is global, so it should not be
+    /// changed while kernels are being executed.
+    ///
+    /// \param  instruction_set The instruction set to be used.
+    ///
+    /// \returns    True if it succeeds; false if the instruction set is not available.
+    static bool SetInstructionSet(InstructionSet instruction_set);
+
+    /// Copy a bitmap from the source to the destination, where the source and the destination may have different strides.
+    ///
+    /// \param          source              The source bitmap.
+    /// \param          source_stride       The stride of the source bitmap (in bytes).
+    /// \param          line_length         The number of bytes to copy per line (i.e. width times bytes per pixel).
+    /// \param          height              The number of lines.
+    /// \param [out]    destination         The destination bitmap.
+    /// \param          destination_stride  The stride of the destination bitmap (in bytes).
+    static void CopyWithStrideConversion(const void* source, std::uint32_t source_stride, std::uint32_t line_length, std::uint32_t height, void* destination, std::uint32_t destination_stride);
+
+    /// Reverses the "hi/lo byte packing" (as used by the ZSTD1-compression scheme) of 16-bit data. The source is expected
+    /// to contain the low bytes of all words (of a contiguous bitmap, i.e. without padding between lines), immediately
+    /// followed by the high bytes of all words. The words are written into the destination bitmap (honoring its stride).
+    ///
+    /// \param          source              The source data, which must have a size of 2 * words_per_line * height bytes.
+    /// \param          words_per_line      The number of 16-bit words per line (e.g. width for Gray16 and 3 * width for Bgr48).
+    /// \param          height              The number of lines.
+    /// \param [out]    destination         The destination bitmap.
+    /// \param          destination_stride  The stride of the destination bitmap (in bytes).
+    static void UnpackHiLoBytes(const void* source, std::uint32_t words_per_line, std::uint32_t height, void* destination, std::uint32_t destination_stride);
+
+    /// Downscales a bitmap by an integer factor (in both directions), where each destination pixel is the average of the
+    /// corresponding factor x factor block of source pixels (rounded to nearest for integer pixel types). For a factor of 2
+    /// and the pixel types Gray8 and Gray16, a SIMD-implementation is used.
+    ///
+    /// \param          pixel_type          The pixel type (c.f. imgdoc2::PixelType) of the source and the destination.
+    /// \param          factor              The minification factor, which must be greater than zero.
+    /// \param          source              The source bitmap, which must have (at least) a size of (destination_width * factor) x (destination_height * factor).
+    /// \param          source_stride       The stride of the source bitmap (in bytes).
+    /// \param          destination_width   The width of the destination bitmap (in pixels).
+    /// \param          destination_height  The height of the destination bitmap (in pixels).
+    /// \param [out]    destination         The destination bitmap.
+    /// \param          destination_stride  The stride of the destination bitmap (in bytes).
+    ///
+    /// \returns    True if the operation was successful; false if the pixel type is not supported or the factor is zero.
+    static bool DownscaleByAveraging(std::uint8_t pixel_type, std::uint32_t factor, const void* source, std::uint32_t source_stride, std::uint32_t destination_width, std::uint32_t destination_height, void* destination, std::uint32_t destination_stride);
+
+    /// Updates the accumulator with the element-wise maximum (or minimum) of the accumulator and the source, i.e. for each
+    /// element "accumulator[i] = max(accumulator[i], source[i])" (or min respectively). For multi-channel pixel types, this
+    /// operation is done for each channel.
+    ///
+    /// \param          pixel_type          The pixel type (c.f. imgdoc2::PixelType) of the source and the accumulator.
+    /// \param          maximum             True to determine the maximum, false to determine the minimum.
+    /// \param          source              The source pixels.
+    /// \param [in,out] accumulator         The accumulator.
+    /// \param          number_of_pixels    The number of pixels.
+    ///
+    /// \returns    True if the operation was successful; false if the pixel type is not supported.
+    static bool UpdateExtremum(std::uint8_t pixel_type, bool maximum, const void* source, void* accumulator, std::uint32_t number_of_pixels);
+
+    /// Adds the source pixels element-wise (i.e. for each channel) to an accumulator of 32-bit integers. This is supported
+    /// for the integer pixel types (Gray8, Gray16, Bgr24 and Bgr48), and it is the responsibility of the caller to ensure
+    /// that the accumulator does not overflow.
+    ///
+    /// \param          pixel_type          The pixel type (c.f. imgdoc2::PixelType) of the source.
+    /// \param          source              The source pixels.
+    /// \param [in,out] accumulator         The accumulator, which must have space for number_of_pixels times the number of channels elements.
+    /// \param          number_of_pixels    The number of pixels.
+    ///
+    /// \returns    True if the operation was successful; false if the pixel type is not supported.
+    static bool AccumulateSum(std::uint8_t pixel_type, const void* source, std::uint32_t* accumulator, std::uint32_t number_of_pixels);
+
+    /// Adds the pixels of a bitmap to a histogram with one bin for each possible value, i.e. the histogram must have 256
+    /// elements for Gray8 and 65536 elements for Gray16.
+    ///
+    /// \param          pixel_type  The pixel type (c.f. imgdoc2::PixelType) - only Gray8 and Gray16 are supported.
+    /// \param          source      The source bitmap.
+    /// \param          stride      The stride of the source bitmap in bytes.
+    /// \param          width       The width of the source bitmap in pixels.
+    /// \param          height      The height of the source bitmap in pixels.
+    /// \param [in,out] histogram   The histogram.
+    ///
+    /// \returns    True if the operation was successful; false if the pixel type is not supported.
+    static bool AccumulateHistogram(std::uint8_t pixel_type, const void* source, std::uint32_t stride, std::uint32_t width, std::uint32_t height, std::uint64_t* histogram);
+
+    /// Updates the statistics (minimum, maximum, sum and sum of squares) with the specified floating-point values.
+    ///
+    /// \param          source      The source values.
+    /// \param          count       The number of values.
+    /// \param [in,out] statistics  The statistics to be updated.
+    static void AccumulateStatistics(const float* source, std::uint32_t count, FloatStatistics& statistics);
+
+    /// Converts a bitmap to a pixel type with a smaller range by mapping the source values linearly ("window/level"), i.e. the
+    /// value window_minimum is mapped to zero, the value window_maximum is mapped to the maximal value of the destination pixel
+    /// type, and values outside of the window are clamped. The result is rounded to nearest, and not-a-number is mapped to zero.
+    /// The following conversions are supported: Gray16 to Gray8, Bgr48 to Bgr24 (where each channel is mapped in the same way),
+    /// Gray32Float to Gray8 and Gray32Float to Gray16.
+    ///
+    /// \param          source_pixel_type       The pixel type (c.f. imgdoc2::PixelType) of the source.
+    /// \param          source                  The source bitmap.
+    /// \param          source_stride           The stride of the source bitmap (in bytes).
+    /// \param          width                   The width of the bitmap (in pixels).
+    /// \param          height                  The height of the bitmap (in pixels).
+    /// \param          window_minimum          The source value which is mapped to zero.
+    /// \param          window_maximum          The source value which is mapped to the maximal value of the destination pixel type.
+    /// \param          destination_pixel_type  The pixel type (c.f. imgdoc2::PixelType) of the destination.
+    /// \param [out]    destination             The destination bitmap.
+    /// \param          destination_stride      The stride of the destination bitmap (in bytes).
+    ///
+    /// \returns    True if the operation was successful; false if the conversion is not supported or window_maximum is not greater than window_minimum.
+    static bool ConvertWithWindow(std::uint8_t source_pixel_type, const void* source, std::uint32_t source_stride, std::uint32_t width, std::uint32_t height, double window_minimum, double window_maximum, std::uint8_t destination_pixel_type, void* destination, std::uint32_t destination_stride);
+
+    /// Fills a look-up table (with 65536 entries) for mapping 16-bit values to 8-bit values. The values are mapped linearly as
+    /// with ConvertWithWindow, and additionally a gamma-correction is applied, i.e. the normalized value t (in the range [0,1])
+    /// is mapped to 255 * t^gamma.
+    ///
+    /// \param          window_minimum  The value which is mapped to zero.
+    /// \param          window_maximum  The value which is mapped to 255.
+    /// \param          gamma           The exponent of the gamma-correction (1 means "linear mapping").
+    /// \param [out]    look_up_table   The look-up table, which must have space for 65536 elements.
+    ///
+    /// \returns    True if the operation was successful; false if window_maximum is not greater than window_minimum or gamma is not positive.
+    static bool FillWindowLookUpTable(double window_minimum, double window_maximum, double gamma, std::uint8_t* look_up_table);
+
+    /// Converts a bitmap of pixel type Gray16 to Gray8 (or Bgr48 to Bgr24) by mapping each value (each channel respectively)
+    /// with the specified look-up table.
+    ///
+    /// \param          source_pixel_type   The pixel type (c.f. imgdoc2::PixelType) of the source - Gray16 or Bgr48.
+    /// \param          source              The source bitmap.
+    /// \param          source_stride       The stride of the source bitmap (in bytes).
+    /// \param          width               The width of the bitmap (in pixels).
+    /// \param          height              The height of the bitmap (in pixels).
+    /// \param          look_up_table       The look-up table with 65536 elements.
+    /// \param [out]    destination         The destination bitmap (of pixel type Gray8 or Bgr24 respectively).
+    /// \param          destination_stride  The stride of the destination bitmap (in bytes).
+    ///
+    /// \returns    True if the operation was successful; false if the pixel type is not supported.
+    static bool ConvertWithLookUpTable(std::uint8_t source_pixel_type, const void* source, std::uint32_t source_stride, std::uint32_t width, std::uint32_t height, const std::uint8_t* look_up_table, void* destination, std::uint32_t destination_stride);
+};
@@ -0,0 +1,511 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include "planeslicerenderer.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include "parallelexecution.h"
+#include "renderingutilities.h"
+
+using namespace std;
+using namespace imgdoc2;
+
+/// The geometry of the slice, prepared for the sampling operation - all vectors are given as arrays (indexed by the axis).
+struct PlaneSliceRenderer::NormalizedGeometry
+{
+    Plane_NormalAndDistD plane;
+    array<double, 3> start;         ///< The point corresponding to the center of the pixel (0, 0).
+    array<double, 3> step_u;        ///< The vector from one pixel to the next in x-direction.
+    array<double, 3> step_v;        ///< The vector from one pixel to the next in y-direction.
+    array<double, 3> bounds_min;    ///< The minimum of the axis-aligned bounding box of the region.
+    array<double, 3> bounds_max;    ///< The maximum of the axis-aligned bounding box of the region.
+};
+
+/// The information about a brick which is to be sampled (together with its voxel data).
+struct PlaneSliceRenderer::BrickToSample : RenderingUtilities::BrickData
+{
+    dbIndex pk{ 0 };
+    array<double, 3> position;              ///< The position of the brick (in the logical coordinate system).
+    array<double, 3> extent;                ///< The extent of the brick (in the logical coordinate system).
+    array<double, 3> voxels_per_unit;       ///< The number of voxels per logical unit (for each axis).
+};
+
+namespace
+{
+    /// The voxel indices and weights along one axis for the samples of a line.
+    struct AxisSamples
+    {
+        vector<uint32_t> index0;
+        vector<uint32_t> index1;
+        vector<float> weight;
+    };
+
+    /// Restricts the range [begin, end) of sample indices to those samples whose coordinate (given by a + i * b) is within
+    /// the half-open interval [low, high).
+    void ClipToInterval(double a, double b, double low, double high, int64_t& begin, int64_t& end)
+    {
+        if (b == 0)
+        {
+            if (!(a >= low && a < high))
+            {
+                end = begin;
+            }
+
+            return;
+        }
+
+        constexpr double kMaxIndex = static_cast<double>(numeric_limits<int32_t>::max());
+        double first, last;
+        if (b > 0)
+        {
+            first = ceil((low - a) / b);
+            last = ceil((high - a) / b);
+        }
+        else
+        {
+            first = floor((high - a) / b) + 1;
+            last = floor((low - a) / b) + 1;
+        }
+
+        begin = max(begin, static_cast<int64_t>(clamp(first, -kMaxIndex, kMaxIndex)));
+        end = min(end, static_cast<int64_t>(clamp(last, -kMaxIndex, kMaxIndex)));
+    }
+
+    /// Calculates the voxel indices and weights along one axis, where the (continuous) voxel coordinate of the n-th sample
+    /// is 'start + n * step'. This loop does not contain any dependencies between the iterations, so the compiler is able to
+    /// vectorize it.
+    void CalculateAxisSamples(double start, double step, size_t count, uint32_t size, bool linear, AxisSamples& samples)
+    {
+        samples.index0.resize(count);
+        samples.index1.resize(count);
+        samples.weight.resize(count);
+        const double max_index = static_cast<double>(size) - 1;
+        for (size_t n = 0; n < count; ++n)
+        {
+            const double coordinate = start + static_cast<double>(n) * step;
+            if (linear)
+            {
+                const double coordinate_floor = floor(coordinate);
+                samples.index0[n] = static_cast<uint32_t>(clamp(coordinate_floor, 0.0, max_index));
+                samples.index1[n] = static_cast<uint32_t>(clamp(coordinate_floor + 1, 0.0, max_index));
+                samples.weight[n] = static_cast<float>(coordinate - coordinate_floor);
+            }
+            else
+            {
+                samples.index0[n] = samples.index1[n] = static_cast<uint32_t>(clamp(floor(coordinate + 0.5), 0.0, max_index));
+                samples.weight[n] = 0;
+            }
+        }
+    }
+
+    /// Samples a line of the destination from a brick, for the case that only one voxel-coordinate (the one for axis 'a') is
+    /// varying along the line. The voxel-coordinates for the two other axes (b and c) are constant, so that the samples are
+    /// taken from (at most) four lines of the brick.
+    template <typename t_channel, int t_channels>
+    void SampleLineOneVaryingAxis(
+        const array<const t_channel*, 4>& lines,    // the lines for (b0,c0), (b1,c0), (b0,c1) and (b1,c1)
+        float weight_b,
+        float weight_c,
+        size_t element_stride,                      // the distance between two voxels along axis 'a' (in units of t_channel)
+        const AxisSamples& samples_a,
+        bool linear,
+        t_channel* destination)
+    {
+        const size_t count = samples_a.index0.size();
+        if (!linear)
+        {
+            if (element_stride == t_channels && count > 1 && samples_a.index0[count - 1] - samples_a.index0[0] == count - 1)
+            {
+                // this is a 1:1-copy of a contiguous range of voxels
+                memcpy(destination, lines[0] + static_cast<size_t>(samples_a.index0[0]) * t_channels, count * t_channels * sizeof(t_channel));
+                return;
+            }
+
+            for (size_t n = 0; n < count; ++n)
+            {
+                const t_channel* source = lines[0] + samples_a.index0[n] * element_stride;
+                for (int c = 0; c < t_channels; ++c)
+                {
+                    *destination++ = source[c];
+                }
+            }
+
+            return;
+        }
+
+        for (size_t n = 0; n < count; ++n)
+        {
+            const size_t offset0 = samples_a.index0[n] * element_stride;
+            const size_t offset1 = samples_a.index1[n] * element_stride;
+            const float weight_a = samples_a.weight[n];
+            for (int c = 0; c < t_channels; ++c)
+            {
+                double values[4];
+                for (int l = 0; l < 4; ++l)
+                {
+                    const double value0 = lines[l][offset0 + c];
+                    values[l] = value0 + (static_cast<double>(lines[l][offset1 + c]) - value0) * weight_a;
+                }
+
+                const double value_c0 = values[0] + (values[1] - values[0]) * weight_b;
+                const double value_c1 = values[2] + (values[3] - values[2]) * weight_b;
+                *destination++ = RenderingUtilities::ConvertFromDouble<t_channel>(value_c0 + (value_c1 - value_c0) * weight_c);
+            }
+        }
+    }
+
+    /// Samples a line of the destination from a brick, for the general case (i.e. all three voxel-coordinates may vary
+    /// along the line).
+    template <typename t_channel, int t_channels>
+    void SampleLineGeneral(
+        const t_channel* data,
+        const array<uint32_t, 3>& size,
+        const array<AxisSamples, 3>& samples,
+        bool linear,
+        t_channel* destination)
+    {
+        const size_t stride_y = static_cast<size_t>(size[0]) * t_channels;
+        const size_t stride_z = stride_y * size[1];
+        const size_t count = samples[0].index0.size();
+        for (size_t n = 0; n < count; ++n)
+        {
+            const size_t x0 = samples[0].index0[n] * static_cast<size_t>(t_channels);
+            const size_t y0 = samples[1].index0[n] * stride_y;
+            const size_t z0 = samples[2].index0[n] * stride_z;
+            if (!linear)
+            {
+                const t_channel* source = data + x0 + y0 + z0;
+                for (int c = 0; c < t_channels; ++c)
+                {
+                    *destination++ = source[c];
+                }
+
+                continue;
+            }
+
+            const size_t x1 = samples[0].index1[n] * static_cast<size_t>(t_channels);
+            const size_t y1 = samples[1].index1[n] * stride_y;
+            const size_t z1 = samples[2].index1[n] * stride_z;
+            const float wx = samples[0].weight[n];
+            const float wy = samples[1].weight[n];
+            const float wz = samples[2].weight[n];
+            for (int c = 0; c < t_channels; ++c)
+            {
+                const auto lerp_x = [&](size_t y, size_t z)->double
+                    {
+                        const double value0 = data[x0 + y + z + c];
+                        return value0 + (static_cast<double>(data[x1 + y + z + c]) - value0) * wx;
+                    };
+                const double value_z0 = lerp_x(y0, z0) + (lerp_x(y1, z0) - lerp_x(y0, z0)) * wy;
+                const double value_z1 = lerp_x(y0, z1) + (lerp_x(y1, z1) - lerp_x(y0, z1)) * wy;
+                *destination++ = RenderingUtilities::ConvertFromDouble<t_channel>(value_z0 + (value_z1 - value_z0) * wz);
+            }
+        }
+    }
+
+    /// Samples 'count' pixels from the brick, where the (continuous) voxel-coordinate of the n-th sample (relative to the
+    /// sub-volume held in memory) is 'start + n * step'.
+    template <typename t_channel, int t_channels>
+    void SampleLine(
+        const uint8_t* brick_data,
+        const array<uint32_t, 3>& size,
+        const array<double, 3>& start,
+        const array<double, 3>& step,
+        size_t count,
+        bool linear,
+        array<AxisSamples, 3>& samples,
+        t_channel* destination)
+    {
+        const t_channel* data = reinterpret_cast<const t_channel*>(brick_data);
+        int varying_axes = 0;
+        int varying_axis = 0;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            if (step[axis] != 0)
+            {
+                ++varying_axes;
+                varying_axis = axis;
+            }
+        }
+
+        if (varying_axes > 1)
+        {
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                CalculateAxisSamples(start[axis], step[axis], count, size[axis], linear, samples[axis]);
+            }
+
+            SampleLineGeneral<t_channel, t_channels>(data, size, samples, linear, destination);
+            return;
+        }
+
+        // the fast path (for slices which are parallel to the axes of the brick) - only the coordinate for one axis is
+        //  varying, for the two other axes we determine the lines of voxels to be used once
+        const array<size_t, 3> element_strides{ static_cast<size_t>(t_channels), static_cast<size_t>(size[0]) * t_channels, static_cast<size_t>(size[0]) * size[1] * t_channels };
+        const int axis_b = varying_axis == 0 ? 1 : 0;
+        const int axis_c = varying_axis == 2 ? 1 : 2;
+        AxisSamples& samples_b = samples[axis_b];
+        AxisSamples& samples_c = samples[axis_c];
+        CalculateAxisSamples(start[axis_b], 0, 1, size[axis_b], linear, samples_b);
+        CalculateAxisSamples(start[axis_c], 0, 1, size[axis_c], linear, samples_c);
+        const array<const t_channel*, 4> lines
+        {
+            data + samples_b.index0[0] * element_strides[axis_b] + samples_c.index0[0] * element_strides[axis_c],
+            data + samples_b.index1[0] * element_strides[axis_b] + samples_c.index0[0] * element_strides[axis_c],
+            data + samples_b.index0[0] * element_strides[axis_b] + samples_c.index1[0] * element_strides[axis_c],
+            data + samples_b.index1[0] * element_strides[axis_b] + samples_c.index1[0] * element_strides[axis_c]
+        };
+
+        CalculateAxisSamples(start[varying_axis], step[varying_axis], count, size[varying_axis], linear, samples[varying_axis]);
+        SampleLineOneVaryingAxis<t_channel, t_channels>(lines, samples_b.weight[0], samples_c.weight[0], element_strides[varying_axis], samples[varying_axis], linear, destination);
+    }
+}
+
+PlaneSliceRenderer::PlaneSliceRenderer(std::shared_ptr<imgdoc2::IDocRead3d> reader) : reader_(std::move(reader))
+{
+}
+
+void PlaneSliceRenderer::Render(const SliceGeometry& geometry, const imgdoc2::IDimCoordinateQueryClause* plane_clause, const Options& options, const DestinationBitmap& destination)
+{
+    const uint8_t bytes_per_pixel = RenderingUtilities::GetBytesPerPixel(options.pixel_type);
+    if (bytes_per_pixel == 0)
+    {
+        throw invalid_argument_exception("The pixel type is not supported.");
+    }
+
+    if (destination.data == nullptr || destination.width == 0 || destination.height == 0)
+    {
+        throw invalid_argument_exception("The destination bitmap must not be empty.");
+    }
+
+    if (destination.stride < destination.width * bytes_per_pixel)
+    {
+        throw invalid_argument_exception("The stride of the destination bitmap is too small.");
+    }
+
+    const auto normalized_geometry = PlaneSliceRenderer::NormalizeGeometry(geometry, destination);
+    const auto bricks = this->ReadBricks(normalized_geometry, plane_clause, options);
+
+    RenderingUtilities::Fill(options.pixel_type, options.background_value, destination);
+
+    if (bricks.empty())
+    {
+        return;
+    }
+
+    const uint32_t number_of_threads = options.max_number_of_threads > 0 ? options.max_number_of_threads : ParallelExecution::GetDefaultNumberOfThreads();
+    const uint32_t number_of_bands = min(destination.height, number_of_threads * 4);
+    ParallelExecution::Run(
+        number_of_threads,
+        number_of_bands,
+        [&](size_t band)->void
+        {
+            const auto y_start = static_cast<uint32_t>(static_cast<uint64_t>(destination.height) * band / number_of_bands);
+            const auto y_end = static_cast<uint32_t>(static_cast<uint64_t>(destination.height) * (band + 1) / number_of_bands);
+            PlaneSliceRenderer::RenderLines(bricks, normalized_geometry, options, destination, y_start, y_end);
+        });
+}
+
+/*static*/PlaneSliceRenderer::NormalizedGeometry PlaneSliceRenderer::NormalizeGeometry(const SliceGeometry& geometry, const DestinationBitmap& destination)
+{
+    const double normal_length = geometry.plane.normal.AbsoluteValue();
+    if (!(normal_length > 0) || !isfinite(normal_length))
+    {
+        throw invalid_argument_exception("The normal of the plane must not be zero.");
+    }
+
+    if (!(geometry.region.w > 0) || !(geometry.region.h > 0))
+    {
+        throw invalid_argument_exception("The region must not be empty.");
+    }
+
+    NormalizedGeometry normalized_geometry;
+    normalized_geometry.plane.normal = Vector3dD(geometry.plane.normal.x / normal_length, geometry.plane.normal.y / normal_length, geometry.plane.normal.z / normal_length);
+    normalized_geometry.plane.distance = geometry.plane.distance / normal_length;
+    const auto& normal = normalized_geometry.plane.normal;
+
+    // we project the basis vectors onto the plane (so that small deviations do not move the samples out of the plane), and
+    //  normalize them
+    const auto project_and_normalize = [&normal](const Vector3dD& vector)->array<double, 3>
+        {
+            const double dot = Vector3dD::Dot(vector, normal);
+            const Vector3dD projected(vector.x - dot * normal.x, vector.y - dot * normal.y, vector.z - dot * normal.z);
+            const double length = projected.AbsoluteValue();
+            if (!(length > 1e-9 * vector.AbsoluteValue()) || !isfinite(length))
+            {
+                throw invalid_argument_exception("The in-plane basis vectors must not be zero or parallel to the normal of the plane.");
+            }
+
+            return { projected.x / length, projected.y / length, projected.z / length };
+        };
+
+    const auto u = project_and_normalize(geometry.axis_u);
+    const auto v = project_and_normalize(geometry.axis_v);
+    const auto cross = Vector3dD::Cross(Vector3dD(u[0], u[1], u[2]), Vector3dD(v[0], v[1], v[2]));
+    if (!(cross.AbsoluteValue() > 1e-9))
+    {
+        throw invalid_argument_exception("The in-plane basis vectors must not be parallel.");
+    }
+
+    const double pixel_size_u = geometry.region.w / destination.width;
+    const double pixel_size_v = geometry.region.h / destination.height;
+    const array<double, 3> origin{ normal.x * normalized_geometry.plane.distance, normal.y * normalized_geometry.plane.distance, normal.z * normalized_geometry.plane.distance };
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        normalized_geometry.start[axis] = origin[axis] + (geometry.region.x + pixel_size_u / 2) * u[axis] + (geometry.region.y + pixel_size_v / 2) * v[axis];
+        normalized_geometry.step_u[axis] = pixel_size_u * u[axis];
+        normalized_geometry.step_v[axis] = pixel_size_v * v[axis];
+
+        // the bounding box of the four corners of the region
+        const double corner0 = origin[axis] + geometry.region.x * u[axis] + geometry.region.y * v[axis];
+        const double extent_u = geometry.region.w * u[axis];
+        const double extent_v = geometry.region.h * v[axis];
+        normalized_geometry.bounds_min[axis] = corner0 + min(0.0, extent_u) + min(0.0, extent_v);
+        normalized_geometry.bounds_max[axis] = corner0 + max(0.0, extent_u) + max(0.0, extent_v);
+    }
+
+    return normalized_geometry;
+}
+
+std::vector<PlaneSliceRenderer::BrickToSample> PlaneSliceRenderer::ReadBricks(const NormalizedGeometry& geometry, const imgdoc2::IDimCoordinateQueryClause* plane_clause, const Options& options)
+{
+    CTileInfoQueryClause tile_info_query_clause;
+    tile_info_query_clause.AddPyramidLevelCondition(LogicalOperator::Invalid, ComparisonOperation::Equal, options.pyramid_level);
+
+    vector<dbIndex> indices;
+    this->reader_->GetTilesIntersectingPlane(
+        geometry.plane,
+        plane_clause,
+        &tile_info_query_clause,
+        [&indices](dbIndex index)->bool
+        {
+            indices.push_back(index);
+            return true;
+        });
+
+    sort(indices.begin(), indices.end());
+    vector<BrickToSample> bricks;
+    for (const auto index : indices)
+    {
+        LogicalPositionInfo3D position;
+        BrickBlobInfo blob_info;
+        this->reader_->ReadBrickInfo(index, nullptr, &position, &blob_info);
+        if (!(position.width > 0) || !(position.height > 0) || !(position.depth > 0) ||
+            blob_info.base_info.pixelWidth == 0 || blob_info.base_info.pixelHeight == 0 || blob_info.base_info.pixelDepth == 0)
+        {
+            continue;
+        }
+
+        BrickToSample brick;
+        brick.pk = index;
+        brick.position = { position.posX, position.posY, position.posZ };
+        brick.extent = { position.width, position.height, position.depth };
+        const array<uint32_t, 3> brick_size{ blob_info.base_info.pixelWidth, blob_info.base_info.pixelHeight, blob_info.base_info.pixelDepth };
+
+        // determine the part of the brick which is within the bounding box of the region (plus one voxel as a margin for
+        //  the interpolation)
+        array<uint32_t, 3> sub_volume_offset;
+        array<uint32_t, 3> sub_volume_size;
+        bool is_intersecting = true;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            brick.voxels_per_unit[axis] = brick_size[axis] / brick.extent[axis];
+            const double low = (geometry.bounds_min[axis] - brick.position[axis]) * brick.voxels_per_unit[axis] - 0.5;
+            const double high = (geometry.bounds_max[axis] - brick.position[axis]) * brick.voxels_per_unit[axis] + 0.5;
+            const double first = clamp(floor(low) - 1, 0.0, static_cast<double>(brick_size[axis]));
+            const double last = clamp(ceil(high) + 1, 0.0, static_cast<double>(brick_size[axis]));
+            if (!(last > first) || geometry.bounds_max[axis] < brick.position[axis] || geometry.bounds_min[axis] > brick.position[axis] + brick.extent[axis])
+            {
+                is_intersecting = false;
+                break;
+            }
+
+            sub_volume_offset[axis] = static_cast<uint32_t>(first);
+            sub_volume_size[axis] = static_cast<uint32_t>(last - first);
+        }
+
+        if (!is_intersecting)
+        {
+            continue;
+        }
+
+        if (blob_info.base_info.pixelType != options.pixel_type)
+        {
+            ostringstream string_stream;
+            string_stream << "The brick with pk=" << index << " has a pixel type different from the pixel type of the destination.";
+            throw invalid_operation_exception(string_stream.str().c_str());
+        }
+
+        RenderingUtilities::LoadBrickData(this->reader_.get(), index, blob_info, sub_volume_offset, sub_volume_size, "rendering a slice", brick);
+        bricks.emplace_back(std::move(brick));
+    }
+
+    return bricks;
+}
+
+/*static*/void PlaneSliceRenderer::RenderLines(const std::vector<BrickToSample>& bricks, const NormalizedGeometry& geometry, const Options& options, const DestinationBitmap& destination, std::uint32_t y_start, std::uint32_t y_end)
+{
+    const uint8_t bytes_per_pixel = RenderingUtilities::GetBytesPerPixel(options.pixel_type);
+    const bool linear = options.filter == SamplingFilter::Trilinear;
+    array<AxisSamples, 3> samples;
+    for (uint32_t y = y_start; y < y_end; ++y)
+    {
+        array<double, 3> line_start;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            line_start[axis] = geometry.start[axis] + y * geometry.step_v[axis];
+        }
+
+        uint8_t* destination_line = static_cast<uint8_t*>(destination.data) + static_cast<size_t>(y) * destination.stride;
+        for (const auto& brick : bricks)
+        {
+            // determine the range of pixels of this line which are within the brick
+            int64_t begin = 0;
+            int64_t end = destination.width;
+            for (int axis = 0; axis < 3 && begin < end; ++axis)
+            {
+                ClipToInterval(line_start[axis], geometry.step_u[axis], brick.position[axis], brick.position[axis] + brick.extent[axis], begin, end);
+            }
+
+            if (begin >= end)
+            {
+                continue;
+            }
+
+            array<double, 3> voxel_start, voxel_step;
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                voxel_start[axis] = (line_start[axis] + static_cast<double>(begin) * geometry.step_u[axis] - brick.position[axis]) * brick.voxels_per_unit[axis] - 0.5 - brick.offset[axis];
+                voxel_step[axis] = geometry.step_u[axis] * brick.voxels_per_unit[axis];
+            }
+
+            const auto count = static_cast<size_t>(end - begin);
+            void* destination_pixel = destination_line + static_cast<size_t>(begin) * bytes_per_pixel;
+            switch (options.pixel_type)
+            {
+            case PixelType::Gray8:
+                SampleLine<uint8_t, 1>(brick.data, brick.size, voxel_start, voxel_step, count, linear, samples, static_cast<uint8_t*>(destination_pixel));
+                break;
+            case PixelType::Gray16:
+                SampleLine<uint16_t, 1>(brick.data, brick.size, voxel_start, voxel_step, count, linear, samples, static_cast<uint16_t*>(destination_pixel));
+                break;
+            case PixelType::Bgr24:
+                SampleLine<uint8_t, 3>(brick.data, brick.size, voxel_start, voxel_step, count, linear, samples, static_cast<uint8_t*>(destination_pixel));
+                break;
+            case PixelType::Bgr48:
+                SampleLine<uint16_t, 3>(brick.data, brick.size, voxel_start, voxel_step, count, linear, samples, static_cast<uint16_t*>(destination_pixel));
+                break;
+            case PixelType::Gray32Float:
+                SampleLine<float, 1>(brick.data, brick.size, voxel_start, voxel_step, count, linear, samples, static_cast<float*>(destination_pixel));
+                break;
+            default:
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <imgdoc2.h>
+#include "renderingutilities.h"
+
+/// This class is rendering an arbitrary (oblique) planar slice through a 3D-document into a 2D-bitmap. The slice is given by
+/// a plane (in normal-and-distance representation), an in-plane basis (two vectors spanning the plane) and a rectangular
+/// region in the coordinate system given by this basis, with its origin at the point of the plane which is closest to the
+/// origin (i.e. normal * distance). The pixel (i, j) of the destination bitmap is sampled at the point
+///   normal * distance + (region.x + (i + 0.5) * region.w / width) * u + (region.y + (j + 0.5) * region.h / height) * v.
+/// The operation is as follows:
+/// - the bricks intersecting the plane (and matching the "plane clause") are queried, and bricks which do not intersect the
+///   bounding box of the region are discarded
+/// - the data of the bricks is read (sequentially) from the document - for chunked bricks only the sub-volume intersecting
+///   the bounding box of the region is read
+/// - the destination bitmap is divided into bands which are processed in parallel, and each line is sampled (using nearest
+///   neighbor or trilinear interpolation) from the bricks in the order of their primary key
+/// If a line of the destination is parallel to one of the axes of the brick (which is the case for XY-, XZ- and YZ-slices),
+/// only one voxel-coordinate is varying along the line, and a faster code path is used. The pixel type of the bricks must be
+/// identical to the pixel type of the destination bitmap.
+class PlaneSliceRenderer
+{
+public:
+    /// Values that represent the filter used for sampling the bricks.
+    enum class SamplingFilter : std::uint8_t
+    {
+        NearestNeighbor = 0,    ///< Nearest neighbor interpolation.
+        Trilinear = 1           ///< Trilinear interpolation.
+    };
+
+    /// This structure defines the slice to be rendered.
+    struct SliceGeometry
+    {
+        imgdoc2::Plane_NormalAndDistD plane;    ///< The plane.
+        imgdoc2::Vector3dD axis_u;              ///< The first vector of the in-plane basis (giving the x-direction of the destination bitmap).
+        imgdoc2::Vector3dD axis_v;              ///< The second vector of the in-plane basis (giving the y-direction of the destination bitmap).
+        imgdoc2::RectangleD region;             ///< The region to be rendered (in the coordinate system given by the in-plane basis).
+    };
+
+    /// The parameters for the rendering operation.
+    struct Options
+    {
+        std::uint8_t pixel_type{ imgdoc2::PixelType::Unknown };    ///< The pixel type of the destination bitmap (c.f. imgdoc2::PixelType).
+        double background_value{ 0 };                               ///< The value with which the destination is filled where there are no bricks.
+        SamplingFilter filter{ SamplingFilter::NearestNeighbor };   ///< The sampling filter.
+        std::uint32_t max_number_of_threads{ 0 };                   ///< The maximal number of threads to use, where 0 means "use the number of hardware threads".
+        int pyramid_level{ 0 };                                     ///< The pyramid level of the bricks to be used.
+    };
+
+    /// This structure describes the destination bitmap.
+    using DestinationBitmap = RenderingUtilities::Bitmap;
+private:
+    struct BrickToSample;
+    struct NormalizedGeometry;
+
+    std::shared_ptr<imgdoc2::IDocRead3d> reader_;
+public:
+    explicit PlaneSliceRenderer(std::shared_ptr<imgdoc2::IDocRead3d> reader);
+
+    /// Renders the specified slice into the destination bitmap.
+    ///
+    /// \param          geometry        The geometry of the slice.
+    /// \param          plane_clause    If non-null, the dimension-clause selecting the plane (i.e. the non-spatial coordinates).
+    /// \param          options         The parameters of the operation.
+    /// \param [out]    destination     The destination bitmap.
+    void Render(const SliceGeometry& geometry, const imgdoc2::IDimCoordinateQueryClause* plane_clause, const Options& options, const DestinationBitmap& destination);
+private:
+    static NormalizedGeometry NormalizeGeometry(const SliceGeometry& geometry, const DestinationBitmap& destination);
+    std::vector<BrickToSample> ReadBricks(const NormalizedGeometry& geometry, const imgdoc2::IDimCoordinateQueryClause* plane_clause, const Options& options);
+    static void RenderLines(const std::vector<BrickToSample>& bricks, const NormalizedGeometry& geometry, const Options& options, const DestinationBitmap& destination, std::uint32_t y_start, std::uint32_t y_end);
+};
@@ -0,0 +1,332 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include "pyramidgenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <sstream>
+#include "parallelexecution.h"
+#include "pixelkernels.h"
+#include "regioncompositor.h"
+#include "utilities.h"
+
+using namespace std;
+using namespace imgdoc2;
+
+namespace
+{
+    /// An output tile of a pyramid level - the prepared composition (i.e. the source data) and the resulting bitmap.
+    struct OutputTile
+    {
+        uint32_t column{ 0 };
+        uint32_t row{ 0 };
+        uint32_t pixel_width{ 0 };
+        uint32_t pixel_height{ 0 };
+        RectangleD logical_rect;
+        RegionCompositor::PreparedComposition prepared_composition;
+        vector<uint8_t> bitmap;
+    };
+}
+
+PyramidGenerator::PyramidGenerator(std::shared_ptr<imgdoc2::IDocRead2d> reader, std::shared_ptr<imgdoc2::IDocWrite2d> writer)
+    : reader_(std::move(reader)), writer_(std::move(writer))
+{
+}
+
+void PyramidGenerator::Generate(const Options& options)
+{
+    PyramidGenerator::ThrowIfOptionsInvalid(options);
+
+    const auto planes = this->DeterminePlanes();
+    for (const auto& plane : planes)
+    {
+        for (uint32_t level = 1; level <= options.number_of_levels; ++level)
+        {
+            if (!this->HasTilesOnPyramidLevel(plane, static_cast<int>(level)))
+            {
+                this->GeneratePyramidLevel(plane, static_cast<int>(level), options);
+            }
+        }
+    }
+}
+
+/*static*/void PyramidGenerator::ThrowIfOptionsInvalid(const Options& options)
+{
+    if (options.minification_factor < 2)
+    {
+        throw invalid_argument_exception("The minification factor must be at least 2.");
+    }
+
+    if (options.tile_width == 0 || options.tile_height == 0)
+    {
+        throw invalid_argument_exception("The size of the output tiles must not be zero.");
+    }
+
+    // the source region of an output tile must be addressable with 32-bit integers
+    const uint64_t max_source_extent = numeric_limits<uint32_t>::max() / 8;
+    if (static_cast<uint64_t>(options.tile_width) * options.minification_factor > max_source_extent ||
+        static_cast<uint64_t>(options.tile_height) * options.minification_factor > max_source_extent)
+    {
+        throw invalid_argument_exception("The size of the output tiles or the minification factor is too large.");
+    }
+}
+
+std::vector<PyramidGenerator::PlaneInfo> PyramidGenerator::DeterminePlanes()
+{
+    CTileInfoQueryClause level0_clause;
+    level0_clause.AddPyramidLevelCondition(LogicalOperator::Invalid, ComparisonOperation::Equal, 0);
+
+    vector<dbIndex> indices;
+    this->reader_->Query(
+        nullptr,
+        &level0_clause,
+        [&indices](dbIndex index)->bool
+        {
+            indices.push_back(index);
+            return true;
+        });
+
+    map<vector<pair<Dimension, int>>, PlaneInfo> planes;
+    for (const auto index : indices)
+    {
+        TileCoordinate tile_coordinate;
+        LogicalPositionInfo position;
+        TileBlobInfo blob_info;
+        this->reader_->ReadTileInfo(index, &tile_coordinate, &position, &blob_info);
+        if (!(position.width > 0) || !(position.height > 0) || blob_info.base_info.pixelWidth == 0 || blob_info.base_info.pixelHeight == 0)
+        {
+            continue;
+        }
+
+        vector<pair<Dimension, int>> coordinate;
+        bool has_m_index = false;
+        tile_coordinate.EnumCoordinates(
+            [&](Dimension dimension, int value)->bool
+            {
+                if (dimension == 'M')
+                {
+                    has_m_index = true;
+                }
+                else
+                {
+                    coordinate.emplace_back(dimension, value);
+                }
+
+                return true;
+            });
+        sort(coordinate.begin(), coordinate.end());
+
+        const double logical_units_per_pixel = min(position.width / blob_info.base_info.pixelWidth, position.height / blob_info.base_info.pixelHeight);
+        const auto iterator = planes.find(coordinate);
+        if (iterator == planes.end())
+        {
+            PlaneInfo plane;
+            plane.coordinate = coordinate;
+            plane.has_m_index = has_m_index;
+            plane.bounding_box = RectangleD{ position.posX, position.posY, position.width, position.height };
+            plane.logical_units_per_pixel = logical_units_per_pixel;
+            plane.pixel_type = blob_info.base_info.pixelType;
+            planes.emplace(std::move(coordinate), plane);
+            continue;
+        }
+
+        auto& plane = iterator->second;
+        if (plane.pixel_type != blob_info.base_info.pixelType)
+        {
+            ostringstream string_stream;
+            string_stream << "The tile with pk=" << index << " has a pixel type different from the other tiles of its plane.";
+            throw invalid_operation_exception(string_stream.str().c_str());
+        }
+
+        const double x_end = max(plane.bounding_box.x + plane.bounding_box.w, position.posX + position.width);
+        const double y_end = max(plane.bounding_box.y + plane.bounding_box.h, position.posY + position.height);
+        plane.bounding_box.x = min(plane.bounding_box.x, position.posX);
+        plane.bounding_box.y = min(plane.bounding_box.y, position.posY);
+        plane.bounding_box.w = x_end - plane.bounding_box.x;
+        plane.bounding_box.h = y_end - plane.bounding_box.y;
+        plane.has_m_index = plane.has_m_index || has_m_index;
+        plane.logical_units_per_pixel = min(plane.logical_units_per_pixel, logical_units_per_pixel);
+    }
+
+    vector<PlaneInfo> result;
+    result.reserve(planes.size());
+    for (auto& item : planes)
+    {
+        result.emplace_back(std::move(item.second));
+    }
+
+    return result;
+}
+
+bool PyramidGenerator::HasTilesOnPyramidLevel(const PlaneInfo& plane, int pyramid_level)
+{
+    const auto plane_clause = PyramidGenerator::CreatePlaneQueryClause(plane);
+    CTileInfoQueryClause level_clause;
+    level_clause.AddPyramidLevelCondition(LogicalOperator::Invalid, ComparisonOperation::Equal, pyramid_level);
+
+    bool tile_found = false;
+    this->reader_->Query(
+        &plane_clause,
+        &level_clause,
+        [&tile_found](dbIndex)->bool
+        {
+            tile_found = true;
+            return false;
+        });
+
+    return tile_found;
+}
+
+void PyramidGenerator::GeneratePyramidLevel(const PlaneInfo& plane, int pyramid_level, const Options& options)
+{
+    const double logical_units_per_pixel = plane.logical_units_per_pixel * pow(static_cast<double>(options.minification_factor), pyramid_level);
+    const uint8_t bytes_per_pixel = RenderingUtilities::GetBytesPerPixel(plane.pixel_type);
+    if (bytes_per_pixel == 0)
+    {
+        ostringstream string_stream;
+        string_stream << "The pixel type " << static_cast<int>(plane.pixel_type) << " is not supported for creating a pyramid.";
+        throw invalid_operation_exception(string_stream.str().c_str());
+    }
+
+    // the number of pixels (at the resolution of the pyramid level) required to cover the bounding box - we allow for
+    //  a small tolerance, so that rounding errors do not lead to an additional column/row of tiles
+    const auto pixels_required = [logical_units_per_pixel](double extent)->uint64_t
+        {
+            return max(static_cast<uint64_t>(1), static_cast<uint64_t>(ceil(extent / logical_units_per_pixel - 1e-6)));
+        };
+    const uint64_t total_pixel_width = pixels_required(plane.bounding_box.w);
+    const uint64_t total_pixel_height = pixels_required(plane.bounding_box.h);
+    const auto number_of_columns = static_cast<uint32_t>((total_pixel_width + options.tile_width - 1) / options.tile_width);
+    const auto number_of_rows = static_cast<uint32_t>((total_pixel_height + options.tile_height - 1) / options.tile_height);
+
+    const auto plane_clause = PyramidGenerator::CreatePlaneQueryClause(plane);
+    TileCoordinate tile_coordinate;
+    for (const auto& item : plane.coordinate)
+    {
+        tile_coordinate.Set(item.first, item.second);
+    }
+
+    const uint32_t number_of_threads = options.max_number_of_threads > 0 ? options.max_number_of_threads : ParallelExecution::GetDefaultNumberOfThreads();
+    const size_t tiles_per_batch = options.tiles_per_batch > 0 ? options.tiles_per_batch : static_cast<size_t>(number_of_threads) * 2;
+    const uint64_t number_of_cells = static_cast<uint64_t>(number_of_columns) * number_of_rows;
+    RegionCompositor compositor(this->reader_);
+
+    RegionCompositor::Options composition_options;
+    composition_options.pixel_type = plane.pixel_type;
+    composition_options.filter = RegionCompositor::ResamplingFilter::NearestNeighbor;
+    composition_options.max_number_of_threads = 1;  // the parallelization is done on the level of output tiles
+    composition_options.pyramid_level = pyramid_level - 1;
+
+    for (uint64_t batch_start = 0; batch_start < number_of_cells; batch_start += tiles_per_batch)
+    {
+        // first phase: determine the source tiles and read their data (sequentially)
+        vector<OutputTile> batch;
+        for (uint64_t cell = batch_start; cell < min(number_of_cells, batch_start + tiles_per_batch); ++cell)
+        {
+            OutputTile output_tile;
+            output_tile.column = static_cast<uint32_t>(cell % number_of_columns);
+            output_tile.row = static_cast<uint32_t>(cell / number_of_columns);
+            output_tile.pixel_width = static_cast<uint32_t>(min(static_cast<uint64_t>(options.tile_width), total_pixel_width - static_cast<uint64_t>(output_tile.column) * options.tile_width));
+            output_tile.pixel_height = static_cast<uint32_t>(min(static_cast<uint64_t>(options.tile_height), total_pixel_height - static_cast<uint64_t>(output_tile.row) * options.tile_height));
+            output_tile.logical_rect = RectangleD{
+                plane.bounding_box.x + static_cast<double>(output_tile.column) * options.tile_width * logical_units_per_pixel,
+                plane.bounding_box.y + static_cast<double>(output_tile.row) * options.tile_height * logical_units_per_pixel,
+                output_tile.pixel_width * logical_units_per_pixel,
+                output_tile.pixel_height * logical_units_per_pixel };
+            output_tile.prepared_composition = compositor.Prepare(
+                output_tile.logical_rect,
+                &plane_clause,
+                composition_options,
+                output_tile.pixel_width * options.minification_factor,
+                output_tile.pixel_height * options.minification_factor);
+            if (!output_tile.prepared_composition.tiles.empty())
+            {
+                batch.emplace_back(std::move(output_tile));
+            }
+        }
+
+        if (batch.empty())
+        {
+            continue;
+        }
+
+        // second phase: render the source region and downscale it (in parallel)
+        ParallelExecution::Run(
+            number_of_threads,
+            batch.size(),
+            [&](size_t index)->void
+            {
+                auto& output_tile = batch[index];
+                RegionCompositor::DestinationBitmap source_bitmap;
+                source_bitmap.width = output_tile.pixel_width * options.minification_factor;
+                source_bitmap.height = output_tile.pixel_height * options.minification_factor;
+                source_bitmap.stride = source_bitmap.width * bytes_per_pixel;
+                vector<uint8_t> source(static_cast<size_t>(source_bitmap.stride) * source_bitmap.height);
+                source_bitmap.data = source.data();
+                RegionCompositor::Render(output_tile.prepared_composition, source_bitmap);
+
+                // the source data is not needed anymore, so release it as early as possible
+                output_tile.prepared_composition.tiles.clear();
+
+                const uint32_t destination_stride = output_tile.pixel_width * bytes_per_pixel;
+                output_tile.bitmap.resize(static_cast<size_t>(destination_stride) * output_tile.pixel_height);
+                PixelKernels::DownscaleByAveraging(
+                    plane.pixel_type,
+                    options.minification_factor,
+                    source.data(),
+                    source_bitmap.stride,
+                    output_tile.pixel_width,
+                    output_tile.pixel_height,
+                    output_tile.bitmap.data(),
+                    destination_stride);
+            });
+
+        // third phase: add the output tiles to the document (within one transaction)
+        this->writer_->BeginTransaction();
+        try
+        {
+            for (const auto& output_tile : batch)
+            {
+                if (plane.has_m_index)
+                {
+                    tile_coordinate.Set('M', static_cast<int>(output_tile.row * number_of_columns + output_tile.column));
+                }
+
+                const LogicalPositionInfo position_info{ output_tile.logical_rect.x, output_tile.logical_rect.y, output_tile.logical_rect.w, output_tile.logical_rect.h, pyramid_level };
+                TileBaseInfo tile_base_info;
+                tile_base_info.pixelWidth = output_tile.pixel_width;
+                tile_base_info.pixelHeight = output_tile.pixel_height;
+                tile_base_info.pixelType = plane.pixel_type;
+                const Utilities::GetDataObject data_object(output_tile.bitmap.data(), output_tile.bitmap.size());
+                this->writer_->AddTile(
+                    &tile_coordinate,
+                    &position_info,
+                    &tile_base_info,
+                    DataTypes::UNCOMPRESSED_BITMAP,
+                    TileDataStorageType::BlobInDatabase,
+                    &data_object);
+            }
+        }
+        catch (...)
+        {
+            this->writer_->RollbackTransaction();
+            throw;
+        }
+
+        this->writer_->CommitTransaction();
+    }
+}
+
+/*static*/imgdoc2::CDimCoordinateQueryClause PyramidGenerator::CreatePlaneQueryClause(const PlaneInfo& plane)
+{
+    CDimCoordinateQueryClause plane_clause;
+    for (const auto& item : plane.coordinate)
+    {
+        plane_clause.AddRangeClause(item.first, IDimCoordinateQueryClause::RangeClause{ item.second, item.second });
+    }
+
+    return plane_clause;
+}
@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <imgdoc2.h>
+
+/// This class is creating the pyramid levels of a 2D-document from its level-0 tiles. The operation is as follows:
+/// - the planes of the document are determined (a plane is given by the tile-coordinate of the level-0 tiles, where the
+///   M-index is not taken into account), together with their bounding box, resolution and pixel type
+/// - for each plane, the pyramid levels 1...N are created one after the other, where level L is created from level L-1
+/// - a pyramid level is covering the bounding box of the plane with a regular grid of output tiles (of the specified size
+///   in pixels, where the tiles at the right and the bottom edge may be smaller), and cells without source data are skipped
+/// - the output tiles are processed in batches: the source data is read (sequentially) from the document, then the source
+///   region is rendered and downscaled on a pool of threads, and finally the tiles are added to the document (within one
+///   transaction per batch)
+/// A pyramid level of a plane which already contains tiles is not modified. The output tiles are stored as uncompressed
+/// bitmaps.
+class PyramidGenerator
+{
+public:
+    /// The parameters for the pyramid generation.
+    struct Options
+    {
+        std::uint32_t minification_factor{ 2 };    ///< The factor by which the resolution decreases from one pyramid level to the next.
+        std::uint32_t number_of_levels{ 1 };       ///< The number of pyramid levels to create (i.e. the levels 1...number_of_levels are created).
+        std::uint32_t tile_width{ 1024 };          ///< The width of the output tiles in pixels.
+        std::uint32_t tile_height{ 1024 };         ///< The height of the output tiles in pixels.
+        std::uint32_t max_number_of_threads{ 0 };  ///< The maximal number of threads to use, where 0 means "use the number of hardware threads".
+        std::uint32_t tiles_per_batch{ 0 };        ///< The number of output tiles processed in one batch, where 0 means "twice the number of threads".
+    };
+private:
+    /// The information about a plane of the document.
+    struct PlaneInfo
+    {
+        std::vector<std::pair<imgdoc2::Dimension, int>> coordinate;  ///< The tile-coordinate of the plane (without the M-index, sorted by dimension).
+        bool has_m_index{ false };                  ///< True if the tiles of the plane have an M-index.
+        imgdoc2::RectangleD bounding_box;           ///< The bounding box of the level-0 tiles.
+        double logical_units_per_pixel{ 0 };        ///< The size of a level-0 pixel in the logical coordinate system.
+        std::uint8_t pixel_type{ imgdoc2::PixelType::Unknown };
+    };
+
+    std::shared_ptr<imgdoc2::IDocRead2d> reader_;
+    std::shared_ptr<imgdoc2::IDocWrite2d> writer_;
+public:
+    PyramidGenerator(std::shared_ptr<imgdoc2::IDocRead2d> reader, std::shared_ptr<imgdoc2::IDocWrite2d> writer);
+
+    /// Creates the pyramid levels. This method must not be called while a transaction is pending on the writer.
+    ///
+    /// \param  options The parameters of the operation.
+    void Generate(const Options& options);
+private:
+    static void ThrowIfOptionsInvalid(const Options& options);
+    std::vector<PlaneInfo> DeterminePlanes();
+    bool HasTilesOnPyramidLevel(const PlaneInfo& plane, int pyramid_level);
+    void GeneratePyramidLevel(const PlaneInfo& plane, int pyramid_level, const Options& options);
+    static imgdoc2::CDimCoordinateQueryClause CreatePlaneQueryClause(const PlaneInfo& plane);
+};
@@ -0,0 +1,485 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include "regioncompositor.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <sstream>
+#include "codecsAPI.h"
+#include "parallelexecution.h"
+
+using namespace std;
+using namespace imgdoc2;
+
+namespace
+{
+    /// A view of a (decoded) tile, together with its position in the logical coordinate system.
+    struct TileBitmapView
+    {
+        const uint8_t* data;
+        uint32_t pixel_width;
+        uint32_t pixel_height;
+        uint32_t stride;
+        double x;
+        double y;
+        double width;
+        double height;
+    };
+
+    bool LIBIMGDOC2_STDCALL AllocateWithMalloc(std::uint64_t size, AllocationObject* allocation_object)
+    {
+        allocation_object->pointer_to_memory = malloc(static_cast<size_t>(size));
+        allocation_object->handle = 0;
+        return allocation_object->pointer_to_memory != nullptr;
+    }
+
+    /// Determines the range of destination pixels (in one direction) whose centers are within the specified interval.
+    ///
+    /// \param          start           The start of the interval (in the logical coordinate system).
+    /// \param          extent          The extent of the interval.
+    /// \param          roi_start       The start of the region-of-interest.
+    /// \param          zoom            The zoom factor.
+    /// \param          range_start     The start of the allowed range of pixels.
+    /// \param          range_end       The end (exclusive) of the allowed range of pixels.
+    /// \param [out]    begin           The first pixel within the interval.
+    /// \param [out]    end             The end (exclusive) of the pixels within the interval.
+    void CalculateDestinationRange(double start, double extent, double roi_start, double zoom, uint32_t range_start, uint32_t range_end, int64_t& begin, int64_t& end)
+    {
+        begin = max(static_cast<int64_t>(range_start), static_cast<int64_t>(ceil((start - roi_start) * zoom - 0.5)));
+        end = min(static_cast<int64_t>(range_end), static_cast<int64_t>(ceil((start + extent - roi_start) * zoom - 0.5)));
+    }
+
+    /// Calculates, for each destination pixel (in one direction), the index of the source pixel(s) and the weight for
+    /// bilinear interpolation.
+    void CalculateSourceCoordinates(
+        int64_t begin,
+        int64_t end,
+        double roi_start,
+        double zoom,
+        double tile_start,
+        double tile_scale,
+        uint32_t tile_size,
+        bool bilinear,
+        vector<uint32_t>& index0,
+        vector<uint32_t>& index1,
+        vector<float>& weight)
+    {
+        const auto count = static_cast<size_t>(end - begin);
+        index0.resize(count);
+        index1.resize(count);
+        weight.resize(count);
+        const int64_t max_index = static_cast<int64_t>(tile_size) - 1;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const double logical = roi_start + (static_cast<double>(begin + static_cast<int64_t>(i)) + 0.5) / zoom;
+            const double source = (logical - tile_start) * tile_scale - 0.5;
+            if (bilinear)
+            {
+                const double source_floor = floor(source);
+                index0[i] = static_cast<uint32_t>(clamp(static_cast<int64_t>(source_floor), static_cast<int64_t>(0), max_index));
+                index1[i] = static_cast<uint32_t>(clamp(static_cast<int64_t>(source_floor) + 1, static_cast<int64_t>(0), max_index));
+                weight[i] = static_cast<float>(source - source_floor);
+            }
+            else
+            {
+                index0[i] = index1[i] = static_cast<uint32_t>(clamp(static_cast<int64_t>(floor(source + 0.5)), static_cast<int64_t>(0), max_index));
+                weight[i] = 0;
+            }
+        }
+    }
+
+    template <typename t_channel, int t_channels>
+    void PasteTileTyped(
+        const TileBitmapView& tile,
+        const RectangleD& roi,
+        double zoom_x,
+        double zoom_y,
+        bool bilinear,
+        const RegionCompositor::DestinationBitmap& destination,
+        uint32_t y_start,
+        uint32_t y_end)
+    {
+        int64_t x_begin, x_end, y_begin, y_stop;
+        CalculateDestinationRange(tile.x, tile.width, roi.x, zoom_x, 0, destination.width, x_begin, x_end);
+        CalculateDestinationRange(tile.y, tile.height, roi.y, zoom_y, y_start, y_end, y_begin, y_stop);
+        if (x_begin >= x_end || y_begin >= y_stop)
+        {
+            return;
+        }
+
+        vector<uint32_t> x_index0, x_index1, y_index0, y_index1;
+        vector<float> x_weight, y_weight;
+        CalculateSourceCoordinates(x_begin, x_end, roi.x, zoom_x, tile.x, tile.pixel_width / tile.width, tile.pixel_width, bilinear, x_index0, x_index1, x_weight);
+        CalculateSourceCoordinates(y_begin, y_stop, roi.y, zoom_y, tile.y, tile.pixel_height / tile.height, tile.pixel_height, bilinear, y_index0, y_index1, y_weight);
+
+        for (size_t y = 0; y < y_index0.size(); ++y)
+        {
+            const t_channel* source_line0 = reinterpret_cast<const t_channel*>(tile.data + static_cast<size_t>(y_index0[y]) * tile.stride);
+            const t_channel* source_line1 = reinterpret_cast<const t_channel*>(tile.data + static_cast<size_t>(y_index1[y]) * tile.stride);
+            t_channel* destination_line = reinterpret_cast<t_channel*>(static_cast<uint8_t*>(destination.data) + static_cast<size_t>(y_begin + y) * destination.stride) + x_begin * t_channels;
+            if (!bilinear)
+            {
+                for (size_t x = 0; x < x_index0.size(); ++x)
+                {
+                    const t_channel* source_pixel = source_line0 + static_cast<size_t>(x_index0[x]) * t_channels;
+                    for (int c = 0; c < t_channels; ++c)
+                    {
+                        *destination_line++ = source_pixel[c];
+                    }
+                }
+            }
+            else
+            {
+                const float wy = y_weight[y];
+                for (size_t x = 0; x < x_index0.size(); ++x)
+                {
+                    const float wx = x_weight[x];
+                    const t_channel* p00 = source_line0 + static_cast<size_t>(x_index0[x]) * t_channels;
+                    const t_channel* p01 = source_line0 + static_cast<size_t>(x_index1[x]) * t_channels;
+                    const t_channel* p10 = source_line1 + static_cast<size_t>(x_index0[x]) * t_channels;
+                    const t_channel* p11 = source_line1 + static_cast<size_t>(x_index1[x]) * t_channels;
+                    for (int c = 0; c < t_channels; ++c)
+                    {
+                        const double top = p00[c] + (static_cast<double>(p01[c]) - p00[c]) * wx;
+                        const double bottom = p10[c] + (static_cast<double>(p11[c]) - p10[c]) * wx;
+                        *destination_line++ = RenderingUtilities::ConvertFromDouble<t_channel>(top + (bottom - top) * wy);
+                    }
+                }
+            }
+        }
+    }
+}
+
+RegionCompositor::RegionCompositor(std::shared_ptr<imgdoc2::IDocRead2d> reader) : reader_(std::move(reader))
+{
+}
+
+void RegionCompositor::Compose(const imgdoc2::RectangleD& roi, const imgdoc2::IDimCoordinateQueryClause* plane_clause, const Options& options, const DestinationBitmap& destination)
+{
+    RegionCompositor::ThrowIfArgumentsInvalid(roi, options, destination);
+    auto prepared_composition = this->Prepare(roi, plane_clause, options, destination.width, destination.height);
+    RegionCompositor::Render(prepared_composition, destination);
+}
+
+RegionCompositor::PreparedComposition RegionCompositor::Prepare(const imgdoc2::RectangleD& roi, const imgdoc2::IDimCoordinateQueryClause* plane_clause, const Options& options, std::uint32_t destination_width, std::uint32_t destination_height)
+{
+    if (RenderingUtilities::GetBytesPerPixel(options.pixel_type) == 0)
+    {
+        throw invalid_argument_exception("The pixel type is not supported.");
+    }
+
+    if (!(roi.w > 0) || !(roi.h > 0) || destination_width == 0 || destination_height == 0)
+    {
+        throw invalid_argument_exception("The region-of-interest and the destination bitmap must not be empty.");
+    }
+
+    PreparedComposition prepared_composition;
+    prepared_composition.roi = roi;
+    prepared_composition.options = options;
+    prepared_composition.tiles = this->QueryTiles(roi, plane_clause, options, max(destination_width / roi.w, destination_height / roi.h));
+
+    // reading the data is done sequentially (since all reads go through the same database connection)
+    for (auto& tile : prepared_composition.tiles)
+    {
+        if (tile.blob_info.base_info.pixelType != options.pixel_type)
+        {
+            ostringstream string_stream;
+            string_stream << "The tile with pk=" << tile.pk << " has a pixel type different from the pixel type of the destination.";
+            throw invalid_operation_exception(string_stream.str().c_str());
+        }
+
+        if (options.decoded_bitmap_cache && RegionCompositor::IsCompressed(tile.blob_info.data_type))
+        {
+            const auto cached_bitmap = options.decoded_bitmap_cache->Get(DecodedBitmapCache::Key{ options.document_id_for_cache, tile.pk });
+            if (cached_bitmap)
+            {
+                tile.decoded_bitmap = shared_ptr<void>(cached_bitmap, cached_bitmap->data.get());
+                tile.bitmap = static_cast<const uint8_t*>(tile.decoded_bitmap.get());
+                tile.stride = cached_bitmap->stride;
+                continue;
+            }
+        }
+
+        if (tile.blob_info.data_type != DataTypes::ZERO)
+        {
+            tile.blob = make_unique<BlobOutputOnHeap>();
+            this->reader_->ReadTileData(tile.pk, tile.blob.get());
+        }
+    }
+
+    return prepared_composition;
+}
+
+/*static*/void RegionCompositor::Render(PreparedComposition& prepared_composition, const DestinationBitmap& destination)
+{
+    const auto& options = prepared_composition.options;
+    RegionCompositor::ThrowIfArgumentsInvalid(prepared_composition.roi, options, destination);
+
+    auto& tiles = prepared_composition.tiles;
+    const uint32_t number_of_threads = options.max_number_of_threads > 0 ? options.max_number_of_threads : ParallelExecution::GetDefaultNumberOfThreads();
+    ParallelExecution::Run(
+        number_of_threads,
+        tiles.size(),
+        [&tiles, &options](size_t index)->void
+        {
+            auto& tile = tiles[index];
+            if (tile.bitmap != nullptr)
+            {
+                // the decoded bitmap was taken from the cache
+                return;
+            }
+
+            const auto start_time = chrono::steady_clock::now();
+            RegionCompositor::DecodeTile(tile);
+            if (options.decoded_bitmap_cache && RegionCompositor::IsCompressed(tile.blob_info.data_type))
+            {
+                const auto bitmap = make_shared<DecodedBitmapCache::Bitmap>();
+                bitmap->pixel_type = tile.blob_info.base_info.pixelType;
+                bitmap->width = tile.blob_info.base_info.pixelWidth;
+                bitmap->height = tile.blob_info.base_info.pixelHeight;
+                bitmap->stride = tile.stride;
+                bitmap->data = tile.decoded_bitmap;
+                options.decoded_bitmap_cache->Add(DecodedBitmapCache::Key{ options.document_id_for_cache, tile.pk }, bitmap, chrono::steady_clock::now() - start_time);
+            }
+        });
+
+    RenderingUtilities::Fill(options.pixel_type, options.background_value, destination);
+
+    // the destination is divided into horizontal bands which are processed in parallel - within each band, the tiles
+    //  are drawn in order, so that the overlap order is honored
+    const uint32_t number_of_bands = min(destination.height, number_of_threads * 4);
+    ParallelExecution::Run(
+        number_of_threads,
+        number_of_bands,
+        [&](size_t band)->void
+        {
+            const auto y_start = static_cast<uint32_t>(static_cast<uint64_t>(destination.height) * band / number_of_bands);
+            const auto y_end = static_cast<uint32_t>(static_cast<uint64_t>(destination.height) * (band + 1) / number_of_bands);
+            RegionCompositor::PasteTiles(tiles, prepared_composition.roi, options, destination, y_start, y_end);
+        });
+}
+
+/*static*/void RegionCompositor::ThrowIfArgumentsInvalid(const imgdoc2::RectangleD& roi, const Options& options, const DestinationBitmap& destination)
+{
+    const uint8_t bytes_per_pixel = RenderingUtilities::GetBytesPerPixel(options.pixel_type);
+    if (bytes_per_pixel == 0)
+    {
+        throw invalid_argument_exception("The pixel type is not supported.");
+    }
+
+    if (destination.data == nullptr || destination.width == 0 || destination.height == 0)
+    {
+        throw invalid_argument_exception("The destination bitmap must not be empty.");
+    }
+
+    if (destination.stride < destination.width * bytes_per_pixel)
+    {
+        throw invalid_argument_exception("The stride of the destination bitmap is too small.");
+    }
+
+    if (!(roi.w > 0) || !(roi.h > 0))
+    {
+        throw invalid_argument_exception("The region-of-interest must not be empty.");
+    }
+}
+
+std::vector<RegionCompositor::TileToCompose> RegionCompositor::QueryTiles(const imgdoc2::RectangleD& roi, const imgdoc2::IDimCoordinateQueryClause* plane_clause, const Options& options, double zoom)
+{
+    CTileInfoQueryClause tile_info_query_clause;
+    if (options.pyramid_level.has_value())
+    {
+        tile_info_query_clause.AddPyramidLevelCondition(LogicalOperator::Invalid, ComparisonOperation::Equal, options.pyramid_level.value());
+    }
+
+    vector<dbIndex> indices;
+    this->reader_->GetTilesIntersectingRect(
+        roi,
+        plane_clause,
+        options.pyramid_level.has_value() ? &tile_info_query_clause : nullptr,
+        [&indices](dbIndex index)->bool
+        {
+            indices.push_back(index);
+            return true;
+        });
+
+    vector<TileToCompose> tiles;
+    tiles.reserve(indices.size());
+    map<int, double> scale_per_pyramid_level;
+    for (const auto index : indices)
+    {
+        TileToCompose tile;
+        tile.pk = index;
+        TileCoordinate tile_coordinate;
+        this->reader_->ReadTileInfo(index, &tile_coordinate, &tile.position, &tile.blob_info);
+        if (!(tile.position.width > 0) || !(tile.position.height > 0) ||
+            tile.blob_info.base_info.pixelWidth == 0 || tile.blob_info.base_info.pixelHeight == 0)
+        {
+            continue;
+        }
+
+        if (!tile_coordinate.TryGetCoordinate('M', &tile.m_index))
+        {
+            tile.m_index = 0;
+        }
+
+        scale_per_pyramid_level.emplace(tile.position.pyrLvl, tile.blob_info.base_info.pixelWidth / tile.position.width);
+        tiles.emplace_back(std::move(tile));
+    }
+
+    if (tiles.empty())
+    {
+        return tiles;
+    }
+
+    // choose the pyramid level with the lowest resolution which is still sufficient (or the one with the highest resolution)
+    int pyramid_level = scale_per_pyramid_level.cbegin()->first;
+    double pyramid_level_scale = scale_per_pyramid_level.cbegin()->second;
+    for (const auto& item : scale_per_pyramid_level)
+    {
+        const bool item_sufficient = item.second >= zoom * (1 - 1e-6);
+        const bool current_sufficient = pyramid_level_scale >= zoom * (1 - 1e-6);
+        if ((item_sufficient && (!current_sufficient || item.second < pyramid_level_scale)) ||
+            (!item_sufficient && !current_sufficient && item.second > pyramid_level_scale))
+        {
+            pyramid_level = item.first;
+            pyramid_level_scale = item.second;
+        }
+    }
+
+    tiles.erase(
+        remove_if(tiles.begin(), tiles.end(), [pyramid_level](const TileToCompose& tile)->bool { return tile.position.pyrLvl != pyramid_level; }),
+        tiles.end());
+    sort(
+        tiles.begin(),
+        tiles.end(),
+        [](const TileToCompose& a, const TileToCompose& b)->bool
+        {
+            return tie(a.m_index, a.pk) < tie(b.m_index, b.pk);
+        });
+    return tiles;
+}
+
+/*static*/bool RegionCompositor::IsCompressed(imgdoc2::DataTypes data_type)
+{
+    return data_type == DataTypes::JPGXRCOMPRESSED_BITMAP || data_type == DataTypes::ZSTD0COMPRESSED_BITMAP || data_type == DataTypes::ZSTD1COMPRESSED_BITMAP;
+}
+
+/*static*/void RegionCompositor::DecodeTile(TileToCompose& tile)
+{
+    const auto& base_info = tile.blob_info.base_info;
+    const uint32_t line_length = base_info.pixelWidth * RenderingUtilities::GetBytesPerPixel(base_info.pixelType);
+    switch (tile.blob_info.data_type)
+    {
+        case DataTypes::ZERO:
+            tile.decoded_bitmap = shared_ptr<void>(calloc(static_cast<size_t>(line_length) * base_info.pixelHeight, 1), free);
+            if (!tile.decoded_bitmap)
+            {
+                throw bad_alloc();
+            }
+
+            tile.bitmap = static_cast<const uint8_t*>(tile.decoded_bitmap.get());
+            tile.stride = line_length;
+            return;
+        case DataTypes::UNCOMPRESSED_BITMAP:
+            if (!tile.blob->GetHasData() || tile.blob->GetSizeOfData() < static_cast<size_t>(line_length) * base_info.pixelHeight)
+            {
+                ostringstream string_stream;
+                string_stream << "The data of the tile with pk=" << tile.pk << " is too small.";
+                throw invalid_operation_exception(string_stream.str().c_str());
+            }
+
+            tile.bitmap = tile.blob->GetDataC();
+            tile.stride = line_length;
+            return;
+        case DataTypes::JPGXRCOMPRESSED_BITMAP:
+        case DataTypes::ZSTD0COMPRESSED_BITMAP:
+        case DataTypes::ZSTD1COMPRESSED_BITMAP:
+        {
+            if (!tile.blob->GetHasData())
+            {
+                ostringstream string_stream;
+                string_stream << "The tile with pk=" << tile.pk << " has no data.";
+                throw invalid_operation_exception(string_stream.str().c_str());
+            }
+
+            const BitmapInfoInterop bitmap_info{ base_info.pixelType, base_info.pixelWidth, base_info.pixelHeight };
+            DecodedImageResultInterop decoded_image_result{};
+            ImgDoc2ErrorInformation error_information{};
+            const auto error_code = DecodeImage(
+                &bitmap_info,
+                static_cast<uint8_t>(tile.blob_info.data_type),
+                tile.blob->GetDataC(),
+                tile.blob->GetSizeOfData(),
+                0,
+                AllocateWithMalloc,
+                &decoded_image_result,
+                &error_information);
+            if (error_code != ImgDoc2_ErrorCode_OK)
+            {
+                ostringstream string_stream;
+                string_stream << "Decoding the tile with pk=" << tile.pk << " failed: " << error_information.message;
+                throw invalid_operation_exception(string_stream.str().c_str());
+            }
+
+            tile.decoded_bitmap = shared_ptr<void>(decoded_image_result.bitmap.pointer_to_memory, free);
+            tile.bitmap = static_cast<const uint8_t*>(tile.decoded_bitmap.get());
+            tile.stride = decoded_image_result.stride;
+
+            // we do not need the compressed data anymore
+            tile.blob.reset();
+            return;
+        }
+        default:
+        {
+            ostringstream string_stream;
+            string_stream << "The tile with pk=" << tile.pk << " has a data type which is not supported.";
+            throw invalid_operation_exception(string_stream.str().c_str());
+        }
+    }
+}
+
+/*static*/void RegionCompositor::PasteTiles(const std::vector<TileToCompose>& tiles, const imgdoc2::RectangleD& roi, const Options& options, const DestinationBitmap& destination, std::uint32_t y_start, std::uint32_t y_end)
+{
+    const double zoom_x = destination.width / roi.w;
+    const double zoom_y = destination.height / roi.h;
+    const bool bilinear = options.filter == ResamplingFilter::Bilinear;
+    for (const auto& tile : tiles)
+    {
+        const TileBitmapView view
+        {
+            tile.bitmap,
+            tile.blob_info.base_info.pixelWidth,
+            tile.blob_info.base_info.pixelHeight,
+            tile.stride,
+            tile.position.posX,
+            tile.position.posY,
+            tile.position.width,
+            tile.position.height
+        };
+
+        switch (options.pixel_type)
+        {
+            case PixelType::Gray8:
+                PasteTileTyped<uint8_t, 1>(view, roi, zoom_x, zoom_y, bilinear, destination, y_start, y_end);
+                break;
+            case PixelType::Gray16:
+                PasteTileTyped<uint16_t, 1>(view, roi, zoom_x, zoom_y, bilinear, destination, y_start, y_end);
+                break;
+            case PixelType::Bgr24:
+                PasteTileTyped<uint8_t, 3>(view, roi, zoom_x, zoom_y, bilinear, destination, y_start, y_end);
+                break;
+            case PixelType::Bgr48:
+                PasteTileTyped<uint16_t, 3>(view, roi, zoom_x, zoom_y, bilinear, destination, y_start, y_end);
+                break;
+            case PixelType::Gray32Float:
+                PasteTileTyped<float, 1>(view, roi, zoom_x, zoom_y, bilinear, destination, y_start, y_end);
+                break;
+            default:
+                throw invalid_argument_exception("The pixel type is not supported.");
+        }
+    }
+}
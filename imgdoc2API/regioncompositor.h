@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+#include <imgdoc2.h>
+#include "decodedbitmapcache.h"
+#include "renderingutilities.h"
+
+/// This class is rendering an arbitrary rectangle of a 2D-document into a bitmap, i.e. it implements the "query tiles, read,
+/// decode and paste"-loop. The operation is as follows:
+/// - the tiles intersecting the region-of-interest (and matching the "plane clause") are queried
+/// - the pyramid level is chosen - we choose the level with the lowest resolution which is still at least as high as the
+///   resolution of the destination bitmap (or the level with the highest resolution if there is no such level)
+/// - the tiles are read (sequentially) from the document, and then decoded in parallel
+/// - the tiles are resampled into the destination bitmap (using nearest-neighbor or bilinear interpolation), where
+///   the destination bitmap is divided into bands which are processed in parallel
+/// Tiles are drawn in the order of their M-index (if the document has an 'M'-dimension) and their primary key, so that
+/// a tile with a higher M-index is drawn on top of a tile with a lower M-index.
+/// The pixel type of the tiles must be identical to the pixel type of the destination bitmap.
+class RegionCompositor
+{
+public:
+    /// Values that represent the filter used for resampling the tiles.
+    enum class ResamplingFilter : std::uint8_t
+    {
+        NearestNeighbor = 0,    ///< Nearest neighbor interpolation.
+        Bilinear = 1            ///< Bilinear interpolation.
+    };
+
+    /// The parameters for the composition operation.
+    struct Options
+    {
+        std::uint8_t pixel_type{ imgdoc2::PixelType::Unknown };    ///< The pixel type of the destination bitmap (c.f. imgdoc2::PixelType).
+        double background_value{ 0 };                               ///< The value with which the destination is filled where there are no tiles.
+        ResamplingFilter filter{ ResamplingFilter::NearestNeighbor };   ///< The resampling filter.
+        std::uint32_t max_number_of_threads{ 0 };                   ///< The maximal number of threads to use, where 0 means "use the number of hardware threads".
+        std::optional<int> pyramid_level;                           ///< If set, only tiles on this pyramid level are used (instead of choosing the level automatically).
+        std::shared_ptr<DecodedBitmapCache> decoded_bitmap_cache;   ///< If non-null, decoded tiles are taken from (and added to) this cache, where tiles found in the cache are not read from the document.
+        std::uint64_t document_id_for_cache{ 0 };                   ///< The document-id under which the tiles of this document are stored in the decoded-bitmap-cache.
+    };
+
+    /// This structure describes the destination bitmap.
+    using DestinationBitmap = RenderingUtilities::Bitmap;
+
+    /// The information about a tile which is to be drawn into the destination.
+    struct TileToCompose
+    {
+        imgdoc2::dbIndex pk{ 0 };
+        int m_index{ 0 };
+        imgdoc2::LogicalPositionInfo position;
+        imgdoc2::TileBlobInfo blob_info;
+        std::unique_ptr<imgdoc2::BlobOutputOnHeap> blob;        ///< The data of the tile as read from the document.
+        std::shared_ptr<void> decoded_bitmap;                   ///< The decoded bitmap (if the tile had to be decoded).
+        const std::uint8_t* bitmap{ nullptr };                  ///< Pointer to the uncompressed bitmap (either into 'blob' or into 'decoded_bitmap').
+        std::uint32_t stride{ 0 };                              ///< The stride of the uncompressed bitmap.
+    };
+
+    /// The result of the "preparation phase" of a composition operation, i.e. the tiles which are to be drawn (with their
+    /// data already read from the document).
+    struct PreparedComposition
+    {
+        imgdoc2::RectangleD roi;
+        Options options;
+        std::vector<TileToCompose> tiles;
+    };
+private:
+    std::shared_ptr<imgdoc2::IDocRead2d> reader_;
+public:
+    explicit RegionCompositor(std::shared_ptr<imgdoc2::IDocRead2d> reader);
+
+    /// Renders the specified region-of-interest into the destination bitmap. The zoom factor is given by the ratio of
+    /// the size of the destination bitmap and the size of the region-of-interest. This is equivalent to calling "Prepare"
+    /// and then "Render".
+    ///
+    /// \param          roi             The region-of-interest (in the logical coordinate system of the document).
+    /// \param          plane_clause    If non-null, the dimension-clause selecting the plane.
+    /// \param          options         The parameters of the operation.
+    /// \param [out]    destination     The destination bitmap.
+    void Compose(const imgdoc2::RectangleD& roi, const imgdoc2::IDimCoordinateQueryClause* plane_clause, const Options& options, const DestinationBitmap& destination);
+
+    /// Executes the first phase of the composition operation - the tiles to be drawn are determined, and their data
+    /// is read from the document. This phase is accessing the document, so it must not be run concurrently with other
+    /// operations on the document.
+    ///
+    /// \param  roi                 The region-of-interest (in the logical coordinate system of the document).
+    /// \param  plane_clause        If non-null, the dimension-clause selecting the plane.
+    /// \param  options             The parameters of the operation.
+    /// \param  destination_width   The width of the destination bitmap in pixels.
+    /// \param  destination_height  The height of the destination bitmap in pixels.
+    ///
+    /// \returns    The prepared composition.
+    PreparedComposition Prepare(const imgdoc2::RectangleD& roi, const imgdoc2::IDimCoordinateQueryClause* plane_clause, const Options& options, std::uint32_t destination_width, std::uint32_t destination_height);
+
+    /// Executes the second phase of the composition operation - the tiles are decoded and drawn into the destination
+    /// bitmap. This phase is not accessing the document, so it can be run concurrently (for different compositions).
+    ///
+    /// \param [in,out] prepared_composition    The prepared composition.
+    /// \param [out]    destination             The destination bitmap (which must have the size given with "Prepare").
+    static void Render(PreparedComposition& prepared_composition, const DestinationBitmap& destination);
+
+    /// Decodes the data of the tile (if necessary), i.e. on return 'bitmap' and 'stride' of the tile are valid. This
+    /// operation is not accessing the document, so it can be run concurrently (for different tiles).
+    ///
+    /// \param [in,out] tile    The tile (with its data read from the document).
+    static void DecodeTile(TileToCompose& tile);
+private:
+    static bool IsCompressed(imgdoc2::DataTypes data_type);
+    static void ThrowIfArgumentsInvalid(const imgdoc2::RectangleD& roi, const Options& options, const DestinationBitmap& destination);
+    std::vector<TileToCompose> QueryTiles(const imgdoc2::RectangleD& roi, const imgdoc2::IDimCoordinateQueryClause* plane_clause, const Options& options, double zoom);
+    static void PasteTiles(const std::vector<TileToCompose>& tiles, const imgdoc2::RectangleD& roi, const Options& options, const DestinationBitmap& destination, std::uint32_t y_start, std::uint32_t y_end);
+};
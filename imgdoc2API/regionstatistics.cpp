@@ -0,0 +1,500 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include "regionstatistics.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <sstream>
+#include "parallelexecution.h"
+#include "pixelkernels.h"
+#include "regioncompositor.h"
+#include "renderingutilities.h"
+
+using namespace std;
+using namespace imgdoc2;
+
+/// The partial result accumulated by one thread. For Gray8 and Gray16, the histogram has one bin for each possible value;
+/// for Gray32Float, it is the histogram as requested, and the statistics are accumulated in 'float_statistics'.
+struct RegionStatistics::PartialResult
+{
+    vector<uint64_t> histogram;
+    PixelKernels::FloatStatistics float_statistics;
+    uint64_t number_of_pixels{ 0 };
+    double range_minimum{ 0 };
+    double bins_per_unit{ 0 };
+
+    explicit PartialResult(const Options& options)
+    {
+        switch (options.pixel_type)
+        {
+        case PixelType::Gray8:
+            this->histogram.resize(256);
+            break;
+        case PixelType::Gray16:
+            this->histogram.resize(65536);
+            break;
+        default:
+            this->histogram.resize(RegionStatistics::GetNumberOfBins(options));
+            this->range_minimum = options.range_minimum;
+            this->bins_per_unit = this->histogram.size() / (options.range_maximum - options.range_minimum);
+            break;
+        }
+    }
+
+    size_t GetBin(float value) const
+    {
+        const double bin = floor((value - this->range_minimum) * this->bins_per_unit);
+        return static_cast<size_t>(clamp(bin, 0.0, static_cast<double>(this->histogram.size() - 1)));
+    }
+};
+
+namespace
+{
+    /// A tile (of a 2D-document) to be analyzed, together with the range of its pixels within the region.
+    struct TileToAnalyze
+    {
+        RegionCompositor::TileToCompose tile;
+        array<uint32_t, 2> begin;
+        array<uint32_t, 2> end;
+    };
+
+    /// A brick (of a 3D-document) to be analyzed, together with the range of its voxels within the region.
+    struct BrickToAnalyze : RenderingUtilities::BrickData
+    {
+        dbIndex pk{ 0 };
+        LogicalPositionInfo3D position;
+        BrickBlobInfo blob_info;
+        array<uint32_t, 3> begin;
+        array<uint32_t, 3> end;
+    };
+
+    /// Determines the range of pixels (along one axis) whose centers are within the interval [start, end).
+    void CalculatePixelRange(double position, double extent, uint32_t number_of_pixels, double start, double end, uint32_t& begin_pixel, uint32_t& end_pixel)
+    {
+        const double pixels_per_unit = number_of_pixels / extent;
+        begin_pixel = static_cast<uint32_t>(clamp(ceil((start - position) * pixels_per_unit - 0.5), 0.0, static_cast<double>(number_of_pixels)));
+        end_pixel = static_cast<uint32_t>(clamp(ceil((end - position) * pixels_per_unit - 0.5), 0.0, static_cast<double>(number_of_pixels)));
+        end_pixel = max(begin_pixel, end_pixel);
+    }
+}
+
+RegionStatistics::RegionStatistics(std::shared_ptr<imgdoc2::IDocRead2d> reader) : reader2d_(std::move(reader))
+{
+}
+
+RegionStatistics::RegionStatistics(std::shared_ptr<imgdoc2::IDocRead3d> reader) : reader3d_(std::move(reader))
+{
+}
+
+RegionStatistics::Result RegionStatistics::Calculate(const imgdoc2::RectangleD& roi, const imgdoc2::IDimCoordinateQueryClause* plane_clause, const Options& options)
+{
+    RegionStatistics::ThrowIfOptionsInvalid(options);
+    if (!this->reader2d_)
+    {
+        throw invalid_operation_exception("The document is not a 2D-document.");
+    }
+
+    if (!(roi.w > 0) || !(roi.h > 0))
+    {
+        throw invalid_argument_exception("The region must not be empty.");
+    }
+
+    vector<dbIndex> indices;
+    this->reader2d_->GetTilesIntersectingRect(
+        roi,
+        plane_clause,
+        nullptr,
+        [&indices](dbIndex index)->bool
+        {
+            indices.push_back(index);
+            return true;
+        });
+
+    vector<TileToAnalyze> tiles;
+    map<int, uint64_t> number_of_pixels_per_pyramid_level;
+    for (const auto index : indices)
+    {
+        TileToAnalyze tile;
+        tile.tile.pk = index;
+        this->reader2d_->ReadTileInfo(index, nullptr, &tile.tile.position, &tile.tile.blob_info);
+        const auto& position = tile.tile.position;
+        const auto& base_info = tile.tile.blob_info.base_info;
+        if (!(position.width > 0) || !(position.height > 0) || base_info.pixelWidth == 0 || base_info.pixelHeight == 0)
+        {
+            continue;
+        }
+
+        CalculatePixelRange(position.posX, position.width, base_info.pixelWidth, roi.x, roi.x + roi.w, tile.begin[0], tile.end[0]);
+        CalculatePixelRange(position.posY, position.height, base_info.pixelHeight, roi.y, roi.y + roi.h, tile.begin[1], tile.end[1]);
+        const uint64_t number_of_pixels = static_cast<uint64_t>(tile.end[0] - tile.begin[0]) * (tile.end[1] - tile.begin[1]);
+        if (number_of_pixels > 0)
+        {
+            number_of_pixels_per_pyramid_level[position.pyrLvl] += number_of_pixels;
+            tiles.emplace_back(std::move(tile));
+        }
+    }
+
+    const int pyramid_level = RegionStatistics::ChoosePyramidLevel(number_of_pixels_per_pyramid_level, options);
+    tiles.erase(
+        remove_if(tiles.begin(), tiles.end(), [pyramid_level](const TileToAnalyze& tile)->bool { return tile.tile.position.pyrLvl != pyramid_level; }),
+        tiles.end());
+    sort(tiles.begin(), tiles.end(), [](const TileToAnalyze& a, const TileToAnalyze& b)->bool { return a.tile.pk < b.tile.pk; });
+
+    const uint32_t number_of_threads = options.max_number_of_threads > 0 ? options.max_number_of_threads : ParallelExecution::GetDefaultNumberOfThreads();
+    vector<PartialResult> partial_results(number_of_threads, PartialResult(options));
+    const uint8_t bytes_per_pixel = RenderingUtilities::GetBytesPerPixel(options.pixel_type);
+    size_t next_tile = 0;
+    while (next_tile < tiles.size())
+    {
+        // reading the data is done sequentially (since all reads go through the same database connection)
+        const size_t first_tile = next_tile;
+        uint64_t size_of_batch = 0;
+        while (next_tile < tiles.size() && size_of_batch < options.max_memory_for_data)
+        {
+            auto& tile = tiles[next_tile++].tile;
+            if (tile.blob_info.base_info.pixelType != options.pixel_type)
+            {
+                ostringstream string_stream;
+                string_stream << "The tile with pk=" << tile.pk << " has a pixel type different from the pixel type given for the statistics.";
+                throw invalid_operation_exception(string_stream.str().c_str());
+            }
+
+            if (tile.blob_info.data_type != DataTypes::ZERO)
+            {
+                tile.blob = make_unique<BlobOutputOnHeap>();
+                this->reader2d_->ReadTileData(tile.pk, tile.blob.get());
+                size_of_batch += tile.blob->GetSizeOfData();
+            }
+        }
+
+        ParallelExecution::RunWithThreadIndex(
+            number_of_threads,
+            next_tile - first_tile,
+            [&](uint32_t thread_index, size_t index)->void
+            {
+                auto& tile_to_analyze = tiles[first_tile + index];
+                auto& tile = tile_to_analyze.tile;
+                const uint32_t width = tile_to_analyze.end[0] - tile_to_analyze.begin[0];
+                const uint32_t height = tile_to_analyze.end[1] - tile_to_analyze.begin[1];
+                if (tile.blob_info.data_type == DataTypes::ZERO)
+                {
+                    RegionStatistics::AccumulateZeros(options, static_cast<uint64_t>(width) * height, partial_results[thread_index]);
+                    return;
+                }
+
+                RegionCompositor::DecodeTile(tile);
+                RegionStatistics::AccumulateBitmap(
+                    options,
+                    tile.bitmap + static_cast<size_t>(tile_to_analyze.begin[1]) * tile.stride + static_cast<size_t>(tile_to_analyze.begin[0]) * bytes_per_pixel,
+                    tile.stride,
+                    width,
+                    height,
+                    partial_results[thread_index]);
+
+                // release the memory as soon as possible
+                tile.bitmap = nullptr;
+                tile.decoded_bitmap.reset();
+                tile.blob.reset();
+            });
+    }
+
+    return RegionStatistics::CreateResult(partial_results, options, pyramid_level);
+}
+
+RegionStatistics::Result RegionStatistics::Calculate(const imgdoc2::CuboidD& roi, const imgdoc2::IDimCoordinateQueryClause* plane_clause, const Options& options)
+{
+    RegionStatistics::ThrowIfOptionsInvalid(options);
+    if (!this->reader3d_)
+    {
+        throw invalid_operation_exception("The document is not a 3D-document.");
+    }
+
+    if (!(roi.w > 0) || !(roi.h > 0) || !(roi.d > 0))
+    {
+        throw invalid_argument_exception("The region must not be empty.");
+    }
+
+    vector<dbIndex> indices;
+    this->reader3d_->GetTilesIntersectingCuboid(
+        roi,
+        plane_clause,
+        nullptr,
+        [&indices](dbIndex index)->bool
+        {
+            indices.push_back(index);
+            return true;
+        });
+
+    vector<BrickToAnalyze> bricks;
+    map<int, uint64_t> number_of_pixels_per_pyramid_level;
+    const array<double, 3> roi_start{ roi.x, roi.y, roi.z };
+    const array<double, 3> roi_end{ roi.x + roi.w, roi.y + roi.h, roi.z + roi.d };
+    for (const auto index : indices)
+    {
+        BrickToAnalyze brick;
+        brick.pk = index;
+        this->reader3d_->ReadBrickInfo(index, nullptr, &brick.position, &brick.blob_info);
+        const array<double, 3> position{ brick.position.posX, brick.position.posY, brick.position.posZ };
+        const array<double, 3> extent{ brick.position.width, brick.position.height, brick.position.depth };
+        const array<uint32_t, 3> brick_size{ brick.blob_info.base_info.pixelWidth, brick.blob_info.base_info.pixelHeight, brick.blob_info.base_info.pixelDepth };
+        uint64_t number_of_voxels = 1;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            if (!(extent[axis] > 0) || brick_size[axis] == 0)
+            {
+                number_of_voxels = 0;
+                break;
+            }
+
+            CalculatePixelRange(position[axis], extent[axis], brick_size[axis], roi_start[axis], roi_end[axis], brick.begin[axis], brick.end[axis]);
+            number_of_voxels *= brick.end[axis] - brick.begin[axis];
+        }
+
+        if (number_of_voxels > 0)
+        {
+            number_of_pixels_per_pyramid_level[brick.position.pyrLvl] += number_of_voxels;
+            bricks.emplace_back(std::move(brick));
+        }
+    }
+
+    const int pyramid_level = RegionStatistics::ChoosePyramidLevel(number_of_pixels_per_pyramid_level, options);
+    bricks.erase(
+        remove_if(bricks.begin(), bricks.end(), [pyramid_level](const BrickToAnalyze& brick)->bool { return brick.position.pyrLvl != pyramid_level; }),
+        bricks.end());
+    sort(bricks.begin(), bricks.end(), [](const BrickToAnalyze& a, const BrickToAnalyze& b)->bool { return a.pk < b.pk; });
+
+    const uint32_t number_of_threads = options.max_number_of_threads > 0 ? options.max_number_of_threads : ParallelExecution::GetDefaultNumberOfThreads();
+    vector<PartialResult> partial_results(number_of_threads, PartialResult(options));
+    const uint8_t bytes_per_pixel = RenderingUtilities::GetBytesPerPixel(options.pixel_type);
+    size_t next_brick = 0;
+    while (next_brick < bricks.size())
+    {
+        const size_t first_brick = next_brick;
+        uint64_t size_of_batch = 0;
+        while (next_brick < bricks.size() && size_of_batch < options.max_memory_for_data)
+        {
+            auto& brick = bricks[next_brick++];
+            const auto& base_info = brick.blob_info.base_info;
+            if (base_info.pixelType != options.pixel_type)
+            {
+                ostringstream string_stream;
+                string_stream << "The brick with pk=" << brick.pk << " has a pixel type different from the pixel type given for the statistics.";
+                throw invalid_operation_exception(string_stream.str().c_str());
+            }
+
+            // bricks of data type "ZERO" are accounted for without any data
+            if (brick.blob_info.data_type != DataTypes::ZERO)
+            {
+                const array<uint32_t, 3> size{ brick.end[0] - brick.begin[0], brick.end[1] - brick.begin[1], brick.end[2] - brick.begin[2] };
+                RenderingUtilities::LoadBrickData(this->reader3d_.get(), brick.pk, brick.blob_info, brick.begin, size, "calculating statistics", brick);
+                size_of_batch += brick.size_of_data;
+            }
+        }
+
+        ParallelExecution::RunWithThreadIndex(
+            number_of_threads,
+            next_brick - first_brick,
+            [&](uint32_t thread_index, size_t index)->void
+            {
+                auto& brick = bricks[first_brick + index];
+                const uint32_t width = brick.end[0] - brick.begin[0];
+                const uint32_t height = brick.end[1] - brick.begin[1];
+                if (brick.blob_info.data_type == DataTypes::ZERO)
+                {
+                    RegionStatistics::AccumulateZeros(options, static_cast<uint64_t>(width) * height * (brick.end[2] - brick.begin[2]), partial_results[thread_index]);
+                    return;
+                }
+
+                // each z-plane of the sub-volume within the region is analyzed as a bitmap
+                const size_t line_stride = static_cast<size_t>(brick.size[0]) * bytes_per_pixel;
+                const size_t plane_stride = line_stride * brick.size[1];
+                for (uint32_t z = brick.begin[2]; z < brick.end[2]; ++z)
+                {
+                    RegionStatistics::AccumulateBitmap(
+                        options,
+                        brick.data + (z - brick.offset[2]) * plane_stride + (brick.begin[1] - brick.offset[1]) * line_stride + static_cast<size_t>(brick.begin[0] - brick.offset[0]) * bytes_per_pixel,
+                        static_cast<uint32_t>(line_stride),
+                        width,
+                        height,
+                        partial_results[thread_index]);
+                }
+
+                brick.blob.reset();
+            });
+    }
+
+    return RegionStatistics::CreateResult(partial_results, options, pyramid_level);
+}
+
+/*static*/std::uint32_t RegionStatistics::GetNumberOfBins(const Options& options)
+{
+    if (options.number_of_bins > 0)
+    {
+        return options.number_of_bins;
+    }
+
+    return options.pixel_type == PixelType::Gray16 ? 65536 : 256;
+}
+
+/*static*/void RegionStatistics::ThrowIfOptionsInvalid(const Options& options)
+{
+    switch (options.pixel_type)
+    {
+    case PixelType::Gray8:
+    case PixelType::Gray16:
+        break;
+    case PixelType::Gray32Float:
+        if (!(options.range_maximum > options.range_minimum) || !isfinite(options.range_maximum - options.range_minimum))
+        {
+            throw invalid_argument_exception("For the pixel type Gray32Float, the range of the histogram must be specified.");
+        }
+
+        break;
+    default:
+        throw invalid_argument_exception("The pixel type is not supported.");
+    }
+}
+
+/*static*/int RegionStatistics::ChoosePyramidLevel(const std::map<int, std::uint64_t>& number_of_pixels_per_pyramid_level, const Options& options)
+{
+    if (options.max_number_of_pixels == 0 || number_of_pixels_per_pyramid_level.empty())
+    {
+        return 0;
+    }
+
+    // choose the pyramid level with the highest resolution which does not exceed the given number of pixels (or the one
+    //  with the lowest number of pixels)
+    int pyramid_level = number_of_pixels_per_pyramid_level.cbegin()->first;
+    uint64_t number_of_pixels = number_of_pixels_per_pyramid_level.cbegin()->second;
+    for (const auto& item : number_of_pixels_per_pyramid_level)
+    {
+        if (item.second <= options.max_number_of_pixels)
+        {
+            return item.first;
+        }
+
+        if (item.second < number_of_pixels)
+        {
+            pyramid_level = item.first;
+            number_of_pixels = item.second;
+        }
+    }
+
+    return pyramid_level;
+}
+
+/*static*/void RegionStatistics::AccumulateBitmap(const Options& options, const std::uint8_t* data, std::uint32_t stride, std::uint32_t width, std::uint32_t height, PartialResult& partial_result)
+{
+    partial_result.number_of_pixels += static_cast<uint64_t>(width) * height;
+    if (options.pixel_type != PixelType::Gray32Float)
+    {
+        PixelKernels::AccumulateHistogram(options.pixel_type, data, stride, width, height, partial_result.histogram.data());
+        return;
+    }
+
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        const float* line = reinterpret_cast<const float*>(data + static_cast<size_t>(y) * stride);
+        PixelKernels::AccumulateStatistics(line, width, partial_result.float_statistics);
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            ++partial_result.histogram[partial_result.GetBin(line[x])];
+        }
+    }
+}
+
+/*static*/void RegionStatistics::AccumulateZeros(const Options& options, std::uint64_t count, PartialResult& partial_result)
+{
+    partial_result.number_of_pixels += count;
+    if (options.pixel_type != PixelType::Gray32Float)
+    {
+        partial_result.histogram[0] += count;
+        return;
+    }
+
+    partial_result.histogram[partial_result.GetBin(0)] += count;
+    partial_result.float_statistics.minimum = min(partial_result.float_statistics.minimum, 0.f);
+    partial_result.float_statistics.maximum = max(partial_result.float_statistics.maximum, 0.f);
+}
+
+/*static*/RegionStatistics::Result RegionStatistics::CreateResult(const std::vector<PartialResult>& partial_results, const Options& options, int pyramid_level)
+{
+    Result result;
+    result.pyramid_level = pyramid_level;
+    const uint32_t number_of_bins = RegionStatistics::GetNumberOfBins(options);
+    result.histogram.resize(number_of_bins);
+    vector<uint64_t> histogram(partial_results.front().histogram.size());
+    for (const auto& partial_result : partial_results)
+    {
+        for (size_t i = 0; i < histogram.size(); ++i)
+        {
+            histogram[i] += partial_result.histogram[i];
+        }
+    }
+
+    double sum = 0;
+    double sum_of_squares = 0;
+    if (options.pixel_type == PixelType::Gray32Float)
+    {
+        PixelKernels::FloatStatistics statistics;
+        for (const auto& partial_result : partial_results)
+        {
+            result.number_of_pixels += partial_result.number_of_pixels;
+            statistics.minimum = min(statistics.minimum, partial_result.float_statistics.minimum);
+            statistics.maximum = max(statistics.maximum, partial_result.float_statistics.maximum);
+            statistics.sum += partial_result.float_statistics.sum;
+            statistics.sum_of_squares += partial_result.float_statistics.sum_of_squares;
+        }
+
+        result.minimum = statistics.minimum;
+        result.maximum = statistics.maximum;
+        sum = statistics.sum;
+        sum_of_squares = statistics.sum_of_squares;
+        result.range_minimum = options.range_minimum;
+        result.range_maximum = options.range_maximum;
+        result.histogram = std::move(histogram);
+    }
+    else
+    {
+        // the statistics are determined from the histogram (which has one bin for each possible value), and then the
+        //  histogram with the requested number of bins is derived from it
+        const bool has_range = options.range_maximum > options.range_minimum;
+        result.range_minimum = has_range ? options.range_minimum : 0;
+        result.range_maximum = has_range ? options.range_maximum : static_cast<double>(histogram.size());
+        const double bins_per_unit = number_of_bins / (result.range_maximum - result.range_minimum);
+        bool is_first = true;
+        for (size_t value = 0; value < histogram.size(); ++value)
+        {
+            const uint64_t count = histogram[value];
+            if (count == 0)
+            {
+                continue;
+            }
+
+            if (is_first)
+            {
+                result.minimum = static_cast<double>(value);
+                is_first = false;
+            }
+
+            result.maximum = static_cast<double>(value);
+            result.number_of_pixels += count;
+            sum += static_cast<double>(value) * count;
+            sum_of_squares += static_cast<double>(value) * value * count;
+            const double bin = floor((value - result.range_minimum) * bins_per_unit);
+            result.histogram[static_cast<size_t>(clamp(bin, 0.0, static_cast<double>(number_of_bins - 1)))] += count;
+        }
+    }
+
+    if (result.number_of_pixels == 0)
+    {
+        result.minimum = result.maximum = 0;
+        return result;
+    }
+
+    result.mean = sum / result.number_of_pixels;
+    result.standard_deviation = sqrt(max(0.0, sum_of_squares / result.number_of_pixels - result.mean * result.mean));
+    return result;
+}
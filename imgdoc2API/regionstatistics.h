@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+#include <imgdoc2.h>
+
+/// This class is calculating the histogram and basic statistics (minimum, maximum, mean and standard deviation) of the
+/// pixels within a rectangle of a 2D-document or the voxels within a cuboid of a 3D-document. A pixel (or voxel) is taken
+/// into account if its center is within the region. The operation is as follows:
+/// - the tiles (or bricks) intersecting the region (and matching the "plane clause") are queried
+/// - the pyramid level is chosen - it is the level 0 unless an approximation is acceptable (i.e. "max_number_of_pixels" is
+///   given), in which case the level with the highest resolution having at most this number of pixels within the region
+///   is chosen
+/// - the tiles are processed in batches, where the size of a batch is limited by the amount of memory for the data - the
+///   data of the tiles of a batch is read (sequentially) from the document, and then the tiles are decoded and analyzed in
+///   parallel, where each thread is accumulating into its own partial result
+/// - finally, the partial results are merged
+/// For Gray8 and Gray16, the partial results are histograms with one bin for each possible value (so the statistics are
+/// exact), and the histogram with the requested number of bins is derived from it. For Gray32Float, the statistics are
+/// accumulated directly, and the range of the histogram must be specified. Values outside of the range of the histogram
+/// are counted in the first or the last bin respectively. Note that pixels in regions where tiles overlap are counted
+/// once for each tile.
+class RegionStatistics
+{
+public:
+    /// The parameters for the operation.
+    struct Options
+    {
+        std::uint8_t pixel_type{ imgdoc2::PixelType::Unknown };        ///< The pixel type of the tiles (c.f. imgdoc2::PixelType) - Gray8, Gray16 and Gray32Float are supported.
+        std::uint32_t number_of_bins{ 0 };                              ///< The number of bins of the histogram, where 0 means "256 for Gray8 and Gray32Float, and 65536 for Gray16".
+        double range_minimum{ 0 };                                      ///< The lower bound of the range covered by the histogram.
+        double range_maximum{ 0 };                                      ///< The upper bound of the range covered by the histogram - if not greater than range_minimum, the range of the pixel type is used (which is not possible for Gray32Float).
+        std::uint64_t max_number_of_pixels{ 0 };                        ///< If non-zero, a pyramid level with at most this number of pixels within the region may be used (giving an approximation).
+        std::uint32_t max_number_of_threads{ 0 };                       ///< The maximal number of threads to use, where 0 means "use the number of hardware threads".
+        std::uint64_t max_memory_for_data{ 256 * 1024 * 1024 };         ///< The (approximate) maximal amount of memory (in bytes) for the tile data read from the document at a time.
+    };
+
+    /// The result of the operation. If there are no pixels within the region, the statistics are zero.
+    struct Result
+    {
+        int pyramid_level{ 0 };                 ///< The pyramid level which was used.
+        std::uint64_t number_of_pixels{ 0 };    ///< The number of pixels which were analyzed.
+        double minimum{ 0 };                    ///< The minimum of the pixel values.
+        double maximum{ 0 };                    ///< The maximum of the pixel values.
+        double mean{ 0 };                       ///< The mean of the pixel values.
+        double standard_deviation{ 0 };         ///< The (population) standard deviation of the pixel values.
+        double range_minimum{ 0 };              ///< The lower bound of the range covered by the histogram.
+        double range_maximum{ 0 };              ///< The upper bound of the range covered by the histogram.
+        std::vector<std::uint64_t> histogram;   ///< The histogram, where the bin i is covering the values [range_minimum + i * bin_width, range_minimum + (i + 1) * bin_width).
+    };
+private:
+    struct PartialResult;
+
+    std::shared_ptr<imgdoc2::IDocRead2d> reader2d_;
+    std::shared_ptr<imgdoc2::IDocRead3d> reader3d_;
+public:
+    explicit RegionStatistics(std::shared_ptr<imgdoc2::IDocRead2d> reader);
+    explicit RegionStatistics(std::shared_ptr<imgdoc2::IDocRead3d> reader);
+
+    /// Calculates the statistics of the pixels within the specified rectangle of a 2D-document.
+    ///
+    /// \param  roi             The region (in the logical coordinate system).
+    /// \param  plane_clause    If non-null, the dimension-clause selecting the plane.
+    /// \param  options         The parameters of the operation.
+    ///
+    /// \returns    The result.
+    Result Calculate(const imgdoc2::RectangleD& roi, const imgdoc2::IDimCoordinateQueryClause* plane_clause, const Options& options);
+
+    /// Calculates the statistics of the voxels within the specified cuboid of a 3D-document.
+    ///
+    /// \param  roi             The region (in the logical coordinate system).
+    /// \param  plane_clause    If non-null, the dimension-clause selecting the plane (i.e. the non-spatial coordinates).
+    /// \param  options         The parameters of the operation.
+    ///
+    /// \returns    The result.
+    Result Calculate(const imgdoc2::CuboidD& roi, const imgdoc2::IDimCoordinateQueryClause* plane_clause, const Options& options);
+
+    /// Gets the number of bins of the histogram, which is the number given with the options or the default for the pixel type.
+    ///
+    /// \param  options The options.
+    ///
+    /// \returns    The number of bins.
+    static std::uint32_t GetNumberOfBins(const Options& options);
+private:
+    static void ThrowIfOptionsInvalid(const Options& options);
+    static int ChoosePyramidLevel(const std::map<int, std::uint64_t>& number_of_pixels_per_pyramid_level, const Options& options);
+    static void AccumulateBitmap(const Options& options, const std::uint8_t* data, std::uint32_t stride, std::uint32_t width, std::uint32_t height, PartialResult& partial_result);
+    static void AccumulateZeros(const Options& options, std::uint64_t count, PartialResult& partial_result);
+    static Result CreateResult(const std::vector<PartialResult>& partial_results, const Options& options, int pyramid_level);
+};
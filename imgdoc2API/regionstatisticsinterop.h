@@ -0,0 +1,25 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+
+#pragma pack(push, 4)
+
+/// This struct contains the statistics of a region as determined by the 'IDocRead2d_CalculateStatistics'- and
+/// 'IDocRead3d_CalculateStatistics'-APIs.
+struct RegionStatisticsInterop
+{
+    std::uint64_t number_of_pixels;     ///< The number of pixels (or voxels) which were analyzed.
+    double minimum;                     ///< The minimum of the pixel values.
+    double maximum;                     ///< The maximum of the pixel values.
+    double mean;                        ///< The mean of the pixel values.
+    double standard_deviation;          ///< The (population) standard deviation of the pixel values.
+    double histogram_range_minimum;     ///< The lower bound of the range covered by the histogram.
+    double histogram_range_maximum;     ///< The upper bound of the range covered by the histogram.
+    std::int32_t pyramid_level;         ///< The pyramid level which was used.
+};
+
+#pragma pack(pop)
@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include "renderingutilities.h"
+#include <sstream>
+
+using namespace std;
+using namespace imgdoc2;
+
+namespace
+{
+    template <typename t_channel, int t_channels>
+    void FillTyped(double value, const RenderingUtilities::Bitmap& bitmap)
+    {
+        const t_channel channel_value = RenderingUtilities::ConvertFromDouble<t_channel>(value);
+        for (uint32_t y = 0; y < bitmap.height; ++y)
+        {
+            t_channel* line = reinterpret_cast<t_channel*>(static_cast<uint8_t*>(bitmap.data) + static_cast<size_t>(y) * bitmap.stride);
+            fill(line, line + static_cast<size_t>(bitmap.width) * t_channels, channel_value);
+        }
+    }
+}
+
+/*static*/void RenderingUtilities::Fill(std::uint8_t pixel_type, double value, const Bitmap& bitmap)
+{
+    switch (pixel_type)
+    {
+    case PixelType::Gray8:
+        FillTyped<uint8_t, 1>(value, bitmap);
+        break;
+    case PixelType::Gray16:
+        FillTyped<uint16_t, 1>(value, bitmap);
+        break;
+    case PixelType::Bgr24:
+        FillTyped<uint8_t, 3>(value, bitmap);
+        break;
+    case PixelType::Bgr48:
+        FillTyped<uint16_t, 3>(value, bitmap);
+        break;
+    case PixelType::Gray32Float:
+        FillTyped<float, 1>(value, bitmap);
+        break;
+    default:
+        throw invalid_argument_exception("The pixel type is not supported.");
+    }
+}
+
+/*static*/void RenderingUtilities::LoadBrickData(imgdoc2::IDocRead3d* reader, imgdoc2::dbIndex pk, const imgdoc2::BrickBlobInfo& blob_info, const std::array<std::uint32_t, 3>& offset, const std::array<std::uint32_t, 3>& size, const char* operation_name, BrickData& brick_data)
+{
+    const auto& base_info = blob_info.base_info;
+    const uint8_t bytes_per_pixel = RenderingUtilities::GetBytesPerPixel(base_info.pixelType);
+    switch (blob_info.data_type)
+    {
+    case DataTypes::ZERO:
+        brick_data.offset = offset;
+        brick_data.size = size;
+        brick_data.zero_data.resize(static_cast<size_t>(size[0]) * size[1] * size[2] * bytes_per_pixel);
+        brick_data.data = brick_data.zero_data.data();
+        brick_data.size_of_data = brick_data.zero_data.size();
+        break;
+    case DataTypes::UNCOMPRESSED_BRICK:
+        brick_data.blob = make_unique<BlobOutputOnHeap>();
+        reader->ReadBrickData(pk, brick_data.blob.get());
+        if (!brick_data.blob->GetHasData() || brick_data.blob->GetSizeOfData() < static_cast<size_t>(base_info.pixelWidth) * base_info.pixelHeight * base_info.pixelDepth * bytes_per_pixel)
+        {
+            ostringstream string_stream;
+            string_stream << "The data of the brick with pk=" << pk << " is too small.";
+            throw invalid_operation_exception(string_stream.str().c_str());
+        }
+
+        brick_data.offset = { 0, 0, 0 };
+        brick_data.size = { base_info.pixelWidth, base_info.pixelHeight, base_info.pixelDepth };
+        brick_data.data = brick_data.blob->GetDataC();
+        brick_data.size_of_data = brick_data.blob->GetSizeOfData();
+        break;
+    case DataTypes::UNCOMPRESSED_CHUNKED_BRICK:
+        brick_data.blob = make_unique<BlobOutputOnHeap>();
+        reader->ReadBrickSubVolume(
+            pk,
+            CuboidI(
+                static_cast<int32_t>(offset[0]), static_cast<int32_t>(offset[1]), static_cast<int32_t>(offset[2]),
+                static_cast<int32_t>(size[0]), static_cast<int32_t>(size[1]), static_cast<int32_t>(size[2])),
+            brick_data.blob.get());
+        brick_data.offset = offset;
+        brick_data.size = size;
+        brick_data.data = brick_data.blob->GetDataC();
+        brick_data.size_of_data = brick_data.blob->GetSizeOfData();
+        break;
+    default:
+    {
+        ostringstream string_stream;
+        string_stream << "The brick with pk=" << pk << " has a data type which is not supported for " << operation_name << ".";
+        throw invalid_operation_exception(string_stream.str().c_str());
+    }
+    }
+}
+
+/*static*/std::uint8_t RenderingUtilities::GetBytesPerPixel(std::uint8_t pixel_type)
+{
+    switch (pixel_type)
+    {
+    case PixelType::Gray8:
+        return 1;
+    case PixelType::Gray16:
+        return 2;
+    case PixelType::Bgr24:
+        return 3;
+    case PixelType::Bgr48:
+        return 6;
+    case PixelType::Gray32Float:
+        return 4;
+    default:
+        return 0;
+    }
+}
@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include <imgdoc2.h>
+
+/// Utilities shared by the operations which are rendering (or analyzing) the pixels of a document, i.e. the region
+/// compositor, the plane-slice renderer, the volume projector and the region statistics.
+class RenderingUtilities
+{
+public:
+    /// This structure describes a bitmap (in memory) - it is used for the destination of the rendering operations.
+    struct Bitmap
+    {
+        void* data{ nullptr };          ///< Pointer to the bitmap data.
+        std::uint32_t width{ 0 };       ///< The width of the bitmap in pixels.
+        std::uint32_t height{ 0 };      ///< The height of the bitmap in pixels.
+        std::uint32_t stride{ 0 };      ///< The stride of the bitmap in bytes.
+    };
+
+    /// The voxel data of a brick (or of a sub-volume of it) as loaded with "LoadBrickData".
+    struct BrickData
+    {
+        std::array<std::uint32_t, 3> offset{};              ///< The offset of the sub-volume held in 'data' (in voxels).
+        std::array<std::uint32_t, 3> size{};                ///< The size of the sub-volume held in 'data' (in voxels).
+        std::unique_ptr<imgdoc2::BlobOutputOnHeap> blob;    ///< The data as read from the document.
+        std::vector<std::uint8_t> zero_data;                ///< For a brick of data type "ZERO", the (zero-filled) data of the sub-volume.
+        const std::uint8_t* data{ nullptr };                ///< Pointer to the voxel data of the sub-volume (either into 'blob' or into 'zero_data').
+        size_t size_of_data{ 0 };                           ///< The size of the voxel data in bytes.
+    };
+
+    /// Converts a value to the specified channel type - for integer types, the value is rounded to nearest and clamped to the
+    /// range of the type.
+    ///
+    /// \tparam t_channel   The type of a channel of a pixel.
+    /// \param  value       The value.
+    ///
+    /// \returns    The converted value.
+    template <typename t_channel>
+    static t_channel ConvertFromDouble(double value)
+    {
+        if constexpr (std::is_integral_v<t_channel>)
+        {
+            return static_cast<t_channel>(std::clamp(std::floor(value + 0.5), static_cast<double>(std::numeric_limits<t_channel>::min()), static_cast<double>(std::numeric_limits<t_channel>::max())));
+        }
+        else
+        {
+            return static_cast<t_channel>(value);
+        }
+    }
+
+    /// Fills all channels of all pixels of the bitmap with the specified value (which is converted with "ConvertFromDouble").
+    ///
+    /// \param          pixel_type  The pixel type (c.f. imgdoc2::PixelType) of the bitmap.
+    /// \param          value       The value.
+    /// \param [out]    bitmap      The bitmap.
+    static void Fill(std::uint8_t pixel_type, double value, const Bitmap& bitmap);
+
+    /// Loads the voxel data of the specified sub-volume of a brick. For a brick of data type "UNCOMPRESSED_BRICK", the whole
+    /// blob has to be read anyway, so it is used directly (instead of copying the sub-volume) - in this case, the sub-volume
+    /// reported in 'brick_data' is the whole brick. For a chunked brick, only the requested sub-volume is read, and for a brick
+    /// of data type "ZERO", a zero-filled buffer for the sub-volume is allocated.
+    ///
+    /// \param          reader          The reader object.
+    /// \param          pk              The primary key of the brick.
+    /// \param          blob_info       The blob-information of the brick.
+    /// \param          offset          The offset of the sub-volume (in voxels).
+    /// \param          size            The size of the sub-volume (in voxels).
+    /// \param          operation_name  The name of the operation (used for the error message if the data type is not supported).
+    /// \param [out]    brick_data      The voxel data.
+    static void LoadBrickData(imgdoc2::IDocRead3d* reader, imgdoc2::dbIndex pk, const imgdoc2::BrickBlobInfo& blob_info, const std::array<std::uint32_t, 3>& offset, const std::array<std::uint32_t, 3>& size, const char* operation_name, BrickData& brick_data);
+
+    /// Gets the number of bytes per pixel for the specified pixel type. If the pixel type is not supported, 0 is returned.
+    ///
+    /// \param  pixel_type  The pixel type.
+    ///
+    /// \returns    The number of bytes per pixel, or 0 if the pixel type is not supported.
+    static std::uint8_t GetBytesPerPixel(std::uint8_t pixel_type);
+};
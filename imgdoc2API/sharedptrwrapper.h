@@ -8,6 +8,7 @@
 #include <memory>
 #include <utility>
 #include <imgdoc2.h>
+#include "decodedbitmapcache.h"
 
 constexpr uint32_t kMagicInvalid = 0;
 constexpr uint32_t kMagicIHostingEnvironment = 0xBCFB6C34;
@@ -18,6 +19,8 @@ constexpr uint32_t kMagicIDocWrite2d = 0xABFF9A83;
 constexpr uint32_t kMagicIDocWrite3d = 0x1714CBB3;
 constexpr uint32_t kMagicIOpenExistingOptions = 0xE8AD8F14;
 constexpr uint32_t kMagicICreateOptions = 0x229D2DAA;
+constexpr uint32_t kMagicDecodedBitmapCache = 0x6A0E5C71;
+constexpr uint32_t kMagicDecodedBitmap = 0xD19B24E6;
 
 // In this file we define a generic template class that can be used to wrap a shared pointer to an object.
 // This is used to provide a handle to an object, and we use a magic value to check if the handle is still valid.
@@ -163,6 +166,22 @@ struct SharedPtrWrapper<imgdoc2::IDocWrite3d> : SharedPtrWrapperBase<imgdoc2::ID
         SharedPtrWrapperBase<imgdoc2::IDocWrite3d, kMagicIDocWrite3d>(std::move(shared_ptr)) {}
 };
 
+/// Partial template specialization for DecodedBitmapCache objects.
+template <>
+struct SharedPtrWrapper<DecodedBitmapCache> : SharedPtrWrapperBase<DecodedBitmapCache, kMagicDecodedBitmapCache>
+{
+    explicit SharedPtrWrapper(std::shared_ptr<DecodedBitmapCache> shared_ptr) :
+        SharedPtrWrapperBase<DecodedBitmapCache, kMagicDecodedBitmapCache>(std::move(shared_ptr)) {}
+};
+
+/// Partial template specialization for (pinned) bitmaps of a DecodedBitmapCache.
+template <>
+struct SharedPtrWrapper<const DecodedBitmapCache::Bitmap> : SharedPtrWrapperBase<const DecodedBitmapCache::Bitmap, kMagicDecodedBitmap>
+{
+    explicit SharedPtrWrapper(std::shared_ptr<const DecodedBitmapCache::Bitmap> shared_ptr) :
+        SharedPtrWrapperBase<const DecodedBitmapCache::Bitmap, kMagicDecodedBitmap>(std::move(shared_ptr)) {}
+};
+
 /// Partial template specialization for IOpenExistingOptions objects - this is using plain-pointers.
 template <>
 struct PtrWrapper<imgdoc2::IOpenExistingOptions> : PtrWrapperBase<imgdoc2::IOpenExistingOptions, kMagicIOpenExistingOptions>
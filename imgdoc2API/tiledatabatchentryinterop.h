@@ -0,0 +1,18 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include "errorcodes.h"
+
+#pragma pack(push, 4)
+/// This struct describes where the data of a tile (or brick) read with a batched read operation has been placed.
+struct TileDataBatchEntryInterop
+{
+    std::uint64_t offset;       ///< The offset of the data (relative to the start of the memory block containing the data of all tiles).
+    std::uint64_t size;         ///< The size of the data in bytes (if the result is "ImgDoc2_ErrorCode_AllocationError", this is the size which did not fit).
+    ImgDoc2ErrorCode result;    ///< The result of reading the data of this tile.
+};
+#pragma pack(pop)
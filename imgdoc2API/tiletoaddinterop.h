@@ -0,0 +1,25 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include "logicalpositioninfointerop.h"
+#include "tilebaseinfointerop.h"
+
+#pragma pack(push, 4)
+/// This struct describes a tile to be added with a batched add operation (c.f. IDocWrite2d_AddTiles). The coordinate of the
+/// tile is given as a range in an array of dimension-value-pairs, and the data of the tile is given as a range in a memory
+/// block containing the data of all tiles.
+struct TileToAddInterop
+{
+    LogicalPositionInfoInterop logical_position_info;   ///< The logical position information.
+    TileBaseInfoInterop tile_base_info;                 ///< The 'base tile information'.
+    std::uint8_t data_type;                             ///< The data type.
+    std::uint32_t coordinate_offset;                    ///< The index of the first dimension-value-pair of the coordinate of the tile.
+    std::uint32_t coordinate_count;                     ///< The number of dimension-value-pairs of the coordinate of the tile.
+    std::uint64_t data_offset;                          ///< The offset of the data of the tile (relative to the start of the memory block).
+    std::uint64_t data_size;                            ///< The size of the data of the tile in bytes.
+};
+#pragma pack(pop)
@@ -21,6 +21,17 @@ using namespace std;
     return tile_coordinate;
 }
 
+/*static*/imgdoc2::TileCoordinate Utilities::ConvertToTileCoordinate(const DimensionAndValueInterop* dimension_and_values, std::uint32_t count)
+{
+    TileCoordinate tile_coordinate;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        tile_coordinate.Set(dimension_and_values[i].dimension, dimension_and_values[i].value);
+    }
+
+    return tile_coordinate;
+}
+
 /*static*/imgdoc2::LogicalPositionInfo Utilities::ConvertLogicalPositionInfoInteropToImgdoc2(const LogicalPositionInfoInterop& logical_position_info_interop)
 {
     const LogicalPositionInfo logical_position_info
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <cstring>
+#include <stdexcept>
 #include <imgdoc2.h>
 #include "importexport.h"
 #include "logicalpositioninfointerop.h"
@@ -23,6 +25,7 @@ class Utilities
 {
 public:
     static imgdoc2::TileCoordinate ConvertToTileCoordinate(const TileCoordinateInterop* tile_coordinate_interop);
+    static imgdoc2::TileCoordinate ConvertToTileCoordinate(const DimensionAndValueInterop* dimension_and_values, std::uint32_t count);
     static imgdoc2::LogicalPositionInfo ConvertLogicalPositionInfoInteropToImgdoc2(const LogicalPositionInfoInterop& logical_position_info_interop);
     static imgdoc2::LogicalPositionInfo3D ConvertLogicalPositionInfo3DInteropToImgdoc2(const LogicalPositionInfo3DInterop& logical_position_info_interop);
     static LogicalPositionInfoInterop ConvertImgDoc2LogicalPositionInfoToInterop(const imgdoc2::LogicalPositionInfo& logical_position_info);
@@ -59,6 +62,7 @@ public:
 
         bool Reserve(size_t s) override
         {
+            this->size_ = s;
             return this->fpnReserve_(this->blob_output_handle_, s);
         }
 
@@ -66,10 +70,92 @@ public:
         {
             return this->fpnSetData_(this->blob_output_handle_, offset, size, data);
         }
+
+        /// Gets the size of the data (as given with the "Reserve"-call).
+        /// \returns The size of the data in bytes.
+        [[nodiscard]] std::uint64_t GetSize() const { return this->size_; }
     private:
         std::intptr_t blob_output_handle_;
         fnReserve fpnReserve_;
         fnSetData fpnSetData_;
+        std::uint64_t size_{ 0 };
+    };
+
+    /// A blob-output object which is placing the data into a caller-provided memory region (an "arena"). Each blob is put
+    /// at the next free position within the arena (aligned to kAlignment bytes). If the blob does not fit into the remaining
+    /// space, it is rejected (i.e. "Reserve" returns false), and the requested size is recorded. Before each blob (except
+    /// for the first one), the method "BeginBlob" must be called.
+    class BlobOutputIntoArena : public imgdoc2::IBlobOutput
+    {
+    public:
+        static constexpr std::uint64_t kAlignment = 16;   ///< The alignment (relative to the start of the arena) of the blobs.
+
+        BlobOutputIntoArena(void* arena, std::uint64_t arena_size) :
+            arena_(static_cast<std::uint8_t*>(arena)), arena_size_(arena_size)
+        {}
+
+        /// Prepares for receiving the next blob.
+        void BeginBlob()
+        {
+            this->blob_offset_ = 0;
+            this->blob_size_ = 0;
+            this->is_reserved_ = false;
+            this->is_rejected_ = false;
+        }
+
+        bool Reserve(size_t s) override
+        {
+            if (this->is_reserved_)
+            {
+                throw std::logic_error("This instance has already been initialized.");
+            }
+
+            this->blob_size_ = s;
+            const std::uint64_t offset = (this->used_size_ + kAlignment - 1) / kAlignment * kAlignment;
+            if (offset > this->arena_size_ || s > this->arena_size_ - offset)
+            {
+                this->is_rejected_ = true;
+                return false;
+            }
+
+            this->blob_offset_ = offset;
+            this->used_size_ = offset + s;
+            this->is_reserved_ = true;
+            return true;
+        }
+
+        bool SetData(size_t offset, size_t size, const void* data) override
+        {
+            if (!this->is_reserved_)
+            {
+                throw std::logic_error("'Reserve' was not called before.");
+            }
+
+            if (offset + size > this->blob_size_)
+            {
+                throw std::invalid_argument("out-of-bounds");
+            }
+
+            memcpy(this->arena_ + this->blob_offset_ + offset, data, size);
+            return true;
+        }
+
+        /// Gets the offset of the current blob (relative to the start of the arena).
+        [[nodiscard]] std::uint64_t GetBlobOffset() const { return this->blob_offset_; }
+
+        /// Gets the size of the current blob in bytes (which is also valid if the blob was rejected).
+        [[nodiscard]] std::uint64_t GetBlobSize() const { return this->blob_size_; }
+
+        /// Gets a boolean indicating whether the current blob was rejected because it did not fit into the arena.
+        [[nodiscard]] bool GetIsRejected() const { return this->is_rejected_; }
+    private:
+        std::uint8_t* arena_;
+        std::uint64_t arena_size_;
+        std::uint64_t used_size_{ 0 };
+        std::uint64_t blob_offset_{ 0 };
+        std::uint64_t blob_size_{ 0 };
+        bool is_reserved_{ false };
+        bool is_rejected_{ false };
     };
 
     /// A wrapper object for a data object that is used to pass data to the imgdoc2 API.
@@ -0,0 +1,14 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#pragma pack(push, 4)
+struct Vector3dDoubleInterop
+{
+    double x;
+    double y;
+    double z;
+};
+#pragma pack(pop)
@@ -0,0 +1,520 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include "volumeprojector.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <sstream>
+#include "parallelexecution.h"
+#include "pixelkernels.h"
+#include "renderingutilities.h"
+
+using namespace std;
+using namespace imgdoc2;
+
+/// The geometry of the projection - the arrays are indexed by the axis of the document (0 = x, 1 = y, 2 = z).
+struct VolumeProjector::Geometry
+{
+    array<int, 3> axes;             ///< The axes of the document corresponding to the x-axis and the y-axis of the destination, and the projection axis.
+    array<double, 3> start;         ///< The start of the region (for each axis of the document).
+    array<double, 3> end;           ///< The end of the region (for each axis of the document).
+    double pixel_size_u{ 0 };       ///< The size of a pixel of the destination in x-direction (in the logical coordinate system).
+    double pixel_size_v{ 0 };       ///< The size of a pixel of the destination in y-direction (in the logical coordinate system).
+    uint32_t width{ 0 };            ///< The width of the destination.
+    uint32_t height{ 0 };           ///< The height of the destination.
+};
+
+/// The information about a brick which is to be projected. The voxel indices are relative to the sub-volume held in 'data'.
+struct VolumeProjector::BrickToProject : RenderingUtilities::BrickData
+{
+    dbIndex pk{ 0 };
+    uint32_t begin_u{ 0 };                  ///< The first pixel (in x-direction of the destination) covered by the brick.
+    uint32_t end_u{ 0 };                    ///< The pixel after the last pixel (in x-direction of the destination) covered by the brick.
+    uint32_t begin_v{ 0 };                  ///< The first line of the destination covered by the brick.
+    uint32_t end_v{ 0 };                    ///< The line after the last line of the destination covered by the brick.
+    vector<uint32_t> index_u;               ///< For the pixels [begin_u, end_u), the voxel index along the corresponding axis.
+    vector<uint32_t> index_v;               ///< For the lines [begin_v, end_v), the voxel index along the corresponding axis.
+    uint32_t begin_w{ 0 };                  ///< The first voxel along the projection axis within the region.
+    uint32_t end_w{ 0 };                    ///< The voxel after the last voxel along the projection axis within the region.
+    array<size_t, 3> stride;                ///< The distance (in pixels) between two adjacent voxels along each axis.
+    bool is_contiguous{ false };            ///< True if the voxels for a line of the destination are adjacent in memory.
+};
+
+/// The state of the reduction. For "maximum" and "minimum", the destination bitmap itself is used as accumulator. For "sum"
+/// and "mean" of integer pixel types, the values are added (with the vectorized kernel) to 32-bit integers, which are folded
+/// into the double-precision sums before they can overflow.
+struct VolumeProjector::Accumulator
+{
+    DestinationBitmap destination;
+    uint8_t result_pixel_type{ PixelType::Unknown };
+    vector<uint32_t> counts;                ///< For each pixel of the destination, the number of voxels which have been reduced.
+    vector<uint32_t> partial_sums;          ///< For each pixel of the destination, the sum not yet added to 'sums'.
+    vector<double> sums;                    ///< For each pixel of the destination, the sum of the voxels.
+    vector<uint32_t> pending_additions;     ///< For each line of the destination, the number of additions to 'partial_sums' since the last fold.
+    uint32_t max_pending_additions{ 0 };    ///< The number of additions after which 'partial_sums' may overflow.
+
+    void FoldLine(uint32_t y)
+    {
+        const size_t offset = static_cast<size_t>(y) * this->destination.width;
+        for (size_t i = offset; i < offset + this->destination.width; ++i)
+        {
+            this->sums[i] += this->partial_sums[i];
+            this->partial_sums[i] = 0;
+        }
+
+        this->pending_additions[y] = 0;
+    }
+};
+
+namespace
+{
+    template <typename t_channel, int t_channels>
+    void SetPixelTyped(double value, uint8_t* pixel)
+    {
+        const t_channel channel_value = RenderingUtilities::ConvertFromDouble<t_channel>(value);
+        for (int c = 0; c < t_channels; ++c)
+        {
+            memcpy(pixel + c * sizeof(t_channel), &channel_value, sizeof(t_channel));
+        }
+    }
+
+    void SetPixel(uint8_t pixel_type, double value, uint8_t* pixel)
+    {
+        switch (pixel_type)
+        {
+        case PixelType::Gray8:
+            SetPixelTyped<uint8_t, 1>(value, pixel);
+            break;
+        case PixelType::Gray16:
+            SetPixelTyped<uint16_t, 1>(value, pixel);
+            break;
+        case PixelType::Bgr24:
+            SetPixelTyped<uint8_t, 3>(value, pixel);
+            break;
+        case PixelType::Bgr48:
+            SetPixelTyped<uint16_t, 3>(value, pixel);
+            break;
+        case PixelType::Gray32Float:
+            SetPixelTyped<float, 1>(value, pixel);
+            break;
+        default:
+            break;
+        }
+    }
+
+    /// Copies the pixels at the specified voxel indices (i.e. at 'data + (base + indices[n] * stride) * bytes_per_pixel') into
+    /// a contiguous line.
+    template <size_t t_bytes_per_pixel>
+    void GatherPixelsTyped(const uint8_t* data, size_t base, const uint32_t* indices, size_t stride, size_t count, uint8_t* destination)
+    {
+        for (size_t n = 0; n < count; ++n)
+        {
+            memcpy(destination + n * t_bytes_per_pixel, data + (base + indices[n] * stride) * t_bytes_per_pixel, t_bytes_per_pixel);
+        }
+    }
+
+    void GatherPixels(uint8_t bytes_per_pixel, const uint8_t* data, size_t base, const uint32_t* indices, size_t stride, size_t count, uint8_t* destination)
+    {
+        switch (bytes_per_pixel)
+        {
+        case 1:
+            GatherPixelsTyped<1>(data, base, indices, stride, count, destination);
+            break;
+        case 2:
+            GatherPixelsTyped<2>(data, base, indices, stride, count, destination);
+            break;
+        case 3:
+            GatherPixelsTyped<3>(data, base, indices, stride, count, destination);
+            break;
+        case 4:
+            GatherPixelsTyped<4>(data, base, indices, stride, count, destination);
+            break;
+        case 6:
+            GatherPixelsTyped<6>(data, base, indices, stride, count, destination);
+            break;
+        default:
+            break;
+        }
+    }
+
+    /// Determines the range of pixels (along one axis of the destination) whose centers are within the brick, and for those
+    /// pixels the voxel index (along the corresponding axis of the brick).
+    void CalculatePixelToVoxelMapping(
+        double start,
+        double pixel_size,
+        uint32_t number_of_pixels,
+        double brick_position,
+        double brick_extent,
+        uint32_t brick_size,
+        uint32_t& begin,
+        uint32_t& end,
+        vector<uint32_t>& indices)
+    {
+        const double first = ceil((brick_position - start) / pixel_size - 0.5);
+        const double last = ceil((brick_position + brick_extent - start) / pixel_size - 0.5);
+        begin = static_cast<uint32_t>(clamp(first, 0.0, static_cast<double>(number_of_pixels)));
+        end = static_cast<uint32_t>(clamp(last, 0.0, static_cast<double>(number_of_pixels)));
+        if (end < begin)
+        {
+            end = begin;
+        }
+
+        const double voxels_per_unit = brick_size / brick_extent;
+        const double max_index = static_cast<double>(brick_size) - 1;
+        indices.resize(end - begin);
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            const double center = start + (i + 0.5) * pixel_size;
+            indices[i - begin] = static_cast<uint32_t>(clamp(floor((center - brick_position) * voxels_per_unit), 0.0, max_index));
+        }
+    }
+}
+
+VolumeProjector::VolumeProjector(std::shared_ptr<imgdoc2::IDocRead3d> reader) : reader_(std::move(reader))
+{
+}
+
+/*static*/std::uint8_t VolumeProjector::GetResultPixelType(Operation operation, std::uint8_t pixel_type)
+{
+    switch (operation)
+    {
+    case Operation::Maximum:
+    case Operation::Minimum:
+        return RenderingUtilities::GetBytesPerPixel(pixel_type) > 0 ? pixel_type : static_cast<uint8_t>(PixelType::Unknown);
+    case Operation::Sum:
+    case Operation::Mean:
+        return pixel_type == PixelType::Gray8 || pixel_type == PixelType::Gray16 || pixel_type == PixelType::Gray32Float ?
+            static_cast<uint8_t>(PixelType::Gray32Float) :
+            static_cast<uint8_t>(PixelType::Unknown);
+    }
+
+    return PixelType::Unknown;
+}
+
+void VolumeProjector::Project(const imgdoc2::CuboidD& roi, const imgdoc2::IDimCoordinateQueryClause* plane_clause, const Options& options, const DestinationBitmap& destination)
+{
+    const uint8_t result_pixel_type = VolumeProjector::GetResultPixelType(options.operation, options.pixel_type);
+    if (result_pixel_type == PixelType::Unknown)
+    {
+        throw invalid_argument_exception("The combination of pixel type and operation is not supported.");
+    }
+
+    if (destination.data == nullptr || destination.width == 0 || destination.height == 0)
+    {
+        throw invalid_argument_exception("The destination bitmap must not be empty.");
+    }
+
+    if (destination.stride < destination.width * RenderingUtilities::GetBytesPerPixel(result_pixel_type))
+    {
+        throw invalid_argument_exception("The stride of the destination bitmap is too small.");
+    }
+
+    const auto geometry = VolumeProjector::CalculateGeometry(roi, options.axis, destination);
+    const auto indices = this->QueryBricks(roi, plane_clause, options);
+
+    Accumulator accumulator;
+    accumulator.destination = destination;
+    accumulator.result_pixel_type = result_pixel_type;
+    const size_t number_of_pixels = static_cast<size_t>(destination.width) * destination.height;
+    accumulator.counts.resize(number_of_pixels);
+    switch (options.operation)
+    {
+    case Operation::Maximum:
+        // the destination is initialized with the smallest possible value (and with the background value at the end where
+        //  there are no voxels)
+        RenderingUtilities::Fill(result_pixel_type, -numeric_limits<double>::infinity(), destination);
+        break;
+    case Operation::Minimum:
+        RenderingUtilities::Fill(result_pixel_type, numeric_limits<double>::infinity(), destination);
+        break;
+    case Operation::Sum:
+    case Operation::Mean:
+        accumulator.sums.resize(number_of_pixels);
+        if (options.pixel_type != PixelType::Gray32Float)
+        {
+            accumulator.partial_sums.resize(number_of_pixels);
+            accumulator.pending_additions.resize(destination.height);
+            accumulator.max_pending_additions = numeric_limits<uint32_t>::max() / (options.pixel_type == PixelType::Gray8 ? numeric_limits<uint8_t>::max() : numeric_limits<uint16_t>::max());
+        }
+
+        break;
+    }
+
+    const uint32_t number_of_threads = options.max_number_of_threads > 0 ? options.max_number_of_threads : ParallelExecution::GetDefaultNumberOfThreads();
+    const uint32_t number_of_bands = min(destination.height, number_of_threads * 4);
+    const auto run_bands = [&](const function<void(uint32_t, uint32_t)>& process_band)->void
+        {
+            ParallelExecution::Run(
+                number_of_threads,
+                number_of_bands,
+                [&](size_t band)->void
+                {
+                    const auto y_start = static_cast<uint32_t>(static_cast<uint64_t>(destination.height) * band / number_of_bands);
+                    const auto y_end = static_cast<uint32_t>(static_cast<uint64_t>(destination.height) * (band + 1) / number_of_bands);
+                    process_band(y_start, y_end);
+                });
+        };
+
+    // the bricks are read in batches (so that the amount of memory is bounded), and the reduction of a batch is done in parallel
+    size_t next_index = 0;
+    while (next_index < indices.size())
+    {
+        vector<BrickToProject> bricks;
+        uint64_t size_of_batch = 0;
+        while (next_index < indices.size() && size_of_batch < options.max_memory_for_bricks)
+        {
+            BrickToProject brick;
+            if (this->ReadBrick(indices[next_index++], geometry, options, brick))
+            {
+                size_of_batch += brick.size_of_data;
+                bricks.emplace_back(std::move(brick));
+            }
+        }
+
+        if (!bricks.empty())
+        {
+            run_bands(
+                [&](uint32_t y_start, uint32_t y_end)->void
+                {
+                    VolumeProjector::ProjectLines(bricks, geometry, options, accumulator, y_start, y_end);
+                });
+        }
+    }
+
+    run_bands(
+        [&](uint32_t y_start, uint32_t y_end)->void
+        {
+            VolumeProjector::FinishLines(options, accumulator, y_start, y_end);
+        });
+}
+
+/*static*/VolumeProjector::Geometry VolumeProjector::CalculateGeometry(const imgdoc2::CuboidD& roi, Axis axis, const DestinationBitmap& destination)
+{
+    if (!(roi.w > 0) || !(roi.h > 0) || !(roi.d > 0) || !isfinite(roi.x + roi.y + roi.z + roi.w + roi.h + roi.d))
+    {
+        throw invalid_argument_exception("The region must not be empty.");
+    }
+
+    Geometry geometry;
+    switch (axis)
+    {
+    case Axis::X:
+        geometry.axes = { 1, 2, 0 };
+        break;
+    case Axis::Y:
+        geometry.axes = { 0, 2, 1 };
+        break;
+    case Axis::Z:
+        geometry.axes = { 0, 1, 2 };
+        break;
+    default:
+        throw invalid_argument_exception("The projection axis is invalid.");
+    }
+
+    geometry.start = { roi.x, roi.y, roi.z };
+    geometry.end = { roi.x + roi.w, roi.y + roi.h, roi.z + roi.d };
+    geometry.width = destination.width;
+    geometry.height = destination.height;
+    geometry.pixel_size_u = (geometry.end[geometry.axes[0]] - geometry.start[geometry.axes[0]]) / destination.width;
+    geometry.pixel_size_v = (geometry.end[geometry.axes[1]] - geometry.start[geometry.axes[1]]) / destination.height;
+    return geometry;
+}
+
+std::vector<imgdoc2::dbIndex> VolumeProjector::QueryBricks(const imgdoc2::CuboidD& roi, const imgdoc2::IDimCoordinateQueryClause* plane_clause, const Options& options)
+{
+    CTileInfoQueryClause tile_info_query_clause;
+    tile_info_query_clause.AddPyramidLevelCondition(LogicalOperator::Invalid, ComparisonOperation::Equal, options.pyramid_level);
+
+    vector<dbIndex> indices;
+    this->reader_->GetTilesIntersectingCuboid(
+        roi,
+        plane_clause,
+        &tile_info_query_clause,
+        [&indices](dbIndex index)->bool
+        {
+            indices.push_back(index);
+            return true;
+        });
+
+    sort(indices.begin(), indices.end());
+    return indices;
+}
+
+bool VolumeProjector::ReadBrick(imgdoc2::dbIndex index, const Geometry& geometry, const Options& options, BrickToProject& brick)
+{
+    LogicalPositionInfo3D position;
+    BrickBlobInfo blob_info;
+    this->reader_->ReadBrickInfo(index, nullptr, &position, &blob_info);
+    if (!(position.width > 0) || !(position.height > 0) || !(position.depth > 0) ||
+        blob_info.base_info.pixelWidth == 0 || blob_info.base_info.pixelHeight == 0 || blob_info.base_info.pixelDepth == 0)
+    {
+        return false;
+    }
+
+    const array<double, 3> brick_position{ position.posX, position.posY, position.posZ };
+    const array<double, 3> brick_extent{ position.width, position.height, position.depth };
+    const array<uint32_t, 3> brick_size{ blob_info.base_info.pixelWidth, blob_info.base_info.pixelHeight, blob_info.base_info.pixelDepth };
+    const int axis_u = geometry.axes[0];
+    const int axis_v = geometry.axes[1];
+    const int axis_w = geometry.axes[2];
+
+    brick.pk = index;
+    CalculatePixelToVoxelMapping(geometry.start[axis_u], geometry.pixel_size_u, geometry.width, brick_position[axis_u], brick_extent[axis_u], brick_size[axis_u], brick.begin_u, brick.end_u, brick.index_u);
+    CalculatePixelToVoxelMapping(geometry.start[axis_v], geometry.pixel_size_v, geometry.height, brick_position[axis_v], brick_extent[axis_v], brick_size[axis_v], brick.begin_v, brick.end_v, brick.index_v);
+
+    // the voxels along the projection axis whose centers are within the region
+    const double voxels_per_unit_w = brick_size[axis_w] / brick_extent[axis_w];
+    const double first_w = ceil((geometry.start[axis_w] - brick_position[axis_w]) * voxels_per_unit_w - 0.5);
+    const double last_w = ceil((geometry.end[axis_w] - brick_position[axis_w]) * voxels_per_unit_w - 0.5);
+    brick.begin_w = static_cast<uint32_t>(clamp(first_w, 0.0, static_cast<double>(brick_size[axis_w])));
+    brick.end_w = static_cast<uint32_t>(clamp(last_w, 0.0, static_cast<double>(brick_size[axis_w])));
+    if (brick.index_u.empty() || brick.index_v.empty() || brick.end_w <= brick.begin_w)
+    {
+        return false;
+    }
+
+    if (blob_info.base_info.pixelType != options.pixel_type)
+    {
+        ostringstream string_stream;
+        string_stream << "The brick with pk=" << index << " has a pixel type different from the pixel type given for the projection.";
+        throw invalid_operation_exception(string_stream.str().c_str());
+    }
+
+    // the part of the brick which is needed for the projection (the voxel indices are monotonic, so the first and the last
+    //  element give the range)
+    array<uint32_t, 3> offset;
+    array<uint32_t, 3> size;
+    offset[axis_u] = brick.index_u.front();
+    size[axis_u] = brick.index_u.back() - brick.index_u.front() + 1;
+    offset[axis_v] = brick.index_v.front();
+    size[axis_v] = brick.index_v.back() - brick.index_v.front() + 1;
+    offset[axis_w] = brick.begin_w;
+    size[axis_w] = brick.end_w - brick.begin_w;
+
+    RenderingUtilities::LoadBrickData(this->reader_.get(), index, blob_info, offset, size, "a projection", brick);
+
+    // make the voxel indices relative to the sub-volume
+    for (auto& voxel_index : brick.index_u)
+    {
+        voxel_index -= brick.offset[axis_u];
+    }
+
+    for (auto& voxel_index : brick.index_v)
+    {
+        voxel_index -= brick.offset[axis_v];
+    }
+
+    brick.begin_w -= brick.offset[axis_w];
+    brick.end_w -= brick.offset[axis_w];
+    brick.stride = { 1, brick.size[0], static_cast<size_t>(brick.size[0]) * brick.size[1] };
+    brick.is_contiguous = axis_u == 0 && brick.index_u.back() - brick.index_u.front() == brick.index_u.size() - 1;
+    return true;
+}
+
+/*static*/void VolumeProjector::ProjectLines(const std::vector<BrickToProject>& bricks, const Geometry& geometry, const Options& options, Accumulator& accumulator, std::uint32_t y_start, std::uint32_t y_end)
+{
+    const uint8_t bytes_per_pixel = RenderingUtilities::GetBytesPerPixel(options.pixel_type);
+    const bool is_extremum = options.operation == Operation::Maximum || options.operation == Operation::Minimum;
+    vector<uint8_t> line_buffer;
+    for (uint32_t y = y_start; y < y_end; ++y)
+    {
+        uint8_t* destination_line = static_cast<uint8_t*>(accumulator.destination.data) + static_cast<size_t>(y) * accumulator.destination.stride;
+        const size_t line_offset = static_cast<size_t>(y) * accumulator.destination.width;
+        for (const auto& brick : bricks)
+        {
+            if (y < brick.begin_v || y >= brick.end_v)
+            {
+                continue;
+            }
+
+            const uint32_t count = brick.end_u - brick.begin_u;
+            const size_t stride_u = brick.stride[geometry.axes[0]];
+            const size_t stride_w = brick.stride[geometry.axes[2]];
+            size_t base = brick.index_v[y - brick.begin_v] * brick.stride[geometry.axes[1]] + brick.begin_w * stride_w;
+            if (!brick.is_contiguous)
+            {
+                line_buffer.resize(static_cast<size_t>(count) * bytes_per_pixel);
+            }
+
+            for (uint32_t w = brick.begin_w; w < brick.end_w; ++w, base += stride_w)
+            {
+                const uint8_t* source;
+                if (brick.is_contiguous)
+                {
+                    source = brick.data + (base + brick.index_u[0]) * bytes_per_pixel;
+                }
+                else
+                {
+                    GatherPixels(bytes_per_pixel, brick.data, base, brick.index_u.data(), stride_u, count, line_buffer.data());
+                    source = line_buffer.data();
+                }
+
+                if (is_extremum)
+                {
+                    PixelKernels::UpdateExtremum(options.pixel_type, options.operation == Operation::Maximum, source, destination_line + static_cast<size_t>(brick.begin_u) * bytes_per_pixel, count);
+                }
+                else if (options.pixel_type == PixelType::Gray32Float)
+                {
+                    const float* source_float = reinterpret_cast<const float*>(source);
+                    double* sums = accumulator.sums.data() + line_offset + brick.begin_u;
+                    for (uint32_t i = 0; i < count; ++i)
+                    {
+                        sums[i] += source_float[i];
+                    }
+                }
+                else
+                {
+                    if (accumulator.pending_additions[y] == accumulator.max_pending_additions)
+                    {
+                        accumulator.FoldLine(y);
+                    }
+
+                    PixelKernels::AccumulateSum(options.pixel_type, source, accumulator.partial_sums.data() + line_offset + brick.begin_u, count);
+                    ++accumulator.pending_additions[y];
+                }
+            }
+
+            uint32_t* counts = accumulator.counts.data() + line_offset + brick.begin_u;
+            const uint32_t number_of_voxels = brick.end_w - brick.begin_w;
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                counts[i] += number_of_voxels;
+            }
+        }
+    }
+}
+
+/*static*/void VolumeProjector::FinishLines(const Options& options, Accumulator& accumulator, std::uint32_t y_start, std::uint32_t y_end)
+{
+    const uint8_t bytes_per_pixel = RenderingUtilities::GetBytesPerPixel(accumulator.result_pixel_type);
+    const bool is_extremum = options.operation == Operation::Maximum || options.operation == Operation::Minimum;
+    for (uint32_t y = y_start; y < y_end; ++y)
+    {
+        if (!accumulator.pending_additions.empty())
+        {
+            accumulator.FoldLine(y);
+        }
+
+        uint8_t* destination_line = static_cast<uint8_t*>(accumulator.destination.data) + static_cast<size_t>(y) * accumulator.destination.stride;
+        const size_t line_offset = static_cast<size_t>(y) * accumulator.destination.width;
+        for (uint32_t x = 0; x < accumulator.destination.width; ++x)
+        {
+            const uint32_t count = accumulator.counts[line_offset + x];
+            uint8_t* pixel = destination_line + static_cast<size_t>(x) * bytes_per_pixel;
+            if (count == 0)
+            {
+                SetPixel(accumulator.result_pixel_type, options.background_value, pixel);
+            }
+            else if (!is_extremum)
+            {
+                const double sum = accumulator.sums[line_offset + x];
+                SetPixel(accumulator.result_pixel_type, options.operation == Operation::Mean ? sum / count : sum, pixel);
+            }
+        }
+    }
+}
@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <imgdoc2.h>
+#include "renderingutilities.h"
+
+/// This class is calculating a projection (e.g. a maximum-intensity-projection) of a cuboid region of a 3D-document along
+/// one of the axes into a 2D-bitmap. The destination bitmap covers the projection of the region (i.e. for a projection
+/// along the z-axis, its x-axis corresponds to the x-axis of the document and its y-axis to the y-axis of the document;
+/// for a projection along the y-axis, it is x and z; and for a projection along the x-axis, it is y and z). The pixel (i, j)
+/// of the destination bitmap is the reduction of all voxels along the projection axis whose center is within the region,
+/// at the position of the center of the pixel (i.e. the voxels are sampled with "nearest neighbor" perpendicular to the
+/// projection axis). The operation is as follows:
+/// - the bricks intersecting the region (and matching the "plane clause") are queried
+/// - the bricks are processed in batches, where the size of a batch is limited by the amount of memory for the brick data
+/// - the data of the bricks of a batch is read (sequentially) from the document - for chunked bricks only the sub-volume
+///   which is needed for the projection is read
+/// - the destination bitmap is divided into bands which are processed in parallel, and for each line of voxels of a brick
+///   the reduction is done with the vectorized kernels of PixelKernels
+/// For the operations "maximum" and "minimum", the pixel type of the destination is the pixel type of the bricks; for
+/// "sum" and "mean" the pixel type of the destination is Gray32Float (and those operations are only supported for the
+/// single-channel pixel types). Pixels of the destination without any voxel contributing are set to the background value.
+class VolumeProjector
+{
+public:
+    /// Values that represent the axis along which the projection is done.
+    enum class Axis : std::uint8_t
+    {
+        X = 0,  ///< Projection along the x-axis.
+        Y = 1,  ///< Projection along the y-axis.
+        Z = 2   ///< Projection along the z-axis.
+    };
+
+    /// Values that represent the operation used for reducing the voxels along the projection axis.
+    enum class Operation : std::uint8_t
+    {
+        Maximum = 0,    ///< The maximum of the voxels (i.e. a maximum-intensity-projection).
+        Minimum = 1,    ///< The minimum of the voxels.
+        Sum = 2,        ///< The sum of the voxels.
+        Mean = 3        ///< The arithmetic mean of the voxels.
+    };
+
+    /// The parameters for the projection.
+    struct Options
+    {
+        Axis axis{ Axis::Z };                                       ///< The axis along which the projection is done.
+        Operation operation{ Operation::Maximum };                  ///< The operation used for reducing the voxels.
+        std::uint8_t pixel_type{ imgdoc2::PixelType::Unknown };    ///< The pixel type of the bricks (c.f. imgdoc2::PixelType).
+        double background_value{ 0 };                               ///< The value with which pixels are filled where there are no voxels.
+        std::uint32_t max_number_of_threads{ 0 };                   ///< The maximal number of threads to use, where 0 means "use the number of hardware threads".
+        int pyramid_level{ 0 };                                     ///< The pyramid level of the bricks to be used.
+        std::uint64_t max_memory_for_bricks{ 256 * 1024 * 1024 };   ///< The (approximate) maximal amount of memory (in bytes) for the brick data held in memory at a time.
+    };
+
+    /// This structure describes the destination bitmap.
+    using DestinationBitmap = RenderingUtilities::Bitmap;
+private:
+    struct Geometry;
+    struct BrickToProject;
+    struct Accumulator;
+
+    std::shared_ptr<imgdoc2::IDocRead3d> reader_;
+public:
+    explicit VolumeProjector(std::shared_ptr<imgdoc2::IDocRead3d> reader);
+
+    /// Calculates the projection of the specified region into the destination bitmap.
+    ///
+    /// \param          roi             The region (in the logical coordinate system) to be projected.
+    /// \param          plane_clause    If non-null, the dimension-clause selecting the plane (i.e. the non-spatial coordinates).
+    /// \param          options         The parameters of the operation.
+    /// \param [out]    destination     The destination bitmap, which must have the pixel type given by GetResultPixelType.
+    void Project(const imgdoc2::CuboidD& roi, const imgdoc2::IDimCoordinateQueryClause* plane_clause, const Options& options, const DestinationBitmap& destination);
+
+    /// Gets the pixel type of the result of a projection.
+    ///
+    /// \param  operation   The operation.
+    /// \param  pixel_type  The pixel type of the bricks.
+    ///
+    /// \returns    The pixel type of the result; or imgdoc2::PixelType::Unknown if the combination is not supported.
+    static std::uint8_t GetResultPixelType(Operation operation, std::uint8_t pixel_type);
+private:
+    static Geometry CalculateGeometry(const imgdoc2::CuboidD& roi, Axis axis, const DestinationBitmap& destination);
+    std::vector<imgdoc2::dbIndex> QueryBricks(const imgdoc2::CuboidD& roi, const imgdoc2::IDimCoordinateQueryClause* plane_clause, const Options& options);
+    bool ReadBrick(imgdoc2::dbIndex index, const Geometry& geometry, const Options& options, BrickToProject& brick);
+    static void ProjectLines(const std::vector<BrickToProject>& bricks, const Geometry& geometry, const Options& options, Accumulator& accumulator, std::uint32_t y_start, std::uint32_t y_end);
+    static void FinishLines(const Options& options, Accumulator& accumulator, std::uint32_t y_start, std::uint32_t y_end);
+};
@@ -0,0 +1,191 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <imgdoc2.h>
+#include "../imgdoc2API/codecsAPI.h"
+#include "utilities.h"
+
+using namespace std;
+using namespace imgdoc2;
+using namespace testing;
+
+namespace
+{
+    /// Creates a zstd-frame which contains the specified data as a single "raw block" (i.e. uncompressed), so that valid
+    /// zstd-data can be created without the need for a compressor. The data must be smaller than 128KB (the maximal
+    /// block size).
+    vector<uint8_t> CreateZstdFrameWithRawBlock(const vector<uint8_t>& data)
+    {
+        const auto size = static_cast<uint32_t>(data.size());
+        const uint8_t header[] =
+        {
+            0x28, 0xb5, 0x2f, 0xfd,     // magic number
+            0xa0,                       // frame header descriptor: single segment, 4 bytes for the frame content size
+            static_cast<uint8_t>(size), static_cast<uint8_t>(size >> 8), static_cast<uint8_t>(size >> 16), static_cast<uint8_t>(size >> 24),
+            static_cast<uint8_t>(1 | (size << 3)), static_cast<uint8_t>(size >> 5), static_cast<uint8_t>(size >> 13),    // block header: last block, raw
+        };
+        vector<uint8_t> frame(sizeof(header) + data.size());
+        memcpy(frame.data(), header, sizeof(header));
+        memcpy(frame.data() + sizeof(header), data.data(), data.size());
+        return frame;
+    }
+
+    /// Creates a ZSTD1-blob (with a header giving the "hi/lo byte packing" flag) for the specified data.
+    vector<uint8_t> CreateZstd1Blob(const vector<uint8_t>& data, bool hi_lo_byte_packing)
+    {
+        vector<uint8_t> blob = hi_lo_byte_packing ? vector<uint8_t>{ 3, 1, 1 } : vector<uint8_t>{ 1 };
+        const auto frame = CreateZstdFrameWithRawBlock(data);
+        blob.insert(blob.end(), frame.cbegin(), frame.cend());
+        return blob;
+    }
+
+    /// Gives the contiguous bitmap (without padding) from a bitmap with the specified stride.
+    vector<uint8_t> RemovePadding(const vector<uint8_t>& bitmap, uint32_t line_length, uint32_t height, uint32_t stride)
+    {
+        vector<uint8_t> result;
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            result.insert(result.end(), bitmap.cbegin() + static_cast<size_t>(y) * stride, bitmap.cbegin() + static_cast<size_t>(y) * stride + line_length);
+        }
+
+        return result;
+    }
+
+    DecodeImageJobInterop CreateJob(uint8_t pixel_type, uint32_t width, uint32_t height, DataTypes data_type, const vector<uint8_t>& compressed_data, vector<uint8_t>& destination, uint32_t stride)
+    {
+        DecodeImageJobInterop job;
+        job.bitmap_info.pixelType = pixel_type;
+        job.bitmap_info.pixelWidth = width;
+        job.bitmap_info.pixelHeight = height;
+        job.data_type = static_cast<uint8_t>(data_type);
+        job.compressed_data = compressed_data.data();
+        job.compressed_data_size = compressed_data.size();
+        job.destination = destination.data();
+        job.destination_stride = stride;
+        job.destination_size = destination.size();
+        job.result = -1;
+        return job;
+    }
+}
+
+TEST(CodecsApi, DecodeBatchWithValidAndCorruptImagesAndCheckResultOfEachJob)
+{
+    // a Gray8-bitmap of 7x4 pixels (ZSTD0), a Gray16-bitmap of 5x3 pixels (ZSTD1 without packing) and a Gray16-bitmap of
+    //  6x2 pixels (ZSTD1 with "hi/lo byte packing", i.e. the low bytes of all words followed by the high bytes)
+    const auto gray8_data = CreateRandomBytes(7 * 4, 1);
+    const auto gray16_data = CreateRandomBytes(5 * 3 * 2, 2);
+    const auto gray16_packed_data = CreateRandomBytes(6 * 2 * 2, 3);
+    vector<uint8_t> gray16_unpacked_data(gray16_packed_data.size());
+    for (size_t i = 0; i < gray16_packed_data.size() / 2; ++i)
+    {
+        gray16_unpacked_data[2 * i] = gray16_packed_data[i];
+        gray16_unpacked_data[2 * i + 1] = gray16_packed_data[gray16_packed_data.size() / 2 + i];
+    }
+
+    const auto gray8_blob = CreateZstdFrameWithRawBlock(gray8_data);
+    const auto gray16_blob = CreateZstd1Blob(gray16_data, false);
+    const auto gray16_packed_blob = CreateZstd1Blob(gray16_packed_data, true);
+    const auto garbage_blob = CreateRandomBytes(40, 4);
+    const vector<uint8_t> truncated_blob(gray8_blob.cbegin(), gray8_blob.cend() - 5);
+
+    // the destinations have padding at the end of the lines, and the jobs are interleaving valid and invalid ones
+    vector<uint8_t> destination_gray8(11 * 4, 0xee);
+    vector<uint8_t> destination_garbage(11 * 4, 0xee);
+    vector<uint8_t> destination_gray16(12 * 3, 0xee);
+    vector<uint8_t> destination_truncated(11 * 4, 0xee);
+    vector<uint8_t> destination_gray16_packed(14 * 2, 0xee);
+    vector<uint8_t> destination_unsupported(11 * 4, 0xee);
+    vector<uint8_t> destination_too_small(11 * 4 - 1, 0xee);
+    vector<uint8_t> destination_size_mismatch(7 * 5, 0xee);
+    vector<DecodeImageJobInterop> jobs
+    {
+        CreateJob(PixelType::Gray8, 7, 4, DataTypes::ZSTD0COMPRESSED_BITMAP, gray8_blob, destination_gray8, 11),
+        CreateJob(PixelType::Gray8, 7, 4, DataTypes::ZSTD0COMPRESSED_BITMAP, garbage_blob, destination_garbage, 11),
+        CreateJob(PixelType::Gray16, 5, 3, DataTypes::ZSTD1COMPRESSED_BITMAP, gray16_blob, destination_gray16, 12),
+        CreateJob(PixelType::Gray8, 7, 4, DataTypes::ZSTD0COMPRESSED_BITMAP, truncated_blob, destination_truncated, 11),
+        CreateJob(PixelType::Gray16, 6, 2, DataTypes::ZSTD1COMPRESSED_BITMAP, gray16_packed_blob, destination_gray16_packed, 14),
+        CreateJob(PixelType::Gray8, 7, 4, DataTypes::UNCOMPRESSED_BITMAP, gray8_data, destination_unsupported, 11),
+        CreateJob(PixelType::Gray8, 7, 4, DataTypes::ZSTD0COMPRESSED_BITMAP, gray8_blob, destination_too_small, 11),
+        CreateJob(PixelType::Gray8, 7, 5, DataTypes::ZSTD0COMPRESSED_BITMAP, gray8_blob, destination_size_mismatch, 7),
+    };
+
+    const vector<ImgDoc2ErrorCode> expected_results
+    {
+        ImgDoc2_ErrorCode_OK,
+        ImgDoc2_ErrorCode_UnspecifiedError,
+        ImgDoc2_ErrorCode_OK,
+        ImgDoc2_ErrorCode_UnspecifiedError,
+        ImgDoc2_ErrorCode_OK,
+        ImgDoc2_ErrorCode_InvalidArgument,
+        ImgDoc2_ErrorCode_InvalidArgument,
+        ImgDoc2_ErrorCode_UnspecifiedError,
+    };
+
+    // the outcome must not depend on the number of threads
+    for (const uint32_t max_number_of_threads : { 1u, 3u, 0u })
+    {
+        for (auto& job : jobs)
+        {
+            job.result = -1;
+        }
+
+        fill(destination_gray8.begin(), destination_gray8.end(), 0xee);
+        fill(destination_gray16.begin(), destination_gray16.end(), 0xee);
+        fill(destination_gray16_packed.begin(), destination_gray16_packed.end(), 0xee);
+
+        ImgDoc2ErrorInformation error_information;
+        error_information.message[0] = '\0';
+        const auto error_code = DecodeImages(jobs.data(), static_cast<uint32_t>(jobs.size()), max_number_of_threads, &error_information);
+
+        // the return value is the result of the failed job with the lowest index, and the error information is filled out
+        EXPECT_EQ(error_code, ImgDoc2_ErrorCode_UnspecifiedError) << "threads " << max_number_of_threads;
+        EXPECT_GT(strlen(error_information.message), 0u) << "threads " << max_number_of_threads;
+        for (size_t i = 0; i < jobs.size(); ++i)
+        {
+            EXPECT_EQ(jobs[i].result, expected_results[i]) << "job " << i << ", threads " << max_number_of_threads;
+        }
+
+        // the valid jobs are decoded correctly, and the padding at the end of the lines is not touched
+        EXPECT_EQ(RemovePadding(destination_gray8, 7, 4, 11), gray8_data);
+        EXPECT_EQ(RemovePadding(destination_gray16, 10, 3, 12), gray16_data);
+        EXPECT_EQ(RemovePadding(destination_gray16_packed, 12, 2, 14), gray16_unpacked_data);
+        EXPECT_EQ(destination_gray8[7], 0xee);
+        EXPECT_EQ(destination_gray16[10], 0xee);
+        EXPECT_EQ(destination_gray16_packed[12], 0xee);
+    }
+}
+
+TEST(CodecsApi, DecodeBatchWithOnlyValidImagesAndExpectSuccess)
+{
+    constexpr int kNumberOfJobs = 10;
+    vector<vector<uint8_t>> data, blobs, destinations;
+    for (int i = 0; i < kNumberOfJobs; ++i)
+    {
+        data.push_back(CreateRandomBytes(16 * 8, 100 + i));
+        blobs.push_back(CreateZstdFrameWithRawBlock(data.back()));
+        destinations.emplace_back(16 * 8);
+    }
+
+    vector<DecodeImageJobInterop> jobs;
+    for (int i = 0; i < kNumberOfJobs; ++i)
+    {
+        jobs.push_back(CreateJob(PixelType::Gray8, 16, 8, DataTypes::ZSTD0COMPRESSED_BITMAP, blobs[i], destinations[i], 16));
+    }
+
+    EXPECT_EQ(DecodeImages(jobs.data(), kNumberOfJobs, 4, nullptr), ImgDoc2_ErrorCode_OK);
+    for (int i = 0; i < kNumberOfJobs; ++i)
+    {
+        EXPECT_EQ(jobs[i].result, ImgDoc2_ErrorCode_OK) << "job " << i;
+        EXPECT_EQ(destinations[i], data[i]) << "job " << i;
+    }
+
+    // an empty batch is valid as well
+    EXPECT_EQ(DecodeImages(nullptr, 0, 4, nullptr), ImgDoc2_ErrorCode_OK);
+}
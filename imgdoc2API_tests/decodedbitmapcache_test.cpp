@@ -0,0 +1,177 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <imgdoc2.h>
+#include "../imgdoc2API/decodedbitmapcache.h"
+
+using namespace std;
+using namespace imgdoc2;
+using namespace testing;
+
+namespace
+{
+    /// Creates a Gray8-bitmap of 'size' x 1 pixels (so its size is 'size' bytes), filled with the specified value.
+    shared_ptr<const DecodedBitmapCache::Bitmap> CreateBitmap(uint32_t size, uint8_t value)
+    {
+        auto bitmap = make_shared<DecodedBitmapCache::Bitmap>();
+        bitmap->pixel_type = PixelType::Gray8;
+        bitmap->width = size;
+        bitmap->height = 1;
+        bitmap->stride = size;
+        bitmap->data = shared_ptr<void>(new uint8_t[size], [](void* data) { delete[] static_cast<uint8_t*>(data); });
+        memset(bitmap->data.get(), value, size);
+        return bitmap;
+    }
+
+    DecodedBitmapCache::Key MakeKey(dbIndex tile_index)
+    {
+        DecodedBitmapCache::Key key;
+        key.document_id = 1;
+        key.tile_index = tile_index;
+        return key;
+    }
+}
+
+TEST(DecodedBitmapCache, AddBitmapsAndCheckThatCapacityIsNotExceeded)
+{
+    // with one shard, the whole budget of 1000 bytes is available to it
+    DecodedBitmapCache cache(1000, 1);
+    for (dbIndex i = 0; i < 5; ++i)
+    {
+        cache.Add(MakeKey(i), CreateBitmap(300, static_cast<uint8_t>(i)), chrono::microseconds(100));
+        const auto statistics = cache.GetStatistics();
+        EXPECT_LE(statistics.memory_usage, 1000u);
+        EXPECT_EQ(statistics.memory_usage, statistics.number_of_entries * 300);
+    }
+
+    auto statistics = cache.GetStatistics();
+    EXPECT_EQ(statistics.number_of_entries, 3u);
+    EXPECT_EQ(statistics.insertions, 5u);
+    EXPECT_EQ(statistics.evictions, 2u);
+
+    // a bitmap larger than the budget is not added (but it is returned)
+    const auto large_bitmap = CreateBitmap(1001, 0);
+    EXPECT_EQ(cache.Add(MakeKey(10), large_bitmap, chrono::microseconds(100)), large_bitmap);
+    EXPECT_EQ(cache.Get(MakeKey(10)), nullptr);
+    EXPECT_EQ(cache.GetStatistics().number_of_entries, 3u);
+
+    // adding a bitmap with a key which is already present gives the bitmap in the cache
+    const auto bitmap_in_cache = cache.Get(MakeKey(4));
+    ASSERT_NE(bitmap_in_cache, nullptr);
+    EXPECT_EQ(cache.Add(MakeKey(4), CreateBitmap(300, 99), chrono::microseconds(100)), bitmap_in_cache);
+
+    // removing the bitmaps of another document does not change anything, clearing the cache removes everything
+    cache.RemoveDocument(2);
+    EXPECT_EQ(cache.GetStatistics().number_of_entries, 3u);
+    cache.Clear();
+    statistics = cache.GetStatistics();
+    EXPECT_EQ(statistics.number_of_entries, 0u);
+    EXPECT_EQ(statistics.memory_usage, 0u);
+}
+
+TEST(DecodedBitmapCache, AddBitmapsWithDifferentCostsAndCheckEvictionOrder)
+{
+    // the priority of a bitmap is "inflation + cost / size" (where the cost is the decode time in microseconds), and the
+    //  bitmap with the lowest priority is evicted first - the inflation is raised to the priority of the evicted bitmap
+    DecodedBitmapCache cache(1000, 1);
+    const auto key_a = MakeKey(1), key_b = MakeKey(2), key_c = MakeKey(3), key_d = MakeKey(4), key_e = MakeKey(5), key_f = MakeKey(6), key_g = MakeKey(7);
+    cache.Add(key_a, CreateBitmap(500, 1), chrono::microseconds(50));     // priority 0.1
+    cache.Add(key_b, CreateBitmap(300, 2), chrono::microseconds(500));    // priority 1.667
+    cache.Add(key_c, CreateBitmap(100, 3), chrono::microseconds(1000));   // priority 10
+
+    // A is the cheapest to reproduce per byte, so it is evicted first (and the inflation becomes 0.1)
+    cache.Add(key_d, CreateBitmap(200, 4), chrono::microseconds(200));    // priority 1
+    EXPECT_EQ(cache.Get(key_a), nullptr);
+    EXPECT_EQ(cache.GetStatistics().memory_usage, 600u);
+
+    // E fits in, then F requires evicting D (which has the lowest priority, 1), and the inflation becomes 1
+    cache.Add(key_e, CreateBitmap(400, 5), chrono::microseconds(400));    // priority 0.1 + 1 = 1.1
+    cache.Add(key_f, CreateBitmap(100, 6), chrono::microseconds(300));    // priority 1 + 3 = 3.1
+    EXPECT_EQ(cache.Get(key_d), nullptr);
+    EXPECT_EQ(cache.GetStatistics().memory_usage, 900u);
+
+    // accessing E raises its priority to 1 + 1 = 2, so G now evicts B (1.667) instead of E (which would have had 1.1)
+    EXPECT_NE(cache.Get(key_e), nullptr);
+    cache.Add(key_g, CreateBitmap(200, 7), chrono::microseconds(240));    // priority 1 + 1.2 = 2.2
+    EXPECT_EQ(cache.Get(key_b), nullptr);
+    EXPECT_EQ(cache.GetStatistics().memory_usage, 800u);
+
+    for (const auto& key : { key_c, key_e, key_f, key_g })
+    {
+        EXPECT_NE(cache.Get(key), nullptr) << "tile index " << key.tile_index;
+    }
+
+    EXPECT_EQ(cache.GetStatistics().evictions, 3u);
+}
+
+TEST(DecodedBitmapCache, EvictBitmapWhichIsInUseAndCheckThatItRemainsValid)
+{
+    DecodedBitmapCache cache(1000, 1);
+    cache.Add(MakeKey(1), CreateBitmap(600, 0xab), chrono::microseconds(10));
+    const auto pinned_bitmap = cache.Get(MakeKey(1));
+    ASSERT_NE(pinned_bitmap, nullptr);
+
+    // adding a more expensive bitmap evicts the first one from the cache...
+    cache.Add(MakeKey(2), CreateBitmap(600, 0xcd), chrono::microseconds(1000));
+    EXPECT_EQ(cache.Get(MakeKey(1)), nullptr);
+    const auto statistics = cache.GetStatistics();
+    EXPECT_EQ(statistics.evictions, 1u);
+    EXPECT_EQ(statistics.memory_usage, 600u);
+
+    // ...but the bitmap held by the caller is still valid
+    EXPECT_EQ(pinned_bitmap->GetSize(), 600u);
+    const auto* data = static_cast<const uint8_t*>(pinned_bitmap->data.get());
+    EXPECT_THAT(vector<uint8_t>(data, data + 600), Each(0xab));
+}
+
+TEST(DecodedBitmapCache, AccessConcurrentlyAndCheckStatistics)
+{
+    constexpr int kNumberOfThreads = 8;
+    constexpr int kLookupsPerThread = 2000;
+    constexpr dbIndex kNumberOfKeys = 100;
+    DecodedBitmapCache cache(1024 * 1024, 0);
+
+    // every thread looks up the keys (in a different order), and adds the bitmap if it is not in the cache - a bitmap
+    //  may be decoded by multiple threads concurrently, but it is inserted only once
+    vector<thread> threads;
+    for (int t = 0; t < kNumberOfThreads; ++t)
+    {
+        threads.emplace_back(
+            [&cache, t]()
+            {
+                for (int i = 0; i < kLookupsPerThread; ++i)
+                {
+                    const auto key = MakeKey((static_cast<dbIndex>(i) * (2 * t + 1)) % kNumberOfKeys);
+                    auto bitmap = cache.Get(key);
+                    if (!bitmap)
+                    {
+                        bitmap = cache.Add(key, CreateBitmap(100, static_cast<uint8_t>(key.tile_index)), chrono::microseconds(10));
+                    }
+
+                    EXPECT_EQ(static_cast<const uint8_t*>(bitmap->data.get())[0], static_cast<uint8_t>(key.tile_index));
+                }
+            });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    const auto statistics = cache.GetStatistics();
+    EXPECT_EQ(statistics.hits + statistics.misses, static_cast<uint64_t>(kNumberOfThreads) * kLookupsPerThread);
+    EXPECT_GE(statistics.misses, static_cast<uint64_t>(kNumberOfKeys));
+    EXPECT_EQ(statistics.insertions, static_cast<uint64_t>(kNumberOfKeys));
+    EXPECT_EQ(statistics.evictions, 0u);
+    EXPECT_EQ(statistics.number_of_entries, static_cast<uint64_t>(kNumberOfKeys));
+    EXPECT_EQ(statistics.memory_usage, kNumberOfKeys * 100);
+}
@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../imgdoc2API/parallelexecution.h"
+
+using namespace std;
+using namespace testing;
+
+TEST(ParallelExecution, RunAndCheckThatEachWorkItemIsExecutedExactlyOnce)
+{
+    for (const uint32_t number_of_threads : { 1u, 2u, 7u })
+    {
+        for (const size_t number_of_work_items : { 0, 1, 3, 1000 })
+        {
+            vector<atomic<int>> counters(number_of_work_items);
+            ParallelExecution::Run(
+                number_of_threads,
+                number_of_work_items,
+                [&counters](size_t work_item)->void
+                {
+                    ++counters[work_item];
+                });
+
+            for (size_t i = 0; i < number_of_work_items; ++i)
+            {
+                EXPECT_EQ(counters[i].load(), 1) << "threads " << number_of_threads << ", work item " << i << " of " << number_of_work_items;
+            }
+        }
+    }
+}
+
+TEST(ParallelExecution, RunWithThreadIndexAndCheckThatThreadIndexIsInRange)
+{
+    constexpr uint32_t kNumberOfThreads = 4;
+    constexpr size_t kNumberOfWorkItems = 500;
+    vector<uint64_t> sum_per_thread(kNumberOfThreads, 0);
+    atomic<bool> thread_index_out_of_range{ false };
+    ParallelExecution::RunWithThreadIndex(
+        kNumberOfThreads,
+        kNumberOfWorkItems,
+        [&](uint32_t thread_index, size_t work_item)->void
+        {
+            if (thread_index >= kNumberOfThreads)
+            {
+                thread_index_out_of_range = true;
+                return;
+            }
+
+            // this is the use-case for the thread index - per-thread state without synchronization
+            sum_per_thread[thread_index] += work_item;
+        });
+
+    ASSERT_FALSE(thread_index_out_of_range.load());
+    uint64_t sum = 0;
+    for (const auto partial_sum : sum_per_thread)
+    {
+        sum += partial_sum;
+    }
+
+    EXPECT_EQ(sum, kNumberOfWorkItems * (kNumberOfWorkItems - 1) / 2);
+}
+
+TEST(ParallelExecution, RunWithActionThrowingAndCheckThatExceptionIsPropagated)
+{
+    atomic<size_t> number_of_work_items_started{ 0 };
+    EXPECT_THROW(
+        ParallelExecution::Run(
+            4,
+            1000,
+            [&number_of_work_items_started](size_t work_item)->void
+            {
+                ++number_of_work_items_started;
+                if (work_item == 10)
+                {
+                    throw runtime_error("test");
+                }
+
+                // the other work items take some time, so that the exception is reported long before all of them are done
+                this_thread::sleep_for(chrono::microseconds(500));
+            }),
+        runtime_error);
+
+    // no further work items are started after the exception (apart from those already picked by the other threads)
+    EXPECT_LT(number_of_work_items_started.load(), 1000u);
+
+    // with one thread, the work items are executed in order, and the execution stops immediately
+    size_t number_of_work_items_executed = 0;
+    EXPECT_THROW(
+        ParallelExecution::Run(
+            1,
+            100,
+            [&number_of_work_items_executed](size_t work_item)->void
+            {
+                ++number_of_work_items_executed;
+                if (work_item == 10)
+                {
+                    throw runtime_error("test");
+                }
+            }),
+        runtime_error);
+    EXPECT_EQ(number_of_work_items_executed, 11u);
+}
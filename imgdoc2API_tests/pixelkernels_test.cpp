@@ -0,0 +1,463 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include <imgdoc2.h>
+#include "../imgdoc2API/pixelkernels.h"
+#include "utilities.h"
+
+using namespace std;
+using namespace testing;
+
+namespace
+{
+    /// The line lengths used in the tests - those are chosen so that the vectorized loops are run with all possible remainders
+    /// (and for lengths smaller than one vector).
+    const vector<uint32_t> kLineLengths{ 1, 2, 3, 7, 8, 15, 16, 17, 31, 32, 33, 47, 63, 64, 65, 67, 127, 129 };
+
+    /// Creates pseudo-random channel values - for float, the values are in the range [-4681, 4681] (and not integers).
+    template <typename t_channel>
+    vector<t_channel> CreateRandomChannels(size_t count, uint32_t seed)
+    {
+        const auto bytes = CreateRandomBytes(2 * count, seed);
+        vector<t_channel> channels(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const int value = bytes[2 * i] | (bytes[2 * i + 1] << 8);
+            if constexpr (is_floating_point_v<t_channel>)
+            {
+                channels[i] = static_cast<t_channel>((value - 32768) / 7.0);
+            }
+            else
+            {
+                channels[i] = static_cast<t_channel>(value);
+            }
+        }
+
+        return channels;
+    }
+
+    /// Runs "UpdateExtremum" (for maximum and minimum) with all instruction sets and all line lengths, and compares the
+    /// result to the element-wise maximum (or minimum) calculated here.
+    template <typename t_channel>
+    void TestUpdateExtremumWithAllInstructionSets(uint8_t pixel_type, uint32_t channels_per_pixel)
+    {
+        for (const auto number_of_pixels : kLineLengths)
+        {
+            const size_t number_of_channels = static_cast<size_t>(number_of_pixels) * channels_per_pixel;
+
+            // the source is starting at an odd element, so that unaligned loads are exercised
+            const auto source = CreateRandomChannels<t_channel>(number_of_channels + 1, number_of_pixels);
+            const auto initial_accumulator = CreateRandomChannels<t_channel>(number_of_channels, number_of_pixels + 1000);
+            for (const bool maximum : { true, false })
+            {
+                vector<t_channel> expected_result(number_of_channels);
+                for (size_t i = 0; i < number_of_channels; ++i)
+                {
+                    expected_result[i] = maximum ? max(initial_accumulator[i], source[i + 1]) : min(initial_accumulator[i], source[i + 1]);
+                }
+
+                for (const auto instruction_set : PixelKernels::GetAvailableInstructionSets())
+                {
+                    ASSERT_TRUE(PixelKernels::SetInstructionSet(instruction_set));
+                    auto accumulator = initial_accumulator;
+                    ASSERT_TRUE(PixelKernels::UpdateExtremum(pixel_type, maximum, source.data() + 1, accumulator.data(), number_of_pixels));
+                    EXPECT_EQ(accumulator, expected_result)
+                        << "instruction set " << static_cast<int>(instruction_set) << ", pixel type " << static_cast<int>(pixel_type)
+                        << ", number of pixels " << number_of_pixels << ", maximum " << maximum;
+                }
+            }
+        }
+    }
+
+    /// Maps a value as documented for "ConvertWithWindow" (where the calculation is done with single precision, as it is
+    /// done by the kernels).
+    template <typename t_source, typename t_destination>
+    t_destination MapWithWindow(t_source value, float window_minimum, float scale)
+    {
+        const float mapped_value = (static_cast<float>(value) - window_minimum) * scale;
+        if (!(mapped_value > 0))
+        {
+            return 0;    // this includes NaN
+        }
+
+        return static_cast<t_destination>(min(mapped_value, static_cast<float>(numeric_limits<t_destination>::max())) + 0.5f);
+    }
+
+    /// Runs "ConvertWithWindow" with all instruction sets and all line lengths (with padded strides), and compares the result
+    /// to the values calculated here. The source lines are taken from 'values' (cyclically, with an offset for each line).
+    template <typename t_source, typename t_destination>
+    void TestConvertWithWindowWithAllInstructionSets(uint8_t source_pixel_type, uint8_t destination_pixel_type, uint32_t channels_per_pixel, const vector<t_source>& values, double window_minimum, double window_maximum)
+    {
+        constexpr uint8_t kFillValue = 0xcd;
+        constexpr uint32_t kHeight = 3;
+        const auto scale = static_cast<float>(numeric_limits<t_destination>::max() / (window_maximum - window_minimum));
+        for (const auto width : kLineLengths)
+        {
+            const uint32_t channels_per_line = width * channels_per_pixel;
+            const uint32_t source_stride = (channels_per_line + 1) * sizeof(t_source);
+            const uint32_t destination_stride = channels_per_line * sizeof(t_destination) + 3;
+            vector<uint8_t> source(static_cast<size_t>(source_stride) * kHeight);
+            vector<uint8_t> expected_result(static_cast<size_t>(destination_stride) * kHeight, kFillValue);
+            for (uint32_t y = 0; y < kHeight; ++y)
+            {
+                for (uint32_t i = 0; i < channels_per_line; ++i)
+                {
+                    const t_source value = values[(static_cast<size_t>(y) * 7 + i) % values.size()];
+                    const t_destination expected_value = MapWithWindow<t_source, t_destination>(value, static_cast<float>(window_minimum), scale);
+                    memcpy(source.data() + static_cast<size_t>(y) * source_stride + i * sizeof(t_source), &value, sizeof(t_source));
+                    memcpy(expected_result.data() + static_cast<size_t>(y) * destination_stride + i * sizeof(t_destination), &expected_value, sizeof(t_destination));
+                }
+            }
+
+            for (const auto instruction_set : PixelKernels::GetAvailableInstructionSets())
+            {
+                ASSERT_TRUE(PixelKernels::SetInstructionSet(instruction_set));
+                vector<uint8_t> destination(static_cast<size_t>(destination_stride) * kHeight, kFillValue);
+                ASSERT_TRUE(PixelKernels::ConvertWithWindow(source_pixel_type, source.data(), source_stride, width, kHeight, window_minimum, window_maximum, destination_pixel_type, destination.data(), destination_stride));
+                EXPECT_EQ(destination, expected_result)
+                    << "instruction set " << static_cast<int>(instruction_set) << ", pixel types " << static_cast<int>(source_pixel_type)
+                    << "->" << static_cast<int>(destination_pixel_type) << ", width " << width;
+            }
+        }
+    }
+
+    /// Runs "AccumulateSum" with all instruction sets and all line lengths, and compares the result to the element-wise sum
+    /// calculated here.
+    template <typename t_channel>
+    void TestAccumulateSumWithAllInstructionSets(uint8_t pixel_type, uint32_t channels_per_pixel)
+    {
+        for (const auto number_of_pixels : kLineLengths)
+        {
+            const size_t number_of_channels = static_cast<size_t>(number_of_pixels) * channels_per_pixel;
+            const auto source = CreateRandomChannels<t_channel>(number_of_channels + 1, number_of_pixels);
+
+            // the accumulator is initialized with values which are larger than 16 bits, so that a carry into the upper
+            //  half-words is exercised
+            const auto random_values = CreateRandomChannels<uint16_t>(number_of_channels, number_of_pixels + 1000);
+            vector<uint32_t> initial_accumulator(number_of_channels);
+            vector<uint32_t> expected_result(number_of_channels);
+            for (size_t i = 0; i < number_of_channels; ++i)
+            {
+                initial_accumulator[i] = random_values[i] * 1000u;
+                expected_result[i] = initial_accumulator[i] + source[i + 1];
+            }
+
+            for (const auto instruction_set : PixelKernels::GetAvailableInstructionSets())
+            {
+                ASSERT_TRUE(PixelKernels::SetInstructionSet(instruction_set));
+                auto accumulator = initial_accumulator;
+                ASSERT_TRUE(PixelKernels::AccumulateSum(pixel_type, source.data() + 1, accumulator.data(), number_of_pixels));
+                EXPECT_EQ(accumulator, expected_result)
+                    << "instruction set " << static_cast<int>(instruction_set) << ", pixel type " << static_cast<int>(pixel_type)
+                    << ", number of pixels " << number_of_pixels;
+            }
+        }
+    }
+}
+
+TEST(PixelKernels, CheckThatScalarInstructionSetIsAlwaysAvailable)
+{
+    const auto instruction_sets = PixelKernels::GetAvailableInstructionSets();
+    EXPECT_THAT(instruction_sets, Contains(PixelKernels::InstructionSet::Scalar));
+    EXPECT_THAT(instruction_sets, Contains(PixelKernels::GetInstructionSet()));
+}
+
+TEST(PixelKernels, CopyWithStrideConversionWithAllInstructionSetsAndCheckResult)
+{
+    InstructionSetRestorer instruction_set_restorer;
+    constexpr uint8_t kFillValue = 0xcd;
+    for (const auto line_length : kLineLengths)
+    {
+        for (const uint32_t height : { 1u, 2u, 5u })
+        {
+            // contiguous (where the bitmap is copied in one go), odd strides and different strides for source and destination
+            for (const auto& strides : { make_pair(line_length, line_length), make_pair(line_length + 1, line_length + 3), make_pair(line_length + 7, line_length) })
+            {
+                // the source is starting at an odd address, so that unaligned loads are exercised
+                const auto source = CreateRandomBytes(1 + static_cast<size_t>(strides.first) * height, line_length);
+                vector<uint8_t> expected_result(static_cast<size_t>(strides.second) * height, kFillValue);
+                for (uint32_t y = 0; y < height; ++y)
+                {
+                    copy_n(source.data() + 1 + static_cast<size_t>(y) * strides.first, line_length, expected_result.data() + static_cast<size_t>(y) * strides.second);
+                }
+
+                for (const auto instruction_set : PixelKernels::GetAvailableInstructionSets())
+                {
+                    ASSERT_TRUE(PixelKernels::SetInstructionSet(instruction_set));
+                    vector<uint8_t> destination(static_cast<size_t>(strides.second) * height, kFillValue);
+                    PixelKernels::CopyWithStrideConversion(source.data() + 1, strides.first, line_length, height, destination.data(), strides.second);
+
+                    // note that this also checks that the padding bytes of the destination are not modified
+                    EXPECT_EQ(destination, expected_result)
+                        << "instruction set " << static_cast<int>(instruction_set) << ", line length " << line_length << ", height " << height
+                        << ", strides " << strides.first << "/" << strides.second;
+                }
+            }
+        }
+    }
+}
+
+TEST(PixelKernels, UnpackHiLoBytesWithAllInstructionSetsAndCheckResult)
+{
+    InstructionSetRestorer instruction_set_restorer;
+    constexpr uint8_t kFillValue = 0xcd;
+    for (const auto words_per_line : kLineLengths)
+    {
+        for (const uint32_t height : { 1u, 2u, 5u })
+        {
+            // contiguous (where the bitmap is unpacked in one go), and with an odd padding
+            for (const uint32_t destination_stride : { words_per_line * 2, words_per_line * 2 + 3 })
+            {
+                const size_t total_number_of_words = static_cast<size_t>(words_per_line) * height;
+                const auto source = CreateRandomBytes(2 * total_number_of_words, words_per_line + height);
+
+                // the source contains the low bytes of all words, followed by the high bytes of all words
+                vector<uint8_t> expected_result(static_cast<size_t>(destination_stride) * height, kFillValue);
+                for (uint32_t y = 0; y < height; ++y)
+                {
+                    for (uint32_t x = 0; x < words_per_line; ++x)
+                    {
+                        const size_t word_index = static_cast<size_t>(y) * words_per_line + x;
+                        expected_result[static_cast<size_t>(y) * destination_stride + 2 * x] = source[word_index];
+                        expected_result[static_cast<size_t>(y) * destination_stride + 2 * x + 1] = source[total_number_of_words + word_index];
+                    }
+                }
+
+                for (const auto instruction_set : PixelKernels::GetAvailableInstructionSets())
+                {
+                    ASSERT_TRUE(PixelKernels::SetInstructionSet(instruction_set));
+                    vector<uint8_t> destination(static_cast<size_t>(destination_stride) * height, kFillValue);
+                    PixelKernels::UnpackHiLoBytes(source.data(), words_per_line, height, destination.data(), destination_stride);
+                    EXPECT_EQ(destination, expected_result)
+                        << "instruction set " << static_cast<int>(instruction_set) << ", words per line " << words_per_line << ", height " << height
+                        << ", stride " << destination_stride;
+                }
+            }
+        }
+    }
+}
+
+TEST(PixelKernels, DownscaleByAveragingWithFactor2WithAllInstructionSetsAndCheckResult)
+{
+    InstructionSetRestorer instruction_set_restorer;
+    constexpr uint8_t kFillValue = 0xcd;
+    for (const auto pixel_type : { imgdoc2::PixelType::Gray8, imgdoc2::PixelType::Gray16 })
+    {
+        const uint32_t bytes_per_pixel = pixel_type == imgdoc2::PixelType::Gray8 ? 1 : 2;
+        for (const auto destination_width : kLineLengths)
+        {
+            for (const uint32_t destination_height : { 1u, 3u })
+            {
+                // the source has a padding of one pixel (plus one byte for Gray8, so that the stride is odd), and the destination
+                //  has an odd padding as well
+                const uint32_t source_stride = (2 * destination_width + 1) * bytes_per_pixel + (bytes_per_pixel == 1 ? 1 : 0);
+                const uint32_t destination_stride = destination_width * bytes_per_pixel + 3;
+                const auto source = CreateRandomBytes(static_cast<size_t>(source_stride) * 2 * destination_height, destination_width);
+                const auto get_source_pixel = [&](uint32_t x, uint32_t y)->uint32_t
+                    {
+                        const uint8_t* pixel = source.data() + static_cast<size_t>(y) * source_stride + static_cast<size_t>(x) * bytes_per_pixel;
+                        return bytes_per_pixel == 1 ? pixel[0] : static_cast<uint32_t>(pixel[0] | (pixel[1] << 8));
+                    };
+
+                vector<uint8_t> expected_result(static_cast<size_t>(destination_stride) * destination_height, kFillValue);
+                for (uint32_t y = 0; y < destination_height; ++y)
+                {
+                    for (uint32_t x = 0; x < destination_width; ++x)
+                    {
+                        const uint32_t sum = get_source_pixel(2 * x, 2 * y) + get_source_pixel(2 * x + 1, 2 * y) + get_source_pixel(2 * x, 2 * y + 1) + get_source_pixel(2 * x + 1, 2 * y + 1);
+                        const uint32_t average = (sum + 2) / 4;
+                        uint8_t* pixel = expected_result.data() + static_cast<size_t>(y) * destination_stride + static_cast<size_t>(x) * bytes_per_pixel;
+                        pixel[0] = static_cast<uint8_t>(average);
+                        if (bytes_per_pixel == 2)
+                        {
+                            pixel[1] = static_cast<uint8_t>(average >> 8);
+                        }
+                    }
+                }
+
+                for (const auto instruction_set : PixelKernels::GetAvailableInstructionSets())
+                {
+                    ASSERT_TRUE(PixelKernels::SetInstructionSet(instruction_set));
+                    vector<uint8_t> destination(static_cast<size_t>(destination_stride) * destination_height, kFillValue);
+                    ASSERT_TRUE(PixelKernels::DownscaleByAveraging(pixel_type, 2, source.data(), source_stride, destination_width, destination_height, destination.data(), destination_stride));
+                    EXPECT_EQ(destination, expected_result)
+                        << "instruction set " << static_cast<int>(instruction_set) << ", pixel type " << static_cast<int>(pixel_type)
+                        << ", width " << destination_width << ", height " << destination_height;
+                }
+            }
+        }
+    }
+}
+
+TEST(PixelKernels, DownscaleByAveragingWithFactor3AndCheckResult)
+{
+    // a Bgr24-bitmap of 6x3 pixels is downscaled to 2x1 pixels, where each channel is averaged separately
+    vector<uint8_t> source(6 * 3 * 3);
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        source[i] = static_cast<uint8_t>(i);
+    }
+
+    vector<uint8_t> destination(2 * 3);
+    ASSERT_TRUE(PixelKernels::DownscaleByAveraging(imgdoc2::PixelType::Bgr24, 3, source.data(), 6 * 3, 2, 1, destination.data(), 2 * 3));
+
+    // the value of channel c of the source pixel (x,y) is 18*y + 3*x + c, so the average of the first 3x3-block is 18 + 3 + c, and
+    //  the average of the second one is 18 + 12 + c
+    EXPECT_THAT(destination, ElementsAre(21, 22, 23, 30, 31, 32));
+
+    // for Gray32Float, no rounding is done
+    const vector<float> float_source{ 1, 2, 4, 4 };
+    float float_destination = 0;
+    ASSERT_TRUE(PixelKernels::DownscaleByAveraging(imgdoc2::PixelType::Gray32Float, 2, float_source.data(), 2 * sizeof(float), 1, 1, &float_destination, sizeof(float)));
+    EXPECT_FLOAT_EQ(float_destination, 2.75f);
+
+    EXPECT_FALSE(PixelKernels::DownscaleByAveraging(imgdoc2::PixelType::Gray8, 0, source.data(), 6, 1, 1, destination.data(), 1));
+    EXPECT_FALSE(PixelKernels::DownscaleByAveraging(imgdoc2::PixelType::Unknown, 2, source.data(), 6, 1, 1, destination.data(), 1));
+}
+
+TEST(PixelKernels, UpdateExtremumWithAllInstructionSetsAndCheckResult)
+{
+    InstructionSetRestorer instruction_set_restorer;
+    TestUpdateExtremumWithAllInstructionSets<uint8_t>(imgdoc2::PixelType::Gray8, 1);
+    TestUpdateExtremumWithAllInstructionSets<uint16_t>(imgdoc2::PixelType::Gray16, 1);
+    TestUpdateExtremumWithAllInstructionSets<uint8_t>(imgdoc2::PixelType::Bgr24, 3);
+    TestUpdateExtremumWithAllInstructionSets<uint16_t>(imgdoc2::PixelType::Bgr48, 3);
+    TestUpdateExtremumWithAllInstructionSets<float>(imgdoc2::PixelType::Gray32Float, 1);
+
+    uint8_t value = 0;
+    EXPECT_FALSE(PixelKernels::UpdateExtremum(imgdoc2::PixelType::Unknown, true, &value, &value, 1));
+}
+
+TEST(PixelKernels, AccumulateSumWithAllInstructionSetsAndCheckResult)
+{
+    InstructionSetRestorer instruction_set_restorer;
+    TestAccumulateSumWithAllInstructionSets<uint8_t>(imgdoc2::PixelType::Gray8, 1);
+    TestAccumulateSumWithAllInstructionSets<uint16_t>(imgdoc2::PixelType::Gray16, 1);
+    TestAccumulateSumWithAllInstructionSets<uint8_t>(imgdoc2::PixelType::Bgr24, 3);
+    TestAccumulateSumWithAllInstructionSets<uint16_t>(imgdoc2::PixelType::Bgr48, 3);
+
+    // the sum is not supported for float
+    const float value = 1;
+    uint32_t accumulator = 0;
+    EXPECT_FALSE(PixelKernels::AccumulateSum(imgdoc2::PixelType::Gray32Float, &value, &accumulator, 1));
+}
+
+TEST(PixelKernels, ConvertWithWindowWithAllInstructionSetsAndCheckResult)
+{
+    InstructionSetRestorer instruction_set_restorer;
+
+    // the integer values are covering the whole range, so that values below and above the window are clamped - and the
+    //  window's bounds themselves are included
+    auto integer_values = CreateRandomChannels<uint16_t>(256, 36);
+    integer_values[3] = 1000;
+    integer_values[20] = 50000;
+    integer_values[41] = 0;
+    integer_values[42] = 65535;
+    TestConvertWithWindowWithAllInstructionSets<uint16_t, uint8_t>(imgdoc2::PixelType::Gray16, imgdoc2::PixelType::Gray8, 1, integer_values, 1000, 50000);
+    TestConvertWithWindowWithAllInstructionSets<uint16_t, uint8_t>(imgdoc2::PixelType::Bgr48, imgdoc2::PixelType::Bgr24, 3, integer_values, 1000, 50000);
+
+    // for float, NaN is mapped to zero, and infinities are clamped
+    auto float_values = CreateRandomChannels<float>(256, 37);
+    float_values[1] = numeric_limits<float>::quiet_NaN();
+    float_values[5] = numeric_limits<float>::infinity();
+    float_values[11] = -numeric_limits<float>::infinity();
+    float_values[18] = -1000;
+    float_values[33] = 3000;
+    float_values[62] = numeric_limits<float>::quiet_NaN();
+    TestConvertWithWindowWithAllInstructionSets<float, uint8_t>(imgdoc2::PixelType::Gray32Float, imgdoc2::PixelType::Gray8, 1, float_values, -1000, 3000);
+    TestConvertWithWindowWithAllInstructionSets<float, uint16_t>(imgdoc2::PixelType::Gray32Float, imgdoc2::PixelType::Gray16, 1, float_values, -1000, 3000);
+
+    // the bounds of the window and some values in between are mapped as expected, and NaN is mapped to zero (on all paths)
+    const vector<float> special_values{ -1000, 3000, 1020, numeric_limits<float>::quiet_NaN(), -1e30f, 1e30f, -999, 2999 };
+    for (const auto instruction_set : PixelKernels::GetAvailableInstructionSets())
+    {
+        ASSERT_TRUE(PixelKernels::SetInstructionSet(instruction_set));
+        vector<uint8_t> destination(special_values.size());
+        ASSERT_TRUE(PixelKernels::ConvertWithWindow(imgdoc2::PixelType::Gray32Float, special_values.data(), static_cast<uint32_t>(special_values.size() * sizeof(float)), static_cast<uint32_t>(special_values.size()), 1, -1000, 3000, imgdoc2::PixelType::Gray8, destination.data(), static_cast<uint32_t>(destination.size())));
+        EXPECT_THAT(destination, ElementsAre(0, 255, 129, 0, 0, 255, 0, 255)) << "instruction set " << static_cast<int>(instruction_set);
+    }
+
+    uint16_t value = 0;
+    uint8_t result = 0;
+    EXPECT_FALSE(PixelKernels::ConvertWithWindow(imgdoc2::PixelType::Gray16, &value, 2, 1, 1, 10, 10, imgdoc2::PixelType::Gray8, &result, 1));
+    EXPECT_FALSE(PixelKernels::ConvertWithWindow(imgdoc2::PixelType::Gray16, &value, 2, 1, 1, 0, 10, imgdoc2::PixelType::Gray16, &result, 1));
+}
+
+TEST(PixelKernels, ConvertWithWindowAndWithLookUpTableAndCheckThatResultsAreIdentical)
+{
+    InstructionSetRestorer instruction_set_restorer;
+
+    // the window is chosen so that the scale is 1/256, i.e. the calculation is exact with single and with double precision,
+    //  so the look-up table (calculated with double precision) must give identical results for all 65536 values
+    constexpr double kWindowMinimum = 1000;
+    constexpr double kWindowMaximum = 1000 + 255 * 256;
+    vector<uint16_t> all_values(65536);
+    for (size_t i = 0; i < all_values.size(); ++i)
+    {
+        all_values[i] = static_cast<uint16_t>(i);
+    }
+
+    vector<uint8_t> look_up_table(65536);
+    ASSERT_TRUE(PixelKernels::FillWindowLookUpTable(kWindowMinimum, kWindowMaximum, 1, look_up_table.data()));
+    vector<uint8_t> result_with_look_up_table(all_values.size());
+    ASSERT_TRUE(PixelKernels::ConvertWithLookUpTable(imgdoc2::PixelType::Gray16, all_values.data(), 256 * 2, 256, 256, look_up_table.data(), result_with_look_up_table.data(), 256));
+    EXPECT_EQ(result_with_look_up_table, look_up_table);
+    for (const auto instruction_set : PixelKernels::GetAvailableInstructionSets())
+    {
+        ASSERT_TRUE(PixelKernels::SetInstructionSet(instruction_set));
+        vector<uint8_t> result_with_window(all_values.size());
+        ASSERT_TRUE(PixelKernels::ConvertWithWindow(imgdoc2::PixelType::Gray16, all_values.data(), 256 * 2, 256, 256, kWindowMinimum, kWindowMaximum, imgdoc2::PixelType::Gray8, result_with_window.data(), 256));
+        EXPECT_EQ(result_with_window, result_with_look_up_table) << "instruction set " << static_cast<int>(instruction_set);
+    }
+
+    // with Bgr48, the look-up table is applied to each channel (note that 65535 is within the window, and mapped to
+    //  64535 / 256 = 252.09)
+    const vector<uint16_t> bgr_pixel{ 0, 1000 + 128 * 256, 65535 };
+    uint8_t bgr_result[3];
+    ASSERT_TRUE(PixelKernels::ConvertWithLookUpTable(imgdoc2::PixelType::Bgr48, bgr_pixel.data(), 6, 1, 1, look_up_table.data(), bgr_result, 3));
+    EXPECT_THAT(bgr_result, ElementsAre(0, 128, 252));
+}
+
+TEST(PixelKernels, FillWindowLookUpTableWithGammaAndCheckResult)
+{
+    vector<uint8_t> look_up_table(65536);
+
+    // with gamma 2, the value 33268 (just above the middle of the window) is mapped to 255 * 0.5^2 = 63.75 (plus a tiny bit),
+    //  and values outside of the window are clamped
+    ASSERT_TRUE(PixelKernels::FillWindowLookUpTable(1000, 65535, 2, look_up_table.data()));
+    EXPECT_EQ(look_up_table[0], 0);
+    EXPECT_EQ(look_up_table[1000], 0);
+    EXPECT_EQ(look_up_table[33268], 64);
+    EXPECT_EQ(look_up_table[65535], 255);
+
+    // with gamma 0.5, the value at a quarter of the window is mapped to 255 * 0.25^0.5 = 127.5, which is rounded up
+    ASSERT_TRUE(PixelKernels::FillWindowLookUpTable(0, 4000, 0.5, look_up_table.data()));
+    EXPECT_EQ(look_up_table[0], 0);
+    EXPECT_EQ(look_up_table[1000], 128);
+    EXPECT_EQ(look_up_table[999], 127);
+    EXPECT_EQ(look_up_table[4000], 255);
+    EXPECT_EQ(look_up_table[65535], 255);
+
+    // the table is monotonic for any gamma
+    for (const double gamma : { 0.3, 1.0, 2.2 })
+    {
+        ASSERT_TRUE(PixelKernels::FillWindowLookUpTable(100, 60000, gamma, look_up_table.data()));
+        EXPECT_TRUE(is_sorted(look_up_table.cbegin(), look_up_table.cend())) << "gamma " << gamma;
+        EXPECT_EQ(look_up_table[100], 0) << "gamma " << gamma;
+        EXPECT_EQ(look_up_table[60000], 255) << "gamma " << gamma;
+    }
+
+    EXPECT_FALSE(PixelKernels::FillWindowLookUpTable(0, 4000, 0, look_up_table.data()));
+    EXPECT_FALSE(PixelKernels::FillWindowLookUpTable(0, 4000, -1, look_up_table.data()));
+    EXPECT_FALSE(PixelKernels::FillWindowLookUpTable(4000, 4000, 1, look_up_table.data()));
+}
@@ -0,0 +1,212 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <imgdoc2.h>
+#include "../imgdoc2API/planeslicerenderer.h"
+#include "utilities.h"
+
+using namespace std;
+using namespace imgdoc2;
+using namespace testing;
+
+namespace
+{
+    /// Renders the specified slice into a newly allocated bitmap (without padding).
+    template <typename t_pixel>
+    vector<t_pixel> RenderSlice(
+        const shared_ptr<IDocRead3d>& reader,
+        const PlaneSliceRenderer::SliceGeometry& geometry,
+        uint8_t pixel_type,
+        PlaneSliceRenderer::SamplingFilter filter,
+        double background_value,
+        uint32_t width,
+        uint32_t height)
+    {
+        PlaneSliceRenderer::Options options;
+        options.pixel_type = pixel_type;
+        options.filter = filter;
+        options.background_value = background_value;
+        options.max_number_of_threads = 2;
+        vector<t_pixel> bitmap(static_cast<size_t>(width) * height);
+        PlaneSliceRenderer::DestinationBitmap destination;
+        destination.data = bitmap.data();
+        destination.width = width;
+        destination.height = height;
+        destination.stride = width * sizeof(t_pixel);
+        PlaneSliceRenderer renderer(reader);
+        renderer.Render(geometry, nullptr, options, destination);
+        return bitmap;
+    }
+}
+
+TEST(PlaneSliceRenderer, RenderAxisAlignedSlicesAndCompareToBrickData)
+{
+    // a Gray8-brick of 5x4x3 voxels with random content, located at (10,20,30) with one voxel per logical unit
+    constexpr uint32_t kWidth = 5, kHeight = 4, kDepth = 3;
+    const auto document = CreateInMemoryDocument3d();
+    const auto brick_data = CreateRandomBytes(static_cast<size_t>(kWidth) * kHeight * kDepth, 32);
+    AddUncompressedBrick(
+        document->GetWriter3d().get(),
+        TileCoordinate({ { 'C', 0 }, { 'M', 0 } }),
+        LogicalPositionInfo3D(10, 20, 30, kWidth, kHeight, kDepth),
+        PixelType::Gray8,
+        kWidth,
+        kHeight,
+        kDepth,
+        brick_data);
+    const auto reader = document->GetReader3d();
+    const auto get_voxel = [&](uint32_t x, uint32_t y, uint32_t z)->uint8_t { return brick_data[(static_cast<size_t>(z) * kHeight + y) * kWidth + x]; };
+
+    // the samples are taken exactly at the voxel centers, so nearest neighbor and trilinear interpolation must give the
+    //  voxels of the brick unchanged
+    for (const auto filter : { PlaneSliceRenderer::SamplingFilter::NearestNeighbor, PlaneSliceRenderer::SamplingFilter::Trilinear })
+    {
+        // XY-slices through the center of each plane of the brick
+        for (uint32_t z = 0; z < kDepth; ++z)
+        {
+            PlaneSliceRenderer::SliceGeometry geometry;
+            geometry.plane = Plane_NormalAndDistD(Vector3dD(0, 0, 1), 30 + z + 0.5);
+            geometry.axis_u = Vector3dD(1, 0, 0);
+            geometry.axis_v = Vector3dD(0, 1, 0);
+            geometry.region = RectangleD(10, 20, kWidth, kHeight);
+            vector<uint8_t> expected_result;
+            for (uint32_t y = 0; y < kHeight; ++y)
+            {
+                for (uint32_t x = 0; x < kWidth; ++x)
+                {
+                    expected_result.push_back(get_voxel(x, y, z));
+                }
+            }
+
+            EXPECT_EQ(RenderSlice<uint8_t>(reader, geometry, PixelType::Gray8, filter, 0, kWidth, kHeight), expected_result) << "XY-slice " << z << ", filter " << static_cast<int>(filter);
+        }
+
+        // XZ-slices through the center of each row of the brick
+        for (uint32_t y = 0; y < kHeight; ++y)
+        {
+            PlaneSliceRenderer::SliceGeometry geometry;
+            geometry.plane = Plane_NormalAndDistD(Vector3dD(0, 1, 0), 20 + y + 0.5);
+            geometry.axis_u = Vector3dD(1, 0, 0);
+            geometry.axis_v = Vector3dD(0, 0, 1);
+            geometry.region = RectangleD(10, 30, kWidth, kDepth);
+            vector<uint8_t> expected_result;
+            for (uint32_t z = 0; z < kDepth; ++z)
+            {
+                for (uint32_t x = 0; x < kWidth; ++x)
+                {
+                    expected_result.push_back(get_voxel(x, y, z));
+                }
+            }
+
+            EXPECT_EQ(RenderSlice<uint8_t>(reader, geometry, PixelType::Gray8, filter, 0, kWidth, kDepth), expected_result) << "XZ-slice " << y << ", filter " << static_cast<int>(filter);
+        }
+
+        // YZ-slices through the center of each column of the brick (here the destination's x-axis is running along the
+        //  y-axis of the brick, so the voxels are not contiguous in memory)
+        for (uint32_t x = 0; x < kWidth; ++x)
+        {
+            PlaneSliceRenderer::SliceGeometry geometry;
+            geometry.plane = Plane_NormalAndDistD(Vector3dD(1, 0, 0), 10 + x + 0.5);
+            geometry.axis_u = Vector3dD(0, 1, 0);
+            geometry.axis_v = Vector3dD(0, 0, 1);
+            geometry.region = RectangleD(20, 30, kHeight, kDepth);
+            vector<uint8_t> expected_result;
+            for (uint32_t z = 0; z < kDepth; ++z)
+            {
+                for (uint32_t y = 0; y < kHeight; ++y)
+                {
+                    expected_result.push_back(get_voxel(x, y, z));
+                }
+            }
+
+            EXPECT_EQ(RenderSlice<uint8_t>(reader, geometry, PixelType::Gray8, filter, 0, kHeight, kDepth), expected_result) << "YZ-slice " << x << ", filter " << static_cast<int>(filter);
+        }
+    }
+}
+
+TEST(PlaneSliceRenderer, RenderObliqueSliceWithTrilinearInterpolationAndCheckResult)
+{
+    // a Gray32Float-brick of 8x8x8 voxels at the origin (one voxel per logical unit), where the value of a voxel is a linear
+    //  function of its indices - trilinear interpolation reproduces a linear function exactly, so the expected value at a
+    //  point p (with the voxel-coordinate p - 0.5) is known
+    constexpr uint32_t kSize = 8;
+    const auto value_function = [](double x, double y, double z)->double { return 1 + 2 * x + 3 * y + 5 * z; };
+    const auto document = CreateInMemoryDocument3d();
+    AddUncompressedBrick(
+        document->GetWriter3d().get(),
+        TileCoordinate({ { 'C', 0 }, { 'M', 0 } }),
+        LogicalPositionInfo3D(0, 0, 0, kSize, kSize, kSize),
+        PixelType::Gray32Float,
+        kSize,
+        kSize,
+        kSize,
+        CreateBitmap(PixelType::Gray32Float, kSize, kSize * kSize, [&](uint32_t x, uint32_t y, int)->double { return value_function(x, y % kSize, y / kSize); }));
+
+    // the plane is going through the center of the brick (4,4,4) and is perpendicular to (1,1,1) (as the normal is not
+    //  normalized, the distance is dot((4,4,4), (1,1,1)) = 12) - the in-plane axes are chosen so that all three
+    //  voxel-coordinates are varying along the lines of the destination, and the region is chosen so that all samples are
+    //  inside the brick (and not within the outermost half voxel, where the interpolation is clamped)
+    PlaneSliceRenderer::SliceGeometry geometry;
+    geometry.plane = Plane_NormalAndDistD(Vector3dD(1, 1, 1), 12);
+    geometry.axis_u = Vector3dD(1, -2, 1);
+    geometry.axis_v = Vector3dD(1, 0, -1);
+    geometry.region = RectangleD(-1.5, -1.5, 3, 3);
+    constexpr uint32_t kDestinationSize = 7;
+    const auto result = RenderSlice<float>(document->GetReader3d(), geometry, PixelType::Gray32Float, PlaneSliceRenderer::SamplingFilter::Trilinear, 0, kDestinationSize, kDestinationSize);
+
+    const double length_u = sqrt(6.0);
+    const double length_v = sqrt(2.0);
+    for (uint32_t j = 0; j < kDestinationSize; ++j)
+    {
+        for (uint32_t i = 0; i < kDestinationSize; ++i)
+        {
+            const double s = -1.5 + (i + 0.5) * 3 / kDestinationSize;
+            const double t = -1.5 + (j + 0.5) * 3 / kDestinationSize;
+            const double x = 4 + s * 1 / length_u + t * 1 / length_v;
+            const double y = 4 + s * -2 / length_u;
+            const double z = 4 + s * 1 / length_u + t * -1 / length_v;
+            EXPECT_NEAR(result[static_cast<size_t>(j) * kDestinationSize + i], value_function(x - 0.5, y - 0.5, z - 0.5), 1e-3) << "pixel (" << i << "," << j << ")";
+        }
+    }
+}
+
+TEST(PlaneSliceRenderer, RenderSliceExtendingBeyondBrickAndCheckBackground)
+{
+    // a uniform Gray16-brick covering [0,4) x [0,4) x [0,4), with two voxels per logical unit
+    const auto document = CreateInMemoryDocument3d();
+    AddUncompressedBrick(
+        document->GetWriter3d().get(),
+        TileCoordinate({ { 'C', 0 }, { 'M', 0 } }),
+        LogicalPositionInfo3D(0, 0, 0, 4, 4, 4),
+        PixelType::Gray16,
+        8,
+        8,
+        8,
+        CreateBitmap(PixelType::Gray16, 8, 64, [](uint32_t, uint32_t, int)->double { return 1000; }));
+
+    // the XY-slice at z=1 covers [-2,6) x [-2,6) with 8x8 pixels, so only the inner 4x4 pixels are within the brick
+    PlaneSliceRenderer::SliceGeometry geometry;
+    geometry.plane = Plane_NormalAndDistD(Vector3dD(0, 0, 1), 1);
+    geometry.axis_u = Vector3dD(1, 0, 0);
+    geometry.axis_v = Vector3dD(0, 1, 0);
+    geometry.region = RectangleD(-2, -2, 8, 8);
+    const auto result = RenderSlice<uint16_t>(document->GetReader3d(), geometry, PixelType::Gray16, PlaneSliceRenderer::SamplingFilter::Trilinear, 42, 8, 8);
+    for (uint32_t y = 0; y < 8; ++y)
+    {
+        for (uint32_t x = 0; x < 8; ++x)
+        {
+            const bool is_inside = x >= 2 && x < 6 && y >= 2 && y < 6;
+            EXPECT_EQ(result[static_cast<size_t>(y) * 8 + x], is_inside ? 1000 : 42) << "pixel (" << x << "," << y << ")";
+        }
+    }
+
+    // a slice which does not intersect the brick is filled with the background entirely
+    geometry.plane.distance = 5;
+    EXPECT_THAT(RenderSlice<uint16_t>(document->GetReader3d(), geometry, PixelType::Gray16, PlaneSliceRenderer::SamplingFilter::NearestNeighbor, 42, 8, 8), Each(42));
+}
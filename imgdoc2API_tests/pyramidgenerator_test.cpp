@@ -0,0 +1,185 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+#include <imgdoc2.h>
+#include "../imgdoc2API/pyramidgenerator.h"
+#include "../imgdoc2API/regioncompositor.h"
+#include "utilities.h"
+
+using namespace std;
+using namespace imgdoc2;
+using namespace testing;
+
+namespace
+{
+    /// The geometry of a tile - its logical rectangle and its size in pixels.
+    typedef tuple<double, double, double, double, uint32_t, uint32_t> TileGeometry;
+
+    vector<TileGeometry> GetTileGeometriesOnPyramidLevel(IDocRead2d* reader, int plane_c, int pyramid_level)
+    {
+        CDimCoordinateQueryClause plane_clause;
+        plane_clause.AddRangeClause('C', IDimCoordinateQueryClause::RangeClause{ plane_c, plane_c });
+        CTileInfoQueryClause level_clause;
+        level_clause.AddPyramidLevelCondition(LogicalOperator::Invalid, ComparisonOperation::Equal, pyramid_level);
+        vector<dbIndex> indices;
+        reader->Query(&plane_clause, &level_clause, [&indices](dbIndex index)->bool { indices.push_back(index); return true; });
+
+        vector<TileGeometry> geometries;
+        for (const auto index : indices)
+        {
+            LogicalPositionInfo position;
+            TileBlobInfo blob_info;
+            reader->ReadTileInfo(index, nullptr, &position, &blob_info);
+            geometries.emplace_back(position.posX, position.posY, position.width, position.height, blob_info.base_info.pixelWidth, blob_info.base_info.pixelHeight);
+        }
+
+        return geometries;
+    }
+
+    /// Renders the specified pyramid level of a plane (without resampling, i.e. at the resolution of the level).
+    vector<uint8_t> RenderPyramidLevel(const shared_ptr<IDocRead2d>& reader, int plane_c, int pyramid_level, uint32_t width, uint32_t height)
+    {
+        CDimCoordinateQueryClause plane_clause;
+        plane_clause.AddRangeClause('C', IDimCoordinateQueryClause::RangeClause{ plane_c, plane_c });
+        RegionCompositor::Options options;
+        options.pixel_type = PixelType::Gray8;
+        options.pyramid_level = pyramid_level;
+        vector<uint8_t> bitmap(static_cast<size_t>(width) * height);
+        RegionCompositor::DestinationBitmap destination;
+        destination.data = bitmap.data();
+        destination.width = width;
+        destination.height = height;
+        destination.stride = width;
+        const double logical_units_per_pixel = 1 << pyramid_level;
+        RegionCompositor compositor(reader);
+        compositor.Compose(RectangleD(0, 0, width * logical_units_per_pixel, height * logical_units_per_pixel), &plane_clause, options, destination);
+        return bitmap;
+    }
+
+    /// Downscales a Gray8-bitmap by a factor of 2 by averaging (rounded to nearest), where pixels outside of the source are
+    /// taken as zero (which is the background used by the pyramid generator).
+    vector<uint8_t> DownscaleReference(const vector<uint8_t>& source, uint32_t width, uint32_t height, uint32_t& destination_width, uint32_t& destination_height)
+    {
+        destination_width = (width + 1) / 2;
+        destination_height = (height + 1) / 2;
+        vector<uint8_t> destination(static_cast<size_t>(destination_width) * destination_height);
+        for (uint32_t y = 0; y < destination_height; ++y)
+        {
+            for (uint32_t x = 0; x < destination_width; ++x)
+            {
+                uint32_t sum = 0;
+                for (uint32_t v = 2 * y; v < 2 * y + 2; ++v)
+                {
+                    for (uint32_t u = 2 * x; u < 2 * x + 2; ++u)
+                    {
+                        sum += (u < width && v < height) ? source[static_cast<size_t>(v) * width + u] : 0;
+                    }
+                }
+
+                destination[static_cast<size_t>(y) * destination_width + x] = static_cast<uint8_t>((sum + 2) / 4);
+            }
+        }
+
+        return destination;
+    }
+}
+
+TEST(PyramidGenerator, GeneratePyramidWithOddSizesAndCheckGeometryAndPixels)
+{
+    const auto document = CreateInMemoryDocument2d();
+    const auto writer = document->GetWriter2d();
+    const auto reader = document->GetReader2d();
+
+    // the plane C=0 consists of two level-0 tiles of 5x6 pixels, i.e. it is 10x6 pixels in total
+    const auto value_function = [](uint32_t x, uint32_t y)->uint8_t { return static_cast<uint8_t>(x * 20 + y * 7 + 1); };
+    vector<uint8_t> level0(10 * 6);
+    for (uint32_t y = 0; y < 6; ++y)
+    {
+        for (uint32_t x = 0; x < 10; ++x)
+        {
+            level0[static_cast<size_t>(y) * 10 + x] = value_function(x, y);
+        }
+    }
+
+    for (uint32_t column = 0; column < 2; ++column)
+    {
+        AddUncompressedTile(
+            writer.get(),
+            TileCoordinate({ { 'C', 0 }, { 'M', static_cast<int>(column) } }),
+            LogicalPositionInfo(column * 5, 0, 5, 6),
+            PixelType::Gray8,
+            5,
+            6,
+            CreateBitmap(PixelType::Gray8, 5, 6, [&](uint32_t x, uint32_t y, int)->double { return value_function(column * 5 + x, y); }));
+    }
+
+    // the plane C=1 consists of a single uniform tile of 4x4 pixels
+    AddUncompressedTile(writer.get(), TileCoordinate({ { 'C', 1 }, { 'M', 0 } }), LogicalPositionInfo(0, 0, 4, 4), PixelType::Gray8, 4, 4, CreateBitmap(PixelType::Gray8, 4, 4, [](uint32_t, uint32_t, int)->double { return 77; }));
+
+    // the output tiles are 2x2 pixels, and the batches are small so that multiple batches are processed
+    PyramidGenerator::Options options;
+    options.minification_factor = 2;
+    options.number_of_levels = 2;
+    options.tile_width = 2;
+    options.tile_height = 2;
+    options.max_number_of_threads = 3;
+    options.tiles_per_batch = 4;
+    PyramidGenerator pyramid_generator(reader, writer);
+    pyramid_generator.Generate(options);
+
+    // level 1 of plane C=0 has 5x3 pixels, i.e. it is covered by 3x2 tiles, where the tiles in the last column are 1 pixel
+    //  wide and the tiles in the last row are 1 pixel high
+    EXPECT_THAT(
+        GetTileGeometriesOnPyramidLevel(reader.get(), 0, 1),
+        UnorderedElementsAre(
+            TileGeometry(0, 0, 4, 4, 2, 2), TileGeometry(4, 0, 4, 4, 2, 2), TileGeometry(8, 0, 2, 4, 1, 2),
+            TileGeometry(0, 4, 4, 2, 2, 1), TileGeometry(4, 4, 4, 2, 2, 1), TileGeometry(8, 4, 2, 2, 1, 1)));
+
+    // level 2 has 3x2 pixels (where the last column is covering the area beyond the right edge of level 1)
+    EXPECT_THAT(
+        GetTileGeometriesOnPyramidLevel(reader.get(), 0, 2),
+        UnorderedElementsAre(TileGeometry(0, 0, 8, 8, 2, 2), TileGeometry(8, 0, 4, 8, 1, 2)));
+
+    uint32_t level1_width, level1_height, level2_width, level2_height;
+    const auto expected_level1 = DownscaleReference(level0, 10, 6, level1_width, level1_height);
+    const auto expected_level2 = DownscaleReference(expected_level1, level1_width, level1_height, level2_width, level2_height);
+    ASSERT_EQ(level1_width, 5u);
+    ASSERT_EQ(level1_height, 3u);
+    ASSERT_EQ(level2_width, 3u);
+    ASSERT_EQ(level2_height, 2u);
+    EXPECT_EQ(RenderPyramidLevel(reader, 0, 1, level1_width, level1_height), expected_level1);
+    EXPECT_EQ(RenderPyramidLevel(reader, 0, 2, level2_width, level2_height), expected_level2);
+
+    // the plane C=1 is processed independently
+    EXPECT_THAT(GetTileGeometriesOnPyramidLevel(reader.get(), 1, 1), ElementsAre(TileGeometry(0, 0, 4, 4, 2, 2)));
+    EXPECT_THAT(GetTileGeometriesOnPyramidLevel(reader.get(), 1, 2), ElementsAre(TileGeometry(0, 0, 4, 4, 1, 1)));
+    EXPECT_THAT(RenderPyramidLevel(reader, 1, 1, 2, 2), Each(77));
+    EXPECT_THAT(RenderPyramidLevel(reader, 1, 2, 1, 1), Each(77));
+
+    // existing pyramid levels are not modified, i.e. running the operation again (with one more level) only adds level 3
+    options.number_of_levels = 3;
+    pyramid_generator.Generate(options);
+    EXPECT_EQ(GetTileGeometriesOnPyramidLevel(reader.get(), 0, 1).size(), 6u);
+    EXPECT_EQ(GetTileGeometriesOnPyramidLevel(reader.get(), 0, 2).size(), 2u);
+    EXPECT_THAT(GetTileGeometriesOnPyramidLevel(reader.get(), 0, 3), ElementsAre(TileGeometry(0, 0, 16, 8, 2, 1)));
+}
+
+TEST(PyramidGenerator, GeneratePyramidWithInvalidOptionsAndExpectException)
+{
+    const auto document = CreateInMemoryDocument2d();
+    PyramidGenerator pyramid_generator(document->GetReader2d(), document->GetWriter2d());
+
+    PyramidGenerator::Options options;
+    options.minification_factor = 1;
+    EXPECT_THROW(pyramid_generator.Generate(options), invalid_argument_exception);
+
+    options.minification_factor = 2;
+    options.tile_width = 0;
+    EXPECT_THROW(pyramid_generator.Generate(options), invalid_argument_exception);
+}
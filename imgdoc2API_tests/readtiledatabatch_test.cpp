@@ -0,0 +1,228 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <imgdoc2.h>
+#include "../imgdoc2API/imgdoc2API.h"
+#include "../imgdoc2API/sharedptrwrapper.h"
+#include "../imgdoc2API/utilities.h"
+#include "utilities.h"
+
+using namespace std;
+using namespace imgdoc2;
+using namespace testing;
+
+namespace
+{
+    int number_of_allocations = 0;
+    bool fail_allocation = false;
+
+    bool LIBIMGDOC2_STDCALL AllocateMemory(uint64_t size, AllocationObject* allocation_object)
+    {
+        ++number_of_allocations;
+        if (fail_allocation)
+        {
+            return false;
+        }
+
+        allocation_object->pointer_to_memory = malloc(static_cast<size_t>(size));
+        allocation_object->handle = reinterpret_cast<intptr_t>(allocation_object->pointer_to_memory);
+        return true;
+    }
+
+    /// Checks the entry for a tile and (if the tile was read successfully) that the memory block contains the expected data at the reported offset.
+    void CheckEntry(const TileDataBatchEntryInterop& entry, ImgDoc2ErrorCode expected_result, uint64_t expected_offset, const vector<uint8_t>& expected_data, const void* memory_block, size_t index)
+    {
+        EXPECT_EQ(entry.result, expected_result) << "entry " << index;
+        EXPECT_EQ(entry.size, expected_data.size()) << "entry " << index;
+        if (expected_result == ImgDoc2_ErrorCode_OK)
+        {
+            EXPECT_EQ(entry.offset, expected_offset) << "entry " << index;
+            const auto* data = static_cast<const uint8_t*>(memory_block) + entry.offset;
+            EXPECT_EQ(vector<uint8_t>(data, data + entry.size), expected_data) << "entry " << index;
+        }
+    }
+
+    /// The fixture is creating a 2D-document with four Gray8-tiles of 15, 40, 16 and 8 bytes, and a handle of a reader
+    /// object for it (which can be used with the functions of imgdoc2API).
+    class ReadTileDataBatch : public Test
+    {
+    protected:
+        void SetUp() override
+        {
+            this->document_ = CreateInMemoryDocument2d();
+            const auto writer = this->document_->GetWriter2d();
+            const uint32_t tile_sizes[4][2] = { { 5, 3 }, { 8, 5 }, { 4, 4 }, { 8, 1 } };
+            for (int i = 0; i < 4; ++i)
+            {
+                this->tile_data_.push_back(CreateRandomBytes(static_cast<size_t>(tile_sizes[i][0]) * tile_sizes[i][1], 10 + i));
+                this->tile_pks_.push_back(AddUncompressedTile(
+                    writer.get(),
+                    TileCoordinate({ { 'C', 0 }, { 'M', i } }),
+                    LogicalPositionInfo(i * 10, 0, tile_sizes[i][0], tile_sizes[i][1]),
+                    PixelType::Gray8,
+                    tile_sizes[i][0],
+                    tile_sizes[i][1],
+                    this->tile_data_.back()));
+            }
+
+            this->reader_wrapper_ = make_unique<SharedPtrWrapper<IDocRead2d>>(this->document_->GetReader2d());
+            number_of_allocations = 0;
+            fail_allocation = false;
+        }
+
+        HandleDocRead2D GetReaderHandle() const
+        {
+            return reinterpret_cast<HandleDocRead2D>(this->reader_wrapper_.get());
+        }
+
+        shared_ptr<IDoc> document_;
+        vector<vector<uint8_t>> tile_data_;
+        vector<int64_t> tile_pks_;
+        unique_ptr<SharedPtrWrapper<IDocRead2d>> reader_wrapper_;
+    };
+}
+
+TEST_F(ReadTileDataBatch, ReadIntoArenaWhichIsTooSmallAndCheckResultOfEachTile)
+{
+    // the arena has 72 bytes - the first two tiles are placed at the offsets 0 and 16 (so 56 bytes are used), the third
+    //  tile (16 bytes at offset 64) does not fit, the fourth primary key is not existing, and the last tile (8 bytes)
+    //  fits exactly into the remaining space
+    const vector<int64_t> pks{ this->tile_pks_[0], this->tile_pks_[1], this->tile_pks_[2], 12345, this->tile_pks_[3] };
+    vector<uint8_t> arena(72, 0xcc);
+    vector<TileDataBatchEntryInterop> entries(pks.size());
+    ImgDoc2ErrorInformation error_information;
+    error_information.message[0] = '\0';
+    const auto error_code = IDocRead2d_ReadTileDataBatch(
+        this->GetReaderHandle(),
+        pks.data(),
+        static_cast<uint32_t>(pks.size()),
+        arena.data(),
+        arena.size(),
+        nullptr,
+        nullptr,
+        entries.data(),
+        &error_information);
+
+    // the error of the first failed tile is reported, and the other tiles are read nevertheless
+    EXPECT_EQ(error_code, ImgDoc2_ErrorCode_AllocationError);
+    EXPECT_GT(strlen(error_information.message), 0u);
+    CheckEntry(entries[0], ImgDoc2_ErrorCode_OK, 0, this->tile_data_[0], arena.data(), 0);
+    CheckEntry(entries[1], ImgDoc2_ErrorCode_OK, 16, this->tile_data_[1], arena.data(), 1);
+    CheckEntry(entries[2], ImgDoc2_ErrorCode_AllocationError, 0, this->tile_data_[2], arena.data(), 2);
+    CheckEntry(entries[3], ImgDoc2_Invalid_TileId, 0, {}, arena.data(), 3);
+    CheckEntry(entries[4], ImgDoc2_ErrorCode_OK, 64, this->tile_data_[3], arena.data(), 4);
+
+    // the gap used for the alignment is not touched
+    EXPECT_THAT(vector<uint8_t>(arena.cbegin() + 15, arena.cbegin() + 16), Each(0xcc));
+    EXPECT_THAT(vector<uint8_t>(arena.cbegin() + 56, arena.cbegin() + 64), Each(0xcc));
+    EXPECT_EQ(number_of_allocations, 0);
+}
+
+TEST_F(ReadTileDataBatch, ReadWithAllocatorAndWithArenaAndCompareResults)
+{
+    const vector<int64_t> pks{ this->tile_pks_[3], 12345, this->tile_pks_[1], this->tile_pks_[0], this->tile_pks_[2], this->tile_pks_[1] };
+    const vector<int> expected_tiles{ 3, -1, 1, 0, 2, 1 };
+
+    // without an arena, the memory block is allocated with one call (with the size of all tiles, including the gaps
+    //  used for the alignment) - here the tiles are placed at 0, 16, 64, 80 and 96, i.e. 136 bytes are allocated
+    vector<TileDataBatchEntryInterop> entries_allocator(pks.size());
+    AllocationObject allocation_object{};
+    auto error_code = IDocRead2d_ReadTileDataBatch(this->GetReaderHandle(), pks.data(), static_cast<uint32_t>(pks.size()), nullptr, 0, AllocateMemory, &allocation_object, entries_allocator.data(), nullptr);
+    EXPECT_EQ(error_code, ImgDoc2_Invalid_TileId);
+    EXPECT_EQ(number_of_allocations, 1);
+    ASSERT_NE(allocation_object.pointer_to_memory, nullptr);
+    const vector<uint64_t> expected_offsets{ 0, 0, 16, 64, 80, 96 };
+    for (size_t i = 0; i < pks.size(); ++i)
+    {
+        if (expected_tiles[i] < 0)
+        {
+            CheckEntry(entries_allocator[i], ImgDoc2_Invalid_TileId, 0, {}, nullptr, i);
+        }
+        else
+        {
+            CheckEntry(entries_allocator[i], ImgDoc2_ErrorCode_OK, expected_offsets[i], this->tile_data_[expected_tiles[i]], allocation_object.pointer_to_memory, i);
+        }
+    }
+
+    // with an arena which is large enough, the tiles are placed in the same way
+    vector<uint8_t> arena(136);
+    vector<TileDataBatchEntryInterop> entries_arena(pks.size());
+    error_code = IDocRead2d_ReadTileDataBatch(this->GetReaderHandle(), pks.data(), static_cast<uint32_t>(pks.size()), arena.data(), arena.size(), AllocateMemory, &allocation_object, entries_arena.data(), nullptr);
+    EXPECT_EQ(error_code, ImgDoc2_Invalid_TileId);
+    EXPECT_EQ(number_of_allocations, 1);
+    for (size_t i = 0; i < pks.size(); ++i)
+    {
+        EXPECT_EQ(entries_arena[i].result, entries_allocator[i].result) << "entry " << i;
+        EXPECT_EQ(entries_arena[i].offset, entries_allocator[i].offset) << "entry " << i;
+        EXPECT_EQ(entries_arena[i].size, entries_allocator[i].size) << "entry " << i;
+        if (entries_arena[i].result == ImgDoc2_ErrorCode_OK)
+        {
+            EXPECT_EQ(memcmp(arena.data() + entries_arena[i].offset, static_cast<const uint8_t*>(allocation_object.pointer_to_memory) + entries_allocator[i].offset, entries_arena[i].size), 0) << "entry " << i;
+        }
+    }
+
+    free(allocation_object.pointer_to_memory);
+
+    // if the allocation fails, this is reported (and no memory block is returned)
+    fail_allocation = true;
+    error_code = IDocRead2d_ReadTileDataBatch(this->GetReaderHandle(), pks.data(), static_cast<uint32_t>(pks.size()), nullptr, 0, AllocateMemory, &allocation_object, entries_allocator.data(), nullptr);
+    EXPECT_EQ(error_code, ImgDoc2_ErrorCode_AllocationError);
+    EXPECT_EQ(allocation_object.pointer_to_memory, nullptr);
+
+    // if there is no data at all, nothing is allocated
+    const int64_t non_existing_pk = 12345;
+    error_code = IDocRead2d_ReadTileDataBatch(this->GetReaderHandle(), &non_existing_pk, 1, nullptr, 0, AllocateMemory, &allocation_object, entries_allocator.data(), nullptr);
+    EXPECT_EQ(error_code, ImgDoc2_Invalid_TileId);
+    EXPECT_EQ(allocation_object.pointer_to_memory, nullptr);
+    EXPECT_EQ(number_of_allocations, 2);
+
+    // without an arena, the allocation function must be given
+    error_code = IDocRead2d_ReadTileDataBatch(this->GetReaderHandle(), pks.data(), static_cast<uint32_t>(pks.size()), nullptr, 0, nullptr, &allocation_object, entries_allocator.data(), nullptr);
+    EXPECT_EQ(error_code, ImgDoc2_ErrorCode_InvalidArgument);
+}
+
+TEST(BlobOutputIntoArena, ReserveBlobsAndCheckPlacementAndRejection)
+{
+    vector<uint8_t> arena(40, 0);
+    Utilities::BlobOutputIntoArena blob_output(arena.data(), arena.size());
+
+    // the first blob is placed at the start of the arena, the next one at the next multiple of the alignment
+    EXPECT_TRUE(blob_output.Reserve(3));
+    EXPECT_TRUE(blob_output.SetData(0, 3, "abc"));
+    EXPECT_EQ(blob_output.GetBlobOffset(), 0u);
+    EXPECT_EQ(blob_output.GetBlobSize(), 3u);
+    EXPECT_FALSE(blob_output.GetIsRejected());
+    EXPECT_THROW(blob_output.Reserve(3), logic_error);
+
+    blob_output.BeginBlob();
+    EXPECT_TRUE(blob_output.Reserve(10));
+    EXPECT_TRUE(blob_output.SetData(4, 6, "defghi"));
+    EXPECT_EQ(blob_output.GetBlobOffset(), Utilities::BlobOutputIntoArena::kAlignment);
+    EXPECT_THROW(blob_output.SetData(8, 3, "xyz"), invalid_argument);
+    EXPECT_EQ(memcmp(arena.data(), "abc", 3), 0);
+    EXPECT_EQ(memcmp(arena.data() + 20, "defghi", 6), 0);
+
+    // a blob which does not fit is rejected (and its size is recorded), and writing to it is not possible...
+    blob_output.BeginBlob();
+    EXPECT_FALSE(blob_output.Reserve(9));
+    EXPECT_TRUE(blob_output.GetIsRejected());
+    EXPECT_EQ(blob_output.GetBlobSize(), 9u);
+    EXPECT_THROW(blob_output.SetData(0, 1, "x"), logic_error);
+
+    // ...but a subsequent smaller blob still fits, and after that the arena is full
+    blob_output.BeginBlob();
+    EXPECT_TRUE(blob_output.Reserve(8));
+    EXPECT_EQ(blob_output.GetBlobOffset(), 32u);
+    EXPECT_FALSE(blob_output.GetIsRejected());
+
+    blob_output.BeginBlob();
+    EXPECT_FALSE(blob_output.Reserve(1));
+}
@@ -0,0 +1,246 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <imgdoc2.h>
+#include "../imgdoc2API/imgdoc2API.h"
+#include "../imgdoc2API/regioncompositor.h"
+#include "../imgdoc2API/sharedptrwrapper.h"
+#include "utilities.h"
+
+using namespace std;
+using namespace imgdoc2;
+using namespace testing;
+
+namespace
+{
+    /// Composes the region-of-interest into a (newly allocated) bitmap of pixel type Gray8, without padding.
+    vector<uint8_t> ComposeGray8(const shared_ptr<IDocRead2d>& reader, const RectangleD& roi, const IDimCoordinateQueryClause* plane_clause, RegionCompositor::Options options, uint32_t width, uint32_t height)
+    {
+        vector<uint8_t> bitmap(static_cast<size_t>(width) * height);
+        options.pixel_type = PixelType::Gray8;
+        RegionCompositor::DestinationBitmap destination;
+        destination.data = bitmap.data();
+        destination.width = width;
+        destination.height = height;
+        destination.stride = width;
+        RegionCompositor compositor(reader);
+        compositor.Compose(roi, plane_clause, options, destination);
+        return bitmap;
+    }
+
+    vector<uint8_t> CreateUniformGray8Bitmap(uint32_t width, uint32_t height, uint8_t value)
+    {
+        return CreateBitmap(PixelType::Gray8, width, height, [value](uint32_t, uint32_t, int)->double { return value; });
+    }
+}
+
+TEST(RegionCompositor, ComposeSingleTileWithZoomOneAndCheckResult)
+{
+    const auto document = CreateInMemoryDocument2d();
+    const auto writer = document->GetWriter2d();
+    const auto tile_bitmap = CreateBitmap(PixelType::Gray8, 4, 4, [](uint32_t x, uint32_t y, int)->double { return 1 + x + 4 * y; });
+    AddUncompressedTile(writer.get(), TileCoordinate({ { 'C', 0 }, { 'M', 0 } }), LogicalPositionInfo(10, 20, 4, 4), PixelType::Gray8, 4, 4, tile_bitmap);
+
+    // the destination bitmap has a stride larger than the line length, and the padding bytes must not be modified
+    constexpr uint32_t kStride = 7;
+    constexpr uint8_t kPaddingValue = 0xcd;
+    vector<uint8_t> bitmap(kStride * 4, kPaddingValue);
+    RegionCompositor::Options options;
+    options.pixel_type = PixelType::Gray8;
+    RegionCompositor::DestinationBitmap destination;
+    destination.data = bitmap.data();
+    destination.width = 4;
+    destination.height = 4;
+    destination.stride = kStride;
+    RegionCompositor compositor(document->GetReader2d());
+    compositor.Compose(RectangleD(10, 20, 4, 4), nullptr, options, destination);
+
+    for (uint32_t y = 0; y < 4; ++y)
+    {
+        EXPECT_THAT(vector<uint8_t>(bitmap.begin() + y * kStride, bitmap.begin() + y * kStride + 4), ElementsAreArray(tile_bitmap.data() + y * 4, 4)) << "line " << y;
+        EXPECT_THAT(vector<uint8_t>(bitmap.begin() + y * kStride + 4, bitmap.begin() + (y + 1) * kStride), Each(kPaddingValue)) << "line " << y;
+    }
+}
+
+TEST(RegionCompositor, ComposePartiallyCoveredRegionAndCheckBackground)
+{
+    const auto document = CreateInMemoryDocument2d();
+    const auto writer = document->GetWriter2d();
+    AddUncompressedTile(writer.get(), TileCoordinate({ { 'C', 0 }, { 'M', 0 } }), LogicalPositionInfo(0, 0, 2, 2), PixelType::Gray8, 2, 2, CreateUniformGray8Bitmap(2, 2, 50));
+
+    // the tile covers the pixels (2,2)-(3,3) of the 6x4 destination, everything else is background
+    RegionCompositor::Options options;
+    options.background_value = 7;
+    const auto bitmap = ComposeGray8(document->GetReader2d(), RectangleD(-2, -2, 6, 4), nullptr, options, 6, 4);
+    const vector<uint8_t> expected_result
+    {
+        7, 7,  7,  7, 7, 7,
+        7, 7,  7,  7, 7, 7,
+        7, 7, 50, 50, 7, 7,
+        7, 7, 50, 50, 7, 7,
+    };
+    EXPECT_EQ(bitmap, expected_result);
+
+    // a region without any tiles is filled with the background value
+    options.background_value = 300;   // this is clamped to the range of the pixel type
+    const auto bitmap_without_tiles = ComposeGray8(document->GetReader2d(), RectangleD(100, 100, 3, 3), nullptr, options, 3, 3);
+    EXPECT_THAT(bitmap_without_tiles, Each(255));
+}
+
+TEST(RegionCompositor, ComposeOverlappingTilesAndCheckThatTheyAreDrawnInOrderOfMIndex)
+{
+    const auto document = CreateInMemoryDocument2d();
+    const auto writer = document->GetWriter2d();
+
+    // the first tile is added with the higher M-index, so it is expected to be drawn on top although it has the lower primary key
+    AddUncompressedTile(writer.get(), TileCoordinate({ { 'C', 0 }, { 'M', 1 } }), LogicalPositionInfo(0, 0, 4, 2), PixelType::Gray8, 4, 2, CreateUniformGray8Bitmap(4, 2, 10));
+    AddUncompressedTile(writer.get(), TileCoordinate({ { 'C', 0 }, { 'M', 0 } }), LogicalPositionInfo(2, 0, 4, 2), PixelType::Gray8, 4, 2, CreateUniformGray8Bitmap(4, 2, 20));
+
+    // with the same M-index, the tile added last (i.e. with the higher primary key) is drawn on top
+    AddUncompressedTile(writer.get(), TileCoordinate({ { 'C', 0 }, { 'M', 1 } }), LogicalPositionInfo(5, 0, 2, 2), PixelType::Gray8, 2, 2, CreateUniformGray8Bitmap(2, 2, 30));
+
+    const auto bitmap = ComposeGray8(document->GetReader2d(), RectangleD(0, 0, 8, 1), nullptr, RegionCompositor::Options(), 8, 1);
+    EXPECT_THAT(bitmap, ElementsAre(10, 10, 10, 10, 20, 30, 30, 0));
+}
+
+TEST(RegionCompositor, ComposeWithPlaneClauseAndCheckThatOnlyTilesOfThePlaneAreUsed)
+{
+    const auto document = CreateInMemoryDocument2d();
+    const auto writer = document->GetWriter2d();
+    AddUncompressedTile(writer.get(), TileCoordinate({ { 'C', 0 }, { 'M', 0 } }), LogicalPositionInfo(0, 0, 2, 2), PixelType::Gray8, 2, 2, CreateUniformGray8Bitmap(2, 2, 10));
+    AddUncompressedTile(writer.get(), TileCoordinate({ { 'C', 1 }, { 'M', 0 } }), LogicalPositionInfo(0, 0, 2, 2), PixelType::Gray8, 2, 2, CreateUniformGray8Bitmap(2, 2, 20));
+
+    CDimCoordinateQueryClause plane_clause;
+    plane_clause.AddRangeClause('C', IDimCoordinateQueryClause::RangeClause{ 0, 0 });
+    EXPECT_THAT(ComposeGray8(document->GetReader2d(), RectangleD(0, 0, 2, 2), &plane_clause, RegionCompositor::Options(), 2, 2), Each(10));
+
+    CDimCoordinateQueryClause other_plane_clause;
+    other_plane_clause.AddRangeClause('C', IDimCoordinateQueryClause::RangeClause{ 1, 1 });
+    EXPECT_THAT(ComposeGray8(document->GetReader2d(), RectangleD(0, 0, 2, 2), &other_plane_clause, RegionCompositor::Options(), 2, 2), Each(20));
+}
+
+TEST(RegionCompositor, ComposeWithPyramidAndCheckThatPyramidLevelIsChosenAccordingToZoom)
+{
+    const auto document = CreateInMemoryDocument2d();
+    const auto writer = document->GetWriter2d();
+
+    // the same area is covered by a tile on pyramid level 0 (8x8 pixels), by one on level 1 (4x4 pixels) and by one
+    //  on level 2 (2x2 pixels) - each with a different value, so that we can tell which one was used
+    AddUncompressedTile(writer.get(), TileCoordinate({ { 'C', 0 }, { 'M', 0 } }), LogicalPositionInfo(0, 0, 8, 8, 0), PixelType::Gray8, 8, 8, CreateUniformGray8Bitmap(8, 8, 100));
+    AddUncompressedTile(writer.get(), TileCoordinate({ { 'C', 0 }, { 'M', 0 } }), LogicalPositionInfo(0, 0, 8, 8, 1), PixelType::Gray8, 4, 4, CreateUniformGray8Bitmap(4, 4, 101));
+    AddUncompressedTile(writer.get(), TileCoordinate({ { 'C', 0 }, { 'M', 0 } }), LogicalPositionInfo(0, 0, 8, 8, 2), PixelType::Gray8, 2, 2, CreateUniformGray8Bitmap(2, 2, 102));
+    const auto reader = document->GetReader2d();
+
+    // the level with the lowest resolution which is still sufficient is chosen
+    EXPECT_THAT(ComposeGray8(reader, RectangleD(0, 0, 8, 8), nullptr, RegionCompositor::Options(), 8, 8), Each(100));
+    EXPECT_THAT(ComposeGray8(reader, RectangleD(0, 0, 8, 8), nullptr, RegionCompositor::Options(), 6, 6), Each(100));
+    EXPECT_THAT(ComposeGray8(reader, RectangleD(0, 0, 8, 8), nullptr, RegionCompositor::Options(), 4, 4), Each(101));
+    EXPECT_THAT(ComposeGray8(reader, RectangleD(0, 0, 8, 8), nullptr, RegionCompositor::Options(), 3, 3), Each(101));
+    EXPECT_THAT(ComposeGray8(reader, RectangleD(0, 0, 8, 8), nullptr, RegionCompositor::Options(), 2, 2), Each(102));
+    EXPECT_THAT(ComposeGray8(reader, RectangleD(0, 0, 8, 8), nullptr, RegionCompositor::Options(), 1, 1), Each(102));
+
+    // if no level has a sufficient resolution, the one with the highest resolution is chosen
+    EXPECT_THAT(ComposeGray8(reader, RectangleD(0, 0, 8, 8), nullptr, RegionCompositor::Options(), 16, 16), Each(100));
+
+    // and the level can be given explicitly
+    RegionCompositor::Options options;
+    options.pyramid_level = 2;
+    EXPECT_THAT(ComposeGray8(reader, RectangleD(0, 0, 8, 8), nullptr, options, 8, 8), Each(102));
+}
+
+TEST(RegionCompositor, ComposeWithUpscalingAndCheckNearestNeighborAndBilinearInterpolation)
+{
+    const auto document = CreateInMemoryDocument2d();
+    const auto writer = document->GetWriter2d();
+    AddUncompressedTile(
+        writer.get(),
+        TileCoordinate({ { 'C', 0 }, { 'M', 0 } }),
+        LogicalPositionInfo(0, 0, 2, 1),
+        PixelType::Gray8,
+        2,
+        1,
+        CreateBitmap(PixelType::Gray8, 2, 1, [](uint32_t x, uint32_t, int)->double { return x == 0 ? 0 : 100; }));
+    const auto reader = document->GetReader2d();
+
+    // the centers of the destination pixels are at 0.25, 0.75, 1.25 and 1.75 - which is -0.25, 0.25, 0.75 and 1.25 in
+    //  source pixel coordinates (where the source pixels are clamped at the border of the tile)
+    RegionCompositor::Options options;
+    options.filter = RegionCompositor::ResamplingFilter::NearestNeighbor;
+    EXPECT_THAT(ComposeGray8(reader, RectangleD(0, 0, 2, 1), nullptr, options, 4, 1), ElementsAre(0, 0, 100, 100));
+    options.filter = RegionCompositor::ResamplingFilter::Bilinear;
+    EXPECT_THAT(ComposeGray8(reader, RectangleD(0, 0, 2, 1), nullptr, options, 4, 1), ElementsAre(0, 25, 75, 100));
+}
+
+TEST(RegionCompositor, ComposeGray16WithDownscalingAndCheckResult)
+{
+    const auto document = CreateInMemoryDocument2d();
+    const auto writer = document->GetWriter2d();
+    const auto tile_bitmap = CreateBitmap(PixelType::Gray16, 4, 4, [](uint32_t x, uint32_t y, int)->double { return 1000 * (1 + x + 4 * y); });
+    AddUncompressedTile(writer.get(), TileCoordinate({ { 'C', 0 }, { 'M', 0 } }), LogicalPositionInfo(0, 0, 4, 4), PixelType::Gray16, 4, 4, tile_bitmap);
+
+    // with a zoom of 0.5, the centers of the destination pixels are at the source pixel coordinates 1 and 3 (in each direction) - so
+    //  we expect the source pixels (1,1), (3,1), (1,3) and (3,3) with nearest neighbor
+    vector<uint16_t> bitmap(4);
+    RegionCompositor::Options options;
+    options.pixel_type = PixelType::Gray16;
+    RegionCompositor::DestinationBitmap destination;
+    destination.data = bitmap.data();
+    destination.width = 2;
+    destination.height = 2;
+    destination.stride = 2 * sizeof(uint16_t);
+    RegionCompositor compositor(document->GetReader2d());
+    compositor.Compose(RectangleD(0, 0, 4, 4), nullptr, options, destination);
+    EXPECT_THAT(bitmap, ElementsAre(6000, 8000, 14000, 16000));
+
+    // with bilinear interpolation, the source coordinates are 0.5 and 2.5, i.e. we get the average of 2x2 pixels
+    options.filter = RegionCompositor::ResamplingFilter::Bilinear;
+    compositor.Compose(RectangleD(0, 0, 4, 4), nullptr, options, destination);
+    EXPECT_THAT(bitmap, ElementsAre(3500, 5500, 11500, 13500));
+}
+
+TEST(RegionCompositor, ComposeWithTileOfDifferentPixelTypeAndExpectException)
+{
+    const auto document = CreateInMemoryDocument2d();
+    const auto writer = document->GetWriter2d();
+    AddUncompressedTile(writer.get(), TileCoordinate({ { 'C', 0 }, { 'M', 0 } }), LogicalPositionInfo(0, 0, 2, 2), PixelType::Gray16, 2, 2, CreateBitmap(PixelType::Gray16, 2, 2, [](uint32_t, uint32_t, int)->double { return 1; }));
+    EXPECT_THROW(ComposeGray8(document->GetReader2d(), RectangleD(0, 0, 2, 2), nullptr, RegionCompositor::Options(), 2, 2), invalid_operation_exception);
+}
+
+TEST(RegionCompositor, CallCompositeRegionOfApiAndCheckResult)
+{
+    shared_ptr<IDoc> document = CreateInMemoryDocument2d();
+    const auto writer = document->GetWriter2d();
+    AddUncompressedTile(writer.get(), TileCoordinate({ { 'C', 0 }, { 'M', 1 } }), LogicalPositionInfo(0, 0, 2, 2), PixelType::Gray8, 2, 2, CreateUniformGray8Bitmap(2, 2, 10));
+    AddUncompressedTile(writer.get(), TileCoordinate({ { 'C', 0 }, { 'M', 0 } }), LogicalPositionInfo(1, 0, 2, 2), PixelType::Gray8, 2, 2, CreateUniformGray8Bitmap(2, 2, 20));
+
+    // we wrap the document into a handle (in the same way as "CreateNewDocument" does)
+    const auto document_handle = reinterpret_cast<HandleDoc>(new SharedPtrWrapper<IDoc>{ document });
+    HandleDocRead2D reader_handle = kInvalidObjectHandle;
+    ASSERT_EQ(IDoc_GetReader2d(document_handle, &reader_handle, nullptr), ImgDoc2_ErrorCode_OK);
+
+    const RectangleDoubleInterop roi{ 0, 0, 4, 3 };
+    vector<uint8_t> bitmap(4 * 3);
+    ImgDoc2ErrorInformation error_information{};
+    ASSERT_EQ(IDocRead2d_CompositeRegion(reader_handle, &roi, nullptr, PixelType::Gray8, 5, 0, 4, 3, 4, bitmap.data(), &error_information), ImgDoc2_ErrorCode_OK);
+    const vector<uint8_t> expected_result
+    {
+        10, 10, 20, 5,
+        10, 10, 20, 5,
+         5,  5,  5, 5,
+    };
+    EXPECT_EQ(bitmap, expected_result);
+
+    // an invalid resampling filter, a stride which is too small and a pixel type which does not match the tiles are reported as errors
+    EXPECT_EQ(IDocRead2d_CompositeRegion(reader_handle, &roi, nullptr, PixelType::Gray8, 5, 2, 4, 3, 4, bitmap.data(), &error_information), ImgDoc2_ErrorCode_InvalidArgument);
+    EXPECT_EQ(IDocRead2d_CompositeRegion(reader_handle, &roi, nullptr, PixelType::Gray8, 5, 0, 4, 3, 3, bitmap.data(), &error_information), ImgDoc2_ErrorCode_InvalidArgument);
+    EXPECT_NE(IDocRead2d_CompositeRegion(reader_handle, &roi, nullptr, PixelType::Gray16, 5, 0, 2, 3, 4, bitmap.data(), &error_information), ImgDoc2_ErrorCode_OK);
+
+    EXPECT_EQ(DestroyReader2d(reader_handle, nullptr), ImgDoc2_ErrorCode_OK);
+    EXPECT_EQ(DestroyDocument(document_handle, nullptr), ImgDoc2_ErrorCode_OK);
+}
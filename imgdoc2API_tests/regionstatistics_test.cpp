@@ -0,0 +1,205 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <imgdoc2.h>
+#include "../imgdoc2API/regionstatistics.h"
+#include "utilities.h"
+
+using namespace std;
+using namespace imgdoc2;
+using namespace testing;
+
+namespace
+{
+    /// Calculates the expected result for the specified pixel values (in the same way as documented for RegionStatistics,
+    /// but directly from the values).
+    RegionStatistics::Result CalculateExpectedResult(const vector<double>& values, double range_minimum, double range_maximum, uint32_t number_of_bins)
+    {
+        RegionStatistics::Result result;
+        result.number_of_pixels = values.size();
+        result.range_minimum = range_minimum;
+        result.range_maximum = range_maximum;
+        result.histogram.resize(number_of_bins);
+        if (values.empty())
+        {
+            return result;
+        }
+
+        result.minimum = *min_element(values.cbegin(), values.cend());
+        result.maximum = *max_element(values.cbegin(), values.cend());
+        double sum = 0;
+        for (const auto value : values)
+        {
+            sum += value;
+            const double bin = floor((value - range_minimum) * number_of_bins / (range_maximum - range_minimum));
+            ++result.histogram[static_cast<size_t>(clamp(bin, 0.0, static_cast<double>(number_of_bins - 1)))];
+        }
+
+        result.mean = sum / values.size();
+        double sum_of_squared_deviations = 0;
+        for (const auto value : values)
+        {
+            sum_of_squared_deviations += (value - result.mean) * (value - result.mean);
+        }
+
+        result.standard_deviation = sqrt(sum_of_squared_deviations / values.size());
+        return result;
+    }
+
+    void CompareResult(const RegionStatistics::Result& result, const RegionStatistics::Result& expected_result, int expected_pyramid_level)
+    {
+        EXPECT_EQ(result.pyramid_level, expected_pyramid_level);
+        EXPECT_EQ(result.number_of_pixels, expected_result.number_of_pixels);
+        EXPECT_DOUBLE_EQ(result.minimum, expected_result.minimum);
+        EXPECT_DOUBLE_EQ(result.maximum, expected_result.maximum);
+        EXPECT_NEAR(result.mean, expected_result.mean, 1e-6);
+        EXPECT_NEAR(result.standard_deviation, expected_result.standard_deviation, 1e-4);
+        EXPECT_DOUBLE_EQ(result.range_minimum, expected_result.range_minimum);
+        EXPECT_DOUBLE_EQ(result.range_maximum, expected_result.range_maximum);
+        EXPECT_EQ(result.histogram, expected_result.histogram);
+    }
+}
+
+TEST(RegionStatistics, CalculateStatisticsOfGray8RegionAndCompareToValuesOfPixels)
+{
+    // two Gray8-tiles of 4x4 pixels side by side on pyramid level 0, and a uniform tile covering both on pyramid level 1
+    const auto value_function = [](uint32_t x, uint32_t y)->double { return (x * 37 + y * 91) % 256; };
+    const auto document = CreateInMemoryDocument2d();
+    const auto writer = document->GetWriter2d();
+    for (uint32_t column = 0; column < 2; ++column)
+    {
+        AddUncompressedTile(
+            writer.get(),
+            TileCoordinate({ { 'C', 0 }, { 'M', static_cast<int>(column) } }),
+            LogicalPositionInfo(column * 4, 0, 4, 4),
+            PixelType::Gray8,
+            4,
+            4,
+            CreateBitmap(PixelType::Gray8, 4, 4, [&](uint32_t x, uint32_t y, int)->double { return value_function(column * 4 + x, y); }));
+    }
+
+    AddUncompressedTile(writer.get(), TileCoordinate({ { 'C', 0 }, { 'M', 2 } }), LogicalPositionInfo(0, 0, 8, 4, 1), PixelType::Gray8, 4, 2, CreateBitmap(PixelType::Gray8, 4, 2, [](uint32_t, uint32_t, int)->double { return 200; }));
+
+    // the region covers the pixels with x in [1, 6] and y in [1, 2] of level 0 (i.e. 12 pixels, spread over both tiles), and
+    //  3x1 pixels of level 1
+    const RectangleD roi(1, 1, 6, 2);
+    vector<double> values;
+    for (uint32_t y = 1; y <= 2; ++y)
+    {
+        for (uint32_t x = 1; x <= 6; ++x)
+        {
+            values.push_back(value_function(x, y));
+        }
+    }
+
+    RegionStatistics region_statistics(document->GetReader2d());
+    RegionStatistics::Options options;
+    options.pixel_type = PixelType::Gray8;
+    options.number_of_bins = 4;
+    options.max_number_of_threads = 2;
+    CompareResult(region_statistics.Calculate(roi, nullptr, options), CalculateExpectedResult(values, 0, 256, 4), 0);
+
+    // with a range for the histogram, values outside of it are counted in the first or the last bin
+    options.range_minimum = 50;
+    options.range_maximum = 150;
+    options.number_of_bins = 5;
+    CompareResult(region_statistics.Calculate(roi, nullptr, options), CalculateExpectedResult(values, 50, 150, 5), 0);
+
+    // the pyramid level is chosen by the budget of pixels - level 0 fits into a budget of 12 pixels...
+    options.range_minimum = options.range_maximum = 0;
+    options.number_of_bins = 4;
+    options.max_number_of_pixels = 12;
+    CompareResult(region_statistics.Calculate(roi, nullptr, options), CalculateExpectedResult(values, 0, 256, 4), 0);
+
+    // ...a budget of 11 pixels requires level 1...
+    const vector<double> level1_values(3, 200);
+    options.max_number_of_pixels = 11;
+    CompareResult(region_statistics.Calculate(roi, nullptr, options), CalculateExpectedResult(level1_values, 0, 256, 4), 1);
+
+    // ...and if no level fits into the budget, the level with the lowest number of pixels is used
+    options.max_number_of_pixels = 1;
+    CompareResult(region_statistics.Calculate(roi, nullptr, options), CalculateExpectedResult(level1_values, 0, 256, 4), 1);
+}
+
+TEST(RegionStatistics, CalculateStatisticsOfGray32FloatRegionAndCompareToValuesOfPixels)
+{
+    const auto value_function = [](uint32_t x, uint32_t y)->double { return (static_cast<double>(x) - 2.5) * 4.25 + y * 0.125; };
+    const auto document = CreateInMemoryDocument2d();
+    AddUncompressedTile(
+        document->GetWriter2d().get(),
+        TileCoordinate({ { 'C', 0 }, { 'M', 0 } }),
+        LogicalPositionInfo(0, 0, 6, 3),
+        PixelType::Gray32Float,
+        6,
+        3,
+        CreateBitmap(PixelType::Gray32Float, 6, 3, [&](uint32_t x, uint32_t y, int)->double { return value_function(x, y); }));
+
+    vector<double> values;
+    for (uint32_t y = 0; y < 3; ++y)
+    {
+        for (uint32_t x = 0; x < 6; ++x)
+        {
+            values.push_back(value_function(x, y));
+        }
+    }
+
+    // the values are in the range [-10.625, 10.875], so the first and the last bin also receive the values outside of [-8, 8)
+    RegionStatistics region_statistics(document->GetReader2d());
+    RegionStatistics::Options options;
+    options.pixel_type = PixelType::Gray32Float;
+    options.number_of_bins = 4;
+    options.range_minimum = -8;
+    options.range_maximum = 8;
+    CompareResult(region_statistics.Calculate(RectangleD(0, 0, 6, 3), nullptr, options), CalculateExpectedResult(values, -8, 8, 4), 0);
+
+    // for Gray32Float, the range must be given
+    options.range_maximum = options.range_minimum;
+    EXPECT_THROW(region_statistics.Calculate(RectangleD(0, 0, 6, 3), nullptr, options), invalid_argument_exception);
+}
+
+TEST(RegionStatistics, CalculateStatisticsOfGray16SubVolumeAndCompareToValuesOfVoxels)
+{
+    // a Gray16-brick of 4x3x5 voxels, where two voxels per logical unit are used along the z-axis
+    constexpr uint32_t kWidth = 4, kHeight = 3, kDepth = 5;
+    const auto value_function = [](uint32_t x, uint32_t y, uint32_t z)->double { return (x * 7919 + y * 104729 + z * 15485863) % 65536; };
+    const auto document = CreateInMemoryDocument3d();
+    AddUncompressedBrick(
+        document->GetWriter3d().get(),
+        TileCoordinate({ { 'C', 0 }, { 'M', 0 } }),
+        LogicalPositionInfo3D(0, 0, 0, kWidth, kHeight, kDepth / 2.0),
+        PixelType::Gray16,
+        kWidth,
+        kHeight,
+        kDepth,
+        CreateBitmap(PixelType::Gray16, kWidth, kHeight * kDepth, [&](uint32_t x, uint32_t y, int)->double { return value_function(x, y % kHeight, y / kHeight); }));
+
+    // the region covers the voxels with x in [1, 3], y in [0, 1] and z in [1, 3] (whose centers are at 0.75, 1.25 and 1.75)
+    vector<double> values;
+    for (uint32_t z = 1; z <= 3; ++z)
+    {
+        for (uint32_t y = 0; y <= 1; ++y)
+        {
+            for (uint32_t x = 1; x <= 3; ++x)
+            {
+                values.push_back(value_function(x, y, z));
+            }
+        }
+    }
+
+    RegionStatistics region_statistics(document->GetReader3d());
+    RegionStatistics::Options options;
+    options.pixel_type = PixelType::Gray16;
+    options.number_of_bins = 8;
+    options.max_number_of_threads = 3;
+    CompareResult(region_statistics.Calculate(CuboidD(1, -1, 0.6, 3, 3, 1.3), nullptr, options), CalculateExpectedResult(values, 0, 65536, 8), 0);
+
+    // a 2D-region is not valid for a 3D-document
+    EXPECT_THROW(region_statistics.Calculate(RectangleD(0, 0, 1, 1), nullptr, options), invalid_operation_exception);
+}
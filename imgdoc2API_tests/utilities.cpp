@@ -0,0 +1,155 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include "utilities.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+
+using namespace std;
+using namespace imgdoc2;
+
+namespace
+{
+    template <typename t_channel>
+    void SetChannel(uint8_t* destination, double value)
+    {
+        t_channel channel_value;
+        if constexpr (is_integral_v<t_channel>)
+        {
+            channel_value = static_cast<t_channel>(clamp(floor(value + 0.5), 0.0, static_cast<double>(numeric_limits<t_channel>::max())));
+        }
+        else
+        {
+            channel_value = static_cast<t_channel>(value);
+        }
+
+        memcpy(destination, &channel_value, sizeof(t_channel));
+    }
+}
+
+std::vector<std::uint8_t> CreateRandomBytes(size_t size, std::uint32_t seed)
+{
+    mt19937 generator(seed);
+    uniform_int_distribution<int> distribution(0, 255);
+    vector<uint8_t> data(size);
+    for (auto& value : data)
+    {
+        value = static_cast<uint8_t>(distribution(generator));
+    }
+
+    return data;
+}
+
+std::shared_ptr<imgdoc2::IDoc> CreateInMemoryDocument2d()
+{
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetFilename(":memory:");
+    create_options->AddDimension('C');
+    create_options->AddDimension('M');
+    create_options->SetUseSpatialIndex(false);
+    create_options->SetCreateBlobTable(true);
+    return ClassFactory::CreateNew(create_options.get());
+}
+
+std::shared_ptr<imgdoc2::IDoc> CreateInMemoryDocument3d()
+{
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetDocumentType(DocumentType::kImage3d);
+    create_options->SetFilename(":memory:");
+    create_options->AddDimension('C');
+    create_options->AddDimension('M');
+    create_options->SetUseSpatialIndex(false);
+    create_options->SetCreateBlobTable(true);
+    return ClassFactory::CreateNew(create_options.get());
+}
+
+std::vector<std::uint8_t> CreateBitmap(std::uint8_t pixel_type, std::uint32_t width, std::uint32_t height, const std::function<double(std::uint32_t x, std::uint32_t y, int c)>& value_function)
+{
+    int channels;
+    size_t bytes_per_channel;
+    switch (pixel_type)
+    {
+    case PixelType::Gray8:
+        channels = 1;
+        bytes_per_channel = 1;
+        break;
+    case PixelType::Gray16:
+        channels = 1;
+        bytes_per_channel = 2;
+        break;
+    case PixelType::Bgr24:
+        channels = 3;
+        bytes_per_channel = 1;
+        break;
+    case PixelType::Bgr48:
+        channels = 3;
+        bytes_per_channel = 2;
+        break;
+    case PixelType::Gray32Float:
+        channels = 1;
+        bytes_per_channel = 4;
+        break;
+    default:
+        throw invalid_argument("The pixel type is not supported.");
+    }
+
+    vector<uint8_t> bitmap(static_cast<size_t>(width) * height * channels * bytes_per_channel);
+    uint8_t* pointer = bitmap.data();
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            for (int c = 0; c < channels; ++c)
+            {
+                const double value = value_function(x, y, c);
+                switch (pixel_type)
+                {
+                case PixelType::Gray8:
+                case PixelType::Bgr24:
+                    SetChannel<uint8_t>(pointer, value);
+                    break;
+                case PixelType::Gray16:
+                case PixelType::Bgr48:
+                    SetChannel<uint16_t>(pointer, value);
+                    break;
+                default:
+                    SetChannel<float>(pointer, value);
+                    break;
+                }
+
+                pointer += bytes_per_channel;
+            }
+        }
+    }
+
+    return bitmap;
+}
+
+imgdoc2::dbIndex AddUncompressedTile(imgdoc2::IDocWrite2d* writer, const imgdoc2::TileCoordinate& coordinate, const imgdoc2::LogicalPositionInfo& position, std::uint8_t pixel_type, std::uint32_t pixel_width, std::uint32_t pixel_height, const std::vector<std::uint8_t>& bitmap)
+{
+    TileBaseInfo tile_base_info;
+    tile_base_info.pixelWidth = pixel_width;
+    tile_base_info.pixelHeight = pixel_height;
+    tile_base_info.pixelType = pixel_type;
+    DataObjectOnHeap data(bitmap.size());
+    memcpy(data.GetData(), bitmap.data(), bitmap.size());
+    return writer->AddTile(&coordinate, &position, &tile_base_info, DataTypes::UNCOMPRESSED_BITMAP, TileDataStorageType::BlobInDatabase, &data);
+}
+
+imgdoc2::dbIndex AddUncompressedBrick(imgdoc2::IDocWrite3d* writer, const imgdoc2::TileCoordinate& coordinate, const imgdoc2::LogicalPositionInfo3D& position, std::uint8_t pixel_type, std::uint32_t pixel_width, std::uint32_t pixel_height, std::uint32_t pixel_depth, const std::vector<std::uint8_t>& data)
+{
+    BrickBaseInfo brick_base_info;
+    brick_base_info.pixelWidth = pixel_width;
+    brick_base_info.pixelHeight = pixel_height;
+    brick_base_info.pixelDepth = pixel_depth;
+    brick_base_info.pixelType = pixel_type;
+    DataObjectOnHeap brick_data(data.size());
+    memcpy(brick_data.GetData(), data.data(), data.size());
+    return writer->AddBrick(&coordinate, &position, &brick_base_info, DataTypes::UNCOMPRESSED_BRICK, TileDataStorageType::BlobInDatabase, &brick_data);
+}
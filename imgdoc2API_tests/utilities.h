@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <imgdoc2.h>
+#include "../imgdoc2API/pixelkernels.h"
+
+/// Creates a vector of pseudo-random bytes (which is reproducible, i.e. the same seed gives the same data).
+///
+/// \param  size    The number of bytes.
+/// \param  seed    The seed for the pseudo-random number generator.
+///
+/// \returns    The pseudo-random bytes.
+std::vector<std::uint8_t> CreateRandomBytes(size_t size, std::uint32_t seed);
+
+/// Creates a new 2D-document in memory (with a blob table), having the dimensions 'C' and 'M'.
+///
+/// \returns   The newly created document.
+std::shared_ptr<imgdoc2::IDoc> CreateInMemoryDocument2d();
+
+/// Creates a new 3D-document in memory (with a blob table), having the dimensions 'C' and 'M'.
+///
+/// \returns   The newly created document.
+std::shared_ptr<imgdoc2::IDoc> CreateInMemoryDocument3d();
+
+/// Creates a bitmap (of the specified pixel type) without padding, where the value of each channel is given by the
+/// specified function.
+///
+/// \param  pixel_type      The pixel type (c.f. imgdoc2::PixelType) - Gray8, Gray16, Bgr24, Bgr48 and Gray32Float are supported.
+/// \param  width           The width of the bitmap in pixels.
+/// \param  height          The height of the bitmap in pixels.
+/// \param  value_function  The function which gives the value for the pixel at (x,y) and the channel c.
+///
+/// \returns   The bitmap.
+std::vector<std::uint8_t> CreateBitmap(std::uint8_t pixel_type, std::uint32_t width, std::uint32_t height, const std::function<double(std::uint32_t x, std::uint32_t y, int c)>& value_function);
+
+/// Adds an uncompressed tile to the document.
+///
+/// \param  writer          The writer object.
+/// \param  coordinate      The coordinate of the tile.
+/// \param  position        The logical position of the tile.
+/// \param  pixel_type      The pixel type (c.f. imgdoc2::PixelType).
+/// \param  pixel_width     The width of the tile in pixels.
+/// \param  pixel_height    The height of the tile in pixels.
+/// \param  bitmap          The bitmap (without padding), e.g. as created with "CreateBitmap".
+///
+/// \returns   The primary key of the new tile.
+imgdoc2::dbIndex AddUncompressedTile(imgdoc2::IDocWrite2d* writer, const imgdoc2::TileCoordinate& coordinate, const imgdoc2::LogicalPositionInfo& position, std::uint8_t pixel_type, std::uint32_t pixel_width, std::uint32_t pixel_height, const std::vector<std::uint8_t>& bitmap);
+
+/// Adds an uncompressed brick to the document.
+///
+/// \param  writer          The writer object.
+/// \param  coordinate      The coordinate of the brick.
+/// \param  position        The logical position of the brick.
+/// \param  pixel_type      The pixel type (c.f. imgdoc2::PixelType).
+/// \param  pixel_width     The width of the brick in pixels.
+/// \param  pixel_height    The height of the brick in pixels.
+/// \param  pixel_depth     The depth of the brick in pixels.
+/// \param  data            The data of the brick (without padding, plane after plane), e.g. as created with "CreateBitmap"
+///                         with a height of pixel_height * pixel_depth.
+///
+/// \returns   The primary key of the new brick.
+imgdoc2::dbIndex AddUncompressedBrick(imgdoc2::IDocWrite3d* writer, const imgdoc2::TileCoordinate& coordinate, const imgdoc2::LogicalPositionInfo3D& position, std::uint8_t pixel_type, std::uint32_t pixel_width, std::uint32_t pixel_height, std::uint32_t pixel_depth, const std::vector<std::uint8_t>& data);
+
+/// This class is restoring the instruction set used by the pixel-kernels when it goes out of scope - it is used by tests
+/// which are running the kernels with all available instruction sets.
+class InstructionSetRestorer
+{
+private:
+    PixelKernels::InstructionSet instruction_set_;
+public:
+    InstructionSetRestorer() : instruction_set_(PixelKernels::GetInstructionSet())
+    {
+    }
+
+    ~InstructionSetRestorer()
+    {
+        PixelKernels::SetInstructionSet(this->instruction_set_);
+    }
+
+    InstructionSetRestorer(const InstructionSetRestorer&) = delete;
+    InstructionSetRestorer& operator=(const InstructionSetRestorer&) = delete;
+};
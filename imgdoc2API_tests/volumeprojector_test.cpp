@@ -0,0 +1,176 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+#include <imgdoc2.h>
+#include "../imgdoc2API/volumeprojector.h"
+#include "utilities.h"
+
+using namespace std;
+using namespace imgdoc2;
+using namespace testing;
+
+namespace
+{
+    /// Calculates the projection of the specified region into a newly allocated bitmap (without padding).
+    template <typename t_pixel>
+    vector<t_pixel> Project(
+        const shared_ptr<IDocRead3d>& reader,
+        const CuboidD& roi,
+        VolumeProjector::Axis axis,
+        VolumeProjector::Operation operation,
+        uint8_t pixel_type,
+        double background_value,
+        uint32_t width,
+        uint32_t height)
+    {
+        VolumeProjector::Options options;
+        options.axis = axis;
+        options.operation = operation;
+        options.pixel_type = pixel_type;
+        options.background_value = background_value;
+        options.max_number_of_threads = 2;
+        vector<t_pixel> bitmap(static_cast<size_t>(width) * height);
+        VolumeProjector::DestinationBitmap destination;
+        destination.data = bitmap.data();
+        destination.width = width;
+        destination.height = height;
+        destination.stride = width * sizeof(t_pixel);
+        VolumeProjector projector(reader);
+        projector.Project(roi, nullptr, options, destination);
+        return bitmap;
+    }
+}
+
+TEST(VolumeProjector, ProjectTinyVolumeAlongAllAxesAndCompareToReference)
+{
+    // a Gray8-brick of 3x2x4 voxels with random content at the origin (one voxel per logical unit)
+    const array<uint32_t, 3> kBrickSize{ 3, 2, 4 };
+    const auto document = CreateInMemoryDocument3d();
+    const auto brick_data = CreateRandomBytes(static_cast<size_t>(kBrickSize[0]) * kBrickSize[1] * kBrickSize[2], 33);
+    AddUncompressedBrick(
+        document->GetWriter3d().get(),
+        TileCoordinate({ { 'C', 0 }, { 'M', 0 } }),
+        LogicalPositionInfo3D(0, 0, 0, kBrickSize[0], kBrickSize[1], kBrickSize[2]),
+        PixelType::Gray8,
+        kBrickSize[0],
+        kBrickSize[1],
+        kBrickSize[2],
+        brick_data);
+    const auto reader = document->GetReader3d();
+
+    // the region extends by one unit beyond the brick in x- and y-direction (so that there are pixels without voxels), and
+    //  it excludes the first plane of the brick
+    const array<int, 3> kRegionStart{ 0, 0, 1 };
+    const array<int, 3> kRegionEnd{ 4, 3, 4 };
+    const CuboidD roi(kRegionStart[0], kRegionStart[1], kRegionStart[2], kRegionEnd[0] - kRegionStart[0], kRegionEnd[1] - kRegionStart[1], kRegionEnd[2] - kRegionStart[2]);
+    constexpr double kBackground = 7;
+
+    const array<pair<VolumeProjector::Axis, array<int, 3>>, 3> axes
+    {
+        make_pair(VolumeProjector::Axis::X, array<int, 3>{ 1, 2, 0 }),
+        make_pair(VolumeProjector::Axis::Y, array<int, 3>{ 0, 2, 1 }),
+        make_pair(VolumeProjector::Axis::Z, array<int, 3>{ 0, 1, 2 }),
+    };
+
+    for (const auto& axis : axes)
+    {
+        // the destination has one pixel per logical unit, so pixel (i,j) corresponds to the voxel at (start_u + i, start_v + j)
+        const int axis_u = axis.second[0], axis_v = axis.second[1], axis_w = axis.second[2];
+        const auto width = static_cast<uint32_t>(kRegionEnd[axis_u] - kRegionStart[axis_u]);
+        const auto height = static_cast<uint32_t>(kRegionEnd[axis_v] - kRegionStart[axis_v]);
+        vector<uint8_t> expected_maximum, expected_minimum;
+        vector<float> expected_sum, expected_mean;
+        for (uint32_t j = 0; j < height; ++j)
+        {
+            for (uint32_t i = 0; i < width; ++i)
+            {
+                array<int, 3> voxel;
+                voxel[axis_u] = kRegionStart[axis_u] + static_cast<int>(i);
+                voxel[axis_v] = kRegionStart[axis_v] + static_cast<int>(j);
+                vector<uint8_t> values;
+                for (voxel[axis_w] = kRegionStart[axis_w]; voxel[axis_w] < kRegionEnd[axis_w]; ++voxel[axis_w])
+                {
+                    if (voxel[0] < static_cast<int>(kBrickSize[0]) && voxel[1] < static_cast<int>(kBrickSize[1]) && voxel[2] < static_cast<int>(kBrickSize[2]))
+                    {
+                        values.push_back(brick_data[(static_cast<size_t>(voxel[2]) * kBrickSize[1] + voxel[1]) * kBrickSize[0] + voxel[0]]);
+                    }
+                }
+
+                if (values.empty())
+                {
+                    expected_maximum.push_back(static_cast<uint8_t>(kBackground));
+                    expected_minimum.push_back(static_cast<uint8_t>(kBackground));
+                    expected_sum.push_back(static_cast<float>(kBackground));
+                    expected_mean.push_back(static_cast<float>(kBackground));
+                }
+                else
+                {
+                    int sum = 0;
+                    for (const auto value : values)
+                    {
+                        sum += value;
+                    }
+
+                    expected_maximum.push_back(*max_element(values.cbegin(), values.cend()));
+                    expected_minimum.push_back(*min_element(values.cbegin(), values.cend()));
+                    expected_sum.push_back(static_cast<float>(sum));
+                    expected_mean.push_back(static_cast<float>(static_cast<double>(sum) / values.size()));
+                }
+            }
+        }
+
+        const int axis_number = static_cast<int>(axis.first);
+        EXPECT_EQ(Project<uint8_t>(reader, roi, axis.first, VolumeProjector::Operation::Maximum, PixelType::Gray8, kBackground, width, height), expected_maximum) << "axis " << axis_number;
+        EXPECT_EQ(Project<uint8_t>(reader, roi, axis.first, VolumeProjector::Operation::Minimum, PixelType::Gray8, kBackground, width, height), expected_minimum) << "axis " << axis_number;
+        EXPECT_THAT(Project<float>(reader, roi, axis.first, VolumeProjector::Operation::Sum, PixelType::Gray8, kBackground, width, height), Pointwise(FloatEq(), expected_sum)) << "axis " << axis_number;
+        EXPECT_THAT(Project<float>(reader, roi, axis.first, VolumeProjector::Operation::Mean, PixelType::Gray8, kBackground, width, height), Pointwise(FloatEq(), expected_mean)) << "axis " << axis_number;
+    }
+}
+
+TEST(VolumeProjector, ProjectSumWhichOverflows32BitsAndCheckResult)
+{
+    // a Gray16-brick of 2x1x70000 voxels with the values 65535 and 65534 - the sum along the z-axis exceeds the range of the
+    //  32-bit partial sums (which can take 65537 additions of 65535), so they must be folded into the sums in between
+    constexpr uint32_t kDepth = 70000;
+    const auto document = CreateInMemoryDocument3d();
+    AddUncompressedBrick(
+        document->GetWriter3d().get(),
+        TileCoordinate({ { 'C', 0 }, { 'M', 0 } }),
+        LogicalPositionInfo3D(0, 0, 0, 2, 1, kDepth),
+        PixelType::Gray16,
+        2,
+        1,
+        kDepth,
+        CreateBitmap(PixelType::Gray16, 2, kDepth, [](uint32_t x, uint32_t, int)->double { return x == 0 ? 65535 : 65534; }));
+    const auto reader = document->GetReader3d();
+    const CuboidD roi(0, 0, 0, 2, 1, kDepth);
+
+    const auto sum = Project<float>(reader, roi, VolumeProjector::Axis::Z, VolumeProjector::Operation::Sum, PixelType::Gray16, 0, 2, 1);
+    EXPECT_THAT(sum, ElementsAre(FloatEq(static_cast<float>(65535.0 * kDepth)), FloatEq(static_cast<float>(65534.0 * kDepth))));
+
+    const auto mean = Project<float>(reader, roi, VolumeProjector::Axis::Z, VolumeProjector::Operation::Mean, PixelType::Gray16, 0, 2, 1);
+    EXPECT_THAT(mean, ElementsAre(FloatEq(65535), FloatEq(65534)));
+}
+
+TEST(VolumeProjector, ProjectWithUnsupportedPixelTypeAndExpectException)
+{
+    const auto document = CreateInMemoryDocument3d();
+    VolumeProjector projector(document->GetReader3d());
+    VolumeProjector::Options options;
+    options.operation = VolumeProjector::Operation::Sum;
+    options.pixel_type = PixelType::Bgr24;
+    uint8_t pixel[3];
+    VolumeProjector::DestinationBitmap destination;
+    destination.data = pixel;
+    destination.width = 1;
+    destination.height = 1;
+    destination.stride = 3;
+    EXPECT_THROW(projector.Project(CuboidD(0, 0, 0, 1, 1, 1), nullptr, options, destination), invalid_argument_exception);
+}
@@ -2,7 +2,15 @@
 //
 // SPDX-License-Identifier: MIT
 
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
 #include <imgdoc2.h>
+#include "syntheticdocumentgenerator.h"
 
 using namespace  std;
 using namespace imgdoc2;
@@ -159,8 +167,552 @@ static void Test4()
     return;
 }
 
+/// Creates a compacted copy of the specified document (c.f. IDoc::CreateCompactedCopy).
+/// \param  source_filename         The filename of the source document.
+/// \param  destination_filename    The filename of the destination document.
+/// \returns The exit code.
+int Compact(const char* source_filename, const char* destination_filename)
+{
+    try
+    {
+        auto open_existing_options = ClassFactory::CreateOpenExistingOptionsUp();
+        open_existing_options->SetFilename(source_filename);
+        open_existing_options->SetOpenReadonly(true);
+        const auto doc = ClassFactory::OpenExisting(open_existing_options.get());
+        doc->CreateCompactedCopy(destination_filename);
+    }
+    catch (exception& exception)
+    {
+        cerr << "Error: " << exception.what() << endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/// Parses a list of unsigned integers separated by 'x' (e.g. "100x200x3"), where the number of values must be in the
+/// range [min_count, max_count].
+/// \param          text        The text to parse.
+/// \param          min_count   The minimal number of values.
+/// \param          max_count   The maximal number of values.
+/// \param [out]    values      The parsed values.
+/// \returns True if successful; false otherwise.
+static bool TryParseSizeList(const string& text, size_t min_count, size_t max_count, vector<uint32_t>& values)
+{
+    values.clear();
+    istringstream string_stream(text);
+    string token;
+    while (getline(string_stream, token, 'x'))
+    {
+        size_t characters_parsed = 0;
+        try
+        {
+            const unsigned long value = stoul(token, &characters_parsed);
+            if (characters_parsed != token.size() || value > UINT32_MAX)
+            {
+                return false;
+            }
+
+            values.push_back(static_cast<uint32_t>(value));
+        }
+        catch (logic_error&)
+        {
+            return false;
+        }
+    }
+
+    return values.size() >= min_count && values.size() <= max_count;
+}
+
+/// Parses the specification of the "planes", which is a comma-separated list of "<dimension>:<count>" (e.g. "C:3,T:10").
+/// \param          text    The text to parse.
+/// \param [out]    planes  The parsed planes.
+/// \returns True if successful; false otherwise.
+static bool TryParsePlanes(const string& text, vector<pair<Dimension, int>>& planes)
+{
+    planes.clear();
+    istringstream string_stream(text);
+    string token;
+    while (getline(string_stream, token, ','))
+    {
+        if (token.size() < 3 || token[1] != ':')
+        {
+            return false;
+        }
+
+        vector<uint32_t> count;
+        if (!TryParseSizeList(token.substr(2), 1, 1, count) || count[0] > INT32_MAX)
+        {
+            return false;
+        }
+
+        planes.emplace_back(token[0], static_cast<int>(count[0]));
+    }
+
+    return true;
+}
+
+/// Parses the name of a data type.
+/// \param          text        The text to parse.
+/// \param          is_3d       Whether the data type is for a 3D-document.
+/// \param [out]    data_type   The data type.
+/// \returns True if successful; false otherwise.
+static bool TryParseDataType(const string& text, bool is_3d, DataTypes& data_type)
+{
+    if (text == "zero")
+    {
+        data_type = DataTypes::ZERO;
+    }
+    else if (text == "uncompressed")
+    {
+        data_type = is_3d ? DataTypes::UNCOMPRESSED_BRICK : DataTypes::UNCOMPRESSED_BITMAP;
+    }
+    else if (text == "jpgxr")
+    {
+        data_type = DataTypes::JPGXRCOMPRESSED_BITMAP;
+    }
+    else if (text == "zstd0")
+    {
+        data_type = DataTypes::ZSTD0COMPRESSED_BITMAP;
+    }
+    else if (text == "zstd1")
+    {
+        data_type = DataTypes::ZSTD1COMPRESSED_BITMAP;
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/// Parses the options for the "generate" command (which are given as "--<name>=<value>" or "--<name>").
+/// \param          argc        The number of options.
+/// \param          argv        The options.
+/// \param [out]    parameters  The parameters for the generator.
+/// \returns True if successful; false otherwise (in which case an error message has been printed).
+static bool TryParseGenerateOptions(int argc, char** argv, SyntheticDocumentParameters& parameters)
+{
+    // the data type is parsed last, since its interpretation depends on the document type
+    string data_type_text;
+    for (int i = 0; i < argc; ++i)
+    {
+        const string argument = argv[i];
+        const size_t position_of_equal_sign = argument.find('=');
+        const string name = argument.substr(0, position_of_equal_sign);
+        const string value = position_of_equal_sign != string::npos ? argument.substr(position_of_equal_sign + 1) : string();
+        vector<uint32_t> values;
+        bool success = true;
+        if (name == "--type")
+        {
+            success = value == "2d" || value == "3d";
+            parameters.is_3d = value == "3d";
+        }
+        else if (name == "--tiles")
+        {
+            success = TryParseSizeList(value, 2, 3, values);
+            if (success)
+            {
+                parameters.tiles_x = values[0];
+                parameters.tiles_y = values[1];
+                parameters.tiles_z = values.size() > 2 ? values[2] : 1;
+            }
+        }
+        else if (name == "--tile-size")
+        {
+            success = TryParseSizeList(value, 2, 3, values);
+            if (success)
+            {
+                parameters.tile_width = values[0];
+                parameters.tile_height = values[1];
+                parameters.tile_depth = values.size() > 2 ? values[2] : parameters.tile_depth;
+            }
+        }
+        else if (name == "--overlap")
+        {
+            try
+            {
+                parameters.overlap = stod(value);
+            }
+            catch (logic_error&)
+            {
+                success = false;
+            }
+        }
+        else if (name == "--planes")
+        {
+            success = TryParsePlanes(value, parameters.planes);
+        }
+        else if (name == "--data-type")
+        {
+            data_type_text = value;
+        }
+        else if (name == "--spatial-index")
+        {
+            parameters.use_spatial_index = true;
+        }
+        else if (name == "--pyramid-levels" || name == "--blob-size" || name == "--metadata-items" || name == "--metadata-fan-out" ||
+            name == "--seed" || name == "--batch-size" || name == "--commit-interval")
+        {
+            success = TryParseSizeList(value, 1, 1, values);
+            if (success)
+            {
+                const uint32_t number = values[0];
+                if (name == "--pyramid-levels")
+                {
+                    parameters.pyramid_levels = number;
+                }
+                else if (name == "--blob-size")
+                {
+                    parameters.blob_size = number;
+                }
+                else if (name == "--metadata-items")
+                {
+                    parameters.metadata_items = number;
+                }
+                else if (name == "--metadata-fan-out")
+                {
+                    parameters.metadata_fan_out = number;
+                }
+                else if (name == "--seed")
+                {
+                    parameters.seed = number;
+                }
+                else if (name == "--batch-size")
+                {
+                    parameters.batch_size = number;
+                }
+                else
+                {
+                    parameters.commit_interval = number;
+                }
+            }
+        }
+        else
+        {
+            success = false;
+        }
+
+        if (!success)
+        {
+            cerr << "Error: invalid option \"" << argument << "\"." << endl;
+            return false;
+        }
+    }
+
+    if (!data_type_text.empty() && !TryParseDataType(data_type_text, parameters.is_3d, parameters.data_type))
+    {
+        cerr << "Error: invalid data type \"" << data_type_text << "\"." << endl;
+        return false;
+    }
+
+    return true;
+}
+
+/// Generates a synthetic document (c.f. SyntheticDocumentGenerator).
+/// \param  destination_filename    The filename of the document to be created.
+/// \param  argc                    The number of options.
+/// \param  argv                    The options.
+/// \returns The exit code.
+int Generate(const char* destination_filename, int argc, char** argv)
+{
+    SyntheticDocumentParameters parameters;
+    parameters.filename = destination_filename;
+    if (!TryParseGenerateOptions(argc, argv, parameters))
+    {
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        SyntheticDocumentGenerator generator(parameters);
+        const auto start_time = chrono::steady_clock::now();
+        auto last_report_time = start_time;
+        cout << "Generating " << generator.GetTotalTileCount() << (parameters.is_3d ? " bricks" : " tiles") << "..." << endl;
+        generator.Generate(
+            [&](uint64_t count_added, uint64_t total_count)
+            {
+                const auto now = chrono::steady_clock::now();
+                if (now - last_report_time >= chrono::seconds(1) || count_added == total_count)
+                {
+                    last_report_time = now;
+                    const double elapsed_seconds = chrono::duration<double>(now - start_time).count();
+                    cout << count_added << " / " << total_count << " (" << static_cast<uint64_t>(count_added / max(elapsed_seconds, 1e-3)) << " per second)" << endl;
+                }
+            });
+
+        cout << "Done in " << chrono::duration<double>(chrono::steady_clock::now() - start_time).count() << " seconds." << endl;
+    }
+    catch (exception& exception)
+    {
+        cerr << "Error: " << exception.what() << endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/// Parses a list of floating-point numbers separated by commas (e.g. "0,0,1024,1024"), where the number of values must
+/// be equal to the specified count.
+/// \param          text    The text to parse.
+/// \param          count   The number of values.
+/// \param [out]    values  The parsed values.
+/// \returns True if successful; false otherwise.
+static bool TryParseDoubleList(const string& text, size_t count, vector<double>& values)
+{
+    values.clear();
+    istringstream string_stream(text);
+    string token;
+    while (getline(string_stream, token, ','))
+    {
+        size_t characters_parsed = 0;
+        try
+        {
+            values.push_back(stod(token, &characters_parsed));
+            if (characters_parsed != token.size())
+            {
+                return false;
+            }
+        }
+        catch (logic_error&)
+        {
+            return false;
+        }
+    }
+
+    return values.size() == count;
+}
+
+/// Parses the specification of a plane, which is a comma-separated list of "<dimension>:<value>" (e.g. "C:0,T:1"), into a
+/// dimension-coordinate query clause.
+/// \param          text            The text to parse.
+/// \param [out]    query_clause    The query clause.
+/// \returns True if successful; false otherwise.
+static bool TryParsePlaneCoordinate(const string& text, CDimCoordinateQueryClause& query_clause)
+{
+    istringstream string_stream(text);
+    string token;
+    while (getline(string_stream, token, ','))
+    {
+        if (token.size() < 3 || token[1] != ':')
+        {
+            return false;
+        }
+
+        size_t characters_parsed = 0;
+        try
+        {
+            const int value = stoi(token.substr(2), &characters_parsed);
+            if (characters_parsed != token.size() - 2)
+            {
+                return false;
+            }
+
+            query_clause.AddRangeClause(token[0], IDimCoordinateQueryClause::RangeClause{ value, value });
+        }
+        catch (logic_error&)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// Merges the specified documents into a new document - the first document is copied (including its metadata), and the
+/// tiles (or bricks) of the other documents are imported into the copy.
+/// \param  destination_filename    The filename of the document to be created.
+/// \param  source_filenames        The filenames of the documents to be merged.
+/// \returns The exit code.
+int Merge(const char* destination_filename, const vector<const char*>& source_filenames)
+{
+    try
+    {
+        const auto start_time = chrono::steady_clock::now();
+        auto open_existing_options = ClassFactory::CreateOpenExistingOptionsUp();
+        open_existing_options->SetFilename(source_filenames[0]);
+        open_existing_options->SetOpenReadonly(true);
+        ClassFactory::OpenExisting(open_existing_options.get())->CreateSubsetCopy(destination_filename, nullptr);
+
+        open_existing_options->SetFilename(destination_filename);
+        open_existing_options->SetOpenReadonly(false);
+        const auto destination_document = ClassFactory::OpenExisting(open_existing_options.get());
+        for (size_t i = 1; i < source_filenames.size(); ++i)
+        {
+            cout << "Importing \"" << source_filenames[i] << "\"..." << endl;
+            destination_document->ImportTiles(source_filenames[i], nullptr);
+        }
+
+        cout << "Done in " << chrono::duration<double>(chrono::steady_clock::now() - start_time).count() << " seconds." << endl;
+    }
+    catch (exception& exception)
+    {
+        cerr << "Error: " << exception.what() << endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/// Creates a new document containing the tiles (or bricks) of the source document which match the selection given with
+/// the options (and the metadata of the source document).
+/// \param  source_filename         The filename of the source document.
+/// \param  destination_filename    The filename of the document to be created.
+/// \param  argc                    The number of options.
+/// \param  argv                    The options.
+/// \returns The exit code.
+int Subset(const char* source_filename, const char* destination_filename, int argc, char** argv)
+{
+    TileSelection selection;
+    CDimCoordinateQueryClause coordinate_clause;
+    CTileInfoQueryClause tileinfo_clause;
+    for (int i = 0; i < argc; ++i)
+    {
+        const string argument = argv[i];
+        const size_t position_of_equal_sign = argument.find('=');
+        const string name = argument.substr(0, position_of_equal_sign);
+        const string value = position_of_equal_sign != string::npos ? argument.substr(position_of_equal_sign + 1) : string();
+        vector<double> values;
+        bool success = true;
+        if (name == "--rect")
+        {
+            success = TryParseDoubleList(value, 4, values);
+            if (success)
+            {
+                // the constructor is throwing for a negative width or height
+                try
+                {
+                    selection.rectangle = RectangleD{ values[0], values[1], values[2], values[3] };
+                }
+                catch (invalid_argument&)
+                {
+                    success = false;
+                }
+            }
+        }
+        else if (name == "--cuboid")
+        {
+            success = TryParseDoubleList(value, 6, values);
+            if (success)
+            {
+                try
+                {
+                    selection.cuboid = CuboidD{ values[0], values[1], values[2], values[3], values[4], values[5] };
+                }
+                catch (invalid_argument&)
+                {
+                    success = false;
+                }
+            }
+        }
+        else if (name == "--plane")
+        {
+            success = TryParsePlaneCoordinate(value, coordinate_clause);
+            selection.coordinate_clause = &coordinate_clause;
+        }
+        else if (name == "--pyramid-level")
+        {
+            success = TryParseDoubleList(value, 1, values) && values[0] >= 0 && values[0] <= INT32_MAX && values[0] == static_cast<int>(values[0]);
+            if (success)
+            {
+                tileinfo_clause.AddPyramidLevelCondition(LogicalOperator::Invalid, ComparisonOperation::Equal, static_cast<int>(values[0]));
+                selection.tileinfo_clause = &tileinfo_clause;
+            }
+        }
+        else
+        {
+            success = false;
+        }
+
+        if (!success)
+        {
+            cerr << "Error: invalid option \"" << argument << "\"." << endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    try
+    {
+        auto open_existing_options = ClassFactory::CreateOpenExistingOptionsUp();
+        open_existing_options->SetFilename(source_filename);
+        open_existing_options->SetOpenReadonly(true);
+        const auto doc = ClassFactory::OpenExisting(open_existing_options.get());
+        doc->CreateSubsetCopy(destination_filename, &selection);
+    }
+    catch (exception& exception)
+    {
+        cerr << "Error: " << exception.what() << endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+void PrintUsage()
+{
+    cout << "Usage:" << endl;
+    cout << "  imgdoc2cmd compact <source> <destination>" << endl;
+    cout << "    Create a compacted copy of the document <source>, where the tiles are stored" << endl;
+    cout << "    in a locality-preserving order. The file <destination> must not exist." << endl;
+    cout << "  imgdoc2cmd merge <destination> <source1> <source2> ..." << endl;
+    cout << "    Merge the documents <source1>, <source2>, ... into the new document <destination>. The documents" << endl;
+    cout << "    must be of the same type and have the same dimensions. The metadata is taken from <source1>." << endl;
+    cout << "  imgdoc2cmd subset <source> <destination> [options]" << endl;
+    cout << "    Copy the tiles of <source> matching all of the given criteria (and the metadata) into the new" << endl;
+    cout << "    document <destination>. Options:" << endl;
+    cout << "      --rect=<x>,<y>,<w>,<h>                  the tiles intersecting with this rectangle (2D only)" << endl;
+    cout << "      --cuboid=<x>,<y>,<z>,<w>,<h>,<d>        the bricks intersecting with this cuboid (3D only)" << endl;
+    cout << "      --plane=<dim>:<value>,...               the tiles with this coordinate, e.g. \"C:0,T:1\"" << endl;
+    cout << "      --pyramid-level=<n>                     the tiles on this pyramid-level" << endl;
+    cout << "  imgdoc2cmd generate <destination> [options]" << endl;
+    cout << "    Generate a synthetic document (for scaling tests and benchmarks). The same options" << endl;
+    cout << "    give the same document. The file <destination> must not exist. Options:" << endl;
+    cout << "      --type=2d|3d                a 2D-mosaic of tiles or a 3D-volume of bricks (default: 2d)" << endl;
+    cout << "      --tiles=<x>x<y>[x<z>]       the number of tiles on pyramid-level 0 (default: 10x10x1)" << endl;
+    cout << "      --tile-size=<w>x<h>[x<d>]   the size of a tile in pixels (default: 1024x1024x64)" << endl;
+    cout << "      --overlap=<fraction>        the overlap of adjacent tiles, in [0, 1) (default: 0)" << endl;
+    cout << "      --pyramid-levels=<n>        the number of pyramid-levels (default: 1)" << endl;
+    cout << "      --planes=<dim>:<n>,...      additional dimensions, e.g. \"C:3,T:10\" (default: none)" << endl;
+    cout << "      --blob-size=<bytes>         the size of the data of each tile (default: 0, no data)" << endl;
+    cout << "      --data-type=<type>          zero|uncompressed|jpgxr|zstd0|zstd1 (default: zero); note that" << endl;
+    cout << "                                  the data is pseudo-random and is not a valid bitstream" << endl;
+    cout << "      --metadata-items=<n>        the number of metadata items (default: 0)" << endl;
+    cout << "      --metadata-fan-out=<n>      the number of children of a metadata node (default: 10)" << endl;
+    cout << "      --seed=<n>                  the seed for the pseudo-random content (default: 1)" << endl;
+    cout << "      --spatial-index             create a spatial index" << endl;
+    cout << "      --batch-size=<n>            the number of tiles added with one call (default: 1000)" << endl;
+    cout << "      --commit-interval=<n>       the number of tiles added in one transaction (default: 100000)" << endl;
+}
+
 int main(int argc, char** argv)
 {
+    if (argc > 1)
+    {
+        if (strcmp(argv[1], "compact") == 0 && argc == 4)
+        {
+            return Compact(argv[2], argv[3]);
+        }
+
+        if (strcmp(argv[1], "merge") == 0 && argc >= 4)
+        {
+            return Merge(argv[2], vector<const char*>(argv + 3, argv + argc));
+        }
+
+        if (strcmp(argv[1], "subset") == 0 && argc >= 4)
+        {
+            return Subset(argv[2], argv[3], argc - 4, argv + 4);
+        }
+
+        if (strcmp(argv[1], "generate") == 0 && argc >= 3)
+        {
+            return Generate(argv[2], argc - 3, argv + 3);
+        }
+
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
     //Test1();
     //Test2();
     //Test3();
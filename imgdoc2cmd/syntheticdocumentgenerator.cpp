@@ -0,0 +1,523 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include "syntheticdocumentgenerator.h"
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <sstream>
+
+using namespace std;
+using namespace imgdoc2;
+
+namespace
+{
+    /// The key of the user property (c.f. IDocWrite2d::SetUserProperty) where the parameters of the generator are stored.
+    constexpr const char* kUserPropertyKeyGeneratorParameters = "imgdoc2cmd.SyntheticDocumentParameters";
+
+    /// A simple pseudo-random number generator (xorshift64*), giving the same sequence on all platforms.
+    class RandomNumberGenerator
+    {
+    private:
+        uint64_t state_;
+    public:
+        explicit RandomNumberGenerator(uint64_t seed) : state_(seed != 0 ? seed : 0x9E3779B97F4A7C15ULL)
+        {}
+
+        uint64_t Next()
+        {
+            this->state_ ^= this->state_ >> 12;
+            this->state_ ^= this->state_ << 25;
+            this->state_ ^= this->state_ >> 27;
+            return this->state_ * 0x2545F4914F6CDD1DULL;
+        }
+    };
+
+    uint32_t GetTileCountOnPyramidLevel(uint32_t tile_count, uint32_t pyramid_level)
+    {
+        const uint64_t factor = 1ULL << pyramid_level;
+        return static_cast<uint32_t>((tile_count + factor - 1) / factor);
+    }
+
+    const char* DataTypeToString(DataTypes data_type)
+    {
+        switch (data_type)
+        {
+        case DataTypes::ZERO:
+            return "zero";
+        case DataTypes::UNCOMPRESSED_BITMAP:
+        case DataTypes::UNCOMPRESSED_BRICK:
+            return "uncompressed";
+        case DataTypes::JPGXRCOMPRESSED_BITMAP:
+            return "jpgxr";
+        case DataTypes::ZSTD0COMPRESSED_BITMAP:
+            return "zstd0";
+        case DataTypes::ZSTD1COMPRESSED_BITMAP:
+            return "zstd1";
+        default:
+            return "other";
+        }
+    }
+}
+
+SyntheticDocumentGenerator::SyntheticDocumentGenerator(const SyntheticDocumentParameters& parameters) :
+    parameters_(parameters)
+{
+    this->ValidateParameters();
+    this->CreateBlobs();
+}
+
+std::uint64_t SyntheticDocumentGenerator::GetTotalTileCount() const
+{
+    uint64_t tile_count_per_plane = 0;
+    for (uint32_t pyramid_level = 0; pyramid_level < this->parameters_.pyramid_levels; ++pyramid_level)
+    {
+        tile_count_per_plane += this->GetTileCountOnPyramidLevel(pyramid_level);
+    }
+
+    return tile_count_per_plane * this->GetPlaneCount();
+}
+
+void SyntheticDocumentGenerator::Generate(const ProgressFunction& report_progress)
+{
+    const auto document = this->CreateDocument();
+    if (this->parameters_.is_3d)
+    {
+        const auto writer = document->GetWriter3d();
+        writer->SetUserProperty(kUserPropertyKeyGeneratorParameters, this->GetParametersAsString());
+        this->GenerateBricks(writer, report_progress);
+        this->GenerateMetadata(document, writer);
+    }
+    else
+    {
+        const auto writer = document->GetWriter2d();
+        writer->SetUserProperty(kUserPropertyKeyGeneratorParameters, this->GetParametersAsString());
+        this->GenerateTiles(writer, report_progress);
+        this->GenerateMetadata(document, writer);
+    }
+}
+
+void SyntheticDocumentGenerator::ValidateParameters() const
+{
+    const auto& parameters = this->parameters_;
+    if (parameters.filename.empty())
+    {
+        throw invalid_argument_exception("No filename was given.");
+    }
+
+    if (parameters.tiles_x == 0 || parameters.tiles_y == 0 || (parameters.is_3d && parameters.tiles_z == 0))
+    {
+        throw invalid_argument_exception("The number of tiles must be greater than zero.");
+    }
+
+    if (parameters.tile_width == 0 || parameters.tile_height == 0 || (parameters.is_3d && parameters.tile_depth == 0))
+    {
+        throw invalid_argument_exception("The size of a tile must be greater than zero.");
+    }
+
+    if (!(parameters.overlap >= 0 && parameters.overlap < 1))
+    {
+        throw invalid_argument_exception("The overlap must be in the range [0, 1).");
+    }
+
+    if (parameters.pyramid_levels == 0 || parameters.pyramid_levels > 31)
+    {
+        throw invalid_argument_exception("The number of pyramid-levels must be in the range [1, 31].");
+    }
+
+    for (const auto& plane : parameters.planes)
+    {
+        if (!IsDimensionValid(plane.first) || plane.first == 'M')
+        {
+            ostringstream string_stream;
+            string_stream << "The dimension '" << plane.first << "' is not valid for a plane (note that 'M' is used for the mosaic index).";
+            throw invalid_argument_exception(string_stream.str().c_str());
+        }
+
+        if (plane.second <= 0)
+        {
+            throw invalid_argument_exception("The number of values of a plane-dimension must be greater than zero.");
+        }
+
+        for (const auto& other_plane : parameters.planes)
+        {
+            if (&other_plane != &plane && other_plane.first == plane.first)
+            {
+                throw invalid_argument_exception("A plane-dimension must only be given once.");
+            }
+        }
+    }
+
+    if (parameters.blob_size == 0 && parameters.data_type != DataTypes::ZERO)
+    {
+        throw invalid_argument_exception("A data type other than \"zero\" requires a blob size greater than zero.");
+    }
+
+    const bool data_type_valid = parameters.is_3d ?
+        (parameters.data_type == DataTypes::ZERO || parameters.data_type == DataTypes::UNCOMPRESSED_BRICK) :
+        (parameters.data_type == DataTypes::ZERO ||
+            parameters.data_type == DataTypes::UNCOMPRESSED_BITMAP ||
+            parameters.data_type == DataTypes::JPGXRCOMPRESSED_BITMAP ||
+            parameters.data_type == DataTypes::ZSTD0COMPRESSED_BITMAP ||
+            parameters.data_type == DataTypes::ZSTD1COMPRESSED_BITMAP);
+    if (!data_type_valid)
+    {
+        throw invalid_argument_exception("The data type is not valid for this type of document.");
+    }
+
+    if (parameters.metadata_items > 0 && parameters.metadata_fan_out == 0)
+    {
+        throw invalid_argument_exception("The fan-out of the metadata tree must be greater than zero.");
+    }
+
+    if (parameters.batch_size == 0)
+    {
+        throw invalid_argument_exception("The batch size must be greater than zero.");
+    }
+}
+
+void SyntheticDocumentGenerator::CreateBlobs()
+{
+    if (this->parameters_.blob_size == 0)
+    {
+        return;
+    }
+
+    for (int i = 0; i < SyntheticDocumentGenerator::kNumberOfDifferentBlobs; ++i)
+    {
+        auto blob = make_unique<DataObjectOnHeap>(static_cast<size_t>(this->parameters_.blob_size));
+        RandomNumberGenerator random_number_generator(this->parameters_.seed + i);
+        uint8_t* data = blob->GetData();
+        for (size_t offset = 0; offset < blob->GetSizeOfData(); offset += sizeof(uint64_t))
+        {
+            const uint64_t random_value = random_number_generator.Next();
+            memcpy(data + offset, &random_value, min(sizeof(uint64_t), blob->GetSizeOfData() - offset));
+        }
+
+        this->blobs_.emplace_back(std::move(blob));
+    }
+}
+
+std::shared_ptr<imgdoc2::IDoc> SyntheticDocumentGenerator::CreateDocument() const
+{
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetFilename(this->parameters_.filename.c_str());
+    create_options->SetDocumentType(this->parameters_.is_3d ? DocumentType::kImage3d : DocumentType::kImage2d);
+    create_options->SetUseSpatialIndex(this->parameters_.use_spatial_index);
+    create_options->SetCreateBlobTable(this->parameters_.blob_size > 0);
+    create_options->AddDimension('M');
+    create_options->AddIndexForDimension('M');
+    for (const auto& plane : this->parameters_.planes)
+    {
+        create_options->AddDimension(plane.first);
+        create_options->AddIndexForDimension(plane.first);
+    }
+
+    return ClassFactory::CreateNew(create_options.get());
+}
+
+std::uint64_t SyntheticDocumentGenerator::GetPlaneCount() const
+{
+    uint64_t plane_count = 1;
+    for (const auto& plane : this->parameters_.planes)
+    {
+        plane_count *= plane.second;
+    }
+
+    return plane_count;
+}
+
+std::uint64_t SyntheticDocumentGenerator::GetTileCountOnPyramidLevel(std::uint32_t pyramid_level) const
+{
+    uint64_t tile_count = static_cast<uint64_t>(::GetTileCountOnPyramidLevel(this->parameters_.tiles_x, pyramid_level)) *
+        ::GetTileCountOnPyramidLevel(this->parameters_.tiles_y, pyramid_level);
+    if (this->parameters_.is_3d)
+    {
+        tile_count *= ::GetTileCountOnPyramidLevel(this->parameters_.tiles_z, pyramid_level);
+    }
+
+    return tile_count;
+}
+
+const imgdoc2::IDataObjBase* SyntheticDocumentGenerator::GetBlob(std::uint64_t tile_number) const
+{
+    if (this->blobs_.empty())
+    {
+        return nullptr;
+    }
+
+    return this->blobs_[tile_number % this->blobs_.size()].get();
+}
+
+imgdoc2::TileDataStorageType SyntheticDocumentGenerator::GetStorageType() const
+{
+    return this->blobs_.empty() ? TileDataStorageType::Invalid : TileDataStorageType::BlobInDatabase;
+}
+
+void SyntheticDocumentGenerator::SetPlaneCoordinate(std::uint64_t plane_number, imgdoc2::TileCoordinate& tile_coordinate) const
+{
+    for (const auto& plane : this->parameters_.planes)
+    {
+        tile_coordinate.Set(plane.first, static_cast<int>(plane_number % plane.second));
+        plane_number /= plane.second;
+    }
+}
+
+void SyntheticDocumentGenerator::GenerateTiles(const std::shared_ptr<imgdoc2::IDocWrite2d>& writer, const ProgressFunction& report_progress)
+{
+    const uint64_t total_count = this->GetTotalTileCount();
+    const uint32_t batch_size = this->parameters_.batch_size;
+    const double step_x = this->parameters_.tile_width * (1 - this->parameters_.overlap);
+    const double step_y = this->parameters_.tile_height * (1 - this->parameters_.overlap);
+
+    TileBaseInfo tile_base_info;
+    tile_base_info.pixelWidth = this->parameters_.tile_width;
+    tile_base_info.pixelHeight = this->parameters_.tile_height;
+    tile_base_info.pixelType = this->parameters_.pixel_type;
+
+    vector<TileCoordinate> coordinates(batch_size);
+    vector<LogicalPositionInfo> logical_positions(batch_size);
+    vector<TileToAdd> tiles(batch_size);
+    uint32_t count_in_batch = 0;
+    uint64_t count_added = 0;
+    const auto add_batch = [&]()
+    {
+        writer->AddTiles(tiles.data(), count_in_batch, nullptr);
+        count_added += count_in_batch;
+        count_in_batch = 0;
+        if (report_progress)
+        {
+            report_progress(count_added, total_count);
+        }
+    };
+
+    AutoCommitPolicy auto_commit_policy;
+    auto_commit_policy.max_items = max(this->parameters_.commit_interval, 1u);
+    writer->SetAutoCommitPolicy(auto_commit_policy);
+
+    const uint64_t plane_count = this->GetPlaneCount();
+    for (uint64_t plane_number = 0; plane_number < plane_count; ++plane_number)
+    {
+        for (uint32_t pyramid_level = 0; pyramid_level < this->parameters_.pyramid_levels; ++pyramid_level)
+        {
+            const double factor = static_cast<double>(1ULL << pyramid_level);
+            const uint32_t tiles_x = ::GetTileCountOnPyramidLevel(this->parameters_.tiles_x, pyramid_level);
+            const uint32_t tiles_y = ::GetTileCountOnPyramidLevel(this->parameters_.tiles_y, pyramid_level);
+            for (uint32_t y = 0; y < tiles_y; ++y)
+            {
+                for (uint32_t x = 0; x < tiles_x; ++x)
+                {
+                    auto& coordinate = coordinates[count_in_batch];
+                    coordinate.Clear();
+                    this->SetPlaneCoordinate(plane_number, coordinate);
+                    coordinate.Set('M', static_cast<int>(static_cast<uint64_t>(y) * tiles_x + x));
+
+                    auto& logical_position = logical_positions[count_in_batch];
+                    logical_position.posX = x * step_x * factor;
+                    logical_position.posY = y * step_y * factor;
+                    logical_position.width = this->parameters_.tile_width * factor;
+                    logical_position.height = this->parameters_.tile_height * factor;
+                    logical_position.pyrLvl = static_cast<int>(pyramid_level);
+
+                    auto& tile = tiles[count_in_batch];
+                    tile.coordinate = &coordinate;
+                    tile.logical_position_info = &logical_position;
+                    tile.tile_base_info = &tile_base_info;
+                    tile.data_type = this->parameters_.data_type;
+                    tile.storage_type = this->GetStorageType();
+                    tile.data = this->GetBlob(count_added + count_in_batch);
+                    if (++count_in_batch == batch_size)
+                    {
+                        add_batch();
+                    }
+                }
+            }
+        }
+    }
+
+    if (count_in_batch > 0)
+    {
+        add_batch();
+    }
+
+    // this commits the pending transaction
+    writer->SetAutoCommitPolicy(AutoCommitPolicy{});
+}
+
+void SyntheticDocumentGenerator::GenerateBricks(const std::shared_ptr<imgdoc2::IDocWrite3d>& writer, const ProgressFunction& report_progress)
+{
+    const uint64_t total_count = this->GetTotalTileCount();
+    const uint32_t batch_size = this->parameters_.batch_size;
+    const double step_x = this->parameters_.tile_width * (1 - this->parameters_.overlap);
+    const double step_y = this->parameters_.tile_height * (1 - this->parameters_.overlap);
+    const double step_z = this->parameters_.tile_depth * (1 - this->parameters_.overlap);
+
+    BrickBaseInfo brick_base_info;
+    brick_base_info.pixelWidth = this->parameters_.tile_width;
+    brick_base_info.pixelHeight = this->parameters_.tile_height;
+    brick_base_info.pixelDepth = this->parameters_.tile_depth;
+    brick_base_info.pixelType = this->parameters_.pixel_type;
+
+    vector<TileCoordinate> coordinates(batch_size);
+    vector<LogicalPositionInfo3D> logical_positions(batch_size);
+    vector<BrickToAdd> bricks(batch_size);
+    uint32_t count_in_batch = 0;
+    uint64_t count_added = 0;
+    const auto add_batch = [&]()
+    {
+        writer->AddBricks(bricks.data(), count_in_batch, nullptr);
+        count_added += count_in_batch;
+        count_in_batch = 0;
+        if (report_progress)
+        {
+            report_progress(count_added, total_count);
+        }
+    };
+
+    AutoCommitPolicy auto_commit_policy;
+    auto_commit_policy.max_items = max(this->parameters_.commit_interval, 1u);
+    writer->SetAutoCommitPolicy(auto_commit_policy);
+
+    const uint64_t plane_count = this->GetPlaneCount();
+    for (uint64_t plane_number = 0; plane_number < plane_count; ++plane_number)
+    {
+        for (uint32_t pyramid_level = 0; pyramid_level < this->parameters_.pyramid_levels; ++pyramid_level)
+        {
+            const double factor = static_cast<double>(1ULL << pyramid_level);
+            const uint32_t tiles_x = ::GetTileCountOnPyramidLevel(this->parameters_.tiles_x, pyramid_level);
+            const uint32_t tiles_y = ::GetTileCountOnPyramidLevel(this->parameters_.tiles_y, pyramid_level);
+            const uint32_t tiles_z = ::GetTileCountOnPyramidLevel(this->parameters_.tiles_z, pyramid_level);
+            for (uint32_t z = 0; z < tiles_z; ++z)
+            {
+                for (uint32_t y = 0; y < tiles_y; ++y)
+                {
+                    for (uint32_t x = 0; x < tiles_x; ++x)
+                    {
+                        auto& coordinate = coordinates[count_in_batch];
+                        coordinate.Clear();
+                        this->SetPlaneCoordinate(plane_number, coordinate);
+                        coordinate.Set('M', static_cast<int>((static_cast<uint64_t>(z) * tiles_y + y) * tiles_x + x));
+
+                        auto& logical_position = logical_positions[count_in_batch];
+                        logical_position.posX = x * step_x * factor;
+                        logical_position.posY = y * step_y * factor;
+                        logical_position.posZ = z * step_z * factor;
+                        logical_position.width = this->parameters_.tile_width * factor;
+                        logical_position.height = this->parameters_.tile_height * factor;
+                        logical_position.depth = this->parameters_.tile_depth * factor;
+                        logical_position.pyrLvl = static_cast<int>(pyramid_level);
+
+                        auto& brick = bricks[count_in_batch];
+                        brick.coordinate = &coordinate;
+                        brick.logical_position_info = &logical_position;
+                        brick.brick_base_info = &brick_base_info;
+                        brick.data_type = this->parameters_.data_type;
+                        brick.storage_type = this->GetStorageType();
+                        brick.data = this->GetBlob(count_added + count_in_batch);
+                        if (++count_in_batch == batch_size)
+                        {
+                            add_batch();
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    if (count_in_batch > 0)
+    {
+        add_batch();
+    }
+
+    // this commits the pending transaction
+    writer->SetAutoCommitPolicy(AutoCommitPolicy{});
+}
+
+void SyntheticDocumentGenerator::GenerateMetadata(const std::shared_ptr<imgdoc2::IDoc>& document, const std::shared_ptr<imgdoc2::IDatabaseTransaction>& transaction) const
+{
+    const uint64_t item_count = this->parameters_.metadata_items;
+    if (item_count == 0)
+    {
+        return;
+    }
+
+    // The items are arranged in a tree (in breadth-first order), where each node has "metadata_fan_out" children - i.e.
+    //  the parent of item n is the item "n / fan_out - 1" (or the root if this is negative). We keep track of the primary
+    //  keys of the items which are parents.
+    const uint64_t fan_out = this->parameters_.metadata_fan_out;
+    const uint64_t parent_count = item_count / fan_out;
+    vector<dbIndex> primary_keys_of_parents;
+    primary_keys_of_parents.reserve(static_cast<size_t>(parent_count));
+
+    const auto metadata_writer = document->GetDocumentMetadataWriter();
+    const uint64_t commit_interval = max(this->parameters_.commit_interval, 1u);
+    RandomNumberGenerator random_number_generator(this->parameters_.seed);
+    transaction->BeginTransaction();
+    for (uint64_t n = 0; n < item_count; ++n)
+    {
+        const optional<dbIndex> parent = n < fan_out ? optional<dbIndex>() : optional<dbIndex>(primary_keys_of_parents[n / fan_out - 1]);
+        const string name = "Item" + to_string(n);
+        const uint64_t random_value = random_number_generator.Next();
+        dbIndex primary_key;
+        switch (n % 3)
+        {
+        case 0:
+            primary_key = metadata_writer->UpdateOrCreateItem(parent, true, name, DocumentMetadataType::kInt32, IDocumentMetadataWrite::metadata_item_variant(static_cast<int32_t>(random_value)));
+            break;
+        case 1:
+            primary_key = metadata_writer->UpdateOrCreateItem(parent, true, name, DocumentMetadataType::kDouble, IDocumentMetadataWrite::metadata_item_variant(static_cast<double>(random_value >> 11) / (1ULL << 53)));
+            break;
+        default:
+            primary_key = metadata_writer->UpdateOrCreateItem(parent, true, name, DocumentMetadataType::kText, IDocumentMetadataWrite::metadata_item_variant(to_string(random_value)));
+            break;
+        }
+
+        if (n < parent_count)
+        {
+            primary_keys_of_parents.push_back(primary_key);
+        }
+
+        if ((n + 1) % commit_interval == 0)
+        {
+            transaction->CommitTransaction();
+            transaction->BeginTransaction();
+        }
+    }
+
+    transaction->CommitTransaction();
+}
+
+std::string SyntheticDocumentGenerator::GetParametersAsString() const
+{
+    const auto& parameters = this->parameters_;
+    ostringstream string_stream;
+    string_stream << "type=" << (parameters.is_3d ? "3d" : "2d") <<
+        ";tiles=" << parameters.tiles_x << "x" << parameters.tiles_y;
+    if (parameters.is_3d)
+    {
+        string_stream << "x" << parameters.tiles_z;
+    }
+
+    string_stream << ";tile_size=" << parameters.tile_width << "x" << parameters.tile_height;
+    if (parameters.is_3d)
+    {
+        string_stream << "x" << parameters.tile_depth;
+    }
+
+    string_stream << ";overlap=" << parameters.overlap <<
+        ";pyramid_levels=" << parameters.pyramid_levels <<
+        ";planes=";
+    for (size_t i = 0; i < parameters.planes.size(); ++i)
+    {
+        string_stream << (i > 0 ? "," : "") << parameters.planes[i].first << ":" << parameters.planes[i].second;
+    }
+
+    string_stream << ";blob_size=" << parameters.blob_size <<
+        ";data_type=" << DataTypeToString(parameters.data_type) <<
+        ";pixel_type=" << static_cast<int>(parameters.pixel_type) <<
+        ";metadata_items=" << parameters.metadata_items <<
+        ";metadata_fan_out=" << parameters.metadata_fan_out <<
+        ";seed=" << parameters.seed;
+    return string_stream.str();
+}
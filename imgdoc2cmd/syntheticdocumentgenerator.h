@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <imgdoc2.h>
+
+/// The parameters for generating a synthetic document (c.f. SyntheticDocumentGenerator).
+struct SyntheticDocumentParameters
+{
+    std::string filename;                       ///< The filename of the document to be created (which must not exist).
+    bool is_3d{ false };                        ///< Whether a 3D-document (with bricks) is to be created, otherwise a 2D-document (with tiles).
+
+    /// The number of tiles (or bricks) in x-, y- and z-direction of the mosaic on pyramid-level 0 (the z-value is only
+    /// relevant for 3D-documents).
+    std::uint32_t tiles_x{ 10 };
+    std::uint32_t tiles_y{ 10 };
+    std::uint32_t tiles_z{ 1 };
+
+    /// The size of a tile (or brick) in pixels (the depth is only relevant for 3D-documents).
+    std::uint32_t tile_width{ 1024 };
+    std::uint32_t tile_height{ 1024 };
+    std::uint32_t tile_depth{ 64 };
+
+    double overlap{ 0.0 };                      ///< The overlap of adjacent tiles (as a fraction of the tile size, in the range [0, 1)).
+    std::uint32_t pyramid_levels{ 1 };          ///< The number of pyramid-levels (where 1 means "only pyramid-level 0").
+
+    /// The "planes" of the document - for each combination of the values of those dimensions, a complete mosaic is
+    /// generated. Each element gives the dimension and the number of values (starting with zero).
+    std::vector<std::pair<imgdoc2::Dimension, int>> planes;
+
+    std::uint64_t blob_size{ 0 };               ///< The size of the data blob of each tile (or brick) in bytes, where 0 means "no blob".
+    imgdoc2::DataTypes data_type{ imgdoc2::DataTypes::ZERO };  ///< The data type stored with each tile (or brick).
+    std::uint8_t pixel_type{ imgdoc2::PixelType::Gray8 };      ///< The pixel type stored with each tile (or brick).
+
+    std::uint64_t metadata_items{ 0 };          ///< The number of metadata items to be created.
+    std::uint32_t metadata_fan_out{ 10 };       ///< The number of children of each node in the metadata tree.
+
+    std::uint64_t seed{ 1 };                    ///< The seed for the pseudo-random content (of the blobs and the metadata values).
+    bool use_spatial_index{ false };            ///< Whether the document is to use a spatial index.
+    std::uint32_t batch_size{ 1000 };           ///< The number of tiles (or bricks) added with one call to AddTiles (or AddBricks).
+    std::uint32_t commit_interval{ 100000 };    ///< The number of tiles (or bricks) added in one transaction.
+};
+
+/// This class is generating synthetic documents (2D-mosaics or 3D-brick-volumes) for scaling tests and benchmarks. The
+/// documents are reproducible - i.e. with the same parameters, the same document is generated. The tiles (or bricks) are
+/// added with the batch write path (AddTiles/AddBricks) and with an auto-commit policy, so that documents with hundreds of
+/// millions of tiles can be generated in reasonable time.
+/// Note that the blobs are filled with pseudo-random content, which is stored with the data type given in the parameters -
+/// i.e. for a data type other than "uncompressed", the blobs are not valid bitstreams and cannot be decoded.
+class SyntheticDocumentGenerator
+{
+public:
+    /// A functor which is called periodically in order to report the progress. The arguments are the number of tiles
+    /// (or bricks) added so far and the total number of tiles (or bricks).
+    using ProgressFunction = std::function<void(std::uint64_t, std::uint64_t)>;
+private:
+    /// The number of different blobs used (in round-robin fashion), so that not all blobs are identical.
+    static constexpr int kNumberOfDifferentBlobs = 16;
+
+    SyntheticDocumentParameters parameters_;
+    std::vector<std::unique_ptr<imgdoc2::DataObjectOnHeap>> blobs_;
+public:
+    /// Constructor. The parameters are validated, and an invalid_argument_exception is thrown if they are invalid.
+    ///
+    /// \param  parameters  The parameters.
+    explicit SyntheticDocumentGenerator(const SyntheticDocumentParameters& parameters);
+
+    /// Gets the total number of tiles (or bricks) which will be generated.
+    ///
+    /// \returns    The total number of tiles (or bricks).
+    [[nodiscard]] std::uint64_t GetTotalTileCount() const;
+
+    /// Generates the document.
+    ///
+    /// \param  report_progress A functor for reporting the progress (may be empty).
+    void Generate(const ProgressFunction& report_progress);
+private:
+    void ValidateParameters() const;
+    void CreateBlobs();
+    [[nodiscard]] std::shared_ptr<imgdoc2::IDoc> CreateDocument() const;
+    [[nodiscard]] std::uint64_t GetPlaneCount() const;
+    [[nodiscard]] std::uint64_t GetTileCountOnPyramidLevel(std::uint32_t pyramid_level) const;
+    [[nodiscard]] const imgdoc2::IDataObjBase* GetBlob(std::uint64_t tile_number) const;
+    [[nodiscard]] imgdoc2::TileDataStorageType GetStorageType() const;
+    void SetPlaneCoordinate(std::uint64_t plane_number, imgdoc2::TileCoordinate& tile_coordinate) const;
+    void GenerateTiles(const std::shared_ptr<imgdoc2::IDocWrite2d>& writer, const ProgressFunction& report_progress);
+    void GenerateBricks(const std::shared_ptr<imgdoc2::IDocWrite3d>& writer, const ProgressFunction& report_progress);
+    void GenerateMetadata(const std::shared_ptr<imgdoc2::IDoc>& document, const std::shared_ptr<imgdoc2::IDatabaseTransaction>& transaction) const;
+
+    /// Gets the parameters formatted as a string (which is stored as a user property in the document).
+    [[nodiscard]] std::string GetParametersAsString() const;
+};
@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+
+namespace imgdoc2
+{
+    /// This structure defines an "auto-commit policy" for a writer object (c.f. IDocWrite2d::SetAutoCommitPolicy and
+    /// IDocWrite3d::SetAutoCommitPolicy). With an auto-commit policy in effect, the write operations (which are not part of
+    /// an explicitly started transaction) are grouped into transactions - a transaction is started with the first write
+    /// operation, and it is committed as soon as one of the limits given here is reached. A value of zero means "no limit",
+    /// and if all limits are zero, the auto-commit policy is disabled (which is the default), meaning that each write
+    /// operation is executed in a transaction of its own.
+    struct AutoCommitPolicy
+    {
+        /// The maximal number of items (i.e. tiles or bricks) added within one transaction.
+        std::uint32_t max_items{ 0 };
+
+        /// The maximal number of bytes (of tile or brick data) added within one transaction.
+        std::uint64_t max_bytes{ 0 };
+
+        /// The maximal duration (in milliseconds) of a transaction. Note that this is only checked when a write operation
+        /// is executed, i.e. the transaction is committed with the first write operation completing after this duration has
+        /// elapsed.
+        std::uint32_t max_duration_milliseconds{ 0 };
+
+        /// Query if the auto-commit policy is enabled, i.e. if any of the limits is given.
+        /// \returns True if the auto-commit policy is enabled; false otherwise.
+        [[nodiscard]] bool IsEnabled() const
+        {
+            return this->max_items > 0 || this->max_bytes > 0 || this->max_duration_milliseconds > 0;
+        }
+    };
+}
@@ -24,6 +24,15 @@ namespace imgdoc2
         std::uint8_t pixelType{ imgdoc2::PixelType::Unknown };
     };
 
+    /// This structure gives the size of the chunks a brick is divided into (cf. IDocWrite3d::AddChunkedBrick). The chunks
+    /// at the right, top and back border of the brick may be smaller than this size.
+    struct BrickChunkExtent
+    {
+        std::uint32_t width{ 0 };     ///< Width of a chunk in unit of pixels.
+        std::uint32_t height{ 0 };    ///< Height of a chunk in unit of pixels.
+        std::uint32_t depth{ 0 };     ///< Depth of a chunk in unit of pixels.
+    };
+
     /// This gives the brick blob information - the base information we can provide about the bitmap
     /// contained in the corresponding blob. This information is part of the database and is available
     /// without inspecting/decoding the blob itself.
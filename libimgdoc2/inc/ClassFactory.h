@@ -24,6 +24,12 @@ namespace imgdoc2
         /// \returns    The version information.
         static VersionInfo GetVersionInfo();
 
+        /// Gets the number of database statements which have been prepared so far (by all documents of the process). This
+        /// is intended for diagnostic purposes, e.g. for observing whether statements are re-used as expected.
+        ///
+        /// \returns    The number of database statements prepared.
+        static std::uint64_t GetNumberOfStatementsPrepared();
+
         /// Creates an options-object for creating a new imgdoc2-document.
         /// \returns    Pointer to a newly create options-object.
         static imgdoc2::ICreateOptions* CreateCreateOptionsPtr();
@@ -28,6 +28,13 @@ namespace imgdoc2
         ZSTD1COMPRESSED_BITMAP = 4,
 
         UNCOMPRESSED_BRICK = 32,
+
+        /// The brick is divided into chunks of a fixed size, where each chunk is stored as a separate uncompressed brick. The binary blob
+        /// of the brick itself contains the "chunk index", which gives the layout of the chunks and a reference to the blob of each chunk.
+        /// This allows for reading a sub-volume of the brick without having to load the complete brick (cf. IDocWrite3d::AddChunkedBrick and
+        /// IDocQuery3d::ReadBrickSubVolume).
+        UNCOMPRESSED_CHUNKED_BRICK = 33,
+
         CUSTOM = 255
     };
 
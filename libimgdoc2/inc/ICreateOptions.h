@@ -48,6 +48,23 @@ namespace imgdoc2
         /// \param  create_blob_table True to create BLOB table.
         virtual void SetCreateBlobTable(bool create_blob_table) = 0;
 
+        /// Sets the filename of a separate database-file which is to contain the BLOB table. If this is an empty string (which
+        /// is the default), then the BLOB table is created in the same file as all other tables. Otherwise, the BLOB table is
+        /// placed into the specified file, which is then attached automatically whenever the document is opened. This keeps the
+        /// (small) index-tables separate from the (huge) binary data. A relative filename is interpreted as relative to the
+        /// location of the document's file. This setting is only relevant if a BLOB table is to be created.
+        /// The string must be given in UTF-8 encoding.
+        ///
+        /// \param  filename  The filename (in UTF8-encoding) of the separate database-file for the BLOB table.
+        virtual void SetBlobDatabaseFilename(const char* filename) = 0;
+
+        /// Sets a flag indicating whether a tile-statistics table is to be constructed. If so, statistics of the pixel values (minimum,
+        /// maximum, sum, sum of squares and a small histogram sketch) are computed for each tile when it is added, and they are stored
+        /// in this table (c.f. TileStatistics). This allows for retrieving aggregated statistics (e.g. for a whole plane) without
+        /// reading the tile data.
+        /// \param  create_tile_statistics_table True to create the tile-statistics table.
+        virtual void SetCreateTileStatisticsTable(bool create_tile_statistics_table) = 0;
+
         /// Gets the document type.
         /// \returns    The document type.
         [[nodiscard]] virtual imgdoc2::DocumentType GetDocumentType() const = 0;
@@ -72,6 +89,14 @@ namespace imgdoc2
         /// \returns True if a blob table is to be created; false otherwise.
         [[nodiscard]] virtual bool GetCreateBlobTable() const = 0;
 
+        /// Gets the filename of the separate database-file which is to contain the BLOB table. The returned string is given in UTF8-encoding.
+        /// \returns The filename of the separate database-file for the BLOB table; or an empty string if the BLOB table is to be created in the main file.
+        [[nodiscard]] virtual const std::string& GetBlobDatabaseFilename() const = 0;
+
+        /// Gets a boolean indicating whether a tile-statistics table is to be created.
+        /// \returns True if a tile-statistics table is to be created; false otherwise.
+        [[nodiscard]] virtual bool GetCreateTileStatisticsTable() const = 0;
+
         virtual ~ICreateOptions() = default;
 
         /// Sets the filename. For a Sqlite-based database, this string allows for additional functionality
@@ -83,6 +108,15 @@ namespace imgdoc2
         {
             this->SetFilename(filename.c_str());
         }
+
+        /// Sets the filename of a separate database-file which is to contain the BLOB table.
+        /// The string must be given in UTF-8 encoding.
+        ///
+        /// \param  filename  The filename (in UTF8-encoding) of the separate database-file for the BLOB table.
+        void SetBlobDatabaseFilename(const std::string& filename)
+        {
+            this->SetBlobDatabaseFilename(filename.c_str());
+        }
     public:
         /// Adds the dimensions from the specified iterator.
         /// \tparam ForwardIterator Type of the forward iterator.
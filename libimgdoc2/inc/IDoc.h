@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include "TileSelection.h"
 
 namespace imgdoc2
 {
@@ -42,6 +43,35 @@ namespace imgdoc2
 
         virtual std::shared_ptr<imgdoc2::IDocumentMetadataRead> GetDocumentMetadataReader() = 0;
 
+        /// Creates a compacted copy of the document in the specified file. The copy is written with the tiles (or bricks) being
+        /// ordered by their tile-coordinate, their pyramid level and the position of their center on a space-filling curve (a
+        /// Hilbert-curve for 2D-documents, a Z-order-curve for 3D-documents), and the binary data of the tiles is stored in the
+        /// same order. So, tiles which are adjacent in space will - to a large extent - also be adjacent in the file, which
+        /// improves the performance of spatial queries and reads. Note that the primary keys of the tiles will be different in
+        /// the copy. The destination file must not exist. This operation is not possible while a transaction is pending, and it
+        /// is not supported for documents with a separate blob-database.
+        /// \param  destination_filename    The filename of the destination (in UTF8-encoding).
+        virtual void CreateCompactedCopy(const char* destination_filename) = 0;
+
+        /// Imports (i.e. copies) the tiles (or bricks) of another document into this document - either all of them, or the
+        /// ones matching the specified selection. The source document must be compatible, i.e. it must be of the same type
+        /// and have the same set of dimensions. The tiles (and their binary data) are copied within the database (without
+        /// decoding or re-encoding anything), and they are assigned new primary keys (following the primary keys already in
+        /// use in this document), and the spatial index is updated. The metadata of the source document is not copied. This
+        /// can be used for merging multiple documents into one. This operation is not possible while a transaction is pending,
+        /// and it is not supported for a source document with a separate blob-database.
+        /// \param  source_filename The filename of the source document (in UTF8-encoding).
+        /// \param  selection       The selection of the tiles to be imported; if null, all tiles are imported.
+        virtual void ImportTiles(const char* source_filename, const imgdoc2::TileSelection* selection) = 0;
+
+        /// Creates a new document containing the tiles (or bricks) matching the specified selection (and their binary data)
+        /// and the metadata of this document. The new document has the same configuration (dimensions, indices, spatial
+        /// index etc.) as this document. The destination file must not exist. This operation is not possible while a
+        /// transaction is pending, and it is not supported for an in-memory document or a document with a separate blob-database.
+        /// \param  destination_filename    The filename of the destination (in UTF8-encoding).
+        /// \param  selection               The selection of the tiles to be copied; if null, all tiles are copied.
+        virtual void CreateSubsetCopy(const char* destination_filename, const imgdoc2::TileSelection* selection) = 0;
+
         virtual ~IDoc() = default;
 
     public:
@@ -8,6 +8,7 @@
 #include <map>
 #include <cstdint>
 #include <limits>
+#include <string>
 #include "Intervals.h"
 
 namespace imgdoc2
@@ -43,6 +44,15 @@ namespace imgdoc2
         ///
         /// \returns A map, where key is the pyramid layer number, and value is the total number of tiles (on this layer) in the document.
         virtual std::map<int, std::uint64_t> GetTileCountPerLayer() = 0;
+
+        /// Attempts to get the "user property" with the specified key (c.f. IDocWrite2d::SetUserProperty and
+        /// IDocWrite3d::SetUserProperty).
+        ///
+        /// \param          key     The key of the property.
+        /// \param [out]    value   If non-null and the property exists, its value is put here.
+        ///
+        /// \returns    True if the property exists; false otherwise.
+        virtual bool TryGetUserProperty(const std::string& key, std::string* value) = 0;
     public:
         std::vector<imgdoc2::Dimension> GetTileDimensions()
         {
@@ -10,6 +10,7 @@
 #include "IDimCoordinateQueryClause.h"
 #include "ITIleInfoQueryClause.h"
 #include "IBlobOutput.h"
+#include "TileStatistics.h"
 
 namespace imgdoc2
 {
@@ -52,6 +53,29 @@ namespace imgdoc2
         /// \param          idx  The primary key of the tile for which the tile data is to be read.
         /// \param [in]     data The object which is receiving the blob data.
         virtual void ReadTileData(imgdoc2::dbIndex idx, imgdoc2::IBlobOutput* data) = 0;
+
+        /// Gets the size of the tile data for the specified tile (in bytes), without reading the data. This allows for providing
+        /// a buffer of the exact size before reading the data. If the tile does not exist, an exception of type
+        /// "imgdoc2::non_existing_tile_exception" is thrown.
+        /// \param  idx The primary key of the tile.
+        /// \returns The size of the tile data in bytes (which is 0 if the tile has no data).
+        virtual std::uint64_t GetTileDataSize(imgdoc2::dbIndex idx) = 0;
+
+        /// Reads the statistics of the specified tile from the tile-statistics table (c.f. ICreateOptions::SetCreateTileStatisticsTable),
+        /// i.e. without reading the tile data. If the tile does not exist, an exception of type "imgdoc2::non_existing_tile_exception" is thrown.
+        /// \param          idx         The primary key of the tile.
+        /// \param [out]    statistics  If successful, the statistics are put here.
+        /// \returns True if successful; false if there are no statistics for this tile (or the document has no tile-statistics table).
+        virtual bool TryReadTileStatistics(imgdoc2::dbIndex idx, imgdoc2::TileStatistics* statistics) = 0;
+
+        /// Aggregates the per-tile statistics of the tiles intersecting the specified rectangle (and satisfying the other criteria). Only
+        /// the tile-statistics table is accessed, the tile data is not read. If the document has no tile-statistics table, an exception
+        /// of type "imgdoc2::invalid_operation_exception" is thrown.
+        /// \param  rect              If non-null, only tiles intersecting this rectangle are taken into account.
+        /// \param  coordinate_clause The coordinate clause (may be null).
+        /// \param  tileinfo_clause   The tileinfo clause (may be null).
+        /// \returns The aggregated statistics.
+        virtual imgdoc2::TileStatisticsSummary GetTileStatisticsSummary(const imgdoc2::RectangleD* rect, const imgdoc2::IDimCoordinateQueryClause* coordinate_clause, const imgdoc2::ITileInfoQueryClause* tileinfo_clause) = 0;
     public:
         // no copy and no move (-> https://github.com/isocpp/CppCoreGuidelines/blob/master/CppCoreGuidelines.md#c21-if-you-define-or-delete-any-copy-move-or-destructor-function-define-or-delete-them-all )
         IDocQuery2d() = default;
@@ -9,6 +9,7 @@
 #include "IDimCoordinateQueryClause.h"
 #include "ITIleInfoQueryClause.h"
 #include "IBlobOutput.h"
+#include "TileStatistics.h"
 
 namespace imgdoc2
 {
@@ -61,6 +62,39 @@ namespace imgdoc2
         // /// \param          idx  The primary key of the brick for which the brick data is to be read.
         // /// \param [in]     data The object which is receiving the blob data.
         virtual void ReadBrickData(imgdoc2::dbIndex idx, imgdoc2::IBlobOutput* data) = 0;
+
+        /// Gets the size of the brick data for the specified brick (in bytes), without reading the data. This allows for providing
+        /// a buffer of the exact size before reading the data. If the brick does not exist, an exception of type
+        /// "imgdoc2::non_existing_tile_exception" is thrown.
+        /// \param  idx The primary key of the brick.
+        /// \returns The size of the brick data in bytes (which is 0 if the brick has no data).
+        virtual std::uint64_t GetBrickDataSize(imgdoc2::dbIndex idx) = 0;
+
+        /// Reads a sub-volume of the specified brick. The sub-volume is given in units of voxels, relative to the brick, and it must be
+        /// completely contained in the brick. The data is delivered as an uncompressed brick (with the layout as for DataTypes::UNCOMPRESSED_BRICK)
+        /// of the size of the sub-volume. For a brick with data-type DataTypes::UNCOMPRESSED_CHUNKED_BRICK, only the chunks intersecting
+        /// with the sub-volume are read. Bricks with data-type DataTypes::UNCOMPRESSED_BRICK are supported as well, but here the complete
+        /// brick is loaded. Other data-types are not supported, and an exception of type "imgdoc2::invalid_operation_exception" is thrown.
+        /// \param          idx  The primary key of the brick.
+        /// \param          roi  The sub-volume to be read (in units of voxels).
+        /// \param [in]     data The object which is receiving the data.
+        virtual void ReadBrickSubVolume(imgdoc2::dbIndex idx, const imgdoc2::CuboidI& roi, imgdoc2::IBlobOutput* data) = 0;
+
+        /// Reads the statistics of the specified brick from the tile-statistics table (c.f. ICreateOptions::SetCreateTileStatisticsTable),
+        /// i.e. without reading the brick data. If the brick does not exist, an exception of type "imgdoc2::non_existing_tile_exception" is thrown.
+        /// \param          idx         The primary key of the brick.
+        /// \param [out]    statistics  If successful, the statistics are put here.
+        /// \returns True if successful; false if there are no statistics for this brick (or the document has no tile-statistics table).
+        virtual bool TryReadBrickStatistics(imgdoc2::dbIndex idx, imgdoc2::TileStatistics* statistics) = 0;
+
+        /// Aggregates the per-brick statistics of the bricks intersecting the specified cuboid (and satisfying the other criteria). Only
+        /// the tile-statistics table is accessed, the brick data is not read. If the document has no tile-statistics table, an exception
+        /// of type "imgdoc2::invalid_operation_exception" is thrown.
+        /// \param  cuboid            If non-null, only bricks intersecting this cuboid are taken into account.
+        /// \param  coordinate_clause The coordinate clause (may be null).
+        /// \param  tileinfo_clause   The tileinfo clause (may be null).
+        /// \returns The aggregated statistics.
+        virtual imgdoc2::TileStatisticsSummary GetBrickStatisticsSummary(const imgdoc2::CuboidD* cuboid, const imgdoc2::IDimCoordinateQueryClause* coordinate_clause, const imgdoc2::ITileInfoQueryClause* tileinfo_clause) = 0;
     public:
         // no copy and no move (-> https://github.com/isocpp/CppCoreGuidelines/blob/master/CppCoreGuidelines.md#c21-if-you-define-or-delete-any-copy-move-or-destructor-function-define-or-delete-them-all )
         IDocQuery3d() = default;
@@ -4,13 +4,27 @@
 
 #pragma once
 
+#include <string>
 #include "TileBaseInfo.h"
 #include "DataTypes.h"
 #include "IDataObj.h"
 #include "IDatabaseTransaction.h"
+#include "AutoCommitPolicy.h"
 
 namespace imgdoc2
 {
+    /// This structure gathers the information describing a tile to be added with IDocWrite2d::AddTiles. The
+    /// arguments have the same meaning as with IDocWrite2d::AddTile.
+    struct TileToAdd
+    {
+        const imgdoc2::ITileCoordinate* coordinate{ nullptr };                  ///< The coordinate.
+        const imgdoc2::LogicalPositionInfo* logical_position_info{ nullptr };   ///< The logical position information.
+        const imgdoc2::TileBaseInfo* tile_base_info{ nullptr };                 ///< Information describing the tile.
+        imgdoc2::DataTypes data_type{ imgdoc2::DataTypes::ZERO };               ///< The datatype.
+        imgdoc2::TileDataStorageType storage_type{ imgdoc2::TileDataStorageType::BlobInDatabase }; ///< Type of the storage.
+        const imgdoc2::IDataObjBase* data{ nullptr };                           ///< The data.
+    };
+
     /// This interface is providing write access to a 2D-document.
     class IDocWrite2d : public imgdoc2::IDatabaseTransaction
     {
@@ -31,6 +45,41 @@ namespace imgdoc2
             imgdoc2::TileDataStorageType storage_type,
             const imgdoc2::IDataObjBase* data) = 0;
 
+        /// Adds a batch of tiles to the document. This is equivalent to calling AddTile for each tile, but it is more
+        /// efficient - the tiles are added within one transaction (if there is no transaction pending already), and the
+        /// database statements are prepared once and then re-used for all tiles. If an error occurs, an exception is
+        /// thrown - if the transaction was initiated by this method, it is rolled back (so that none of the tiles is added).
+        /// \param          tiles       The tiles to be added.
+        /// \param          count       The number of tiles.
+        /// \param [out]    result_pks  If non-null, the primary keys of the newly added tiles are put here (this array must
+        ///                             have room for 'count' elements).
+        virtual void AddTiles(const imgdoc2::TileToAdd* tiles, std::uint32_t count, imgdoc2::dbIndex* result_pks) = 0;
+
+        /// Sets the auto-commit policy - with an auto-commit policy in effect, the tiles added (outside of a transaction started
+        /// with BeginTransaction) are grouped into transactions, which are committed when one of the limits given with the
+        /// policy is reached (c.f. AutoCommitPolicy). Each call to AddTile or AddTiles is guarded by a savepoint, so if a call
+        /// fails, only the tiles of this call are rolled back, and the tiles added before are retained. A pending auto-commit
+        /// transaction can be committed with CommitTransaction (or discarded with RollbackTransaction), it is committed before
+        /// a transaction is started with BeginTransaction, and it is committed when this object is destroyed. Note that while
+        /// an auto-commit transaction is pending, operations of other objects on the same document are part of it.
+        /// Setting the policy commits a pending auto-commit transaction.
+        /// \param  policy  The auto-commit policy.
+        virtual void SetAutoCommitPolicy(const imgdoc2::AutoCommitPolicy& policy) = 0;
+
+        /// Gets the auto-commit policy.
+        /// \returns The auto-commit policy.
+        [[nodiscard]] virtual imgdoc2::AutoCommitPolicy GetAutoCommitPolicy() const = 0;
+
+        /// Sets a "user property", i.e. a key-value pair (of strings) stored with the document (in the "general table"). An
+        /// existing property with the same key is overwritten. The properties can be read with IDocInfo::TryGetUserProperty.
+        /// The property is written within the current transaction - with an auto-commit policy in effect, it is written within
+        /// the auto-commit transaction, and setting a property never causes the auto-commit transaction to be committed. So,
+        /// a property set before adding tiles is committed together with those tiles, which allows to record e.g. the
+        /// progress of an operation in a consistent way.
+        /// \param  key     The key of the property (which must not be empty).
+        /// \param  value   The value.
+        virtual void SetUserProperty(const std::string& key, const std::string& value) = 0;
+
         ~IDocWrite2d() override = default;
     public:
         // no copy and no move (-> https://github.com/isocpp/CppCoreGuidelines/blob/master/CppCoreGuidelines.md#c21-if-you-define-or-delete-any-copy-move-or-destructor-function-define-or-delete-them-all )
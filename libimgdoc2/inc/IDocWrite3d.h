@@ -4,13 +4,27 @@
 
 #pragma once
 
+#include <string>
 #include "BrickBaseInfo.h"
 #include "DataTypes.h"
 #include "IDataObj.h"
 #include "IDatabaseTransaction.h"
+#include "AutoCommitPolicy.h"
 
 namespace imgdoc2
 {
+    /// This structure gathers the information describing a brick to be added with IDocWrite3d::AddBricks. The
+    /// arguments have the same meaning as with IDocWrite3d::AddBrick.
+    struct BrickToAdd
+    {
+        const imgdoc2::ITileCoordinate* coordinate{ nullptr };                      ///< The coordinate.
+        const imgdoc2::LogicalPositionInfo3D* logical_position_info{ nullptr };     ///< The logical position information.
+        const imgdoc2::BrickBaseInfo* brick_base_info{ nullptr };                   ///< Information describing the brick.
+        imgdoc2::DataTypes data_type{ imgdoc2::DataTypes::ZERO };                   ///< The datatype.
+        imgdoc2::TileDataStorageType storage_type{ imgdoc2::TileDataStorageType::BlobInDatabase }; ///< Type of the storage.
+        const imgdoc2::IDataObjBase* data{ nullptr };                               ///< The data.
+    };
+
     /// This interface is providing write access to a 3D-document.
     class IDocWrite3d : public imgdoc2::IDatabaseTransaction
     {
@@ -31,6 +45,60 @@ namespace imgdoc2
             imgdoc2::TileDataStorageType storage_type,
             const imgdoc2::IDataObjBase* data) = 0;
 
+        /// Adds a brick to the document, where the brick is divided into chunks of the specified size, and each chunk is stored as
+        /// a separate blob. This allows for reading sub-volumes of the brick (with IDocQuery3d::ReadBrickSubVolume) without having to
+        /// load the complete brick. The data must be an uncompressed brick (with the layout as for DataTypes::UNCOMPRESSED_BRICK), and
+        /// its size must be an integer multiple of the number of voxels. The data-type of the brick is DataTypes::UNCOMPRESSED_CHUNKED_BRICK.
+        /// \param  coordinate                  The coordinate.
+        /// \param  logical_position_3d_info    The logical position information.
+        /// \param  brick_base_info             Information describing the brick.
+        /// \param  chunk_extent                The size of the chunks.
+        /// \param  storage_type                Type of the storage.
+        /// \param  data                        The data (an uncompressed brick).
+        /// \returns If successful, the primary key of the newly added tile.
+        virtual imgdoc2::dbIndex AddChunkedBrick(
+            const imgdoc2::ITileCoordinate* coordinate,
+            const imgdoc2::LogicalPositionInfo3D* logical_position_3d_info,
+            const imgdoc2::BrickBaseInfo* brick_base_info,
+            const imgdoc2::BrickChunkExtent& chunk_extent,
+            imgdoc2::TileDataStorageType storage_type,
+            const imgdoc2::IDataObjBase* data) = 0;
+
+        /// Adds a batch of bricks to the document. This is equivalent to calling AddBrick for each brick, but it is more
+        /// efficient - the bricks are added within one transaction (if there is no transaction pending already), and the
+        /// database statements are prepared once and then re-used for all bricks. If an error occurs, an exception is
+        /// thrown - if the transaction was initiated by this method, it is rolled back (so that none of the bricks is added).
+        /// \param          bricks      The bricks to be added.
+        /// \param          count       The number of bricks.
+        /// \param [out]    result_pks  If non-null, the primary keys of the newly added bricks are put here (this array must
+        ///                             have room for 'count' elements).
+        virtual void AddBricks(const imgdoc2::BrickToAdd* bricks, std::uint32_t count, imgdoc2::dbIndex* result_pks) = 0;
+
+        /// Sets the auto-commit policy - with an auto-commit policy in effect, the bricks added (outside of a transaction started
+        /// with BeginTransaction) are grouped into transactions, which are committed when one of the limits given with the
+        /// policy is reached (c.f. AutoCommitPolicy). Each call to AddBrick, AddChunkedBrick or AddBricks is guarded by a
+        /// savepoint, so if a call fails, only the bricks of this call are rolled back, and the bricks added before are retained.
+        /// A pending auto-commit transaction can be committed with CommitTransaction (or discarded with RollbackTransaction), it
+        /// is committed before a transaction is started with BeginTransaction, and it is committed when this object is destroyed.
+        /// Note that while an auto-commit transaction is pending, operations of other objects on the same document are part of it.
+        /// Setting the policy commits a pending auto-commit transaction.
+        /// \param  policy  The auto-commit policy.
+        virtual void SetAutoCommitPolicy(const imgdoc2::AutoCommitPolicy& policy) = 0;
+
+        /// Gets the auto-commit policy.
+        /// \returns The auto-commit policy.
+        [[nodiscard]] virtual imgdoc2::AutoCommitPolicy GetAutoCommitPolicy() const = 0;
+
+        /// Sets a "user property", i.e. a key-value pair (of strings) stored with the document (in the "general table"). An
+        /// existing property with the same key is overwritten. The properties can be read with IDocInfo::TryGetUserProperty.
+        /// The property is written within the current transaction - with an auto-commit policy in effect, it is written within
+        /// the auto-commit transaction, and setting a property never causes the auto-commit transaction to be committed. So,
+        /// a property set before adding bricks is committed together with those bricks, which allows to record e.g. the
+        /// progress of an operation in a consistent way.
+        /// \param  key     The key of the property (which must not be empty).
+        /// \param  value   The value.
+        virtual void SetUserProperty(const std::string& key, const std::string& value) = 0;
+
         ~IDocWrite3d() override = default;
     public:
         // no copy and no move (-> https://github.com/isocpp/CppCoreGuidelines/blob/master/CppCoreGuidelines.md#c21-if-you-define-or-delete-any-copy-move-or-destructor-function-define-or-delete-them-all )
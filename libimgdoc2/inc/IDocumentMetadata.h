@@ -11,6 +11,7 @@
 #include <limits>
 #include <optional>
 #include <type_traits>
+#include <vector>
 #include "types.h"
 
 namespace imgdoc2
@@ -138,6 +139,18 @@ namespace imgdoc2
         /// \returns    The item.
         virtual imgdoc2::DocumentMetadataItem GetItemForPath(const std::string& path, imgdoc2::DocumentMetadataItemFlags flags) = 0;
 
+        /// Get the items identified by the specified paths. This gives the same result as calling GetItemForPath for each
+        /// of the paths, but the paths are resolved together (with a small number of database queries), which is much
+        /// faster when a large number of items is to be retrieved. The returned vector has the same number of elements as
+        /// the 'paths' argument, and for a path which does not exist (or which is empty), the respective element is empty.
+        /// If a path is syntactically invalid, an exception of type imgdoc2::invalid_path_exception is thrown.
+        ///
+        /// \param  paths   The paths of the items to be retrieved.
+        /// \param  flags   The flags.
+        ///
+        /// \returns    The items (in the same order as the paths).
+        virtual std::vector<std::optional<imgdoc2::DocumentMetadataItem>> GetItemsForPaths(const std::vector<std::string>& paths, imgdoc2::DocumentMetadataItemFlags flags) = 0;
+
         /// Enumerate items for which the specified node 'parent' is the ancestor. If recursive is false, then only the direct children of the specified parent are enumerated.
         /// If recursive is true, then all descendants of the specified parent are enumerated.
         /// If the specified parent is not valid (nullopt), then all items are enumerated.
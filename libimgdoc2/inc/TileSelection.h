@@ -0,0 +1,31 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <optional>
+#include "types.h"
+#include "IDimCoordinateQueryClause.h"
+#include "ITIleInfoQueryClause.h"
+
+namespace imgdoc2
+{
+    /// This structure specifies a selection of tiles (or bricks) of a document, as used with IDoc::ImportTiles and
+    /// IDoc::CreateSubsetCopy. All criteria which are given are combined with a logical AND, and a criterion which
+    /// is not given (i.e. a null pointer or an empty optional) means "no restriction".
+    struct TileSelection
+    {
+        /// The query clause for the tile-coordinate.
+        const imgdoc2::IDimCoordinateQueryClause* coordinate_clause{ nullptr };
+
+        /// The query clause for the tile-information (i.e. the pyramid-level).
+        const imgdoc2::ITileInfoQueryClause* tileinfo_clause{ nullptr };
+
+        /// If given, only the tiles intersecting with this rectangle are selected. This is only valid for 2D-documents.
+        std::optional<imgdoc2::RectangleD> rectangle;
+
+        /// If given, only the bricks intersecting with this cuboid are selected. This is only valid for 3D-documents.
+        std::optional<imgdoc2::CuboidD> cuboid;
+    };
+}
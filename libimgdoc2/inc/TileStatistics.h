@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace imgdoc2
+{
+    /// Statistics of the pixel values of a tile (or the voxel values of a brick). Those statistics are computed when a tile is added
+    /// to a document which was created with a tile-statistics table (c.f. ICreateOptions::SetCreateTileStatisticsTable). They are
+    /// available for tiles with the data-types ZERO, UNCOMPRESSED_BITMAP, UNCOMPRESSED_BRICK and UNCOMPRESSED_CHUNKED_BRICK and with
+    /// one of the pixel types Gray8, Gray16 or Gray32Float. Values which are not-a-number or infinite are not taken into account.
+    /// The histogram is a coarse sketch of the distribution of the values - it has kHistogramBinCount bins of equal width covering
+    /// the range [minimum, maximum] (where the maximum is included in the last bin).
+    struct TileStatistics
+    {
+        static constexpr int kHistogramBinCount = 16;   ///< The number of bins of the histogram sketch.
+
+        std::uint64_t pixel_count{ 0 };                 ///< The number of pixels (or voxels).
+        double minimum{ 0 };                            ///< The minimum of the values.
+        double maximum{ 0 };                            ///< The maximum of the values.
+        double sum{ 0 };                                ///< The sum of the values.
+        double sum_of_squares{ 0 };                     ///< The sum of the squares of the values.
+        std::array<std::uint64_t, kHistogramBinCount> histogram{};  ///< The histogram sketch, covering the range [minimum, maximum].
+
+        /// Gets the mean of the values.
+        /// \returns The mean of the values (or zero if there are no values).
+        [[nodiscard]] double GetMean() const
+        {
+            return this->pixel_count > 0 ? this->sum / static_cast<double>(this->pixel_count) : 0;
+        }
+
+        /// Gets the (population) standard deviation of the values.
+        /// \returns The standard deviation of the values (or zero if there are no values).
+        [[nodiscard]] double GetStandardDeviation() const
+        {
+            if (this->pixel_count == 0)
+            {
+                return 0;
+            }
+
+            const double mean = this->GetMean();
+            const double variance = this->sum_of_squares / static_cast<double>(this->pixel_count) - mean * mean;
+            return variance > 0 ? std::sqrt(variance) : 0;
+        }
+    };
+
+    /// The per-tile statistics aggregated over a set of tiles (e.g. all tiles within a region of a plane). This is computed from
+    /// the tile-statistics table only, i.e. without reading the tile data. The minimum, maximum, sum and sum of squares (and thus
+    /// the mean and standard deviation) are exact - with respect to the tiles, i.e. pixels in regions where tiles overlap are
+    /// counted once for each tile. The histogram covers the range [minimum, maximum] of the aggregated statistics, and it is
+    /// an approximation derived from the histogram sketches of the tiles (where the count of a bin is distributed
+    /// proportionally to the bins it overlaps with).
+    struct TileStatisticsSummary
+    {
+        std::uint64_t tile_count{ 0 };                          ///< The number of tiles for which statistics are available, and which were aggregated.
+        std::uint64_t tile_count_without_statistics{ 0 };       ///< The number of tiles for which no statistics are available.
+        TileStatistics statistics;                              ///< The aggregated statistics.
+    };
+}
@@ -14,6 +14,8 @@ So - this is the only file which is to be included by a client application.
 #include "types.h"
 #include "IEnvironment.h"
 #include "TileDataStorageType.h"
+#include "AutoCommitPolicy.h"
+#include "TileSelection.h"
 #include "ICreateOptions.h"
 #include "ClassFactory.h"
 #include "IDocRead2d.h"
@@ -321,6 +321,23 @@ namespace imgdoc2
         CuboidD(double x, double y, double z, double w, double h, double d) :CuboidT<double>(x, y, z, w, h, d) {}
     };
 
+    /// Structure defining an axis-aligned cuboid in three dimensions with integers representing the coordinates. This is
+    /// e.g. used for specifying a sub-volume of a brick in units of voxels.
+    struct CuboidI : CuboidT<std::int32_t>
+    {
+        CuboidI() :CuboidT<std::int32_t>() {}
+
+        /// Constructor.
+        /// \exception std::invalid_argument Thrown when an invalid argument error condition occurs.
+        /// \param  x The x-coordinate of the edge point of the cuboid.
+        /// \param  y The y-coordinate of the edge point of the cuboid.
+        /// \param  z The z-coordinate of the edge point of the cuboid.
+        /// \param  w The width of the cuboid (i.e. the extent in x-direction).
+        /// \param  h The height of the cuboid (i.e. the extent in y-direction).
+        /// \param  d The depth of the cuboid (i.e. the extent in z-direction).
+        CuboidI(std::int32_t x, std::int32_t y, std::int32_t z, std::int32_t w, std::int32_t h, std::int32_t d) :CuboidT<std::int32_t>(x, y, z, w, h, d) {}
+    };
+
     /// Structure defining a vector in three dimensions.
     /// \tparam t Generic type parameter.
     template <typename t>
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <IEnvironment.h>
 #include "IDbConnection.h"
@@ -13,4 +14,5 @@ class DbFactory
 public:
     static std::shared_ptr<IDbConnection> SqliteCreateNewDatabase(const char* filename, std::shared_ptr<imgdoc2::IHostingEnvironment> environment = nullptr);
     static std::shared_ptr<IDbConnection> SqliteOpenExistingDatabase(const char* filename, bool readonly, std::shared_ptr<imgdoc2::IHostingEnvironment> environment = nullptr);
+    static std::uint64_t SqliteGetNumberOfStatementsPrepared();
 };
@@ -60,6 +60,18 @@ public:
     virtual void EndTransaction(bool commit) = 0;
     virtual bool IsTransactionPending() const = 0;
 
+    /// Establishes a savepoint with the specified name. A savepoint marks a point within a transaction to which
+    /// the transaction can be rolled back (without rolling back the complete transaction). Savepoints can be nested,
+    /// and they are ended (in reverse order) with EndSavepoint.
+    /// \param  savepoint_name  The name of the savepoint.
+    virtual void BeginSavepoint(const char* savepoint_name) = 0;
+
+    /// Ends the savepoint with the specified name - either by keeping the changes made since the savepoint was
+    /// established, or by rolling them back. In both cases, the savepoint is removed.
+    /// \param  savepoint_name  The name of the savepoint.
+    /// \param  commit          True to keep the changes; false to roll them back.
+    virtual void EndSavepoint(const char* savepoint_name, bool commit) = 0;
+
     /// Gets information about the specified table.
     /// TODO: Note that (in current implementation) this method returns an empty vector in case that the
     /// table does not exists (so an empty table and a non-existing table is indistinguishable).
@@ -75,6 +87,36 @@ public:
     /// \returns    The indices which exist for the specified table.
     virtual std::vector<IDbConnection::IndexInfo> GetIndicesOfTable(const char* table_name) = 0;
 
+    /// Attaches an additional database-file to this connection under the specified schema-name. Tables in the attached
+    /// database can then be addressed as "schema_name.table_name", or simply with their name if the name is unique
+    /// amongst all attached databases. If the file does not exist, it is created if \p create_if_missing is true (and the
+    /// connection is not read-only), otherwise a database_exception is thrown. A relative filename is interpreted relative
+    /// to the location of the main database-file. This operation cannot be executed while a transaction is pending.
+    ///
+    /// \param  filename            The filename (in UTF8) of the database-file to attach.
+    /// \param  schema_name         The schema-name under which the database is attached.
+    /// \param  create_if_missing   If true, a non-existing file is created; if false, a non-existing file is an error.
+    virtual void AttachDatabase(const char* filename, const char* schema_name, bool create_if_missing) = 0;
+
+    /// Detaches the database which has been attached under the specified schema-name (c.f. AttachDatabase). This operation
+    /// cannot be executed while a transaction is pending.
+    ///
+    /// \param  schema_name The schema-name of the database to detach.
+    virtual void DetachDatabase(const char* schema_name) = 0;
+
+    /// Gets the filename of the main database-file.
+    ///
+    /// \returns The filename (in UTF8) of the main database-file; an empty string for an in-memory (or temporary) database.
+    [[nodiscard]] virtual std::string GetMainDatabaseFilename() const = 0;
+
+    /// Gets the "data version" of the main database. This is a number which changes whenever a transaction which modified
+    /// the database has been committed (by this connection, or - noticed when this connection next reads from the
+    /// database - by another connection). Note that the value does not change while a transaction is pending, and it
+    /// is only meaningful when compared to a value previously retrieved from the same connection.
+    ///
+    /// \returns The data version.
+    [[nodiscard]] virtual std::uint32_t GetDataVersion() = 0;
+
     virtual ~IDbConnection() = default;
 
     [[nodiscard]] virtual const std::shared_ptr<imgdoc2::IHostingEnvironment>& GetHostingEnvironment() const = 0;
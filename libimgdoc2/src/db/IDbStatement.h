@@ -18,6 +18,7 @@
 class IDbStatement
 {
 public:
+    /// Resets the statement, so that it can be executed again, and clears all bindings.
     virtual void Reset() = 0;
 
     virtual void BindNull(int index) = 0;
@@ -97,6 +97,16 @@ bool DatabaseConfigurationCommon::TryGetColumnNameOfMetadataTable(int column_ide
     return GetColumnName(this->map_metadatatable_columnids_to_columnname_, column_identifier, column_name);
 }
 
+void DatabaseConfigurationCommon::SetColumnNameForTileStatisticsTable(int column_identifier, const char* column_name)
+{
+    SetColumnName(this->map_tilestatisticstable_columnids_to_columnname_, column_identifier, column_name);
+}
+
+bool DatabaseConfigurationCommon::TryGetColumnNameOfTileStatisticsTable(int column_identifier, std::string* column_name) const
+{
+    return GetColumnName(this->map_tilestatisticstable_columnids_to_columnname_, column_identifier, column_name);
+}
+
 std::string DatabaseConfigurationCommon::GetTableNameForTilesDataOrThrow() const
 {
     return this->GetTableNameOrThrow(TableTypeCommon::TilesData);
@@ -127,6 +137,11 @@ std::string DatabaseConfigurationCommon::GetTableNameForMetadataTableOrThrow() c
     return this->GetTableNameOrThrow(TableTypeCommon::Metadata);
 }
 
+std::string DatabaseConfigurationCommon::GetTableNameForTileStatisticsTableOrThrow() const
+{
+    return this->GetTableNameOrThrow(TableTypeCommon::TileStatistics);
+}
+
 std::string DatabaseConfigurationCommon::GetColumnNameOfGeneralInfoTableOrThrow(int column_identifier) const
 {
     string general_table_name;
@@ -156,6 +171,12 @@ bool DatabaseConfigurationCommon::GetHasMetadataTable() const
     return iterator != this->map_tabletype_to_tablename_.cend();
 }
 
+bool DatabaseConfigurationCommon::GetHasTileStatisticsTable() const
+{
+    const auto iterator = this->map_tabletype_to_tablename_.find(TableTypeCommon::TileStatistics);
+    return iterator != this->map_tabletype_to_tablename_.cend();
+}
+
 bool DatabaseConfigurationCommon::IsDimensionIndexed(imgdoc2::Dimension dimension) const
 {
     return this->indexed_dimensions_.find(dimension) != this->indexed_dimensions_.cend();
@@ -188,6 +209,17 @@ std::string DatabaseConfigurationCommon::GetColumnNameOfMetadataTableOrThrow(int
     return column_name;
 }
 
+std::string DatabaseConfigurationCommon::GetColumnNameOfTileStatisticsTableOrThrow(int column_identifier) const
+{
+    std::string column_name;
+    if (!this->TryGetColumnNameOfTileStatisticsTable(column_identifier, &column_name))
+    {
+        throw std::runtime_error("column-name not present");
+    }
+
+    return column_name;
+}
+
 /*static*/void DatabaseConfigurationCommon::SetColumnName(std::map<int, std::string>& map, int columnIdentifier, const char* column_name)
 {
     if (column_name != nullptr)
@@ -227,6 +259,17 @@ void DatabaseConfigurationCommon::SetDefaultColumnNamesForMetadataTable()
     this->SetColumnNameForMetadataTable(DatabaseConfigurationCommon::kMetadataTable_Column_ValueString, DbConstants::kMetadataTable_Column_ValueString_DefaultName);
 }
 
+void DatabaseConfigurationCommon::SetDefaultColumnNamesForTileStatisticsTable()
+{
+    this->SetColumnNameForTileStatisticsTable(DatabaseConfigurationCommon::kTileStatisticsTable_Column_Pk, DbConstants::kTileStatisticsTable_Column_Pk_DefaultName);
+    this->SetColumnNameForTileStatisticsTable(DatabaseConfigurationCommon::kTileStatisticsTable_Column_PixelCount, DbConstants::kTileStatisticsTable_Column_PixelCount_DefaultName);
+    this->SetColumnNameForTileStatisticsTable(DatabaseConfigurationCommon::kTileStatisticsTable_Column_Minimum, DbConstants::kTileStatisticsTable_Column_Minimum_DefaultName);
+    this->SetColumnNameForTileStatisticsTable(DatabaseConfigurationCommon::kTileStatisticsTable_Column_Maximum, DbConstants::kTileStatisticsTable_Column_Maximum_DefaultName);
+    this->SetColumnNameForTileStatisticsTable(DatabaseConfigurationCommon::kTileStatisticsTable_Column_Sum, DbConstants::kTileStatisticsTable_Column_Sum_DefaultName);
+    this->SetColumnNameForTileStatisticsTable(DatabaseConfigurationCommon::kTileStatisticsTable_Column_SumOfSquares, DbConstants::kTileStatisticsTable_Column_SumOfSquares_DefaultName);
+    this->SetColumnNameForTileStatisticsTable(DatabaseConfigurationCommon::kTileStatisticsTable_Column_Histogram, DbConstants::kTileStatisticsTable_Column_Histogram_DefaultName);
+}
+
 // ----------------------------------------------------------------------------
 
 /*virtual*/ [[nodiscard]] imgdoc2::DocumentType DatabaseConfiguration2D::GetDocumentType() const
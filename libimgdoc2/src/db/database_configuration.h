@@ -31,7 +31,8 @@ public:
         TilesInfo,
         TilesSpatialIndex,
         Metadata,
-        Blobs
+        Blobs,
+        TileStatistics
     };
 
     static constexpr int kGeneralInfoTable_Column_Key = 1;          ///< Identifier for the "key column" in the "general" table.
@@ -47,6 +48,14 @@ public:
     static constexpr int kMetadataTable_Column_ValueDouble = 5;       ///< Identifier for the "value(double) column" in the "metadata" table.
     static constexpr int kMetadataTable_Column_ValueInteger = 6;      ///< Identifier for the "value(integer) column" in the "metadata" table.
     static constexpr int kMetadataTable_Column_ValueString = 7;       ///< Identifier for the "value(string) column" in the "metadata" table.
+
+    static constexpr int kTileStatisticsTable_Column_Pk = 1;            ///< Identifier for the "primary key" column in the "tile-statistics" table (which is the primary key of the row in the "tiles-data" table).
+    static constexpr int kTileStatisticsTable_Column_PixelCount = 2;    ///< Identifier for the "pixel count" column in the "tile-statistics" table.
+    static constexpr int kTileStatisticsTable_Column_Minimum = 3;       ///< Identifier for the "minimum" column in the "tile-statistics" table.
+    static constexpr int kTileStatisticsTable_Column_Maximum = 4;       ///< Identifier for the "maximum" column in the "tile-statistics" table.
+    static constexpr int kTileStatisticsTable_Column_Sum = 5;           ///< Identifier for the "sum" column in the "tile-statistics" table.
+    static constexpr int kTileStatisticsTable_Column_SumOfSquares = 6;  ///< Identifier for the "sum of squares" column in the "tile-statistics" table.
+    static constexpr int kTileStatisticsTable_Column_Histogram = 7;     ///< Identifier for the "histogram" column in the "tile-statistics" table.
 private:
     std::unordered_set<imgdoc2::Dimension> dimensions_;
     std::unordered_set<imgdoc2::Dimension> indexed_dimensions_;
@@ -55,6 +64,7 @@ private:
     std::string index_for_dimension_prefix_;
     std::map<int, std::string> map_blobtable_columnids_to_columnname_;
     std::map<int, std::string> map_metadatatable_columnids_to_columnname_;
+    std::map<int, std::string> map_tilestatisticstable_columnids_to_columnname_;
 public:
     template<typename ForwardIterator>
     void SetTileDimensions(ForwardIterator begin, ForwardIterator end)
@@ -97,10 +107,12 @@ public:
 
     void SetColumnNameForBlobTable(int column_identifier, const char* column_name);
     void SetColumnNameForMetadataTable(int column_identifier, const char* column_name);
+    void SetColumnNameForTileStatisticsTable(int column_identifier, const char* column_name);
 
     bool TryGetColumnNameOfGeneralInfoTable(int columnIdentifier, std::string* column_name) const;
     bool TryGetColumnNameOfBlobTable(int column_identifier, std::string* column_name) const;
     bool TryGetColumnNameOfMetadataTable(int column_identifier, std::string* column_name) const;
+    bool TryGetColumnNameOfTileStatisticsTable(int column_identifier, std::string* column_name) const;
 
     /// Gets document type constant - which document-type is represented by this configuration.
     ///
@@ -116,16 +128,20 @@ public:
     std::string GetTableNameForTilesSpatialIndexTableOrThrow() const;
     std::string GetTableNameForBlobTableOrThrow() const;
     std::string GetTableNameForMetadataTableOrThrow() const;
+    std::string GetTableNameForTileStatisticsTableOrThrow() const;
 
     std::string GetColumnNameOfGeneralInfoTableOrThrow(int column_identifier) const;
     std::string GetColumnNameOfBlobTableOrThrow(int column_identifier) const;
     std::string GetColumnNameOfMetadataTableOrThrow(int column_identifier) const;
+    std::string GetColumnNameOfTileStatisticsTableOrThrow(int column_identifier) const;
 
     void SetDefaultColumnNamesForMetadataTable();
+    void SetDefaultColumnNamesForTileStatisticsTable();
 
     bool GetIsUsingSpatialIndex() const;
     bool GetHasBlobsTable() const;
     bool GetHasMetadataTable() const;
+    bool GetHasTileStatisticsTable() const;
 
 protected:
     static void SetColumnName(std::map<int, std::string>& map, int columnIdentifier, const char* column_name);
@@ -11,12 +11,14 @@ using namespace std;
 
 /*static*/const char* const DbConstants::kGeneralTable_KeyColumnName = "Key";
 /*static*/const char* const DbConstants::kGeneralTable_ValueStringColumnName = "ValueString";
+/*static*/const char* const DbConstants::kGeneralTable_UserPropertyKeyPrefix = "User:";
 
 /*static*/const char* const DbConstants::kTilesInfoTable_DefaultName = "TILESINFO";
 /*static*/const char* const DbConstants::kTilesDataTable_DefaultName = "TILESDATA";
 /*static*/const char* const DbConstants::kTilesSpatialIndexTable_DefaultName = "TILESSPATIALINDEX";
 /*static*/const char* const DbConstants::kBlobTable_DefaultName = "BLOBS";
 /*static*/const char* const DbConstants::kMetadataTable_DefaultName = "METADATA";
+/*static*/const char* const DbConstants::kTileStatisticsTable_DefaultName = "TILESTATISTICS";
 
 /*static*/const char* const DbConstants::kTilesDataTable_Column_Pk_DefaultName = "Pk";
 /*static*/const char* const DbConstants::kTilesDataTable_Column_PixelWidth_DefaultName = "PixelWidth";
@@ -58,6 +60,16 @@ using namespace std;
 /*static*/const char* const DbConstants::kMetadataTable_Column_ValueInteger_DefaultName = "ValueInteger";
 /*static*/const char* const DbConstants::kMetadataTable_Column_ValueString_DefaultName = "ValueString";
 
+/*static*/const char* const DbConstants::kTileStatisticsTable_Column_Pk_DefaultName = "Pk";
+/*static*/const char* const DbConstants::kTileStatisticsTable_Column_PixelCount_DefaultName = "PixelCount";
+/*static*/const char* const DbConstants::kTileStatisticsTable_Column_Minimum_DefaultName = "Minimum";
+/*static*/const char* const DbConstants::kTileStatisticsTable_Column_Maximum_DefaultName = "Maximum";
+/*static*/const char* const DbConstants::kTileStatisticsTable_Column_Sum_DefaultName = "Sum";
+/*static*/const char* const DbConstants::kTileStatisticsTable_Column_SumOfSquares_DefaultName = "SumOfSquares";
+/*static*/const char* const DbConstants::kTileStatisticsTable_Column_Histogram_DefaultName = "Histogram";
+
+/*static*/const char* const DbConstants::kBlobDatabase_SchemaName = "BLOBDB";
+
 /*static*/const char* const DbConstants::kDimensionColumnPrefix_Default = "Dim_";
 /*static*/const char* const DbConstants::kIndexForDimensionColumnPrefix_Default = "IndexForDim_";
 
@@ -79,6 +91,10 @@ using namespace std;
             return "SpatialIndexTable";
         case GeneralTableItems::kMetadataTable:
             return "MetadataTable";
+        case GeneralTableItems::kBlobDatabase:
+            return "BlobDatabase";
+        case GeneralTableItems::kTileStatisticsTable:
+            return "TileStatisticsTable";
     }
 
     throw std::invalid_argument("invalid argument for 'item' specified.");
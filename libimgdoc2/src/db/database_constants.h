@@ -13,7 +13,9 @@ enum class GeneralTableItems
     kDocType,           ///< An enum constant representing the document type.
     kBlobTable,         ///< An enum constant representing "Name of the 'BLOB'-table".
     kSpatialIndexTable, ///< An enum constant representing the "Name of the 'Spatial-Index'-table".
-    kMetadataTable      ///< An enum constant representing the "Name of the 'Metadata'-table".
+    kMetadataTable,     ///< An enum constant representing the "Name of the 'Metadata'-table".
+    kBlobDatabase,      ///< An enum constant representing the "Filename of the separate database-file containing the 'BLOB'-table".
+    kTileStatisticsTable ///< An enum constant representing the "Name of the 'TileStatistics'-table".
 };
 
 /// Here we gather constants for the imgdoc2-database design. "Constant" means that this should be the
@@ -30,11 +32,16 @@ public:
     /// The name of the column with the values for the property-bag in the General table ("ValueString").
     static const char* const kGeneralTable_ValueStringColumnName; // = "ValueString"
 
+    /// The prefix for the keys of "user properties" in the General table ("User:") - this prefix separates the items set by
+    /// the application from the "well known items" used by imgdoc2 itself.
+    static const char* const kGeneralTable_UserPropertyKeyPrefix; // = "User:"
+
     static const char* const kTilesInfoTable_DefaultName;         // = "TILESINFO"
     static const char* const kTilesDataTable_DefaultName;         // = "TILESDATA"
     static const char* const kTilesSpatialIndexTable_DefaultName; // = "TILESSPATIALINDEX"
     static const char* const kBlobTable_DefaultName;              // = "BLOBS"
     static const char* const kMetadataTable_DefaultName;          // = "METADATA"
+    static const char* const kTileStatisticsTable_DefaultName;    // = "TILESTATISTICS"
 
     static const char* const kTilesDataTable_Column_Pk_DefaultName;
     static const char* const kTilesDataTable_Column_PixelWidth_DefaultName;
@@ -76,6 +83,17 @@ public:
     static const char* const kMetadataTable_Column_ValueInteger_DefaultName;
     static const char* const kMetadataTable_Column_ValueString_DefaultName;
 
+    static const char* const kTileStatisticsTable_Column_Pk_DefaultName;
+    static const char* const kTileStatisticsTable_Column_PixelCount_DefaultName;
+    static const char* const kTileStatisticsTable_Column_Minimum_DefaultName;
+    static const char* const kTileStatisticsTable_Column_Maximum_DefaultName;
+    static const char* const kTileStatisticsTable_Column_Sum_DefaultName;
+    static const char* const kTileStatisticsTable_Column_SumOfSquares_DefaultName;
+    static const char* const kTileStatisticsTable_Column_Histogram_DefaultName;
+
+    /// The schema-name under which a separate database-file containing the BLOB-table is attached ("BLOBDB").
+    static const char* const kBlobDatabase_SchemaName;
+
     static const char* const kDimensionColumnPrefix_Default;  // = "Dim_"
     static const char* const kIndexForDimensionColumnPrefix_Default; // = "IndexForDim_"
 
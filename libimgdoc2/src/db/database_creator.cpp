@@ -52,11 +52,19 @@ std::shared_ptr<DatabaseConfiguration2D> DbCreator::CreateTables2d(const imgdoc2
 
     if (create_options->GetCreateBlobTable())
     {
-        sql_statement = GenerateSqlStatementForCreatingBlobTable_Sqlite(database_configuration.get());
+        const char* blob_table_schema_name = this->AttachBlobDatabaseIfRequested(database_configuration.get(), create_options);
+        sql_statement = GenerateSqlStatementForCreatingBlobTable_Sqlite(database_configuration.get(), blob_table_schema_name);
         this->db_connection_->Execute(sql_statement);
         this->SetBlobTableNameInGeneralTable(database_configuration.get());
     }
 
+    if (create_options->GetCreateTileStatisticsTable())
+    {
+        sql_statement = this->GenerateSqlStatementForCreatingTileStatisticsTable_Sqlite(database_configuration.get());
+        this->db_connection_->Execute(sql_statement);
+        this->SetTileStatisticsTableNameInGeneralTable(database_configuration.get());
+    }
+
     return database_configuration;
 }
 
@@ -95,11 +103,19 @@ std::shared_ptr<DatabaseConfiguration3D> DbCreator::CreateTables3d(const imgdoc2
 
     if (create_options->GetCreateBlobTable())
     {
-        sql_statement = GenerateSqlStatementForCreatingBlobTable_Sqlite(database_configuration.get());
+        const char* blob_table_schema_name = this->AttachBlobDatabaseIfRequested(database_configuration.get(), create_options);
+        sql_statement = GenerateSqlStatementForCreatingBlobTable_Sqlite(database_configuration.get(), blob_table_schema_name);
         this->db_connection_->Execute(sql_statement);
         this->SetBlobTableNameInGeneralTable(database_configuration.get());
     }
 
+    if (create_options->GetCreateTileStatisticsTable())
+    {
+        sql_statement = this->GenerateSqlStatementForCreatingTileStatisticsTable_Sqlite(database_configuration.get());
+        this->db_connection_->Execute(sql_statement);
+        this->SetTileStatisticsTableNameInGeneralTable(database_configuration.get());
+    }
+
     return database_configuration;
 }
 
@@ -276,6 +292,12 @@ void DbCreator::Initialize2dConfigurationFromCreateOptions(DatabaseConfiguration
         database_configuration->SetColumnNameForBlobTable(DatabaseConfiguration2D::kBlobTable_Column_Pk, DbConstants::kBlobTable_Column_Pk_DefaultName);
         database_configuration->SetColumnNameForBlobTable(DatabaseConfiguration2D::kBlobTable_Column_Data, DbConstants::kBlobTable_Column_Data_DefaultName);
     }
+
+    if (create_options->GetCreateTileStatisticsTable())
+    {
+        database_configuration->SetTableName(DatabaseConfigurationCommon::TableTypeCommon::TileStatistics, DbConstants::kTileStatisticsTable_DefaultName);
+        database_configuration->SetDefaultColumnNamesForTileStatisticsTable();
+    }
 }
 
 void DbCreator::Initialize3dConfigurationFromCreateOptions(DatabaseConfiguration3D* database_configuration, const imgdoc2::ICreateOptions* create_options)
@@ -311,6 +333,12 @@ void DbCreator::Initialize3dConfigurationFromCreateOptions(DatabaseConfiguration
         database_configuration->SetColumnNameForBlobTable(DatabaseConfiguration2D::kBlobTable_Column_Pk, DbConstants::kBlobTable_Column_Pk_DefaultName);
         database_configuration->SetColumnNameForBlobTable(DatabaseConfiguration2D::kBlobTable_Column_Data, DbConstants::kBlobTable_Column_Data_DefaultName);
     }
+
+    if (create_options->GetCreateTileStatisticsTable())
+    {
+        database_configuration->SetTableName(DatabaseConfigurationCommon::TableTypeCommon::TileStatistics, DbConstants::kTileStatisticsTable_DefaultName);
+        database_configuration->SetDefaultColumnNamesForTileStatisticsTable();
+    }
 }
 
 std::string DbCreator::GenerateSqlStatementForCreatingSpatialTilesIndex_Sqlite(const DatabaseConfiguration2D* database_configuration)
@@ -343,24 +371,36 @@ std::string DbCreator::GenerateSqlStatementForCreatingSpatialTilesIndex_Sqlite(c
     return string_stream.str();
 }
 
-std::string DbCreator::GenerateSqlStatementForCreatingBlobTable_Sqlite(const DatabaseConfiguration2D* database_configuration)
+std::string DbCreator::GenerateSqlStatementForCreatingBlobTable_Sqlite(const DatabaseConfiguration2D* database_configuration, const char* schema_name)
 {
     Expects(database_configuration != nullptr && database_configuration->GetHasBlobsTable() == true);
 
     ostringstream string_stream;
-    string_stream << "CREATE TABLE [" << database_configuration->GetTableNameForBlobTableOrThrow() << "] (" <<
+    string_stream << "CREATE TABLE ";
+    if (schema_name != nullptr)
+    {
+        string_stream << "[" << schema_name << "].";
+    }
+
+    string_stream << "[" << database_configuration->GetTableNameForBlobTableOrThrow() << "] (" <<
         "[" << database_configuration->GetColumnNameOfBlobTableOrThrow(DatabaseConfiguration2D::kBlobTable_Column_Pk) << "] INTEGER PRIMARY KEY," <<
         "[" << database_configuration->GetColumnNameOfBlobTableOrThrow(DatabaseConfiguration2D::kBlobTable_Column_Data) << "] BLOB );";
 
     return string_stream.str();
 }
 
-std::string DbCreator::GenerateSqlStatementForCreatingBlobTable_Sqlite(const DatabaseConfiguration3D* database_configuration)
+std::string DbCreator::GenerateSqlStatementForCreatingBlobTable_Sqlite(const DatabaseConfiguration3D* database_configuration, const char* schema_name)
 {
     Expects(database_configuration != nullptr && database_configuration->GetHasBlobsTable() == true);
 
     ostringstream string_stream;
-    string_stream << "CREATE TABLE [" << database_configuration->GetTableNameForBlobTableOrThrow() << "] (" <<
+    string_stream << "CREATE TABLE ";
+    if (schema_name != nullptr)
+    {
+        string_stream << "[" << schema_name << "].";
+    }
+
+    string_stream << "[" << database_configuration->GetTableNameForBlobTableOrThrow() << "] (" <<
         "[" << database_configuration->GetColumnNameOfBlobTableOrThrow(DatabaseConfiguration3D::kBlobTable_Column_Pk) << "] INTEGER PRIMARY KEY," <<
         "[" << database_configuration->GetColumnNameOfBlobTableOrThrow(DatabaseConfiguration3D::kBlobTable_Column_Data) << "] BLOB );";
 
@@ -377,6 +417,59 @@ void DbCreator::SetBlobTableNameInGeneralTable(const DatabaseConfigurationCommon
     this->db_connection_->Execute(string_stream.str());
 }
 
+std::string DbCreator::GenerateSqlStatementForCreatingTileStatisticsTable_Sqlite(const DatabaseConfigurationCommon* database_configuration_common)
+{
+    Expects(database_configuration_common != nullptr && database_configuration_common->GetHasTileStatisticsTable() == true);
+
+    // the primary key of this table is the primary key of the corresponding row in the TILESDATA-table
+    ostringstream string_stream;
+    string_stream << "CREATE TABLE [" << database_configuration_common->GetTableNameForTileStatisticsTableOrThrow() << "] (" <<
+        "[" << database_configuration_common->GetColumnNameOfTileStatisticsTableOrThrow(DatabaseConfigurationCommon::kTileStatisticsTable_Column_Pk) << "] INTEGER PRIMARY KEY," <<
+        "[" << database_configuration_common->GetColumnNameOfTileStatisticsTableOrThrow(DatabaseConfigurationCommon::kTileStatisticsTable_Column_PixelCount) << "] INTEGER NOT NULL," <<
+        "[" << database_configuration_common->GetColumnNameOfTileStatisticsTableOrThrow(DatabaseConfigurationCommon::kTileStatisticsTable_Column_Minimum) << "] REAL NOT NULL," <<
+        "[" << database_configuration_common->GetColumnNameOfTileStatisticsTableOrThrow(DatabaseConfigurationCommon::kTileStatisticsTable_Column_Maximum) << "] REAL NOT NULL," <<
+        "[" << database_configuration_common->GetColumnNameOfTileStatisticsTableOrThrow(DatabaseConfigurationCommon::kTileStatisticsTable_Column_Sum) << "] REAL NOT NULL," <<
+        "[" << database_configuration_common->GetColumnNameOfTileStatisticsTableOrThrow(DatabaseConfigurationCommon::kTileStatisticsTable_Column_SumOfSquares) << "] REAL NOT NULL," <<
+        "[" << database_configuration_common->GetColumnNameOfTileStatisticsTableOrThrow(DatabaseConfigurationCommon::kTileStatisticsTable_Column_Histogram) << "] BLOB );";
+
+    return string_stream.str();
+}
+
+void DbCreator::SetTileStatisticsTableNameInGeneralTable(const DatabaseConfigurationCommon* database_configuration_common)
+{
+    Utilities::WriteStringIntoPropertyBag(
+        this->db_connection_.get(),
+        database_configuration_common->GetTableNameForGeneralTableOrThrow(),
+        database_configuration_common->GetColumnNameOfGeneralInfoTableOrThrow(DatabaseConfigurationCommon::kGeneralInfoTable_Column_Key),
+        database_configuration_common->GetColumnNameOfGeneralInfoTableOrThrow(DatabaseConfigurationCommon::kGeneralInfoTable_Column_ValueString),
+        DbConstants::GetGeneralTable_ItemKey(GeneralTableItems::kTileStatisticsTable),
+        database_configuration_common->GetTableNameForTileStatisticsTableOrThrow());
+}
+
+const char* DbCreator::AttachBlobDatabaseIfRequested(const DatabaseConfigurationCommon* database_configuration_common, const imgdoc2::ICreateOptions* create_options)
+{
+    const auto& blob_database_filename = create_options->GetBlobDatabaseFilename();
+    if (blob_database_filename.empty())
+    {
+        return nullptr;
+    }
+
+    this->db_connection_->AttachDatabase(blob_database_filename.c_str(), DbConstants::kBlobDatabase_SchemaName, true);
+
+    // We store the filename (as it was given to us) in the "General"-table, so that the discovery can attach the
+    //  file when opening the document. Note that all queries are using the unqualified table name, which works
+    //  because SQLite searches all attached databases for a table name (as long as it is unique).
+    Utilities::WriteStringIntoPropertyBag(
+        this->db_connection_.get(),
+        database_configuration_common->GetTableNameForGeneralTableOrThrow(),
+        database_configuration_common->GetColumnNameOfGeneralInfoTableOrThrow(DatabaseConfigurationCommon::kGeneralInfoTable_Column_Key),
+        database_configuration_common->GetColumnNameOfGeneralInfoTableOrThrow(DatabaseConfigurationCommon::kGeneralInfoTable_Column_ValueString),
+        DbConstants::GetGeneralTable_ItemKey(GeneralTableItems::kBlobDatabase),
+        blob_database_filename);
+
+    return DbConstants::kBlobDatabase_SchemaName;
+}
+
 /*static*/void DbCreator::ThrowIfDocumentTypeIsNotAsSpecified(const imgdoc2::ICreateOptions* create_options, imgdoc2::DocumentType document_type)
 {
     if (create_options->GetDocumentType() != document_type)
@@ -29,12 +29,12 @@ private:
     std::string GenerateSqlStatementForCreatingTilesDataTable_Sqlite(const DatabaseConfiguration2D* database_configuration);
     std::string GenerateSqlStatementForCreatingTilesInfoTable_Sqlite(const DatabaseConfiguration2D* database_configuration);
     std::string GenerateSqlStatementForCreatingSpatialTilesIndex_Sqlite(const DatabaseConfiguration2D* database_configuration);
-    std::string GenerateSqlStatementForCreatingBlobTable_Sqlite(const DatabaseConfiguration2D* database_configuration);
+    std::string GenerateSqlStatementForCreatingBlobTable_Sqlite(const DatabaseConfiguration2D* database_configuration, const char* schema_name);
 
     std::string GenerateSqlStatementForCreatingTilesDataTable_Sqlite(const DatabaseConfiguration3D* database_configuration);
     std::string GenerateSqlStatementForCreatingTilesInfoTable_Sqlite(const DatabaseConfiguration3D* database_configuration);
     std::string GenerateSqlStatementForCreatingSpatialTilesIndex_Sqlite(const DatabaseConfiguration3D* database_configuration);
-    std::string GenerateSqlStatementForCreatingBlobTable_Sqlite(const DatabaseConfiguration3D* database_configuration);
+    std::string GenerateSqlStatementForCreatingBlobTable_Sqlite(const DatabaseConfiguration3D* database_configuration, const char* schema_name);
 
     /// Generates the SQL statement for creating metadata table (for SQLite).
     /// \param  database_configuration_common   The database configuration.
@@ -43,6 +43,20 @@ private:
 
     void SetBlobTableNameInGeneralTable(const DatabaseConfigurationCommon* database_configuration_common);
 
+    /// Generates the SQL statement for creating the tile-statistics table (for SQLite).
+    /// \param  database_configuration_common   The database configuration.
+    /// \returns    The SQL statement for creating the tile-statistics table.
+    std::string GenerateSqlStatementForCreatingTileStatisticsTable_Sqlite(const DatabaseConfigurationCommon* database_configuration_common);
+
+    void SetTileStatisticsTableNameInGeneralTable(const DatabaseConfigurationCommon* database_configuration_common);
+
+    /// If the create-options request a separate database-file for the BLOB table, then this file is attached here and its filename
+    /// is recorded in the "General"-table.
+    /// \param  database_configuration_common   The database configuration.
+    /// \param  create_options                  The create-options.
+    /// \returns The schema-name under which the separate database-file was attached (where the BLOB table is to be created); or null if no separate file is requested.
+    const char* AttachBlobDatabaseIfRequested(const DatabaseConfigurationCommon* database_configuration_common, const imgdoc2::ICreateOptions* create_options);
+
     void SetGeneralTableInfoForSpatialIndex(const DatabaseConfigurationCommon* database_configuration_common);
 
     static void ThrowIfDocumentTypeIsNotAsSpecified(const imgdoc2::ICreateOptions* create_options, imgdoc2::DocumentType document_type);
@@ -22,6 +22,9 @@ void DbDiscovery::DoDiscovery()
     // first step - find the "GENERAL" table and see if we can make sense of it
     GeneralDataDiscoveryResult general_table_discovery_result = this->DiscoverGeneralTable();
 
+    // if the blob-table is located in a separate file, we need to attach it before we can check the tables
+    this->AttachBlobDatabaseIfPresent(general_table_discovery_result);
+
     // now, check whether those tables exist and are usable
     this->Check_Tables_And_Determine_Dimensions(general_table_discovery_result);
 
@@ -109,6 +112,11 @@ void DbDiscovery::FillInformationForConfiguration2D(const GeneralDataDiscoveryRe
     if (!general_data_discovery_result.spatial_index_table_name.empty())
     {
         database_configuration_2d.SetTableName(DatabaseConfigurationCommon::TableTypeCommon::TilesSpatialIndex, general_data_discovery_result.spatial_index_table_name.c_str());
+        database_configuration_2d.SetColumnNameForTilesSpatialIndexTable(DatabaseConfiguration2D::kTilesSpatialIndexTable_Column_Pk, DbConstants::kSqliteSpatialIndexTable_Column_Pk_DefaultName/*"id"*/);
+        database_configuration_2d.SetColumnNameForTilesSpatialIndexTable(DatabaseConfiguration2D::kTilesSpatialIndexTable_Column_MinX, DbConstants::kSqliteSpatialIndexTable_Column_minX_DefaultName /*"minX"*/);
+        database_configuration_2d.SetColumnNameForTilesSpatialIndexTable(DatabaseConfiguration2D::kTilesSpatialIndexTable_Column_MaxX, DbConstants::kSqliteSpatialIndexTable_Column_maxX_DefaultName /*"maxX"*/);
+        database_configuration_2d.SetColumnNameForTilesSpatialIndexTable(DatabaseConfiguration2D::kTilesSpatialIndexTable_Column_MinY, DbConstants::kSqliteSpatialIndexTable_Column_minY_DefaultName /*"minY"*/);
+        database_configuration_2d.SetColumnNameForTilesSpatialIndexTable(DatabaseConfiguration2D::kTilesSpatialIndexTable_Column_MaxY, DbConstants::kSqliteSpatialIndexTable_Column_maxY_DefaultName /*"maxY"*/);
     }
 
     if (!general_data_discovery_result.blobtable_name.empty())
@@ -117,6 +125,19 @@ void DbDiscovery::FillInformationForConfiguration2D(const GeneralDataDiscoveryRe
         database_configuration_2d.SetColumnNameForBlobTable(DatabaseConfiguration2D::kBlobTable_Column_Pk, DbConstants::kBlobTable_Column_Pk_DefaultName); // TODO(JBL): I guess the presence of those columns should be tested for
         database_configuration_2d.SetColumnNameForBlobTable(DatabaseConfiguration2D::kBlobTable_Column_Data, DbConstants::kBlobTable_Column_Data_DefaultName);
     }
+
+    if (!general_data_discovery_result.tile_statistics_table_name.empty())
+    {
+        database_configuration_2d.SetTableName(DatabaseConfigurationCommon::TableTypeCommon::TileStatistics, general_data_discovery_result.tile_statistics_table_name.c_str());
+        database_configuration_2d.SetDefaultColumnNamesForTileStatisticsTable();
+    }
+
+    if (!general_data_discovery_result.metadatatable_name.empty())
+    {
+        database_configuration_2d.SetTableName(DatabaseConfigurationCommon::TableTypeCommon::Metadata, general_data_discovery_result.metadatatable_name.c_str());
+        database_configuration_2d.SetDefaultColumnNamesForMetadataTable();
+        database_configuration_2d.SetDefaultColumnNamesForTileStatisticsTable();
+    }
 }
 
 void DbDiscovery::FillInformationForConfiguration3D(const GeneralDataDiscoveryResult& general_data_discovery_result, DatabaseConfiguration3D& configuration_3d)
@@ -133,6 +154,13 @@ void DbDiscovery::FillInformationForConfiguration3D(const GeneralDataDiscoveryRe
     if (!general_data_discovery_result.spatial_index_table_name.empty())
     {
         configuration_3d.SetTableName(DatabaseConfigurationCommon::TableTypeCommon::TilesSpatialIndex, general_data_discovery_result.spatial_index_table_name.c_str());
+        configuration_3d.SetColumnNameForTilesSpatialIndexTable(DatabaseConfiguration3D::kTilesSpatialIndexTable_Column_Pk, DbConstants::kSqliteSpatialIndexTable_Column_Pk_DefaultName/*"id"*/);
+        configuration_3d.SetColumnNameForTilesSpatialIndexTable(DatabaseConfiguration3D::kTilesSpatialIndexTable_Column_MinX, DbConstants::kSqliteSpatialIndexTable_Column_minX_DefaultName /*"minX"*/);
+        configuration_3d.SetColumnNameForTilesSpatialIndexTable(DatabaseConfiguration3D::kTilesSpatialIndexTable_Column_MaxX, DbConstants::kSqliteSpatialIndexTable_Column_maxX_DefaultName /*"maxX"*/);
+        configuration_3d.SetColumnNameForTilesSpatialIndexTable(DatabaseConfiguration3D::kTilesSpatialIndexTable_Column_MinY, DbConstants::kSqliteSpatialIndexTable_Column_minY_DefaultName /*"minY"*/);
+        configuration_3d.SetColumnNameForTilesSpatialIndexTable(DatabaseConfiguration3D::kTilesSpatialIndexTable_Column_MaxY, DbConstants::kSqliteSpatialIndexTable_Column_maxY_DefaultName /*"maxY"*/);
+        configuration_3d.SetColumnNameForTilesSpatialIndexTable(DatabaseConfiguration3D::kTilesSpatialIndexTable_Column_MinZ, DbConstants::kSqliteSpatialIndexTable_Column_minZ_DefaultName /*"minZ"*/);
+        configuration_3d.SetColumnNameForTilesSpatialIndexTable(DatabaseConfiguration3D::kTilesSpatialIndexTable_Column_MaxZ, DbConstants::kSqliteSpatialIndexTable_Column_maxZ_DefaultName /*"maxZ"*/);
     }
     if (!general_data_discovery_result.blobtable_name.empty())
     {
@@ -140,6 +168,19 @@ void DbDiscovery::FillInformationForConfiguration3D(const GeneralDataDiscoveryRe
         configuration_3d.SetColumnNameForBlobTable(DatabaseConfiguration3D::kBlobTable_Column_Pk, DbConstants::kBlobTable_Column_Pk_DefaultName); // TODO(JBL): I guess the presence of those columns should be tested for
         configuration_3d.SetColumnNameForBlobTable(DatabaseConfiguration3D::kBlobTable_Column_Data, DbConstants::kBlobTable_Column_Data_DefaultName);
     }
+
+    if (!general_data_discovery_result.tile_statistics_table_name.empty())
+    {
+        configuration_3d.SetTableName(DatabaseConfigurationCommon::TableTypeCommon::TileStatistics, general_data_discovery_result.tile_statistics_table_name.c_str());
+        configuration_3d.SetDefaultColumnNamesForTileStatisticsTable();
+    }
+
+    if (!general_data_discovery_result.metadatatable_name.empty())
+    {
+        configuration_3d.SetTableName(DatabaseConfigurationCommon::TableTypeCommon::Metadata, general_data_discovery_result.metadatatable_name.c_str());
+        configuration_3d.SetDefaultColumnNamesForMetadataTable();
+        configuration_3d.SetDefaultColumnNamesForTileStatisticsTable();
+    }
 }
 
 DbDiscovery::GeneralDataDiscoveryResult DbDiscovery::DiscoverGeneralTable()
@@ -246,9 +287,59 @@ DbDiscovery::GeneralDataDiscoveryResult DbDiscovery::DiscoverGeneralTable()
         general_discovery_result.metadatatable_name = str;
     }
 
+    if (Utilities::TryReadStringFromPropertyBag(
+        this->db_connection_.get(),
+        DbConstants::kGeneralTable_Name,
+        DbConstants::kGeneralTable_KeyColumnName,
+        DbConstants::kGeneralTable_ValueStringColumnName,
+        DbConstants::GetGeneralTable_ItemKey(GeneralTableItems::kBlobDatabase), //"BlobDatabase",
+        &str))
+    {
+        general_discovery_result.blob_database_filename = str;
+    }
+
+    if (Utilities::TryReadStringFromPropertyBag(
+        this->db_connection_.get(),
+        DbConstants::kGeneralTable_Name,
+        DbConstants::kGeneralTable_KeyColumnName,
+        DbConstants::kGeneralTable_ValueStringColumnName,
+        DbConstants::GetGeneralTable_ItemKey(GeneralTableItems::kTileStatisticsTable), //"TileStatisticsTable",
+        &str))
+    {
+        general_discovery_result.tile_statistics_table_name = str;
+    }
+
     return general_discovery_result;
 }
 
+void DbDiscovery::AttachBlobDatabaseIfPresent(const GeneralDataDiscoveryResult& general_table_discovery_result)
+{
+    if (general_table_discovery_result.blob_database_filename.empty())
+    {
+        return;
+    }
+
+    try
+    {
+        this->db_connection_->AttachDatabase(general_table_discovery_result.blob_database_filename.c_str(), DbConstants::kBlobDatabase_SchemaName, false);
+    }
+    catch (database_exception& exception)
+    {
+        ostringstream string_stream;
+        string_stream << "Could not attach the blob-database '" << general_table_discovery_result.blob_database_filename << "' (" << (exception.GetIsSqliteErrorCodeValid() ? exception.GetSqliteErrorMessage() : exception.what()) << ").";
+        throw discovery_exception(string_stream.str());
+    }
+
+    // we require that the blob-table can be found (in the attached file) - otherwise, we refuse to open the document
+    if (!general_table_discovery_result.blobtable_name.empty() &&
+        this->db_connection_->GetTableInfo(general_table_discovery_result.blobtable_name.c_str()).empty())
+    {
+        ostringstream string_stream;
+        string_stream << "The blob-table '" << general_table_discovery_result.blobtable_name << "' was not found in the blob-database '" << general_table_discovery_result.blob_database_filename << "'.";
+        throw discovery_exception(string_stream.str());
+    }
+}
+
 void DbDiscovery::Check_Tables_And_Determine_Dimensions(GeneralDataDiscoveryResult& general_table_discovery_result)
 {
     // check the tiles-data table for the expected columns
@@ -399,4 +490,39 @@ void DbDiscovery::Check_Tables_And_Determine_Dimensions(GeneralDataDiscoveryResu
             general_table_discovery_result.spatial_index_table_name.clear();
         }
     }
+
+    // the tile-statistics table is optional - if it is not present or not usable, we just proceed without it
+    if (!general_table_discovery_result.tile_statistics_table_name.empty())
+    {
+        const auto columns_of_tile_statistics_table = this->db_connection_->GetTableInfo(general_table_discovery_result.tile_statistics_table_name.c_str());
+        expected_columns_for_table = vector<ExpectedColumnsInfo>
+        {
+            ExpectedColumnsInfo(DbConstants::kTileStatisticsTable_Column_Pk_DefaultName),
+            ExpectedColumnsInfo(DbConstants::kTileStatisticsTable_Column_PixelCount_DefaultName),
+            ExpectedColumnsInfo(DbConstants::kTileStatisticsTable_Column_Minimum_DefaultName),
+            ExpectedColumnsInfo(DbConstants::kTileStatisticsTable_Column_Maximum_DefaultName),
+            ExpectedColumnsInfo(DbConstants::kTileStatisticsTable_Column_Sum_DefaultName),
+            ExpectedColumnsInfo(DbConstants::kTileStatisticsTable_Column_SumOfSquares_DefaultName),
+            ExpectedColumnsInfo(DbConstants::kTileStatisticsTable_Column_Histogram_DefaultName)
+        };
+
+        const bool tile_statistics_table_ok = all_of(
+            expected_columns_for_table.cbegin(),
+            expected_columns_for_table.cend(),
+            [&](const ExpectedColumnsInfo& expected_column_info)->bool
+            {
+                return any_of(
+                    columns_of_tile_statistics_table.cbegin(),
+                    columns_of_tile_statistics_table.cend(),
+                    [&](const IDbConnection::ColumnInfo& column_info)->bool
+                    {
+                        return column_info.column_name == expected_column_info.column_name;
+                    });
+            });
+
+        if (!tile_statistics_table_ok)
+        {
+            general_table_discovery_result.tile_statistics_table_name.clear();
+        }
+    }
 }
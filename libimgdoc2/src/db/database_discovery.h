@@ -28,6 +28,12 @@ private:
         std::string spatial_index_table_name;
         std::string metadatatable_name;
 
+        /// If non-empty, the name of the tile-statistics table (which is optional).
+        std::string tile_statistics_table_name;
+
+        /// If non-empty, the BLOB table resides in a separate database-file (which needs to be attached).
+        std::string blob_database_filename;
+
         imgdoc2::DocumentType document_type { imgdoc2::DocumentType::kInvalid };
         std::vector<imgdoc2::Dimension> dimensions;
         std::vector<imgdoc2::Dimension> indexed_dimensions;
@@ -86,6 +92,10 @@ private:
     /// \param [in,out] general_table_discovery_result  On input, it is expected that the table-names are filled, on exit the other fields are populated and validated.
     void Check_Tables_And_Determine_Dimensions(GeneralDataDiscoveryResult& general_table_discovery_result);
 
+    /// If the "General"-table specifies a separate database-file for the BLOB table, then this file is attached here.
+    /// \param  general_table_discovery_result  The result of the discovery of the "General"-table.
+    void AttachBlobDatabaseIfPresent(const GeneralDataDiscoveryResult& general_table_discovery_result);
+
     void FillInformationForConfiguration2D(const GeneralDataDiscoveryResult& general_data_discovery_result, DatabaseConfiguration2D& configuration_2d);
     void FillInformationForConfiguration3D(const GeneralDataDiscoveryResult& general_data_discovery_result, DatabaseConfiguration3D& configuration_3d);
 
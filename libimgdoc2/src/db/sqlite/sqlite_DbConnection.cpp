@@ -8,6 +8,8 @@
 #include <vector>
 #include <string>
 #include <utility>
+#include <cstring>
+#include <filesystem>
 #include "sqlite_DbConnection.h"
 #include "sqlite_DbStatement.h"
 #include "custom_functions.h"
@@ -16,6 +18,8 @@
 using namespace std;
 using namespace imgdoc2;
 
+/*static*/std::atomic_uint64_t SqliteDbConnection::number_of_statements_prepared_{ 0 };
+
 /*static*/std::shared_ptr<IDbConnection> SqliteDbConnection::SqliteCreateNewDatabase(const char* filename, std::shared_ptr<imgdoc2::IHostingEnvironment> environment)
 {
     sqlite3* database = nullptr;
@@ -142,9 +146,15 @@ SqliteDbConnection::SqliteDbConnection(sqlite3* database, std::shared_ptr<imgdoc
         throw database_exception("Error from 'sqlite3_prepare_v2'", return_value);
     }
 
+    SqliteDbConnection::number_of_statements_prepared_.fetch_add(1, memory_order_relaxed);
     return make_shared<SqliteDbStatement>(statement);
 }
 
+/*static*/std::uint64_t SqliteDbConnection::GetNumberOfStatementsPrepared()
+{
+    return SqliteDbConnection::number_of_statements_prepared_.load(memory_order_relaxed);
+}
+
 /*virtual*/bool SqliteDbConnection::StepStatement(IDbStatement* statement)
 {
     // try to cast "statement" to ISqliteStatement
@@ -198,6 +208,27 @@ SqliteDbConnection::SqliteDbConnection(sqlite3* database, std::shared_ptr<imgdoc
     return this->transaction_count_ > 0;
 }
 
+/*virtual*/void SqliteDbConnection::BeginSavepoint(const char* savepoint_name)
+{
+    // https://www.sqlite.org/lang_savepoint.html
+    ostringstream string_stream;
+    string_stream << "SAVEPOINT [" << savepoint_name << "];";
+    this->Execute(string_stream.str().c_str());
+}
+
+/*virtual*/void SqliteDbConnection::EndSavepoint(const char* savepoint_name, bool commit)
+{
+    // note that "ROLLBACK TO" does not remove the savepoint from the transaction stack, so it is released afterwards
+    ostringstream string_stream;
+    if (!commit)
+    {
+        string_stream << "ROLLBACK TO [" << savepoint_name << "];";
+    }
+
+    string_stream << "RELEASE [" << savepoint_name << "];";
+    this->Execute(string_stream.str().c_str());
+}
+
 /*virtual*/std::vector<IDbConnection::ColumnInfo> SqliteDbConnection::GetTableInfo(const char* table_name)
 {
     ostringstream string_stream;
@@ -232,6 +263,82 @@ SqliteDbConnection::SqliteDbConnection(sqlite3* database, std::shared_ptr<imgdoc
     return result;
 }
 
+/*virtual*/void SqliteDbConnection::AttachDatabase(const char* filename, const char* schema_name, bool create_if_missing)
+{
+    const string resolved_filename = this->ResolveFilenameRelativeToMainDatabase(filename);
+
+    // SQLite would silently create a missing file (for a writable connection) - so, if this is not desired, we have to check
+    //  for the file's existence ourselves (URIs and special names are excluded from this check)
+    if (!create_if_missing &&
+        strncmp(resolved_filename.c_str(), "file:", 5) != 0 &&
+        resolved_filename[0] != ':' &&
+        !filesystem::exists(filesystem::u8path(resolved_filename)))
+    {
+        ostringstream string_stream;
+        string_stream << "The database-file '" << resolved_filename << "' does not exist.";
+        throw database_exception(string_stream.str().c_str());
+    }
+
+    // https://www.sqlite.org/lang_attach.html -> the filename is an expression, so we can pass it in as a parameter
+    ostringstream string_stream;
+    string_stream << "ATTACH DATABASE ?1 AS [" << schema_name << "];";
+    const auto statement = this->PrepareStatement(string_stream.str());
+    statement->BindString(1, resolved_filename);
+    this->Execute(statement.get());
+}
+
+/*virtual*/void SqliteDbConnection::DetachDatabase(const char* schema_name)
+{
+    ostringstream string_stream;
+    string_stream << "DETACH DATABASE [" << schema_name << "];";
+    this->Execute(string_stream.str().c_str());
+}
+
+/*virtual*/std::string SqliteDbConnection::GetMainDatabaseFilename() const
+{
+    // https://www.sqlite.org/c3ref/db_filename.html -> for an in-memory or temporary database, we get an empty string (or null)
+    const char* main_database_filename = sqlite3_db_filename(this->database_, "main");
+    return main_database_filename != nullptr ? string(main_database_filename) : string();
+}
+
+/*virtual*/std::uint32_t SqliteDbConnection::GetDataVersion()
+{
+    // https://www.sqlite.org/c3ref/c_fcntl_begin_atomic_write.html#sqlitefcntldataversion -> this is a cheap call (no statement
+    //  is executed), which is why it is used in favor of "PRAGMA data_version"
+    unsigned int data_version = 0;
+    const int return_value = sqlite3_file_control(this->database_, "main", SQLITE_FCNTL_DATA_VERSION, &data_version);
+    if (return_value != SQLITE_OK)
+    {
+        throw database_exception("Error from 'sqlite3_file_control'", return_value);
+    }
+
+    return data_version;
+}
+
+std::string SqliteDbConnection::ResolveFilenameRelativeToMainDatabase(const char* filename) const
+{
+    // URIs (and special names like ":memory:") are passed on to SQLite unaltered
+    if (strncmp(filename, "file:", 5) == 0 || filename[0] == ':')
+    {
+        return filename;
+    }
+
+    const filesystem::path path = filesystem::u8path(filename);
+    if (path.is_absolute())
+    {
+        return filename;
+    }
+
+    // https://www.sqlite.org/c3ref/db_filename.html -> for an in-memory or temporary database, we get an empty string (or null)
+    const char* main_database_filename = sqlite3_db_filename(this->database_, "main");
+    if (main_database_filename == nullptr || *main_database_filename == '\0')
+    {
+        return filename;
+    }
+
+    return (filesystem::u8path(main_database_filename).parent_path() / path).u8string();
+}
+
 /*virtual*/const std::shared_ptr<imgdoc2::IHostingEnvironment>& SqliteDbConnection::GetHostingEnvironment() const
 {
     return this->environment_;
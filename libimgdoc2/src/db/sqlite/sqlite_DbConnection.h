@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <vector>
 #include <string>
@@ -18,6 +19,8 @@ private:
     std::shared_ptr<imgdoc2::IHostingEnvironment> environment_;
     sqlite3* database_;
     int transaction_count_;
+
+    static std::atomic_uint64_t number_of_statements_prepared_;  ///< The number of statements prepared (by all connections).
 public:
     explicit SqliteDbConnection(sqlite3* database, std::shared_ptr<imgdoc2::IHostingEnvironment> environment = nullptr);
     SqliteDbConnection() = delete;
@@ -40,15 +43,32 @@ public:
     void BeginTransaction() override;
     void EndTransaction(bool commit) override;
     bool IsTransactionPending() const override;
+    void BeginSavepoint(const char* savepoint_name) override;
+    void EndSavepoint(const char* savepoint_name, bool commit) override;
 
     std::vector<IDbConnection::ColumnInfo> GetTableInfo(const char* table_name) override;
     std::vector<IDbConnection::IndexInfo> GetIndicesOfTable(const char* table_name) override;
 
+    void AttachDatabase(const char* filename, const char* schema_name, bool create_if_missing) override;
+    void DetachDatabase(const char* schema_name) override;
+    [[nodiscard]] std::string GetMainDatabaseFilename() const override;
+    [[nodiscard]] std::uint32_t GetDataVersion() override;
+
     [[nodiscard]] const std::shared_ptr<imgdoc2::IHostingEnvironment>& GetHostingEnvironment() const override;
 
+    /// Gets the number of statements prepared so far by all connections.
+    /// \returns The number of statements prepared.
+    static std::uint64_t GetNumberOfStatementsPrepared();
+
     ~SqliteDbConnection() override;
 
 private:
+    /// If the specified filename is a relative path, then it is made relative to the directory of the main database-file. If the
+    /// main database has no file (e.g. an in-memory database), or if the filename is a URI, then it is returned unaltered.
+    /// \param  filename    The filename (in UTF8).
+    /// \returns The resolved filename (in UTF8).
+    std::string ResolveFilenameRelativeToMainDatabase(const char* filename) const;
+
     void LogSqlExecution(const char* function_name, sqlite3_stmt* pStmt, int return_value) const;
     void LogSqlExecution(const char* function_name, const char* sql_statement, int return_value) const;
 };
@@ -23,3 +23,8 @@ using namespace std;
         readonly, 
         environment ? environment : imgdoc2::ClassFactory::CreateNullHostingEnvironment());
 }
+
+/*static*/std::uint64_t DbFactory::SqliteGetNumberOfStatementsPrepared()
+{
+    return SqliteDbConnection::GetNumberOfStatementsPrepared();
+}
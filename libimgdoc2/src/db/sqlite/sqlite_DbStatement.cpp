@@ -22,7 +22,10 @@ SqliteDbStatement::SqliteDbStatement(sqlite3_stmt* sql_statement)  :
 
 /*virtual*/void SqliteDbStatement::Reset()
 {
-    throw std::logic_error("not implemented");
+    // Note: the return value of sqlite3_reset is reflecting the result of the most recent sqlite3_step-call (which
+    //  has already been reported), so we do not evaluate it here (-> https://www.sqlite.org/c3ref/reset.html).
+    sqlite3_reset(this->sql_statement_);
+    sqlite3_clear_bindings(this->sql_statement_);
 }
 
 /*virtual*/void SqliteDbStatement::BindNull(int index)
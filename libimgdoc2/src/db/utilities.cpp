@@ -152,8 +152,9 @@ using namespace imgdoc2;
 /*static*/bool Utilities::TryReadStringFromPropertyBag(IDbConnection* db_connection, const std::string& table_name, const std::string& key_column_name, const std::string& value_column_name, const std::string& key, std::string* output)
 {
     ostringstream string_stream;
-    string_stream << "SELECT [" << value_column_name << "] FROM [" << table_name << "] WHERE [" << key_column_name << "]='" << key << "';";
+    string_stream << "SELECT [" << value_column_name << "] FROM [" << table_name << "] WHERE [" << key_column_name << "]=?;";
     const auto statement = db_connection->PrepareStatement(string_stream.str());
+    statement->BindString(1, key);
     if (db_connection->StepStatement(statement.get()))
     {
         if (output != nullptr)
@@ -0,0 +1,238 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <utility>
+#include <AutoCommitPolicy.h>
+#include <IDataObj.h>
+#include "../db/IDbConnection.h"
+#include "transactionHelper.h"
+
+/// This class is implementing the "auto-commit policy" for a writer object (c.f. imgdoc2::AutoCommitPolicy). If the policy
+/// is enabled, write operations (which are not part of a transaction started by the user) are executed within an
+/// "auto-commit transaction", which is started with the first write operation and committed as soon as one of the limits
+/// of the policy is reached. Each write operation is guarded by a savepoint - so, if a write operation fails, only the
+/// changes of this operation are rolled back, and the operations executed before (within the same auto-commit transaction)
+/// are retained (and will be committed later).
+/// If the policy is not enabled, or if a transaction started by the user is pending, the write operation is executed with
+/// the TransactionHelper (i.e. in a transaction of its own, or as part of the user's transaction).
+class AutoCommitTransaction
+{
+private:
+    static constexpr const char* kSavepointName = "imgdoc2_auto_commit";
+
+    std::shared_ptr<IDbConnection> database_connection_;
+    imgdoc2::AutoCommitPolicy policy_;
+    bool transaction_pending_{ false };     ///< Whether an auto-commit transaction (i.e. a transaction initiated by this object) is pending.
+    std::uint32_t items_in_transaction_{ 0 };
+    std::uint64_t bytes_in_transaction_{ 0 };
+    std::chrono::steady_clock::time_point transaction_start_;
+public:
+    explicit AutoCommitTransaction(std::shared_ptr<IDbConnection> database_connection) :
+        database_connection_(std::move(database_connection))
+    {}
+
+    AutoCommitTransaction(const AutoCommitTransaction&) = delete;
+    AutoCommitTransaction& operator=(const AutoCommitTransaction&) = delete;
+
+    /// Destructor - a pending auto-commit transaction is committed.
+    ~AutoCommitTransaction()
+    {
+        // the destructor must not throw, so if committing the pending auto-commit transaction fails, we can only log it
+        try
+        {
+            this->Commit();
+        }
+        catch (std::exception& exception)
+        {
+            const auto& hosting_environment = this->database_connection_->GetHostingEnvironment();
+            if (hosting_environment)
+            {
+                std::ostringstream string_stream;
+                string_stream << "Committing the pending auto-commit transaction failed: " << exception.what();
+                hosting_environment->Log(imgdoc2::LogLevel::Error, string_stream.str().c_str());
+            }
+        }
+    }
+
+    /// Sets the auto-commit policy. A pending auto-commit transaction is committed before.
+    /// \param  policy  The auto-commit policy.
+    void SetPolicy(const imgdoc2::AutoCommitPolicy& policy)
+    {
+        this->Commit();
+        this->policy_ = policy;
+    }
+
+    /// Gets the auto-commit policy.
+    /// \returns The auto-commit policy.
+    [[nodiscard]] const imgdoc2::AutoCommitPolicy& GetPolicy() const
+    {
+        return this->policy_;
+    }
+
+    /// Query if an auto-commit transaction is pending.
+    /// \returns True if an auto-commit transaction is pending; false otherwise.
+    [[nodiscard]] bool IsPending() const
+    {
+        return this->transaction_pending_;
+    }
+
+    /// Executes the specified write operation - either within the auto-commit transaction (which is started if necessary, and
+    /// committed afterwards if one of the limits is reached), or (if the policy is not enabled or if there is a transaction
+    /// pending which was not initiated by this object) with the TransactionHelper.
+    ///
+    /// \tparam t_return_value  Type of the return value.
+    /// \param  action  The write operation.
+    /// \param  items   The number of items (tiles or bricks) added by the write operation.
+    /// \param  bytes   The number of bytes (of tile or brick data) added by the write operation.
+    ///
+    /// \returns    The return value of the action.
+    template <typename t_return_value>
+    t_return_value Execute(std::function<t_return_value()> action, std::uint32_t items, std::uint64_t bytes)
+    {
+        if (!this->policy_.IsEnabled() ||
+            (!this->transaction_pending_ && this->database_connection_->IsTransactionPending()))
+        {
+            TransactionHelper<t_return_value> transaction{ this->database_connection_, std::move(action) };
+            return transaction.Execute();
+        }
+
+        if (!this->transaction_pending_)
+        {
+            this->database_connection_->BeginTransaction();
+            this->transaction_pending_ = true;
+            this->items_in_transaction_ = 0;
+            this->bytes_in_transaction_ = 0;
+            this->transaction_start_ = std::chrono::steady_clock::now();
+        }
+
+        this->database_connection_->BeginSavepoint(AutoCommitTransaction::kSavepointName);
+        t_return_value return_value;
+        try
+        {
+            return_value = action();
+            this->database_connection_->EndSavepoint(AutoCommitTransaction::kSavepointName, true);
+        }
+        catch (...)
+        {
+            this->RollbackToSavepoint();
+            throw;
+        }
+
+        // an operation which is not adding any items (e.g. setting a property) never triggers a commit - so it is committed
+        //  together with the items added next
+        this->items_in_transaction_ += items;
+        this->bytes_in_transaction_ += bytes;
+        if ((items > 0 || bytes > 0) && this->IsLimitReached())
+        {
+            this->Commit();
+        }
+
+        return return_value;
+    }
+
+    /// Gets the size of the data of the specified data object (which is what is accounted for with the "max_bytes" limit).
+    /// \param  data    The data object (which may be null).
+    /// \returns The size of the data in bytes; zero if the data object is null.
+    static std::uint64_t GetDataSize(const imgdoc2::IDataObjBase* data)
+    {
+        if (data == nullptr)
+        {
+            return 0;
+        }
+
+        const void* ptr_data = nullptr;
+        size_t size_data = 0;
+        data->GetData(&ptr_data, &size_data);
+        return size_data;
+    }
+
+    /// Commits the pending auto-commit transaction (if there is one).
+    void Commit()
+    {
+        if (this->transaction_pending_)
+        {
+            this->database_connection_->EndTransaction(true);
+            this->transaction_pending_ = false;
+        }
+    }
+
+    /// Rolls back the pending auto-commit transaction (if there is one).
+    void Rollback()
+    {
+        if (this->transaction_pending_)
+        {
+            this->database_connection_->EndTransaction(false);
+            this->transaction_pending_ = false;
+        }
+    }
+
+    /// Begins a transaction on behalf of the user of the writer object (c.f. imgdoc2::IDatabaseTransaction::BeginTransaction).
+    /// A pending auto-commit transaction is committed before the user's transaction is started.
+    void BeginTransaction()
+    {
+        this->Commit();
+        this->database_connection_->BeginTransaction();
+    }
+
+    /// Ends a transaction on behalf of the user of the writer object (c.f. imgdoc2::IDatabaseTransaction::CommitTransaction and
+    /// imgdoc2::IDatabaseTransaction::RollbackTransaction). If an auto-commit transaction is pending, then this one is ended,
+    /// otherwise the transaction started by the user.
+    /// \param  commit  True to commit the transaction; false to roll it back.
+    void EndTransaction(bool commit)
+    {
+        if (this->transaction_pending_)
+        {
+            if (commit)
+            {
+                this->Commit();
+            }
+            else
+            {
+                this->Rollback();
+            }
+
+            return;
+        }
+
+        this->database_connection_->EndTransaction(commit);
+    }
+
+private:
+    [[nodiscard]] bool IsLimitReached() const
+    {
+        return (this->policy_.max_items > 0 && this->items_in_transaction_ >= this->policy_.max_items) ||
+            (this->policy_.max_bytes > 0 && this->bytes_in_transaction_ >= this->policy_.max_bytes) ||
+            (this->policy_.max_duration_milliseconds > 0 &&
+                std::chrono::steady_clock::now() - this->transaction_start_ >= std::chrono::milliseconds(this->policy_.max_duration_milliseconds));
+    }
+
+    void RollbackToSavepoint()
+    {
+        try
+        {
+            this->database_connection_->EndSavepoint(AutoCommitTransaction::kSavepointName, false);
+        }
+        catch (...)
+        {
+            // if rolling back to the savepoint fails (which is the case if the database has rolled back the transaction
+            //  itself, which SQLite does for some errors), we give up on the auto-commit transaction
+            this->transaction_pending_ = false;
+            try
+            {
+                this->database_connection_->EndTransaction(false);
+            }
+            catch (...)
+            {
+            }
+        }
+    }
+};
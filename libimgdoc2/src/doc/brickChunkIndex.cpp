@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: 2023 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <sstream>
+#include "brickChunkIndex.h"
+
+using namespace std;
+using namespace imgdoc2;
+
+namespace
+{
+    void WriteUint32(uint8_t* destination, uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            destination[i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+    void WriteInt64(uint8_t* destination, int64_t value)
+    {
+        const uint64_t value_unsigned = static_cast<uint64_t>(value);
+        for (int i = 0; i < 8; ++i)
+        {
+            destination[i] = static_cast<uint8_t>(value_unsigned >> (8 * i));
+        }
+    }
+
+    uint32_t ReadUint32(const uint8_t* source)
+    {
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            value |= static_cast<uint32_t>(source[i]) << (8 * i);
+        }
+
+        return value;
+    }
+
+    int64_t ReadInt64(const uint8_t* source)
+    {
+        uint64_t value = 0;
+        for (int i = 0; i < 8; ++i)
+        {
+            value |= static_cast<uint64_t>(source[i]) << (8 * i);
+        }
+
+        return static_cast<int64_t>(value);
+    }
+}
+
+imgdoc2::CuboidI BrickChunkIndex::GetChunkCuboid(std::uint32_t chunk_x, std::uint32_t chunk_y, std::uint32_t chunk_z) const
+{
+    const uint32_t x = chunk_x * this->chunk_extent.width;
+    const uint32_t y = chunk_y * this->chunk_extent.height;
+    const uint32_t z = chunk_z * this->chunk_extent.depth;
+    return CuboidI{
+        static_cast<int32_t>(x),
+        static_cast<int32_t>(y),
+        static_cast<int32_t>(z),
+        static_cast<int32_t>(min(this->chunk_extent.width, this->brick_width - x)),
+        static_cast<int32_t>(min(this->chunk_extent.height, this->brick_height - y)),
+        static_cast<int32_t>(min(this->chunk_extent.depth, this->brick_depth - z)) };
+}
+
+std::vector<std::uint8_t> BrickChunkIndex::Serialize() const
+{
+    vector<uint8_t> data(kHeaderSize + this->chunk_blob_keys.size() * sizeof(int64_t));
+    WriteUint32(data.data(), kVersion);
+    WriteUint32(data.data() + 4, this->bytes_per_voxel);
+    WriteUint32(data.data() + 8, this->brick_width);
+    WriteUint32(data.data() + 12, this->brick_height);
+    WriteUint32(data.data() + 16, this->brick_depth);
+    WriteUint32(data.data() + 20, this->chunk_extent.width);
+    WriteUint32(data.data() + 24, this->chunk_extent.height);
+    WriteUint32(data.data() + 28, this->chunk_extent.depth);
+    for (size_t i = 0; i < this->chunk_blob_keys.size(); ++i)
+    {
+        WriteInt64(data.data() + kHeaderSize + i * sizeof(int64_t), this->chunk_blob_keys[i]);
+    }
+
+    return data;
+}
+
+/*static*/BrickChunkIndex BrickChunkIndex::Parse(const void* data, size_t size)
+{
+    const uint8_t* source = static_cast<const uint8_t*>(data);
+    if (source == nullptr || size < kHeaderSize)
+    {
+        throw invalid_operation_exception("The chunk index of the brick is invalid (it is too small).");
+    }
+
+    const uint32_t version = ReadUint32(source);
+    if (version != kVersion)
+    {
+        ostringstream string_stream;
+        string_stream << "The chunk index of the brick has an unsupported version (" << version << ").";
+        throw invalid_operation_exception(string_stream.str().c_str());
+    }
+
+    BrickChunkIndex chunk_index;
+    chunk_index.bytes_per_voxel = ReadUint32(source + 4);
+    chunk_index.brick_width = ReadUint32(source + 8);
+    chunk_index.brick_height = ReadUint32(source + 12);
+    chunk_index.brick_depth = ReadUint32(source + 16);
+    chunk_index.chunk_extent.width = ReadUint32(source + 20);
+    chunk_index.chunk_extent.height = ReadUint32(source + 24);
+    chunk_index.chunk_extent.depth = ReadUint32(source + 28);
+    if (chunk_index.bytes_per_voxel == 0 || chunk_index.chunk_extent.width == 0 || chunk_index.chunk_extent.height == 0 || chunk_index.chunk_extent.depth == 0)
+    {
+        throw invalid_operation_exception("The chunk index of the brick is invalid (bytes per voxel or the chunk extent is zero).");
+    }
+
+    // the header is not trusted - the number of chunks is compared against the number of keys which fit into the data, and
+    //  this is done step by step, so that the product of the chunk counts cannot overflow
+    const uint64_t max_chunk_count = (size - kHeaderSize) / sizeof(int64_t);
+    const uint64_t chunk_count_xy = static_cast<uint64_t>(chunk_index.GetChunkCountX()) * chunk_index.GetChunkCountY();
+    if (chunk_count_xy > max_chunk_count || (chunk_count_xy > 0 && chunk_index.GetChunkCountZ() > max_chunk_count / chunk_count_xy))
+    {
+        throw invalid_operation_exception("The chunk index of the brick is invalid (the list of chunks is incomplete).");
+    }
+
+    const size_t chunk_count = static_cast<size_t>(chunk_count_xy * chunk_index.GetChunkCountZ());
+    chunk_index.chunk_blob_keys.reserve(chunk_count);
+    for (size_t i = 0; i < chunk_count; ++i)
+    {
+        chunk_index.chunk_blob_keys.push_back(ReadInt64(source + kHeaderSize + i * sizeof(int64_t)));
+    }
+
+    return chunk_index;
+}
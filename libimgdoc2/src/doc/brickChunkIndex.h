@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: 2023 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <imgdoc2.h>
+
+/// This class represents the "chunk index" of a chunked brick (i.e. a brick with data-type DataTypes::UNCOMPRESSED_CHUNKED_BRICK).
+/// A chunked brick is divided into chunks of a fixed size (where the chunks at the right, top and back border may be smaller), and
+/// each chunk is stored as an uncompressed brick in a separate blob. The chunk index is stored as the blob of the brick itself, and
+/// it gives the layout of the chunks and the primary key of the blob of each chunk. The chunks are enumerated in the same order as
+/// the voxels of an uncompressed brick, i.e. x is running fastest, then y, then z.
+///
+/// The binary representation is as follows (all values are little-endian):
+/// | offset | type           | description                                                     |
+/// |--------|----------------|-----------------------------------------------------------------|
+/// | 0      | uint32         | version (currently 1)                                           |
+/// | 4      | uint32         | bytes per voxel                                                 |
+/// | 8      | uint32[3]      | width, height and depth of the brick                            |
+/// | 20     | uint32[3]      | width, height and depth of a chunk                              |
+/// | 32     | int64[n]       | primary keys of the chunk-blobs, where n is the number of chunks |
+class BrickChunkIndex
+{
+public:
+    static constexpr std::uint32_t kVersion = 1;   ///< The version of the binary representation.
+    static constexpr size_t kHeaderSize = 32;      ///< The size of the header (in bytes), i.e. the offset of the list of primary keys.
+
+    std::uint32_t bytes_per_voxel{ 0 };             ///< The number of bytes per voxel.
+    std::uint32_t brick_width{ 0 };                 ///< The width of the brick (in units of voxels).
+    std::uint32_t brick_height{ 0 };                ///< The height of the brick (in units of voxels).
+    std::uint32_t brick_depth{ 0 };                 ///< The depth of the brick (in units of voxels).
+    imgdoc2::BrickChunkExtent chunk_extent;         ///< The extent of a chunk (in units of voxels).
+    std::vector<imgdoc2::dbIndex> chunk_blob_keys;  ///< The primary keys of the blobs of the chunks.
+
+    /// Gets the number of chunks in x-direction.
+    /// \returns The number of chunks in x-direction.
+    [[nodiscard]] std::uint32_t GetChunkCountX() const { return BrickChunkIndex::DivideRoundingUp(this->brick_width, this->chunk_extent.width); }
+
+    /// Gets the number of chunks in y-direction.
+    /// \returns The number of chunks in y-direction.
+    [[nodiscard]] std::uint32_t GetChunkCountY() const { return BrickChunkIndex::DivideRoundingUp(this->brick_height, this->chunk_extent.height); }
+
+    /// Gets the number of chunks in z-direction.
+    /// \returns The number of chunks in z-direction.
+    [[nodiscard]] std::uint32_t GetChunkCountZ() const { return BrickChunkIndex::DivideRoundingUp(this->brick_depth, this->chunk_extent.depth); }
+
+    /// Gets the total number of chunks. Note that the product may overflow for an (invalid) chunk index with huge dimensions - a
+    /// chunk index returned by Parse has been checked to be consistent with the size of its data.
+    /// \returns The total number of chunks.
+    [[nodiscard]] size_t GetChunkCount() const { return static_cast<size_t>(this->GetChunkCountX()) * this->GetChunkCountY() * this->GetChunkCountZ(); }
+
+    /// Gets the cuboid (in units of voxels, relative to the brick) which is covered by the specified chunk.
+    /// \param  chunk_x The index of the chunk in x-direction.
+    /// \param  chunk_y The index of the chunk in y-direction.
+    /// \param  chunk_z The index of the chunk in z-direction.
+    /// \returns The cuboid covered by the chunk.
+    [[nodiscard]] imgdoc2::CuboidI GetChunkCuboid(std::uint32_t chunk_x, std::uint32_t chunk_y, std::uint32_t chunk_z) const;
+
+    /// Gets the index of the specified chunk in the list of chunks (i.e. in 'chunk_blob_keys').
+    /// \param  chunk_x The index of the chunk in x-direction.
+    /// \param  chunk_y The index of the chunk in y-direction.
+    /// \param  chunk_z The index of the chunk in z-direction.
+    /// \returns The index of the chunk.
+    [[nodiscard]] size_t GetChunkListIndex(std::uint32_t chunk_x, std::uint32_t chunk_y, std::uint32_t chunk_z) const
+    {
+        return (static_cast<size_t>(chunk_z) * this->GetChunkCountY() + chunk_y) * this->GetChunkCountX() + chunk_x;
+    }
+
+    /// Gets the binary representation of the chunk index.
+    /// \returns The binary representation.
+    [[nodiscard]] std::vector<std::uint8_t> Serialize() const;
+
+    /// Parses the binary representation of a chunk index. If the data is invalid, an exception of type
+    /// "imgdoc2::invalid_operation_exception" is thrown.
+    /// \param  data The binary representation.
+    /// \param  size The size of the binary representation (in bytes).
+    /// \returns The chunk index.
+    static BrickChunkIndex Parse(const void* data, size_t size);
+private:
+    /// Divides the extent of the brick by the extent of a chunk, rounding up - this is done without an intermediate sum, so
+    /// that it cannot overflow.
+    static std::uint32_t DivideRoundingUp(std::uint32_t extent, std::uint32_t chunk_extent)
+    {
+        return extent > 0 ? (extent - 1) / chunk_extent + 1 : 0;
+    }
+};
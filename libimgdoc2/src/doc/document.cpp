@@ -8,9 +8,13 @@
 #include "documentWrite2d.h"
 #include "documentRead3d.h"
 #include "documentWrite3d.h"
+#include "documentCompaction.h"
+#include "documentImport.h"
 
 #include "documentMetadataReader.h"
 #include "documentMetadataWriter.h"
+#include "../db/database_constants.h"
+#include "../db/utilities.h"
 
 using namespace std;
 using namespace imgdoc2;
@@ -64,3 +68,54 @@ using namespace imgdoc2;
 {
     return make_shared<DocumentMetadataReader>(shared_from_this());
 }
+
+/*virtual*/void Document::CreateCompactedCopy(const char* destination_filename)
+{
+    DocumentCompaction compaction(shared_from_this());
+    compaction.CreateCompactedCopy(destination_filename);
+}
+
+/*virtual*/void Document::ImportTiles(const char* source_filename, const imgdoc2::TileSelection* selection)
+{
+    DocumentImport document_import(shared_from_this());
+    document_import.ImportTiles(source_filename, selection);
+}
+
+/*virtual*/void Document::CreateSubsetCopy(const char* destination_filename, const imgdoc2::TileSelection* selection)
+{
+    DocumentImport::CreateSubsetCopy(shared_from_this(), destination_filename, selection);
+}
+
+void Document::WriteUserProperty(const std::string& key, const std::string& value) const
+{
+    if (key.empty())
+    {
+        throw invalid_argument_exception("The key of a user property must not be empty.");
+    }
+
+    const auto database_configuration_common = this->GetDataBaseConfigurationCommon();
+    Utilities::WriteStringIntoPropertyBag(
+        this->database_connection_.get(),
+        database_configuration_common->GetTableNameForGeneralTableOrThrow(),
+        database_configuration_common->GetColumnNameOfGeneralInfoTableOrThrow(DatabaseConfigurationCommon::kGeneralInfoTable_Column_Key),
+        database_configuration_common->GetColumnNameOfGeneralInfoTableOrThrow(DatabaseConfigurationCommon::kGeneralInfoTable_Column_ValueString),
+        DbConstants::kGeneralTable_UserPropertyKeyPrefix + key,
+        value);
+}
+
+bool Document::TryReadUserProperty(const std::string& key, std::string* value) const
+{
+    if (key.empty())
+    {
+        return false;
+    }
+
+    const auto database_configuration_common = this->GetDataBaseConfigurationCommon();
+    return Utilities::TryReadStringFromPropertyBag(
+        this->database_connection_.get(),
+        database_configuration_common->GetTableNameForGeneralTableOrThrow(),
+        database_configuration_common->GetColumnNameOfGeneralInfoTableOrThrow(DatabaseConfigurationCommon::kGeneralInfoTable_Column_Key),
+        database_configuration_common->GetColumnNameOfGeneralInfoTableOrThrow(DatabaseConfigurationCommon::kGeneralInfoTable_Column_ValueString),
+        DbConstants::kGeneralTable_UserPropertyKeyPrefix + key,
+        value);
+}
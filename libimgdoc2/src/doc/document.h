@@ -6,9 +6,11 @@
 
 #include <utility>
 #include <memory>
+#include <string>
 #include <imgdoc2.h>
 #include "../db/IDbConnection.h"
 #include "../db/database_configuration.h"
+#include "documentMetadataPathCache.h"
 
 class Document : public imgdoc2::IDoc, public std::enable_shared_from_this<Document>
 {
@@ -16,6 +18,7 @@ private:
     std::shared_ptr<IDbConnection> database_connection_;
     std::shared_ptr<DatabaseConfiguration2D> database_configuration_2d_;    ///< The database configuration for a "tiles-2d-document". Note that this member is only valid if the document is a "tiles-2d-document", and it is mutually exclusive to 'database_configuration_3d_'.
     std::shared_ptr<DatabaseConfiguration3D> database_configuration_3d_;    ///< The database configuration for a "bricks-3d-document". Note that this member is only valid if the document is a "bricks-3d-document", and it is mutually exclusive to 'database_configuration_2d_'.
+    DocumentMetadataPathCache metadata_path_cache_;                         ///< The cache for resolving metadata-paths (which is shared by all metadata-readers and -writers of this document).
 public:
     Document(std::shared_ptr<IDbConnection> database_connection, std::shared_ptr<DatabaseConfiguration2D> database_configuration) :
         database_connection_(std::move(database_connection)),
@@ -50,6 +53,10 @@ public:
     std::shared_ptr<imgdoc2::IDocumentMetadataWrite> GetDocumentMetadataWriter() override;
     std::shared_ptr<imgdoc2::IDocumentMetadataRead> GetDocumentMetadataReader() override;
 
+    void CreateCompactedCopy(const char* destination_filename) override;
+    void ImportTiles(const char* source_filename, const imgdoc2::TileSelection* selection) override;
+    void CreateSubsetCopy(const char* destination_filename, const imgdoc2::TileSelection* selection) override;
+
     ~Document() override = default;
 public:
     [[nodiscard]] const std::shared_ptr<IDbConnection>& GetDatabase_connection() const { return this->database_connection_; }
@@ -69,6 +76,22 @@ public:
         return nullptr;
     }
 
+    /// Writes the specified "user property" into the 'GENERAL'-table (where it is stored with the key prefixed
+    /// with DbConstants::kGeneralTable_UserPropertyKeyPrefix). Note that this method does not deal with transactions.
+    /// \param  key     The key of the property (which must not be empty).
+    /// \param  value   The value.
+    void WriteUserProperty(const std::string& key, const std::string& value) const;
+
+    /// Attempts to read the specified "user property" from the 'GENERAL'-table.
+    /// \param          key     The key of the property.
+    /// \param [out]    value   If non-null and successful, the value is put here.
+    /// \returns True if the property exists; false otherwise.
+    bool TryReadUserProperty(const std::string& key, std::string* value) const;
+
+    /// Gets the cache which is used for resolving metadata-paths (to the primary keys of the nodes on the path).
+    /// \returns The metadata-path-cache.
+    [[nodiscard]] DocumentMetadataPathCache& GetMetadataPathCache() { return this->metadata_path_cache_; }
+
     [[nodiscard]] const std::shared_ptr<imgdoc2::IHostingEnvironment>& GetHostingEnvironment() const { return this->database_connection_->GetHostingEnvironment(); }
     [[nodiscard]] bool IsDocument2d() const { return this->database_configuration_2d_.operator bool(); }
     [[nodiscard]] bool IsDocument3d() const { return this->database_configuration_3d_.operator bool(); }
@@ -0,0 +1,522 @@
+// SPDX-FileCopyrightText: 2023 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <unordered_set>
+#include "documentCompaction.h"
+#include "brickChunkIndex.h"
+#include "../db/DbFactory.h"
+
+using namespace std;
+using namespace imgdoc2;
+
+namespace
+{
+    constexpr uint32_t kCurveGridSize = 65536;   ///< The size of the grid (in each direction) used for the space-filling curves.
+
+    const char* const kMapTableTilesInfo = "compaction_map_tilesinfo";
+    const char* const kMapTableTilesData = "compaction_map_tilesdata";
+    const char* const kMapTableBlobs = "compaction_map_blobs";
+
+    uint32_t QuantizeToCurveGrid(double value, double minimum, double maximum)
+    {
+        if (maximum <= minimum)
+        {
+            return 0;
+        }
+
+        const double normalized = (value - minimum) / (maximum - minimum);
+        return static_cast<uint32_t>(clamp(normalized * (kCurveGridSize - 1), 0.0, static_cast<double>(kCurveGridSize - 1)));
+    }
+}
+
+DocumentCompaction::DocumentCompaction(std::shared_ptr<Document> document) :
+    document_(std::move(document)),
+    names_(DocumentCompaction::GetTableAndColumnNames(*this->document_))
+{
+}
+
+/*static*/DocumentCompaction::TableAndColumnNames DocumentCompaction::GetTableAndColumnNames(const Document& document)
+{
+    TableAndColumnNames names;
+    const DatabaseConfigurationCommon* configuration_common = document.GetDataBaseConfigurationCommon();
+    if (document.IsDocument2d())
+    {
+        const auto& configuration = document.GetDataBaseConfiguration2d();
+        names.tiles_info_pk = configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration2D::kTilesInfoTable_Column_Pk);
+        names.tiles_info_x = configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration2D::kTilesInfoTable_Column_TileX);
+        names.tiles_info_y = configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration2D::kTilesInfoTable_Column_TileY);
+        names.tiles_info_w = configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration2D::kTilesInfoTable_Column_TileW);
+        names.tiles_info_h = configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration2D::kTilesInfoTable_Column_TileH);
+        names.tiles_info_pyramid_level = configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration2D::kTilesInfoTable_Column_PyramidLevel);
+        names.tiles_info_tile_data_id = configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration2D::kTilesInfoTable_Column_TileDataId);
+        names.tiles_data_pk = configuration->GetColumnNameOfTilesDataTableOrThrow(DatabaseConfiguration2D::kTilesDataTable_Column_Pk);
+        names.tiles_data_data_type = configuration->GetColumnNameOfTilesDataTableOrThrow(DatabaseConfiguration2D::kTilesDataTable_Column_TileDataType);
+        names.tiles_data_bin_data_id = configuration->GetColumnNameOfTilesDataTableOrThrow(DatabaseConfiguration2D::kTilesDataTable_Column_BinDataId);
+        if (configuration->GetIsUsingSpatialIndex())
+        {
+            for (const int column : { DatabaseConfiguration2D::kTilesSpatialIndexTable_Column_Pk,
+                                      DatabaseConfiguration2D::kTilesSpatialIndexTable_Column_MinX, DatabaseConfiguration2D::kTilesSpatialIndexTable_Column_MaxX,
+                                      DatabaseConfiguration2D::kTilesSpatialIndexTable_Column_MinY, DatabaseConfiguration2D::kTilesSpatialIndexTable_Column_MaxY })
+            {
+                names.spatial_index_columns.push_back(configuration->GetColumnNameOfTilesSpatialIndexTableOrThrow(column));
+            }
+        }
+    }
+    else if (document.IsDocument3d())
+    {
+        const auto& configuration = document.GetDataBaseConfiguration3d();
+        names.tiles_info_pk = configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration3D::kTilesInfoTable_Column_Pk);
+        names.tiles_info_x = configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration3D::kTilesInfoTable_Column_TileX);
+        names.tiles_info_y = configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration3D::kTilesInfoTable_Column_TileY);
+        names.tiles_info_z = configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration3D::kTilesInfoTable_Column_TileZ);
+        names.tiles_info_w = configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration3D::kTilesInfoTable_Column_TileW);
+        names.tiles_info_h = configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration3D::kTilesInfoTable_Column_TileH);
+        names.tiles_info_d = configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration3D::kTilesInfoTable_Column_TileD);
+        names.tiles_info_pyramid_level = configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration3D::kTilesInfoTable_Column_PyramidLevel);
+        names.tiles_info_tile_data_id = configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration3D::kTilesInfoTable_Column_TileDataId);
+        names.tiles_data_pk = configuration->GetColumnNameOfTilesDataTableOrThrow(DatabaseConfiguration3D::kTilesDataTable_Column_Pk);
+        names.tiles_data_data_type = configuration->GetColumnNameOfTilesDataTableOrThrow(DatabaseConfiguration3D::kTilesDataTable_Column_TileDataType);
+        names.tiles_data_bin_data_id = configuration->GetColumnNameOfTilesDataTableOrThrow(DatabaseConfiguration3D::kTilesDataTable_Column_BinDataId);
+        if (configuration->GetIsUsingSpatialIndex())
+        {
+            for (const int column : { DatabaseConfiguration3D::kTilesSpatialIndexTable_Column_Pk,
+                                      DatabaseConfiguration3D::kTilesSpatialIndexTable_Column_MinX, DatabaseConfiguration3D::kTilesSpatialIndexTable_Column_MaxX,
+                                      DatabaseConfiguration3D::kTilesSpatialIndexTable_Column_MinY, DatabaseConfiguration3D::kTilesSpatialIndexTable_Column_MaxY,
+                                      DatabaseConfiguration3D::kTilesSpatialIndexTable_Column_MinZ, DatabaseConfiguration3D::kTilesSpatialIndexTable_Column_MaxZ })
+            {
+                names.spatial_index_columns.push_back(configuration->GetColumnNameOfTilesSpatialIndexTableOrThrow(column));
+            }
+        }
+    }
+    else
+    {
+        throw invalid_operation_exception("The document type is not supported for this operation.");
+    }
+
+    names.tiles_info_table = configuration_common->GetTableNameForTilesInfoOrThrow();
+    names.tiles_data_table = configuration_common->GetTableNameForTilesDataOrThrow();
+    if (configuration_common->GetHasBlobsTable())
+    {
+        names.blob_table = configuration_common->GetTableNameForBlobTableOrThrow();
+        names.blob_pk = configuration_common->GetColumnNameOfBlobTableOrThrow(DatabaseConfigurationCommon::kBlobTable_Column_Pk);
+        names.blob_data = configuration_common->GetColumnNameOfBlobTableOrThrow(DatabaseConfigurationCommon::kBlobTable_Column_Data);
+    }
+
+    if (configuration_common->GetIsUsingSpatialIndex())
+    {
+        names.spatial_index_table = configuration_common->GetTableNameForTilesSpatialIndexTableOrThrow();
+    }
+
+    if (configuration_common->GetHasTileStatisticsTable())
+    {
+        names.tile_statistics_table = configuration_common->GetTableNameForTileStatisticsTableOrThrow();
+        names.tile_statistics_pk = configuration_common->GetColumnNameOfTileStatisticsTableOrThrow(DatabaseConfigurationCommon::kTileStatisticsTable_Column_Pk);
+    }
+
+    return names;
+}
+
+void DocumentCompaction::CreateCompactedCopy(const char* destination_filename)
+{
+    this->ThrowIfNotSupported();
+
+    // first step - we create a copy of the database with "VACUUM INTO" (-> https://www.sqlite.org/lang_vacuum.html#vacuuminto),
+    //  which gives us a copy without any free pages
+    const auto& source_connection = this->document_->GetDatabase_connection();
+    const auto vacuum_into_statement = source_connection->PrepareStatement("VACUUM main INTO ?1;");
+    vacuum_into_statement->BindString(1, destination_filename);
+    source_connection->Execute(vacuum_into_statement.get());
+
+    // now, we operate on the copy - we renumber the tiles, the tiles-data and the blobs in a locality-preserving order
+    const auto destination_connection = DbFactory::SqliteOpenExistingDatabase(destination_filename, false, this->document_->GetHostingEnvironment());
+
+    vector<Dimension> dimensions(
+        this->document_->GetDataBaseConfigurationCommon()->GetTileDimensions().cbegin(),
+        this->document_->GetDataBaseConfigurationCommon()->GetTileDimensions().cend());
+    sort(dimensions.begin(), dimensions.end());
+
+    destination_connection->BeginTransaction();
+    try
+    {
+        auto tiles = this->ReadTilesInfo(destination_connection.get(), dimensions);
+        this->CalculateCurveKeys(tiles);
+        sort(
+            tiles.begin(),
+            tiles.end(),
+            [](const TileSortInfo& a, const TileSortInfo& b)->bool
+            {
+                return tie(a.coordinate, a.pyramid_level, a.curve_key, a.pk) < tie(b.coordinate, b.pyramid_level, b.curve_key, b.pk);
+            });
+
+        this->Renumber(destination_connection.get(), tiles);
+        this->RebuildSpatialIndex(destination_connection.get());
+    }
+    catch (...)
+    {
+        destination_connection->EndTransaction(false);
+        throw;
+    }
+
+    destination_connection->EndTransaction(true);
+
+    // and finally, vacuum the copy so that the rows are stored in the order of their new primary keys
+    destination_connection->Execute("VACUUM;");
+}
+
+void DocumentCompaction::ThrowIfNotSupported() const
+{
+    const auto& connection = this->document_->GetDatabase_connection();
+    if (connection->IsTransactionPending())
+    {
+        throw invalid_operation_exception("A compacted copy cannot be created while a transaction is pending.");
+    }
+
+    if (!this->names_.blob_table.empty())
+    {
+        // "VACUUM INTO" is only copying the main database, so we cannot deal with a blob-table which resides in an attached database
+        const auto statement = connection->PrepareStatement("SELECT COUNT(*) FROM [main].[sqlite_master] WHERE [type]='table' AND [name]=?1;");
+        statement->BindString(1, this->names_.blob_table);
+        if (!connection->StepStatement(statement.get()) || statement->GetResultInt64(0) == 0)
+        {
+            throw invalid_operation_exception("A compacted copy cannot be created for a document with a separate blob-database.");
+        }
+    }
+}
+
+std::vector<DocumentCompaction::TileSortInfo> DocumentCompaction::ReadTilesInfo(IDbConnection* connection, const std::vector<imgdoc2::Dimension>& dimensions) const
+{
+    const bool is_3d = !this->names_.tiles_info_z.empty();
+    ostringstream string_stream;
+    string_stream << "SELECT [" << this->names_.tiles_info_pk << "],[" << this->names_.tiles_info_tile_data_id << "],[" << this->names_.tiles_info_pyramid_level << "],"
+        << "[" << this->names_.tiles_info_x << "]+[" << this->names_.tiles_info_w << "]/2,"
+        << "[" << this->names_.tiles_info_y << "]+[" << this->names_.tiles_info_h << "]/2";
+    if (is_3d)
+    {
+        string_stream << ",[" << this->names_.tiles_info_z << "]+[" << this->names_.tiles_info_d << "]/2";
+    }
+
+    for (const auto dimension : dimensions)
+    {
+        string_stream << ",[" << this->document_->GetDataBaseConfigurationCommon()->GetDimensionsColumnPrefix() << dimension << "]";
+    }
+
+    string_stream << " FROM [" << this->names_.tiles_info_table << "];";
+
+    const auto statement = connection->PrepareStatement(string_stream.str());
+    vector<TileSortInfo> tiles;
+    while (connection->StepStatement(statement.get()))
+    {
+        TileSortInfo tile;
+        int column = 0;
+        tile.pk = statement->GetResultInt64(column++);
+        tile.tile_data_id = statement->GetResultInt64(column++);
+        tile.pyramid_level = statement->GetResultInt32(column++);
+        tile.center_x = statement->GetResultDouble(column++);
+        tile.center_y = statement->GetResultDouble(column++);
+        tile.center_z = is_3d ? statement->GetResultDouble(column++) : 0;
+        tile.curve_key = 0;
+        tile.coordinate.reserve(dimensions.size());
+        for (size_t i = 0; i < dimensions.size(); ++i)
+        {
+            tile.coordinate.push_back(statement->GetResultInt32(column++));
+        }
+
+        tiles.emplace_back(std::move(tile));
+    }
+
+    return tiles;
+}
+
+void DocumentCompaction::CalculateCurveKeys(std::vector<TileSortInfo>& tiles) const
+{
+    double min_x = numeric_limits<double>::max(), max_x = numeric_limits<double>::lowest();
+    double min_y = numeric_limits<double>::max(), max_y = numeric_limits<double>::lowest();
+    double min_z = numeric_limits<double>::max(), max_z = numeric_limits<double>::lowest();
+    for (const auto& tile : tiles)
+    {
+        min_x = min(min_x, tile.center_x);
+        max_x = max(max_x, tile.center_x);
+        min_y = min(min_y, tile.center_y);
+        max_y = max(max_y, tile.center_y);
+        min_z = min(min_z, tile.center_z);
+        max_z = max(max_z, tile.center_z);
+    }
+
+    const bool is_3d = !this->names_.tiles_info_z.empty();
+    for (auto& tile : tiles)
+    {
+        const uint32_t x = QuantizeToCurveGrid(tile.center_x, min_x, max_x);
+        const uint32_t y = QuantizeToCurveGrid(tile.center_y, min_y, max_y);
+        if (is_3d)
+        {
+            tile.curve_key = DocumentCompaction::CalculateZOrderKey(x, y, QuantizeToCurveGrid(tile.center_z, min_z, max_z));
+        }
+        else
+        {
+            tile.curve_key = DocumentCompaction::CalculateHilbertKey(x, y);
+        }
+    }
+}
+
+void DocumentCompaction::Renumber(IDbConnection* connection, const std::vector<TileSortInfo>& sorted_tiles) const
+{
+    // the new order of the TILESINFO-table is given by the sorted tiles
+    vector<dbIndex> tiles_info_order;
+    tiles_info_order.reserve(sorted_tiles.size());
+    for (const auto& tile : sorted_tiles)
+    {
+        tiles_info_order.push_back(tile.pk);
+    }
+
+    // the rows in the TILESDATA-table are ordered in the same way (so that - as is the case with a document which
+    //  is written in the usual way - the primary keys of TILESINFO and TILESDATA are identical), rows which are not
+    //  referenced are put at the end
+    vector<dbIndex> tiles_data_order;
+    tiles_data_order.reserve(sorted_tiles.size());
+    unordered_set<dbIndex> tiles_data_seen;
+    for (const auto& tile : sorted_tiles)
+    {
+        if (tiles_data_seen.insert(tile.tile_data_id).second)
+        {
+            tiles_data_order.push_back(tile.tile_data_id);
+        }
+    }
+
+    for (const auto pk : DocumentCompaction::ReadAllPrimaryKeys(connection, this->names_.tiles_data_table, this->names_.tiles_data_pk))
+    {
+        if (tiles_data_seen.insert(pk).second)
+        {
+            tiles_data_order.push_back(pk);
+        }
+    }
+
+    DocumentCompaction::CreateMapTable(connection, kMapTableTilesInfo, tiles_info_order);
+    DocumentCompaction::CreateMapTable(connection, kMapTableTilesData, tiles_data_order);
+    DocumentCompaction::UpdateForeignKeys(connection, this->names_.tiles_info_table, this->names_.tiles_info_tile_data_id, kMapTableTilesData);
+    DocumentCompaction::RenumberPrimaryKey(connection, this->names_.tiles_info_table, this->names_.tiles_info_pk, kMapTableTilesInfo);
+    DocumentCompaction::RenumberPrimaryKey(connection, this->names_.tiles_data_table, this->names_.tiles_data_pk, kMapTableTilesData);
+    if (!this->names_.tile_statistics_table.empty())
+    {
+        // the rows of the tile-statistics table have the same primary key as the corresponding row in the TILESDATA-table
+        DocumentCompaction::RenumberPrimaryKey(connection, this->names_.tile_statistics_table, this->names_.tile_statistics_pk, kMapTableTilesData);
+    }
+
+    if (!this->names_.blob_table.empty())
+    {
+        // now, the blobs are ordered in the order of the (renumbered) TILESDATA-table, and for a chunked brick, the chunk index
+        //  is followed by the chunks
+        ostringstream string_stream;
+        string_stream << "SELECT [" << this->names_.tiles_data_bin_data_id << "],[" << this->names_.tiles_data_data_type << "] FROM [" << this->names_.tiles_data_table << "] "
+            << "WHERE [" << this->names_.tiles_data_bin_data_id << "] IS NOT NULL ORDER BY [" << this->names_.tiles_data_pk << "];";
+        const auto statement = connection->PrepareStatement(string_stream.str());
+        const auto read_blob_statement = connection->PrepareStatement("SELECT [" + this->names_.blob_data + "] FROM [" + this->names_.blob_table + "] WHERE [" + this->names_.blob_pk + "]=?1;");
+
+        vector<dbIndex> blobs_order;
+        unordered_set<dbIndex> blobs_seen;
+        vector<dbIndex> chunked_brick_blobs;
+        while (connection->StepStatement(statement.get()))
+        {
+            const dbIndex blob_pk = statement->GetResultInt64(0);
+            if (!blobs_seen.insert(blob_pk).second)
+            {
+                continue;
+            }
+
+            blobs_order.push_back(blob_pk);
+            if (statement->GetResultInt32(1) == static_cast<int>(DataTypes::UNCOMPRESSED_CHUNKED_BRICK))
+            {
+                read_blob_statement->Reset();
+                read_blob_statement->BindInt64(1, blob_pk);
+                BlobOutputOnHeap chunk_index_data;
+                if (connection->StepStatement(read_blob_statement.get()))
+                {
+                    read_blob_statement->GetResultBlob(0, &chunk_index_data);
+                }
+
+                const auto chunk_index = BrickChunkIndex::Parse(chunk_index_data.GetDataC(), chunk_index_data.GetSizeOfData());
+                for (const auto chunk_blob_pk : chunk_index.chunk_blob_keys)
+                {
+                    if (blobs_seen.insert(chunk_blob_pk).second)
+                    {
+                        blobs_order.push_back(chunk_blob_pk);
+                    }
+                }
+
+                chunked_brick_blobs.push_back(blob_pk);
+            }
+        }
+
+        for (const auto pk : DocumentCompaction::ReadAllPrimaryKeys(connection, this->names_.blob_table, this->names_.blob_pk))
+        {
+            if (blobs_seen.insert(pk).second)
+            {
+                blobs_order.push_back(pk);
+            }
+        }
+
+        unordered_map<dbIndex, dbIndex> blob_mapping;
+        for (size_t i = 0; i < blobs_order.size(); ++i)
+        {
+            blob_mapping[blobs_order[i]] = static_cast<dbIndex>(i + 1);
+        }
+
+        DocumentCompaction::CreateMapTable(connection, kMapTableBlobs, blobs_order);
+        DocumentCompaction::UpdateForeignKeys(connection, this->names_.tiles_data_table, this->names_.tiles_data_bin_data_id, kMapTableBlobs);
+        DocumentCompaction::RenumberPrimaryKey(connection, this->names_.blob_table, this->names_.blob_pk, kMapTableBlobs);
+        this->RewriteChunkIndices(connection, chunked_brick_blobs, blob_mapping);
+        connection->Execute((string("DROP TABLE [temp].[") + kMapTableBlobs + "];").c_str());
+    }
+
+    connection->Execute((string("DROP TABLE [temp].[") + kMapTableTilesInfo + "];").c_str());
+    connection->Execute((string("DROP TABLE [temp].[") + kMapTableTilesData + "];").c_str());
+}
+
+void DocumentCompaction::RewriteChunkIndices(IDbConnection* connection, const std::vector<imgdoc2::dbIndex>& chunked_brick_blobs, const std::unordered_map<imgdoc2::dbIndex, imgdoc2::dbIndex>& blob_mapping) const
+{
+    // the chunk index of a chunked brick contains the primary keys of the chunks, so it needs to be updated
+    const auto read_statement = connection->PrepareStatement("SELECT [" + this->names_.blob_data + "] FROM [" + this->names_.blob_table + "] WHERE [" + this->names_.blob_pk + "]=?1;");
+    for (const auto old_pk : chunked_brick_blobs)
+    {
+        const dbIndex new_pk = blob_mapping.at(old_pk);
+        read_statement->Reset();
+        read_statement->BindInt64(1, new_pk);
+        BlobOutputOnHeap chunk_index_data;
+        if (connection->StepStatement(read_statement.get()))
+        {
+            read_statement->GetResultBlob(0, &chunk_index_data);
+        }
+
+        auto chunk_index = BrickChunkIndex::Parse(chunk_index_data.GetDataC(), chunk_index_data.GetSizeOfData());
+        for (auto& chunk_blob_pk : chunk_index.chunk_blob_keys)
+        {
+            chunk_blob_pk = blob_mapping.at(chunk_blob_pk);
+        }
+
+        const auto serialized_chunk_index = chunk_index.Serialize();
+        const auto update_statement = connection->PrepareStatement("UPDATE [" + this->names_.blob_table + "] SET [" + this->names_.blob_data + "]=?2 WHERE [" + this->names_.blob_pk + "]=?1;");
+        update_statement->BindInt64(1, new_pk);
+        update_statement->BindBlob_Static(2, serialized_chunk_index.data(), serialized_chunk_index.size());
+        connection->Execute(update_statement.get());
+    }
+}
+
+void DocumentCompaction::RebuildSpatialIndex(IDbConnection* connection) const
+{
+    if (this->names_.spatial_index_table.empty())
+    {
+        return;
+    }
+
+    // we rebuild the spatial index, inserting the tiles in the order of their (new) primary keys
+    connection->Execute(("DELETE FROM [" + this->names_.spatial_index_table + "];").c_str());
+
+    const auto& columns = this->names_.spatial_index_columns;
+    ostringstream string_stream;
+    string_stream << "INSERT INTO [" << this->names_.spatial_index_table << "] (";
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+        string_stream << (i > 0 ? "," : "") << "[" << columns[i] << "]";
+    }
+
+    string_stream << ") SELECT [" << this->names_.tiles_info_pk << "],"
+        << "[" << this->names_.tiles_info_x << "],[" << this->names_.tiles_info_x << "]+[" << this->names_.tiles_info_w << "],"
+        << "[" << this->names_.tiles_info_y << "],[" << this->names_.tiles_info_y << "]+[" << this->names_.tiles_info_h << "]";
+    if (!this->names_.tiles_info_z.empty())
+    {
+        string_stream << ",[" << this->names_.tiles_info_z << "],[" << this->names_.tiles_info_z << "]+[" << this->names_.tiles_info_d << "]";
+    }
+
+    string_stream << " FROM [" << this->names_.tiles_info_table << "] ORDER BY [" << this->names_.tiles_info_pk << "];";
+    connection->Execute(string_stream.str().c_str());
+}
+
+/*static*/std::vector<imgdoc2::dbIndex> DocumentCompaction::ReadAllPrimaryKeys(IDbConnection* connection, const std::string& table_name, const std::string& pk_column)
+{
+    const auto statement = connection->PrepareStatement("SELECT [" + pk_column + "] FROM [" + table_name + "] ORDER BY [" + pk_column + "];");
+    vector<dbIndex> primary_keys;
+    while (connection->StepStatement(statement.get()))
+    {
+        primary_keys.push_back(statement->GetResultInt64(0));
+    }
+
+    return primary_keys;
+}
+
+/*static*/void DocumentCompaction::CreateMapTable(IDbConnection* connection, const std::string& map_table_name, const std::vector<imgdoc2::dbIndex>& new_order)
+{
+    connection->Execute(("CREATE TEMP TABLE [" + map_table_name + "]([OldPk] INTEGER PRIMARY KEY, [NewPk] INTEGER NOT NULL);").c_str());
+    const auto statement = connection->PrepareStatement("INSERT INTO [temp].[" + map_table_name + "]([OldPk],[NewPk]) VALUES(?1,?2);");
+    for (size_t i = 0; i < new_order.size(); ++i)
+    {
+        statement->Reset();
+        statement->BindInt64(1, new_order[i]);
+        statement->BindInt64(2, static_cast<dbIndex>(i + 1));
+        connection->Execute(statement.get());
+    }
+}
+
+/*static*/void DocumentCompaction::UpdateForeignKeys(IDbConnection* connection, const std::string& table_name, const std::string& column, const std::string& map_table_name)
+{
+    ostringstream string_stream;
+    string_stream << "UPDATE [" << table_name << "] SET [" << column << "]="
+        << "(SELECT [NewPk] FROM [temp].[" << map_table_name << "] WHERE [OldPk]=[" << table_name << "].[" << column << "]) "
+        << "WHERE [" << column << "] IN (SELECT [OldPk] FROM [temp].[" << map_table_name << "]);";
+    connection->Execute(string_stream.str().c_str());
+}
+
+/*static*/void DocumentCompaction::RenumberPrimaryKey(IDbConnection* connection, const std::string& table_name, const std::string& pk_column, const std::string& map_table_name)
+{
+    // In order to avoid collisions (of the old and the new primary keys), we do this in two steps - first, we assign the
+    //  negated new primary key, and then we negate it again.
+    ostringstream string_stream;
+    string_stream << "UPDATE [" << table_name << "] SET [" << pk_column << "]="
+        << "-(SELECT [NewPk] FROM [temp].[" << map_table_name << "] WHERE [OldPk]=[" << table_name << "].[" << pk_column << "]);";
+    connection->Execute(string_stream.str().c_str());
+
+    string_stream.str("");
+    string_stream << "UPDATE [" << table_name << "] SET [" << pk_column << "]=-[" << pk_column << "];";
+    connection->Execute(string_stream.str().c_str());
+}
+
+/*static*/std::uint64_t DocumentCompaction::CalculateHilbertKey(std::uint32_t x, std::uint32_t y)
+{
+    // c.f. https://en.wikipedia.org/wiki/Hilbert_curve#Applications_and_mapping_algorithms
+    uint64_t distance = 0;
+    for (uint32_t s = kCurveGridSize / 2; s > 0; s /= 2)
+    {
+        const uint32_t rx = (x & s) > 0 ? 1 : 0;
+        const uint32_t ry = (y & s) > 0 ? 1 : 0;
+        distance += static_cast<uint64_t>(s) * s * ((3 * rx) ^ ry);
+
+        // rotate the quadrant
+        if (ry == 0)
+        {
+            if (rx == 1)
+            {
+                x = kCurveGridSize - 1 - x;
+                y = kCurveGridSize - 1 - y;
+            }
+
+            swap(x, y);
+        }
+    }
+
+    return distance;
+}
+
+/*static*/std::uint64_t DocumentCompaction::CalculateZOrderKey(std::uint32_t x, std::uint32_t y, std::uint32_t z)
+{
+    uint64_t key = 0;
+    for (int bit = 0; bit < 16; ++bit)
+    {
+        key |= static_cast<uint64_t>((x >> bit) & 1) << (3 * bit);
+        key |= static_cast<uint64_t>((y >> bit) & 1) << (3 * bit + 1);
+        key |= static_cast<uint64_t>((z >> bit) & 1) << (3 * bit + 2);
+    }
+
+    return key;
+}
@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: 2023 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "document.h"
+
+/// This class implements the creation of a "compacted copy" of a document. The copy is created with "VACUUM INTO", and then
+/// the tiles (or bricks) are renumbered so that the primary keys follow a locality-preserving order - the rows are sorted
+/// by their plane (i.e. the tile-coordinate), the pyramid level and a space-filling-curve key of the center of the tile (a
+/// Hilbert-curve for 2D-documents, a Z-order-curve for 3D-documents). The rows of the TILESDATA-table and the BLOBS-table
+/// are renumbered in the same order, the spatial index is rebuilt, and finally the copy is vacuumed. Since SQLite is storing
+/// the rows of a table in the order of their primary keys, the blobs of tiles which are adjacent in space are then (to a large
+/// extent) also adjacent in the file.
+class DocumentCompaction
+{
+public:
+    /// The names of the tables and columns which are relevant for the compaction operation (and for other operations
+    /// dealing with all tables of a document, c.f. DocumentImport). This allows us to deal with 2D- and 3D-documents
+    /// in the same way.
+    struct TableAndColumnNames
+    {
+        std::string tiles_info_table;
+        std::string tiles_info_pk;
+        std::string tiles_info_x;
+        std::string tiles_info_y;
+        std::string tiles_info_z;                   ///< The column for the z-position, empty for 2D-documents.
+        std::string tiles_info_w;
+        std::string tiles_info_h;
+        std::string tiles_info_d;                   ///< The column for the depth, empty for 2D-documents.
+        std::string tiles_info_pyramid_level;
+        std::string tiles_info_tile_data_id;
+
+        std::string tiles_data_table;
+        std::string tiles_data_pk;
+        std::string tiles_data_data_type;
+        std::string tiles_data_bin_data_id;
+
+        std::string blob_table;                     ///< The name of the blob-table, empty if there is no blob-table.
+        std::string blob_pk;
+        std::string blob_data;
+
+        std::string spatial_index_table;            ///< The name of the spatial-index table, empty if there is no spatial index.
+        std::vector<std::string> spatial_index_columns;   ///< The columns of the spatial index (pk, min-x, max-x, min-y, max-y, [min-z, max-z]).
+
+        std::string tile_statistics_table;          ///< The name of the tile-statistics table, empty if there is no tile-statistics table.
+        std::string tile_statistics_pk;
+    };
+private:
+    std::shared_ptr<Document> document_;
+
+    /// The information about a tile which is required for determining its position in the compacted document.
+    struct TileSortInfo
+    {
+        imgdoc2::dbIndex pk;
+        imgdoc2::dbIndex tile_data_id;
+        std::vector<int> coordinate;                ///< The tile-coordinate (with the dimensions in ascending order).
+        int pyramid_level;
+        double center_x;
+        double center_y;
+        double center_z;
+        std::uint64_t curve_key;                    ///< The key on the space-filling curve.
+    };
+
+    TableAndColumnNames names_;
+public:
+    explicit DocumentCompaction(std::shared_ptr<Document> document);
+
+    /// Creates a compacted copy of the document. The destination file must not exist.
+    /// \param  destination_filename    The filename of the destination (in UTF8-encoding).
+    void CreateCompactedCopy(const char* destination_filename);
+
+    /// Gets the names of the tables and columns of the specified document.
+    /// \param  document    The document.
+    /// \returns The names of the tables and columns.
+    static TableAndColumnNames GetTableAndColumnNames(const Document& document);
+
+    /// Calculates the distance along a Hilbert curve (of order 16, i.e. on a 65536x65536-grid) for the specified point.
+    /// \param  x   The x-coordinate (in the range 0...65535).
+    /// \param  y   The y-coordinate (in the range 0...65535).
+    /// \returns The distance along the Hilbert curve.
+    static std::uint64_t CalculateHilbertKey(std::uint32_t x, std::uint32_t y);
+
+    /// Calculates the distance along a Z-order curve (of order 16) in three dimensions for the specified point.
+    /// \param  x   The x-coordinate (in the range 0...65535).
+    /// \param  y   The y-coordinate (in the range 0...65535).
+    /// \param  z   The z-coordinate (in the range 0...65535).
+    /// \returns The distance along the Z-order curve.
+    static std::uint64_t CalculateZOrderKey(std::uint32_t x, std::uint32_t y, std::uint32_t z);
+private:
+    void ThrowIfNotSupported() const;
+    std::vector<TileSortInfo> ReadTilesInfo(IDbConnection* connection, const std::vector<imgdoc2::Dimension>& dimensions) const;
+    void CalculateCurveKeys(std::vector<TileSortInfo>& tiles) const;
+    void Renumber(IDbConnection* connection, const std::vector<TileSortInfo>& sorted_tiles) const;
+    void RewriteChunkIndices(IDbConnection* connection, const std::vector<imgdoc2::dbIndex>& chunked_brick_blobs, const std::unordered_map<imgdoc2::dbIndex, imgdoc2::dbIndex>& blob_mapping) const;
+    void RebuildSpatialIndex(IDbConnection* connection) const;
+    static std::vector<imgdoc2::dbIndex> ReadAllPrimaryKeys(IDbConnection* connection, const std::string& table_name, const std::string& pk_column);
+
+    /// Creates a (temporary) table which maps the old primary keys to the new ones.
+    /// \param  connection      The database connection.
+    /// \param  map_table_name  Name of the table to be created.
+    /// \param  new_order       The old primary keys in their new order, i.e. the n-th element will get the primary key n+1.
+    static void CreateMapTable(IDbConnection* connection, const std::string& map_table_name, const std::vector<imgdoc2::dbIndex>& new_order);
+
+    /// Updates a column which is referencing the primary key of another table, using the specified map table.
+    /// \param  connection      The database connection.
+    /// \param  table_name      Name of the table to be updated.
+    /// \param  column          The column (containing the foreign key) to be updated.
+    /// \param  map_table_name  Name of the map table.
+    static void UpdateForeignKeys(IDbConnection* connection, const std::string& table_name, const std::string& column, const std::string& map_table_name);
+
+    /// Renumbers the primary key of the specified table, using the specified map table.
+    /// \param  connection      The database connection.
+    /// \param  table_name      Name of the table to be updated.
+    /// \param  pk_column       The primary key column.
+    /// \param  map_table_name  Name of the map table.
+    static void RenumberPrimaryKey(IDbConnection* connection, const std::string& table_name, const std::string& pk_column, const std::string& map_table_name);
+};
@@ -0,0 +1,595 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include <filesystem>
+#include <sstream>
+#include <system_error>
+#include "documentImport.h"
+#include "brickChunkIndex.h"
+#include "../db/DbFactory.h"
+#include "../db/database_discovery.h"
+#include "../db/database_constants.h"
+#include "../db/utilities.h"
+
+using namespace std;
+using namespace imgdoc2;
+
+namespace
+{
+    const char* const kMapTableTilesInfo = "import_map_tilesinfo";
+    const char* const kMapTableTilesData = "import_map_tilesdata";
+    const char* const kMapTableBlobs = "import_map_blobs";
+    const char* const kSelectedBlobsTable = "import_selected_blobs";
+}
+
+/*static*/const char* const DocumentImport::kSourceSchemaName = "imgdoc2_source";
+
+DocumentImport::DocumentImport(std::shared_ptr<Document> document) :
+    document_(std::move(document)),
+    names_(DocumentCompaction::GetTableAndColumnNames(*this->document_))
+{
+}
+
+void DocumentImport::ImportTiles(const char* source_filename, const imgdoc2::TileSelection* selection)
+{
+    this->OpenSourceDocument(source_filename);
+    this->ImportRows(selection, false);
+}
+
+/*static*/void DocumentImport::CreateSubsetCopy(const std::shared_ptr<Document>& document, const char* destination_filename, const imgdoc2::TileSelection* selection)
+{
+    const auto& connection = document->GetDatabase_connection();
+    if (connection->IsTransactionPending())
+    {
+        throw invalid_operation_exception("A subset copy cannot be created while a transaction is pending.");
+    }
+
+    const string source_filename = connection->GetMainDatabaseFilename();
+    if (source_filename.empty())
+    {
+        throw invalid_operation_exception("A subset copy cannot be created for an in-memory document.");
+    }
+
+    // we check the selection before creating the destination document, so that we do not leave an empty document behind
+    DocumentImport::ThrowIfSelectionIsInvalid(*document, selection);
+
+    // the new document gets the same configuration as the source document
+    const DatabaseConfigurationCommon* configuration_common = document->GetDataBaseConfigurationCommon();
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetFilename(destination_filename);
+    create_options->SetDocumentType(document->IsDocument3d() ? DocumentType::kImage3d : DocumentType::kImage2d);
+    for (const auto dimension : configuration_common->GetTileDimensions())
+    {
+        create_options->AddDimension(dimension);
+    }
+
+    for (const auto dimension : configuration_common->GetIndexedTileDimensions())
+    {
+        create_options->AddIndexForDimension(dimension);
+    }
+
+    create_options->SetUseSpatialIndex(configuration_common->GetIsUsingSpatialIndex());
+    create_options->SetCreateBlobTable(configuration_common->GetHasBlobsTable());
+    create_options->SetCreateTileStatisticsTable(configuration_common->GetHasTileStatisticsTable());
+
+    // if the copy fails, we remove the destination file again, so that we do not leave a partial copy behind - but only if
+    //  the file did not exist before, so that we never delete a file which we did not create
+    const auto destination_path = filesystem::u8path(destination_filename);
+    const bool destination_existed = filesystem::exists(destination_path);
+    try
+    {
+        const auto destination_document = dynamic_pointer_cast<Document>(ClassFactory::CreateNew(create_options.get(), document->GetHostingEnvironment()));
+        DocumentImport import(destination_document);
+        import.source_document_ = document;
+        import.source_names_ = DocumentCompaction::GetTableAndColumnNames(*document);
+        import.ImportRows(selection, true);
+    }
+    catch (...)
+    {
+        // note that at this point the destination document has been destroyed (i.e. the database connection is closed)
+        if (!destination_existed)
+        {
+            error_code error_code;
+            filesystem::remove(destination_path, error_code);
+        }
+
+        throw;
+    }
+}
+
+void DocumentImport::OpenSourceDocument(const std::string& source_filename)
+{
+    const auto source_connection = DbFactory::SqliteOpenExistingDatabase(source_filename.c_str(), true, this->document_->GetHostingEnvironment());
+    DbDiscovery database_discovery{ source_connection };
+    database_discovery.DoDiscovery();
+    const auto database_configuration_2d = database_discovery.GetDatabaseConfiguration2DOrNull();
+    const auto database_configuration_3d = database_discovery.GetDatabaseConfiguration3DOrNull();
+    if (database_configuration_2d)
+    {
+        this->source_document_ = make_shared<Document>(source_connection, database_configuration_2d);
+    }
+    else if (database_configuration_3d)
+    {
+        this->source_document_ = make_shared<Document>(source_connection, database_configuration_3d);
+    }
+    else
+    {
+        throw invalid_operation_exception("The source document could not be opened.");
+    }
+
+    this->source_names_ = DocumentCompaction::GetTableAndColumnNames(*this->source_document_);
+}
+
+void DocumentImport::ThrowIfNotCompatible(const imgdoc2::TileSelection* selection) const
+{
+    if (this->document_->GetDatabase_connection()->IsTransactionPending())
+    {
+        throw invalid_operation_exception("Tiles cannot be imported while a transaction is pending.");
+    }
+
+    if (this->document_->IsDocument2d() != this->source_document_->IsDocument2d())
+    {
+        throw invalid_operation_exception("The source document is not of the same type as the destination document.");
+    }
+
+    if (this->document_->GetDataBaseConfigurationCommon()->GetTileDimensions() != this->source_document_->GetDataBaseConfigurationCommon()->GetTileDimensions())
+    {
+        throw invalid_operation_exception("The source document does not have the same dimensions as the destination document.");
+    }
+
+    DocumentImport::ThrowIfSelectionIsInvalid(*this->document_, selection);
+}
+
+/*static*/void DocumentImport::ThrowIfSelectionIsInvalid(const Document& document, const imgdoc2::TileSelection* selection)
+{
+    if (selection != nullptr)
+    {
+        if (selection->rectangle.has_value() && !document.IsDocument2d())
+        {
+            throw invalid_argument_exception("A rectangle can only be given with a 2D-document.");
+        }
+
+        if (selection->cuboid.has_value() && !document.IsDocument3d())
+        {
+            throw invalid_argument_exception("A cuboid can only be given with a 3D-document.");
+        }
+    }
+}
+
+void DocumentImport::ImportRows(const imgdoc2::TileSelection* selection, bool copy_metadata_and_user_properties)
+{
+    this->ThrowIfNotCompatible(selection);
+
+    const string source_filename = filesystem::absolute(filesystem::u8path(this->source_document_->GetDatabase_connection()->GetMainDatabaseFilename())).u8string();
+    const auto& connection = this->document_->GetDatabase_connection();
+    connection->AttachDatabase(source_filename.c_str(), kSourceSchemaName, false);
+
+    try
+    {
+        if (!this->source_names_.blob_table.empty())
+        {
+            // we only deal with a blob-table which resides in the source document's file (i.e. not in a separate blob-database)
+            const auto statement = connection->PrepareStatement(string("SELECT COUNT(*) FROM [") + kSourceSchemaName + "].[sqlite_master] WHERE [type]='table' AND [name]=?1;");
+            statement->BindString(1, this->source_names_.blob_table);
+            if (!connection->StepStatement(statement.get()) || statement->GetResultInt64(0) == 0)
+            {
+                throw invalid_operation_exception("Importing from a document with a separate blob-database is not supported.");
+            }
+        }
+
+        connection->BeginTransaction();
+        try
+        {
+            this->CreateTilesInfoMapTable(connection.get(), selection);
+            this->CreateTilesDataMapTable(connection.get());
+            const auto chunked_brick_blobs = this->CreateBlobsMapTable(connection.get());
+
+            const string source_prefix = string("[") + kSourceSchemaName + "].";
+            if (!this->source_names_.blob_table.empty() && !this->names_.blob_table.empty())
+            {
+                // note that the destination's blob-table is not qualified with a schema-name, since it may reside in a separate blob-database
+                DocumentImport::CopyRows(
+                    connection.get(),
+                    "[" + this->names_.blob_table + "]",
+                    source_prefix + "[" + this->source_names_.blob_table + "]",
+                    { this->names_.blob_pk, this->names_.blob_data },
+                    this->names_.blob_pk,
+                    kMapTableBlobs,
+                    string(),
+                    string());
+                this->RewriteChunkIndices(connection.get(), chunked_brick_blobs);
+            }
+
+            // The blob-ids are only to be mapped if both documents have a blob-table (only then the blob-map-table exists). If
+            //  the destination has no blob-table, then CreateBlobsMapTable has ensured that no selected tile references a blob.
+            const bool map_blob_ids = !this->source_names_.blob_table.empty() && !this->names_.blob_table.empty();
+            DocumentImport::CopyRows(
+                connection.get(),
+                "[main].[" + this->names_.tiles_data_table + "]",
+                source_prefix + "[" + this->source_names_.tiles_data_table + "]",
+                DocumentImport::GetColumnNames(connection.get(), this->names_.tiles_data_table),
+                this->names_.tiles_data_pk,
+                kMapTableTilesData,
+                map_blob_ids ? this->names_.tiles_data_bin_data_id : string(),
+                kMapTableBlobs);
+            DocumentImport::CopyRows(
+                connection.get(),
+                "[main].[" + this->names_.tiles_info_table + "]",
+                source_prefix + "[" + this->source_names_.tiles_info_table + "]",
+                DocumentImport::GetColumnNames(connection.get(), this->names_.tiles_info_table),
+                this->names_.tiles_info_pk,
+                kMapTableTilesInfo,
+                this->names_.tiles_info_tile_data_id,
+                kMapTableTilesData);
+            if (!this->names_.tile_statistics_table.empty() && !this->source_names_.tile_statistics_table.empty())
+            {
+                // the rows of the tile-statistics table have the same primary key as the corresponding row in the TILESDATA-table
+                DocumentImport::CopyRows(
+                    connection.get(),
+                    "[main].[" + this->names_.tile_statistics_table + "]",
+                    source_prefix + "[" + this->source_names_.tile_statistics_table + "]",
+                    DocumentImport::GetColumnNames(connection.get(), this->names_.tile_statistics_table),
+                    this->names_.tile_statistics_pk,
+                    kMapTableTilesData,
+                    string(),
+                    string());
+            }
+
+            this->UpdateSpatialIndex(connection.get());
+            if (copy_metadata_and_user_properties)
+            {
+                this->CopyMetadataAndUserProperties(connection.get());
+            }
+
+            for (const auto* table_name : { kMapTableTilesInfo, kMapTableTilesData, kMapTableBlobs, kSelectedBlobsTable })
+            {
+                connection->Execute((string("DROP TABLE IF EXISTS [temp].[") + table_name + "];").c_str());
+            }
+        }
+        catch (...)
+        {
+            connection->EndTransaction(false);
+            throw;
+        }
+
+        connection->EndTransaction(true);
+    }
+    catch (...)
+    {
+        connection->DetachDatabase(kSourceSchemaName);
+        throw;
+    }
+
+    connection->DetachDatabase(kSourceSchemaName);
+}
+
+void DocumentImport::CreateTilesInfoMapTable(IDbConnection* connection, const imgdoc2::TileSelection* selection) const
+{
+    // the new primary keys follow the largest primary key in use in the destination, and the tiles keep their relative order
+    const dbIndex offset = DocumentImport::GetMaxPrimaryKey(connection, "[main].[" + this->names_.tiles_info_table + "]", this->names_.tiles_info_pk);
+    connection->Execute((string("CREATE TEMP TABLE [") + kMapTableTilesInfo + "]([OldPk] INTEGER PRIMARY KEY, [NewPk] INTEGER NOT NULL);").c_str());
+
+    const auto& names = this->source_names_;
+    ostringstream string_stream;
+    string_stream << "INSERT INTO [temp].[" << kMapTableTilesInfo << "]([OldPk],[NewPk]) SELECT [" << names.tiles_info_pk << "],"
+        << "?+ROW_NUMBER() OVER (ORDER BY [" << names.tiles_info_pk << "]) FROM [" << kSourceSchemaName << "].[" << names.tiles_info_table << "] WHERE ";
+
+    tuple<string, vector<Utilities::DataBindInfo>> where_statement;
+    if (this->source_document_->IsDocument2d())
+    {
+        where_statement = Utilities::CreateWhereStatement(
+            selection != nullptr ? selection->coordinate_clause : nullptr,
+            selection != nullptr ? selection->tileinfo_clause : nullptr,
+            *this->source_document_->GetDataBaseConfiguration2d());
+    }
+    else
+    {
+        where_statement = Utilities::CreateWhereStatement(
+            selection != nullptr ? selection->coordinate_clause : nullptr,
+            selection != nullptr ? selection->tileinfo_clause : nullptr,
+            *this->source_document_->GetDataBaseConfiguration3d());
+    }
+
+    string_stream << get<0>(where_statement);
+
+    // the extent to be intersected with - as (min, max)-pairs for x, y and (for 3D) z
+    vector<double> extent;
+    if (selection != nullptr && selection->rectangle.has_value())
+    {
+        const auto& rectangle = selection->rectangle.value();
+        extent = { rectangle.x, rectangle.x + rectangle.w, rectangle.y, rectangle.y + rectangle.h };
+    }
+    else if (selection != nullptr && selection->cuboid.has_value())
+    {
+        const auto& cuboid = selection->cuboid.value();
+        extent = { cuboid.x, cuboid.x + cuboid.w, cuboid.y, cuboid.y + cuboid.h, cuboid.z, cuboid.z + cuboid.d };
+    }
+
+    if (!extent.empty())
+    {
+        if (!names.spatial_index_table.empty())
+        {
+            // the columns of the spatial index are given as (pk, min-x, max-x, min-y, max-y, [min-z, max-z])
+            string_stream << " AND [" << names.tiles_info_pk << "] IN (SELECT [" << names.spatial_index_columns[0] << "] FROM [" << kSourceSchemaName << "].[" << names.spatial_index_table << "] WHERE ";
+            for (size_t i = 0; i < extent.size() / 2; ++i)
+            {
+                string_stream << (i > 0 ? " AND " : "") << "[" << names.spatial_index_columns[1 + 2 * i + 1] << "]>=? AND [" << names.spatial_index_columns[1 + 2 * i] << "]<=?";
+            }
+
+            string_stream << ")";
+        }
+        else
+        {
+            const string positions[] = { names.tiles_info_x, names.tiles_info_y, names.tiles_info_z };
+            const string sizes[] = { names.tiles_info_w, names.tiles_info_h, names.tiles_info_d };
+            for (size_t i = 0; i < extent.size() / 2; ++i)
+            {
+                string_stream << " AND [" << positions[i] << "]+[" << sizes[i] << "]>=? AND [" << positions[i] << "]<=?";
+            }
+        }
+    }
+
+    string_stream << ";";
+    const auto statement = connection->PrepareStatement(string_stream.str());
+    int binding_index = 1;
+    statement->BindInt64(binding_index++, offset);
+    binding_index = Utilities::AddDataBindInfoListToDbStatement(get<1>(where_statement), statement.get(), binding_index);
+    for (const double value : extent)
+    {
+        statement->BindDouble(binding_index++, value);
+    }
+
+    connection->Execute(statement.get());
+}
+
+void DocumentImport::CreateTilesDataMapTable(IDbConnection* connection) const
+{
+    const dbIndex offset = DocumentImport::GetMaxPrimaryKey(connection, "[main].[" + this->names_.tiles_data_table + "]", this->names_.tiles_data_pk);
+    connection->Execute((string("CREATE TEMP TABLE [") + kMapTableTilesData + "]([OldPk] INTEGER PRIMARY KEY, [NewPk] INTEGER NOT NULL);").c_str());
+
+    const auto& names = this->source_names_;
+    ostringstream string_stream;
+    string_stream << "INSERT INTO [temp].[" << kMapTableTilesData << "]([OldPk],[NewPk]) SELECT [Id],?1+ROW_NUMBER() OVER (ORDER BY [Id]) FROM "
+        << "(SELECT DISTINCT s.[" << names.tiles_info_tile_data_id << "] AS [Id] FROM [" << kSourceSchemaName << "].[" << names.tiles_info_table << "] s "
+        << "INNER JOIN [temp].[" << kMapTableTilesInfo << "] m ON m.[OldPk]=s.[" << names.tiles_info_pk << "] "
+        << "WHERE s.[" << names.tiles_info_tile_data_id << "] IS NOT NULL);";
+    const auto statement = connection->PrepareStatement(string_stream.str());
+    statement->BindInt64(1, offset);
+    connection->Execute(statement.get());
+}
+
+std::vector<imgdoc2::dbIndex> DocumentImport::CreateBlobsMapTable(IDbConnection* connection) const
+{
+    vector<dbIndex> chunked_brick_blobs;
+    const auto& names = this->source_names_;
+    if (names.blob_table.empty())
+    {
+        return chunked_brick_blobs;
+    }
+
+    // first, we gather the blobs referenced by the selected tiles-data rows - and for a chunked brick, the blobs
+    //  referenced by the chunk index
+    connection->Execute((string("CREATE TEMP TABLE [") + kSelectedBlobsTable + "]([Pk] INTEGER PRIMARY KEY);").c_str());
+    ostringstream string_stream;
+    string_stream << "INSERT OR IGNORE INTO [temp].[" << kSelectedBlobsTable << "]([Pk]) SELECT s.[" << names.tiles_data_bin_data_id << "] "
+        << "FROM [" << kSourceSchemaName << "].[" << names.tiles_data_table << "] s INNER JOIN [temp].[" << kMapTableTilesData << "] m ON m.[OldPk]=s.[" << names.tiles_data_pk << "] "
+        << "WHERE s.[" << names.tiles_data_bin_data_id << "] IS NOT NULL;";
+    connection->Execute(string_stream.str().c_str());
+
+    string_stream.str("");
+    string_stream << "SELECT b.[" << names.blob_pk << "],b.[" << names.blob_data << "] FROM [" << kSourceSchemaName << "].[" << names.tiles_data_table << "] s "
+        << "INNER JOIN [temp].[" << kMapTableTilesData << "] m ON m.[OldPk]=s.[" << names.tiles_data_pk << "] "
+        << "INNER JOIN [" << kSourceSchemaName << "].[" << names.blob_table << "] b ON b.[" << names.blob_pk << "]=s.[" << names.tiles_data_bin_data_id << "] "
+        << "WHERE s.[" << names.tiles_data_data_type << "]=?1;";
+    const auto chunked_bricks_statement = connection->PrepareStatement(string_stream.str());
+    chunked_bricks_statement->BindInt32(1, static_cast<int>(DataTypes::UNCOMPRESSED_CHUNKED_BRICK));
+    const auto insert_statement = connection->PrepareStatement(string("INSERT OR IGNORE INTO [temp].[") + kSelectedBlobsTable + "]([Pk]) VALUES(?1);");
+    while (connection->StepStatement(chunked_bricks_statement.get()))
+    {
+        chunked_brick_blobs.push_back(chunked_bricks_statement->GetResultInt64(0));
+        BlobOutputOnHeap chunk_index_data;
+        chunked_bricks_statement->GetResultBlob(1, &chunk_index_data);
+        const auto chunk_index = BrickChunkIndex::Parse(chunk_index_data.GetDataC(), chunk_index_data.GetSizeOfData());
+        for (const auto chunk_blob_pk : chunk_index.chunk_blob_keys)
+        {
+            insert_statement->Reset();
+            insert_statement->BindInt64(1, chunk_blob_pk);
+            connection->Execute(insert_statement.get());
+        }
+    }
+
+    if (this->names_.blob_table.empty())
+    {
+        const auto count_statement = connection->PrepareStatement(string("SELECT COUNT(*) FROM [temp].[") + kSelectedBlobsTable + "];");
+        if (connection->StepStatement(count_statement.get()) && count_statement->GetResultInt64(0) > 0)
+        {
+            throw invalid_operation_exception("The destination document has no blob-table, so tiles with data cannot be imported.");
+        }
+
+        return chunked_brick_blobs;
+    }
+
+    const dbIndex offset = DocumentImport::GetMaxPrimaryKey(connection, "[" + this->names_.blob_table + "]", this->names_.blob_pk);
+    connection->Execute((string("CREATE TEMP TABLE [") + kMapTableBlobs + "]([OldPk] INTEGER PRIMARY KEY, [NewPk] INTEGER NOT NULL);").c_str());
+    const auto statement = connection->PrepareStatement(
+        string("INSERT INTO [temp].[") + kMapTableBlobs + "]([OldPk],[NewPk]) SELECT [Pk],?1+ROW_NUMBER() OVER (ORDER BY [Pk]) FROM [temp].[" + kSelectedBlobsTable + "];");
+    statement->BindInt64(1, offset);
+    connection->Execute(statement.get());
+    return chunked_brick_blobs;
+}
+
+void DocumentImport::RewriteChunkIndices(IDbConnection* connection, const std::vector<imgdoc2::dbIndex>& chunked_brick_blobs) const
+{
+    // the chunk index of a chunked brick contains the primary keys of the chunks, so it needs to be updated
+    const auto map_statement = connection->PrepareStatement(string("SELECT [NewPk] FROM [temp].[") + kMapTableBlobs + "] WHERE [OldPk]=?1;");
+    const auto get_new_pk =
+        [&](dbIndex old_pk)->dbIndex
+    {
+        map_statement->Reset();
+        map_statement->BindInt64(1, old_pk);
+        if (!connection->StepStatement(map_statement.get()))
+        {
+            throw internal_error_exception("A blob referenced by a chunk index was not found in the map table.");
+        }
+
+        return map_statement->GetResultInt64(0);
+    };
+
+    const auto read_statement = connection->PrepareStatement("SELECT [" + this->names_.blob_data + "] FROM [" + this->names_.blob_table + "] WHERE [" + this->names_.blob_pk + "]=?1;");
+    const auto update_statement = connection->PrepareStatement("UPDATE [" + this->names_.blob_table + "] SET [" + this->names_.blob_data + "]=?2 WHERE [" + this->names_.blob_pk + "]=?1;");
+    for (const auto old_pk : chunked_brick_blobs)
+    {
+        const dbIndex new_pk = get_new_pk(old_pk);
+        read_statement->Reset();
+        read_statement->BindInt64(1, new_pk);
+        BlobOutputOnHeap chunk_index_data;
+        if (connection->StepStatement(read_statement.get()))
+        {
+            read_statement->GetResultBlob(0, &chunk_index_data);
+        }
+
+        auto chunk_index = BrickChunkIndex::Parse(chunk_index_data.GetDataC(), chunk_index_data.GetSizeOfData());
+        for (auto& chunk_blob_pk : chunk_index.chunk_blob_keys)
+        {
+            chunk_blob_pk = get_new_pk(chunk_blob_pk);
+        }
+
+        const auto serialized_chunk_index = chunk_index.Serialize();
+        update_statement->Reset();
+        update_statement->BindInt64(1, new_pk);
+        update_statement->BindBlob_Static(2, serialized_chunk_index.data(), serialized_chunk_index.size());
+        connection->Execute(update_statement.get());
+    }
+}
+
+void DocumentImport::UpdateSpatialIndex(IDbConnection* connection) const
+{
+    if (this->names_.spatial_index_table.empty())
+    {
+        return;
+    }
+
+    // we add the imported tiles to the spatial index in one go (in the order of their primary keys)
+    const auto& columns = this->names_.spatial_index_columns;
+    ostringstream string_stream;
+    string_stream << "INSERT INTO [main].[" << this->names_.spatial_index_table << "] (";
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+        string_stream << (i > 0 ? "," : "") << "[" << columns[i] << "]";
+    }
+
+    string_stream << ") SELECT t.[" << this->names_.tiles_info_pk << "],"
+        << "t.[" << this->names_.tiles_info_x << "],t.[" << this->names_.tiles_info_x << "]+t.[" << this->names_.tiles_info_w << "],"
+        << "t.[" << this->names_.tiles_info_y << "],t.[" << this->names_.tiles_info_y << "]+t.[" << this->names_.tiles_info_h << "]";
+    if (!this->names_.tiles_info_z.empty())
+    {
+        string_stream << ",t.[" << this->names_.tiles_info_z << "],t.[" << this->names_.tiles_info_z << "]+t.[" << this->names_.tiles_info_d << "]";
+    }
+
+    string_stream << " FROM [main].[" << this->names_.tiles_info_table << "] t INNER JOIN [temp].[" << kMapTableTilesInfo << "] m ON m.[NewPk]=t.[" << this->names_.tiles_info_pk << "] "
+        << "ORDER BY t.[" << this->names_.tiles_info_pk << "];";
+    connection->Execute(string_stream.str().c_str());
+}
+
+void DocumentImport::CopyMetadataAndUserProperties(IDbConnection* connection) const
+{
+    const DatabaseConfigurationCommon* configuration = this->document_->GetDataBaseConfigurationCommon();
+    const DatabaseConfigurationCommon* source_configuration = this->source_document_->GetDataBaseConfigurationCommon();
+    if (configuration->GetHasMetadataTable() && source_configuration->GetHasMetadataTable())
+    {
+        // the destination is a newly created document, so we can keep the primary keys (and the references to the parent items)
+        const string table_name = configuration->GetTableNameForMetadataTableOrThrow();
+        ostringstream columns;
+        bool first = true;
+        for (const auto& column : DocumentImport::GetColumnNames(connection, table_name))
+        {
+            columns << (first ? "" : ",") << "[" << column << "]";
+            first = false;
+        }
+
+        ostringstream string_stream;
+        string_stream << "INSERT INTO [main].[" << table_name << "](" << columns.str() << ") SELECT " << columns.str()
+            << " FROM [" << kSourceSchemaName << "].[" << source_configuration->GetTableNameForMetadataTableOrThrow() << "];";
+        connection->Execute(string_stream.str().c_str());
+    }
+
+    const string key_column = configuration->GetColumnNameOfGeneralInfoTableOrThrow(DatabaseConfigurationCommon::kGeneralInfoTable_Column_Key);
+    const string value_column = configuration->GetColumnNameOfGeneralInfoTableOrThrow(DatabaseConfigurationCommon::kGeneralInfoTable_Column_ValueString);
+    ostringstream string_stream;
+    string_stream << "INSERT OR REPLACE INTO [main].[" << configuration->GetTableNameForGeneralTableOrThrow() << "]([" << key_column << "],[" << value_column << "]) "
+        << "SELECT [" << source_configuration->GetColumnNameOfGeneralInfoTableOrThrow(DatabaseConfigurationCommon::kGeneralInfoTable_Column_Key) << "],"
+        << "[" << source_configuration->GetColumnNameOfGeneralInfoTableOrThrow(DatabaseConfigurationCommon::kGeneralInfoTable_Column_ValueString) << "] "
+        << "FROM [" << kSourceSchemaName << "].[" << source_configuration->GetTableNameForGeneralTableOrThrow() << "] "
+        << "WHERE substr([" << source_configuration->GetColumnNameOfGeneralInfoTableOrThrow(DatabaseConfigurationCommon::kGeneralInfoTable_Column_Key) << "],1,length(?1))=?1;";
+    const auto statement = connection->PrepareStatement(string_stream.str());
+    statement->BindString(1, DbConstants::kGeneralTable_UserPropertyKeyPrefix);
+    connection->Execute(statement.get());
+}
+
+/*static*/imgdoc2::dbIndex DocumentImport::GetMaxPrimaryKey(IDbConnection* connection, const std::string& table_name, const std::string& pk_column)
+{
+    const auto statement = connection->PrepareStatement("SELECT COALESCE(MAX([" + pk_column + "]),0) FROM " + table_name + ";");
+    if (!connection->StepStatement(statement.get()))
+    {
+        return 0;
+    }
+
+    return statement->GetResultInt64(0);
+}
+
+/*static*/void DocumentImport::CopyRows(
+    IDbConnection* connection,
+    const std::string& destination_table,
+    const std::string& source_table,
+    const std::vector<std::string>& columns,
+    const std::string& pk_column,
+    const std::string& map_table_name,
+    const std::string& foreign_key_column,
+    const std::string& foreign_key_map_table)
+{
+    ostringstream string_stream;
+    string_stream << "INSERT INTO " << destination_table << "(";
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+        string_stream << (i > 0 ? "," : "") << "[" << columns[i] << "]";
+    }
+
+    string_stream << ") SELECT ";
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+        string_stream << (i > 0 ? "," : "");
+        if (columns[i] == pk_column)
+        {
+            string_stream << "m.[NewPk]";
+        }
+        else if (columns[i] == foreign_key_column)
+        {
+            string_stream << "f.[NewPk]";
+        }
+        else
+        {
+            string_stream << "s.[" << columns[i] << "]";
+        }
+    }
+
+    string_stream << " FROM " << source_table << " s INNER JOIN [temp].[" << map_table_name << "] m ON m.[OldPk]=s.[" << pk_column << "]";
+    if (!foreign_key_column.empty())
+    {
+        string_stream << " LEFT JOIN [temp].[" << foreign_key_map_table << "] f ON f.[OldPk]=s.[" << foreign_key_column << "]";
+    }
+
+    string_stream << " ORDER BY m.[NewPk];";
+    connection->Execute(string_stream.str().c_str());
+}
+
+/*static*/std::vector<std::string> DocumentImport::GetColumnNames(IDbConnection* connection, const std::string& table_name)
+{
+    vector<string> column_names;
+    for (const auto& column_info : connection->GetTableInfo(table_name.c_str()))
+    {
+        column_names.push_back(column_info.column_name);
+    }
+
+    return column_names;
+}
@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "document.h"
+#include "documentCompaction.h"
+
+/// This class implements importing the tiles (or bricks) of another document into a document - which is the building block
+/// for merging documents and for extracting a subset of a document. The source document is attached to the database connection
+/// of the destination document, and then all operations are done inside SQLite with set-based "INSERT ... SELECT"-statements
+/// (i.e. the tiles are not decoded or re-encoded, and the data does not pass through our code). The operation is as follows:
+/// - for the selected tiles, their tiles-data rows and their blobs, a (temporary) map table is created, which maps the
+///   primary keys in the source document to new primary keys in the destination document (which follow the largest
+///   primary key in use in the destination document)
+/// - the rows are copied using those map tables (for the primary keys as well as for the foreign keys)
+/// - the chunk indices of chunked bricks (which contain the primary keys of the chunks) are rewritten
+/// - the spatial index is updated with the new tiles (in the order of their primary keys).
+class DocumentImport
+{
+private:
+    std::shared_ptr<Document> document_;
+    DocumentCompaction::TableAndColumnNames names_;
+
+    std::shared_ptr<Document> source_document_;
+    DocumentCompaction::TableAndColumnNames source_names_;
+public:
+    /// Constructor.
+    /// \param  document    The destination document.
+    explicit DocumentImport(std::shared_ptr<Document> document);
+
+    /// Imports the tiles (or bricks) of the specified document which match the specified selection.
+    /// \param  source_filename     The filename of the source document (in UTF8-encoding).
+    /// \param  selection           The selection of the tiles to be imported; if null, all tiles are imported.
+    void ImportTiles(const char* source_filename, const imgdoc2::TileSelection* selection);
+
+    /// Creates a new document (with the same configuration as the specified document) and imports the tiles (or bricks)
+    /// which match the specified selection, and the metadata (and the user properties) of the document into it.
+    /// \param  document                The source document.
+    /// \param  destination_filename    The filename of the destination (in UTF8-encoding).
+    /// \param  selection               The selection of the tiles to be copied; if null, all tiles are copied.
+    static void CreateSubsetCopy(const std::shared_ptr<Document>& document, const char* destination_filename, const imgdoc2::TileSelection* selection);
+private:
+    /// The schema-name under which the source document is attached.
+    static const char* const kSourceSchemaName;
+
+    void OpenSourceDocument(const std::string& source_filename);
+    void ThrowIfNotCompatible(const imgdoc2::TileSelection* selection) const;
+    static void ThrowIfSelectionIsInvalid(const Document& document, const imgdoc2::TileSelection* selection);
+    void ImportRows(const imgdoc2::TileSelection* selection, bool copy_metadata_and_user_properties);
+    void CreateTilesInfoMapTable(IDbConnection* connection, const imgdoc2::TileSelection* selection) const;
+    void CreateTilesDataMapTable(IDbConnection* connection) const;
+    std::vector<imgdoc2::dbIndex> CreateBlobsMapTable(IDbConnection* connection) const;
+    void RewriteChunkIndices(IDbConnection* connection, const std::vector<imgdoc2::dbIndex>& chunked_brick_blobs) const;
+    void UpdateSpatialIndex(IDbConnection* connection) const;
+    void CopyMetadataAndUserProperties(IDbConnection* connection) const;
+
+    /// Gets the largest primary key in use in the specified table (or 0 if the table is empty).
+    /// \param  connection  The database connection.
+    /// \param  table_name  Name of the table (which may be qualified with a schema-name).
+    /// \param  pk_column   The primary key column.
+    /// \returns The largest primary key.
+    static imgdoc2::dbIndex GetMaxPrimaryKey(IDbConnection* connection, const std::string& table_name, const std::string& pk_column);
+
+    /// Copies the rows of a table of the source document (for which there is an entry in the specified map table) into the
+    /// destination table, where the primary key and (optionally) a foreign key are mapped using the specified map tables.
+    /// \param  connection              The database connection.
+    /// \param  destination_table       The destination table (which may be qualified with a schema-name).
+    /// \param  source_table            The table in the source document.
+    /// \param  columns                 The columns to be copied.
+    /// \param  pk_column               The primary key column.
+    /// \param  map_table_name          Name of the map table for the primary key.
+    /// \param  foreign_key_column      The column containing a foreign key (may be empty).
+    /// \param  foreign_key_map_table   Name of the map table for the foreign key.
+    static void CopyRows(
+        IDbConnection* connection,
+        const std::string& destination_table,
+        const std::string& source_table,
+        const std::vector<std::string>& columns,
+        const std::string& pk_column,
+        const std::string& map_table_name,
+        const std::string& foreign_key_column,
+        const std::string& foreign_key_map_table);
+
+    static std::vector<std::string> GetColumnNames(IDbConnection* connection, const std::string& table_name);
+};
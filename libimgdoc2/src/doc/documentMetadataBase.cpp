@@ -150,40 +150,47 @@ int DocumentMetadataBase::BindTypeDiscriminatorAndData(
     return tokens;
 }
 
-std::shared_ptr<IDbStatement> DocumentMetadataBase::CreateQueryForNodeIdsForPath(const std::vector<std::string_view>& path_parts)
+std::shared_ptr<IDbStatement> DocumentMetadataBase::CreateQueryForNodeIdsForPaths(const std::vector<std::vector<std::string_view>>& parts_of_paths)
 {
-    ostringstream string_stream;
     const auto metadata_table_name = this->GetDocument()->GetDataBaseConfigurationCommon()->GetTableNameForMetadataTableOrThrow();
     const auto column_name_pk = this->GetDocument()->GetDataBaseConfigurationCommon()->GetColumnNameOfMetadataTableOrThrow(DatabaseConfigurationCommon::kMetadataTable_Column_Pk);
     const auto column_name_name = this->GetDocument()->GetDataBaseConfigurationCommon()->GetColumnNameOfMetadataTableOrThrow(DatabaseConfigurationCommon::kMetadataTable_Column_Name);
     const auto column_name_ancestor_id = this->GetDocument()->GetDataBaseConfigurationCommon()->GetColumnNameOfMetadataTableOrThrow(DatabaseConfigurationCommon::kMetadataTable_Column_AncestorId);
 
-    if (path_parts.size() > 1)
+    // The query is constructed like this:
+    // - the parts of all paths are given as a table "parts(path_no, level, name)" (with the names being bound as parameters)
+    // - starting with the nodes at level 1 (i.e. nodes without ancestor), we then recursively look for the node which has the
+    //    node found in the previous step as ancestor and the name of the next part of the path
+    // Note that every step is a lookup with "name" and "ancestor-id" - for which there is an index (due to the UNIQUE-constraint
+    //  on those columns). The result gives the primary key of the node for each path and each level which could be resolved.
+    ostringstream string_stream;
+    string_stream << "WITH RECURSIVE parts(path_no, level, name) AS (VALUES ";
+    bool first_part = true;
+    for (size_t path_no = 0; path_no < parts_of_paths.size(); ++path_no)
     {
-        string_stream << "WITH RECURSIVE paths(id, name, level) AS( " <<
-            "SELECT " << column_name_pk << "," << column_name_name << ",1 FROM [" << metadata_table_name << "] WHERE " << column_name_ancestor_id << " IS NULL AND " << column_name_name << "=? " <<
-            "UNION " <<
-            "SELECT " << metadata_table_name << "." << column_name_pk << ", " << metadata_table_name << "." << column_name_name << ",  level + 1 " <<
-            "FROM [" << metadata_table_name << "] JOIN paths WHERE " << metadata_table_name << "." << column_name_ancestor_id << "=paths.id AND " <<
-            "CASE level ";
-
-        for (size_t i = 1; i < path_parts.size(); i++)
+        if (parts_of_paths[path_no].empty())
         {
-            string_stream << "WHEN " << i << " THEN " << metadata_table_name << "." << column_name_name << "=? ";
+            throw invalid_argument_exception("The path must contain at least one part");
         }
 
-        string_stream << "END) " <<
-            "SELECT id FROM paths;";
-    }
-    else if (path_parts.size() == 1)
-    {
-        string_stream << "SELECT " << column_name_pk << " FROM " << metadata_table_name << " WHERE " << column_name_ancestor_id << " IS NULL AND " << column_name_name << "=?;";
-    }
-    else
-    {
-        throw invalid_argument_exception("The path must contain at least one part");
+        for (size_t level = 1; level <= parts_of_paths[path_no].size(); ++level)
+        {
+            string_stream << (first_part ? "" : ",") << "(" << path_no << "," << level << ",?)";
+            first_part = false;
+        }
     }
 
+    string_stream << "), " <<
+        "nodes(path_no, level, id) AS (" <<
+        "SELECT parts.path_no, 1, [" << metadata_table_name << "].[" << column_name_pk << "] FROM parts JOIN [" << metadata_table_name << "] ON " <<
+        "[" << metadata_table_name << "].[" << column_name_ancestor_id << "] IS NULL AND [" << metadata_table_name << "].[" << column_name_name << "]=parts.name " <<
+        "WHERE parts.level=1 " <<
+        "UNION ALL " <<
+        "SELECT nodes.path_no, nodes.level+1, [" << metadata_table_name << "].[" << column_name_pk << "] FROM nodes " <<
+        "JOIN parts ON parts.path_no=nodes.path_no AND parts.level=nodes.level+1 " <<
+        "JOIN [" << metadata_table_name << "] ON [" << metadata_table_name << "].[" << column_name_ancestor_id << "]=nodes.id AND [" << metadata_table_name << "].[" << column_name_name << "]=parts.name) " <<
+        "SELECT path_no, level, id FROM nodes;";
+
     auto statement = this->document_->GetDatabase_connection()->PrepareStatement(string_stream.str());
     return statement;
 }
@@ -213,31 +220,138 @@ std::vector<imgdoc2::dbIndex> DocumentMetadataBase::GetNodeIdsForPath(const std:
         *count_of_parts_in_path = tokens.size();
     }
 
-    return this->GetNodeIdsForPathParts(tokens);
+    const uint32_t data_version = this->document_->GetDatabase_connection()->GetDataVersion();
+    std::vector<imgdoc2::dbIndex> node_ids;
+    if (this->document_->GetMetadataPathCache().TryGet(path, data_version, &node_ids))
+    {
+        return node_ids;
+    }
+
+    node_ids = this->GetNodeIdsForPathParts(tokens);
+    this->AddToPathCacheIfApplicable(path, data_version, tokens.size(), node_ids);
+    return node_ids;
+}
+
+std::vector<std::vector<imgdoc2::dbIndex>> DocumentMetadataBase::GetNodeIdsForPaths(const std::vector<std::string>& paths, std::vector<size_t>* count_of_parts_in_paths)
+{
+    std::vector<std::vector<imgdoc2::dbIndex>> node_ids_for_paths(paths.size());
+    std::vector<std::vector<std::string_view>> parts_of_paths(paths.size());
+    std::vector<size_t> paths_to_be_queried;
+
+    const uint32_t data_version = this->document_->GetDatabase_connection()->GetDataVersion();
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        // an empty string means "the root" (as in GetNodeIdsForPath), for which there is nothing to resolve
+        if (paths[i].empty())
+        {
+            continue;
+        }
+
+        if (paths[i][0] == DocumentMetadataBase::kPathDelimiter_)
+        {
+            throw invalid_path_exception("The path must not start with a slash");
+        }
+
+        parts_of_paths[i] = DocumentMetadataBase::SplitPath(paths[i]);
+        if (!this->document_->GetMetadataPathCache().TryGet(paths[i], data_version, &node_ids_for_paths[i]))
+        {
+            paths_to_be_queried.push_back(i);
+        }
+    }
+
+    // now resolve the paths which are not in the cache, where we put as many paths into one query as
+    //  the limit "kMaxNumberOfPathPartsPerQuery" allows
+    size_t index_of_next_path = 0;
+    while (index_of_next_path < paths_to_be_queried.size())
+    {
+        std::vector<std::vector<std::string_view>> parts_of_paths_for_query;
+        size_t number_of_parts_in_query = 0;
+        while (index_of_next_path < paths_to_be_queried.size())
+        {
+            const auto& parts = parts_of_paths[paths_to_be_queried[index_of_next_path]];
+            if (!parts_of_paths_for_query.empty() && number_of_parts_in_query + parts.size() > DocumentMetadataBase::kMaxNumberOfPathPartsPerQuery)
+            {
+                break;
+            }
+
+            parts_of_paths_for_query.push_back(parts);
+            number_of_parts_in_query += parts.size();
+            ++index_of_next_path;
+        }
+
+        auto result_of_query = this->QueryNodeIdsForPaths(parts_of_paths_for_query);
+        const size_t index_of_first_path_in_query = index_of_next_path - parts_of_paths_for_query.size();
+        for (size_t i = 0; i < result_of_query.size(); ++i)
+        {
+            const size_t path_index = paths_to_be_queried[index_of_first_path_in_query + i];
+            node_ids_for_paths[path_index] = std::move(result_of_query[i]);
+            this->AddToPathCacheIfApplicable(paths[path_index], data_version, parts_of_paths[path_index].size(), node_ids_for_paths[path_index]);
+        }
+    }
+
+    if (count_of_parts_in_paths != nullptr)
+    {
+        count_of_parts_in_paths->clear();
+        count_of_parts_in_paths->reserve(paths.size());
+        for (const auto& parts : parts_of_paths)
+        {
+            count_of_parts_in_paths->push_back(parts.size());
+        }
+    }
+
+    return node_ids_for_paths;
 }
 
 std::vector<imgdoc2::dbIndex> DocumentMetadataBase::GetNodeIdsForPathParts(const std::vector<std::string_view>& parts)
 {
-    const auto statement = this->CreateQueryForNodeIdsForPath(parts);
+    auto result = this->QueryNodeIdsForPaths({ parts });
+    return std::move(result[0]);
+}
+
+std::vector<std::vector<imgdoc2::dbIndex>> DocumentMetadataBase::QueryNodeIdsForPaths(const std::vector<std::vector<std::string_view>>& parts_of_paths)
+{
+    const auto statement = this->CreateQueryForNodeIdsForPaths(parts_of_paths);
 
     // TODO(JBl) : The binding currently is making a copy of the string. This is not necessary, we could use a "STATIC" binding
     //              if we ensure that the string is not deleted before the statement is executed.
-    for (size_t i = 0; i < parts.size(); i++)
+    int binding_index = 1;
+    for (const auto& parts : parts_of_paths)
     {
-        statement->BindStringView(gsl::narrow<int>(i + 1), parts[i]);
+        for (const auto& part : parts)
+        {
+            statement->BindStringView(binding_index++, part);
+        }
     }
 
-    std::vector<imgdoc2::dbIndex> result;
-    result.reserve(parts.size());
+    std::vector<std::vector<imgdoc2::dbIndex>> result(parts_of_paths.size());
     while (this->document_->GetDatabase_connection()->StepStatement(statement.get()))
     {
-        const imgdoc2::dbIndex index = statement->GetResultInt64(0);
-        result.push_back(index);
+        const auto path_no = gsl::narrow<size_t>(statement->GetResultInt64(0));
+        const auto level = gsl::narrow<size_t>(statement->GetResultInt64(1));
+        const imgdoc2::dbIndex index = statement->GetResultInt64(2);
+
+        // note: the levels which could be resolved are always "1 to n", so after all rows are processed, the size of
+        //  the vector is the number of levels which could be resolved
+        auto& node_ids = result[path_no];
+        if (node_ids.size() < level)
+        {
+            node_ids.resize(level);
+        }
+
+        node_ids[level - 1] = index;
     }
 
     return result;
 }
 
+void DocumentMetadataBase::AddToPathCacheIfApplicable(const std::string& path, std::uint32_t data_version, size_t count_of_parts_in_path, const std::vector<imgdoc2::dbIndex>& node_ids)
+{
+    if (node_ids.size() == count_of_parts_in_path && !this->document_->GetDatabase_connection()->IsTransactionPending())
+    {
+        this->document_->GetMetadataPathCache().Add(path, data_version, node_ids);
+    }
+}
+
 bool DocumentMetadataBase::TryMapPathAndGetTerminalNode(const std::string& path, std::optional<imgdoc2::dbIndex>* terminal_node_id)
 {
     size_t count_of_parts_in_path;
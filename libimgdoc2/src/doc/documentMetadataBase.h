@@ -52,6 +52,8 @@ protected:
     /// a part cannot be found, then the query stops at this point (and the vector returned contains less
     /// elements than the number of parts in the path). So, only if the complete path can be resolved, the
     /// size of the returned vector is equal to the number of parts in the path.
+    /// Completely resolved paths are stored in the metadata-path-cache of the document, and subsequent requests
+    /// for the same path are then served from the cache.
     ///
     /// \param          path                    The path to be mapped.
     /// \param [in,out] count_of_parts_in_path  If non-null, the parts as determined by the path string.
@@ -59,6 +61,22 @@ protected:
     /// \returns    The primary keys of the nodes which could be mapped.
     std::vector<imgdoc2::dbIndex> GetNodeIdsForPath(const std::string& path, size_t* count_of_parts_in_path);
 
+    /// This is the "batch version" of GetNodeIdsForPath - the specified paths are mapped, where all paths which
+    /// cannot be served from the metadata-path-cache are resolved together with a single query (or - if there are
+    /// very many of them - with a small number of queries).
+    ///
+    /// \param          paths                       The paths to be mapped.
+    /// \param [in,out] count_of_parts_in_paths     If non-null, the number of parts of each path is put here.
+    ///
+    /// \returns    For each path, the primary keys of the nodes which could be mapped.
+    std::vector<std::vector<imgdoc2::dbIndex>> GetNodeIdsForPaths(const std::vector<std::string>& paths, std::vector<size_t>* count_of_parts_in_paths);
+
+    /// Query the database for the primary keys of the nodes on the path given by the specified parts. The
+    /// metadata-path-cache is not used here.
+    ///
+    /// \param  parts   The parts of the path.
+    ///
+    /// \returns    The primary keys of the nodes which could be mapped.
     std::vector<imgdoc2::dbIndex> GetNodeIdsForPathParts(const std::vector<std::string_view>& parts);
 
     bool TryMapPathAndGetTerminalNode(const std::string& path, std::optional<imgdoc2::dbIndex>* terminal_node_id);
@@ -75,5 +93,20 @@ protected:
 
     bool CheckIfItemExists(imgdoc2::dbIndex primary_key);
 private:
-    std::shared_ptr<IDbStatement> CreateQueryForNodeIdsForPath(const std::vector<std::string_view>& path_parts);
+    /// The maximum number of path-parts for which the nodes are resolved with one query (in GetNodeIdsForPaths).
+    static constexpr size_t kMaxNumberOfPathPartsPerQuery = 500;
+
+    /// Query the database for the primary keys of the nodes on the paths given by the specified parts, which
+    /// is done with a single query.
+    ///
+    /// \param  parts_of_paths  For each path, its parts.
+    ///
+    /// \returns    For each path, the primary keys of the nodes which could be mapped.
+    std::vector<std::vector<imgdoc2::dbIndex>> QueryNodeIdsForPaths(const std::vector<std::vector<std::string_view>>& parts_of_paths);
+
+    std::shared_ptr<IDbStatement> CreateQueryForNodeIdsForPaths(const std::vector<std::vector<std::string_view>>& parts_of_paths);
+
+    /// Adds the specified path to the metadata-path-cache - if it is completely resolved and no transaction is pending
+    /// (since the content of a pending transaction may be rolled back).
+    void AddToPathCacheIfApplicable(const std::string& path, std::uint32_t data_version, size_t count_of_parts_in_path, const std::vector<imgdoc2::dbIndex>& node_ids);
 };
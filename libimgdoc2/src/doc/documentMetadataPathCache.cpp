@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include "documentMetadataPathCache.h"
+
+using namespace std;
+using namespace imgdoc2;
+
+DocumentMetadataPathCache::DocumentMetadataPathCache(size_t max_number_of_entries) :
+    max_number_of_entries_(max_number_of_entries)
+{
+}
+
+bool DocumentMetadataPathCache::TryGet(std::string_view path, std::uint32_t data_version, std::vector<imgdoc2::dbIndex>* node_ids)
+{
+    const lock_guard<mutex> lock(this->mutex_);
+    this->ClearIfDataVersionDiffers(data_version);
+
+    const auto iterator = this->map_path_to_entry_.find(path);
+    if (iterator == this->map_path_to_entry_.end())
+    {
+        return false;
+    }
+
+    // move the entry to the front of the list (marking it as "most recently used")
+    this->entries_.splice(this->entries_.begin(), this->entries_, iterator->second);
+    if (node_ids != nullptr)
+    {
+        *node_ids = iterator->second->second;
+    }
+
+    return true;
+}
+
+void DocumentMetadataPathCache::Add(std::string_view path, std::uint32_t data_version, std::vector<imgdoc2::dbIndex> node_ids)
+{
+    if (this->max_number_of_entries_ == 0)
+    {
+        return;
+    }
+
+    const lock_guard<mutex> lock(this->mutex_);
+    this->ClearIfDataVersionDiffers(data_version);
+
+    const auto iterator = this->map_path_to_entry_.find(path);
+    if (iterator != this->map_path_to_entry_.end())
+    {
+        iterator->second->second = std::move(node_ids);
+        this->entries_.splice(this->entries_.begin(), this->entries_, iterator->second);
+        return;
+    }
+
+    if (this->entries_.size() >= this->max_number_of_entries_)
+    {
+        this->map_path_to_entry_.erase(this->entries_.back().first);
+        this->entries_.pop_back();
+    }
+
+    this->entries_.emplace_front(string(path), std::move(node_ids));
+    this->map_path_to_entry_.emplace(this->entries_.front().first, this->entries_.begin());
+}
+
+void DocumentMetadataPathCache::Clear()
+{
+    const lock_guard<mutex> lock(this->mutex_);
+    this->map_path_to_entry_.clear();
+    this->entries_.clear();
+}
+
+size_t DocumentMetadataPathCache::GetNumberOfEntries() const
+{
+    const lock_guard<mutex> lock(this->mutex_);
+    return this->entries_.size();
+}
+
+void DocumentMetadataPathCache::ClearIfDataVersionDiffers(std::uint32_t data_version)
+{
+    if (this->data_version_ != data_version)
+    {
+        this->map_path_to_entry_.clear();
+        this->entries_.clear();
+        this->data_version_ = data_version;
+    }
+}
@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <imgdoc2.h>
+
+/// This class implements a (bounded) cache which maps a metadata-path to the primary keys of the nodes on this path.
+/// Only completely resolved paths are stored. When the maximum number of entries is reached, the least recently used
+/// entry is evicted. The cache is tagged with the "data version" of the database (c.f. IDbConnection::GetDataVersion) -
+/// if a lookup or an insertion is done with a different data version, then the cache is cleared first. This takes care
+/// of modifications which have been committed; modifications which are done inside a pending transaction must be dealt
+/// with by calling "Clear" explicitly.
+/// The methods of this class are thread-safe.
+class DocumentMetadataPathCache
+{
+public:
+    /// The default for the maximum number of entries in the cache.
+    static constexpr size_t kDefaultMaxNumberOfEntries = 4096;
+private:
+    using CacheEntry = std::pair<std::string, std::vector<imgdoc2::dbIndex>>;
+
+    size_t max_number_of_entries_;
+    std::uint32_t data_version_{ 0 };
+    std::list<CacheEntry> entries_;     ///< The entries, the most recently used entry is at the front.
+    std::unordered_map<std::string_view, std::list<CacheEntry>::iterator> map_path_to_entry_;   ///< The key here points to the string in the list-element.
+    mutable std::mutex mutex_;
+public:
+    explicit DocumentMetadataPathCache(size_t max_number_of_entries = kDefaultMaxNumberOfEntries);
+
+    DocumentMetadataPathCache(const DocumentMetadataPathCache&) = delete;
+    DocumentMetadataPathCache& operator=(const DocumentMetadataPathCache&) = delete;
+
+    /// Attempts to get the primary keys of the nodes on the specified path from the cache.
+    ///
+    /// \param          path            The path.
+    /// \param          data_version    The current data version of the database.
+    /// \param [out]    node_ids        If non-null and successful, the primary keys of the nodes on the path are put here.
+    ///
+    /// \returns    True if the path was found in the cache; false otherwise.
+    bool TryGet(std::string_view path, std::uint32_t data_version, std::vector<imgdoc2::dbIndex>* node_ids);
+
+    /// Adds the (completely resolved) path to the cache.
+    ///
+    /// \param  path            The path.
+    /// \param  data_version    The data version of the database at the time the path has been resolved.
+    /// \param  node_ids        The primary keys of the nodes on the path.
+    void Add(std::string_view path, std::uint32_t data_version, std::vector<imgdoc2::dbIndex> node_ids);
+
+    /// Removes all entries from the cache.
+    void Clear();
+
+    /// Gets the number of entries currently in the cache.
+    ///
+    /// \returns    The number of entries.
+    [[nodiscard]] size_t GetNumberOfEntries() const;
+private:
+    void ClearIfDataVersionDiffers(std::uint32_t data_version);
+};
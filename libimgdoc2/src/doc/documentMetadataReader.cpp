@@ -76,6 +76,29 @@ using namespace imgdoc2;
     throw invalid_path_exception(string_stream.str());
 }
 
+/*virtual*/std::vector<std::optional<imgdoc2::DocumentMetadataItem>> DocumentMetadataReader::GetItemsForPaths(const std::vector<std::string>& paths, imgdoc2::DocumentMetadataItemFlags flags)
+{
+    vector<size_t> count_of_parts_in_paths;
+    const auto node_ids_for_paths = this->GetNodeIdsForPaths(paths, &count_of_parts_in_paths);
+
+    vector<optional<DocumentMetadataItem>> items;
+    items.reserve(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        // note: as with "GetItemForPath", an empty path (i.e. the "root") does not identify an item
+        if (count_of_parts_in_paths[i] > 0 && node_ids_for_paths[i].size() == count_of_parts_in_paths[i])
+        {
+            items.emplace_back(this->GetItem(node_ids_for_paths[i].back(), flags));
+        }
+        else
+        {
+            items.emplace_back(nullopt);
+        }
+    }
+
+    return items;
+}
+
 void DocumentMetadataReader::EnumerateItems(
   std::optional<imgdoc2::dbIndex> parent,
   bool recursive,
@@ -7,6 +7,8 @@
 #include <memory>
 #include <utility>
 #include <string>
+#include <vector>
+#include <optional>
 #include "IDocumentMetadata.h"
 #include "document.h"
 #include "documentMetadataBase.h"
@@ -21,6 +23,7 @@ public:
 
     imgdoc2::DocumentMetadataItem GetItem(imgdoc2::dbIndex primary_key, imgdoc2::DocumentMetadataItemFlags flags) override;
     imgdoc2::DocumentMetadataItem GetItemForPath(const std::string& path, imgdoc2::DocumentMetadataItemFlags flags) override;
+    std::vector<std::optional<imgdoc2::DocumentMetadataItem>> GetItemsForPaths(const std::vector<std::string>& paths, imgdoc2::DocumentMetadataItemFlags flags) override;
     void EnumerateItems(
       std::optional<imgdoc2::dbIndex> parent,
       bool recursive,
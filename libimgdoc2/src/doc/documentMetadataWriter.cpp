@@ -55,7 +55,14 @@ imgdoc2::dbIndex DocumentMetadataWriter::UpdateOrCreateItemForPath(
             const IDocumentMetadata::metadata_item_variant& value)
 {
     const auto path_parts = this->SplitPath(path);
-    auto pk_of_nodes_on_path = this->GetNodeIdsForPathParts(path_parts);
+    auto pk_of_nodes_on_path = this->GetNodeIdsForPath(path, nullptr);
+
+    // If the node itself already exists, then its primary key is the last element - we are only interested in the
+    // nodes on the path leading to it (the last of which is the parent of the node).
+    if (pk_of_nodes_on_path.size() == path_parts.size())
+    {
+        pk_of_nodes_on_path.pop_back();
+    }
 
     // If the size of the "pks of nodes on path" is smaller than the size of the path parts, then we 
     // need to create the missing nodes. Or - only if the caller requested it - we need to create the missing nodes.
@@ -92,6 +99,13 @@ uint64_t DocumentMetadataWriter::DeleteItem(
     if (statement)
     {
         this->GetDocument()->GetDatabase_connection()->Execute(statement.get(), &number_of_modified_rows);
+
+        // If a transaction is pending, the data version of the database does not change, so we have to invalidate
+        //  the path-cache explicitly here (the deleted nodes might be cached).
+        if (number_of_modified_rows > 0)
+        {
+            this->GetDocument()->GetMetadataPathCache().Clear();
+        }
     }
 
     return gsl::narrow_cast<uint64_t>(number_of_modified_rows);
@@ -63,6 +63,11 @@ using namespace imgdoc2;
            this->GetDocument()->GetDataBaseConfiguration2d()->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration2D::kTilesInfoTable_Column_PyramidLevel));
 }
 
+/*virtual*/bool DocumentRead2d::TryGetUserProperty(const std::string& key, std::string* value)
+{
+    return this->GetDocument()->TryReadUserProperty(key, value);
+}
+
 /*virtual*/void DocumentRead2d::ReadTileInfo(imgdoc2::dbIndex idx, imgdoc2::ITileCoordinateMutate* coordinate, imgdoc2::LogicalPositionInfo* info, imgdoc2::TileBlobInfo* tile_blob_info)
 {
     const auto query_statement = this->GetReadTileInfo_Statement(coordinate != nullptr, info != nullptr, tile_blob_info != nullptr);
@@ -146,7 +151,7 @@ using namespace imgdoc2;
 /*virtual*/void DocumentRead2d::ReadTileData(imgdoc2::dbIndex idx, imgdoc2::IBlobOutput* data)
 {
     // TODO(JBL): if following the idea of a "plug-able blob-storage component", then this operation would be affected.
-    const shared_ptr<IDbStatement> query_statement = this->GetReadDataQueryStatement(idx);
+    const shared_ptr<IDbStatement> query_statement = this->GetReadDataQueryStatement(idx, false);
 
     // TODO(JBL): - we expect one and only one result, should raise an error otherwise
     //       - also, we need to report if no result is found
@@ -171,6 +176,87 @@ using namespace imgdoc2;
     }
 }
 
+/*virtual*/std::uint64_t DocumentRead2d::GetTileDataSize(imgdoc2::dbIndex idx)
+{
+    const shared_ptr<IDbStatement> query_statement = this->GetReadDataQueryStatement(idx, true);
+    if (!this->GetDocument()->GetDatabase_connection()->StepStatement(query_statement.get()))
+    {
+        ostringstream ss;
+        ss << "Request for the size of the tiledata for an non-existing tile (with pk=" << idx << ")";
+        throw non_existing_tile_exception(ss.str(), idx);
+    }
+
+    // if there is no blob, the result is null (which is reported as 0)
+    return static_cast<uint64_t>(query_statement->GetResultInt64(0));
+}
+
+/*virtual*/bool DocumentRead2d::TryReadTileStatistics(imgdoc2::dbIndex idx, imgdoc2::TileStatistics* statistics)
+{
+    return this->TryReadTileStatisticsInternal(this->GetTilesInfoForStatistics(), idx, statistics);
+}
+
+/*virtual*/imgdoc2::TileStatisticsSummary DocumentRead2d::GetTileStatisticsSummary(const imgdoc2::RectangleD* rect, const imgdoc2::IDimCoordinateQueryClause* coordinate_clause, const imgdoc2::ITileInfoQueryClause* tileinfo_clause)
+{
+    const auto& configuration = this->GetDocument()->GetDataBaseConfiguration2d();
+    ostringstream string_stream;
+    if (rect != nullptr)
+    {
+        if (configuration->GetIsUsingSpatialIndex())
+        {
+            string_stream << "[" << configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration2D::kTilesInfoTable_Column_Pk) << "] IN (SELECT "
+                << configuration->GetColumnNameOfTilesSpatialIndexTableOrThrow(DatabaseConfiguration2D::kTilesSpatialIndexTable_Column_Pk) << " FROM "
+                << configuration->GetTableNameForTilesSpatialIndexTableOrThrow() << " WHERE "
+                << configuration->GetColumnNameOfTilesSpatialIndexTableOrThrow(DatabaseConfiguration2D::kTilesSpatialIndexTable_Column_MaxX) << ">=? AND "
+                << configuration->GetColumnNameOfTilesSpatialIndexTableOrThrow(DatabaseConfiguration2D::kTilesSpatialIndexTable_Column_MinX) << "<=? AND "
+                << configuration->GetColumnNameOfTilesSpatialIndexTableOrThrow(DatabaseConfiguration2D::kTilesSpatialIndexTable_Column_MaxY) << ">=? AND "
+                << configuration->GetColumnNameOfTilesSpatialIndexTableOrThrow(DatabaseConfiguration2D::kTilesSpatialIndexTable_Column_MinY) << "<=?)";
+        }
+        else
+        {
+            string_stream << "(" <<
+                configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration2D::kTilesInfoTable_Column_TileX) << '+' <<
+                configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration2D::kTilesInfoTable_Column_TileW) << ">=? AND " <<
+                configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration2D::kTilesInfoTable_Column_TileX) << "<=? AND " <<
+                configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration2D::kTilesInfoTable_Column_TileY) << '+' <<
+                configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration2D::kTilesInfoTable_Column_TileH) << ">=? AND " <<
+                configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration2D::kTilesInfoTable_Column_TileY) << "<=?)";
+        }
+
+        string_stream << " AND ";
+    }
+
+    const auto query_statement_and_binding_info = Utilities::CreateWhereStatement(coordinate_clause, tileinfo_clause, *configuration);
+    string_stream << get<0>(query_statement_and_binding_info);
+
+    return this->GetTileStatisticsSummaryInternal(
+        this->GetTilesInfoForStatistics(),
+        string_stream.str(),
+        [&](IDbStatement* statement)->void
+        {
+            int binding_index = 1;
+            if (rect != nullptr)
+            {
+                statement->BindDouble(binding_index++, rect->x);
+                statement->BindDouble(binding_index++, rect->x + rect->w);
+                statement->BindDouble(binding_index++, rect->y);
+                statement->BindDouble(binding_index++, rect->y + rect->h);
+            }
+
+            Utilities::AddDataBindInfoListToDbStatement(get<1>(query_statement_and_binding_info), statement, binding_index);
+        });
+}
+
+DocumentReadBase::TilesInfoForStatistics DocumentRead2d::GetTilesInfoForStatistics() const
+{
+    const auto& configuration = this->GetDocument()->GetDataBaseConfiguration2d();
+    return TilesInfoForStatistics
+    {
+        configuration->GetTableNameForTilesInfoOrThrow(),
+        configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration2D::kTilesInfoTable_Column_Pk),
+        configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration2D::kTilesInfoTable_Column_TileDataId)
+    };
+}
+
 shared_ptr<IDbStatement> DocumentRead2d::GetReadTileInfo_Statement(bool include_tile_coordinates, bool include_logical_position_info, bool include_tile_blob_info)
 {
     // If include_tile_blob_info is false, we create a SQL-state something like this:
@@ -384,7 +470,7 @@ std::shared_ptr<IDbStatement> DocumentRead2d::GetTilesIntersectingRectQueryAndCo
     return statement;
 }
 
-std::shared_ptr<IDbStatement> DocumentRead2d::GetReadDataQueryStatement(imgdoc2::dbIndex idx)
+std::shared_ptr<IDbStatement> DocumentRead2d::GetReadDataQueryStatement(imgdoc2::dbIndex idx, bool query_size_only)
 {
     // we create a statement like this:
     // SELECT [BLOBS].[Data]
@@ -399,10 +485,12 @@ std::shared_ptr<IDbStatement> DocumentRead2d::GetReadDataQueryStatement(imgdoc2:
     //    [BLOBS]-table, then we a result with a null
     // 
     // This allows us to distinguish between "invalid idx" and "no blob present"
+    // If only the size is requested, we select "length([BLOBS].[Data])" instead, which SQLite can determine without reading
+    //  the blob data.
 
     ostringstream string_stream;
-    string_stream << "SELECT [" << this->GetDocument()->GetDataBaseConfiguration2d()->GetTableNameForBlobTableOrThrow() << "]."
-        << "[" << this->GetDocument()->GetDataBaseConfiguration2d()->GetColumnNameOfBlobTableOrThrow(DatabaseConfiguration2D::kBlobTable_Column_Data) << "] "
+    string_stream << "SELECT " << (query_size_only ? "length(" : "") << "[" << this->GetDocument()->GetDataBaseConfiguration2d()->GetTableNameForBlobTableOrThrow() << "]."
+        << "[" << this->GetDocument()->GetDataBaseConfiguration2d()->GetColumnNameOfBlobTableOrThrow(DatabaseConfiguration2D::kBlobTable_Column_Data) << "]" << (query_size_only ? ") " : " ")
         << "FROM [" << this->GetDocument()->GetDataBaseConfiguration2d()->GetTableNameForTilesDataOrThrow() << "] LEFT JOIN [" << this->GetDocument()->GetDataBaseConfiguration2d()->GetTableNameForBlobTableOrThrow() << "] "
         << "ON [" << this->GetDocument()->GetDataBaseConfiguration2d()->GetTableNameForTilesDataOrThrow() << "].[" << this->GetDocument()->GetDataBaseConfiguration2d()->GetColumnNameOfTilesDataTableOrThrow(DatabaseConfiguration2D::kTilesDataTable_Column_BinDataId) << "]"
         << " = [" << this->GetDocument()->GetDataBaseConfiguration2d()->GetTableNameForBlobTableOrThrow() << "].[" << this->GetDocument()->GetDataBaseConfiguration2d()->GetColumnNameOfBlobTableOrThrow(DatabaseConfiguration2D::kBlobTable_Column_Pk) << "]"
@@ -24,12 +24,16 @@ public:
     void Query(const imgdoc2::IDimCoordinateQueryClause* coordinate_clause, const imgdoc2::ITileInfoQueryClause* tileinfo_clause, const std::function<bool(imgdoc2::dbIndex)>& func) override;
     void GetTilesIntersectingRect(const imgdoc2::RectangleD& rect, const imgdoc2::IDimCoordinateQueryClause* coordinate_clause, const imgdoc2::ITileInfoQueryClause* tileinfo_clause, const std::function<bool(imgdoc2::dbIndex)>& func) override;
     void ReadTileData(imgdoc2::dbIndex idx, imgdoc2::IBlobOutput* data) override;
+    std::uint64_t GetTileDataSize(imgdoc2::dbIndex idx) override;
+    bool TryReadTileStatistics(imgdoc2::dbIndex idx, imgdoc2::TileStatistics* statistics) override;
+    imgdoc2::TileStatisticsSummary GetTileStatisticsSummary(const imgdoc2::RectangleD* rect, const imgdoc2::IDimCoordinateQueryClause* coordinate_clause, const imgdoc2::ITileInfoQueryClause* tileinfo_clause) override;
 
     // interface IDocInfo
     void GetTileDimensions(imgdoc2::Dimension* dimensions, std::uint32_t& count) override;
     std::map<imgdoc2::Dimension, imgdoc2::Int32Interval> GetMinMaxForTileDimension(const std::vector<imgdoc2::Dimension>& dimensions_to_query_for) override;
     std::uint64_t GetTotalTileCount() override;
     std::map<int, std::uint64_t> GetTileCountPerLayer() override;
+    bool TryGetUserProperty(const std::string& key, std::string* value) override;
 
     // interface IDocInfo2d
     void GetTilesBoundingBox(imgdoc2::DoubleInterval* bounds_x, imgdoc2::DoubleInterval* bounds_y) override;
@@ -40,9 +44,10 @@ private:
     std::shared_ptr<IDbStatement> GetTilesIntersectingRectQuery(const imgdoc2::RectangleD& rect);
     std::shared_ptr<IDbStatement> GetTilesIntersectingRectQueryAndCoordinateAndInfoQueryClauseWithSpatialIndex(const imgdoc2::RectangleD& rect, const imgdoc2::IDimCoordinateQueryClause* coordinate_clause, const imgdoc2::ITileInfoQueryClause* tileinfo_clause);
     std::shared_ptr<IDbStatement> GetTilesIntersectingRectQueryAndCoordinateAndInfoQueryClause(const imgdoc2::RectangleD& rect, const imgdoc2::IDimCoordinateQueryClause* coordinate_clause, const imgdoc2::ITileInfoQueryClause* tileinfo_clause);
-    std::shared_ptr<IDbStatement> GetReadDataQueryStatement(imgdoc2::dbIndex idx);
+    std::shared_ptr<IDbStatement> GetReadDataQueryStatement(imgdoc2::dbIndex idx, bool query_size_only);
 
     std::shared_ptr<IDbStatement> CreateQueryMinMaxStatement(const std::vector<imgdoc2::Dimension>& dimensions);
 
     std::shared_ptr<IDbStatement> CreateQueryTilesBoundingBoxStatement(bool include_x, bool include_y) const;
+    [[nodiscard]] TilesInfoForStatistics GetTilesInfoForStatistics() const;
 };
@@ -9,6 +9,7 @@
 #include <vector>
 #include <gsl/assert>
 #include "documentRead3d.h"
+#include "brickChunkIndex.h"
 #include "../db/utilities.h"
 #include "../db/sqlite/custom_functions.h"
 
@@ -150,6 +151,11 @@ using namespace imgdoc2;
         this->GetDocument()->GetDataBaseConfiguration3d()->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration3D::kTilesInfoTable_Column_PyramidLevel));
 }
 
+/*virtual*/bool DocumentRead3d::TryGetUserProperty(const std::string& key, std::string* value)
+{
+    return this->GetDocument()->TryReadUserProperty(key, value);
+}
+
 /*virtual*/void DocumentRead3d::GetBricksBoundingBox(imgdoc2::DoubleInterval* bounds_x, imgdoc2::DoubleInterval* bounds_y, imgdoc2::DoubleInterval* bounds_z)
 {
     if (bounds_x == nullptr && bounds_y == nullptr && bounds_z == nullptr)
@@ -174,7 +180,7 @@ using namespace imgdoc2;
 /*virtual*/void DocumentRead3d::ReadBrickData(imgdoc2::dbIndex idx, imgdoc2::IBlobOutput* data)
 {
     // TODO(JBL): if following the idea of a "plug-able blob-storage component", then this operation would be affected.
-    const shared_ptr<IDbStatement> query_statement = this->GetReadBrickDataQueryStatement(idx);
+    const shared_ptr<IDbStatement> query_statement = this->GetReadBrickDataQueryStatement(idx, false);
 
     // TODO(JBL): - we expect one and only one result, should raise an error otherwise
     //       - also, we need to report if no result is found
@@ -199,7 +205,248 @@ using namespace imgdoc2;
     }
 }
 
-std::shared_ptr<IDbStatement> DocumentRead3d::GetReadBrickDataQueryStatement(imgdoc2::dbIndex idx)
+/*virtual*/std::uint64_t DocumentRead3d::GetBrickDataSize(imgdoc2::dbIndex idx)
+{
+    const shared_ptr<IDbStatement> query_statement = this->GetReadBrickDataQueryStatement(idx, true);
+    if (!this->GetDocument()->GetDatabase_connection()->StepStatement(query_statement.get()))
+    {
+        ostringstream ss;
+        ss << "Request for the size of the brick-data for an non-existing brick (with pk=" << idx << ")";
+        throw non_existing_tile_exception(ss.str(), idx);
+    }
+
+    // if there is no blob, the result is null (which is reported as 0)
+    return static_cast<uint64_t>(query_statement->GetResultInt64(0));
+}
+
+/*virtual*/void DocumentRead3d::ReadBrickSubVolume(imgdoc2::dbIndex idx, const imgdoc2::CuboidI& roi, imgdoc2::IBlobOutput* data)
+{
+    if (data == nullptr)
+    {
+        throw invalid_argument_exception("The blob-output object must not be null.");
+    }
+
+    if (roi.w <= 0 || roi.h <= 0 || roi.d <= 0)
+    {
+        throw invalid_argument_exception("The sub-volume must have a non-zero extent.");
+    }
+
+    BrickBlobInfo brick_blob_info;
+    this->ReadBrickInfo(idx, nullptr, nullptr, &brick_blob_info);
+    if (roi.x < 0 || roi.y < 0 || roi.z < 0 ||
+        static_cast<int64_t>(roi.x) + roi.w > brick_blob_info.base_info.pixelWidth ||
+        static_cast<int64_t>(roi.y) + roi.h > brick_blob_info.base_info.pixelHeight ||
+        static_cast<int64_t>(roi.z) + roi.d > brick_blob_info.base_info.pixelDepth)
+    {
+        ostringstream string_stream;
+        string_stream << "The sub-volume is not contained in the brick (with pk=" << idx << ").";
+        throw invalid_argument_exception(string_stream.str().c_str());
+    }
+
+    switch (brick_blob_info.data_type)
+    {
+        case DataTypes::UNCOMPRESSED_CHUNKED_BRICK:
+            this->ReadChunkedBrickSubVolume(idx, brick_blob_info.base_info, roi, data);
+            break;
+        case DataTypes::UNCOMPRESSED_BRICK:
+        {
+            BlobOutputOnHeap brick_data;
+            this->ReadBrickData(idx, &brick_data);
+            const size_t voxel_count = static_cast<size_t>(brick_blob_info.base_info.pixelWidth) * brick_blob_info.base_info.pixelHeight * brick_blob_info.base_info.pixelDepth;
+            const size_t bytes_per_voxel = brick_data.GetHasData() ? brick_data.GetSizeOfData() / voxel_count : 0;
+            if (bytes_per_voxel == 0)
+            {
+                ostringstream string_stream;
+                string_stream << "The blob of the brick (with pk=" << idx << ") is too small.";
+                throw invalid_operation_exception(string_stream.str().c_str());
+            }
+
+            if (data->Reserve(static_cast<size_t>(roi.w) * roi.h * roi.d * bytes_per_voxel))
+            {
+                const CuboidI brick_cuboid{ 0, 0, 0, static_cast<int32_t>(brick_blob_info.base_info.pixelWidth), static_cast<int32_t>(brick_blob_info.base_info.pixelHeight), static_cast<int32_t>(brick_blob_info.base_info.pixelDepth) };
+                DocumentRead3d::CopyIntersectionToBlobOutput(brick_data.GetDataC(), brick_cuboid, roi, bytes_per_voxel, data);
+            }
+
+            break;
+        }
+        default:
+        {
+            ostringstream string_stream;
+            string_stream << "Reading a sub-volume is not supported for the data-type of the brick (with pk=" << idx << ").";
+            throw invalid_operation_exception(string_stream.str().c_str());
+        }
+    }
+}
+
+/*virtual*/bool DocumentRead3d::TryReadBrickStatistics(imgdoc2::dbIndex idx, imgdoc2::TileStatistics* statistics)
+{
+    return this->TryReadTileStatisticsInternal(this->GetTilesInfoForStatistics(), idx, statistics);
+}
+
+/*virtual*/imgdoc2::TileStatisticsSummary DocumentRead3d::GetBrickStatisticsSummary(const imgdoc2::CuboidD* cuboid, const imgdoc2::IDimCoordinateQueryClause* coordinate_clause, const imgdoc2::ITileInfoQueryClause* tileinfo_clause)
+{
+    const auto& configuration = this->GetDocument()->GetDataBaseConfiguration3d();
+    ostringstream string_stream;
+    if (cuboid != nullptr)
+    {
+        if (configuration->GetIsUsingSpatialIndex())
+        {
+            string_stream << "[" << configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration3D::kTilesInfoTable_Column_Pk) << "] IN (SELECT "
+                << configuration->GetColumnNameOfTilesSpatialIndexTableOrThrow(DatabaseConfiguration3D::kTilesSpatialIndexTable_Column_Pk) << " FROM "
+                << configuration->GetTableNameForTilesSpatialIndexTableOrThrow() << " WHERE "
+                << configuration->GetColumnNameOfTilesSpatialIndexTableOrThrow(DatabaseConfiguration3D::kTilesSpatialIndexTable_Column_MaxX) << ">=? AND "
+                << configuration->GetColumnNameOfTilesSpatialIndexTableOrThrow(DatabaseConfiguration3D::kTilesSpatialIndexTable_Column_MinX) << "<=? AND "
+                << configuration->GetColumnNameOfTilesSpatialIndexTableOrThrow(DatabaseConfiguration3D::kTilesSpatialIndexTable_Column_MaxY) << ">=? AND "
+                << configuration->GetColumnNameOfTilesSpatialIndexTableOrThrow(DatabaseConfiguration3D::kTilesSpatialIndexTable_Column_MinY) << "<=? AND "
+                << configuration->GetColumnNameOfTilesSpatialIndexTableOrThrow(DatabaseConfiguration3D::kTilesSpatialIndexTable_Column_MaxZ) << ">=? AND "
+                << configuration->GetColumnNameOfTilesSpatialIndexTableOrThrow(DatabaseConfiguration3D::kTilesSpatialIndexTable_Column_MinZ) << "<=?)";
+        }
+        else
+        {
+            string_stream << "(" <<
+                configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration3D::kTilesInfoTable_Column_TileX) << '+' <<
+                configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration3D::kTilesInfoTable_Column_TileW) << ">=? AND " <<
+                configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration3D::kTilesInfoTable_Column_TileX) << "<=? AND " <<
+                configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration3D::kTilesInfoTable_Column_TileY) << '+' <<
+                configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration3D::kTilesInfoTable_Column_TileH) << ">=? AND " <<
+                configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration3D::kTilesInfoTable_Column_TileY) << "<=? AND " <<
+                configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration3D::kTilesInfoTable_Column_TileZ) << '+' <<
+                configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration3D::kTilesInfoTable_Column_TileD) << ">=? AND " <<
+                configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration3D::kTilesInfoTable_Column_TileZ) << "<=?)";
+        }
+
+        string_stream << " AND ";
+    }
+
+    const auto query_statement_and_binding_info = Utilities::CreateWhereStatement(coordinate_clause, tileinfo_clause, *configuration);
+    string_stream << get<0>(query_statement_and_binding_info);
+
+    return this->GetTileStatisticsSummaryInternal(
+        this->GetTilesInfoForStatistics(),
+        string_stream.str(),
+        [&](IDbStatement* statement)->void
+        {
+            int binding_index = 1;
+            if (cuboid != nullptr)
+            {
+                statement->BindDouble(binding_index++, cuboid->x);
+                statement->BindDouble(binding_index++, cuboid->x + cuboid->w);
+                statement->BindDouble(binding_index++, cuboid->y);
+                statement->BindDouble(binding_index++, cuboid->y + cuboid->h);
+                statement->BindDouble(binding_index++, cuboid->z);
+                statement->BindDouble(binding_index++, cuboid->z + cuboid->d);
+            }
+
+            Utilities::AddDataBindInfoListToDbStatement(get<1>(query_statement_and_binding_info), statement, binding_index);
+        });
+}
+
+DocumentReadBase::TilesInfoForStatistics DocumentRead3d::GetTilesInfoForStatistics() const
+{
+    const auto& configuration = this->GetDocument()->GetDataBaseConfiguration3d();
+    return TilesInfoForStatistics
+    {
+        configuration->GetTableNameForTilesInfoOrThrow(),
+        configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration3D::kTilesInfoTable_Column_Pk),
+        configuration->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration3D::kTilesInfoTable_Column_TileDataId)
+    };
+}
+
+void DocumentRead3d::ReadChunkedBrickSubVolume(imgdoc2::dbIndex idx, const imgdoc2::BrickBaseInfo& brick_base_info, const imgdoc2::CuboidI& roi, imgdoc2::IBlobOutput* data)
+{
+    BlobOutputOnHeap chunk_index_data;
+    this->ReadBrickData(idx, &chunk_index_data);
+    const BrickChunkIndex chunk_index = BrickChunkIndex::Parse(chunk_index_data.GetDataC(), chunk_index_data.GetSizeOfData());
+    if (chunk_index.brick_width != brick_base_info.pixelWidth || chunk_index.brick_height != brick_base_info.pixelHeight || chunk_index.brick_depth != brick_base_info.pixelDepth)
+    {
+        ostringstream string_stream;
+        string_stream << "The chunk index of the brick (with pk=" << idx << ") does not match the extent of the brick.";
+        throw invalid_operation_exception(string_stream.str().c_str());
+    }
+
+    if (!data->Reserve(static_cast<size_t>(roi.w) * roi.h * roi.d * chunk_index.bytes_per_voxel))
+    {
+        return;
+    }
+
+    const auto query_statement = this->GetReadBlobDataQueryStatement();
+
+    // we only visit the chunks which intersect with the sub-volume, and only their blobs are read from the database
+    for (uint32_t chunk_z = roi.z / chunk_index.chunk_extent.depth; chunk_z <= (roi.z + roi.d - 1) / chunk_index.chunk_extent.depth; ++chunk_z)
+    {
+        for (uint32_t chunk_y = roi.y / chunk_index.chunk_extent.height; chunk_y <= (roi.y + roi.h - 1) / chunk_index.chunk_extent.height; ++chunk_y)
+        {
+            for (uint32_t chunk_x = roi.x / chunk_index.chunk_extent.width; chunk_x <= (roi.x + roi.w - 1) / chunk_index.chunk_extent.width; ++chunk_x)
+            {
+                const CuboidI chunk_cuboid = chunk_index.GetChunkCuboid(chunk_x, chunk_y, chunk_z);
+
+                query_statement->Reset();
+                query_statement->BindInt64(1, chunk_index.chunk_blob_keys[chunk_index.GetChunkListIndex(chunk_x, chunk_y, chunk_z)]);
+                BlobOutputOnHeap chunk_data;
+                if (this->GetDocument()->GetDatabase_connection()->StepStatement(query_statement.get()))
+                {
+                    query_statement->GetResultBlob(0, &chunk_data);
+                }
+
+                const size_t expected_chunk_size = static_cast<size_t>(chunk_cuboid.w) * chunk_cuboid.h * chunk_cuboid.d * chunk_index.bytes_per_voxel;
+                if (!chunk_data.GetHasData() || chunk_data.GetSizeOfData() < expected_chunk_size)
+                {
+                    ostringstream string_stream;
+                    string_stream << "A chunk of the brick (with pk=" << idx << ") is missing or too small.";
+                    throw invalid_operation_exception(string_stream.str().c_str());
+                }
+
+                if (!DocumentRead3d::CopyIntersectionToBlobOutput(chunk_data.GetDataC(), chunk_cuboid, roi, chunk_index.bytes_per_voxel, data))
+                {
+                    return;
+                }
+            }
+        }
+    }
+}
+
+/*static*/bool DocumentRead3d::CopyIntersectionToBlobOutput(const std::uint8_t* source, const imgdoc2::CuboidI& source_cuboid, const imgdoc2::CuboidI& roi, size_t bytes_per_voxel, imgdoc2::IBlobOutput* data)
+{
+    const int32_t x_start = max(source_cuboid.x, roi.x);
+    const int32_t x_end = min(source_cuboid.x + source_cuboid.w, roi.x + roi.w);
+    const int32_t y_start = max(source_cuboid.y, roi.y);
+    const int32_t y_end = min(source_cuboid.y + source_cuboid.h, roi.y + roi.h);
+    const int32_t z_start = max(source_cuboid.z, roi.z);
+    const int32_t z_end = min(source_cuboid.z + source_cuboid.d, roi.z + roi.d);
+    if (x_start >= x_end || y_start >= y_end || z_start >= z_end)
+    {
+        return true;
+    }
+
+    const size_t line_length = static_cast<size_t>(x_end - x_start) * bytes_per_voxel;
+    for (int32_t z = z_start; z < z_end; ++z)
+    {
+        for (int32_t y = y_start; y < y_end; ++y)
+        {
+            const size_t source_offset = ((static_cast<size_t>(z - source_cuboid.z) * source_cuboid.h + (y - source_cuboid.y)) * source_cuboid.w + (x_start - source_cuboid.x)) * bytes_per_voxel;
+            const size_t destination_offset = ((static_cast<size_t>(z - roi.z) * roi.h + (y - roi.y)) * roi.w + (x_start - roi.x)) * bytes_per_voxel;
+            if (!data->SetData(destination_offset, line_length, source + source_offset))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+std::shared_ptr<IDbStatement> DocumentRead3d::GetReadBlobDataQueryStatement()
+{
+    // we create a statement like this:
+    // SELECT [Data] FROM [BLOBS] WHERE [Pk] = ?1;
+    ostringstream string_stream;
+    string_stream << "SELECT [" << this->GetDocument()->GetDataBaseConfiguration3d()->GetColumnNameOfBlobTableOrThrow(DatabaseConfiguration3D::kBlobTable_Column_Data) << "] "
+        << "FROM [" << this->GetDocument()->GetDataBaseConfiguration3d()->GetTableNameForBlobTableOrThrow() << "] "
+        << "WHERE [" << this->GetDocument()->GetDataBaseConfiguration3d()->GetColumnNameOfBlobTableOrThrow(DatabaseConfiguration3D::kBlobTable_Column_Pk) << "] = ?1;";
+    return this->GetDocument()->GetDatabase_connection()->PrepareStatement(string_stream.str());
+}
+
+std::shared_ptr<IDbStatement> DocumentRead3d::GetReadBrickDataQueryStatement(imgdoc2::dbIndex idx, bool query_size_only)
 {
     // we create a statement like this:
     // SELECT [BLOBS].[Data]
@@ -214,10 +461,12 @@ std::shared_ptr<IDbStatement> DocumentRead3d::GetReadBrickDataQueryStatement(img
     //    [BLOBS]-table, then we a result with a null
     // 
     // This allows us to distinguish between "invalid idx" and "no blob present"
+    // If only the size is requested, we select "length([BLOBS].[Data])" instead, which SQLite can determine without reading
+    //  the blob data.
 
     ostringstream string_stream;
-    string_stream << "SELECT [" << this->GetDocument()->GetDataBaseConfiguration3d()->GetTableNameForBlobTableOrThrow() << "]."
-        << "[" << this->GetDocument()->GetDataBaseConfiguration3d()->GetColumnNameOfBlobTableOrThrow(DatabaseConfiguration3D::kBlobTable_Column_Data) << "] "
+    string_stream << "SELECT " << (query_size_only ? "length(" : "") << "[" << this->GetDocument()->GetDataBaseConfiguration3d()->GetTableNameForBlobTableOrThrow() << "]."
+        << "[" << this->GetDocument()->GetDataBaseConfiguration3d()->GetColumnNameOfBlobTableOrThrow(DatabaseConfiguration3D::kBlobTable_Column_Data) << "]" << (query_size_only ? ") " : " ")
         << "FROM [" << this->GetDocument()->GetDataBaseConfiguration3d()->GetTableNameForTilesDataOrThrow() << "] LEFT JOIN [" << this->GetDocument()->GetDataBaseConfiguration3d()->GetTableNameForBlobTableOrThrow() << "] "
         << "ON [" << this->GetDocument()->GetDataBaseConfiguration3d()->GetTableNameForTilesDataOrThrow() << "].[" << this->GetDocument()->GetDataBaseConfiguration3d()->GetColumnNameOfTilesDataTableOrThrow(DatabaseConfiguration3D::kTilesDataTable_Column_BinDataId) << "]"
         << " = [" << this->GetDocument()->GetDataBaseConfiguration3d()->GetTableNameForBlobTableOrThrow() << "].[" << this->GetDocument()->GetDataBaseConfiguration3d()->GetColumnNameOfBlobTableOrThrow(DatabaseConfiguration3D::kBlobTable_Column_Pk) << "]"
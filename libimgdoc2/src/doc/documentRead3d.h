@@ -25,12 +25,17 @@ public:
     void GetTilesIntersectingCuboid(const imgdoc2::CuboidD& cuboid, const imgdoc2::IDimCoordinateQueryClause* coordinate_clause, const imgdoc2::ITileInfoQueryClause* tileinfo_clause, const std::function<bool(imgdoc2::dbIndex)>& func) override;
     void GetTilesIntersectingPlane(const imgdoc2::Plane_NormalAndDistD& plane, const imgdoc2::IDimCoordinateQueryClause* coordinate_clause, const imgdoc2::ITileInfoQueryClause* tileinfo_clause, const std::function<bool(imgdoc2::dbIndex)>& func) override;
     void ReadBrickData(imgdoc2::dbIndex idx, imgdoc2::IBlobOutput* data) override;
+    std::uint64_t GetBrickDataSize(imgdoc2::dbIndex idx) override;
+    void ReadBrickSubVolume(imgdoc2::dbIndex idx, const imgdoc2::CuboidI& roi, imgdoc2::IBlobOutput* data) override;
+    bool TryReadBrickStatistics(imgdoc2::dbIndex idx, imgdoc2::TileStatistics* statistics) override;
+    imgdoc2::TileStatisticsSummary GetBrickStatisticsSummary(const imgdoc2::CuboidD* cuboid, const imgdoc2::IDimCoordinateQueryClause* coordinate_clause, const imgdoc2::ITileInfoQueryClause* tileinfo_clause) override;
 
     // interface IDocInfo
     void GetTileDimensions(imgdoc2::Dimension* dimensions, std::uint32_t& count) override;
     std::map<imgdoc2::Dimension, imgdoc2::Int32Interval> GetMinMaxForTileDimension(const std::vector<imgdoc2::Dimension>& dimensions_to_query_for) override;
     std::uint64_t GetTotalTileCount() override;
     std::map<int, std::uint64_t> GetTileCountPerLayer() override;
+    bool TryGetUserProperty(const std::string& key, std::string* value) override;
 
     // interface IDocInfo3d
     void GetBricksBoundingBox(imgdoc2::DoubleInterval* bounds_x, imgdoc2::DoubleInterval* bounds_y, imgdoc2::DoubleInterval* bounds_z) override;
@@ -41,7 +46,23 @@ private:
     std::shared_ptr<IDbStatement> GetTilesIntersectingCuboidQuery(const imgdoc2::CuboidD& cuboid);
     std::shared_ptr<IDbStatement> GetTilesIntersectingCuboidQueryAndCoordinateAndInfoQueryClauseWithSpatialIndex(const imgdoc2::CuboidD& cuboid, const imgdoc2::IDimCoordinateQueryClause* coordinate_clause, const imgdoc2::ITileInfoQueryClause* tileinfo_clause);
     std::shared_ptr<IDbStatement> GetTilesIntersectingCuboidQueryAndCoordinateAndInfoQueryClause(const imgdoc2::CuboidD& cuboid, const imgdoc2::IDimCoordinateQueryClause* coordinate_clause, const imgdoc2::ITileInfoQueryClause* tileinfo_clause);
-    std::shared_ptr<IDbStatement> GetReadBrickDataQueryStatement(imgdoc2::dbIndex idx);
+    std::shared_ptr<IDbStatement> GetReadBrickDataQueryStatement(imgdoc2::dbIndex idx, bool query_size_only);
+    std::shared_ptr<IDbStatement> GetReadBlobDataQueryStatement();
+
+    [[nodiscard]] TilesInfoForStatistics GetTilesInfoForStatistics() const;
+
+    void ReadChunkedBrickSubVolume(imgdoc2::dbIndex idx, const imgdoc2::BrickBaseInfo& brick_base_info, const imgdoc2::CuboidI& roi, imgdoc2::IBlobOutput* data);
+
+    /// Copies the intersection of the source brick with the region-of-interest into the blob-output object. The source brick is an
+    /// uncompressed brick covering the cuboid 'source_cuboid', and the blob-output object receives an uncompressed brick covering
+    /// the cuboid 'roi' (both cuboids are given in the coordinate system of the brick, in units of voxels).
+    /// \param          source          The source brick.
+    /// \param          source_cuboid   The cuboid covered by the source brick.
+    /// \param          roi             The cuboid covered by the blob-output object.
+    /// \param          bytes_per_voxel The number of bytes per voxel.
+    /// \param [in]     data            The blob-output object.
+    /// \returns False if the blob-output object indicated that it is not interested in more data; true otherwise.
+    static bool CopyIntersectionToBlobOutput(const std::uint8_t* source, const imgdoc2::CuboidI& source_cuboid, const imgdoc2::CuboidI& roi, size_t bytes_per_voxel, imgdoc2::IBlobOutput* data);
 
     std::shared_ptr<IDbStatement> GetTilesIntersectingWithPlaneQueryAndCoordinateAndInfoQueryClauseWithSpatialIndex(const imgdoc2::Plane_NormalAndDistD& plane, const imgdoc2::IDimCoordinateQueryClause* coordinate_clause, const imgdoc2::ITileInfoQueryClause* tileinfo_clause) const; 
     std::shared_ptr<IDbStatement> GetTilesIntersectingWithPlaneQueryAndCoordinateAndInfoQueryClause(const imgdoc2::Plane_NormalAndDistD& plane, const imgdoc2::IDimCoordinateQueryClause* coordinate_clause, const imgdoc2::ITileInfoQueryClause* tileinfo_clause) const;
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: MIT
 
 #include "documentReadBase.h"
+#include "tileStatisticsTable.h"
 #include <algorithm>
 #include <vector>
 #include <string>
@@ -189,3 +190,89 @@ std::map<int, std::uint64_t> DocumentReadBase::GetTileCountPerLayer(const std::s
 
     return result;
 }
+
+bool DocumentReadBase::TryReadTileStatisticsInternal(const TilesInfoForStatistics& tiles_info, imgdoc2::dbIndex idx, imgdoc2::TileStatistics* statistics)
+{
+    const auto configuration = this->GetDocument()->GetDataBaseConfigurationCommon();
+    const bool has_statistics_table = configuration->GetHasTileStatisticsTable();
+
+    ostringstream string_stream;
+    if (has_statistics_table)
+    {
+        string_stream << "SELECT " << TileStatisticsTable::GetColumnsForSelect(*configuration, "statistics") << " FROM [" << tiles_info.table_name << "] info "
+            << "LEFT JOIN [" << configuration->GetTableNameForTileStatisticsTableOrThrow() << "] statistics ON "
+            << "info.[" << tiles_info.column_name_tile_data_id << "] = statistics.[" << configuration->GetColumnNameOfTileStatisticsTableOrThrow(DatabaseConfigurationCommon::kTileStatisticsTable_Column_Pk) << "] "
+            << "WHERE info.[" << tiles_info.column_name_pk << "] = ?1;";
+    }
+    else
+    {
+        string_stream << "SELECT [" << tiles_info.column_name_pk << "] FROM [" << tiles_info.table_name << "] WHERE [" << tiles_info.column_name_pk << "] = ?1;";
+    }
+
+    const auto statement = this->GetDocument()->GetDatabase_connection()->PrepareStatement(string_stream.str());
+    statement->BindInt64(1, idx);
+    if (!this->GetDocument()->GetDatabase_connection()->StepStatement(statement.get()))
+    {
+        ostringstream ss;
+        ss << "Request for reading the statistics of a non-existing tile (with pk=" << idx << ")";
+        throw non_existing_tile_exception(ss.str(), idx);
+    }
+
+    if (!has_statistics_table)
+    {
+        return false;
+    }
+
+    TileStatistics tile_statistics;
+    if (!TileStatisticsTable::TryReadFromStatement(statement.get(), 0, tile_statistics))
+    {
+        return false;
+    }
+
+    if (statistics != nullptr)
+    {
+        *statistics = tile_statistics;
+    }
+
+    return true;
+}
+
+imgdoc2::TileStatisticsSummary DocumentReadBase::GetTileStatisticsSummaryInternal(const TilesInfoForStatistics& tiles_info, const std::string& condition, const std::function<void(IDbStatement*)>& bind_parameters)
+{
+    const auto configuration = this->GetDocument()->GetDataBaseConfigurationCommon();
+    if (!configuration->GetHasTileStatisticsTable())
+    {
+        throw invalid_operation_exception("The document does not contain a tile-statistics table.");
+    }
+
+    // The tiles are selected in a sub-query, so that the condition can refer to the columns of the TILESINFO-table without
+    //  ambiguity. Note that we use a LEFT JOIN, so that we can count the tiles for which there are no statistics.
+    ostringstream string_stream;
+    string_stream << "SELECT " << TileStatisticsTable::GetColumnsForSelect(*configuration, "statistics") << " FROM "
+        << "(SELECT [" << tiles_info.column_name_tile_data_id << "] FROM [" << tiles_info.table_name << "] WHERE " << condition << ") info "
+        << "LEFT JOIN [" << configuration->GetTableNameForTileStatisticsTableOrThrow() << "] statistics ON "
+        << "info.[" << tiles_info.column_name_tile_data_id << "] = statistics.[" << configuration->GetColumnNameOfTileStatisticsTableOrThrow(DatabaseConfigurationCommon::kTileStatisticsTable_Column_Pk) << "];";
+
+    const auto statement = this->GetDocument()->GetDatabase_connection()->PrepareStatement(string_stream.str());
+    if (bind_parameters)
+    {
+        bind_parameters(statement.get());
+    }
+
+    vector<TileStatistics> tile_statistics;
+    uint64_t tile_count_without_statistics = 0;
+    while (this->GetDocument()->GetDatabase_connection()->StepStatement(statement.get()))
+    {
+        TileStatistics statistics;
+        if (TileStatisticsTable::TryReadFromStatement(statement.get(), 0, statistics))
+        {
+            tile_statistics.push_back(statistics);
+        }
+        else
+        {
+            ++tile_count_without_statistics;
+        }
+    }
+
+    return TileStatisticsTable::Aggregate(tile_statistics, tile_count_without_statistics);
+}
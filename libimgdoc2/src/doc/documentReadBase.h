@@ -66,6 +66,31 @@ protected:
     std::uint64_t GetTotalTileCount(const std::string& table_name);
     std::map<int, std::uint64_t> GetTileCountPerLayer(const std::string& table_name, const std::string& pyramid_level_column_name);
 
+    /// Information about the TILESINFO-table, as required for accessing the tile-statistics table.
+    struct TilesInfoForStatistics
+    {
+        std::string table_name;                     ///< Name of the TILESINFO-table.
+        std::string column_name_pk;                 ///< Name of the column for the primary key.
+        std::string column_name_tile_data_id;       ///< Name of the column referencing the TILESDATA-table.
+    };
+
+    /// Reads the statistics for the specified tile from the tile-statistics table. If the tile does not exist, an exception of
+    /// type "imgdoc2::non_existing_tile_exception" is thrown.
+    /// \param          tiles_info  Information about the TILESINFO-table.
+    /// \param          idx         The primary key of the tile.
+    /// \param [out]    statistics  If non-null and successful, the statistics are put here.
+    /// \returns    True if successful; false if there are no statistics for the tile (or there is no tile-statistics table).
+    bool TryReadTileStatisticsInternal(const TilesInfoForStatistics& tiles_info, imgdoc2::dbIndex idx, imgdoc2::TileStatistics* statistics);
+
+    /// Aggregates the statistics of the tiles satisfying the specified condition. The condition is an SQL-expression (referring to the
+    /// columns of the TILESINFO-table), and the functor 'bind_parameters' is called in order to bind the parameters of the expression.
+    /// If there is no tile-statistics table, an exception of type "imgdoc2::invalid_operation_exception" is thrown.
+    /// \param  tiles_info      Information about the TILESINFO-table.
+    /// \param  condition       The condition (an SQL-expression).
+    /// \param  bind_parameters A functor which binds the parameters of the condition.
+    /// \returns    The aggregated statistics.
+    imgdoc2::TileStatisticsSummary GetTileStatisticsSummaryInternal(const TilesInfoForStatistics& tiles_info, const std::string& condition, const std::function<void(IDbStatement*)>& bind_parameters);
+
     [[nodiscard]] const std::shared_ptr<Document>& GetDocument() const { return this->document_; }
     [[nodiscard]] const std::shared_ptr<imgdoc2::IHostingEnvironment>& GetHostingEnvironment() const { return this->document_->GetHostingEnvironment(); }
 private:
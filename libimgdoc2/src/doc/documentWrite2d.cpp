@@ -6,7 +6,7 @@
 #include <vector> 
 #include <gsl/gsl>
 #include "documentWrite2d.h"
-#include "transactionHelper.h"
+#include "tileStatisticsTable.h"
 
 using namespace std;
 using namespace imgdoc2;
@@ -19,30 +19,108 @@ using namespace imgdoc2;
     imgdoc2::TileDataStorageType storage_type,
     const imgdoc2::IDataObjBase* data)
 {
-    TransactionHelper<dbIndex> transaction{
-        this->document_->GetDatabase_connection(),
+    return this->auto_commit_transaction_.Execute<dbIndex>(
         [&]()->dbIndex
         {
             return this->AddTileInternal(coordinate, info, tileInfo, datatype, storage_type, data);
+        },
+        1,
+        AutoCommitTransaction::GetDataSize(data));
+}
+
+/*virtual*/void DocumentWrite2d::AddTiles(const imgdoc2::TileToAdd* tiles, std::uint32_t count, imgdoc2::dbIndex* result_pks)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    if (tiles == nullptr)
+    {
+        throw invalid_argument_exception("The array of tiles must not be null.");
+    }
+
+    uint64_t total_data_size = 0;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        total_data_size += AutoCommitTransaction::GetDataSize(tiles[i].data);
+    }
+
+    const auto action = [&]()->uint32_t
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const auto& tile = tiles[i];
+            const auto pk = this->AddTileInternal(tile.coordinate, tile.logical_position_info, tile.tile_base_info, tile.data_type, tile.storage_type, tile.data);
+            if (result_pks != nullptr)
+            {
+                result_pks[i] = pk;
+            }
         }
+
+        return count;
     };
 
-    return transaction.Execute();
+    // the statement cache is only active for the duration of this call, so that the statements are not kept alive beyond it
+    this->batch_statement_cache_ = make_unique<StatementCache>(this->document_->GetDatabase_connection());
+    try
+    {
+        this->auto_commit_transaction_.Execute<uint32_t>(action, count, total_data_size);
+    }
+    catch (...)
+    {
+        this->batch_statement_cache_.reset();
+        throw;
+    }
+
+    this->batch_statement_cache_.reset();
+}
+
+/*virtual*/void DocumentWrite2d::SetAutoCommitPolicy(const imgdoc2::AutoCommitPolicy& policy)
+{
+    this->auto_commit_transaction_.SetPolicy(policy);
+}
+
+/*virtual*/imgdoc2::AutoCommitPolicy DocumentWrite2d::GetAutoCommitPolicy() const
+{
+    return this->auto_commit_transaction_.GetPolicy();
+}
+
+/*virtual*/void DocumentWrite2d::SetUserProperty(const std::string& key, const std::string& value)
+{
+    this->auto_commit_transaction_.Execute<bool>(
+        [&]()->bool
+        {
+            this->document_->WriteUserProperty(key, value);
+            return true;
+        },
+        0,
+        0);
 }
 
 /*virtual*/void DocumentWrite2d::BeginTransaction()
 {
-    this->document_->GetDatabase_connection()->BeginTransaction();
+    this->auto_commit_transaction_.BeginTransaction();
 }
 
 /*virtual*/void DocumentWrite2d::CommitTransaction()
 {
-    this->document_->GetDatabase_connection()->EndTransaction(true);
+    this->auto_commit_transaction_.EndTransaction(true);
 }
 
 /*virtual*/void DocumentWrite2d::RollbackTransaction()
 {
-    this->document_->GetDatabase_connection()->EndTransaction(false);
+    this->auto_commit_transaction_.EndTransaction(false);
+}
+
+std::shared_ptr<IDbStatement> DocumentWrite2d::PrepareStatement(const std::string& sql_statement)
+{
+    if (this->batch_statement_cache_)
+    {
+        return this->batch_statement_cache_->GetOrPrepare(sql_statement);
+    }
+
+    return this->document_->GetDatabase_connection()->PrepareStatement(sql_statement);
 }
 
 imgdoc2::dbIndex DocumentWrite2d::AddTileInternal(
@@ -54,6 +132,15 @@ imgdoc2::dbIndex DocumentWrite2d::AddTileInternal(
     const imgdoc2::IDataObjBase* data)
 {
     const auto tiles_data_id = this->AddTileData(tileInfo, datatype, storage_type, data);
+    TileStatisticsTable::AddIfApplicable(
+        this->document_->GetDatabase_connection().get(),
+        this->batch_statement_cache_.get(),
+        *this->document_->GetDataBaseConfiguration2d(),
+        tiles_data_id,
+        tileInfo->pixelType,
+        datatype,
+        static_cast<uint64_t>(tileInfo->pixelWidth) * tileInfo->pixelHeight,
+        data);
 
     ostringstream string_stream;
     string_stream << "INSERT INTO [" << this->document_->GetDataBaseConfiguration2d()->GetTableNameForTilesInfoOrThrow() << "] ("
@@ -81,7 +168,7 @@ imgdoc2::dbIndex DocumentWrite2d::AddTileInternal(
 
     string_stream << ");";
 
-    const auto statement = this->document_->GetDatabase_connection()->PrepareStatement(string_stream.str());
+    const auto statement = this->PrepareStatement(string_stream.str());
     int binding_index = 1;
     statement->BindDouble(binding_index++, info->posX);
     statement->BindDouble(binding_index++, info->posY);
@@ -124,7 +211,7 @@ imgdoc2::dbIndex DocumentWrite2d::AddTileData(const imgdoc2::TileBaseInfo* tile_
         << "[" << this->document_->GetDataBaseConfiguration2d()->GetColumnNameOfTilesDataTableOrThrow(DatabaseConfiguration2D::kTilesDataTable_Column_BinDataId) << "]"
         ") VALUES( ?1, ?2, ?3, ?4, ?5, ?6);";
 
-    const auto statement = this->document_->GetDatabase_connection()->PrepareStatement(string_stream.str());
+    const auto statement = this->PrepareStatement(string_stream.str());
 
     int binding_index = 1;
     statement->BindInt32(binding_index++, tile_info->pixelWidth);
@@ -169,7 +256,7 @@ std::shared_ptr<IDbStatement> DocumentWrite2d::CreateInsertDataStatement(const i
         << "[" << this->document_->GetDataBaseConfiguration2d()->GetColumnNameOfBlobTableOrThrow(DatabaseConfigurationCommon::kBlobTable_Column_Data) << "]"
         << ") VALUES( ?1 );";
 
-    auto statement = this->document_->GetDatabase_connection()->PrepareStatement(string_stream.str());
+    auto statement = this->PrepareStatement(string_stream.str());
     const void* ptr_data = nullptr;
     size_t size_data = 0;
     data->GetData(&ptr_data, &size_data);
@@ -188,7 +275,7 @@ void DocumentWrite2d::AddToSpatialIndex(imgdoc2::dbIndex index, const imgdoc2::L
         << "[" << this->document_->GetDataBaseConfiguration2d()->GetColumnNameOfTilesSpatialIndexTableOrThrow(DatabaseConfiguration2D::kTilesSpatialIndexTable_Column_MaxY) << "]"
         ") VALUES(?1,?2,?3,?4,?5);";
 
-    const auto statement = this->document_->GetDatabase_connection()->PrepareStatement(string_stream.str());
+    const auto statement = this->PrepareStatement(string_stream.str());
 
     int binding_index = 1;
     statement->BindInt64(binding_index++, index);
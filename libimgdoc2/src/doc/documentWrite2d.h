@@ -9,13 +9,19 @@
 #include <imgdoc2.h>
 #include "document.h"
 #include "ITileCoordinate.h"
+#include "statementCache.h"
+#include "autoCommitTransaction.h"
 
 class DocumentWrite2d : public imgdoc2::IDocWrite2d
 {
 private:
     std::shared_ptr < Document> document_;
+    std::unique_ptr<StatementCache> batch_statement_cache_;   ///< If non-null, a batch of tiles is being added, and statements are re-used.
+    AutoCommitTransaction auto_commit_transaction_;
 public:
-    explicit DocumentWrite2d(std::shared_ptr<Document> document) : document_(std::move(document))
+    explicit DocumentWrite2d(std::shared_ptr<Document> document) :
+        document_(std::move(document)),
+        auto_commit_transaction_(this->document_->GetDatabase_connection())
     {}
 
     imgdoc2::dbIndex AddTile(
@@ -26,6 +32,13 @@ public:
         imgdoc2::TileDataStorageType storage_type,
         const imgdoc2::IDataObjBase* data) override;
 
+    void AddTiles(const imgdoc2::TileToAdd* tiles, std::uint32_t count, imgdoc2::dbIndex* result_pks) override;
+
+    void SetAutoCommitPolicy(const imgdoc2::AutoCommitPolicy& policy) override;
+    [[nodiscard]] imgdoc2::AutoCommitPolicy GetAutoCommitPolicy() const override;
+
+    void SetUserProperty(const std::string& key, const std::string& value) override;
+
     void BeginTransaction() override;
     void CommitTransaction() override;
     void RollbackTransaction() override;
@@ -33,6 +46,11 @@ public:
     ~DocumentWrite2d() override = default;
 
 private:
+    /// Prepares the specified statement - or, if a batch of tiles is being added, gets the statement from the statement cache.
+    /// \param  sql_statement   The SQL-text.
+    /// \returns The statement.
+    std::shared_ptr<IDbStatement> PrepareStatement(const std::string& sql_statement);
+
     imgdoc2::dbIndex AddTileInternal(
         const imgdoc2::ITileCoordinate* coordinate,
         const imgdoc2::LogicalPositionInfo* info,
@@ -4,9 +4,11 @@
 
 #include <sstream>
 #include <vector> 
+#include <cstring>
 #include <gsl/gsl>
 #include "documentWrite3d.h"
-#include "transactionHelper.h"
+#include "brickChunkIndex.h"
+#include "tileStatisticsTable.h"
 
 using namespace std;
 using namespace imgdoc2;
@@ -19,30 +21,146 @@ using namespace imgdoc2;
             imgdoc2::TileDataStorageType storage_type,
             const imgdoc2::IDataObjBase* data)
 {
-    TransactionHelper<dbIndex> transaction{
-        this->document_->GetDatabase_connection(),
+    return this->auto_commit_transaction_.Execute<dbIndex>(
         [&]()->dbIndex
         {
             return this->AddBrickInternal(coordinate, logical_position_3d_info, brickInfo, data_type, storage_type, data);
+        },
+        1,
+        AutoCommitTransaction::GetDataSize(data));
+}
+
+/*virtual*/imgdoc2::dbIndex DocumentWrite3d::AddChunkedBrick(
+            const imgdoc2::ITileCoordinate* coordinate,
+            const imgdoc2::LogicalPositionInfo3D* logical_position_3d_info,
+            const imgdoc2::BrickBaseInfo* brick_base_info,
+            const imgdoc2::BrickChunkExtent& chunk_extent,
+            imgdoc2::TileDataStorageType storage_type,
+            const imgdoc2::IDataObjBase* data)
+{
+    if (chunk_extent.width == 0 || chunk_extent.height == 0 || chunk_extent.depth == 0)
+    {
+        throw invalid_argument_exception("The extent of the chunks must be non-zero.");
+    }
+
+    if (data == nullptr)
+    {
+        throw invalid_argument_exception("The data must be specified for a chunked brick.");
+    }
+
+    return this->auto_commit_transaction_.Execute<dbIndex>(
+        [&]()->dbIndex
+        {
+            const auto chunk_index_blob_id = this->AddBrickChunks(brick_base_info, chunk_extent, storage_type, data);
+            const auto tiles_data_id = this->AddBrickDataRow(brick_base_info, DataTypes::UNCOMPRESSED_CHUNKED_BRICK, storage_type, &chunk_index_blob_id);
+            TileStatisticsTable::AddIfApplicable(
+                this->document_->GetDatabase_connection().get(),
+                this->batch_statement_cache_.get(),
+                *this->document_->GetDataBaseConfiguration3d(),
+                tiles_data_id,
+                brick_base_info->pixelType,
+                DataTypes::UNCOMPRESSED_CHUNKED_BRICK,
+                static_cast<uint64_t>(brick_base_info->pixelWidth) * brick_base_info->pixelHeight * brick_base_info->pixelDepth,
+                data);
+            return this->AddBrickInfoRow(coordinate, logical_position_3d_info, tiles_data_id);
+        },
+        1,
+        AutoCommitTransaction::GetDataSize(data));
+}
+
+/*virtual*/void DocumentWrite3d::AddBricks(const imgdoc2::BrickToAdd* bricks, std::uint32_t count, imgdoc2::dbIndex* result_pks)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    if (bricks == nullptr)
+    {
+        throw invalid_argument_exception("The array of bricks must not be null.");
+    }
+
+    uint64_t total_data_size = 0;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        total_data_size += AutoCommitTransaction::GetDataSize(bricks[i].data);
+    }
+
+    const auto action = [&]()->uint32_t
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const auto& brick = bricks[i];
+            const auto pk = this->AddBrickInternal(brick.coordinate, brick.logical_position_info, brick.brick_base_info, brick.data_type, brick.storage_type, brick.data);
+            if (result_pks != nullptr)
+            {
+                result_pks[i] = pk;
+            }
         }
+
+        return count;
     };
 
-    return transaction.Execute();
+    // the statement cache is only active for the duration of this call, so that the statements are not kept alive beyond it
+    this->batch_statement_cache_ = make_unique<StatementCache>(this->document_->GetDatabase_connection());
+    try
+    {
+        this->auto_commit_transaction_.Execute<uint32_t>(action, count, total_data_size);
+    }
+    catch (...)
+    {
+        this->batch_statement_cache_.reset();
+        throw;
+    }
+
+    this->batch_statement_cache_.reset();
+}
+
+/*virtual*/void DocumentWrite3d::SetAutoCommitPolicy(const imgdoc2::AutoCommitPolicy& policy)
+{
+    this->auto_commit_transaction_.SetPolicy(policy);
+}
+
+/*virtual*/imgdoc2::AutoCommitPolicy DocumentWrite3d::GetAutoCommitPolicy() const
+{
+    return this->auto_commit_transaction_.GetPolicy();
+}
+
+/*virtual*/void DocumentWrite3d::SetUserProperty(const std::string& key, const std::string& value)
+{
+    this->auto_commit_transaction_.Execute<bool>(
+        [&]()->bool
+        {
+            this->document_->WriteUserProperty(key, value);
+            return true;
+        },
+        0,
+        0);
 }
 
 /*virtual*/void DocumentWrite3d::BeginTransaction()
 {
-    this->document_->GetDatabase_connection()->BeginTransaction();
+    this->auto_commit_transaction_.BeginTransaction();
 }
 
 /*virtual*/void DocumentWrite3d::CommitTransaction()
 {
-    this->document_->GetDatabase_connection()->EndTransaction(true);
+    this->auto_commit_transaction_.EndTransaction(true);
 }
 
 /*virtual*/void DocumentWrite3d::RollbackTransaction()
 {
-    this->document_->GetDatabase_connection()->EndTransaction(false);
+    this->auto_commit_transaction_.EndTransaction(false);
+}
+
+std::shared_ptr<IDbStatement> DocumentWrite3d::PrepareStatement(const std::string& sql_statement)
+{
+    if (this->batch_statement_cache_)
+    {
+        return this->batch_statement_cache_->GetOrPrepare(sql_statement);
+    }
+
+    return this->document_->GetDatabase_connection()->PrepareStatement(sql_statement);
 }
 
 imgdoc2::dbIndex DocumentWrite3d::AddBrickInternal(
@@ -54,7 +172,23 @@ imgdoc2::dbIndex DocumentWrite3d::AddBrickInternal(
         const imgdoc2::IDataObjBase* data)
 {
     const auto tiles_data_id = this->AddBrickData(brick_base_info, data_type, storage_type, data);
+    TileStatisticsTable::AddIfApplicable(
+        this->document_->GetDatabase_connection().get(),
+        this->batch_statement_cache_.get(),
+        *this->document_->GetDataBaseConfiguration3d(),
+        tiles_data_id,
+        brick_base_info->pixelType,
+        data_type,
+        static_cast<uint64_t>(brick_base_info->pixelWidth) * brick_base_info->pixelHeight * brick_base_info->pixelDepth,
+        data);
+    return this->AddBrickInfoRow(coordinate, logical_position_info_3d, tiles_data_id);
+}
 
+imgdoc2::dbIndex DocumentWrite3d::AddBrickInfoRow(
+        const imgdoc2::ITileCoordinate* coordinate,
+        const imgdoc2::LogicalPositionInfo3D* logical_position_info_3d,
+        imgdoc2::dbIndex tiles_data_id)
+{
     ostringstream string_stream;
     string_stream << "INSERT INTO [" << this->document_->GetDataBaseConfiguration3d()->GetTableNameForTilesInfoOrThrow() << "] ("
         << "[" << this->document_->GetDataBaseConfiguration3d()->GetColumnNameOfTilesInfoTableOrThrow(DatabaseConfiguration3D::kTilesInfoTable_Column_TileX) << "],"
@@ -83,7 +217,7 @@ imgdoc2::dbIndex DocumentWrite3d::AddBrickInternal(
 
     string_stream << ");";
 
-    const auto statement = this->document_->GetDatabase_connection()->PrepareStatement(string_stream.str());
+    const auto statement = this->PrepareStatement(string_stream.str());
     int binding_index = 1;
     statement->BindDouble(binding_index++, logical_position_info_3d->posX);
     statement->BindDouble(binding_index++, logical_position_info_3d->posY);
@@ -118,6 +252,11 @@ imgdoc2::dbIndex DocumentWrite3d::AddBrickData(const imgdoc2::BrickBaseInfo* bri
         blob_db_index = this->AddBlobData(storage_type, data);
     }
 
+    return this->AddBrickDataRow(brick_base_info, data_type, storage_type, data != nullptr ? &blob_db_index : nullptr);
+}
+
+imgdoc2::dbIndex DocumentWrite3d::AddBrickDataRow(const imgdoc2::BrickBaseInfo* brick_base_info, imgdoc2::DataTypes data_type, imgdoc2::TileDataStorageType storage_type, const imgdoc2::dbIndex* blob_db_index)
+{
     ostringstream string_stream;
     string_stream << "INSERT INTO " << this->document_->GetDataBaseConfiguration3d()->GetTableNameForTilesDataOrThrow() << " ("
         << "[" << this->document_->GetDataBaseConfiguration3d()->GetColumnNameOfTilesDataTableOrThrow(DatabaseConfiguration3D::kTilesDataTable_Column_PixelWidth) << "],"
@@ -129,7 +268,7 @@ imgdoc2::dbIndex DocumentWrite3d::AddBrickData(const imgdoc2::BrickBaseInfo* bri
         << "[" << this->document_->GetDataBaseConfiguration3d()->GetColumnNameOfTilesDataTableOrThrow(DatabaseConfiguration3D::kTilesDataTable_Column_BinDataId) << "]"
         ") VALUES( ?1, ?2, ?3, ?4, ?5, ?6, ?7);";
 
-    const auto statement = this->document_->GetDatabase_connection()->PrepareStatement(string_stream.str());
+    const auto statement = this->PrepareStatement(string_stream.str());
 
     int binding_index = 1;
     statement->BindInt32(binding_index++, brick_base_info->pixelWidth);
@@ -137,11 +276,11 @@ imgdoc2::dbIndex DocumentWrite3d::AddBrickData(const imgdoc2::BrickBaseInfo* bri
     statement->BindInt32(binding_index++, brick_base_info->pixelDepth);
     statement->BindInt32(binding_index++, brick_base_info->pixelType);
     statement->BindInt32(binding_index++, static_cast<underlying_type_t<decltype(data_type)>>(data_type));
-    if (data != nullptr)
+    if (blob_db_index != nullptr)
     {
         // for data-type "zero" 
         statement->BindInt32(binding_index++, static_cast<underlying_type_t<decltype(storage_type)>>(storage_type));
-        statement->BindInt64(binding_index++, blob_db_index);
+        statement->BindInt64(binding_index++, *blob_db_index);
     }
 
     const auto row_id = this->document_->GetDatabase_connection()->ExecuteAndGetLastRowId(statement.get());
@@ -153,6 +292,14 @@ imgdoc2::dbIndex DocumentWrite3d::AddBlobData(imgdoc2::TileDataStorageType stora
     // TODO(JBL) - combine with 2d version
     Expects(data != nullptr);
 
+    const void* ptr_data = nullptr;
+    size_t size_data = 0;
+    data->GetData(&ptr_data, &size_data);
+    return this->AddBlobData(storage_type, ptr_data, size_data);
+}
+
+imgdoc2::dbIndex DocumentWrite3d::AddBlobData(imgdoc2::TileDataStorageType storage_type, const void* ptr_data, size_t size_data)
+{
     if (storage_type != TileDataStorageType::BlobInDatabase)
     {
         throw invalid_operation_exception("Storage-types other than 'blob-in-database' are not implemented.");
@@ -163,13 +310,13 @@ imgdoc2::dbIndex DocumentWrite3d::AddBlobData(imgdoc2::TileDataStorageType stora
         throw invalid_operation_exception("The database does not have a blob-table.");
     }
 
-    const auto insert_data_statement = this->CreateInsertDataStatement(data);
+    const auto insert_data_statement = this->CreateInsertDataStatement(ptr_data, size_data);
 
     const auto row_id = this->document_->GetDatabase_connection()->ExecuteAndGetLastRowId(insert_data_statement.get());
     return row_id;
 }
 
-std::shared_ptr<IDbStatement> DocumentWrite3d::CreateInsertDataStatement(const imgdoc2::IDataObjBase* data)
+std::shared_ptr<IDbStatement> DocumentWrite3d::CreateInsertDataStatement(const void* ptr_data, size_t size_data)
 {
     // TODO(JBL) - combine with 2d version
     ostringstream string_stream;
@@ -177,12 +324,70 @@ std::shared_ptr<IDbStatement> DocumentWrite3d::CreateInsertDataStatement(const i
         << "[" << this->document_->GetDataBaseConfiguration3d()->GetColumnNameOfBlobTableOrThrow(DatabaseConfigurationCommon::kBlobTable_Column_Data) << "]"
         << ") VALUES( ?1 );";
 
-    auto statement = this->document_->GetDatabase_connection()->PrepareStatement(string_stream.str());
+    auto statement = this->PrepareStatement(string_stream.str());
+    statement->BindBlob_Static(1, ptr_data, size_data);
+    return statement;
+}
+
+imgdoc2::dbIndex DocumentWrite3d::AddBrickChunks(const imgdoc2::BrickBaseInfo* brick_base_info, const imgdoc2::BrickChunkExtent& chunk_extent, imgdoc2::TileDataStorageType storage_type, const imgdoc2::IDataObjBase* data)
+{
     const void* ptr_data = nullptr;
     size_t size_data = 0;
     data->GetData(&ptr_data, &size_data);
-    statement->BindBlob_Static(1, ptr_data, size_data);
-    return statement;
+
+    // The pixeltype is opaque to us, so we determine the size of a voxel from the size of the data. We require the data
+    //  to be exactly an integer multiple of the number of voxels.
+    const size_t voxel_count = static_cast<size_t>(brick_base_info->pixelWidth) * brick_base_info->pixelHeight * brick_base_info->pixelDepth;
+    if (voxel_count == 0 || size_data == 0 || size_data % voxel_count != 0)
+    {
+        ostringstream string_stream;
+        string_stream << "The size of the data (" << size_data << " bytes) is not an integer multiple of the number of voxels (" << voxel_count << ").";
+        throw invalid_argument_exception(string_stream.str().c_str());
+    }
+
+    BrickChunkIndex chunk_index;
+    chunk_index.bytes_per_voxel = gsl::narrow<uint32_t>(size_data / voxel_count);
+    chunk_index.brick_width = brick_base_info->pixelWidth;
+    chunk_index.brick_height = brick_base_info->pixelHeight;
+    chunk_index.brick_depth = brick_base_info->pixelDepth;
+    chunk_index.chunk_extent = chunk_extent;
+    chunk_index.chunk_blob_keys.reserve(chunk_index.GetChunkCount());
+
+    const size_t source_line_length = static_cast<size_t>(brick_base_info->pixelWidth) * chunk_index.bytes_per_voxel;
+    const size_t source_plane_size = source_line_length * brick_base_info->pixelHeight;
+    vector<uint8_t> chunk_data;
+    for (uint32_t chunk_z = 0; chunk_z < chunk_index.GetChunkCountZ(); ++chunk_z)
+    {
+        for (uint32_t chunk_y = 0; chunk_y < chunk_index.GetChunkCountY(); ++chunk_y)
+        {
+            for (uint32_t chunk_x = 0; chunk_x < chunk_index.GetChunkCountX(); ++chunk_x)
+            {
+                const CuboidI chunk_cuboid = chunk_index.GetChunkCuboid(chunk_x, chunk_y, chunk_z);
+                const size_t chunk_line_length = static_cast<size_t>(chunk_cuboid.w) * chunk_index.bytes_per_voxel;
+                chunk_data.resize(chunk_line_length * chunk_cuboid.h * chunk_cuboid.d);
+
+                // copy the chunk (line-by-line) into a contiguous buffer, which then is an "uncompressed brick" itself
+                uint8_t* destination = chunk_data.data();
+                for (int32_t z = 0; z < chunk_cuboid.d; ++z)
+                {
+                    for (int32_t y = 0; y < chunk_cuboid.h; ++y)
+                    {
+                        const uint8_t* source = static_cast<const uint8_t*>(ptr_data) +
+                            (chunk_cuboid.z + z) * source_plane_size +
+                            (chunk_cuboid.y + y) * source_line_length +
+                            static_cast<size_t>(chunk_cuboid.x) * chunk_index.bytes_per_voxel;
+                        memcpy(destination, source, chunk_line_length);
+                        destination += chunk_line_length;
+                    }
+                }
+
+                chunk_index.chunk_blob_keys.push_back(this->AddBlobData(storage_type, chunk_data.data(), chunk_data.size()));
+            }
+        }
+    }
+
+    const auto chunk_index_data = chunk_index.Serialize();
+    return this->AddBlobData(storage_type, chunk_index_data.data(), chunk_index_data.size());
 }
 
 void DocumentWrite3d::AddToSpatialIndex(imgdoc2::dbIndex index, const imgdoc2::LogicalPositionInfo3D& logical_position_info)
@@ -198,7 +403,7 @@ void DocumentWrite3d::AddToSpatialIndex(imgdoc2::dbIndex index, const imgdoc2::L
         << "[" << this->document_->GetDataBaseConfiguration3d()->GetColumnNameOfTilesSpatialIndexTableOrThrow(DatabaseConfiguration3D::kTilesSpatialIndexTable_Column_MaxZ) << "]"
         ") VALUES(?1,?2,?3,?4,?5,?6,?7);";
 
-    const auto statement = this->document_->GetDatabase_connection()->PrepareStatement(string_stream.str());
+    const auto statement = this->PrepareStatement(string_stream.str());
 
     int binding_index = 1;
     statement->BindInt64(binding_index++, index);
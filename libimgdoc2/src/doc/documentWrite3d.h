@@ -8,6 +8,8 @@
 #include <memory>
 #include <imgdoc2.h>
 #include "document.h"
+#include "statementCache.h"
+#include "autoCommitTransaction.h"
 #include "ITileCoordinate.h"
 
 /// This class implements the IDocWrite3d interface, i.e. write access to a 3D image document.
@@ -15,8 +17,12 @@ class DocumentWrite3d : public imgdoc2::IDocWrite3d
 {
 private:
     std::shared_ptr < Document> document_;
+    std::unique_ptr<StatementCache> batch_statement_cache_;   ///< If non-null, a batch of bricks is being added, and statements are re-used.
+    AutoCommitTransaction auto_commit_transaction_;
 public:
-    explicit DocumentWrite3d(std::shared_ptr<Document> document) : document_(std::move(document))
+    explicit DocumentWrite3d(std::shared_ptr<Document> document) :
+        document_(std::move(document)),
+        auto_commit_transaction_(this->document_->GetDatabase_connection())
     {}
 
     imgdoc2::dbIndex AddBrick(
@@ -27,6 +33,21 @@ public:
         imgdoc2::TileDataStorageType storage_type,
         const imgdoc2::IDataObjBase* data) override;
 
+    imgdoc2::dbIndex AddChunkedBrick(
+        const imgdoc2::ITileCoordinate* coordinate,
+        const imgdoc2::LogicalPositionInfo3D* logical_position_3d_info,
+        const imgdoc2::BrickBaseInfo* brick_base_info,
+        const imgdoc2::BrickChunkExtent& chunk_extent,
+        imgdoc2::TileDataStorageType storage_type,
+        const imgdoc2::IDataObjBase* data) override;
+
+    void AddBricks(const imgdoc2::BrickToAdd* bricks, std::uint32_t count, imgdoc2::dbIndex* result_pks) override;
+
+    void SetAutoCommitPolicy(const imgdoc2::AutoCommitPolicy& policy) override;
+    [[nodiscard]] imgdoc2::AutoCommitPolicy GetAutoCommitPolicy() const override;
+
+    void SetUserProperty(const std::string& key, const std::string& value) override;
+
     void BeginTransaction() override;
     void CommitTransaction() override;
     void RollbackTransaction() override;
@@ -34,6 +55,11 @@ public:
     ~DocumentWrite3d() override = default;
 
 private:
+    /// Prepares the specified statement - or, if a batch of bricks is being added, gets the statement from the statement cache.
+    /// \param  sql_statement   The SQL-text.
+    /// \returns The statement.
+    std::shared_ptr<IDbStatement> PrepareStatement(const std::string& sql_statement);
+
     imgdoc2::dbIndex AddBrickInternal(
         const imgdoc2::ITileCoordinate* coordinate,
         const imgdoc2::LogicalPositionInfo3D* logical_position_info_3d,
@@ -42,12 +68,34 @@ private:
         imgdoc2::TileDataStorageType storage_type,
         const imgdoc2::IDataObjBase* data);
 
+    imgdoc2::dbIndex AddBrickInfoRow(
+        const imgdoc2::ITileCoordinate* coordinate,
+        const imgdoc2::LogicalPositionInfo3D* logical_position_info_3d,
+        imgdoc2::dbIndex tiles_data_id);
+
     void AddToSpatialIndex(imgdoc2::dbIndex index, const imgdoc2::LogicalPositionInfo3D& logical_position_info);
 
     imgdoc2::dbIndex AddBrickData(const imgdoc2::BrickBaseInfo* brick_base_info, imgdoc2::DataTypes data_type, imgdoc2::TileDataStorageType storage_type, const imgdoc2::IDataObjBase* data);
+
+    /// Adds a row to the TILESDATA-table.
+    /// \param  brick_base_info Information describing the brick.
+    /// \param  data_type       The data type.
+    /// \param  storage_type    The storage type.
+    /// \param  blob_db_index   If non-null, the primary key of the blob (in the BLOBS-table) associated with the brick; if null, there is no blob.
+    /// \returns The primary key of the newly added row.
+    imgdoc2::dbIndex AddBrickDataRow(const imgdoc2::BrickBaseInfo* brick_base_info, imgdoc2::DataTypes data_type, imgdoc2::TileDataStorageType storage_type, const imgdoc2::dbIndex* blob_db_index);
     imgdoc2::dbIndex AddBlobData(imgdoc2::TileDataStorageType storage_type, const imgdoc2::IDataObjBase* data);
+    imgdoc2::dbIndex AddBlobData(imgdoc2::TileDataStorageType storage_type, const void* ptr_data, size_t size_data);
+
+    /// Splits the specified (uncompressed) brick into chunks, adds each chunk as a blob, and then adds the chunk index (cf. BrickChunkIndex) as a blob.
+    /// \param  brick_base_info Information describing the brick.
+    /// \param  chunk_extent    The extent of the chunks.
+    /// \param  storage_type    The storage type.
+    /// \param  data            The (uncompressed) brick.
+    /// \returns The primary key of the blob containing the chunk index.
+    imgdoc2::dbIndex AddBrickChunks(const imgdoc2::BrickBaseInfo* brick_base_info, const imgdoc2::BrickChunkExtent& chunk_extent, imgdoc2::TileDataStorageType storage_type, const imgdoc2::IDataObjBase* data);
 
-    std::shared_ptr<IDbStatement> CreateInsertDataStatement(const imgdoc2::IDataObjBase* data);
+    std::shared_ptr<IDbStatement> CreateInsertDataStatement(const void* ptr_data, size_t size_data);
 public:
     // no copy and no move (-> https://github.com/isocpp/CppCoreGuidelines/blob/master/CppCoreGuidelines.md#c21-if-you-define-or-delete-any-copy-move-or-destructor-function-define-or-delete-them-all )
     DocumentWrite3d() = default;
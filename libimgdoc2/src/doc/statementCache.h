@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include "../db/IDbConnection.h"
+
+/// A utility for re-using prepared statements - statements are identified by their SQL-text, and if a statement with the
+/// same SQL-text is requested again, the statement prepared before is reset (including its bindings) and returned. This
+/// is intended for scenarios where the same statements are executed many times in a row (e.g. when adding a batch of
+/// tiles), so that the cost of preparing the statements is only paid once.
+/// Note that the statements are kept alive as long as this object exists, so the lifetime of the cache should be
+/// restricted to the operation in question.
+class StatementCache
+{
+private:
+    std::shared_ptr<IDbConnection> database_connection_;
+    std::map<std::string, std::shared_ptr<IDbStatement>> statements_;
+public:
+    explicit StatementCache(std::shared_ptr<IDbConnection> database_connection) :
+        database_connection_(std::move(database_connection))
+    {}
+
+    /// Gets a statement for the specified SQL-text - either a statement prepared before (which is reset), or a newly
+    /// prepared statement.
+    ///
+    /// \param  sql_statement   The SQL-text.
+    ///
+    /// \returns    The statement.
+    std::shared_ptr<IDbStatement> GetOrPrepare(const std::string& sql_statement)
+    {
+        const auto iterator = this->statements_.find(sql_statement);
+        if (iterator != this->statements_.end())
+        {
+            iterator->second->Reset();
+            return iterator->second;
+        }
+
+        auto statement = this->database_connection_->PrepareStatement(sql_statement);
+        this->statements_.emplace(sql_statement, statement);
+        return statement;
+    }
+};
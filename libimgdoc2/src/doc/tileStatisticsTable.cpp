@@ -0,0 +1,367 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <type_traits>
+#include "tileStatisticsTable.h"
+
+using namespace std;
+using namespace imgdoc2;
+
+namespace
+{
+    /// Reads a value (of the specified type) from the specified (possibly unaligned) address.
+    template<typename t>
+    t ReadValue(const t* source)
+    {
+        t value;
+        memcpy(&value, source, sizeof(t));
+        return value;
+    }
+}
+
+/*static*/bool TileStatisticsTable::TryCalculate(std::uint8_t pixel_type, imgdoc2::DataTypes data_type, std::uint64_t pixel_count, const imgdoc2::IDataObjBase* data, imgdoc2::TileStatistics& statistics)
+{
+    size_t bytes_per_pixel;
+    switch (pixel_type)
+    {
+        case PixelType::Gray8:
+            bytes_per_pixel = 1;
+            break;
+        case PixelType::Gray16:
+            bytes_per_pixel = 2;
+            break;
+        case PixelType::Gray32Float:
+            bytes_per_pixel = 4;
+            break;
+        default:
+            return false;
+    }
+
+    if (data_type == DataTypes::ZERO)
+    {
+        // all pixels are zero, so all of them are counted in the first bin
+        statistics = TileStatistics{};
+        statistics.pixel_count = pixel_count;
+        statistics.histogram[0] = pixel_count;
+        return true;
+    }
+
+    if ((data_type != DataTypes::UNCOMPRESSED_BITMAP && data_type != DataTypes::UNCOMPRESSED_BRICK && data_type != DataTypes::UNCOMPRESSED_CHUNKED_BRICK) ||
+        data == nullptr)
+    {
+        return false;
+    }
+
+    const void* ptr_data = nullptr;
+    size_t size_data = 0;
+    data->GetData(&ptr_data, &size_data);
+    if (ptr_data == nullptr || size_data / bytes_per_pixel < pixel_count)
+    {
+        return false;
+    }
+
+    switch (pixel_type)
+    {
+        case PixelType::Gray8:
+            CalculateStatistics(static_cast<const uint8_t*>(ptr_data), pixel_count, statistics);
+            break;
+        case PixelType::Gray16:
+            CalculateStatistics(static_cast<const uint16_t*>(ptr_data), pixel_count, statistics);
+            break;
+        default:
+            CalculateStatistics(static_cast<const float*>(ptr_data), pixel_count, statistics);
+            break;
+    }
+
+    return true;
+}
+
+/*static*/void TileStatisticsTable::AddIfApplicable(IDbConnection* connection, StatementCache* statement_cache, const DatabaseConfigurationCommon& configuration, imgdoc2::dbIndex tiles_data_pk, std::uint8_t pixel_type, imgdoc2::DataTypes data_type, std::uint64_t pixel_count, const imgdoc2::IDataObjBase* data)
+{
+    if (!configuration.GetHasTileStatisticsTable())
+    {
+        return;
+    }
+
+    TileStatistics statistics;
+    if (!TileStatisticsTable::TryCalculate(pixel_type, data_type, pixel_count, data, statistics))
+    {
+        return;
+    }
+
+    ostringstream string_stream;
+    string_stream << "INSERT INTO [" << configuration.GetTableNameForTileStatisticsTableOrThrow() << "] ("
+        << "[" << configuration.GetColumnNameOfTileStatisticsTableOrThrow(DatabaseConfigurationCommon::kTileStatisticsTable_Column_Pk) << "],"
+        << "[" << configuration.GetColumnNameOfTileStatisticsTableOrThrow(DatabaseConfigurationCommon::kTileStatisticsTable_Column_PixelCount) << "],"
+        << "[" << configuration.GetColumnNameOfTileStatisticsTableOrThrow(DatabaseConfigurationCommon::kTileStatisticsTable_Column_Minimum) << "],"
+        << "[" << configuration.GetColumnNameOfTileStatisticsTableOrThrow(DatabaseConfigurationCommon::kTileStatisticsTable_Column_Maximum) << "],"
+        << "[" << configuration.GetColumnNameOfTileStatisticsTableOrThrow(DatabaseConfigurationCommon::kTileStatisticsTable_Column_Sum) << "],"
+        << "[" << configuration.GetColumnNameOfTileStatisticsTableOrThrow(DatabaseConfigurationCommon::kTileStatisticsTable_Column_SumOfSquares) << "],"
+        << "[" << configuration.GetColumnNameOfTileStatisticsTableOrThrow(DatabaseConfigurationCommon::kTileStatisticsTable_Column_Histogram) << "]"
+        << ") VALUES( ?1, ?2, ?3, ?4, ?5, ?6, ?7);";
+
+    const auto statement = statement_cache != nullptr ? statement_cache->GetOrPrepare(string_stream.str()) : connection->PrepareStatement(string_stream.str());
+    const auto histogram = TileStatisticsTable::SerializeHistogram(statistics);
+    int binding_index = 1;
+    statement->BindInt64(binding_index++, tiles_data_pk);
+    statement->BindInt64(binding_index++, static_cast<int64_t>(statistics.pixel_count));
+    statement->BindDouble(binding_index++, statistics.minimum);
+    statement->BindDouble(binding_index++, statistics.maximum);
+    statement->BindDouble(binding_index++, statistics.sum);
+    statement->BindDouble(binding_index++, statistics.sum_of_squares);
+    statement->BindBlob_Static(binding_index++, histogram.data(), histogram.size());
+    connection->Execute(statement.get());
+}
+
+/*static*/std::string TileStatisticsTable::GetColumnsForSelect(const DatabaseConfigurationCommon& configuration, const char* table_alias)
+{
+    ostringstream string_stream;
+    string_stream << table_alias << ".[" << configuration.GetColumnNameOfTileStatisticsTableOrThrow(DatabaseConfigurationCommon::kTileStatisticsTable_Column_PixelCount) << "],"
+        << table_alias << ".[" << configuration.GetColumnNameOfTileStatisticsTableOrThrow(DatabaseConfigurationCommon::kTileStatisticsTable_Column_Minimum) << "],"
+        << table_alias << ".[" << configuration.GetColumnNameOfTileStatisticsTableOrThrow(DatabaseConfigurationCommon::kTileStatisticsTable_Column_Maximum) << "],"
+        << table_alias << ".[" << configuration.GetColumnNameOfTileStatisticsTableOrThrow(DatabaseConfigurationCommon::kTileStatisticsTable_Column_Sum) << "],"
+        << table_alias << ".[" << configuration.GetColumnNameOfTileStatisticsTableOrThrow(DatabaseConfigurationCommon::kTileStatisticsTable_Column_SumOfSquares) << "],"
+        << table_alias << ".[" << configuration.GetColumnNameOfTileStatisticsTableOrThrow(DatabaseConfigurationCommon::kTileStatisticsTable_Column_Histogram) << "]";
+    return string_stream.str();
+}
+
+/*static*/bool TileStatisticsTable::TryReadFromStatement(IDbStatement* statement, int first_column, imgdoc2::TileStatistics& statistics)
+{
+    // the columns are declared as "NOT NULL", so a null here means that there is no row for the tile (with a LEFT JOIN)
+    const auto minimum = statement->GetResultDoubleOrNull(first_column + 1);
+    if (!minimum.has_value())
+    {
+        return false;
+    }
+
+    statistics.pixel_count = static_cast<uint64_t>(statement->GetResultInt64(first_column));
+    statistics.minimum = minimum.value();
+    statistics.maximum = statement->GetResultDouble(first_column + 2);
+    statistics.sum = statement->GetResultDouble(first_column + 3);
+    statistics.sum_of_squares = statement->GetResultDouble(first_column + 4);
+    BlobOutputOnHeap histogram_blob;
+    statement->GetResultBlob(first_column + 5, &histogram_blob);
+    TileStatisticsTable::ParseHistogram(histogram_blob.GetDataC(), histogram_blob.GetSizeOfData(), statistics);
+    return true;
+}
+
+/*static*/imgdoc2::TileStatisticsSummary TileStatisticsTable::Aggregate(const std::vector<imgdoc2::TileStatistics>& statistics, std::uint64_t tile_count_without_statistics)
+{
+    TileStatisticsSummary summary;
+    summary.tile_count = statistics.size();
+    summary.tile_count_without_statistics = tile_count_without_statistics;
+
+    double minimum = numeric_limits<double>::infinity();
+    double maximum = -numeric_limits<double>::infinity();
+    for (const auto& tile_statistics : statistics)
+    {
+        if (tile_statistics.pixel_count > 0)
+        {
+            summary.statistics.pixel_count += tile_statistics.pixel_count;
+            summary.statistics.sum += tile_statistics.sum;
+            summary.statistics.sum_of_squares += tile_statistics.sum_of_squares;
+            minimum = min(minimum, tile_statistics.minimum);
+            maximum = max(maximum, tile_statistics.maximum);
+        }
+    }
+
+    if (summary.statistics.pixel_count == 0)
+    {
+        return summary;
+    }
+
+    summary.statistics.minimum = minimum;
+    summary.statistics.maximum = maximum;
+
+    // Now, the histogram sketches of the tiles are re-binned into the histogram covering the aggregated range. We assume that
+    //  the values are uniformly distributed within a bin, so the count of a bin is distributed to the bins of the result
+    //  proportionally to the overlap.
+    constexpr int kBinCount = TileStatistics::kHistogramBinCount;
+    const double bin_width = (maximum - minimum) / kBinCount;
+    array<double, kBinCount> histogram{};
+    for (const auto& tile_statistics : statistics)
+    {
+        if (tile_statistics.pixel_count == 0)
+        {
+            continue;
+        }
+
+        const double tile_bin_width = (tile_statistics.maximum - tile_statistics.minimum) / kBinCount;
+        for (int i = 0; i < kBinCount; ++i)
+        {
+            const auto count = static_cast<double>(tile_statistics.histogram[i]);
+            if (count == 0)
+            {
+                continue;
+            }
+
+            const double start = tile_statistics.minimum + i * tile_bin_width;
+            const double end = start + tile_bin_width;
+            const int first_bin = TileStatisticsTable::GetHistogramBin(start, minimum, maximum);
+            const int last_bin = TileStatisticsTable::GetHistogramBin(end, minimum, maximum);
+            if (tile_bin_width <= 0 || first_bin == last_bin)
+            {
+                histogram[first_bin] += count;
+                continue;
+            }
+
+            for (int bin = first_bin; bin <= last_bin; ++bin)
+            {
+                const double overlap = min(end, minimum + (bin + 1) * bin_width) - max(start, minimum + bin * bin_width);
+                if (overlap > 0)
+                {
+                    histogram[bin] += count * overlap / tile_bin_width;
+                }
+            }
+        }
+    }
+
+    // the counts are rounded down, and the remainder is then given to the bins with the largest fractional parts (so that the
+    //  sum of the counts is equal to the number of pixels)
+    uint64_t total_count = 0;
+    array<int, kBinCount> bins_by_fraction{};
+    for (int i = 0; i < kBinCount; ++i)
+    {
+        summary.statistics.histogram[i] = static_cast<uint64_t>(floor(histogram[i]));
+        total_count += summary.statistics.histogram[i];
+        bins_by_fraction[i] = i;
+    }
+
+    sort(
+        bins_by_fraction.begin(),
+        bins_by_fraction.end(),
+        [&](int a, int b)->bool
+        {
+            return histogram[a] - floor(histogram[a]) > histogram[b] - floor(histogram[b]);
+        });
+    for (size_t i = 0; total_count < summary.statistics.pixel_count; i = (i + 1) % kBinCount)
+    {
+        ++summary.statistics.histogram[bins_by_fraction[i]];
+        ++total_count;
+    }
+
+    return summary;
+}
+
+/*static*/std::vector<std::uint8_t> TileStatisticsTable::SerializeHistogram(const imgdoc2::TileStatistics& statistics)
+{
+    vector<uint8_t> data(kHistogramBlobSize);
+    for (size_t i = 0; i < statistics.histogram.size(); ++i)
+    {
+        for (size_t byte = 0; byte < sizeof(uint64_t); ++byte)
+        {
+            data[i * sizeof(uint64_t) + byte] = static_cast<uint8_t>(statistics.histogram[i] >> (8 * byte));
+        }
+    }
+
+    return data;
+}
+
+/*static*/void TileStatisticsTable::ParseHistogram(const void* data, size_t size, imgdoc2::TileStatistics& statistics)
+{
+    if (data == nullptr || size < kHistogramBlobSize)
+    {
+        throw invalid_operation_exception("The histogram of the tile statistics is invalid (it is too small).");
+    }
+
+    const uint8_t* source = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < statistics.histogram.size(); ++i)
+    {
+        uint64_t value = 0;
+        for (size_t byte = 0; byte < sizeof(uint64_t); ++byte)
+        {
+            value |= static_cast<uint64_t>(source[i * sizeof(uint64_t) + byte]) << (8 * byte);
+        }
+
+        statistics.histogram[i] = value;
+    }
+}
+
+/*static*/int TileStatisticsTable::GetHistogramBin(double value, double minimum, double maximum)
+{
+    // note: with an infinite range or value, the bin may be NaN - and converting NaN to int is undefined behavior
+    const double range = maximum - minimum;
+    if (!(range > 0) || !isfinite(range))
+    {
+        return 0;
+    }
+
+    const double bin = floor((value - minimum) / range * TileStatistics::kHistogramBinCount);
+    if (isnan(bin))
+    {
+        return 0;
+    }
+
+    return static_cast<int>(clamp(bin, 0.0, static_cast<double>(TileStatistics::kHistogramBinCount - 1)));
+}
+
+template<typename t>
+/*static*/void TileStatisticsTable::CalculateStatistics(const t* values, std::uint64_t count, imgdoc2::TileStatistics& statistics)
+{
+    // For integer types, we accumulate the sums exactly (with 64-bit integers) within blocks, which are small enough so that
+    //  no overflow can occur, and then add the block-sums to the (floating-point) total.
+    constexpr uint64_t kBlockSize = 65536;
+    using accumulator_type = conditional_t<is_integral_v<t>, uint64_t, double>;
+
+    statistics = TileStatistics{};
+    t minimum = numeric_limits<t>::max();
+    t maximum = numeric_limits<t>::lowest();
+    for (uint64_t block_start = 0; block_start < count; block_start += kBlockSize)
+    {
+        const uint64_t block_end = min(count, block_start + kBlockSize);
+        accumulator_type sum = 0;
+        accumulator_type sum_of_squares = 0;
+        uint64_t pixel_count = 0;
+        for (uint64_t i = block_start; i < block_end; ++i)
+        {
+            const t value = ReadValue(values + i);
+            if constexpr (is_floating_point_v<t>)
+            {
+                if (!isfinite(value))
+                {
+                    continue;
+                }
+            }
+
+            minimum = min(minimum, value);
+            maximum = max(maximum, value);
+            sum += value;
+            sum_of_squares += static_cast<accumulator_type>(value) * value;
+            ++pixel_count;
+        }
+
+        statistics.pixel_count += pixel_count;
+        statistics.sum += static_cast<double>(sum);
+        statistics.sum_of_squares += static_cast<double>(sum_of_squares);
+    }
+
+    if (statistics.pixel_count == 0)
+    {
+        return;
+    }
+
+    statistics.minimum = minimum;
+    statistics.maximum = maximum;
+
+    // second pass - fill the histogram sketch
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        const t value = ReadValue(values + i);
+        if constexpr (is_floating_point_v<t>)
+        {
+            if (!isfinite(value))
+            {
+                continue;
+            }
+        }
+
+        ++statistics.histogram[TileStatisticsTable::GetHistogramBin(value, statistics.minimum, statistics.maximum)];
+    }
+}
@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <imgdoc2.h>
+#include "../db/IDbConnection.h"
+#include "../db/database_configuration.h"
+#include "statementCache.h"
+
+/// This class gathers the operations on the (optional) tile-statistics table, i.e. the calculation of the statistics of a tile
+/// (when it is added to the document), the storing of the statistics, and the aggregation of the statistics of a set of tiles.
+/// The table contains one row per row of the TILESDATA-table (with the same primary key). The histogram sketch is stored as a
+/// blob with the following binary representation (all values are little-endian):
+/// | offset | type           | description                                                     |
+/// |--------|----------------|-----------------------------------------------------------------|
+/// | 0      | uint64[16]     | the counts of the bins of the histogram sketch                  |
+class TileStatisticsTable
+{
+public:
+    static constexpr size_t kHistogramBlobSize = imgdoc2::TileStatistics::kHistogramBinCount * sizeof(std::uint64_t);   ///< The size of the blob containing the histogram sketch (in bytes).
+
+    /// Calculates the statistics of the specified tile data. This is possible for the pixel types Gray8, Gray16 and Gray32Float, and
+    /// for the data-types ZERO (where no data is required), UNCOMPRESSED_BITMAP, UNCOMPRESSED_BRICK and UNCOMPRESSED_CHUNKED_BRICK (where
+    /// the data is expected to be an uncompressed bitmap or brick without padding).
+    ///
+    /// \param          pixel_type  The pixel type.
+    /// \param          data_type   The data type.
+    /// \param          pixel_count The number of pixels (or voxels) of the tile.
+    /// \param          data        The tile data (may be null for the data-type ZERO).
+    /// \param [out]    statistics  If successful, the statistics are put here.
+    ///
+    /// \returns    True if the statistics could be calculated; false otherwise.
+    static bool TryCalculate(std::uint8_t pixel_type, imgdoc2::DataTypes data_type, std::uint64_t pixel_count, const imgdoc2::IDataObjBase* data, imgdoc2::TileStatistics& statistics);
+
+    /// If the document has a tile-statistics table and the statistics can be calculated for the specified tile, then the statistics
+    /// are calculated and added to the table. Otherwise, nothing is done.
+    ///
+    /// \param  connection      The database connection.
+    /// \param  statement_cache If non-null, the statement is obtained from this cache (so that it is re-used when adding a batch of tiles).
+    /// \param  configuration   The database configuration.
+    /// \param  tiles_data_pk   The primary key of the row in the TILESDATA-table.
+    /// \param  pixel_type      The pixel type.
+    /// \param  data_type       The data type.
+    /// \param  pixel_count     The number of pixels (or voxels) of the tile.
+    /// \param  data            The tile data (may be null).
+    static void AddIfApplicable(IDbConnection* connection, StatementCache* statement_cache, const DatabaseConfigurationCommon& configuration, imgdoc2::dbIndex tiles_data_pk, std::uint8_t pixel_type, imgdoc2::DataTypes data_type, std::uint64_t pixel_count, const imgdoc2::IDataObjBase* data);
+
+    /// Gets the SQL for the columns of the tile-statistics table, in the order as expected by TryReadFromStatement.
+    ///
+    /// \param  configuration   The database configuration.
+    /// \param  table_alias     The alias under which the tile-statistics table is referenced.
+    ///
+    /// \returns    The list of the columns (separated by commas).
+    static std::string GetColumnsForSelect(const DatabaseConfigurationCommon& configuration, const char* table_alias);
+
+    /// Reads the statistics from the current result row of the specified statement, where the columns (starting at the specified
+    /// index) are expected as given by GetColumnsForSelect.
+    ///
+    /// \param          statement       The statement.
+    /// \param          first_column    The index of the first column.
+    /// \param [out]    statistics      If successful, the statistics are put here.
+    ///
+    /// \returns    True if successful; false if the columns are null (i.e. there are no statistics for the tile).
+    static bool TryReadFromStatement(IDbStatement* statement, int first_column, imgdoc2::TileStatistics& statistics);
+
+    /// Aggregates the specified statistics.
+    ///
+    /// \param  statistics                      The statistics of the tiles.
+    /// \param  tile_count_without_statistics   The number of tiles without statistics.
+    ///
+    /// \returns    The aggregated statistics.
+    static imgdoc2::TileStatisticsSummary Aggregate(const std::vector<imgdoc2::TileStatistics>& statistics, std::uint64_t tile_count_without_statistics);
+
+    static std::vector<std::uint8_t> SerializeHistogram(const imgdoc2::TileStatistics& statistics);
+    static void ParseHistogram(const void* data, size_t size, imgdoc2::TileStatistics& statistics);
+private:
+    static int GetHistogramBin(double value, double minimum, double maximum);
+
+    template<typename t>
+    static void CalculateStatistics(const t* values, std::uint64_t count, imgdoc2::TileStatistics& statistics);
+};
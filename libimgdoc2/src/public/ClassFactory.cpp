@@ -130,6 +130,11 @@ static std::uint32_t convert_to_uint32(const char* str)
     return version_info;
 }
 
+/*static*/std::uint64_t imgdoc2::ClassFactory::GetNumberOfStatementsPrepared()
+{
+    return DbFactory::SqliteGetNumberOfStatementsPrepared();
+}
+
 /*static*/std::shared_ptr<imgdoc2::IDoc> imgdoc2::ClassFactory::CreateNew(imgdoc2::ICreateOptions* create_options, std::shared_ptr<IHostingEnvironment> environment)
 {
     // TODO(JBL): here would be the place where we'd allow for "other databases than Sqlite", for the time being,
@@ -15,10 +15,12 @@ class CreateOptions : public imgdoc2::ICreateOptions
 private:
     imgdoc2::DocumentType document_type_ = imgdoc2::DocumentType::kImage2d;
     std::string     filename_;
+    std::string     blob_database_filename_;
     std::unordered_set<Dimension> dimensions_;
     std::unordered_set<Dimension> dimensionsToIndex_;
     bool            use_spatial_index_ = false;
     bool            create_blob_table_ = false;
+    bool            create_tile_statistics_table_ = false;
 public:
     CreateOptions() = default;
 
@@ -52,6 +54,16 @@ public:
         this->create_blob_table_ = create_blob_table;
     }
 
+    void SetBlobDatabaseFilename(const char* filename) override
+    {
+        this->blob_database_filename_ = filename;
+    }
+
+    void SetCreateTileStatisticsTable(bool create_tile_statistics_table) override
+    {
+        this->create_tile_statistics_table_ = create_tile_statistics_table;
+    }
+
     [[nodiscard]] bool GetUseSpatialIndex() const override
     {
         return this->use_spatial_index_;
@@ -83,6 +95,16 @@ public:
     {
         return this->create_blob_table_;
     }
+
+    [[nodiscard]] const std::string& GetBlobDatabaseFilename() const override
+    {
+        return this->blob_database_filename_;
+    }
+
+    [[nodiscard]] bool GetCreateTileStatisticsTable() const override
+    {
+        return this->create_tile_statistics_table_;
+    }
 };
 
 /*static*/ICreateOptions* imgdoc2::ClassFactory::CreateCreateOptionsPtr()
@@ -0,0 +1,226 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include "benchmark_utilities.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <tuple>
+#include <vector>
+
+using namespace std;
+using namespace imgdoc2;
+
+namespace
+{
+    /// The documents are added in batches of this size (within one transaction).
+    constexpr int kBatchSize = 10000;
+}
+
+/*static*/std::int64_t BenchmarkUtilities::GetMaxRowCount()
+{
+    static const int64_t max_row_count = []()->int64_t
+        {
+            const char* value = getenv("IMGDOC2_BENCH_MAX_ROWS");
+            const int64_t count = value != nullptr ? strtoll(value, nullptr, 10) : 0;
+            return count > 0 ? min<int64_t>(count, 10000000) : 100000;
+        }();
+    return max_row_count;
+}
+
+/*static*/void BenchmarkUtilities::RowCountArguments(benchmark::internal::Benchmark* benchmark)
+{
+    for (int64_t row_count = 1000; row_count <= BenchmarkUtilities::GetMaxRowCount(); row_count *= 10)
+    {
+        benchmark->Arg(row_count);
+    }
+}
+
+/*static*/void BenchmarkUtilities::RowCountAndSpatialIndexArguments(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgNames({ "rows", "spatial_index" });
+    for (int64_t row_count = 1000; row_count <= BenchmarkUtilities::GetMaxRowCount(); row_count *= 10)
+    {
+        benchmark->Args({ row_count, 0 });
+        benchmark->Args({ row_count, 1 });
+    }
+}
+
+/*static*/std::int64_t BenchmarkUtilities::GetGridSize(std::int64_t count, int dimensions)
+{
+    auto grid_size = static_cast<int64_t>(pow(static_cast<double>(count), 1.0 / dimensions));
+    while (static_cast<int64_t>(pow(static_cast<double>(grid_size), dimensions)) < count)
+    {
+        ++grid_size;
+    }
+
+    return max<int64_t>(grid_size, 1);
+}
+
+/*static*/std::shared_ptr<imgdoc2::IDoc> BenchmarkUtilities::CreateEmptyDocument2d(bool use_spatial_index)
+{
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetFilename(":memory:");
+    create_options->AddDimension('C');
+    create_options->AddDimension('T');
+    create_options->AddDimension('M');
+    create_options->AddIndexForDimension('C');
+    create_options->AddIndexForDimension('T');
+    create_options->AddIndexForDimension('M');
+    create_options->SetUseSpatialIndex(use_spatial_index);
+    create_options->SetCreateBlobTable(true);
+    return ClassFactory::CreateNew(create_options.get());
+}
+
+/*static*/std::shared_ptr<imgdoc2::IDoc> BenchmarkUtilities::GetDocument2d(std::int64_t tile_count, bool use_spatial_index)
+{
+    static map<tuple<int64_t, bool>, shared_ptr<IDoc>> documents;
+    const auto key = make_tuple(tile_count, use_spatial_index);
+    const auto iterator = documents.find(key);
+    if (iterator != documents.cend())
+    {
+        return iterator->second;
+    }
+
+    auto doc = BenchmarkUtilities::CreateEmptyDocument2d(use_spatial_index);
+    const auto writer = doc->GetWriter2d();
+    const int64_t grid_size = BenchmarkUtilities::GetGridSize(tile_count, 2);
+
+    TileBaseInfo tile_base_info;
+    tile_base_info.pixelWidth = 256;
+    tile_base_info.pixelHeight = 256;
+    tile_base_info.pixelType = PixelType::Gray8;
+
+    vector<TileCoordinate> coordinates(kBatchSize);
+    vector<LogicalPositionInfo> positions(kBatchSize);
+    vector<TileToAdd> tiles(kBatchSize);
+    for (int64_t start = 0; start < tile_count; start += kBatchSize)
+    {
+        const auto count = static_cast<uint32_t>(min<int64_t>(kBatchSize, tile_count - start));
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const int64_t index = start + i;
+            coordinates[i] = TileCoordinate({ { 'C', static_cast<int>(index % 4) }, { 'T', static_cast<int>(index / 4) }, { 'M', static_cast<int>(index) } });
+            positions[i] = LogicalPositionInfo(static_cast<double>(index % grid_size) * 256, static_cast<double>(index / grid_size) * 256, 256, 256, 0);
+            tiles[i].coordinate = &coordinates[i];
+            tiles[i].logical_position_info = &positions[i];
+            tiles[i].tile_base_info = &tile_base_info;
+            tiles[i].data_type = DataTypes::ZERO;
+            tiles[i].storage_type = TileDataStorageType::Invalid;
+        }
+
+        writer->AddTiles(tiles.data(), count, nullptr);
+    }
+
+    documents[key] = doc;
+    return doc;
+}
+
+/*static*/std::shared_ptr<imgdoc2::IDoc> BenchmarkUtilities::GetDocument3d(std::int64_t brick_count, bool use_spatial_index)
+{
+    static map<tuple<int64_t, bool>, shared_ptr<IDoc>> documents;
+    const auto key = make_tuple(brick_count, use_spatial_index);
+    const auto iterator = documents.find(key);
+    if (iterator != documents.cend())
+    {
+        return iterator->second;
+    }
+
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetDocumentType(DocumentType::kImage3d);
+    create_options->SetFilename(":memory:");
+    create_options->AddDimension('C');
+    create_options->AddDimension('M');
+    create_options->SetUseSpatialIndex(use_spatial_index);
+    create_options->SetCreateBlobTable(true);
+    auto doc = ClassFactory::CreateNew(create_options.get());
+    const auto writer = doc->GetWriter3d();
+    const int64_t grid_size = BenchmarkUtilities::GetGridSize(brick_count, 3);
+
+    BrickBaseInfo brick_base_info;
+    brick_base_info.pixelWidth = 64;
+    brick_base_info.pixelHeight = 64;
+    brick_base_info.pixelDepth = 64;
+    brick_base_info.pixelType = PixelType::Gray8;
+
+    vector<TileCoordinate> coordinates(kBatchSize);
+    vector<LogicalPositionInfo3D> positions(kBatchSize);
+    vector<BrickToAdd> bricks(kBatchSize);
+    for (int64_t start = 0; start < brick_count; start += kBatchSize)
+    {
+        const auto count = static_cast<uint32_t>(min<int64_t>(kBatchSize, brick_count - start));
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const int64_t index = start + i;
+            coordinates[i] = TileCoordinate({ { 'C', static_cast<int>(index % 4) }, { 'M', static_cast<int>(index) } });
+            auto& position = positions[i];
+            position.posX = static_cast<double>(index % grid_size) * 64;
+            position.posY = static_cast<double>((index / grid_size) % grid_size) * 64;
+            position.posZ = static_cast<double>(index / (grid_size * grid_size)) * 64;
+            position.width = 64;
+            position.height = 64;
+            position.depth = 64;
+            position.pyrLvl = 0;
+            bricks[i].coordinate = &coordinates[i];
+            bricks[i].logical_position_info = &positions[i];
+            bricks[i].brick_base_info = &brick_base_info;
+            bricks[i].data_type = DataTypes::ZERO;
+            bricks[i].storage_type = TileDataStorageType::Invalid;
+        }
+
+        writer->AddBricks(bricks.data(), count, nullptr);
+    }
+
+    documents[key] = doc;
+    return doc;
+}
+
+/*static*/std::string BenchmarkUtilities::GetMetadataPath(std::int64_t item_number)
+{
+    // the tree has (up to) 100 nodes on the first level, 100 children for each of them, and the leaves below
+    return "L" + to_string(item_number % 100) + "/M" + to_string((item_number / 100) % 100) + "/N" + to_string(item_number / 10000);
+}
+
+/*static*/std::shared_ptr<imgdoc2::IDoc> BenchmarkUtilities::GetDocumentWithMetadata(std::int64_t item_count)
+{
+    static map<int64_t, shared_ptr<IDoc>> documents;
+    const auto iterator = documents.find(item_count);
+    if (iterator != documents.cend())
+    {
+        return iterator->second;
+    }
+
+    auto doc = BenchmarkUtilities::CreateEmptyDocument2d(false);
+    const auto writer = doc->GetWriter2d();
+    const auto metadata_writer = doc->GetDocumentMetadataWriter();
+    for (int64_t start = 0; start < item_count; start += kBatchSize)
+    {
+        writer->BeginTransaction();
+        const int64_t end = min<int64_t>(start + kBatchSize, item_count);
+        for (int64_t i = start; i < end; ++i)
+        {
+            metadata_writer->UpdateOrCreateItemForPath(
+                true,
+                true,
+                BenchmarkUtilities::GetMetadataPath(i),
+                DocumentMetadataType::kInt32,
+                IDocumentMetadataWrite::metadata_item_variant(static_cast<int32_t>(i)));
+        }
+
+        writer->CommitTransaction();
+    }
+
+    documents[item_count] = doc;
+    return doc;
+}
+
+std::int64_t BenchmarkUtilities::RandomSequence::Next(std::int64_t max)
+{
+    // xorshift64*
+    this->state_ ^= this->state_ >> 12;
+    this->state_ ^= this->state_ << 25;
+    this->state_ ^= this->state_ >> 27;
+    return static_cast<int64_t>((this->state_ * 0x2545F4914F6CDD1DULL) % static_cast<uint64_t>(max));
+}
@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <benchmark/benchmark.h>
+#include "../libimgdoc2/inc/imgdoc2.h"
+
+/// Utilities for creating the documents the benchmarks operate on. The documents are created in memory, and they are
+/// cached (since creating a document with millions of rows takes a lot longer than running a benchmark on it) - so,
+/// the benchmarks must not modify those documents.
+class BenchmarkUtilities
+{
+public:
+    /// Gets the maximal number of rows (tiles, bricks or metadata items) for the documents used with the benchmarks. This is
+    /// given by the environment variable "IMGDOC2_BENCH_MAX_ROWS", the default is 100000 and the maximal value is 10000000.
+    /// \returns The maximal number of rows.
+    static std::int64_t GetMaxRowCount();
+
+    /// Adds the row counts (10^3, 10^4, ... up to the maximal row count) as arguments to the specified benchmark.
+    /// \param  benchmark   The benchmark.
+    static void RowCountArguments(benchmark::internal::Benchmark* benchmark);
+
+    /// Adds the row counts (as with RowCountArguments) combined with "without/with spatial index" (0 or 1) as arguments
+    /// to the specified benchmark.
+    /// \param  benchmark   The benchmark.
+    static void RowCountAndSpatialIndexArguments(benchmark::internal::Benchmark* benchmark);
+
+    /// Gets a 2D-document containing the specified number of tiles. The tiles (of size 256x256) are arranged on a square
+    /// grid (row by row), and they have the coordinates C=index%4, T=index/4 and M=index (where "index" is the
+    /// number of the tile, starting with zero). There is no tile data (the data type is "ZERO").
+    /// \param  tile_count          The number of tiles.
+    /// \param  use_spatial_index   Whether the document is to use a spatial index.
+    /// \returns The document.
+    static std::shared_ptr<imgdoc2::IDoc> GetDocument2d(std::int64_t tile_count, bool use_spatial_index);
+
+    /// Gets a 3D-document containing the specified number of bricks. The bricks (of size 64x64x64) are arranged on a
+    /// cubic grid, and they have the coordinates C=index%4 and M=index. There is no brick data (the data type is "ZERO").
+    /// \param  brick_count         The number of bricks.
+    /// \param  use_spatial_index   Whether the document is to use a spatial index.
+    /// \returns The document.
+    static std::shared_ptr<imgdoc2::IDoc> GetDocument3d(std::int64_t brick_count, bool use_spatial_index);
+
+    /// Gets a 2D-document containing the specified number of metadata items (and no tiles). The items are organized in
+    /// a tree with three levels, and they are named "L<index>/M<index>/N<index>" (c.f. GetMetadataPath).
+    /// \param  item_count  The number of (leaf-)items.
+    /// \returns The document.
+    static std::shared_ptr<imgdoc2::IDoc> GetDocumentWithMetadata(std::int64_t item_count);
+
+    /// Gets the path of the metadata item with the specified number (in a document created with GetDocumentWithMetadata).
+    /// \param  item_number The number of the item.
+    /// \returns The path.
+    static std::string GetMetadataPath(std::int64_t item_number);
+
+    /// Gets the number of the grid-cells on each side of the grid for the specified number of items (i.e. the
+    /// square root (or cube root) of the number of items, rounded up).
+    /// \param  count       The number of items.
+    /// \param  dimensions  The number of dimensions of the grid (2 or 3).
+    /// \returns The number of cells on each side of the grid.
+    static std::int64_t GetGridSize(std::int64_t count, int dimensions);
+
+    /// Creates a new (empty) 2D-document in memory (which has the dimensions 'C', 'T' and 'M').
+    /// \param  use_spatial_index   Whether the document is to use a spatial index.
+    /// \returns The newly created document.
+    static std::shared_ptr<imgdoc2::IDoc> CreateEmptyDocument2d(bool use_spatial_index);
+
+    /// A pseudo-random sequence of numbers (with a fixed seed), which is used for choosing the items to be accessed
+    /// in the benchmarks - so that successive accesses are not to adjacent items.
+    class RandomSequence
+    {
+    private:
+        std::uint64_t state_;
+    public:
+        explicit RandomSequence(std::uint64_t seed = 0x2545F4914F6CDD1D) : state_(seed)
+        {}
+
+        /// Gets the next number, in the range [0, max).
+        /// \param  max The upper limit (exclusive).
+        /// \returns The next number.
+        std::int64_t Next(std::int64_t max);
+    };
+};
@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include "benchmark_utilities.h"
+
+using namespace std;
+using namespace imgdoc2;
+
+/// Looks up randomly chosen metadata items by their path (which has three levels).
+static void BM_MetadataGetItemForPath(benchmark::State& state)
+{
+    const int64_t item_count = state.range(0);
+    const auto metadata_reader = BenchmarkUtilities::GetDocumentWithMetadata(item_count)->GetDocumentMetadataReader();
+    BenchmarkUtilities::RandomSequence random_sequence;
+    for (auto _ : state)
+    {
+        const auto item = metadata_reader->GetItemForPath(BenchmarkUtilities::GetMetadataPath(random_sequence.Next(item_count)), DocumentMetadataItemFlags::kAll);
+        benchmark::DoNotOptimize(item);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_MetadataGetItemForPath)->ArgName("rows")->Apply(BenchmarkUtilities::RowCountArguments);
+
+/// Updates the value of randomly chosen (existing) metadata items, which are specified by their path.
+static void BM_MetadataUpdateItemForPath(benchmark::State& state)
+{
+    const int64_t item_count = state.range(0);
+    const auto doc = BenchmarkUtilities::GetDocumentWithMetadata(item_count);
+    const auto metadata_writer = doc->GetDocumentMetadataWriter();
+    BenchmarkUtilities::RandomSequence random_sequence;
+
+    // the changes are rolled back at the end, so that the (cached) document is not modified
+    const auto writer = doc->GetWriter2d();
+    writer->BeginTransaction();
+    for (auto _ : state)
+    {
+        const int64_t item_number = random_sequence.Next(item_count);
+        metadata_writer->UpdateOrCreateItemForPath(
+            false,
+            false,
+            BenchmarkUtilities::GetMetadataPath(item_number),
+            DocumentMetadataType::kInt32,
+            IDocumentMetadataWrite::metadata_item_variant(static_cast<int32_t>(item_number + 1)));
+    }
+
+    writer->RollbackTransaction();
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_MetadataUpdateItemForPath)->ArgName("rows")->Apply(BenchmarkUtilities::RowCountArguments);
+
+/// Enumerates the children of randomly chosen nodes on the second level of the tree, specified by their path.
+static void BM_MetadataEnumerateItemsForPath(benchmark::State& state)
+{
+    const int64_t item_count = state.range(0);
+    const auto metadata_reader = BenchmarkUtilities::GetDocumentWithMetadata(item_count)->GetDocumentMetadataReader();
+    BenchmarkUtilities::RandomSequence random_sequence;
+    int64_t total_result_count = 0;
+    for (auto _ : state)
+    {
+        const int64_t item_number = random_sequence.Next(min<int64_t>(item_count, 10000));
+        const string path = "L" + to_string(item_number % 100) + "/M" + to_string((item_number / 100) % 100);
+        metadata_reader->EnumerateItemsForPath(
+            path,
+            false,
+            DocumentMetadataItemFlags::kPrimaryKeyValid,
+            [&](dbIndex, const DocumentMetadataItem&)->bool { ++total_result_count; return true; });
+    }
+
+    state.SetItemsProcessed(total_result_count);
+}
+
+BENCHMARK(BM_MetadataEnumerateItemsForPath)->ArgName("rows")->Apply(BenchmarkUtilities::RowCountArguments);
+
+/// Looks up batches of randomly chosen metadata items by their path (which has three levels), where the paths of
+/// a batch are resolved together.
+static void BM_MetadataGetItemsForPaths(benchmark::State& state)
+{
+    constexpr size_t kBatchSize = 256;
+    const int64_t item_count = state.range(0);
+    const auto metadata_reader = BenchmarkUtilities::GetDocumentWithMetadata(item_count)->GetDocumentMetadataReader();
+    BenchmarkUtilities::RandomSequence random_sequence;
+    vector<string> paths(kBatchSize);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        for (auto& path : paths)
+        {
+            path = BenchmarkUtilities::GetMetadataPath(random_sequence.Next(item_count));
+        }
+
+        state.ResumeTiming();
+        const auto items = metadata_reader->GetItemsForPaths(paths, DocumentMetadataItemFlags::kAll);
+        benchmark::DoNotOptimize(items);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kBatchSize));
+}
+
+BENCHMARK(BM_MetadataGetItemsForPaths)->ArgName("rows")->Apply(BenchmarkUtilities::RowCountArguments);
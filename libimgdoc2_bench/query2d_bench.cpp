@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include "benchmark_utilities.h"
+
+using namespace std;
+using namespace imgdoc2;
+
+/// Query with a clause for a single dimension, selecting a single tile (M=<random>).
+static void BM_QuerySingleDimensionEquality(benchmark::State& state)
+{
+    const int64_t tile_count = state.range(0);
+    const auto reader = BenchmarkUtilities::GetDocument2d(tile_count, false)->GetReader2d();
+    BenchmarkUtilities::RandomSequence random_sequence;
+    for (auto _ : state)
+    {
+        const int m = static_cast<int>(random_sequence.Next(tile_count));
+        CDimCoordinateQueryClause clause;
+        clause.AddRangeClause('M', IDimCoordinateQueryClause::RangeClause{ m, m });
+        int64_t result_count = 0;
+        reader->Query(&clause, nullptr, [&](dbIndex)->bool { ++result_count; return true; });
+        benchmark::DoNotOptimize(result_count);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_QuerySingleDimensionEquality)->ArgName("rows")->Apply(BenchmarkUtilities::RowCountArguments);
+
+/// Query with a range clause for one dimension combined with an equality clause for another dimension, selecting
+/// about 100 tiles (C=<random> and T in [<random>, <random>+100]).
+static void BM_QueryRangeAndEquality(benchmark::State& state)
+{
+    const int64_t tile_count = state.range(0);
+    const auto reader = BenchmarkUtilities::GetDocument2d(tile_count, false)->GetReader2d();
+    BenchmarkUtilities::RandomSequence random_sequence;
+    int64_t total_result_count = 0;
+    for (auto _ : state)
+    {
+        const int t = static_cast<int>(random_sequence.Next(tile_count / 4));
+        CDimCoordinateQueryClause clause;
+        clause.AddRangeClause('C', IDimCoordinateQueryClause::RangeClause{ t % 4, t % 4 });
+        clause.AddRangeClause('T', IDimCoordinateQueryClause::RangeClause{ t, t + 100 });
+        reader->Query(&clause, nullptr, [&](dbIndex)->bool { ++total_result_count; return true; });
+    }
+
+    state.SetItemsProcessed(total_result_count);
+}
+
+BENCHMARK(BM_QueryRangeAndEquality)->ArgName("rows")->Apply(BenchmarkUtilities::RowCountArguments);
+
+/// Query with a clause for a dimension and a clause for the pyramid level, selecting a quarter of all tiles.
+static void BM_QueryDimensionAndPyramidLevel(benchmark::State& state)
+{
+    const int64_t tile_count = state.range(0);
+    const auto reader = BenchmarkUtilities::GetDocument2d(tile_count, false)->GetReader2d();
+    int64_t total_result_count = 0;
+    for (auto _ : state)
+    {
+        CDimCoordinateQueryClause clause;
+        clause.AddRangeClause('C', IDimCoordinateQueryClause::RangeClause{ 1, 1 });
+        CTileInfoQueryClause tile_info_clause;
+        tile_info_clause.AddPyramidLevelCondition(LogicalOperator::Invalid, ComparisonOperation::Equal, 0);
+        reader->Query(&clause, &tile_info_clause, [&](dbIndex)->bool { ++total_result_count; return true; });
+    }
+
+    state.SetItemsProcessed(total_result_count);
+}
+
+BENCHMARK(BM_QueryDimensionAndPyramidLevel)->ArgName("rows")->Apply(BenchmarkUtilities::RowCountArguments);
+
+/// Query for all tiles (without any clause).
+static void BM_QueryAll(benchmark::State& state)
+{
+    const int64_t tile_count = state.range(0);
+    const auto reader = BenchmarkUtilities::GetDocument2d(tile_count, false)->GetReader2d();
+    int64_t total_result_count = 0;
+    for (auto _ : state)
+    {
+        reader->Query(nullptr, nullptr, [&](dbIndex)->bool { ++total_result_count; return true; });
+    }
+
+    state.SetItemsProcessed(total_result_count);
+}
+
+BENCHMARK(BM_QueryAll)->ArgName("rows")->Apply(BenchmarkUtilities::RowCountArguments);
+
+/// Query for the tiles intersecting a rectangle (at a random position, covering about 4x4 tiles), without or with
+/// the spatial index.
+static void BM_GetTilesIntersectingRect(benchmark::State& state)
+{
+    const int64_t tile_count = state.range(0);
+    const bool use_spatial_index = state.range(1) != 0;
+    const auto reader = BenchmarkUtilities::GetDocument2d(tile_count, use_spatial_index)->GetReader2d();
+    const int64_t grid_size = BenchmarkUtilities::GetGridSize(tile_count, 2);
+    BenchmarkUtilities::RandomSequence random_sequence;
+    int64_t total_result_count = 0;
+    for (auto _ : state)
+    {
+        const RectangleD rectangle(
+            static_cast<double>(random_sequence.Next(grid_size)) * 256 + 10,
+            static_cast<double>(random_sequence.Next(grid_size)) * 256 + 10,
+            3 * 256,
+            3 * 256);
+        reader->GetTilesIntersectingRect(rectangle, nullptr, nullptr, [&](dbIndex)->bool { ++total_result_count; return true; });
+    }
+
+    state.SetItemsProcessed(total_result_count);
+}
+
+BENCHMARK(BM_GetTilesIntersectingRect)->Apply(BenchmarkUtilities::RowCountAndSpatialIndexArguments);
+
+/// Query for the tiles intersecting a rectangle (as above), combined with a clause for a dimension (C=<random>).
+static void BM_GetTilesIntersectingRectWithDimensionClause(benchmark::State& state)
+{
+    const int64_t tile_count = state.range(0);
+    const bool use_spatial_index = state.range(1) != 0;
+    const auto reader = BenchmarkUtilities::GetDocument2d(tile_count, use_spatial_index)->GetReader2d();
+    const int64_t grid_size = BenchmarkUtilities::GetGridSize(tile_count, 2);
+    BenchmarkUtilities::RandomSequence random_sequence;
+    int64_t total_result_count = 0;
+    for (auto _ : state)
+    {
+        const RectangleD rectangle(
+            static_cast<double>(random_sequence.Next(grid_size)) * 256 + 10,
+            static_cast<double>(random_sequence.Next(grid_size)) * 256 + 10,
+            3 * 256,
+            3 * 256);
+        const int c = static_cast<int>(random_sequence.Next(4));
+        CDimCoordinateQueryClause clause;
+        clause.AddRangeClause('C', IDimCoordinateQueryClause::RangeClause{ c, c });
+        reader->GetTilesIntersectingRect(rectangle, &clause, nullptr, [&](dbIndex)->bool { ++total_result_count; return true; });
+    }
+
+    state.SetItemsProcessed(total_result_count);
+}
+
+BENCHMARK(BM_GetTilesIntersectingRectWithDimensionClause)->Apply(BenchmarkUtilities::RowCountAndSpatialIndexArguments);
@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include "benchmark_utilities.h"
+
+using namespace std;
+using namespace imgdoc2;
+
+/// Query for the bricks intersecting a cuboid (at a random position, covering about 3x3x3 bricks), without or with
+/// the spatial index.
+static void BM_GetTilesIntersectingCuboid(benchmark::State& state)
+{
+    const int64_t brick_count = state.range(0);
+    const bool use_spatial_index = state.range(1) != 0;
+    const auto reader = BenchmarkUtilities::GetDocument3d(brick_count, use_spatial_index)->GetReader3d();
+    const int64_t grid_size = BenchmarkUtilities::GetGridSize(brick_count, 3);
+    BenchmarkUtilities::RandomSequence random_sequence;
+    int64_t total_result_count = 0;
+    for (auto _ : state)
+    {
+        const CuboidD cuboid(
+            static_cast<double>(random_sequence.Next(grid_size)) * 64 + 5,
+            static_cast<double>(random_sequence.Next(grid_size)) * 64 + 5,
+            static_cast<double>(random_sequence.Next(grid_size)) * 64 + 5,
+            2 * 64,
+            2 * 64,
+            2 * 64);
+        reader->GetTilesIntersectingCuboid(cuboid, nullptr, nullptr, [&](dbIndex)->bool { ++total_result_count; return true; });
+    }
+
+    state.SetItemsProcessed(total_result_count);
+}
+
+BENCHMARK(BM_GetTilesIntersectingCuboid)->Apply(BenchmarkUtilities::RowCountAndSpatialIndexArguments);
+
+/// Query for the bricks intersecting an axis-aligned plane (z=<random>), without or with the spatial index.
+static void BM_GetTilesIntersectingAxisAlignedPlane(benchmark::State& state)
+{
+    const int64_t brick_count = state.range(0);
+    const bool use_spatial_index = state.range(1) != 0;
+    const auto reader = BenchmarkUtilities::GetDocument3d(brick_count, use_spatial_index)->GetReader3d();
+    const int64_t grid_size = BenchmarkUtilities::GetGridSize(brick_count, 3);
+    BenchmarkUtilities::RandomSequence random_sequence;
+    int64_t total_result_count = 0;
+    for (auto _ : state)
+    {
+        const double z = static_cast<double>(random_sequence.Next(grid_size)) * 64 + 5;
+        const auto plane = Plane_NormalAndDistD::FromThreePoints(Point3dD(0, 0, z), Point3dD(1, 0, z), Point3dD(0, 1, z));
+        reader->GetTilesIntersectingPlane(plane, nullptr, nullptr, [&](dbIndex)->bool { ++total_result_count; return true; });
+    }
+
+    state.SetItemsProcessed(total_result_count);
+}
+
+BENCHMARK(BM_GetTilesIntersectingAxisAlignedPlane)->Apply(BenchmarkUtilities::RowCountAndSpatialIndexArguments);
+
+/// Query for the bricks intersecting an oblique plane (through the center of the volume), without or with the spatial index.
+static void BM_GetTilesIntersectingObliquePlane(benchmark::State& state)
+{
+    const int64_t brick_count = state.range(0);
+    const bool use_spatial_index = state.range(1) != 0;
+    const auto reader = BenchmarkUtilities::GetDocument3d(brick_count, use_spatial_index)->GetReader3d();
+    const double center = static_cast<double>(BenchmarkUtilities::GetGridSize(brick_count, 3)) * 64 / 2;
+    const auto plane = Plane_NormalAndDistD::FromThreePoints(
+        Point3dD(0, 0, center / 2),
+        Point3dD(2 * center, 0, 3 * center / 2),
+        Point3dD(0, 2 * center, center));
+    int64_t total_result_count = 0;
+    for (auto _ : state)
+    {
+        reader->GetTilesIntersectingPlane(plane, nullptr, nullptr, [&](dbIndex)->bool { ++total_result_count; return true; });
+    }
+
+    state.SetItemsProcessed(total_result_count);
+}
+
+BENCHMARK(BM_GetTilesIntersectingObliquePlane)->Apply(BenchmarkUtilities::RowCountAndSpatialIndexArguments);
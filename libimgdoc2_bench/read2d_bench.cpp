@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include <vector>
+#include "benchmark_utilities.h"
+
+using namespace std;
+using namespace imgdoc2;
+
+namespace
+{
+    /// The number of tiles in the document used for the ReadTileData-benchmark.
+    constexpr int kTileCountForReadData = 64;
+
+    shared_ptr<IDoc> CreateDocumentWithTileData(size_t data_size, vector<dbIndex>& primary_keys)
+    {
+        auto doc = BenchmarkUtilities::CreateEmptyDocument2d(false);
+        const auto writer = doc->GetWriter2d();
+        TileBaseInfo tile_base_info;
+        tile_base_info.pixelWidth = 256;
+        tile_base_info.pixelHeight = 256;
+        tile_base_info.pixelType = PixelType::Gray8;
+        DataObjectOnHeap data(data_size);
+        for (int i = 0; i < kTileCountForReadData; ++i)
+        {
+            const TileCoordinate tile_coordinate({ { 'C', 0 }, { 'T', 0 }, { 'M', i } });
+            const LogicalPositionInfo position_info(i * 256, 0, 256, 256, 0);
+            primary_keys.push_back(writer->AddTile(&tile_coordinate, &position_info, &tile_base_info, DataTypes::UNCOMPRESSED_BITMAP, TileDataStorageType::BlobInDatabase, &data));
+        }
+
+        return doc;
+    }
+}
+
+/// Reads the tile information (coordinate and logical position) of randomly chosen tiles.
+static void BM_ReadTileInfo(benchmark::State& state)
+{
+    const int64_t tile_count = state.range(0);
+    const auto reader = BenchmarkUtilities::GetDocument2d(tile_count, false)->GetReader2d();
+
+    // the primary keys are assigned in ascending order, starting with one
+    BenchmarkUtilities::RandomSequence random_sequence;
+    TileCoordinate tile_coordinate;
+    LogicalPositionInfo position_info;
+    for (auto _ : state)
+    {
+        reader->ReadTileInfo(random_sequence.Next(tile_count) + 1, &tile_coordinate, &position_info, nullptr);
+        benchmark::DoNotOptimize(position_info);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_ReadTileInfo)->ArgName("rows")->Apply(BenchmarkUtilities::RowCountArguments);
+
+/// Reads the data of tiles, where the size of the tile data is given as argument.
+static void BM_ReadTileData(benchmark::State& state)
+{
+    const auto data_size = static_cast<size_t>(state.range(0));
+    vector<dbIndex> primary_keys;
+    const auto reader = CreateDocumentWithTileData(data_size, primary_keys)->GetReader2d();
+
+    size_t index = 0;
+    for (auto _ : state)
+    {
+        BlobOutputOnHeap blob_output;
+        reader->ReadTileData(primary_keys[index++ % primary_keys.size()], &blob_output);
+        benchmark::DoNotOptimize(blob_output.GetDataC());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data_size));
+}
+
+BENCHMARK(BM_ReadTileData)->ArgName("bytes")->Arg(1024)->Arg(64 * 1024)->Arg(1024 * 1024)->Arg(16 * 1024 * 1024);
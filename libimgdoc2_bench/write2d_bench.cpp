@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2024 Carl Zeiss Microscopy GmbH
+//
+// SPDX-License-Identifier: MIT
+
+#include <vector>
+#include "benchmark_utilities.h"
+
+using namespace std;
+using namespace imgdoc2;
+
+namespace
+{
+    TileBaseInfo CreateTileBaseInfo()
+    {
+        TileBaseInfo tile_base_info;
+        tile_base_info.pixelWidth = 256;
+        tile_base_info.pixelHeight = 256;
+        tile_base_info.pixelType = PixelType::Gray8;
+        return tile_base_info;
+    }
+}
+
+/// Adds tiles (without data) with AddTile - where each tile is added in a transaction of its own (argument "transaction" is 0),
+/// or all tiles are added within one transaction (argument "transaction" is 1).
+static void BM_AddTile(benchmark::State& state)
+{
+    const bool use_spatial_index = state.range(0) != 0;
+    const bool use_transaction = state.range(1) != 0;
+    const auto doc = BenchmarkUtilities::CreateEmptyDocument2d(use_spatial_index);
+    const auto writer = doc->GetWriter2d();
+    const TileBaseInfo tile_base_info = CreateTileBaseInfo();
+    if (use_transaction)
+    {
+        writer->BeginTransaction();
+    }
+
+    int index = 0;
+    for (auto _ : state)
+    {
+        const TileCoordinate tile_coordinate({ { 'C', index % 4 }, { 'T', index / 4 }, { 'M', index } });
+        const LogicalPositionInfo position_info(index % 1000 * 256, index / 1000 * 256, 256, 256, 0);
+        benchmark::DoNotOptimize(writer->AddTile(&tile_coordinate, &position_info, &tile_base_info, DataTypes::ZERO, TileDataStorageType::Invalid, nullptr));
+        ++index;
+    }
+
+    if (use_transaction)
+    {
+        writer->CommitTransaction();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_AddTile)->ArgNames({ "spatial_index", "transaction" })->Args({ 0, 0 })->Args({ 0, 1 })->Args({ 1, 0 })->Args({ 1, 1 });
+
+/// Adds tiles with data (of the size given as argument) with AddTiles, in batches of 64 tiles.
+static void BM_AddTilesWithData(benchmark::State& state)
+{
+    constexpr uint32_t kBatchSize = 64;
+    const auto data_size = static_cast<size_t>(state.range(0));
+    const auto doc = BenchmarkUtilities::CreateEmptyDocument2d(false);
+    const auto writer = doc->GetWriter2d();
+    const TileBaseInfo tile_base_info = CreateTileBaseInfo();
+    DataObjectOnHeap data(data_size);
+
+    vector<TileCoordinate> coordinates(kBatchSize);
+    vector<LogicalPositionInfo> positions(kBatchSize);
+    vector<TileToAdd> tiles(kBatchSize);
+    int index = 0;
+    for (auto _ : state)
+    {
+        for (uint32_t i = 0; i < kBatchSize; ++i, ++index)
+        {
+            coordinates[i] = TileCoordinate({ { 'C', index % 4 }, { 'T', index / 4 }, { 'M', index } });
+            positions[i] = LogicalPositionInfo(index % 1000 * 256, index / 1000 * 256, 256, 256, 0);
+            tiles[i].coordinate = &coordinates[i];
+            tiles[i].logical_position_info = &positions[i];
+            tiles[i].tile_base_info = &tile_base_info;
+            tiles[i].data_type = DataTypes::UNCOMPRESSED_BITMAP;
+            tiles[i].storage_type = TileDataStorageType::BlobInDatabase;
+            tiles[i].data = &data;
+        }
+
+        writer->AddTiles(tiles.data(), kBatchSize, nullptr);
+    }
+
+    state.SetItemsProcessed(state.iterations() * kBatchSize);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * kBatchSize * data_size));
+}
+
+BENCHMARK(BM_AddTilesWithData)->ArgName("bytes")->Arg(1024)->Arg(64 * 1024)->Arg(1024 * 1024);
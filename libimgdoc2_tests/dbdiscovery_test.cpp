@@ -4,6 +4,7 @@
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <filesystem>
 
 #include "../libimgdoc2/src/db/DbFactory.h"
 #include "../libimgdoc2/src/db/database_creator.h"
@@ -351,3 +352,88 @@ TEST(DbDiscoveryTest, CreateDocument3dAndUseOpenExistingAndCheckContent)
     EXPECT_EQ(tile_blob_info_3d_doc2.base_info.pixelType, PixelType::Gray32Float);
     EXPECT_EQ(tile_blob_info_3d_doc2.data_type, DataTypes::ZERO);
 }
+
+TEST(DbDiscoveryTest, CreateDocument2dWithSeparateBlobDatabaseAndUseOpenExistingAndCheckContent)
+{
+    const auto document_file_name = GenerateUniqueSharedInMemoryFileNameForSqlite(__FILE__, __LINE__);
+    const auto blob_database_file_name = GenerateUniqueSharedInMemoryFileNameForSqlite(__FILE__, __LINE__);
+
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetFilename(document_file_name);
+    create_options->SetBlobDatabaseFilename(blob_database_file_name.c_str());
+    create_options->AddDimension('A');
+    create_options->SetCreateBlobTable(true);
+    const auto doc = ClassFactory::CreateNew(create_options.get());
+    auto writer2d = doc->GetWriter2d();
+
+    LogicalPositionInfo position_info;
+    TileBaseInfo tile_info;
+    position_info.posX = 1;
+    position_info.posY = 2;
+    position_info.width = 3;
+    position_info.height = 4;
+    position_info.pyrLvl = 0;
+    tile_info.pixelWidth = 4;
+    tile_info.pixelHeight = 4;
+    tile_info.pixelType = PixelType::Gray8;
+    const TileCoordinate tile_coordinate({ { 'A', 3} });
+    uint8_t data[16];
+    for (size_t i = 0; i < sizeof(data); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i + 1);
+    }
+
+    DataObjectOnHeap blob_data{ sizeof(data) };
+    memcpy(blob_data.GetData(), data, sizeof(data));
+    writer2d->AddTile(&tile_coordinate, &position_info, &tile_info, DataTypes::UNCOMPRESSED_BITMAP, TileDataStorageType::BlobInDatabase, &blob_data);
+    writer2d.reset();
+
+    // the blob-table must not be present in the main database, but only in the blob-database
+    const auto main_database_connection = DbFactory::SqliteOpenExistingDatabase(document_file_name.c_str(), true);
+    EXPECT_TRUE(main_database_connection->GetTableInfo("BLOBS").empty());
+    const auto blob_database_connection = DbFactory::SqliteOpenExistingDatabase(blob_database_file_name.c_str(), true);
+    EXPECT_FALSE(blob_database_connection->GetTableInfo("BLOBS").empty());
+
+    const auto open_existing_options = ClassFactory::CreateOpenExistingOptionsUp();
+    open_existing_options->SetFilename(document_file_name);
+    open_existing_options->SetOpenReadonly(true);
+    const auto doc2 = ClassFactory::OpenExisting(open_existing_options.get());
+    const auto reader2d = doc2->GetReader2d();
+    vector<dbIndex> tile_indices;
+    reader2d->Query(nullptr, nullptr, [&tile_indices](dbIndex tile_index)->bool {tile_indices.push_back(tile_index); return true; });
+    ASSERT_EQ(tile_indices.size(), 1);
+    BlobOutputOnHeap output_blob;
+    reader2d->ReadTileData(tile_indices[0], &output_blob);
+    ASSERT_TRUE(output_blob.GetHasData());
+    ASSERT_EQ(output_blob.GetSizeOfData(), sizeof(data));
+    EXPECT_EQ(memcmp(output_blob.GetDataC(), data, sizeof(data)), 0);
+}
+
+TEST(DbDiscoveryTest, OpenDocumentWithMissingBlobDatabaseWritableAndExpectErrorAndFileNotCreated)
+{
+    const auto document_file_name = (filesystem::temp_directory_path() / "imgdoc2_missing_blob_database_test.db").u8string();
+    const auto blob_database_file_name = (filesystem::temp_directory_path() / "imgdoc2_missing_blob_database_test_blobs.db").u8string();
+    filesystem::remove(filesystem::u8path(document_file_name));
+    filesystem::remove(filesystem::u8path(blob_database_file_name));
+
+    {
+        const auto create_options = ClassFactory::CreateCreateOptionsUp();
+        create_options->SetFilename(document_file_name.c_str());
+        create_options->SetBlobDatabaseFilename(blob_database_file_name.c_str());
+        create_options->AddDimension('A');
+        create_options->SetCreateBlobTable(true);
+        const auto doc = ClassFactory::CreateNew(create_options.get());
+    }
+
+    ASSERT_TRUE(filesystem::exists(filesystem::u8path(blob_database_file_name)));
+    filesystem::remove(filesystem::u8path(blob_database_file_name));
+
+    // opening the document (writable) must fail, and the blob-database must not be (re-)created as an empty file
+    const auto open_existing_options = ClassFactory::CreateOpenExistingOptionsUp();
+    open_existing_options->SetFilename(document_file_name.c_str());
+    open_existing_options->SetOpenReadonly(false);
+    EXPECT_THROW(ClassFactory::OpenExisting(open_existing_options.get()), discovery_exception);
+    EXPECT_FALSE(filesystem::exists(filesystem::u8path(blob_database_file_name)));
+
+    filesystem::remove(filesystem::u8path(document_file_name));
+}
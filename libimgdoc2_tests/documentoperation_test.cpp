@@ -4,10 +4,14 @@
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <cstring>
+#include <filesystem>
 #include <limits>
+#include <map>
 #include <stdexcept>
 
 #include "../libimgdoc2/inc/imgdoc2.h"
+#include "../libimgdoc2/src/doc/documentCompaction.h"
 #include "utilities.h"
 
 using namespace imgdoc2;
@@ -61,3 +65,648 @@ TEST(DocumentOperation, InATransactionAddTilesThenRollbackExpectOperationsToBeUn
     const auto total_tile_count = reader2d->GetTotalTileCount();
     EXPECT_EQ(total_tile_count, 0);
 }
+
+TEST(DocumentOperation, CreateCompactedCopyAndCheckContent)
+{
+    // arrange
+
+    // create a document (in a file) with a 4x4-grid of tiles on two planes, where the tiles are added in a "scrambled" order
+    const auto source_filename = (filesystem::temp_directory_path() / "imgdoc2_compaction_test_source.db").u8string();
+    const auto destination_filename = (filesystem::temp_directory_path() / "imgdoc2_compaction_test_destination.db").u8string();
+    filesystem::remove(source_filename);
+    filesystem::remove(destination_filename);
+
+    constexpr int kTileSize = 10;
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetFilename(source_filename.c_str());
+    create_options->AddDimension('C');
+    create_options->SetUseSpatialIndex(true);
+    create_options->SetCreateBlobTable(true);
+    {
+        const auto doc = ClassFactory::CreateNew(create_options.get());
+        const auto writer2d = doc->GetWriter2d();
+        writer2d->BeginTransaction();
+        for (int i = 0; i < 32; ++i)
+        {
+            const int n = (i * 13) % 32;  // 13 and 32 are coprime, so this gives a permutation of 0...31
+            const int c = n / 16;
+            const int x = n % 4;
+            const int y = (n / 4) % 4;
+            LogicalPositionInfo position_info{ static_cast<double>(x * kTileSize), static_cast<double>(y * kTileSize), kTileSize, kTileSize };
+            TileBaseInfo tile_info;
+            tile_info.pixelWidth = 2;
+            tile_info.pixelHeight = 2;
+            tile_info.pixelType = PixelType::Gray8;
+            TileCoordinate tile_coordinate({ { 'C', c } });
+            DataObjectOnHeap blob_data{ 4 };
+            memset(blob_data.GetData(), n, 4);
+            writer2d->AddTile(&tile_coordinate, &position_info, &tile_info, DataTypes::UNCOMPRESSED_BITMAP, TileDataStorageType::BlobInDatabase, &blob_data);
+        }
+
+        writer2d->CommitTransaction();
+
+        // act
+        doc->CreateCompactedCopy(destination_filename.c_str());
+    }
+
+    // assert
+    {
+        const auto open_existing_options = ClassFactory::CreateOpenExistingOptionsUp();
+        open_existing_options->SetFilename(destination_filename.c_str());
+        open_existing_options->SetOpenReadonly(true);
+        const auto doc = ClassFactory::OpenExisting(open_existing_options.get());
+        const auto reader2d = doc->GetReader2d();
+        EXPECT_EQ(reader2d->GetTotalTileCount(), 32);
+
+        // every tile must have the expected content, and the tiles of plane C=0 must come before the tiles of plane C=1
+        for (dbIndex pk = 1; pk <= 32; ++pk)
+        {
+            TileCoordinate tile_coordinate;
+            LogicalPositionInfo position_info;
+            reader2d->ReadTileInfo(pk, &tile_coordinate, &position_info, nullptr);
+            int c = 0;
+            ASSERT_TRUE(tile_coordinate.TryGetCoordinate('C', &c));
+            EXPECT_EQ(c, pk <= 16 ? 0 : 1);
+            const int expected_value = c * 16 + static_cast<int>(position_info.posY / kTileSize) * 4 + static_cast<int>(position_info.posX / kTileSize);
+
+            BlobOutputOnHeap blob_output;
+            reader2d->ReadTileData(pk, &blob_output);
+            ASSERT_TRUE(blob_output.GetHasData());
+            ASSERT_EQ(blob_output.GetSizeOfData(), 4);
+            EXPECT_EQ(blob_output.GetDataC()[0], expected_value);
+        }
+
+        // check that the spatial index has been rebuilt correctly
+        vector<dbIndex> result;
+        reader2d->GetTilesIntersectingRect(
+            RectangleD{ 21, 1, 2, 2 },
+            nullptr,
+            nullptr,
+            [&result](dbIndex index)->bool
+            {
+                result.push_back(index);
+                return true;
+            });
+        ASSERT_EQ(result.size(), 2);
+        for (const auto pk : result)
+        {
+            LogicalPositionInfo position_info;
+            reader2d->ReadTileInfo(pk, nullptr, &position_info, nullptr);
+            EXPECT_DOUBLE_EQ(position_info.posX, 20);
+            EXPECT_DOUBLE_EQ(position_info.posY, 0);
+        }
+    }
+
+    filesystem::remove(source_filename);
+    filesystem::remove(destination_filename);
+}
+
+TEST(DocumentOperation, CheckHilbertKeyForSmallGridIsContinuous)
+{
+    // the Hilbert curve visits the cells of a 4x4-grid at the lower left corner before visiting any other cell, and
+    //  consecutive cells on the curve are adjacent
+    map<uint64_t, pair<uint32_t, uint32_t>> cells_by_key;
+    for (uint32_t y = 0; y < 4; ++y)
+    {
+        for (uint32_t x = 0; x < 4; ++x)
+        {
+            cells_by_key[DocumentCompaction::CalculateHilbertKey(x, y)] = make_pair(x, y);
+        }
+    }
+
+    ASSERT_EQ(cells_by_key.size(), 16);
+    EXPECT_EQ(cells_by_key.begin()->first, 0);
+    EXPECT_EQ(cells_by_key.rbegin()->first, 15);
+    for (auto it = next(cells_by_key.cbegin()); it != cells_by_key.cend(); ++it)
+    {
+        const auto& previous = prev(it)->second;
+        const auto& current = it->second;
+        const auto distance = abs(static_cast<int>(previous.first) - static_cast<int>(current.first)) + abs(static_cast<int>(previous.second) - static_cast<int>(current.second));
+        EXPECT_EQ(distance, 1);
+    }
+}
+
+TEST(DocumentOperation, WithAutoCommitPolicyAddTilesWhereOneCallFailsAndCheckThatEarlierTilesAreRetained)
+{
+    // arrange
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetFilename(":memory:");
+    create_options->AddDimension('l');
+    create_options->SetUseSpatialIndex(false);
+    create_options->SetCreateBlobTable(true);
+    const auto doc = ClassFactory::CreateNew(create_options.get());
+    const auto writer2d = doc->GetWriter2d();
+    const auto reader2d = doc->GetReader2d();
+
+    AutoCommitPolicy policy;
+    policy.max_items = 4;
+    writer2d->SetAutoCommitPolicy(policy);
+
+    LogicalPositionInfo position_info(0, 0, 10, 10, 0);
+    TileBaseInfo tile_info;
+    tile_info.pixelWidth = 10;
+    tile_info.pixelHeight = 10;
+    tile_info.pixelType = PixelType::Gray8;
+    const auto add_tile = [&](int l)
+    {
+        const TileCoordinate tile_coordinate({ { 'l', l } });
+        writer2d->AddTile(&tile_coordinate, &position_info, &tile_info, DataTypes::ZERO, TileDataStorageType::Invalid, nullptr);
+    };
+
+    // act
+
+    // add three tiles (which are part of the pending auto-commit transaction), and then a batch where the second tile is
+    //  invalid (the storage type is not supported)
+    add_tile(0);
+    add_tile(1);
+    add_tile(2);
+
+    const TileCoordinate batch_tile_coordinate({ { 'l', 3 } });
+    const uint8_t data[] = { 1, 2, 3, 4 };
+    DataObjectOnHeap data_object(sizeof(data));
+    memcpy(data_object.GetData(), data, sizeof(data));
+    TileToAdd batch[2];
+    for (auto& tile_to_add : batch)
+    {
+        tile_to_add.coordinate = &batch_tile_coordinate;
+        tile_to_add.logical_position_info = &position_info;
+        tile_to_add.tile_base_info = &tile_info;
+    }
+
+    batch[1].data_type = DataTypes::UNCOMPRESSED_BITMAP;
+    batch[1].storage_type = TileDataStorageType::Invalid;
+    batch[1].data = &data_object;
+    EXPECT_THROW(writer2d->AddTiles(batch, 2, nullptr), exception);
+
+    // assert
+
+    // the failed batch is rolled back, but the three tiles added before are retained
+    EXPECT_EQ(reader2d->GetTotalTileCount(), 3);
+
+    // the fourth tile reaches the limit, so the transaction is committed, and the fifth tile starts a new one...
+    add_tile(3);
+    add_tile(4);
+    EXPECT_EQ(reader2d->GetTotalTileCount(), 5);
+
+    // ...which we can roll back (without affecting the tiles committed before)
+    writer2d->RollbackTransaction();
+    EXPECT_EQ(reader2d->GetTotalTileCount(), 4);
+    EXPECT_EQ(writer2d->GetAutoCommitPolicy().max_items, 4);
+}
+
+TEST(DocumentOperation, WithAutoCommitPolicyCheckThatPendingTransactionIsCommittedWhenWriterIsDestroyed)
+{
+    // arrange
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetFilename(":memory:");
+    create_options->AddDimension('l');
+    create_options->SetUseSpatialIndex(false);
+    create_options->SetCreateBlobTable(true);
+    const auto doc = ClassFactory::CreateNew(create_options.get());
+
+    LogicalPositionInfo position_info(0, 0, 10, 10, 0);
+    TileBaseInfo tile_info;
+    tile_info.pixelWidth = 2;
+    tile_info.pixelHeight = 2;
+    tile_info.pixelType = PixelType::Gray8;
+    DataObjectOnHeap data_object(4);
+    memset(data_object.GetData(), 0, 4);
+
+    // act
+    {
+        const auto writer2d = doc->GetWriter2d();
+        AutoCommitPolicy policy;
+        policy.max_bytes = 1000;
+        writer2d->SetAutoCommitPolicy(policy);
+        for (int i = 0; i < 10; ++i)
+        {
+            const TileCoordinate tile_coordinate({ { 'l', i } });
+            writer2d->AddTile(&tile_coordinate, &position_info, &tile_info, DataTypes::UNCOMPRESSED_BITMAP, TileDataStorageType::BlobInDatabase, &data_object);
+        }
+    }
+
+    // assert
+
+    // the pending transaction must have been committed, so we can start a new transaction and roll it back without losing the tiles
+    const auto writer2d = doc->GetWriter2d();
+    writer2d->BeginTransaction();
+    writer2d->RollbackTransaction();
+    EXPECT_EQ(doc->GetReader2d()->GetTotalTileCount(), 10);
+}
+
+TEST(DocumentOperation, SetUserPropertiesAndReadThemAndCheckResult)
+{
+    // arrange
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetFilename(":memory:");
+    create_options->AddDimension('l');
+    const auto doc = ClassFactory::CreateNew(create_options.get());
+    const auto writer2d = doc->GetWriter2d();
+    const auto reader2d = doc->GetReader2d();
+
+    // act
+    writer2d->SetUserProperty("Progress", "42");
+    writer2d->SetUserProperty("Source", "it's a file");
+    writer2d->SetUserProperty("Progress", "43");
+
+    // assert
+    string value;
+    EXPECT_TRUE(reader2d->TryGetUserProperty("Progress", &value));
+    EXPECT_EQ(value, "43");
+    EXPECT_TRUE(reader2d->TryGetUserProperty("Source", &value));
+    EXPECT_EQ(value, "it's a file");
+    EXPECT_FALSE(reader2d->TryGetUserProperty("DocType", &value));
+    EXPECT_FALSE(reader2d->TryGetUserProperty("NotExisting", nullptr));
+    EXPECT_THROW(writer2d->SetUserProperty("", "abc"), invalid_argument_exception);
+}
+
+TEST(DocumentOperation, WithAutoCommitPolicySetUserPropertyAndCheckThatItIsCommittedTogetherWithTiles)
+{
+    // arrange
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetFilename(":memory:");
+    create_options->AddDimension('l');
+    create_options->SetUseSpatialIndex(false);
+    const auto doc = ClassFactory::CreateNew(create_options.get());
+    const auto writer2d = doc->GetWriter2d();
+    const auto reader2d = doc->GetReader2d();
+
+    AutoCommitPolicy policy;
+    policy.max_items = 2;
+    writer2d->SetAutoCommitPolicy(policy);
+
+    LogicalPositionInfo position_info(0, 0, 10, 10, 0);
+    TileBaseInfo tile_info;
+    tile_info.pixelWidth = 10;
+    tile_info.pixelHeight = 10;
+    tile_info.pixelType = PixelType::Gray8;
+    const auto add_tile = [&](int l)
+    {
+        const TileCoordinate tile_coordinate({ { 'l', l } });
+        writer2d->AddTile(&tile_coordinate, &position_info, &tile_info, DataTypes::ZERO, TileDataStorageType::Invalid, nullptr);
+    };
+
+    // act
+
+    // the property is set before the tiles, and the second tile reaches the limit - so the property is committed with them
+    writer2d->SetUserProperty("Progress", "2");
+    add_tile(0);
+    add_tile(1);
+
+    // now, setting the property starts a new auto-commit transaction, which we then roll back
+    writer2d->SetUserProperty("Progress", "3");
+    add_tile(2);
+    writer2d->RollbackTransaction();
+
+    // assert
+    string value;
+    EXPECT_TRUE(reader2d->TryGetUserProperty("Progress", &value));
+    EXPECT_EQ(value, "2");
+    EXPECT_EQ(reader2d->GetTotalTileCount(), 2);
+}
+
+/// Creates a 2D-document (in a file) with a 4x4-grid of tiles (of size 10x10) on the planes C=0 and C=1, where the data of
+/// each tile is 4 bytes with the value "value_offset + c * 16 + y * 4 + x".
+static void CreateDocumentWithGridOfTiles(const string& filename, int value_offset)
+{
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetFilename(filename.c_str());
+    create_options->AddDimension('C');
+    create_options->SetUseSpatialIndex(true);
+    create_options->SetCreateBlobTable(true);
+    const auto doc = ClassFactory::CreateNew(create_options.get());
+    const auto writer2d = doc->GetWriter2d();
+    writer2d->BeginTransaction();
+    for (int n = 0; n < 32; ++n)
+    {
+        LogicalPositionInfo position_info{ static_cast<double>((n % 4) * 10), static_cast<double>(((n / 4) % 4) * 10), 10, 10 };
+        TileBaseInfo tile_info;
+        tile_info.pixelWidth = 2;
+        tile_info.pixelHeight = 2;
+        tile_info.pixelType = PixelType::Gray8;
+        TileCoordinate tile_coordinate({ { 'C', n / 16 } });
+        DataObjectOnHeap blob_data{ 4 };
+        memset(blob_data.GetData(), value_offset + n, 4);
+        writer2d->AddTile(&tile_coordinate, &position_info, &tile_info, DataTypes::UNCOMPRESSED_BITMAP, TileDataStorageType::BlobInDatabase, &blob_data);
+    }
+
+    writer2d->CommitTransaction();
+}
+
+/// Reads all tiles of the specified document, and returns a map of the value of the tile data to the number of tiles with this
+/// value - where it is checked that the value matches the position and the plane of the tile (c.f. CreateDocumentWithGridOfTiles).
+static map<int, int> ReadAndCheckTilesOfGrid(const shared_ptr<IDocRead2d>& reader2d)
+{
+    map<int, int> values;
+    reader2d->Query(
+        nullptr,
+        nullptr,
+        [&](dbIndex pk)->bool
+        {
+            TileCoordinate tile_coordinate;
+            LogicalPositionInfo position_info;
+            reader2d->ReadTileInfo(pk, &tile_coordinate, &position_info, nullptr);
+            int c = 0;
+            EXPECT_TRUE(tile_coordinate.TryGetCoordinate('C', &c));
+            BlobOutputOnHeap blob_output;
+            reader2d->ReadTileData(pk, &blob_output);
+            EXPECT_TRUE(blob_output.GetHasData());
+            EXPECT_EQ(blob_output.GetSizeOfData(), 4);
+            const int value = blob_output.GetDataC()[0];
+            EXPECT_EQ(value % 100, c * 16 + static_cast<int>(position_info.posY / 10) * 4 + static_cast<int>(position_info.posX / 10));
+            ++values[value];
+            return true;
+        });
+
+    return values;
+}
+
+TEST(DocumentOperation, MergeTwoDocumentsAndCheckContent)
+{
+    // arrange
+    const auto source1_filename = (filesystem::temp_directory_path() / "imgdoc2_merge_test_source1.db").u8string();
+    const auto source2_filename = (filesystem::temp_directory_path() / "imgdoc2_merge_test_source2.db").u8string();
+    const auto destination_filename = (filesystem::temp_directory_path() / "imgdoc2_merge_test_destination.db").u8string();
+    filesystem::remove(source1_filename);
+    filesystem::remove(source2_filename);
+    filesystem::remove(destination_filename);
+    CreateDocumentWithGridOfTiles(source1_filename, 0);
+    CreateDocumentWithGridOfTiles(source2_filename, 100);
+
+    const auto open_existing_options = ClassFactory::CreateOpenExistingOptionsUp();
+    open_existing_options->SetFilename(source1_filename.c_str());
+    {
+        const auto doc = ClassFactory::OpenExisting(open_existing_options.get());
+        doc->GetDocumentMetadataWriter()->UpdateOrCreateItemForPath(true, true, "A/B", DocumentMetadataType::kText, IDocumentMetadataWrite::metadata_item_variant("Testtext"));
+
+        // act
+        doc->CreateSubsetCopy(destination_filename.c_str(), nullptr);
+    }
+
+    open_existing_options->SetFilename(destination_filename.c_str());
+    {
+        const auto doc = ClassFactory::OpenExisting(open_existing_options.get());
+        doc->ImportTiles(source2_filename.c_str(), nullptr);
+    }
+
+    // assert
+    {
+        const auto doc = ClassFactory::OpenExisting(open_existing_options.get());
+        const auto reader2d = doc->GetReader2d();
+        EXPECT_EQ(reader2d->GetTotalTileCount(), 64);
+
+        // every tile of both documents must be present exactly once
+        const auto values = ReadAndCheckTilesOfGrid(reader2d);
+        ASSERT_EQ(values.size(), 64);
+        for (const auto& value : values)
+        {
+            EXPECT_EQ(value.second, 1);
+        }
+
+        // check that the spatial index contains the tiles of both documents
+        vector<dbIndex> result;
+        reader2d->GetTilesIntersectingRect(
+            RectangleD{ 21, 1, 2, 2 },
+            nullptr,
+            nullptr,
+            [&result](dbIndex index)->bool
+            {
+                result.push_back(index);
+                return true;
+            });
+        EXPECT_EQ(result.size(), 4);
+
+        const auto item = doc->GetDocumentMetadataReader()->GetItemForPath("A/B", DocumentMetadataItemFlags::kAll);
+        EXPECT_EQ(item.type, DocumentMetadataType::kText);
+        EXPECT_STREQ(get<string>(item.value).c_str(), "Testtext");
+    }
+
+    filesystem::remove(source1_filename);
+    filesystem::remove(source2_filename);
+    filesystem::remove(destination_filename);
+}
+
+TEST(DocumentOperation, MergeDocumentWithBlobTableIntoDocumentWithoutBlobTableAndCheckResult)
+{
+    // arrange
+    const auto source1_filename = (filesystem::temp_directory_path() / "imgdoc2_merge_noblobs_test_source1.db").u8string();
+    const auto source2_filename = (filesystem::temp_directory_path() / "imgdoc2_merge_noblobs_test_source2.db").u8string();
+    const auto destination_filename = (filesystem::temp_directory_path() / "imgdoc2_merge_noblobs_test_destination.db").u8string();
+    filesystem::remove(source1_filename);
+    filesystem::remove(source2_filename);
+    filesystem::remove(destination_filename);
+
+    // the first source has a blob-table, but its tiles have no data
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetFilename(source1_filename.c_str());
+    create_options->AddDimension('C');
+    create_options->SetCreateBlobTable(true);
+    {
+        const auto doc = ClassFactory::CreateNew(create_options.get());
+        const auto writer2d = doc->GetWriter2d();
+        for (int n = 0; n < 4; ++n)
+        {
+            LogicalPositionInfo position_info{ static_cast<double>(n * 10), 0, 10, 10 };
+            TileBaseInfo tile_info;
+            tile_info.pixelWidth = 2;
+            tile_info.pixelHeight = 2;
+            tile_info.pixelType = PixelType::Gray8;
+            TileCoordinate tile_coordinate({ { 'C', 0 } });
+            writer2d->AddTile(&tile_coordinate, &position_info, &tile_info, DataTypes::ZERO, TileDataStorageType::Invalid, nullptr);
+        }
+    }
+
+    // the second source has a blob-table, and its tiles have data
+    CreateDocumentWithGridOfTiles(source2_filename, 0);
+
+    create_options->SetFilename(destination_filename.c_str());
+    create_options->SetCreateBlobTable(false);
+    ClassFactory::CreateNew(create_options.get());
+
+    const auto open_existing_options = ClassFactory::CreateOpenExistingOptionsUp();
+    open_existing_options->SetFilename(destination_filename.c_str());
+    {
+        const auto doc = ClassFactory::OpenExisting(open_existing_options.get());
+
+        // act
+        doc->ImportTiles(source1_filename.c_str(), nullptr);
+
+        // the tiles with data cannot be imported, and the destination document must be left unchanged
+        EXPECT_THROW(doc->ImportTiles(source2_filename.c_str(), nullptr), invalid_operation_exception);
+    }
+
+    // assert
+    {
+        const auto doc = ClassFactory::OpenExisting(open_existing_options.get());
+        const auto reader2d = doc->GetReader2d();
+        EXPECT_EQ(reader2d->GetTotalTileCount(), 4);
+        reader2d->Query(
+            nullptr,
+            nullptr,
+            [&](dbIndex pk)->bool
+            {
+                TileBlobInfo tile_blob_info;
+                reader2d->ReadTileInfo(pk, nullptr, nullptr, &tile_blob_info);
+                EXPECT_EQ(tile_blob_info.data_type, DataTypes::ZERO);
+                return true;
+            });
+    }
+
+    filesystem::remove(source1_filename);
+    filesystem::remove(source2_filename);
+    filesystem::remove(destination_filename);
+}
+
+TEST(DocumentOperation, CreateSubsetCopyWithRectangleAndPlaneAndCheckContent)
+{
+    // arrange
+    const auto source_filename = (filesystem::temp_directory_path() / "imgdoc2_subset_test_source.db").u8string();
+    const auto destination_filename = (filesystem::temp_directory_path() / "imgdoc2_subset_test_destination.db").u8string();
+    filesystem::remove(source_filename);
+    filesystem::remove(destination_filename);
+    CreateDocumentWithGridOfTiles(source_filename, 0);
+
+    const auto open_existing_options = ClassFactory::CreateOpenExistingOptionsUp();
+    open_existing_options->SetFilename(source_filename.c_str());
+    open_existing_options->SetOpenReadonly(true);
+    {
+        const auto doc = ClassFactory::OpenExisting(open_existing_options.get());
+        CDimCoordinateQueryClause coordinate_clause;
+        coordinate_clause.AddRangeClause('C', IDimCoordinateQueryClause::RangeClause{ 1, 1 });
+        TileSelection selection;
+        selection.coordinate_clause = &coordinate_clause;
+        selection.rectangle = RectangleD{ 15, 5, 10, 10 };
+
+        // act
+        doc->CreateSubsetCopy(destination_filename.c_str(), &selection);
+    }
+
+    // assert
+    {
+        open_existing_options->SetFilename(destination_filename.c_str());
+        const auto doc = ClassFactory::OpenExisting(open_existing_options.get());
+        const auto reader2d = doc->GetReader2d();
+        EXPECT_EQ(reader2d->GetTotalTileCount(), 4);
+
+        // we expect the tiles at x=10,20 and y=0,10 on the plane C=1
+        const auto values = ReadAndCheckTilesOfGrid(reader2d);
+        EXPECT_THAT(values, ElementsAre(Pair(17, 1), Pair(18, 1), Pair(21, 1), Pair(22, 1)));
+    }
+
+    filesystem::remove(source_filename);
+    filesystem::remove(destination_filename);
+}
+
+TEST(DocumentOperation, CreateSubsetCopyOfDocumentWithSeparateBlobDatabaseAndCheckThatNoPartialCopyIsLeftBehind)
+{
+    // arrange
+    const auto source_filename = (filesystem::temp_directory_path() / "imgdoc2_subset_failure_test_source.db").u8string();
+    const auto source_blob_database_filename = (filesystem::temp_directory_path() / "imgdoc2_subset_failure_test_source_blobs.db").u8string();
+    const auto destination_filename = (filesystem::temp_directory_path() / "imgdoc2_subset_failure_test_destination.db").u8string();
+    filesystem::remove(source_filename);
+    filesystem::remove(source_blob_database_filename);
+    filesystem::remove(destination_filename);
+    {
+        const auto create_options = ClassFactory::CreateCreateOptionsUp();
+        create_options->SetFilename(source_filename.c_str());
+        create_options->SetBlobDatabaseFilename(source_blob_database_filename.c_str());
+        create_options->AddDimension('C');
+        create_options->SetCreateBlobTable(true);
+        const auto doc = ClassFactory::CreateNew(create_options.get());
+        const auto writer2d = doc->GetWriter2d();
+        LogicalPositionInfo position_info{ 0, 0, 10, 10 };
+        TileBaseInfo tile_info;
+        tile_info.pixelWidth = 2;
+        tile_info.pixelHeight = 2;
+        tile_info.pixelType = PixelType::Gray8;
+        TileCoordinate tile_coordinate({ { 'C', 0 } });
+        DataObjectOnHeap blob_data{ 4 };
+        memset(blob_data.GetData(), 1, 4);
+        writer2d->AddTile(&tile_coordinate, &position_info, &tile_info, DataTypes::UNCOMPRESSED_BITMAP, TileDataStorageType::BlobInDatabase, &blob_data);
+    }
+
+    const auto open_existing_options = ClassFactory::CreateOpenExistingOptionsUp();
+    open_existing_options->SetFilename(source_filename.c_str());
+    open_existing_options->SetOpenReadonly(true);
+    {
+        const auto doc = ClassFactory::OpenExisting(open_existing_options.get());
+
+        // act - a subset copy is not supported for a document with a separate blob-database, which is only detected
+        //  after the destination document has been created
+        EXPECT_THROW(doc->CreateSubsetCopy(destination_filename.c_str(), nullptr), invalid_operation_exception);
+    }
+
+    // assert
+    EXPECT_FALSE(filesystem::exists(destination_filename));
+
+    filesystem::remove(source_filename);
+    filesystem::remove(source_blob_database_filename);
+    filesystem::remove(destination_filename);
+}
+
+TEST(DocumentOperation, ImportChunkedBrickIntoDocumentWithExistingBricksAndCheckContent)
+{
+    // arrange
+    const auto source_filename = (filesystem::temp_directory_path() / "imgdoc2_import_test_source.db").u8string();
+    const auto destination_filename = (filesystem::temp_directory_path() / "imgdoc2_import_test_destination.db").u8string();
+    filesystem::remove(source_filename);
+    filesystem::remove(destination_filename);
+
+    constexpr uint32_t kSize = 10;
+    BrickBaseInfo brick_base_info;
+    brick_base_info.pixelWidth = kSize;
+    brick_base_info.pixelHeight = kSize;
+    brick_base_info.pixelDepth = kSize;
+    brick_base_info.pixelType = PixelType::Gray8;
+    const LogicalPositionInfo3D position_info{ 0, 0, 0, kSize, kSize, kSize, 0 };
+    DataObjectOnHeap brick_data{ kSize * kSize * kSize };
+    for (size_t i = 0; i < brick_data.GetSizeOfData(); ++i)
+    {
+        static_cast<uint8_t*>(brick_data.GetData())[i] = static_cast<uint8_t>(i * 7 + i / 251);
+    }
+
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetDocumentType(DocumentType::kImage3d);
+    create_options->AddDimension('M');
+    create_options->SetUseSpatialIndex(true);
+    create_options->SetCreateBlobTable(true);
+    for (const auto& filename : { source_filename, destination_filename })
+    {
+        create_options->SetFilename(filename.c_str());
+        const auto doc = ClassFactory::CreateNew(create_options.get());
+        const TileCoordinate tile_coordinate({ { 'M', 1 } });
+        doc->GetWriter3d()->AddChunkedBrick(&tile_coordinate, &position_info, &brick_base_info, BrickChunkExtent{ 4, 4, 4 }, TileDataStorageType::BlobInDatabase, &brick_data);
+    }
+
+    // act
+    const auto open_existing_options = ClassFactory::CreateOpenExistingOptionsUp();
+    open_existing_options->SetFilename(destination_filename.c_str());
+    const auto doc = ClassFactory::OpenExisting(open_existing_options.get());
+    doc->ImportTiles(source_filename.c_str(), nullptr);
+
+    // assert
+    const auto reader3d = doc->GetReader3d();
+    EXPECT_EQ(reader3d->GetTotalTileCount(), 2);
+    vector<dbIndex> result;
+    reader3d->GetTilesIntersectingCuboid(
+        CuboidD{ 1, 1, 1, 1, 1, 1 },
+        nullptr,
+        nullptr,
+        [&result](dbIndex index)->bool
+        {
+            result.push_back(index);
+            return true;
+        });
+    ASSERT_EQ(result.size(), 2);
+    for (const auto pk : result)
+    {
+        BlobOutputOnHeap sub_volume;
+        reader3d->ReadBrickSubVolume(pk, CuboidI{ 0, 0, 0, kSize, kSize, kSize }, &sub_volume);
+        ASSERT_TRUE(sub_volume.GetHasData());
+        ASSERT_EQ(sub_volume.GetSizeOfData(), brick_data.GetSizeOfData());
+        EXPECT_EQ(memcmp(sub_volume.GetDataC(), brick_data.GetDataC(), brick_data.GetSizeOfData()), 0);
+    }
+
+    filesystem::remove(source_filename);
+    filesystem::remove(destination_filename);
+}
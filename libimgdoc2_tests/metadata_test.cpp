@@ -187,6 +187,32 @@ TEST(Metadata, AddMetadataItemsWithPathAndCheckIfTheyAreAdded_Scenario1)
     EXPECT_STREQ(get<string>(item.value).c_str(), "Testtext3");
 }
 
+TEST(Metadata, UpdateExistingMetadataItemsWithPathAndCheckResult)
+{
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetFilename(":memory:");
+    create_options->AddDimension('M');
+    const auto doc = ClassFactory::CreateNew(create_options.get());
+    const auto metadata_writer = doc->GetDocumentMetadataWriter();
+
+    const auto id1 = metadata_writer->UpdateOrCreateItemForPath(true, true, "A/B/C", DocumentMetadataType::kText, IDocumentMetadataWrite::metadata_item_variant("Testtext"));
+    const auto id2 = metadata_writer->UpdateOrCreateItemForPath(true, true, "A/B/C", DocumentMetadataType::kInt32, IDocumentMetadataWrite::metadata_item_variant(1234));
+    const auto id3 = metadata_writer->UpdateOrCreateItemForPath(false, false, "A/B/C", DocumentMetadataType::kText, IDocumentMetadataWrite::metadata_item_variant("Testtext2"));
+    EXPECT_EQ(id1, id2);
+    EXPECT_EQ(id1, id3);
+
+    const auto metadata_reader = doc->GetDocumentMetadataReader();
+    const auto item = metadata_reader->GetItemForPath("A/B/C", DocumentMetadataItemFlags::kAll);
+    EXPECT_STREQ(item.name.c_str(), "C");
+    EXPECT_EQ(item.type, DocumentMetadataType::kText);
+    EXPECT_STREQ(get<string>(item.value).c_str(), "Testtext2");
+
+    // the node "C" must not have any children (i.e. the update must not have created a node "A/B/C/C")
+    int count_of_children = 0;
+    metadata_reader->EnumerateItemsForPath("A/B/C", true, DocumentMetadataItemFlags::kPrimaryKeyValid, [&](dbIndex, const DocumentMetadataItem&)->bool { ++count_of_children; return true; });
+    EXPECT_EQ(count_of_children, 0);
+}
+
 TEST(Metadata, EnumerateItems_Scenario1)
 {
     // Arrange
@@ -1410,6 +1436,100 @@ TEST(Metadata, EnumerateItemsFullPathCheckResult_Scenario2)
     EXPECT_TRUE(all_true);
 }
 
+TEST(Metadata, GetItemsForPathsAndCheckResult)
+{
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetFilename(":memory:");
+    create_options->AddDimension('M');
+    const auto doc = ClassFactory::CreateNew(create_options.get());
+    const auto metadata_writer = doc->GetDocumentMetadataWriter();
+
+    // we create enough items so that more than one query is necessary to resolve all of them
+    constexpr int kNumberOfItems = 300;
+    vector<string> paths;
+    vector<dbIndex> primary_keys;
+    for (int i = 0; i < kNumberOfItems; ++i)
+    {
+        paths.emplace_back("A/B/Item" + to_string(i));
+        primary_keys.push_back(metadata_writer->UpdateOrCreateItemForPath(true, true, paths.back(), DocumentMetadataType::kInt32, IDocumentMetadataWrite::metadata_item_variant(i)));
+    }
+
+    // add some paths which do not exist (or which are only partially existing), a duplicate and the empty path
+    paths.emplace_back("A/B/ItemX");
+    paths.emplace_back("A/X/Item1");
+    paths.emplace_back("A/B/Item1/C");
+    paths.emplace_back("A/B/Item5");
+    paths.emplace_back("");
+
+    const auto metadata_reader = doc->GetDocumentMetadataReader();
+    const auto items = metadata_reader->GetItemsForPaths(paths, DocumentMetadataItemFlags::kAll);
+    ASSERT_EQ(items.size(), paths.size());
+    for (int i = 0; i < kNumberOfItems; ++i)
+    {
+        ASSERT_TRUE(items[i].has_value());
+        EXPECT_EQ(items[i]->primary_key, primary_keys[i]);
+        EXPECT_EQ(items[i]->name, "Item" + to_string(i));
+        EXPECT_EQ(items[i]->type, DocumentMetadataType::kInt32);
+        EXPECT_EQ(get<int>(items[i]->value), i);
+    }
+
+    EXPECT_FALSE(items[kNumberOfItems].has_value());
+    EXPECT_FALSE(items[kNumberOfItems + 1].has_value());
+    EXPECT_FALSE(items[kNumberOfItems + 2].has_value());
+    ASSERT_TRUE(items[kNumberOfItems + 3].has_value());
+    EXPECT_EQ(items[kNumberOfItems + 3]->primary_key, primary_keys[5]);
+    EXPECT_FALSE(items[kNumberOfItems + 4].has_value());
+
+    // now all existing paths are resolved from the cache, the result must be the same
+    const auto items_second_call = metadata_reader->GetItemsForPaths(paths, DocumentMetadataItemFlags::kPrimaryKeyValid);
+    ASSERT_EQ(items_second_call.size(), paths.size());
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        ASSERT_EQ(items_second_call[i].has_value(), items[i].has_value());
+        if (items[i].has_value())
+        {
+            EXPECT_EQ(items_second_call[i]->primary_key, items[i]->primary_key);
+        }
+    }
+
+    EXPECT_THROW(metadata_reader->GetItemsForPaths({ "A/B/Item1", "/A/B" }, DocumentMetadataItemFlags::kAll), invalid_path_exception);
+    EXPECT_THROW(metadata_reader->GetItemsForPaths({ "A//B" }, DocumentMetadataItemFlags::kAll), invalid_path_exception);
+}
+
+TEST(Metadata, DeleteAndRecreateItemsAndCheckThatPathsAreResolvedCorrectly)
+{
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetFilename(":memory:");
+    create_options->AddDimension('M');
+    const auto doc = ClassFactory::CreateNew(create_options.get());
+    const auto metadata_writer = doc->GetDocumentMetadataWriter();
+    const auto metadata_reader = doc->GetDocumentMetadataReader();
+
+    const auto id1 = metadata_writer->UpdateOrCreateItemForPath(true, true, "A/B/C", DocumentMetadataType::kText, IDocumentMetadataWrite::metadata_item_variant("Testtext"));
+    EXPECT_EQ(metadata_reader->GetItemForPath("A/B/C", DocumentMetadataItemFlags::kPrimaryKeyValid).primary_key, id1);
+
+    // delete the node (and the subtree) and re-create it, it must then be found with its new primary key
+    metadata_writer->DeleteItemForPath("A", true);
+    EXPECT_THROW(metadata_reader->GetItemForPath("A/B/C", DocumentMetadataItemFlags::kPrimaryKeyValid), invalid_path_exception);
+    const auto id2 = metadata_writer->UpdateOrCreateItemForPath(true, true, "A/B/C", DocumentMetadataType::kText, IDocumentMetadataWrite::metadata_item_variant("Testtext2"));
+    auto item = metadata_reader->GetItemForPath("A/B/C", DocumentMetadataItemFlags::kAll);
+    EXPECT_EQ(item.primary_key, id2);
+    EXPECT_EQ(get<string>(item.value), "Testtext2");
+
+    // now do the same inside a transaction, which is then rolled back - afterwards, the original node must be found again
+    const auto writer = doc->GetWriter2d();
+    writer->BeginTransaction();
+    metadata_writer->DeleteItemForPath("A/B/C", false);
+    EXPECT_THROW(metadata_reader->GetItemForPath("A/B/C", DocumentMetadataItemFlags::kPrimaryKeyValid), invalid_path_exception);
+    const auto id3 = metadata_writer->UpdateOrCreateItemForPath(false, true, "A/B/C", DocumentMetadataType::kText, IDocumentMetadataWrite::metadata_item_variant("Testtext3"));
+    EXPECT_EQ(metadata_reader->GetItemForPath("A/B/C", DocumentMetadataItemFlags::kPrimaryKeyValid).primary_key, id3);
+    writer->RollbackTransaction();
+
+    item = metadata_reader->GetItemForPath("A/B/C", DocumentMetadataItemFlags::kAll);
+    EXPECT_EQ(item.primary_key, id2);
+    EXPECT_EQ(get<string>(item.value), "Testtext2");
+}
+
 struct WithDifferentDocumentMetadataItemFlagsFixture : public testing::TestWithParam<DocumentMetadataItemFlags>
 {
 };
@@ -186,6 +186,42 @@ TEST(Miscellaneous, Document3dCheckTransactionSemantic)
     EXPECT_THROW(writer3d->CommitTransaction(), database_exception);
 }
 
+TEST(Miscellaneous, AddTilesAsBatchAndCheckThatStatementsAreReused)
+{
+    // when adding a batch of tiles with "AddTiles", the statements are prepared once and then re-used - so, the number of
+    //  statements prepared must be independent of the number of tiles
+    constexpr int kTileCount = 50;
+
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetFilename(":memory:");
+    create_options->AddDimension('p');
+    create_options->SetUseSpatialIndex(true);
+    create_options->SetCreateBlobTable(false);
+    const auto doc = ClassFactory::CreateNew(create_options.get());
+    const auto writer2d = doc->GetWriter2d();
+
+    const TileCoordinate tile_coordinate({ { 'p', 1 } });
+    const LogicalPositionInfo position_info{ 0, 0, 10, 10, 0 };
+    TileBaseInfo tile_base_info;
+    tile_base_info.pixelWidth = 10;
+    tile_base_info.pixelHeight = 10;
+    tile_base_info.pixelType = PixelType::Gray8;
+    vector<TileToAdd> tiles_to_add(kTileCount);
+    for (auto& tile_to_add : tiles_to_add)
+    {
+        tile_to_add.coordinate = &tile_coordinate;
+        tile_to_add.logical_position_info = &position_info;
+        tile_to_add.tile_base_info = &tile_base_info;
+        tile_to_add.data_type = DataTypes::ZERO;
+    }
+
+    const auto number_of_statements_prepared_before = ClassFactory::GetNumberOfStatementsPrepared();
+    writer2d->AddTiles(tiles_to_add.data(), kTileCount, nullptr);
+    const auto number_of_statements_prepared = ClassFactory::GetNumberOfStatementsPrepared() - number_of_statements_prepared_before;
+    EXPECT_LT(number_of_statements_prepared, kTileCount);
+    EXPECT_EQ(doc->GetReader2d()->GetTotalTileCount(), kTileCount);
+}
+
 TEST(Miscellaneous, DoubleInterval)
 {
     const DoubleInterval interval1{ 1.0, 2.0 };
@@ -92,3 +92,319 @@ TEST(Read2d, CreateDocumentAddSingleTileReadTileInfoCheckForCorrectness)
     ASSERT_EQ(dimensions_read.size(), 1);
     ASSERT_EQ(dimensions_read[0], 'M');
 }
+
+TEST(Read2d, GetTileDataSizeAndCompareWithSizeOfTileData)
+{
+    // we add a tile with data and a tile without data (of data-type ZERO), and check that "GetTileDataSize" reports the
+    //  size of the data as it is read with "ReadTileData"
+    constexpr size_t kBLOB_SIZE = 1234;
+
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetFilename(":memory:");
+    create_options->AddDimension('M');
+    create_options->SetCreateBlobTable(true);
+
+    const auto doc = ClassFactory::CreateNew(create_options.get());
+    const auto reader = doc->GetReader2d();
+    const auto writer = doc->GetWriter2d();
+
+    LogicalPositionInfo position_info{ 0, 0, 10, 10, 0 };
+    TileBaseInfo tile_info;
+    tile_info.pixelWidth = 10;
+    tile_info.pixelHeight = 10;
+    tile_info.pixelType = PixelType::Gray8;
+    const TileCoordinate tc({ { 'M', 1 } });
+
+    const DataObjectOnHeap blob_data{ kBLOB_SIZE };
+    const auto pk_with_data = writer->AddTile(&tc, &position_info, &tile_info, DataTypes::ZSTD0COMPRESSED_BITMAP, TileDataStorageType::BlobInDatabase, &blob_data);
+    const auto pk_without_data = writer->AddTile(&tc, &position_info, &tile_info, DataTypes::ZERO, TileDataStorageType::BlobInDatabase, nullptr);
+
+    EXPECT_EQ(reader->GetTileDataSize(pk_with_data), kBLOB_SIZE);
+    BlobOutputOnHeap tile_data;
+    reader->ReadTileData(pk_with_data, &tile_data);
+    EXPECT_EQ(tile_data.GetSizeOfData(), kBLOB_SIZE);
+
+    EXPECT_EQ(reader->GetTileDataSize(pk_without_data), 0);
+
+    EXPECT_THROW(reader->GetTileDataSize(pk_with_data + pk_without_data + 1), non_existing_tile_exception);
+}
+
+TEST(Read2d, AddTilesAsBatchAndReadTilesCheckForCorrectness)
+{
+    // we add a batch of tiles (with and without data) with "AddTiles", and then check that the tiles can be read back
+    //  with the expected information and data
+    constexpr uint32_t kTileCount = 10;
+
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetFilename(":memory:");
+    create_options->AddDimension('M');
+    create_options->SetUseSpatialIndex(true);
+    create_options->SetCreateBlobTable(true);
+
+    const auto doc = ClassFactory::CreateNew(create_options.get());
+    const auto reader = doc->GetReader2d();
+    const auto writer = doc->GetWriter2d();
+
+    vector<TileCoordinate> coordinates;
+    vector<LogicalPositionInfo> position_infos;
+    vector<TileBaseInfo> tile_infos;
+    vector<vector<uint8_t>> tile_data;
+    vector<unique_ptr<DataObjectOnHeap>> data_objects;
+    for (uint32_t i = 0; i < kTileCount; ++i)
+    {
+        coordinates.emplace_back(TileCoordinate({ { 'M', static_cast<int>(i) } }));
+        position_infos.push_back(LogicalPositionInfo{ static_cast<double>(i) * 10, 0, 10, 10, 0 });
+        TileBaseInfo tile_info;
+        tile_info.pixelWidth = 10;
+        tile_info.pixelHeight = 10;
+        tile_info.pixelType = PixelType::Gray8;
+        tile_infos.push_back(tile_info);
+        tile_data.emplace_back(vector<uint8_t>(100, static_cast<uint8_t>(i)));
+        data_objects.emplace_back(make_unique<DataObjectOnHeap>(tile_data.back().size()));
+        memcpy(data_objects.back()->GetData(), tile_data.back().data(), tile_data.back().size());
+    }
+
+    vector<TileToAdd> tiles_to_add(kTileCount);
+    for (uint32_t i = 0; i < kTileCount; ++i)
+    {
+        // every third tile is added without data
+        const bool has_data = i % 3 != 0;
+        tiles_to_add[i].coordinate = &coordinates[i];
+        tiles_to_add[i].logical_position_info = &position_infos[i];
+        tiles_to_add[i].tile_base_info = &tile_infos[i];
+        tiles_to_add[i].data_type = has_data ? DataTypes::UNCOMPRESSED_BITMAP : DataTypes::ZERO;
+        tiles_to_add[i].data = has_data ? data_objects[i].get() : nullptr;
+    }
+
+    vector<dbIndex> pks(kTileCount);
+    writer->AddTiles(tiles_to_add.data(), kTileCount, pks.data());
+
+    for (uint32_t i = 0; i < kTileCount; ++i)
+    {
+        TileCoordinate tile_coordinate_read;
+        LogicalPositionInfo logical_position_info;
+        TileBlobInfo tile_blob_info;
+        reader->ReadTileInfo(pks[i], &tile_coordinate_read, &logical_position_info, &tile_blob_info);
+        int m_read;
+        ASSERT_TRUE(tile_coordinate_read.TryGetCoordinate('M', &m_read));
+        EXPECT_EQ(m_read, static_cast<int>(i));
+        EXPECT_EQ(logical_position_info, position_infos[i]);
+        EXPECT_EQ(tile_blob_info.data_type, tiles_to_add[i].data_type);
+        if (tiles_to_add[i].data != nullptr)
+        {
+            BlobOutputOnHeap blob_output;
+            reader->ReadTileData(pks[i], &blob_output);
+            ASSERT_EQ(blob_output.GetSizeOfData(), tile_data[i].size());
+            EXPECT_EQ(memcmp(blob_output.GetDataC(), tile_data[i].data(), tile_data[i].size()), 0);
+        }
+        else
+        {
+            EXPECT_EQ(reader->GetTileDataSize(pks[i]), 0);
+        }
+    }
+
+    // the spatial index must contain the tiles as well
+    vector<dbIndex> indices;
+    const RectangleD query_rectangle{ 15, 1, 20, 1 };
+    reader->GetTilesIntersectingRect(query_rectangle, nullptr, nullptr, [&](dbIndex index)->bool {indices.push_back(index); return true; });
+    EXPECT_THAT(indices, UnorderedElementsAre(pks[1], pks[2], pks[3]));
+
+    // if adding one of the tiles fails, then none of the tiles of the batch is added
+    tiles_to_add[kTileCount - 1].storage_type = TileDataStorageType::Invalid;
+    tiles_to_add[kTileCount - 1].data = data_objects[kTileCount - 1].get();
+    EXPECT_THROW(writer->AddTiles(tiles_to_add.data(), kTileCount, nullptr), invalid_operation_exception);
+    EXPECT_EQ(reader->GetTotalTileCount(), kTileCount);
+}
+
+TEST(Read2d, AddTilesWithTileStatisticsAndReadStatisticsCheckForCorrectness)
+{
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetFilename(":memory:");
+    create_options->AddDimension('M');
+    create_options->SetUseSpatialIndex(true);
+    create_options->SetCreateBlobTable(true);
+    create_options->SetCreateTileStatisticsTable(true);
+
+    const auto doc = ClassFactory::CreateNew(create_options.get());
+    const auto reader = doc->GetReader2d();
+    const auto writer = doc->GetWriter2d();
+
+    // a Gray8-tile with the values 0, 1, ..., 31 (and a not-a-number float-tile further below)
+    TileBaseInfo tile_info;
+    tile_info.pixelWidth = 8;
+    tile_info.pixelHeight = 4;
+    tile_info.pixelType = PixelType::Gray8;
+    DataObjectOnHeap gray8_data{ 32 };
+    for (size_t i = 0; i < gray8_data.GetSizeOfData(); ++i)
+    {
+        static_cast<uint8_t*>(gray8_data.GetData())[i] = static_cast<uint8_t>(i);
+    }
+
+    TileCoordinate tc({ { 'M', 0 } });
+    LogicalPositionInfo position_info{ 0, 0, 8, 4, 0 };
+    const auto pk_gray8 = writer->AddTile(&tc, &position_info, &tile_info, DataTypes::UNCOMPRESSED_BITMAP, TileDataStorageType::BlobInDatabase, &gray8_data);
+
+    // a ZERO-tile
+    tc = TileCoordinate({ { 'M', 1 } });
+    position_info = LogicalPositionInfo{ 100, 0, 8, 4, 0 };
+    const auto pk_zero = writer->AddTile(&tc, &position_info, &tile_info, DataTypes::ZERO, TileDataStorageType::Invalid, nullptr);
+
+    // a Gray32Float-tile with the values 1, 2, 3 and a NaN
+    tile_info.pixelWidth = 2;
+    tile_info.pixelHeight = 2;
+    tile_info.pixelType = PixelType::Gray32Float;
+    const float float_values[] = { 1, 2, 3, numeric_limits<float>::quiet_NaN() };
+    DataObjectOnHeap float_data{ sizeof(float_values) };
+    memcpy(float_data.GetData(), float_values, sizeof(float_values));
+    tc = TileCoordinate({ { 'M', 2 } });
+    position_info = LogicalPositionInfo{ 0, 0, 2, 2, 0 };
+    const auto pk_float = writer->AddTile(&tc, &position_info, &tile_info, DataTypes::UNCOMPRESSED_BITMAP, TileDataStorageType::BlobInDatabase, &float_data);
+
+    // a Bgr24-tile, for which no statistics are calculated
+    tile_info.pixelType = PixelType::Bgr24;
+    DataObjectOnHeap bgr24_data{ 2 * 2 * 3 };
+    tc = TileCoordinate({ { 'M', 0 } });
+    position_info = LogicalPositionInfo{ 4, 0, 2, 2, 0 };
+    const auto pk_bgr24 = writer->AddTile(&tc, &position_info, &tile_info, DataTypes::UNCOMPRESSED_BITMAP, TileDataStorageType::BlobInDatabase, &bgr24_data);
+
+    TileStatistics statistics;
+    ASSERT_TRUE(reader->TryReadTileStatistics(pk_gray8, &statistics));
+    EXPECT_EQ(statistics.pixel_count, 32);
+    EXPECT_DOUBLE_EQ(statistics.minimum, 0);
+    EXPECT_DOUBLE_EQ(statistics.maximum, 31);
+    EXPECT_DOUBLE_EQ(statistics.GetMean(), 15.5);
+    EXPECT_DOUBLE_EQ(statistics.sum_of_squares, 31 * 32 * 63 / 6);
+    for (int i = 0; i < TileStatistics::kHistogramBinCount; ++i)
+    {
+        EXPECT_EQ(statistics.histogram[i], 2) << "bin " << i;
+    }
+
+    ASSERT_TRUE(reader->TryReadTileStatistics(pk_zero, &statistics));
+    EXPECT_EQ(statistics.pixel_count, 32);
+    EXPECT_DOUBLE_EQ(statistics.minimum, 0);
+    EXPECT_DOUBLE_EQ(statistics.maximum, 0);
+    EXPECT_EQ(statistics.histogram[0], 32);
+
+    ASSERT_TRUE(reader->TryReadTileStatistics(pk_float, &statistics));
+    EXPECT_EQ(statistics.pixel_count, 3);
+    EXPECT_DOUBLE_EQ(statistics.minimum, 1);
+    EXPECT_DOUBLE_EQ(statistics.maximum, 3);
+    EXPECT_DOUBLE_EQ(statistics.GetMean(), 2);
+    EXPECT_EQ(statistics.histogram[0], 1);
+    EXPECT_EQ(statistics.histogram[8], 1);
+    EXPECT_EQ(statistics.histogram[15], 1);
+
+    EXPECT_FALSE(reader->TryReadTileStatistics(pk_bgr24, &statistics));
+    EXPECT_THROW(reader->TryReadTileStatistics(12345, &statistics), non_existing_tile_exception);
+
+    // the tiles intersecting the rectangle (0,0,10,10) on plane M=0 are the Gray8-tile and the Bgr24-tile
+    CDimCoordinateQueryClause coordinate_query_clause;
+    coordinate_query_clause.AddRangeClause('M', IDimCoordinateQueryClause::RangeClause{ 0, 0 });
+    const RectangleD rect{ 0, 0, 10, 10 };
+    auto summary = reader->GetTileStatisticsSummary(&rect, &coordinate_query_clause, nullptr);
+    EXPECT_EQ(summary.tile_count, 1);
+    EXPECT_EQ(summary.tile_count_without_statistics, 1);
+    EXPECT_EQ(summary.statistics.pixel_count, 32);
+    EXPECT_DOUBLE_EQ(summary.statistics.GetMean(), 15.5);
+
+    // all tiles - the range is now [0,31] (so the bin width is 1.9375), and the values of the float-tile are distributed to the first two bins
+    summary = reader->GetTileStatisticsSummary(nullptr, nullptr, nullptr);
+    EXPECT_EQ(summary.tile_count, 3);
+    EXPECT_EQ(summary.tile_count_without_statistics, 1);
+    EXPECT_EQ(summary.statistics.pixel_count, 32 + 32 + 3);
+    EXPECT_DOUBLE_EQ(summary.statistics.minimum, 0);
+    EXPECT_DOUBLE_EQ(summary.statistics.maximum, 31);
+    EXPECT_DOUBLE_EQ(summary.statistics.sum, 31 * 32 / 2 + 6);
+    uint64_t total_count = 0;
+    for (const auto count : summary.statistics.histogram)
+    {
+        total_count += count;
+    }
+
+    EXPECT_EQ(total_count, summary.statistics.pixel_count);
+    EXPECT_EQ(summary.statistics.histogram[0], 2 + 32 + 1);
+    EXPECT_EQ(summary.statistics.histogram[1], 2 + 2);
+
+    // the rectangle does not intersect with any tile
+    const RectangleD rect_empty{ 1000, 1000, 10, 10 };
+    summary = reader->GetTileStatisticsSummary(&rect_empty, nullptr, nullptr);
+    EXPECT_EQ(summary.tile_count, 0);
+    EXPECT_EQ(summary.statistics.pixel_count, 0);
+}
+
+TEST(Read2d, AddFloatTileWithInfiniteValuesAndCheckThatTheyAreIgnoredInTileStatistics)
+{
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetFilename(":memory:");
+    create_options->AddDimension('M');
+    create_options->SetCreateBlobTable(true);
+    create_options->SetCreateTileStatisticsTable(true);
+
+    const auto doc = ClassFactory::CreateNew(create_options.get());
+    const auto reader = doc->GetReader2d();
+    const auto writer = doc->GetWriter2d();
+
+    // a Gray32Float-tile with the values 1, 3, +inf, -inf and a NaN
+    TileBaseInfo tile_info;
+    tile_info.pixelWidth = 5;
+    tile_info.pixelHeight = 1;
+    tile_info.pixelType = PixelType::Gray32Float;
+    const float float_values[] = { 1, numeric_limits<float>::infinity(), 3, -numeric_limits<float>::infinity(), numeric_limits<float>::quiet_NaN() };
+    DataObjectOnHeap float_data{ sizeof(float_values) };
+    memcpy(float_data.GetData(), float_values, sizeof(float_values));
+    TileCoordinate tc({ { 'M', 0 } });
+    LogicalPositionInfo position_info{ 0, 0, 5, 1, 0 };
+    const auto pk_float = writer->AddTile(&tc, &position_info, &tile_info, DataTypes::UNCOMPRESSED_BITMAP, TileDataStorageType::BlobInDatabase, &float_data);
+
+    // a Gray32Float-tile with only infinite values
+    const float infinite_values[] = { numeric_limits<float>::infinity(), -numeric_limits<float>::infinity() };
+    tile_info.pixelWidth = 2;
+    DataObjectOnHeap infinite_data{ sizeof(infinite_values) };
+    memcpy(infinite_data.GetData(), infinite_values, sizeof(infinite_values));
+    tc = TileCoordinate({ { 'M', 1 } });
+    position_info = LogicalPositionInfo{ 0, 0, 2, 1, 0 };
+    const auto pk_infinite = writer->AddTile(&tc, &position_info, &tile_info, DataTypes::UNCOMPRESSED_BITMAP, TileDataStorageType::BlobInDatabase, &infinite_data);
+
+    TileStatistics statistics;
+    ASSERT_TRUE(reader->TryReadTileStatistics(pk_float, &statistics));
+    EXPECT_EQ(statistics.pixel_count, 2);
+    EXPECT_DOUBLE_EQ(statistics.minimum, 1);
+    EXPECT_DOUBLE_EQ(statistics.maximum, 3);
+    EXPECT_DOUBLE_EQ(statistics.sum, 4);
+    EXPECT_EQ(statistics.histogram[0], 1);
+    EXPECT_EQ(statistics.histogram[TileStatistics::kHistogramBinCount - 1], 1);
+
+    ASSERT_TRUE(reader->TryReadTileStatistics(pk_infinite, &statistics));
+    EXPECT_EQ(statistics.pixel_count, 0);
+
+    const auto summary = reader->GetTileStatisticsSummary(nullptr, nullptr, nullptr);
+    EXPECT_EQ(summary.statistics.pixel_count, 2);
+    EXPECT_DOUBLE_EQ(summary.statistics.minimum, 1);
+    EXPECT_DOUBLE_EQ(summary.statistics.maximum, 3);
+    EXPECT_DOUBLE_EQ(summary.statistics.sum, 4);
+    EXPECT_EQ(summary.statistics.histogram[0], 1);
+    EXPECT_EQ(summary.statistics.histogram[TileStatistics::kHistogramBinCount - 1], 1);
+}
+
+TEST(Read2d, GetTileStatisticsForDocumentWithoutTileStatisticsTable)
+{
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetFilename(":memory:");
+    create_options->AddDimension('M');
+
+    const auto doc = ClassFactory::CreateNew(create_options.get());
+    const auto reader = doc->GetReader2d();
+    const auto writer = doc->GetWriter2d();
+
+    TileBaseInfo tile_info;
+    tile_info.pixelWidth = 8;
+    tile_info.pixelHeight = 4;
+    tile_info.pixelType = PixelType::Gray8;
+    const TileCoordinate tc({ { 'M', 0 } });
+    const LogicalPositionInfo position_info{ 0, 0, 8, 4, 0 };
+    const auto pk = writer->AddTile(&tc, &position_info, &tile_info, DataTypes::ZERO, TileDataStorageType::Invalid, nullptr);
+
+    TileStatistics statistics;
+    EXPECT_FALSE(reader->TryReadTileStatistics(pk, &statistics));
+    EXPECT_THROW(reader->GetTileStatisticsSummary(nullptr, nullptr, nullptr), invalid_operation_exception);
+}
@@ -4,7 +4,10 @@
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <cstring>
+#include <limits>
 #include "../libimgdoc2/inc/imgdoc2.h"
+#include "../libimgdoc2/src/doc/brickChunkIndex.h"
 
 using namespace std;
 using namespace imgdoc2;
@@ -100,3 +103,274 @@ TEST(Read3d, CreateDocumentAddSingleTileReadTileInfoCheckForCorrectness)
     ASSERT_EQ(dimensions_read.size(), 1);
     ASSERT_EQ(dimensions_read[0], 'M');
 }
+
+static vector<uint8_t> ExtractSubVolume(const uint8_t* brick, uint32_t brick_width, uint32_t brick_height, size_t bytes_per_voxel, const CuboidI& roi)
+{
+    vector<uint8_t> result;
+    for (int32_t z = roi.z; z < roi.z + roi.d; ++z)
+    {
+        for (int32_t y = roi.y; y < roi.y + roi.h; ++y)
+        {
+            const uint8_t* line = brick + ((static_cast<size_t>(z) * brick_height + y) * brick_width + roi.x) * bytes_per_voxel;
+            result.insert(result.end(), line, line + roi.w * bytes_per_voxel);
+        }
+    }
+
+    return result;
+}
+
+TEST(Read3d, AddChunkedBrickAndReadSubVolumesCheckForCorrectness)
+{
+    constexpr uint32_t kWidth = 20;
+    constexpr uint32_t kHeight = 17;
+    constexpr uint32_t kDepth = 13;
+    constexpr size_t kBytesPerVoxel = 2;
+
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetDocumentType(DocumentType::kImage3d);
+    create_options->SetFilename(":memory:");
+    create_options->AddDimension('M');
+    create_options->SetCreateBlobTable(true);
+
+    const auto doc = ClassFactory::CreateNew(create_options.get());
+    const auto reader = doc->GetReader3d();
+    const auto writer = doc->GetWriter3d();
+
+    const LogicalPositionInfo3D position_info{ 0, 0, 0, kWidth, kHeight, kDepth, 0 };
+    BrickBaseInfo brick_base_info;
+    brick_base_info.pixelWidth = kWidth;
+    brick_base_info.pixelHeight = kHeight;
+    brick_base_info.pixelDepth = kDepth;
+    brick_base_info.pixelType = PixelType::Gray16;
+    const TileCoordinate tc({ { 'M', 1 } });
+
+    DataObjectOnHeap brick_data{ kWidth * kHeight * kDepth * kBytesPerVoxel };
+    for (size_t i = 0; i < brick_data.GetSizeOfData(); ++i)
+    {
+        static_cast<uint8_t*>(brick_data.GetData())[i] = static_cast<uint8_t>(i * 7 + i / 251);
+    }
+
+    const BrickChunkExtent chunk_extent{ 8, 8, 4 };
+    const auto pk = writer->AddChunkedBrick(&tc, &position_info, &brick_base_info, chunk_extent, TileDataStorageType::BlobInDatabase, &brick_data);
+
+    BrickBlobInfo brick_blob_info;
+    reader->ReadBrickInfo(pk, nullptr, nullptr, &brick_blob_info);
+    EXPECT_EQ(brick_blob_info.data_type, DataTypes::UNCOMPRESSED_CHUNKED_BRICK);
+
+    const CuboidI rois[] =
+    {
+        CuboidI{ 0, 0, 0, kWidth, kHeight, kDepth },
+        CuboidI{ 0, 0, 0, 1, 1, 1 },
+        CuboidI{ 3, 5, 2, 1, 1, 1 },
+        CuboidI{ 7, 7, 3, 2, 2, 2 },        // crosses the chunk borders in all directions
+        CuboidI{ 0, 0, 6, kWidth, kHeight, 1 },
+        CuboidI{ 11, 2, 0, 1, 14, kDepth },
+        CuboidI{ 16, 16, 12, 4, 1, 1 },     // in the (smaller) chunks at the border
+    };
+
+    for (const auto& roi : rois)
+    {
+        BlobOutputOnHeap sub_volume;
+        reader->ReadBrickSubVolume(pk, roi, &sub_volume);
+        const auto expected = ExtractSubVolume(static_cast<const uint8_t*>(brick_data.GetDataC()), kWidth, kHeight, kBytesPerVoxel, roi);
+        ASSERT_TRUE(sub_volume.GetHasData());
+        ASSERT_EQ(sub_volume.GetSizeOfData(), expected.size());
+        EXPECT_EQ(memcmp(sub_volume.GetDataC(), expected.data(), expected.size()), 0);
+    }
+}
+
+TEST(Read3d, ParseChunkIndexWithInconsistentHeaderAndCheckForException)
+{
+    BrickChunkIndex chunk_index;
+    chunk_index.bytes_per_voxel = 1;
+    chunk_index.brick_width = 5;
+    chunk_index.brick_height = 3;
+    chunk_index.brick_depth = 2;
+    chunk_index.chunk_extent = BrickChunkExtent{ 2, 2, 2 };
+    chunk_index.chunk_blob_keys = { 1, 2, 3, 4, 5, 6 };
+    const auto data = chunk_index.Serialize();
+    const auto parsed_chunk_index = BrickChunkIndex::Parse(data.data(), data.size());
+    EXPECT_EQ(parsed_chunk_index.chunk_blob_keys, chunk_index.chunk_blob_keys);
+    EXPECT_THROW(BrickChunkIndex::Parse(data.data(), data.size() - 1), invalid_operation_exception);
+
+    // the header is manipulated so that the number of chunks does not match the list of keys - with the brick width being
+    //  the maximal value, the chunk count must not wrap around (to zero), and with all dimensions being huge, the product of
+    //  the chunk counts must not overflow
+    const auto parse_with_brick_and_chunk_extent = [&data](uint32_t brick_extent, uint32_t chunk_extent, bool all_dimensions)->void
+        {
+            auto manipulated_data = data;
+            for (size_t i = 0; i < (all_dimensions ? 3 : 1); ++i)
+            {
+                for (size_t byte = 0; byte < 4; ++byte)
+                {
+                    manipulated_data[8 + i * 4 + byte] = static_cast<uint8_t>(brick_extent >> (8 * byte));
+                    manipulated_data[20 + i * 4 + byte] = static_cast<uint8_t>(chunk_extent >> (8 * byte));
+                }
+            }
+
+            BrickChunkIndex::Parse(manipulated_data.data(), manipulated_data.size());
+        };
+
+    EXPECT_THROW(parse_with_brick_and_chunk_extent(numeric_limits<uint32_t>::max(), 2, false), invalid_operation_exception);
+    EXPECT_THROW(parse_with_brick_and_chunk_extent(numeric_limits<uint32_t>::max(), 1, true), invalid_operation_exception);
+    EXPECT_THROW(parse_with_brick_and_chunk_extent(1u << 22, 1, true), invalid_operation_exception);
+}
+
+TEST(Read3d, AddUncompressedBrickAndReadSubVolumeCheckForCorrectness)
+{
+    constexpr uint32_t kWidth = 9;
+    constexpr uint32_t kHeight = 8;
+    constexpr uint32_t kDepth = 7;
+
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetDocumentType(DocumentType::kImage3d);
+    create_options->SetFilename(":memory:");
+    create_options->AddDimension('M');
+    create_options->SetCreateBlobTable(true);
+
+    const auto doc = ClassFactory::CreateNew(create_options.get());
+    const auto reader = doc->GetReader3d();
+    const auto writer = doc->GetWriter3d();
+
+    const LogicalPositionInfo3D position_info{ 0, 0, 0, kWidth, kHeight, kDepth, 0 };
+    BrickBaseInfo brick_base_info;
+    brick_base_info.pixelWidth = kWidth;
+    brick_base_info.pixelHeight = kHeight;
+    brick_base_info.pixelDepth = kDepth;
+    brick_base_info.pixelType = PixelType::Gray8;
+    const TileCoordinate tc({ { 'M', 1 } });
+
+    DataObjectOnHeap brick_data{ kWidth * kHeight * kDepth };
+    for (size_t i = 0; i < brick_data.GetSizeOfData(); ++i)
+    {
+        static_cast<uint8_t*>(brick_data.GetData())[i] = static_cast<uint8_t>(i);
+    }
+
+    const auto pk = writer->AddBrick(&tc, &position_info, &brick_base_info, DataTypes::UNCOMPRESSED_BRICK, TileDataStorageType::BlobInDatabase, &brick_data);
+
+    const CuboidI roi{ 2, 3, 4, 5, 4, 3 };
+    BlobOutputOnHeap sub_volume;
+    reader->ReadBrickSubVolume(pk, roi, &sub_volume);
+    const auto expected = ExtractSubVolume(static_cast<const uint8_t*>(brick_data.GetDataC()), kWidth, kHeight, 1, roi);
+    ASSERT_EQ(sub_volume.GetSizeOfData(), expected.size());
+    EXPECT_EQ(memcmp(sub_volume.GetDataC(), expected.data(), expected.size()), 0);
+
+    // a sub-volume which is not completely contained in the brick is rejected
+    BlobOutputOnHeap sub_volume2;
+    EXPECT_THROW(reader->ReadBrickSubVolume(pk, CuboidI{ 5, 0, 0, 5, 1, 1 }, &sub_volume2), invalid_argument_exception);
+}
+
+TEST(Read3d, GetBrickDataSizeAndCompareWithSizeOfBrickData)
+{
+    constexpr uint32_t kWidth = 9;
+    constexpr uint32_t kHeight = 8;
+    constexpr uint32_t kDepth = 7;
+
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetDocumentType(DocumentType::kImage3d);
+    create_options->SetFilename(":memory:");
+    create_options->AddDimension('M');
+    create_options->SetCreateBlobTable(true);
+
+    const auto doc = ClassFactory::CreateNew(create_options.get());
+    const auto reader = doc->GetReader3d();
+    const auto writer = doc->GetWriter3d();
+
+    const LogicalPositionInfo3D position_info{ 0, 0, 0, kWidth, kHeight, kDepth, 0 };
+    BrickBaseInfo brick_base_info;
+    brick_base_info.pixelWidth = kWidth;
+    brick_base_info.pixelHeight = kHeight;
+    brick_base_info.pixelDepth = kDepth;
+    brick_base_info.pixelType = PixelType::Gray16;
+    const TileCoordinate tc({ { 'M', 1 } });
+
+    const DataObjectOnHeap brick_data{ kWidth * kHeight * kDepth * 2 };
+    const auto pk = writer->AddBrick(&tc, &position_info, &brick_base_info, DataTypes::UNCOMPRESSED_BRICK, TileDataStorageType::BlobInDatabase, &brick_data);
+
+    EXPECT_EQ(reader->GetBrickDataSize(pk), brick_data.GetSizeOfData());
+    BlobOutputOnHeap brick_data_read;
+    reader->ReadBrickData(pk, &brick_data_read);
+    EXPECT_EQ(brick_data_read.GetSizeOfData(), brick_data.GetSizeOfData());
+
+    EXPECT_THROW(reader->GetBrickDataSize(pk + 1), non_existing_tile_exception);
+}
+
+TEST(Read3d, AddBricksWithTileStatisticsAndReadStatisticsCheckForCorrectness)
+{
+    constexpr uint32_t kWidth = 10;
+    constexpr uint32_t kHeight = 9;
+    constexpr uint32_t kDepth = 8;
+    constexpr size_t kVoxelCount = static_cast<size_t>(kWidth) * kHeight * kDepth;
+
+    const auto create_options = ClassFactory::CreateCreateOptionsUp();
+    create_options->SetDocumentType(DocumentType::kImage3d);
+    create_options->SetFilename(":memory:");
+    create_options->AddDimension('M');
+    create_options->SetUseSpatialIndex(true);
+    create_options->SetCreateBlobTable(true);
+    create_options->SetCreateTileStatisticsTable(true);
+
+    const auto doc = ClassFactory::CreateNew(create_options.get());
+    const auto reader = doc->GetReader3d();
+    const auto writer = doc->GetWriter3d();
+
+    BrickBaseInfo brick_base_info;
+    brick_base_info.pixelWidth = kWidth;
+    brick_base_info.pixelHeight = kHeight;
+    brick_base_info.pixelDepth = kDepth;
+    brick_base_info.pixelType = PixelType::Gray16;
+
+    // the first brick (uncompressed) contains the values 0...719, the second brick (chunked) the values 1000...1719
+    DataObjectOnHeap brick_data{ kVoxelCount * sizeof(uint16_t) };
+    for (size_t i = 0; i < kVoxelCount; ++i)
+    {
+        reinterpret_cast<uint16_t*>(brick_data.GetData())[i] = static_cast<uint16_t>(i);
+    }
+
+    const TileCoordinate tc({ { 'M', 1 } });
+    LogicalPositionInfo3D position_info{ 0, 0, 0, kWidth, kHeight, kDepth, 0 };
+    const auto pk_brick = writer->AddBrick(&tc, &position_info, &brick_base_info, DataTypes::UNCOMPRESSED_BRICK, TileDataStorageType::BlobInDatabase, &brick_data);
+
+    for (size_t i = 0; i < kVoxelCount; ++i)
+    {
+        reinterpret_cast<uint16_t*>(brick_data.GetData())[i] = static_cast<uint16_t>(i + 1000);
+    }
+
+    position_info = LogicalPositionInfo3D{ 100, 0, 0, kWidth, kHeight, kDepth, 0 };
+    const auto pk_chunked_brick = writer->AddChunkedBrick(&tc, &position_info, &brick_base_info, BrickChunkExtent{ 4, 4, 4 }, TileDataStorageType::BlobInDatabase, &brick_data);
+
+    TileStatistics statistics;
+    ASSERT_TRUE(reader->TryReadBrickStatistics(pk_brick, &statistics));
+    EXPECT_EQ(statistics.pixel_count, kVoxelCount);
+    EXPECT_DOUBLE_EQ(statistics.minimum, 0);
+    EXPECT_DOUBLE_EQ(statistics.maximum, kVoxelCount - 1);
+    EXPECT_DOUBLE_EQ(statistics.GetMean(), (kVoxelCount - 1) / 2.0);
+
+    ASSERT_TRUE(reader->TryReadBrickStatistics(pk_chunked_brick, &statistics));
+    EXPECT_EQ(statistics.pixel_count, kVoxelCount);
+    EXPECT_DOUBLE_EQ(statistics.minimum, 1000);
+    EXPECT_DOUBLE_EQ(statistics.maximum, 1000 + kVoxelCount - 1);
+
+    // the cuboid intersects with the second brick only
+    const CuboidD cuboid{ 105, 0, 0, 1, 1, 1 };
+    auto summary = reader->GetBrickStatisticsSummary(&cuboid, nullptr, nullptr);
+    EXPECT_EQ(summary.tile_count, 1);
+    EXPECT_DOUBLE_EQ(summary.statistics.minimum, 1000);
+
+    CDimCoordinateQueryClause coordinate_query_clause;
+    coordinate_query_clause.AddRangeClause('M', IDimCoordinateQueryClause::RangeClause{ 1, 1 });
+    summary = reader->GetBrickStatisticsSummary(nullptr, &coordinate_query_clause, nullptr);
+    EXPECT_EQ(summary.tile_count, 2);
+    EXPECT_EQ(summary.tile_count_without_statistics, 0);
+    EXPECT_EQ(summary.statistics.pixel_count, 2 * kVoxelCount);
+    EXPECT_DOUBLE_EQ(summary.statistics.minimum, 0);
+    EXPECT_DOUBLE_EQ(summary.statistics.maximum, 1000 + kVoxelCount - 1);
+    EXPECT_DOUBLE_EQ(summary.statistics.GetMean(), (kVoxelCount - 1) / 2.0 + 500);
+    uint64_t total_count = 0;
+    for (const auto count : summary.statistics.histogram)
+    {
+        total_count += count;
+    }
+
+    EXPECT_EQ(total_count, 2 * kVoxelCount);
+}